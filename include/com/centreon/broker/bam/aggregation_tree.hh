@@ -0,0 +1,77 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_BAM_AGGREGATION_TREE_HH
+#define CCB_BAM_AGGREGATION_TREE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace bam {
+/**
+ *  @class aggregation_tree aggregation_tree.hh
+ * "com/centreon/broker/bam/aggregation_tree.hh"
+ *  @brief Minimum, maximum and sum of a set of metric values.
+ *
+ *  Segment tree over metric slots: each node holds the minimum, the
+ *  maximum and the sum of the slots below it. Setting or removing a
+ *  value updates the nodes from its slot to the root, in O(log n).
+ *  Slots of removed metrics are reused, the tree doubles its capacity
+ *  when all its slots are used.
+ */
+class aggregation_tree {
+ public:
+  aggregation_tree();
+  ~aggregation_tree();
+  aggregation_tree(aggregation_tree const& other) = delete;
+  aggregation_tree& operator=(aggregation_tree const& other) = delete;
+  void clear();
+  bool get(uint32_t metric_id, double& value) const;
+  double max() const;
+  double min() const;
+  bool remove(uint32_t metric_id);
+  void set(uint32_t metric_id, double value);
+  size_t size() const;
+  double sum() const;
+
+ private:
+  struct node {
+    double min;
+    double max;
+    double sum;
+  };
+
+  static void _combine(std::vector<node>& nodes, size_t i);
+  void _grow();
+  void _update(uint32_t slot);
+
+  size_t _capacity;
+  std::vector<uint32_t> _free;
+  std::vector<node> _nodes;
+  std::unordered_map<uint32_t, uint32_t> _slots;
+};
+}  // namespace bam
+
+CCB_END()
+
+#endif  // !CCB_BAM_AGGREGATION_TREE_HH
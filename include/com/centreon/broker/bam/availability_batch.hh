@@ -0,0 +1,89 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_BAM_AVAILABILITY_BATCH_HH
+#define CCB_BAM_AVAILABILITY_BATCH_HH
+
+#include <ctime>
+#include <exception>
+#include <map>
+#include <vector>
+#include "com/centreon/broker/bam/availability_builder.hh"
+#include "com/centreon/broker/namespace.hh"
+#include "com/centreon/broker/time/timeperiod.hh"
+
+CCB_BEGIN()
+
+namespace bam {
+/**
+ *  @class availability_batch availability_batch.hh
+ * "com/centreon/broker/bam/availability_batch.hh"
+ *  @brief Daily availabilities of many BAs.
+ *
+ *  Events of all the BAs are loaded once for the whole period. Each BA
+ *  starts at its own first day (the day following its last written
+ *  availability) and the BAs are computed in parallel.
+ */
+class availability_batch {
+ public:
+  struct event {
+    uint32_t timeperiod_id;
+    time::timeperiod::ptr tp;
+    bool timeperiod_is_default;
+    short status;
+    time_t start_time;
+    time_t end_time;  // 0 if the event is not finished.
+    bool in_downtime;
+  };
+
+  struct availability {
+    uint32_t ba_id;
+    time_t day_start;
+    uint32_t timeperiod_id;
+    availability_builder builder;
+  };
+
+  availability_batch(std::vector<time_t> const& days);
+  ~availability_batch();
+  availability_batch(availability_batch const& other) = delete;
+  availability_batch& operator=(availability_batch const& other) = delete;
+  void add_event(uint32_t ba_id, event const& e);
+  void compute(unsigned int threads_count = 0);
+  std::vector<availability> const& get_availabilities() const;
+  void set_first_day(uint32_t ba_id, time_t first_day);
+
+ private:
+  struct ba_events {
+    ba_events();
+    time_t first_day;
+    std::vector<event> events;
+    std::vector<availability> availabilities;
+    std::exception_ptr error;
+  };
+
+  void _compute_ba(uint32_t ba_id, ba_events& ba) const;
+
+  std::vector<availability> _availabilities;
+  std::map<uint32_t, ba_events> _bas;
+  std::vector<time_t> _days;
+};
+}  // namespace bam
+
+CCB_END()
+
+#endif  // !CCB_BAM_AVAILABILITY_BATCH_HH
@@ -20,10 +20,12 @@
 #define CCB_BAM_AVAILABILITY_THREAD_HH
 
 #include <condition_variable>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include "com/centreon/broker/bam/availability_batch.hh"
 #include "com/centreon/broker/bam/availability_builder.hh"
 #include "com/centreon/broker/bam/timeperiod_map.hh"
 #include "com/centreon/broker/database_config.hh"
@@ -64,14 +66,12 @@ class availability_thread {
 
   void _delete_all_availabilities();
   void _build_availabilities(time_t midnight);
-  void _build_daily_availabilities(int thread_id,
-                                   time_t day_start,
-                                   time_t day_end);
-  void _write_availability(int thread_id,
-                           availability_builder const& builder,
-                           uint32_t ba_id,
-                           time_t day_start,
-                           uint32_t timeperiod_id);
+  void _load_events(int thread_id,
+                    availability_batch& batch,
+                    std::map<uint32_t, time_t> const& first_days,
+                    time_t first_day,
+                    time_t last_day);
+  void _write_availabilities(availability_batch const& batch);
 
   time_t _compute_next_midnight();
   time_t _compute_start_of_day(time_t when);
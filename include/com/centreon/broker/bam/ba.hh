@@ -66,12 +66,15 @@ class ba : public computable, public service_listener {
   void _recompute();
   void _unapply_impact(kpi* kpi_ptr, impact_info& impact);
   void _compute_inherited_downtime(io::stream* visitor);
+  bool _update_event(io::stream* visitor);
+  void _write_status(io::stream* visitor, bool state_changed);
 
   configuration::ba::state_source _state_source;
   ba::state _computed_soft_state;
   ba::state _computed_hard_state;
   float _num_soft_critical_childs;
   float _num_hard_critical_childs;
+  bool _deferred_publication;
   double _acknowledgement_hard;
   double _acknowledgement_soft;
   double _downtime_hard;
@@ -90,6 +93,8 @@ class ba : public computable, public service_listener {
   std::string _name;
   int _recompute_count;
   uint32_t _service_id;
+  bool _state_changed;
+  bool _status_pending;
   bool _valid;
   configuration::ba::downtime_behaviour _dt_behaviour;
   std::unique_ptr<inherited_downtime> _inherited_downtime;
@@ -121,7 +126,9 @@ class ba : public computable, public service_listener {
   ba::state get_state_hard();
   ba::state get_state_soft();
   configuration::ba::state_source get_state_source() const;
+  void publish(io::stream* visitor);
   void remove_impact(std::shared_ptr<kpi> const& impact);
+  void set_deferred_publication(bool deferred);
   void set_id(uint32_t id);
   void set_host_id(uint32_t host_id);
   void set_service_id(uint32_t service_id);
@@ -45,6 +45,8 @@ class bool_binary_operator : public bool_value {
   virtual ~bool_binary_operator();
   bool_binary_operator& operator=(bool_binary_operator const& right);
   bool child_has_update(computable* child, io::stream* visitor = NULL);
+  std::shared_ptr<bool_value> const& get_left() const;
+  std::shared_ptr<bool_value> const& get_right() const;
   void set_left(std::shared_ptr<bool_value> const& left);
   void set_right(std::shared_ptr<bool_value> const& right);
   bool state_known() const;
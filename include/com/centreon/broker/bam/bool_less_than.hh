@@ -39,6 +39,7 @@ class bool_less_than : public bool_binary_operator {
   bool_less_than(bool_less_than const& right);
   ~bool_less_than();
   bool_less_than& operator=(bool_less_than const& right);
+  bool is_strict() const;
   double value_hard();
   double value_soft();
 
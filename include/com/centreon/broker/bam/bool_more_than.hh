@@ -38,6 +38,7 @@ class bool_more_than : public bool_binary_operator {
   bool_more_than(bool_more_than const& right);
   ~bool_more_than();
   bool_more_than& operator=(bool_more_than const& right);
+  bool is_strict() const;
   double value_hard();
   double value_soft();
 
@@ -44,6 +44,7 @@ class bool_not : public bool_value {
   ~bool_not();
   bool_not& operator=(bool_not const& right);
   bool child_has_update(computable* child, io::stream* visitor = NULL);
+  bool_value::ptr const& get_value() const;
   void set_value(std::shared_ptr<bool_value>& value);
   double value_hard();
   double value_soft();
@@ -36,22 +36,25 @@ namespace bam {
  */
 class bool_operation : public bool_binary_operator {
  public:
+  enum operation_type {
+    addition,
+    substraction,
+    multiplication,
+    division,
+    modulo
+  };
+
   bool_operation(std::string const& op);
   bool_operation(bool_operation const& right);
   ~bool_operation();
   bool_operation& operator=(bool_operation const& right);
+  operation_type get_type() const;
+  static double modulo_value(double left, double right);
   double value_hard();
   double value_soft();
   bool state_known() const;
 
  private:
-  enum operation_type {
-    addition,
-    substraction,
-    multiplication,
-    division,
-    modulo
-  };
   operation_type _type;
 };
 }  // namespace bam
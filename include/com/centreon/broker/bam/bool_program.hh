@@ -0,0 +1,108 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_BAM_BOOL_PROGRAM_HH
+#define CCB_BAM_BOOL_PROGRAM_HH
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "com/centreon/broker/bam/bool_value.hh"
+#include "com/centreon/broker/io/stream.hh"
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace bam {
+/**
+ *  @class bool_program bool_program.hh
+ * "com/centreon/broker/bam/bool_program.hh"
+ *  @brief Compiled boolean expression.
+ *
+ *  The operators of a tree built by exp_builder are flattened into an
+ *  array of instructions, operands before the operators using them.
+ *  Each instruction caches its values and knows its parent, so when a
+ *  leaf (service, call, ...) is updated only the instructions from this
+ *  leaf to the root are evaluated again, stopping as soon as a value
+ *  does not change. Values are the ones of the tree evaluator.
+ */
+class bool_program : public bool_value {
+ public:
+  typedef std::shared_ptr<bool_program> ptr;
+
+  ~bool_program();
+  bool child_has_update(computable* child, io::stream* visitor = NULL);
+  static ptr compile(bool_value::ptr const& tree);
+  uint32_t get_size() const;
+  double value_hard();
+  double value_soft();
+  bool state_known() const;
+  bool in_downtime() const;
+
+ private:
+  enum opcode {
+    op_leaf,
+    op_constant,
+    op_not,
+    op_and,
+    op_or,
+    op_xor,
+    op_equal,
+    op_not_equal,
+    op_more_than,
+    op_more_equal,
+    op_less_than,
+    op_less_equal,
+    op_add,
+    op_sub,
+    op_mul,
+    op_div,
+    op_mod
+  };
+
+  struct instruction {
+    opcode op;
+    uint32_t left;
+    uint32_t right;
+    uint32_t parent;
+    double hard;
+    double soft;
+    bool known;
+    bool downtime;
+  };
+
+  static uint32_t const no_parent = static_cast<uint32_t>(-1);
+
+  bool_program();
+  bool_program(bool_program const& other) = delete;
+  bool_program& operator=(bool_program const& other) = delete;
+  uint32_t _compile(bool_value::ptr const& node,
+                    std::shared_ptr<computable> const& parent,
+                    ptr const& self);
+  bool _execute(uint32_t index);
+
+  std::vector<instruction> _code;
+  std::vector<bool_value::ptr> _leaves;
+  std::unordered_multimap<computable const*, uint32_t> _leaf_index;
+};
+}  // namespace bam
+
+CCB_END()
+
+#endif  // !CCB_BAM_BOOL_PROGRAM_HH
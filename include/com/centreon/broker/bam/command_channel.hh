@@ -0,0 +1,64 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_BAM_COMMAND_CHANNEL_HH
+#define CCB_BAM_COMMAND_CHANNEL_HH
+
+#include <string>
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace bam {
+/**
+ *  @class command_channel command_channel.hh
+ * "com/centreon/broker/bam/command_channel.hh"
+ *  @brief Persistent channel to the engine command file.
+ *
+ *  External commands are buffered and written in batches on flush()
+ *  to a command file kept open between batches. Writes never block:
+ *  what the FIFO cannot accept stays in the buffer for the next flush.
+ *  When the engine is stopped or restarted, the file is reopened and
+ *  the pending commands are sent to the new engine. The buffer is
+ *  bounded, the oldest commands are dropped when it is full.
+ */
+class command_channel {
+ public:
+  command_channel(std::string const& path, size_t max_size = 1 << 20);
+  ~command_channel();
+  bool flush();
+  size_t get_pending() const;
+  void write(std::string const& cmd);
+
+ private:
+  command_channel(command_channel const& other);
+  command_channel& operator=(command_channel const& other);
+  void _close();
+  bool _open();
+
+  std::string _buffer;
+  int _fd;
+  size_t _max_size;
+  bool _partial;
+  std::string _path;
+};
+}  // namespace bam
+
+CCB_END()
+
+#endif  // !CCB_BAM_COMMAND_CHANNEL_HH
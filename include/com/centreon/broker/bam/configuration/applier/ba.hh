@@ -21,6 +21,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 #include "com/centreon/broker/bam/ba.hh"
 #include "com/centreon/broker/bam/configuration/ba.hh"
 #include "com/centreon/broker/bam/configuration/state.hh"
@@ -54,6 +55,8 @@ class ba {
   ba& operator=(ba const& other);
   void apply(configuration::state::bas const& my_bas, service_book& book);
   std::shared_ptr<bam::ba> find_ba(uint32_t id);
+  void publish(io::stream* visitor);
+  void sort(configuration::state::kpis const& my_kpis);
   void visit(io::stream* visitor);
   void save_to_cache(persistent_cache& cache);
   void load_from_cache(persistent_cache& cache);
@@ -73,6 +76,7 @@ class ba {
                                    service_book& book);
 
   std::map<uint32_t, applied> _applied;
+  std::vector<std::shared_ptr<bam::ba> > _order;
 };
 }  // namespace applier
 }  // namespace configuration
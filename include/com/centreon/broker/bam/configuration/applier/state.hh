@@ -56,6 +56,7 @@ class state {
   void apply(configuration::state const& my_state);
   metric_book& book_metric();
   service_book& book_service();
+  void publish(io::stream* visitor);
   void visit(io::stream* visitor);
   void save_to_cache(persistent_cache& cache);
   void load_from_cache(persistent_cache& cache);
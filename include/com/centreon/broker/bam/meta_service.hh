@@ -20,7 +20,7 @@
 #define CCB_BAM_META_SERVICE_HH
 
 #include <string>
-#include <unordered_map>
+#include "com/centreon/broker/bam/aggregation_tree.hh"
 #include "com/centreon/broker/bam/computable.hh"
 #include "com/centreon/broker/bam/metric_listener.hh"
 #include "com/centreon/broker/io/stream.hh"
@@ -51,9 +51,6 @@ class meta_service : public computable, public metric_listener {
   enum computation_type { average = 1, min, max, sum };
 
  private:
-  static int const _recompute_limit = 100;
-
-  void _recompute_partial(double new_value, double old_value);
   void _send_service_status(io::stream* visitor, bool state_has_changed);
 
   computation_type _computation;
@@ -63,8 +60,7 @@ class meta_service : public computable, public metric_listener {
   meta_service::state _last_state;
   double _level_critical;
   double _level_warning;
-  std::unordered_map<uint32_t, double> _metrics;
-  int _recompute_count;
+  aggregation_tree _metrics;
   double _value;
   timestamp _last_service_status_sent;
 
@@ -81,6 +77,7 @@ class meta_service : public computable, public metric_listener {
   std::string get_output() const;
   std::string get_perfdata() const;
   meta_service::state get_state() const;
+  double get_value() const;
   void metric_update(std::shared_ptr<storage::metric> const& m,
                      io::stream* visitor = NULL);
   void remove_metric(uint32_t metric_id);
@@ -22,6 +22,7 @@
 #include <mutex>
 #include <string>
 
+#include "com/centreon/broker/bam/command_channel.hh"
 #include "com/centreon/broker/bam/configuration/applier/state.hh"
 #include "com/centreon/broker/database/mysql_stmt.hh"
 #include "com/centreon/broker/database_config.hh"
@@ -59,16 +60,17 @@ class monitoring_stream : public io::stream {
   monitoring_stream& operator=(monitoring_stream const& other);
   void _check_replication();
   void _prepare();
+  void _publish();
   void _rebuild();
   void _update_status(std::string const& status);
-  void _write_external_command(std::string cmd);
+  void _write_external_command(std::string const& cmd);
 
   void _read_cache();
   void _write_cache();
 
   configuration::applier::state _applier;
   std::string _status;
-  std::string _ext_cmd_file;
+  command_channel _commands;
   ba_svc_mapping _ba_mapping;
   ba_svc_mapping _meta_mapping;
   mutable std::mutex _statusm;
@@ -76,6 +78,7 @@ class monitoring_stream : public io::stream {
   database::mysql_stmt _ba_update;
   database::mysql_stmt _kpi_update;
   database::mysql_stmt _meta_service_update;
+  time_t _next_publication;
   int _pending_events;
   database_config _storage_db_cfg;
   std::shared_ptr<persistent_cache> _cache;
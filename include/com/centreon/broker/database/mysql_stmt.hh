@@ -21,6 +21,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 #include "com/centreon/broker/database/mysql_bind.hh"
 #include "com/centreon/broker/io/data.hh"
 
@@ -28,7 +29,39 @@ CCB_BEGIN()
 
 typedef std::map<std::string, int> mysql_bind_mapping;
 
+namespace mapping {
+class entry;
+}
+
 namespace database {
+/**
+ *  @class mysql_bind_plan mysql_stmt.hh
+ *  "com/centreon/broker/database/mysql_stmt.hh"
+ *  @brief Bindings of an event type in a statement.
+ *
+ *  Computed once from the statement bind mapping, it gives for each field
+ *  of the event the indexes it is bound to (two for insert or update
+ *  queries) and when it has to be bound as NULL.
+ */
+struct mysql_bind_plan {
+  enum null_policy {
+    never_null,
+    null_on_zero,
+    null_on_minus_one,
+    null_on_empty
+  };
+
+  struct field {
+    mapping::entry const* entry;
+    uint32_t type;
+    null_policy policy;
+    int index[2];
+  };
+
+  uint32_t event_type;
+  std::vector<field> fields;
+};
+
 class mysql_stmt {
  public:
   mysql_stmt();
@@ -41,6 +74,7 @@ class mysql_stmt {
   int get_id() const;
   std::unique_ptr<database::mysql_bind> get_bind();
   void operator<<(io::data const& d);
+  void compile_bind_plan(uint32_t event_type);
 
   void bind_value_as_i32(int range, int value);
   void bind_value_as_i32(std::string const& key, int value);
@@ -73,6 +107,18 @@ class mysql_stmt {
 
  private:
   int _compute_param_count(std::string const& query);
+  template <typename T>
+  void _bind_field(mysql_bind_plan::field const& f,
+                   bool null,
+                   T value,
+                   void (mysql_bind::*setter)(int, T)) {
+    for (int i = 0; i < 2 && f.index[i] >= 0; ++i) {
+      if (null)
+        _bind->set_value_as_null(f.index[i]);
+      else
+        (_bind.get()->*setter)(f.index[i], value);
+    }
+  }
 
   int _id;
   int _param_count;
@@ -80,6 +126,7 @@ class mysql_stmt {
 
   std::unique_ptr<database::mysql_bind> _bind;
   mysql_bind_mapping _bind_mapping;
+  std::shared_ptr<mysql_bind_plan const> _bind_plan;
 };
 }  // namespace database
 
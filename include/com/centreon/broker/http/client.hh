@@ -0,0 +1,129 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_HTTP_CLIENT_HH
+#define CCB_HTTP_CLIENT_HH
+
+#include <asio.hpp>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <future>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+#include "com/centreon/broker/http/request.hh"
+#include "com/centreon/broker/http/response.hh"
+#include "com/centreon/broker/namespace.hh"
+
+#if ASIO_VERSION < 101200
+namespace asio {
+typedef io_service io_context;
+}
+#endif
+
+CCB_BEGIN()
+
+namespace http {
+/**
+ *  @class client client.hh "com/centreon/broker/http/client.hh"
+ *  @brief Asynchronous HTTP/1.1 client.
+ *
+ *  Requests are sent over a pool of keep-alive connections to one
+ *  server. Each connection pipelines up to max_pipeline requests, so at
+ *  most max_connections * max_pipeline requests are waiting for an
+ *  answer; the following ones are queued until a slot is released.
+ *  Request bodies can be gzipped.
+ *
+ *  Sockets are driven by an internal thread, callers only get futures.
+ *  A request whose connection is lost after it was sent fails, it is not
+ *  replayed since the server may already have processed it.
+ */
+class client {
+ public:
+  struct config {
+    uint32_t max_connections;
+    uint32_t max_pipeline;
+    bool gzip;
+    std::chrono::seconds timeout;
+
+    config()
+        : max_connections{1},
+          max_pipeline{1},
+          gzip{false},
+          timeout{std::chrono::seconds(30)} {}
+  };
+
+  client(std::string const& host, uint16_t port, config const& conf);
+  ~client();
+  client(client const&) = delete;
+  client& operator=(client const&) = delete;
+
+  void connect();
+  std::future<response> send(request req);
+  uint32_t in_flight() const;
+  std::string const& host() const;
+  uint16_t port() const;
+
+ private:
+  struct pending {
+    std::string data;
+    bool no_body;
+    std::promise<response> promise;
+  };
+  struct connection;
+  typedef std::shared_ptr<pending> pending_ptr;
+  typedef std::shared_ptr<connection> connection_ptr;
+
+  void _dispatch();
+  connection_ptr _open_connection();
+  void _on_connect(connection_ptr c, std::error_code const& err);
+  void _assign(connection_ptr const& c, pending_ptr p);
+  void _start_write(connection_ptr c);
+  void _on_write(connection_ptr c, std::error_code const& err);
+  void _start_read(connection_ptr c);
+  void _on_read(connection_ptr c, std::error_code const& err, size_t bytes);
+  void _arm_timer(connection_ptr const& c);
+  void _on_timeout(connection_ptr c, std::error_code const& err);
+  void _close(connection_ptr const& c, std::string const& reason);
+  void _fail(pending_ptr const& p, std::string const& reason);
+
+  std::string const _host;
+  uint16_t const _port;
+  std::string const _host_header;
+  config _conf;
+
+  asio::io_context _io_context;
+  asio::executor_work_guard<asio::io_context::executor_type> _work;
+  asio::ip::tcp::resolver _resolver;
+  std::thread _thread;
+
+  // Only accessed from the client thread.
+  std::list<connection_ptr> _connections;
+  std::deque<pending_ptr> _waiting;
+  uint32_t _connecting;
+  bool _closing;
+
+  std::atomic<uint32_t> _in_flight;
+};
+}  // namespace http
+
+CCB_END()
+
+#endif  // !CCB_HTTP_CLIENT_HH
@@ -0,0 +1,65 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_HTTP_REQUEST_HH
+#define CCB_HTTP_REQUEST_HH
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace http {
+/**
+ *  @class request request.hh "com/centreon/broker/http/request.hh"
+ *  @brief HTTP/1.1 request.
+ *
+ *  Plain description of a request sent by an http::client. The Host,
+ *  Content-Length and Content-Encoding headers are added by the client.
+ */
+class request {
+ public:
+  typedef std::vector<std::pair<std::string, std::string> > header_list;
+
+  request() = default;
+  request(std::string const& method,
+          std::string const& target,
+          std::string body = std::string());
+  request(request const& other) = default;
+  request(request&& other) = default;
+  ~request() = default;
+  request& operator=(request const& other) = default;
+  request& operator=(request&& other) = default;
+
+  void add_header(std::string const& name, std::string const& value);
+  void serialize(std::string& buffer,
+                 std::string const& host,
+                 bool gzipped) const;
+
+  std::string method;
+  std::string target;
+  header_list headers;
+  std::string body;
+};
+}  // namespace http
+
+CCB_END()
+
+#endif  // !CCB_HTTP_REQUEST_HH
@@ -0,0 +1,107 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_HTTP_RESPONSE_HH
+#define CCB_HTTP_RESPONSE_HH
+
+#include <string>
+#include <unordered_map>
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace http {
+/**
+ *  @class response response.hh "com/centreon/broker/http/response.hh"
+ *  @brief HTTP/1.1 response.
+ *
+ *  Header names are stored lower-cased.
+ */
+class response {
+ public:
+  response();
+  response(response const& other) = default;
+  response(response&& other) = default;
+  ~response() = default;
+  response& operator=(response const& other) = default;
+  response& operator=(response&& other) = default;
+
+  std::string const& header(std::string const& name) const;
+  bool keep_alive() const;
+
+  std::string version;
+  int code;
+  std::string reason;
+  std::unordered_map<std::string, std::string> headers;
+  std::string body;
+};
+
+/**
+ *  @class response_parser response.hh "com/centreon/broker/http/response.hh"
+ *  @brief Incremental HTTP/1.1 response parser.
+ *
+ *  Bytes read from the socket are fed as they come. Pipelined responses
+ *  may be received in the same buffer, so parse() only consumes the bytes
+ *  of the current response and returns how many it used.
+ */
+class response_parser {
+ public:
+  enum state {
+    status_line,
+    header_lines,
+    body_length,
+    chunk_size,
+    chunk_data,
+    chunk_trailer,
+    trailer_lines,
+    body_eof,
+    complete
+  };
+
+  response_parser();
+  ~response_parser() = default;
+  response_parser(response_parser const&) = delete;
+  response_parser& operator=(response_parser const&) = delete;
+
+  size_t parse(char const* data, size_t size);
+  bool done() const;
+  void eof();
+  void expect_no_body(bool no_body);
+  response& get();
+  void reset();
+
+ private:
+  bool _next_line(char const* data,
+                  size_t size,
+                  size_t& consumed,
+                  std::string& line);
+  void _parse_status(std::string const& line);
+  void _parse_header(std::string const& line);
+  void _headers_done();
+
+  state _state;
+  bool _no_body;
+  size_t _remaining;
+  std::string _line;
+  response _response;
+};
+}  // namespace http
+
+CCB_END()
+
+#endif  // !CCB_HTTP_RESPONSE_HH
@@ -50,7 +50,10 @@ class connector : public io::endpoint {
                   std::vector<column> const& status_cols,
                   std::string const& metric_ts,
                   std::vector<column> const& metric_cols,
-                  std::shared_ptr<persistent_cache> const& cache);
+                  std::shared_ptr<persistent_cache> const& cache,
+                  uint32_t max_in_flight = 1,
+                  uint32_t max_connections = 1,
+                  bool gzip = false);
   std::shared_ptr<io::stream> open();
 
  private:
@@ -65,6 +68,9 @@ class connector : public io::endpoint {
   std::string _metric_ts;
   std::vector<column> _metric_cols;
   std::shared_ptr<persistent_cache> _cache;
+  uint32_t _max_in_flight;
+  uint32_t _max_connections;
+  bool _gzip;
 };
 }  // namespace influxdb
 
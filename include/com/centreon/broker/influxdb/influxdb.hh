@@ -58,8 +58,22 @@ class influxdb {
 
   /**
    *  Commit all the events pending to the db.
+   *
+   *  @return True if a query was sent.
    */
-  virtual void commit() = 0;
+  virtual bool commit() = 0;
+
+  /**
+   *  Check the answers already received from the db.
+   */
+  virtual void collect() = 0;
+
+  /**
+   *  Get the number of queries accepted by the db since the last call.
+   *
+   *  @return The number of queries accepted.
+   */
+  virtual uint32_t answered() = 0;
 };
 }  // namespace influxdb
 
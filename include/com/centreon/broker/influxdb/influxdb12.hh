@@ -19,9 +19,11 @@
 #ifndef CCB_INFLUXDB_INFLUXDB12_HH
 #define CCB_INFLUXDB_INFLUXDB12_HH
 
-#include <asio.hpp>
+#include <deque>
+#include <future>
 #include <memory>
 #include <string>
+#include "com/centreon/broker/http/client.hh"
 #include "com/centreon/broker/influxdb/column.hh"
 #include "com/centreon/broker/influxdb/influxdb.hh"
 #include "com/centreon/broker/influxdb/line_protocol_query.hh"
@@ -29,12 +31,6 @@
 #include "com/centreon/broker/namespace.hh"
 #include "com/centreon/broker/storage/metric.hh"
 
-#if ASIO_VERSION < 101200
-namespace asio {
-typedef io_service io_context;
-}
-#endif
-
 CCB_BEGIN()
 
 namespace influxdb {
@@ -44,6 +40,13 @@ namespace influxdb {
  *
  *  This object manage connection and query to influxdb through the Lina
  *  API.
+ *
+ *  Queries are posted over a pool of keep-alive HTTP connections. Up to
+ *  max_in_flight queries may be waiting for their answer, commit() only
+ *  blocks when this window is full. An error answer is reported by the
+ *  commit() or collect() call that receives it, so with a window greater
+ *  than 1 it may be the one of a previous query. The queries accepted
+ *  before it are still counted by answered().
  */
 class influxdb12 : public influxdb::influxdb {
  public:
@@ -56,7 +59,10 @@ class influxdb12 : public influxdb::influxdb {
              std::vector<column> const& status_cols,
              std::string const& metric_ts,
              std::vector<column> const& metric_cols,
-             macro_cache const& cache);
+             macro_cache const& cache,
+             uint32_t max_in_flight = 1,
+             uint32_t max_connections = 1,
+             bool gzip = false);
   ~influxdb12();
 
   influxdb12(influxdb12 const& f) = delete;
@@ -65,24 +71,25 @@ class influxdb12 : public influxdb::influxdb {
   void clear();
   void write(storage::metric const& m);
   void write(storage::status const& s);
-  void commit();
+  bool commit();
+  void collect();
+  uint32_t answered();
 
  private:
-  std::string _post_header;
+  std::string _post_target;
   std::string _query;
   line_protocol_query _status_query;
   line_protocol_query _metric_query;
 
-  asio::io_context _io_context;
-  asio::ip::tcp::socket _socket;
-
-  std::string _host;
-  uint16_t _port;
+  http::client _client;
+  uint32_t _max_in_flight;
+  std::deque<std::future<http::response> > _pending;
+  uint32_t _answered;
 
   macro_cache const& _cache;
 
-  void _connect_socket();
-  bool _check_answer_string(std::string const& ans);
+  void _check_answer(http::response const& ans);
+  void _collect(size_t max_pending);
   void _create_queries(std::string const& user,
                        std::string const& passwd,
                        std::string const& db,
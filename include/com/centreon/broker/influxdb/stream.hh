@@ -20,6 +20,7 @@
 #define CCB_INFLUXDB_STREAM_HH
 
 #include <deque>
+#include <exception>
 #include <list>
 #include <map>
 #include <memory>
@@ -56,7 +57,10 @@ class stream : public io::stream {
          std::vector<column> const& status_cols,
          std::string const& metric_ts,
          std::vector<column> const& metric_cols,
-         std::shared_ptr<persistent_cache> const& cache);
+         std::shared_ptr<persistent_cache> const& cache,
+         uint32_t max_in_flight = 1,
+         uint32_t max_connections = 1,
+         bool gzip = false);
   ~stream();
   int flush();
   bool read(std::shared_ptr<io::data>& d, time_t deadline);
@@ -76,6 +80,8 @@ class stream : public io::stream {
   int _pending_queries;
   uint32_t _actual_query;
   bool _commit;
+  std::deque<int> _committed;
+  std::exception_ptr _error;
 
   // Cache
   macro_cache _cache;
@@ -19,6 +19,7 @@
 #ifndef CCB_IO_DATA_HH
 #define CCB_IO_DATA_HH
 
+#include <cstddef>
 #include <cstdint>
 #include "com/centreon/broker/namespace.hh"
 
@@ -33,6 +34,8 @@ namespace io {
  *  Broker. It is an interface that is implemented by all specific
  *  module data that wish to be transmitted by the multiplexing
  *  engine.
+ *
+ *  Events are allocated from io::data_pool.
  */
 class data {
   const uint32_t _type;
@@ -43,6 +46,8 @@ class data {
   virtual ~data();
   data& operator=(data const& other);
   uint32_t type() const noexcept;
+  static void* operator new(size_t size);
+  static void operator delete(void* p, size_t size) noexcept;
 
   uint32_t source_id;
   uint32_t destination_id;
@@ -0,0 +1,107 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_IO_DATA_POOL_HH
+#define CCB_IO_DATA_POOL_HH
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace io {
+/**
+ *  @class data_pool data_pool.hh "com/centreon/broker/io/data_pool.hh"
+ *  @brief Memory pool of the events.
+ *
+ *  Blocks are grouped by size classes of 16 bytes, up to 1 kB. Each
+ *  thread keeps a cache of free blocks per size class, so most
+ *  allocations and releases take no lock. Caches exchange blocks in
+ *  batches with a shared pool, that gets new blocks by slabs of 64 kB.
+ *  Events are often created by one thread and released by another one,
+ *  blocks then travel back through the shared pool. Slabs are never
+ *  given back to the system.
+ */
+class data_pool {
+ public:
+  data_pool() = delete;
+  static void* allocate(size_t size);
+  static void deallocate(void* p, size_t size) noexcept;
+  static size_t get_slabs_count() noexcept;
+
+  static size_t const max_block_size = 1024;
+};
+
+/**
+ *  @class pool_allocator data_pool.hh "com/centreon/broker/io/data_pool.hh"
+ *  @brief Standard allocator on the events memory pool.
+ *
+ *  Used for the control blocks of event shared pointers and for the
+ *  nodes of event queues.
+ */
+template <typename T>
+class pool_allocator {
+ public:
+  typedef T value_type;
+
+  pool_allocator() noexcept = default;
+  template <typename U>
+  pool_allocator(pool_allocator<U> const&) noexcept {}
+
+  T* allocate(size_t n) {
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "over-aligned types cannot be pooled");
+    return static_cast<T*>(data_pool::allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, size_t n) noexcept {
+    data_pool::deallocate(p, n * sizeof(T));
+  }
+};
+
+template <typename T, typename U>
+bool operator==(pool_allocator<T> const&, pool_allocator<U> const&) noexcept {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(pool_allocator<T> const&, pool_allocator<U> const&) noexcept {
+  return false;
+}
+
+/**
+ *  Create an event and its shared pointer control block in one block of
+ *  the events pool. Events should be created this way rather than with
+ *  std::make_shared, that does not use the pool.
+ *
+ *  @param[in] args  Arguments of the event constructor.
+ *
+ *  @return The new event.
+ */
+template <typename T, typename... Args>
+std::shared_ptr<T> make_event(Args&&... args) {
+  return std::allocate_shared<T>(pool_allocator<T>(),
+                                 std::forward<Args>(args)...);
+}
+}  // namespace io
+
+CCB_END()
+
+#endif  // !CCB_IO_DATA_POOL_HH
@@ -19,7 +19,10 @@
 #ifndef CCB_IO_EVENTS_HH
 #define CCB_IO_EVENTS_HH
 
+#include <atomic>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 #include "com/centreon/broker/io/event_info.hh"
 
 CCB_BEGIN()
@@ -30,6 +33,11 @@ namespace io {
  *  @brief Data events registration.
  *
  *  Maintain the set of existing events.
+ *
+ *  Every registration compiles the events into a dense table indexed
+ *  by category and element, so that get_event_info() does no hashing
+ *  and takes no lock. Replaced tables are kept until the registry is
+ *  destroyed as readers may still use them.
  */
 class events {
  public:
@@ -97,16 +105,41 @@ class events {
   categories_container::const_iterator begin() const;
   categories_container::const_iterator end() const;
   events_container get_events_by_category_name(std::string const& name) const;
-  event_info const* get_event_info(uint32_t type);
+  event_info const* get_event_info(uint32_t type) const noexcept {
+    uint32_t slot(category_slot(category_of_type(type)));
+    dense_table const* table(_dense.load(std::memory_order_acquire));
+    if (slot + 1 >= table->offsets.size())
+      return nullptr;
+    uint32_t index(table->offsets[slot] + element_of_type(type));
+    return index < table->offsets[slot + 1] ? table->infos[index] : nullptr;
+  }
   events_container get_matching_events(std::string const& name) const;
 
  private:
+  // Events of category slot s are infos[offsets[s]] to
+  // infos[offsets[s + 1] - 1], indexed by element.
+  struct dense_table {
+    std::vector<uint32_t> offsets;
+    std::vector<event_info const*> infos;
+  };
+
+  // The internal category takes the first slot, other categories use
+  // the slot following their ID, so built-in categories have fixed
+  // slots and category 0, never registered, has an empty one.
+  static constexpr uint32_t category_slot(unsigned short category_id) {
+    return static_cast<unsigned short>(category_id + 1);
+  }
+
   events();
   events(events const& other);
   ~events();
   events& operator=(events const& other);
 
+  void _compile();
+
   categories_container _elements;
+  std::atomic<dense_table const*> _dense;
+  std::vector<std::unique_ptr<dense_table const>> _tables;
 };
 }  // namespace io
 
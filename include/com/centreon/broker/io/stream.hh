@@ -21,6 +21,7 @@
 
 #include <json11.hpp>
 #include <ctime>
+#include <functional>
 #include <memory>
 #include <string>
 #include "com/centreon/broker/io/data.hh"
@@ -47,6 +48,9 @@ namespace io {
  *  should return the number of event fully written through (taking into
  *  account any buffering, or underlayer) to the end device. If that
  *  information is not available or meaningful, it should always return '1'.
+ *
+ *  The set_read_notifier() method lets a stream tell when read() has new
+ *  data, so that its reader does not have to poll it.
  */
 class stream {
  public:
@@ -58,6 +62,7 @@ class stream {
   virtual std::string peer() const;
   virtual bool read(std::shared_ptr<io::data>& d,
                     time_t deadline = (time_t)-1) = 0;
+  virtual bool set_read_notifier(std::function<void()> const& notifier);
   virtual void set_substream(std::shared_ptr<stream> substream);
   virtual void statistics(json11::Json::object& tree) const;
   virtual void update();
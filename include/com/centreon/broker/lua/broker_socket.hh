@@ -35,7 +35,9 @@ namespace lua {
  * "com/centreon/broker/lua/broker_socket.hh"
  *  @brief Class providing TCP socket to the lua interpreter
  *
- *  This class provides a binding to Lua to access TCP sockets.
+ *  This class provides a binding to Lua to access TCP sockets
+ *  (broker_tcp_socket) and a pipelined keep-alive HTTP client
+ *  (broker_http_client).
  */
 class broker_socket {
  public:
@@ -0,0 +1,139 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_MULTIPLEXING_ASYNC_PUBLISHER_HH
+#define CCB_MULTIPLEXING_ASYNC_PUBLISHER_HH
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "com/centreon/broker/io/stream.hh"
+#include "com/centreon/broker/namespace.hh"
+#include "com/centreon/broker/persistent_file.hh"
+
+CCB_BEGIN()
+
+namespace multiplexing {
+/**
+ *  @class async_publisher async_publisher.hh
+ * "com/centreon/broker/multiplexing/async_publisher.hh"
+ *  @brief Publish events to the multiplexing engine from a dedicated
+ *  thread.
+ *
+ *  Once started, events written by the thread that called start() are
+ *  pushed in a bounded single producer / single consumer ring and
+ *  published by batches from a publishing thread, so the writer never
+ *  waits on the multiplexing engine. Events written from other threads
+ *  go through a small locked queue. When the ring is full, the writer
+ *  either waits for a free slot (overflow_block) or appends the event
+ *  to a spill file that is read back once the ring is drained
+ *  (overflow_spill).
+ *
+ *  Before start() and after stop(), events are published synchronously.
+ *
+ *  @see publisher
+ */
+class async_publisher : public io::stream {
+ public:
+  enum overflow_policy { overflow_block, overflow_spill };
+
+  struct stats {
+    size_t queued;
+    size_t capacity;
+    uint64_t published;
+    uint64_t failed;
+    uint64_t spilled;
+    uint64_t blocked;
+    double average_latency;
+    double max_latency;
+  };
+
+  static size_t const batch_size = 1024;
+
+  async_publisher();
+  async_publisher(async_publisher const& other) = delete;
+  ~async_publisher();
+  async_publisher& operator=(async_publisher const& other) = delete;
+  stats get_stats() const;
+  bool read(std::shared_ptr<io::data>& d, time_t deadline = (time_t)-1);
+  bool running() const noexcept;
+  void start(size_t queue_size,
+             overflow_policy policy,
+             std::string const& spill_file);
+  void statistics(json11::Json::object& tree) const;
+  void stop();
+  int write(std::shared_ptr<io::data> const& d);
+
+ private:
+  struct entry {
+    std::shared_ptr<io::data> event;
+    int64_t enqueued;
+  };
+
+  static int64_t _now() noexcept;
+  void _callback();
+  size_t _consume(std::list<std::shared_ptr<io::data>>& batch);
+  void _publish(std::list<std::shared_ptr<io::data>>& batch);
+  bool _push(std::shared_ptr<io::data> const& d, int64_t now);
+  size_t _read_spill(std::list<std::shared_ptr<io::data>>& batch);
+  void _spill(std::shared_ptr<io::data> const& d);
+  void _wake();
+
+  std::vector<entry> _ring;
+  size_t _mask;
+  size_t _capacity;
+  overflow_policy _policy;
+  std::string _spill_file;
+  std::thread::id _producer;
+  std::thread _thread;
+  std::atomic_bool _running;
+
+  /* Written by the producer. */
+  alignas(64) std::atomic<size_t> _head;
+  std::atomic_bool _spilling;
+  /* Written by the publishing thread. */
+  alignas(64) std::atomic<size_t> _tail;
+  std::atomic_bool _sleeping;
+
+  mutable std::mutex _m;
+  std::condition_variable _cv;
+  std::deque<entry> _foreign;
+
+  std::mutex _spill_m;
+  std::unique_ptr<persistent_file> _file;
+
+  std::atomic<uint64_t> _published;
+  std::atomic<uint64_t> _failed;
+  std::atomic<uint64_t> _spilled;
+  std::atomic<uint64_t> _blocked;
+  std::atomic<int64_t> _latency_sum;
+  std::atomic<int64_t> _latency_max;
+  std::atomic<uint64_t> _latency_count;
+};
+}  // namespace multiplexing
+
+CCB_END()
+
+#endif  // !CCB_MULTIPLEXING_ASYNC_PUBLISHER_HH
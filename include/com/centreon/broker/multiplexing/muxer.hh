@@ -20,6 +20,7 @@
 #define CCB_MULTIPLEXING_MUXER_HH
 
 #include <condition_variable>
+#include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -27,6 +28,7 @@
 #include <string>
 #include <unordered_set>
 
+#include "com/centreon/broker/io/data_pool.hh"
 #include "com/centreon/broker/namespace.hh"
 #include "com/centreon/broker/persistent_file.hh"
 
@@ -57,6 +59,7 @@ class muxer : public io::stream {
   static uint32_t event_queue_max_size() throw();
   void publish(std::shared_ptr<io::data> const& d);
   bool read(std::shared_ptr<io::data>& d, time_t deadline);
+  void set_notifier(std::function<void()> const& notifier);
   void set_read_filters(filters const& fltrs);
   void set_write_filters(filters const& fltrs);
   filters const& get_read_filters() const;
@@ -74,6 +77,11 @@ class muxer : public io::stream {
   static std::string queue_file(std::string const& name);
 
  private:
+  // Nodes come from the events memory pool.
+  typedef std::list<std::shared_ptr<io::data>,
+                    io::pool_allocator<std::shared_ptr<io::data>>>
+      event_list;
+
   void _clean();
   void _get_event_from_file(std::shared_ptr<io::data>& event);
   std::string _memory_file() const;
@@ -81,14 +89,15 @@ class muxer : public io::stream {
   std::string _queue_file() const;
 
   std::condition_variable _cv;
-  std::list<std::shared_ptr<io::data>> _events;
+  event_list _events;
   uint32_t _events_size;
   static uint32_t _event_queue_max_size;
   std::unique_ptr<persistent_file> _file;
   mutable std::mutex _mutex;
   std::string _name;
+  std::function<void()> _notifier;
   bool _persistent;
-  std::list<std::shared_ptr<io::data>>::iterator _pos;
+  event_list::iterator _pos;
   filters _read_filters;
   filters _write_filters;
   std::string _read_filters_str;
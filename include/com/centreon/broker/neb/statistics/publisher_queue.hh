@@ -0,0 +1,48 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_NEB_STATISTICS_PUBLISHER_QUEUE_HH
+#define CCB_NEB_STATISTICS_PUBLISHER_QUEUE_HH
+
+#include <string>
+#include "com/centreon/broker/namespace.hh"
+#include "com/centreon/broker/neb/statistics/plugin.hh"
+
+CCB_BEGIN()
+
+namespace neb {
+namespace statistics {
+/**
+ *  @class publisher_queue publisher_queue.hh
+ * "com/centreon/broker/neb/statistics/publisher_queue.hh"
+ *  @brief publisher_queue statistics plugin.
+ */
+class publisher_queue : public plugin {
+ public:
+  publisher_queue();
+  publisher_queue(publisher_queue const& right);
+  ~publisher_queue();
+  publisher_queue& operator=(publisher_queue const& right);
+  void run(std::string& output, std::string& perfdata);
+};
+}  // namespace statistics
+}  // namespace neb
+
+CCB_END()
+
+#endif  // !CCB_NEB_STATISTICS_PUBLISHER_QUEUE_HH
@@ -0,0 +1,123 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_PROCESSING_EXECUTOR_HH
+#define CCB_PROCESSING_EXECUTOR_HH
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "com/centreon/broker/namespace.hh"
+
+CCB_BEGIN()
+
+namespace processing {
+/**
+ *  @class executor executor.hh "com/centreon/broker/processing/executor.hh"
+ *  @brief Run endpoints on a fixed pool of threads.
+ *
+ *  Feeders and failovers are tasks instead of threads. A task runs a
+ *  slice of work and returns the delay before its next run. It is run
+ *  earlier when notified, for example when its muxer or its stream has
+ *  data. A task never runs on two threads at once, so the events of an
+ *  endpoint keep their order.
+ *
+ *  Each thread has its own queue of ready tasks and steals tasks from
+ *  the other queues when its own one is empty.
+ */
+class executor {
+ public:
+  /**
+   *  @class task executor.hh "com/centreon/broker/processing/executor.hh"
+   *  @brief Task of the executor.
+   *
+   *  Its function returns the delay in milliseconds before it should run
+   *  again, 0 to run again as soon as possible or a negative value once
+   *  it is finished.
+   */
+  class task : public std::enable_shared_from_this<task> {
+    friend class executor;
+
+    enum state { idle, queued, running, running_notified, finished };
+
+    executor& _owner;
+    std::function<int()> _run;
+    std::atomic<int> _state;
+    std::atomic_bool _removed;
+    // Pending timer, protected by the executor mutex.
+    std::chrono::steady_clock::time_point _timer;
+
+   public:
+    task(executor& owner, std::function<int()> const& run);
+    task(task const&) = delete;
+    task& operator=(task const&) = delete;
+    void notify();
+  };
+
+  static executor& instance();
+  static void load(uint32_t threads_count = 0);
+  static void unload();
+
+  executor(executor const&) = delete;
+  executor& operator=(executor const&) = delete;
+  std::shared_ptr<task> add(std::function<int()> const& run);
+  uint32_t get_threads_count() const noexcept;
+  void remove(std::shared_ptr<task> const& t);
+
+ private:
+  typedef std::chrono::steady_clock::time_point time_point;
+
+  struct worker_queue {
+    std::mutex m;
+    std::deque<std::shared_ptr<task>> tasks;
+  };
+
+  executor(uint32_t threads_count);
+  ~executor();
+  void _add_timer(std::shared_ptr<task> const& t, int delay);
+  std::shared_ptr<task> _pop(uint32_t index);
+  void _push(std::shared_ptr<task> const& t);
+  void _run(std::shared_ptr<task> const& t);
+  void _work(uint32_t index);
+
+  static executor* _instance;
+
+  std::vector<std::unique_ptr<worker_queue>> _queues;
+  std::atomic<uint32_t> _next_queue;
+  std::atomic<uint32_t> _queued;
+  std::atomic<uint32_t> _sleepers;
+  std::vector<std::thread> _threads;
+
+  // Timers, sleeping threads and removals.
+  std::mutex _m;
+  std::condition_variable _cv;
+  std::condition_variable _removed_cv;
+  std::vector<std::pair<time_point, std::shared_ptr<task>>> _timers;
+  std::atomic_bool _exit;
+};
+}  // namespace processing
+
+CCB_END()
+
+#endif  // !CCB_PROCESSING_EXECUTOR_HH
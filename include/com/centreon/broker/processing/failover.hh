@@ -21,14 +21,18 @@
 
 #include <climits>
 #include <ctime>
+#include <functional>
+#include <future>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include "com/centreon/broker/io/endpoint.hh"
 #include "com/centreon/broker/io/stream.hh"
 #include "com/centreon/broker/multiplexing/subscriber.hh"
 #include "com/centreon/broker/namespace.hh"
 #include "com/centreon/broker/processing/acceptor.hh"
+#include "com/centreon/broker/processing/executor.hh"
 #include "com/centreon/broker/processing/thread.hh"
 
 CCB_BEGIN()
@@ -48,7 +52,19 @@ namespace processing {
  *
  *  Thread that provide failover on output endpoints.
  *
- *  Multiple failover can be forwarded.
+ *  Multiple failover can be forwarded. The failover does not run on its
+ *  own thread but is a task of the executor. It goes through the
+ *  opening, buffering, starting, running and waiting steps, the running
+ *  step is run when the stream or the muxer has data. Opening streams
+ *  and exiting the failover of the endpoint may block, this is done by
+ *  a job thread so that executor threads never wait for them.
+ *
+ *  Reads and writes of the running step are done by the slice itself.
+ *  A slice processes at most 1000 events, but a stream write that
+ *  blocks (a full TCP peer, a slow database) keeps its executor thread
+ *  busy until it returns. Endpoints that may block for long should
+ *  bound their writes with their own timeouts, or the executor should
+ *  have more threads than such failovers.
  */
 class failover : public bthread {
   friend class stats::builder;
@@ -65,10 +81,11 @@ class failover : public bthread {
   time_t get_buffering_timeout() const throw();
   bool get_initialized() const throw();
   time_t get_retry_interval() const throw();
-  void run() override;
+  bool is_running() const override;
   void set_buffering_timeout(time_t secs);
   void set_failover(std::shared_ptr<processing::failover> fo);
   void set_retry_interval(time_t retry_interval);
+  void start() override;
   void update() override;
   //bool wait(unsigned long time = ULONG_MAX);
 
@@ -79,8 +96,17 @@ class failover : public bthread {
   virtual void _forward_statistic(json11::Json::object& tree) override;
 
  private:
+  enum step { opening, buffering, starting, running, waiting };
+
   void _launch_failover();
+  void _open();
+  void _open_secondaries();
+  int _process();
+  int _run() noexcept;
+  void _start_processing();
+  void _stop();
   void _update_status(std::string const& status);
+  bool _wait_job(std::function<void()> const& job);
 
   // Data that doesn't require locking.
   volatile time_t _buffering_timeout;
@@ -94,6 +120,24 @@ class failover : public bthread {
   std::shared_ptr<multiplexing::subscriber> _subscriber;
   volatile bool _update;
 
+  // Task.
+  std::shared_ptr<executor::task> _task;
+  mutable std::mutex _task_m;
+
+  // Data only used by the task.
+  step _step;
+  time_t _step_end;
+  std::vector<std::shared_ptr<io::stream> > _secondaries;
+  bool _stream_can_read;
+  bool _muxer_can_read;
+  bool _should_commit;
+  bool _stream_notifies;
+  time_t _fill_stats_time;
+
+  // Job blocking on I/O, run on its own thread.
+  std::thread _job_thread;
+  std::future<void> _job;
+
   // Status.
   std::string _status;
   mutable std::mutex _status_m;
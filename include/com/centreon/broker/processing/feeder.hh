@@ -19,15 +19,15 @@
 #ifndef CCB_PROCESSING_FEEDER_HH
 #define CCB_PROCESSING_FEEDER_HH
 
-#include <atomic>
-#include <condition_variable>
-#include <thread>
 #include <climits>
+#include <ctime>
 #include <memory>
+#include <mutex>
 #include <string>
 #include "com/centreon/broker/misc/shared_mutex.hh"
 #include "com/centreon/broker/multiplexing/subscriber.hh"
 #include "com/centreon/broker/namespace.hh"
+#include "com/centreon/broker/processing/executor.hh"
 #include "com/centreon/broker/processing/stat_visitable.hh"
 
 CCB_BEGIN()
@@ -42,19 +42,20 @@ namespace processing {
  *  @class feeder feeder.hh "com/centreon/broker/processing/feeder.hh"
  *  @brief Feed events from a source to a destination.
  *
- *  Take events from a source and send them to a destination.
+ *  Take events from a source and send them to a destination. The feeder
+ *  is a task of the executor, run when its client stream or its muxer
+ *  has data.
  */
 class feeder : public stat_visitable {
-  // Condition variable used when waiting for the thread to finish
-  std::thread _thread;
-  bool _started;
-  mutable std::mutex _started_m;
-  std::condition_variable _started_cv;
-  bool _stopped;
-  mutable std::mutex _stopped_m;
-  std::condition_variable _stopped_cv;
+  std::shared_ptr<executor::task> _task;
+  bool _finished;
+  mutable std::mutex _task_m;
 
-  std::atomic_bool _should_exit;
+  // Data only used by the task.
+  bool _stream_can_read;
+  bool _muxer_can_read;
+  bool _stream_notifies;
+  time_t _fill_stats_time;
 
   std::shared_ptr<io::stream> _client;
   multiplexing::subscriber _subscriber;
@@ -62,7 +63,8 @@ class feeder : public stat_visitable {
   // This mutex is used for the stat thread.
   mutable misc::shared_mutex _client_m;
 
-  void _callback() noexcept;
+  int _run() noexcept;
+  void _stop();
 
  protected:
   std::string const& _get_read_filters() const override;
@@ -54,10 +54,10 @@ class bthread : public stat_visitable {
   virtual ~bthread();
   virtual void exit();
   bool should_exit() const;
-  void start();
+  virtual void start();
   virtual void update();
   virtual void run() {};
-  bool is_running() const;
+  virtual bool is_running() const;
 
  private:
   std::atomic_bool _should_exit;
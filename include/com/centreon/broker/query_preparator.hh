@@ -31,7 +31,8 @@ CCB_BEGIN()
  * "com/centreon/broker/query_preparator.hh"
  *  @brief Prepare database queries.
  *
- *  Prepare queries using event mappings.
+ *  Prepare queries using event mappings. Prepared statements come with
+ *  the bind plan of the event, so events are bound without any lookup.
  */
 class query_preparator {
  public:
@@ -21,6 +21,7 @@
 
 #include <ctime>
 #include <string>
+#include <vector>
 #include "com/centreon/broker/namespace.hh"
 
 CCB_BEGIN()
@@ -54,6 +55,7 @@ class backend {
                     short value_type = 0) = 0;
   virtual void remove(std::string const& filename) = 0;
   virtual void update(time_t t, std::string const& value) = 0;
+  virtual void update(std::vector<std::string> const& pts) = 0;
 };
 }  // namespace rrd
 
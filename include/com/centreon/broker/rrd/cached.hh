@@ -65,6 +65,7 @@ class cached : public backend {
             short value_type = 0);
   void remove(std::string const& filename);
   void update(time_t t, std::string const& value);
+  void update(std::vector<std::string> const& pts);
 
  private:
   template <typename T>
@@ -52,6 +52,7 @@ class lib : public backend {
             short value_type = 0);
   void remove(std::string const& filename);
   void update(time_t t, std::string const& value);
+  void update(std::vector<std::string> const& pts);
 
  private:
   creator _creator;
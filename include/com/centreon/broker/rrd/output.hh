@@ -69,6 +69,8 @@ class output : public io::stream {
  private:
   output(output const& o);
   output& operator=(output const& o);
+  static std::string _metric_value(short value_type, double value);
+  static std::string _status_value(short state);
 
   std::unique_ptr<backend> _backend;
   bool _ignore_update_errors;
@@ -0,0 +1,77 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCB_STORAGE_REBUILD_DATA_HH
+#define CCB_STORAGE_REBUILD_DATA_HH
+
+#include <ctime>
+#include <string>
+#include "com/centreon/broker/io/data.hh"
+#include "com/centreon/broker/io/event_info.hh"
+#include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/mapping/entry.hh"
+#include "com/centreon/broker/namespace.hh"
+#include "com/centreon/broker/storage/internal.hh"
+
+CCB_BEGIN()
+
+namespace storage {
+/**
+ *  @class rebuild_data rebuild_data.hh
+ * "com/centreon/broker/storage/rebuild_data.hh"
+ *  @brief Values of a graph being rebuilt.
+ *
+ *  Many values of a metric or of a status, in time order. They are sent
+ *  by the rebuilder between the start and the end rebuild events.
+ */
+class rebuild_data : public io::data {
+ public:
+  rebuild_data();
+  rebuild_data(uint32_t id,
+               bool is_index,
+               uint32_t interval,
+               uint32_t rrd_len,
+               short value_type);
+  rebuild_data(rebuild_data const& right);
+  ~rebuild_data() = default;
+  rebuild_data& operator=(rebuild_data const& right);
+  constexpr static uint32_t static_type() {
+    return io::events::data_type<io::events::storage,
+                                 storage::de_rebuild_data>::value;
+  }
+  void add_value(time_t ctime, double value);
+  bool next_value(size_t& pos, time_t& ctime, double& value) const;
+
+  uint32_t id;
+  uint32_t interval;
+  bool is_index;
+  uint32_t rrd_len;
+  short value_type;
+  std::string values;
+
+  static mapping::entry const entries[];
+  static io::event_info::event_operations const operations;
+
+ private:
+  void _internal_copy(rebuild_data const& right);
+};
+}  // namespace storage
+
+CCB_END()
+
+#endif  // !CCB_STORAGE_REBUILD_DATA_HH
@@ -20,6 +20,7 @@
 #define CCB_STORAGE_REBUILDER_HH
 
 #include <memory>
+#include <thread>
 
 #include "com/centreon/broker/database_config.hh"
 #include "com/centreon/broker/mysql.hh"
@@ -63,9 +64,8 @@ class rebuilder {
   rebuilder& operator=(rebuilder const& other);
   void _next_index_to_rebuild(index_info& info, mysql& ms);
   void _rebuild_metric(mysql& ms,
+                       int thread_id,
                        uint32_t metric_id,
-                       uint32_t host_id,
-                       uint32_t service_id,
                        std::string const& metric_name,
                        short metric_type,
                        uint32_t interval,
@@ -87,6 +87,12 @@ class rebuilder {
   std::condition_variable _cond_should_exit;
   std::mutex _mutex_should_exit;
   volatile bool _should_exit;
+  uint32_t _threads_count;
+
+  // Maximum number of metrics rebuilt at the same time.
+  static constexpr uint32_t max_threads = 4;
+  // Maximum number of values in a rebuild_data event.
+  static constexpr uint32_t values_per_event = 5000;
 };
 }  // namespace storage
 
@@ -52,6 +52,7 @@ class stream : public io::stream {
   std::string peer() const;
   bool read(std::shared_ptr<io::data>& d, time_t deadline);
   void set_parent(acceptor* parent);
+  bool set_read_notifier(std::function<void()> const& notifier) override;
   void set_read_timeout(int secs);
   void set_write_timeout(int secs);
   int write(std::shared_ptr<io::data> const& d);
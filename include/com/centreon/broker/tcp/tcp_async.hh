@@ -19,6 +19,7 @@
 #define CENTREON_BROKER_TCP_INC_COM_CENTREON_BROKER_TCP_TCP_ASYNC_HH_
 
 #include <asio.hpp>
+#include <functional>
 #include <queue>
 #include <thread>
 #include <unordered_map>
@@ -41,6 +42,9 @@ struct tcp_con {
   // waiting for data
   std::condition_variable _wait_socket_event;
 
+  // called when data or disconnection arrives
+  std::function<void()> _notifier;
+
   tcp_con() : _timer{nullptr}, _closing{false}, _timeout{false} {};
 };
 
@@ -82,6 +86,8 @@ class tcp_async {
  public:
   void register_socket(asio::ip::tcp::socket& socket);
   void unregister_socket(asio::ip::tcp::socket& socket, bool sync);
+  void set_read_notifier(asio::ip::tcp::socket& socket,
+                         std::function<void()> const& notifier);
 
   async_buf wait_for_packet(asio::ip::tcp::socket& socket,
                             time_t deadline,
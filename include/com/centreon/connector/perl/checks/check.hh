@@ -53,12 +53,16 @@ class check : public handle_listener {
   void on_timeout(bool final = true);
   void read(handle& h) override;
   void terminated(int exit_code);
+  void terminated(int exit_code,
+                  std::string const& output,
+                  std::string const& error);
   void unlisten(listener* listnr);
   bool want_read(handle& h) override;
   void write(handle& h) override;
 
  private:
 
+  void _kill(int signum);
   void _send_result_and_unregister(result const& r);
 
   pid_t _child;
@@ -41,6 +41,7 @@ CCCP_BEGIN()
 class embedded_perl {
  public:
   ~embedded_perl();
+  int execute(std::string const& cmd, std::string& output, std::string& error);
   static embedded_perl& instance();
   static void load(int* argc,
                    char*** argv,
@@ -53,6 +54,7 @@ class embedded_perl {
   embedded_perl(int* argc, char*** argv, char*** env, char const* code = NULL);
   embedded_perl(embedded_perl const& ep);
   embedded_perl& operator=(embedded_perl const& ep);
+  SV* _compile(std::string const& file);
 
   umap<std::string, SV*> _parsed;
   static char const* const _script;
@@ -0,0 +1,119 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCCP_WORKER_POOL_HH
+#define CCCP_WORKER_POOL_HH
+
+#include <sys/types.h>
+
+#include <deque>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "com/centreon/connector/perl/namespace.hh"
+#include "com/centreon/connector/perl/pipe_handle.hh"
+#include "com/centreon/handle_listener.hh"
+
+CCCP_BEGIN()
+
+/**
+ *  @class worker_pool worker_pool.hh
+ * "com/centreon/connector/perl/worker_pool.hh"
+ *  @brief Pool of pre-forked Perl interpreters.
+ *
+ *  Workers are forked once the embedded interpreter is loaded. Each one
+ *  keeps its own cache of compiled scripts and runs the checks it
+ *  receives on a pipe within its process, sending back the exit code
+ *  and outputs on another pipe. Checks wait in a queue while all the
+ *  workers are busy. A worker is replaced after a given number of
+ *  checks or when its resident memory exceeds a limit.
+ *
+ *  Checks are identified by negative numbers lower than -1 so that
+ *  they can be stored along forked processes' PIDs.
+ */
+class worker_pool {
+ public:
+  struct completion {
+    pid_t id;
+    int exit_code;
+    std::string output;
+    std::string error;
+  };
+
+  ~worker_pool();
+  std::list<completion> completions();
+  static bool enabled() noexcept;
+  static worker_pool& instance();
+  void kill(pid_t id, int signum);
+  static void load(uint32_t size,
+                   uint32_t max_checks,
+                   uint32_t max_memory);
+  void on_exit(pid_t pid);
+  pid_t run(std::string const& cmd);
+  static void unload();
+
+ private:
+  class worker : public handle_listener {
+   public:
+    worker(worker_pool& pool);
+    ~worker() noexcept;
+    worker(worker const& w) = delete;
+    worker& operator=(worker const& w) = delete;
+    void error(handle& h) override;
+    void read(handle& h) override;
+    void retire() noexcept;
+    bool send(pid_t id, std::string const& request);
+    bool want_read(handle& h) override;
+
+    pid_t pid;
+    pid_t running;
+    bool dead;
+    uint32_t checks;
+    uint32_t memory;
+
+   private:
+    void _parse();
+
+    std::string _buffer;
+    worker_pool& _pool;
+    pipe_handle _request;
+    pipe_handle _response;
+  };
+
+  worker_pool(uint32_t size, uint32_t max_checks, uint32_t max_memory);
+  worker_pool(worker_pool const& wp) = delete;
+  worker_pool& operator=(worker_pool const& wp) = delete;
+  void _dispatch();
+  void _release(worker* w);
+  static void _serve(int request, int response);
+
+  std::list<completion> _completions;
+  uint32_t _max_checks;
+  uint32_t _max_memory;
+  pid_t _next_id;
+  std::deque<std::pair<pid_t, std::string>> _queue;
+  std::list<std::unique_ptr<worker>> _retired;
+  std::vector<std::unique_ptr<worker>> _workers;
+};
+
+CCCP_END()
+
+#endif  // !CCCP_WORKER_POOL_HH
@@ -31,18 +31,22 @@ CCCS_BEGIN()
  *  @brief Multiplexing class.
  *
  *  Singleton that aggregates multiplexing features such as file
- *  descriptor monitoring and task execution.
+ *  descriptor monitoring and task execution. Threads running their own
+ *  event loop can load a local instance that is returned instead of the
+ *  global one within this thread.
  */
 class multiplexer : public com::centreon::task_manager,
                     public com::centreon::handle_manager {
-  multiplexer();
+  multiplexer(uint32_t max_thread_count = 0);
 
  public:
   static multiplexer& instance() noexcept;
   multiplexer(multiplexer const& m) = delete;
   multiplexer& operator=(multiplexer const& m) = delete;
   static void load();
+  static void load_local();
   static void unload();
+  static void unload_local();
 };
 
 CCCS_END()
@@ -0,0 +1,54 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCCS_NOTIFIER_HH
+#define CCCS_NOTIFIER_HH
+
+#include "com/centreon/connector/ssh/namespace.hh"
+#include "com/centreon/connector/ssh/sessions/socket_handle.hh"
+#include "com/centreon/handle_listener.hh"
+
+CCCS_BEGIN()
+
+/**
+ *  @class notifier notifier.hh "com/centreon/connector/ssh/notifier.hh"
+ *  @brief Wake up a multiplexer from another thread.
+ *
+ *  Pipe whose read end is monitored by a multiplexer. Writing to it
+ *  makes the thread waiting in this multiplexer return.
+ */
+class notifier : public com::centreon::handle_listener {
+ public:
+  notifier();
+  ~notifier() noexcept override;
+  notifier(notifier const& n) = delete;
+  notifier& operator=(notifier const& n) = delete;
+  void error(handle& h) override;
+  handle* get_handle() noexcept;
+  void notify();
+  void read(handle& h) override;
+  bool want_read(handle& h) override;
+
+ private:
+  sessions::socket_handle _read;
+  sessions::socket_handle _write;
+};
+
+CCCS_END()
+
+#endif  // !CCCS_NOTIFIER_HH
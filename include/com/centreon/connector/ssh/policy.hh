@@ -19,37 +19,36 @@
 #ifndef CCCS_POLICY_HH
 #define CCCS_POLICY_HH
 
-#include <map>
+#include <deque>
+#include <memory>
 #include <mutex>
-#include <utility>
+#include <unordered_set>
+#include <vector>
 #include "com/centreon/connector/ssh/checks/listener.hh"
+#include "com/centreon/connector/ssh/notifier.hh"
 #include "com/centreon/connector/ssh/orders/listener.hh"
 #include "com/centreon/connector/ssh/orders/parser.hh"
 #include "com/centreon/connector/ssh/reporter.hh"
-#include "com/centreon/connector/ssh/sessions/credentials.hh"
+#include "com/centreon/connector/ssh/worker.hh"
 #include "com/centreon/io/file_stream.hh"
 #include "com/centreon/timestamp.hh"
 
 CCCS_BEGIN()
 
-// Forward declarations.
-namespace checks {
-class check;
-class result;
-}  // namespace checks
-namespace sessions {
-class session;
-}
-
 /**
  *  @class policy policy.hh "com/centreon/connector/ssh/policy.hh"
  *  @brief Software policy.
  *
- *  Manage program execution.
+ *  Manage program execution. Checks are dispatched to workers by
+ *  credentials, so that sessions of a host are always handled by the
+ *  same worker. Results are sent back to the monitoring engine from
+ *  the main thread.
  */
 class policy : public orders::listener, public checks::listener {
  public:
-  policy();
+  policy(uint32_t threads = 1,
+         uint32_t max_sessions = 1,
+         uint32_t max_channels = 10);
   ~policy() noexcept override;
   void on_eof() override;
   void on_error(uint64_t cmd_id, char const* msg) override;
@@ -73,14 +72,18 @@ class policy : public orders::listener, public checks::listener {
   policy(policy const& p);
   policy& operator=(policy const& p);
 
-  std::map<uint64_t, std::pair<checks::check*, sessions::session*> > _checks;
+  void _report();
+
+  std::unordered_set<uint64_t> _checks;
   bool _error;
   std::mutex _mutex;
+  notifier _notifier;
   orders::parser _parser;
   reporter _reporter;
-  std::map<sessions::credentials, sessions::session*> _sessions;
+  std::deque<checks::result> _results;
   io::file_stream _sin;
   io::file_stream _sout;
+  std::vector<std::unique_ptr<worker> > _workers;
 };
 
 CCCS_END()
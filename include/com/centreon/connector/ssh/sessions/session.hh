@@ -47,6 +47,7 @@ class session : public com::centreon::handle_listener {
   void connect(bool use_ipv6 = false);
   void error();
   void error(handle& h) override;
+  size_t get_channel_count() const noexcept;
   credentials const& get_credentials() const noexcept;
   LIBSSH2_SESSION* get_libssh2_session() const noexcept;
   socket_handle* get_socket_handle() noexcept;
@@ -0,0 +1,110 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#ifndef CCCS_WORKER_HH
+#define CCCS_WORKER_HH
+
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "com/centreon/connector/ssh/checks/listener.hh"
+#include "com/centreon/connector/ssh/notifier.hh"
+#include "com/centreon/connector/ssh/sessions/credentials.hh"
+#include "com/centreon/timestamp.hh"
+
+CCCS_BEGIN()
+
+// Forward declarations.
+namespace checks {
+class check;
+}
+namespace sessions {
+class session;
+}
+
+/**
+ *  @class worker worker.hh "com/centreon/connector/ssh/worker.hh"
+ *  @brief Thread running checks on its own set of SSH sessions.
+ *
+ *  Each worker runs its own multiplexer, so the key exchange or the
+ *  output of a host does not delay sessions handled by other workers.
+ *  A worker keeps up to max_sessions sessions per credentials: checks
+ *  are run on the session with the fewest channels, and a new session
+ *  is opened once every session of the credentials runs max_channels
+ *  checks.
+ *
+ *  Results are sent to the listener from the worker thread.
+ */
+class worker : public checks::listener {
+ public:
+  worker(checks::listener& listnr,
+         uint32_t max_sessions,
+         uint32_t max_channels);
+  ~worker() noexcept override;
+  worker(worker const& w) = delete;
+  worker& operator=(worker const& w) = delete;
+  void execute(uint64_t cmd_id,
+               timestamp const& timeout,
+               sessions::credentials const& creds,
+               std::list<std::string> const& cmds,
+               int skip_stdout,
+               int skip_stderr,
+               bool use_ipv6);
+  void on_result(checks::result const& r) override;
+  void start();
+  void stop();
+
+ private:
+  struct request {
+    uint64_t cmd_id;
+    timestamp timeout;
+    sessions::credentials creds;
+    std::list<std::string> cmds;
+    int skip_stdout;
+    int skip_stderr;
+    bool use_ipv6;
+  };
+
+  void _callback();
+  void _close();
+  void _execute(request const& r);
+  sessions::session* _session_for(sessions::credentials const& creds,
+                                  bool use_ipv6);
+
+  std::map<uint64_t, std::pair<checks::check*, sessions::session*> > _checks;
+  bool _exit;
+  checks::listener& _listnr;
+  uint32_t _max_channels;
+  uint32_t _max_sessions;
+  std::mutex _mutex;
+  notifier _notifier;
+  std::deque<request> _requests;
+  std::map<sessions::credentials, std::vector<sessions::session*> >
+      _sessions;
+  std::thread _thread;
+};
+
+CCCS_END()
+
+#endif  // !CCCS_WORKER_HH
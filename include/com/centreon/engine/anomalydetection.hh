@@ -21,23 +21,71 @@
 #define CCE_ANOMALYDETECTION_HH
 
 #include <json11.hpp>
-#include <map>
+#include <memory>
 #include <mutex>
 #include <tuple>
+#include <vector>
 
 #include "com/centreon/engine/service.hh"
 
 CCE_BEGIN()
 
 class anomalydetection : public service {
+ public:
+  /**
+   *  One prediction. This is also the layout of predictions in binary
+   *  thresholds files.
+   */
+  struct threshold_point {
+    int64_t timestamp;
+    double lower;
+    double upper;
+  };
+
+  /**
+   *  Immutable predictions sorted by timestamp. They are stored either in
+   *  an owned vector or directly in the buffer of a binary file.
+   */
+  class threshold_set {
+    std::shared_ptr<void const> _storage;
+    threshold_point const* _begin;
+    size_t _size;
+
+   public:
+    threshold_set(std::vector<threshold_point>&& points);
+    threshold_set(std::shared_ptr<void const> storage,
+                  threshold_point const* begin,
+                  size_t size);
+    threshold_set(threshold_set const&) = delete;
+    threshold_set& operator=(threshold_set const&) = delete;
+    threshold_point const* begin() const noexcept { return _begin; }
+    threshold_point const* end() const noexcept { return _begin + _size; }
+    size_t size() const noexcept { return _size; }
+  };
+
+  /**
+   *  Predictions of one anomaly detection service read from a file.
+   */
+  struct thresholds_entry {
+    uint64_t host_id;
+    uint64_t service_id;
+    std::string metric_name;
+    std::shared_ptr<threshold_set const> thresholds;
+  };
+
+ private:
   service* _dependent_service;
   std::string _metric_name;
   std::string _thresholds_file;
   bool _status_change;
-  bool _thresholds_file_viable;
-  std::map<time_t, std::pair<double, double> > _thresholds;
+  std::shared_ptr<threshold_set const> _thresholds;
   std::mutex _thresholds_m;
 
+  static int _parse_json_thresholds(std::string const& filename,
+                                    std::vector<thresholds_entry>& entries);
+  static int _parse_binary_thresholds(std::string const& filename,
+                                      std::vector<thresholds_entry>& entries);
+
  public:
   anomalydetection(uint64_t host_id,
                    uint64_t service_id,
@@ -81,8 +129,15 @@ class anomalydetection : public service {
   void set_thresholds_file(std::string const& file);
   void set_thresholds(
       const std::string& filename,
-      std::map<time_t, std::pair<double, double> >&& thresholds) noexcept;
+      std::shared_ptr<threshold_set const> thresholds) noexcept;
+  std::shared_ptr<threshold_set const> get_thresholds() const noexcept;
+  static int parse_thresholds_file(std::string const& filename,
+                                   std::vector<thresholds_entry>& entries);
+  static int apply_thresholds(std::string const& filename,
+                              std::vector<thresholds_entry> const& entries);
   static int update_thresholds(const std::string& filename);
+  static void update_thresholds_async(std::string const& filename);
+  static void stop_thresholds_updates();
   virtual int run_async_check(int check_options,
                               double latency,
                               bool scheduled_check,
@@ -23,6 +23,7 @@
 #include <queue>
 
 #include "com/centreon/engine/anomalydetection.hh"
+#include "com/centreon/engine/checks/reachability.hh"
 #include "com/centreon/engine/commands/command.hh"
 
 CCE_BEGIN()
@@ -53,6 +54,7 @@ class checker : public commands::command_listener {
   void add_check_result(uint64_t id, check_result* result) noexcept;
   void add_check_result_to_reap(check_result* result) noexcept;
   static void forget(notifier* n) noexcept;
+  reachability& get_reachability() noexcept;
 
  private:
   checker();
@@ -81,6 +83,10 @@ class checker : public commands::command_listener {
   /* Due to reloads of centengine we have the following list with notifiers
    * that should be forgotten if notifiers are removed. */
   std::deque<notifier*> _to_forget;
+
+  /* Hosts waiting for their parents checks to know if they are DOWN or
+   * UNREACHABLE. */
+  reachability _reachability;
 };
 }  // namespace checks
 
@@ -0,0 +1,87 @@
+/*
+** Copyright 2020 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CHECKS_REACHABILITY_HH
+#define CCE_CHECKS_REACHABILITY_HH
+
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "com/centreon/engine/host.hh"
+
+CCE_BEGIN()
+
+namespace checks {
+/**
+ *  @class reachability reachability.hh
+ * "com/centreon/engine/checks/reachability.hh"
+ *  @brief Tell asynchronously whether a host is DOWN or UNREACHABLE.
+ *
+ *  A host that goes down with a single check attempt is DOWN if one of
+ *  its parents is UP and UNREACHABLE otherwise. Parents whose state is
+ *  older than the cached check horizon are checked in parallel and the
+ *  state transition of the host is finished once their results are
+ *  processed. A parent check is shared by all the children waiting on
+ *  it.
+ */
+class reachability {
+ public:
+  typedef std::function<void(host::host_state)> callback;
+
+  reachability() = default;
+  reachability(reachability const&) = delete;
+  reachability& operator=(reachability const&) = delete;
+  void cancel(host* hst);
+  void clear() noexcept;
+  void flush();
+  void forget(host* hst);
+  bool is_pending(host const* hst) const noexcept;
+  void notify(host* hst);
+  bool resolve(host* hst,
+               int check_options,
+               int use_cached_result,
+               unsigned long check_timestamp_horizon,
+               host::host_state& state,
+               callback&& finish);
+
+ private:
+  struct pending {
+    std::unordered_set<host*> parents;
+    callback finish;
+  };
+
+  typedef std::unordered_map<host const*, pending> pending_map;
+
+  void _finish(host* hst, host::host_state state);
+  void _remove(pending_map::iterator it);
+
+  // Children waiting for the results of their parents.
+  pending_map _pending;
+  // Children that lost all the parents they were waiting on.
+  std::vector<host*> _ready;
+  // Parents being checked, with their waiting children.
+  std::unordered_map<host const*, std::unordered_set<host*>> _waiters;
+};
+}  // namespace checks
+
+CCE_END()
+
+#endif  // !CCE_CHECKS_REACHABILITY_HH
@@ -20,29 +20,57 @@
 #ifndef CCE_COMMAND_MANAGER_HH
 #define CCE_COMMAND_MANAGER_HH
 
+#include <chrono>
+#include <condition_variable>
 #include <deque>
 #include <future>
 #include <mutex>
+#include <vector>
 
 #include "com/centreon/engine/engine_impl.hh"
 #include "com/centreon/engine/host.hh"
 #include "com/centreon/engine/namespace.hh"
+#include "com/centreon/engine/service.hh"
 
 CCE_BEGIN()
 class command_manager {
   std::mutex _queue_m;
   std::deque<std::packaged_task<int()>> _queue;
+  std::mutex _results_m;
+  std::condition_variable _results_cv;
+  std::deque<std::vector<Check>> _results;
+  size_t _results_size;
   command_manager();
+  static int _submit_passive_service_check(service* svc,
+                                           time_t check_time,
+                                           uint32_t return_code,
+                                           const std::string& output);
 
  public:
+  /* Passive check results are queued by chunks of this size at most. */
+  static constexpr size_t check_results_chunk = 1024;
+  /* Maximum number of passive check results handled by execute(). */
+  static constexpr size_t check_results_per_execute = 16384;
+  /* Passive check results waiting for the main loop are limited to this
+   * number, producers wait beyond. */
+  static constexpr size_t check_results_max = 65536;
+
   static command_manager& instance();
   void enqueue(std::packaged_task<int(void)>&& f);
+  bool enqueue_check_results(std::vector<Check>&& results,
+                             std::chrono::milliseconds timeout);
+  size_t process_check_results(size_t max = check_results_per_execute);
 
   int process_passive_service_check(time_t check_time,
                                     const std::string& host_name,
                                     const std::string& svc_description,
                                     uint32_t return_code,
                                     const std::string& output);
+  int process_passive_service_check_by_id(time_t check_time,
+                                          uint64_t host_id,
+                                          uint64_t service_id,
+                                          uint32_t return_code,
+                                          const std::string& output);
   int process_passive_host_check(time_t check_time,
                                  const std::string& host_name,
                                  uint32_t return_code,
@@ -0,0 +1,91 @@
+/*
+** Copyright 2020 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_COMMAND_RING_HH
+#define CCE_COMMAND_RING_HH
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class command_ring command_ring.hh "com/centreon/engine/command_ring.hh"
+ *  @brief Lock-free queue of external command lines.
+ *
+ *  There must be exactly one producer (the command file worker thread)
+ *  and one consumer (the main loop). Slots are allocated once by
+ *  resize() and reused: a line is copied in a slot whose buffer is kept
+ *  from one use to the other, so no allocation is done once the ring
+ *  has warmed up.
+ */
+class command_ring {
+ public:
+  static size_t const slot_size = 1024;
+
+  command_ring();
+  command_ring(command_ring const& other) = delete;
+  ~command_ring() = default;
+  command_ring& operator=(command_ring const& other) = delete;
+
+  size_t capacity() const noexcept;
+  void clear() noexcept;
+  size_t high() const noexcept;
+  bool push(char const* line, size_t length);
+  void resize(size_t slots);
+  size_t size() const noexcept;
+
+  /**
+   *  Consume at most max_items lines. The consumed slots are given back
+   *  to the producer once the whole batch has been handled.
+   *
+   *  @param[in] max_items Maximum number of lines to consume.
+   *  @param[in] f         Function called with each line.
+   *
+   *  @return Number of lines consumed.
+   */
+  template <typename F>
+  size_t consume(size_t max_items, F&& f) {
+    size_t tail{_tail.load(std::memory_order_relaxed)};
+    size_t available{_head.load(std::memory_order_acquire) - tail};
+    if (available > max_items)
+      available = max_items;
+    for (size_t i{0}; i < available; ++i)
+      f(static_cast<std::string const&>(_slots[(tail + i) & _mask]));
+    _tail.store(tail + available, std::memory_order_release);
+    return available;
+  }
+
+ private:
+  std::vector<std::string> _slots;
+  size_t _capacity;
+  size_t _mask;
+  /* Written by the producer. */
+  alignas(64) std::atomic<size_t> _head;
+  std::atomic<size_t> _high;
+  /* Written by the consumer. */
+  alignas(64) std::atomic<size_t> _tail;
+};
+
+CCE_END()
+
+#endif  // !CCE_COMMAND_RING_HH
@@ -20,6 +20,7 @@
 #ifndef CCE_CONFIGURATION_APPLIER_DIFFERENCE_HH
 #define CCE_CONFIGURATION_APPLIER_DIFFERENCE_HH
 
+#include <cstdint>
 #include <iterator>
 #include "com/centreon/engine/namespace.hh"
 
@@ -65,7 +66,7 @@ class difference {
         *del++ = *first1++;
       else if (first1->key() != first2->key())
         *add++ = *first2++;
-      else if (*first1 != *first2) {
+      else if (!_same(*first1, *first2)) {
         *modif++ = *first2++;
         ++first1;
       } else {
@@ -79,6 +80,18 @@ class difference {
   }
 
  private:
+  /**
+   *  Objects supporting content hashes are compared by hash, the hash
+   *  of the old object being computed only once.
+   */
+  static bool _same(typename T::value_type const& old_obj,
+                    typename T::value_type const& new_obj) {
+    uint64_t old_hash(old_obj.content_hash());
+    if (old_hash)
+      return old_hash == new_obj.content_hash();
+    return old_obj == new_obj;
+  }
+
   T _added;
   T _deleted;
   T _modified;
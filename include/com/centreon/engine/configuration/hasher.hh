@@ -0,0 +1,134 @@
+/*
+** Copyright 2020 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_CONFIGURATION_HASHER_HH
+#define CCE_CONFIGURATION_HASHER_HH
+
+#include <cstdint>
+#include <list>
+#include <set>
+#include <string>
+#include <type_traits>
+#include "com/centreon/engine/configuration/group.hh"
+#include "com/centreon/engine/configuration/point_2d.hh"
+#include "com/centreon/engine/configuration/point_3d.hh"
+#include "com/centreon/engine/customvariable.hh"
+#include "com/centreon/engine/namespace.hh"
+#include "com/centreon/engine/opt.hh"
+
+CCE_BEGIN()
+
+namespace configuration {
+/**
+ *  @class hasher hasher.hh "com/centreon/engine/configuration/hasher.hh"
+ *  @brief Compute the content hash of configuration objects.
+ *
+ *  64 bits FNV-1a hash of the values given to operator<<. Values that
+ *  are equal for the configuration objects comparison operators give
+ *  the same hash: options and groups are hashed by their value only and
+ *  custom variables independently of their order.
+ */
+class hasher {
+ public:
+  hasher() : _hash(14695981039346656037ull) {}
+
+  void add(void const* data, size_t size) noexcept {
+    unsigned char const* p(static_cast<unsigned char const*>(data));
+    for (size_t i(0); i < size; ++i) {
+      _hash ^= p[i];
+      _hash *= 1099511628211ull;
+    }
+  }
+
+  template <typename T>
+  typename std::enable_if<std::is_arithmetic<T>::value, hasher&>::type
+  operator<<(T value) noexcept {
+    add(&value, sizeof(value));
+    return *this;
+  }
+
+  hasher& operator<<(std::string const& value) noexcept {
+    *this << value.size();
+    add(value.data(), value.size());
+    return *this;
+  }
+
+  template <typename T>
+  hasher& operator<<(opt<T> const& value) {
+    return *this << value.get();
+  }
+
+  template <typename T>
+  hasher& operator<<(group<T> const& value) {
+    return *this << value.get();
+  }
+
+  template <typename T>
+  hasher& operator<<(std::list<T> const& value) {
+    *this << value.size();
+    for (T const& v : value)
+      *this << v;
+    return *this;
+  }
+
+  template <typename T>
+  hasher& operator<<(std::set<T> const& value) {
+    *this << value.size();
+    for (T const& v : value)
+      *this << v;
+    return *this;
+  }
+
+  template <typename T, typename U>
+  hasher& operator<<(std::pair<T, U> const& value) {
+    return *this << value.first << value.second;
+  }
+
+  hasher& operator<<(point_2d const& value) noexcept {
+    return *this << value.x() << value.y();
+  }
+
+  hasher& operator<<(point_3d const& value) noexcept {
+    return *this << value.x() << value.y() << value.z();
+  }
+
+  hasher& operator<<(map_customvar const& value) {
+    uint64_t sum(0);
+    for (map_customvar::const_iterator it(value.begin()), end(value.end());
+         it != end; ++it) {
+      hasher h;
+      h << it->first << it->second.get_value() << it->second.is_sent();
+      sum += h.value();
+    }
+    return *this << value.size() << sum;
+  }
+
+  /**
+   *  Get the hash, never 0 since 0 means the hash is not computed.
+   */
+  uint64_t value() const noexcept { return _hash ? _hash : 1; }
+
+ private:
+  uint64_t _hash;
+};
+}  // namespace configuration
+
+CCE_END()
+
+#endif  // !CCE_CONFIGURATION_HASHER_HH
@@ -120,6 +120,8 @@ class host : public object {
  private:
   typedef bool (*setter_func)(host&, char const*);
 
+  uint64_t _hash() const override;
+
   bool _set_action_url(std::string const& value);
   bool _set_address(std::string const& value);
   bool _set_alias(std::string const& value);
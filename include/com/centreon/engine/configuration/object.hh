@@ -33,6 +33,8 @@ typedef std::set<std::string> set_string;
 CCE_BEGIN()
 
 namespace configuration {
+class hasher;
+
 class object {
  public:
   enum object_type {
@@ -61,6 +63,7 @@ class object {
   bool operator==(object const& right) const noexcept;
   bool operator!=(object const& right) const noexcept;
   virtual void check_validity() const = 0;
+  uint64_t content_hash() const;
   static std::shared_ptr<object> create(std::string const& type_name);
   virtual void merge(object const& obj) = 0;
   std::string const& name() const noexcept;
@@ -72,6 +75,10 @@ class object {
   object_type type() const noexcept;
   std::string const& type_name() const noexcept;
 
+  /* Warnings raised while parsing are counted there, config_warnings by
+   * default. Parsing threads count theirs apart and sum them after. */
+  static thread_local int* parse_warnings;
+
  protected:
   struct setters {
     char const* name;
@@ -95,10 +102,13 @@ class object {
     }
   };
 
+  virtual uint64_t _hash() const;
+  void _hash_object(hasher& h) const;
   bool _set_name(std::string const& value);
   bool _set_should_register(bool value);
   bool _set_templates(std::string const& value);
 
+  mutable uint64_t _content_hash;
   bool _is_resolve;
   std::string _name;
   static setters const _setters[];
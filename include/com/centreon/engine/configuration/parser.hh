@@ -22,7 +22,11 @@
 
 #include <fstream>
 #include <array>
+#include <exception>
+#include <list>
 #include <string>
+#include <utility>
+#include <vector>
 #include "com/centreon/engine/configuration/command.hh"
 #include "com/centreon/engine/configuration/connector.hh"
 #include "com/centreon/engine/configuration/contact.hh"
@@ -72,6 +76,26 @@ class parser {
  private:
   typedef void (parser::*store)(object_ptr obj);
 
+  /* An object definition split into lines, as read from a file. */
+  struct definition {
+    unsigned int line;
+    std::string type;
+    std::vector<std::pair<unsigned int, std::string>> lines;
+  };
+
+  /* The definitions of an object file. */
+  struct file_definitions {
+    std::string path;
+    std::vector<definition> definitions;
+  };
+
+  /* The objects built from an object file, filled by a parsing thread. */
+  struct file_objects {
+    std::list<std::pair<object_ptr, file_info>> objects;
+    std::exception_ptr error;
+    int warnings = 0;
+  };
+
   parser(parser const& right);
   parser& operator=(parser const& right);
   void _add_object(object_ptr obj);
@@ -80,6 +104,7 @@ class parser {
               void (parser::*pfunc)(std::string const&));
   void _apply_hostextinfo();
   void _apply_serviceextinfo();
+  void _build_objects(file_definitions const& file, file_objects& out) const;
   file_info const& _get_file_info(object* obj) const;
   void _get_hosts_by_hostgroups(hostgroup const& hostgroups, list_host& hosts);
   void _get_hosts_by_hostgroups_name(set_string const& lst_group,
@@ -93,11 +118,13 @@ class parser {
   static void _insert(list_object const& from, std::set<T>& to);
   template <typename T>
   static void _insert(map_object const& from, std::set<T>& to);
+  void _list_directory_configuration(std::string const& path);
+  void _list_object_definitions(std::string const& path);
   std::string const& _map_object_type(map_object const& objects) const throw();
-  void _parse_directory_configuration(std::string const& path);
   void _parse_global_configuration(std::string const& path);
-  void _parse_object_definitions(std::string const& path);
+  void _parse_object_files();
   void _parse_resource_file(std::string const& path);
+  static void _read_definitions(file_definitions& file);
   void _resolve_template();
   void _store_into_list(object_ptr obj);
   template <typename T, std::string const& (T::*ptr)() const throw()>
@@ -106,6 +133,7 @@ class parser {
   state* _config;
   unsigned int _current_line;
   std::string _current_path;
+  std::vector<file_definitions> _files;
   std::array<list_object, 16> _lst_objects;
   std::array<map_object, 16> _map_objects;
   std::unordered_map<object*, file_info> _objects_info;
@@ -130,6 +130,8 @@ class service : public object {
  private:
   typedef bool (*setter_func)(service&, char const*);
 
+  uint64_t _hash() const override;
+
   bool _set_action_url(std::string const& value);
   bool _set_check_command(std::string const& value);
   bool _set_checks_active(bool value);
@@ -311,6 +311,8 @@ class state {
   void retained_process_host_attribute_mask(unsigned long value);
   bool retain_state_information() const noexcept;
   void retain_state_information(bool value);
+  bool retention_binary_format() const noexcept;
+  void retention_binary_format(bool value);
   unsigned int retention_scheduling_horizon() const noexcept;
   void retention_scheduling_horizon(unsigned int value);
   unsigned int retention_update_interval() const noexcept;
@@ -363,6 +365,8 @@ class state {
   void state_retention_file(std::string const& value);
   std::string const& status_file() const noexcept;
   void status_file(std::string const& value);
+  std::string const& status_snapshot_file() const noexcept;
+  void status_snapshot_file(std::string const& value);
   unsigned int status_update_interval() const noexcept;
   void status_update_interval(unsigned int value);
   bool set(char const* key, char const* value);
@@ -569,6 +573,7 @@ class state {
   unsigned long _retained_host_attribute_mask;
   unsigned long _retained_process_host_attribute_mask;
   bool _retain_state_information;
+  bool _retention_binary_format;
   unsigned int _retention_scheduling_horizon;
   unsigned int _retention_update_interval;
   set_servicedependency _servicedependencies;
@@ -591,6 +596,7 @@ class state {
   bool _soft_state_dependencies;
   std::string _state_retention_file;
   std::string _status_file;
+  std::string _status_snapshot_file;
   unsigned int _status_update_interval;
   set_timeperiod _timeperiods;
   unsigned int _time_change_threshold;
@@ -21,7 +21,10 @@
 #define CCE_DOWNTIMES_DOWTIME_MANAGER_HH
 
 #include <map>
+#include <unordered_map>
+#include <vector>
 #include "com/centreon/engine/downtimes/downtime.hh"
+#include "com/centreon/pair.hh"
 
 CCE_BEGIN()
 
@@ -38,9 +41,13 @@ class downtime_manager {
   void delete_downtime(uint64_t downtime_id);
   int unschedule_downtime(uint64_t downtime_id);
   std::shared_ptr<downtime> find_downtime(downtime::type type, uint64_t downtime_id);
+  std::vector<std::shared_ptr<downtime>> find_downtimes(
+      downtime::type type,
+      std::string const& hostname,
+      std::string const& service_description) const;
   int check_pending_flex_host_downtime(host* hst);
   int check_pending_flex_service_downtime(service* svc);
-  void add_downtime(downtime* dt) noexcept;
+  bool add_downtime(downtime* dt) noexcept;
   void clear_scheduled_downtimes();
   int check_for_expired_downtime();
   int delete_downtime_by_hostname_service_description_start_time_comment(
@@ -48,7 +55,7 @@ class downtime_manager {
       std::string const& service_description,
       std::pair<bool, time_t> const& start_time,
       std::string const& comment);
-  void insert_downtime(std::shared_ptr<downtime> dt);
+  bool insert_downtime(std::shared_ptr<downtime> dt);
   void initialize_downtime_data();
   int xdddefault_validate_downtime_data();
   uint64_t get_next_downtime_id();
@@ -88,8 +95,27 @@ class downtime_manager {
   int register_downtime(downtime::type type, uint64_t downtime_id);
 
  private:
+  typedef std::multimap<time_t, std::shared_ptr<downtime>> time_index;
+  typedef std::pair<uint64_t, uint64_t> object_key;
+  struct index_entry {
+    time_index::iterator it;
+    object_key object;
+  };
+
   downtime_manager() = default;
-  std::multimap<time_t, std::shared_ptr<downtime>> _scheduled_downtimes;
+  time_index::iterator _erase(time_index::iterator it);
+  bool _insert(std::shared_ptr<downtime> const& dt);
+  void _append_object_downtimes(
+      object_key const& object,
+      downtime::type type,
+      std::string const& hostname,
+      std::string const& service_description,
+      std::vector<std::shared_ptr<downtime>>& downtimes) const;
+
+  time_index _scheduled_downtimes;
+  std::unordered_map<uint64_t, index_entry> _downtimes_by_id;
+  std::unordered_multimap<object_key, uint64_t> _downtimes_by_object;
+  std::unordered_multimap<uint64_t, uint64_t> _downtimes_by_trigger;
   uint64_t _next_id;
 };
 }  // namespace downtimes
@@ -34,9 +34,18 @@ class engine_impl final : public Engine::Service {
   grpc::Status ProcessServiceCheckResult(grpc::ServerContext* context,
                                          const Check* request,
                                          CommandSuccess* response) override;
+  grpc::Status ProcessServiceCheckResultById(grpc::ServerContext* context,
+                                             const CheckById* request,
+                                             CommandSuccess* response) override;
   grpc::Status ProcessHostCheckResult(grpc::ServerContext* context,
                                       const Check* request,
                                       CommandSuccess* response) override;
+  grpc::Status ProcessCheckResults(grpc::ServerContext* context,
+                                   grpc::ServerReader<Check>* reader,
+                                   CheckResultsCount* response) override;
+  grpc::Status ProcessCheckResultsBatch(grpc::ServerContext* context,
+                                        const CheckList* request,
+                                        CheckResultsCount* response) override;
   grpc::Status NewThresholdsFile(grpc::ServerContext* context,
                                  const ThresholdsFile* request,
                                  CommandSuccess* response) override;
@@ -27,6 +27,7 @@
 #include <map>
 
 #include "com/centreon/engine/circular_buffer.hh"
+#include "com/centreon/engine/command_ring.hh"
 #include "com/centreon/engine/configuration/state.hh"
 #include "com/centreon/engine/events/sched_info.hh"
 #include "com/centreon/engine/events/timed_event.hh"
@@ -86,7 +87,7 @@ extern time_t program_start;
 extern uint16_t grpc_port;
 extern time_t event_start;
 
-extern circular_buffer external_command_buffer;
+extern com::centreon::engine::command_ring external_command_buffer;
 extern pthread_t worker_threads[];
 
 extern check_stats check_statistics[];
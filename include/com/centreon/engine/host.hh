@@ -50,6 +50,9 @@ typedef std::unordered_map<std::string, com::centreon::engine::host*>
 typedef std::unordered_map<uint64_t,
                            std::shared_ptr<com::centreon::engine::host>>
     host_id_map;
+typedef std::unordered_multimap<std::string,
+                                std::shared_ptr<com::centreon::engine::host>>
+    host_address_map;
 
 CCE_BEGIN()
 class host : public notifier {
@@ -263,12 +266,20 @@ class host : public notifier {
   host_map_unsafe child_hosts;
   static host_map hosts;
   static host_id_map hosts_by_id;
+  static host_address_map hosts_by_address;
 
   service_map_unsafe services;
   std::list<hostgroup*> const& get_parent_groups() const;
   std::list<hostgroup*>& get_parent_groups();
 
  private:
+  int _finish_check_result_3x(std::string const& old_plugin_output,
+                              int reschedule_check,
+                              time_t next_check,
+                              std::list<host*> const& check_hostlist,
+                              int use_cached_result,
+                              unsigned long check_timestamp_horizon);
+
   uint64_t _id;
   std::string _name;
   std::string _alias;
@@ -322,6 +333,8 @@ void check_for_expired_acknowledgement(com::centreon::engine::host* h);
 com::centreon::engine::host& find_host(uint64_t host_id);
 bool is_host_exist(uint64_t host_id) throw();
 uint64_t get_host_id(std::string const& name);
+com::centreon::engine::host* find_host_by_name_or_address(
+    std::string const& name);
 
 CCE_END()
 
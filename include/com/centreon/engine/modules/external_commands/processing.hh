@@ -25,6 +25,7 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/contact.hh"
 #include "com/centreon/engine/contactgroup.hh"
@@ -281,7 +282,23 @@ class processing {
         (*fptr)(it->second);
   }
 
+  /*
+   *  Perfect hash of the command names: the bucket of a name gives the
+   *  seed to hash it with, and that second hash gives a slot used by no
+   *  other command.
+   */
+  struct command_slot {
+    std::string const* name;
+    command_info const* info;
+  };
+
+  static uint32_t _hash(char const* name, size_t length, uint32_t seed);
+  void _build_lookup_table();
+  command_info const* _find(char const* name, size_t length) const;
+
   std::unordered_map<std::string, command_info> _lst_command;
+  std::vector<uint32_t> _lookup_seeds;
+  std::vector<command_slot> _lookup_slots;
   mutable std::mutex _mutex;
 };
 }  // namespace external_commands
@@ -20,6 +20,7 @@
 #ifndef CCE_RETENTION_DUMP_HH
 #define CCE_RETENTION_DUMP_HH
 
+#include <cstdint>
 #include <ostream>
 #include <unordered_map>
 #include "com/centreon/engine/customvariable.hh"
@@ -40,6 +41,14 @@ class host;
 
 namespace retention {
 namespace dump {
+// Binary retention files start with this magic number. Then each object
+// is its type name identifier followed by its keys identifiers and
+// values, and binary_end. Identifiers and lengths are 32 bits integers
+// in host byte order. An identifier not seen before is a new entry of
+// the dictionary, followed by its length and its name.
+char const binary_magic[] = "CERETB01";
+uint32_t const binary_end = 0xFFFFFFFF;
+
 std::ostream& comment(std::ostream& os, comment const& obj);
 std::ostream& comments(std::ostream& os);
 std::ostream& contact(std::ostream& os, contact const& obj);
@@ -59,9 +68,11 @@ std::ostream& hosts(std::ostream& os);
 std::ostream& info(std::ostream& os);
 std::ostream& program(std::ostream& os);
 bool save(std::string const& path);
+bool save_async(std::string const& path);
 std::ostream& service(std::ostream& os,
                       com::centreon::engine::service const& obj);
 std::ostream& services(std::ostream& os);
+bool wait();
 }  // namespace dump
 }  // namespace retention
 CCE_END()
@@ -38,6 +38,9 @@ class parser {
  private:
   typedef void (parser::*store)(state&, object_ptr obj);
 
+  void _parse_binary(std::string const& path,
+                     std::string const& data,
+                     state& retention);
   template <typename T, typename T2, T& (state::*ptr)() throw()>
   void _store_into_list(state& retention, object_ptr obj);
   template <typename T, T& (state::*ptr)() throw()>
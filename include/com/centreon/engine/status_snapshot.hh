@@ -0,0 +1,203 @@
+/*
+** Copyright 2020 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_STATUS_SNAPSHOT_HH
+#define CCE_STATUS_SNAPSHOT_HH
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "com/centreon/engine/checks/stats.hh"
+#include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+class host;
+class notifier;
+class service;
+
+/**
+ *  Binary status snapshot, a memory mapped file that tools can read
+ *  without parsing the text status file.
+ *
+ *  The file is a header followed by a record per host and then a
+ *  record per service. Records are updated in place; the header
+ *  sequence is odd while the engine writes, so readers retry until
+ *  they get an even and unchanged sequence. When objects are added or
+ *  removed, a new file is written and renamed over the old one.
+ */
+namespace status_snapshot {
+// Schema version, incremented on incompatible changes.
+uint32_t const version = 1;
+char const magic[8] = {'C', 'E', 'S', 'T', 'A', 'T', 'U', 'S'};
+
+struct header {
+  char magic[8];
+  uint32_t version;
+  uint32_t header_size;
+  uint32_t record_size;
+  uint32_t host_count;
+  uint32_t service_count;
+  uint32_t reserved;
+  uint64_t sequence;
+  int64_t created;
+  int64_t program_start;
+  uint64_t pid;
+  int32_t total_external_command_buffer_slots;
+  int32_t used_external_command_buffer_slots;
+  int32_t high_external_command_buffer_slots;
+  int32_t check_stats[MAX_CHECK_STATS_TYPES][3];
+};
+
+struct record {
+  uint64_t host_id;
+  uint64_t service_id;
+  double execution_time;
+  double latency;
+  double percent_state_change;
+  int64_t last_check;
+  int32_t check_type;
+  int32_t current_state;
+  int32_t scheduled_downtime_depth;
+  uint8_t is_flapping;
+  uint8_t has_been_checked;
+  uint8_t should_be_scheduled;
+  uint8_t reserved;
+};
+
+/**
+ *  @class reader status_snapshot.hh "com/centreon/engine/status_snapshot.hh"
+ *  @brief Read a consistent copy of a status snapshot.
+ */
+class reader {
+ public:
+  /**
+   *  Read a status snapshot.
+   *
+   *  @param[in] path  The snapshot file.
+   *
+   *  @return True if a consistent snapshot was read.
+   */
+  bool read(std::string const& path) {
+    int fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd < 0)
+      return false;
+    struct stat st;
+    void* map(MAP_FAILED);
+    if (!fstat(fd, &st) && static_cast<size_t>(st.st_size) >= sizeof(header))
+      map = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED)
+      return false;
+
+    bool retval(false);
+    header const* h(static_cast<header const*>(map));
+    if (!memcmp(h->magic, magic, sizeof(magic)) && h->version == version &&
+        h->header_size == sizeof(header) && h->record_size == sizeof(record)) {
+      for (int i(0); i < 1000 && !retval; ++i) {
+        uint64_t seq(__atomic_load_n(&h->sequence, __ATOMIC_ACQUIRE));
+        if (seq & 1) {
+          usleep(1000);
+          continue;
+        }
+        memcpy(&_header, h, sizeof(_header));
+        size_t count(static_cast<size_t>(_header.host_count) +
+                     _header.service_count);
+        if (sizeof(header) + count * sizeof(record) >
+            static_cast<size_t>(st.st_size))
+          break;
+        _records.resize(count);
+        if (count)
+          memcpy(&_records[0], h + 1, count * sizeof(record));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        retval = __atomic_load_n(&h->sequence, __ATOMIC_RELAXED) == seq;
+      }
+    }
+    munmap(map, st.st_size);
+    return retval;
+  }
+
+  header const& get_header() const noexcept { return _header; }
+
+  record const* hosts() const noexcept { return _records.data(); }
+
+  record const* services() const noexcept {
+    return _records.data() + _header.host_count;
+  }
+
+ private:
+  header _header;
+  std::vector<record> _records;
+};
+
+/**
+ *  @class writer status_snapshot.hh "com/centreon/engine/status_snapshot.hh"
+ *  @brief Maintain the status snapshot of the engine.
+ *
+ *  Hosts and services mark themselves as modified when their status is
+ *  updated and only their records are rewritten on update().
+ */
+class writer {
+ public:
+  static writer& instance();
+  void close(bool remove);
+  void mark(host const& hst);
+  void mark(service const& svc);
+  bool open(std::string const& path);
+  bool update();
+
+ private:
+  typedef std::pair<uint64_t, uint64_t> key;
+
+  struct key_hash {
+    size_t operator()(key const& k) const noexcept {
+      return std::hash<uint64_t>()(k.first * 31 + k.second);
+    }
+  };
+
+  writer();
+  ~writer();
+  writer(writer const&) = delete;
+  writer& operator=(writer const&) = delete;
+  void _fill_header();
+  void _mark(key const& k);
+  bool _rebuild();
+
+  std::vector<uint32_t> _dirty;
+  std::vector<bool> _is_dirty;
+  header* _map;
+  std::string _path;
+  bool _rebuild_needed;
+  size_t _size;
+  std::unordered_map<key, uint32_t, key_hash> _slots;
+};
+}  // namespace status_snapshot
+
+CCE_END()
+
+#endif  // !CCE_STATUS_SNAPSHOT_HH
@@ -26,6 +26,7 @@
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/daterange.hh"
 #include "com/centreon/engine/namespace.hh"
+#include "com/centreon/engine/timeperiod_index.hh"
 #include "com/centreon/engine/timerange.hh"
 
 /* Forward declaration. */
@@ -55,6 +56,9 @@ class timeperiod {
                                           time_t* invalid_time);
   void get_next_invalid_time_per_timeperiod(time_t preferred_time,
                                             time_t* invalid_time);
+  bool is_valid_time(time_t test_time);
+  bool get_indexed() const noexcept;
+  void set_indexed(bool indexed);
 
   void resolve(int& w, int& e);
 
@@ -65,11 +69,20 @@ class timeperiod {
   std::array<daterange_list, DATERANGE_TYPES> exceptions;
 
   static timeperiod_map timeperiods;
+  static void invalidate_indexes();
 
  private:
+  timeperiod_index const& _get_index(time_t preferred_time);
+  void _get_next_valid_time_uncached(time_t preferred_time,
+                                     time_t* valid_time);
+
+  static unsigned int _indexes_generation;
+
   std::string _name;
   std::string _alias;
   timeperiodexclusion _exclusions;
+  bool _indexed;
+  std::unordered_map<std::string, timeperiod_index> _indexes;
 };
 
 CCE_END()
@@ -0,0 +1,74 @@
+/*
+** Copyright 2020 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CCE_TIMEPERIOD_INDEX_HH
+#define CCE_TIMEPERIOD_INDEX_HH
+
+#include <ctime>
+#include <utility>
+#include <vector>
+#include "com/centreon/engine/namespace.hh"
+
+CCE_BEGIN()
+
+/**
+ *  @class timeperiod_index timeperiod_index.hh
+ *  "com/centreon/engine/timeperiod_index.hh"
+ *  @brief Valid intervals of a time period over a rolling horizon.
+ *
+ *  The valid times of a time period, exclusions already subtracted, are
+ *  stored as a sorted list of [start, end[ intervals. An index is only
+ *  meaningful for the timezone it was built in and as long as the
+ *  configuration did not change (see generation()).
+ */
+class timeperiod_index {
+ public:
+  typedef std::vector<std::pair<time_t, time_t> > interval_list;
+
+  static time_t const horizon = 8 * 7 * 24 * 60 * 60;
+  static time_t const lookahead = 7 * 24 * 60 * 60;
+
+  timeperiod_index();
+  timeperiod_index(timeperiod_index const& other) = default;
+  timeperiod_index(timeperiod_index&& other) = default;
+  ~timeperiod_index() = default;
+  timeperiod_index& operator=(timeperiod_index const& other) = default;
+  timeperiod_index& operator=(timeperiod_index&& other) = default;
+
+  bool covers(time_t t, unsigned int generation) const;
+  bool get_next_valid_time(time_t preferred_time, time_t& valid_time) const;
+  interval_list const& intervals() const;
+  bool is_valid(time_t t) const;
+  std::pair<time_t, time_t> next_horizon(time_t t,
+                                         unsigned int generation) const;
+  void set(time_t start,
+           time_t end,
+           unsigned int generation,
+           interval_list&& intervals);
+
+ private:
+  time_t _start;
+  time_t _end;
+  unsigned int _generation;
+  interval_list _intervals;
+};
+
+CCE_END()
+
+#endif  // !CCE_TIMEPERIOD_INDEX_HH
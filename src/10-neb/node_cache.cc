@@ -18,6 +18,7 @@
 
 #include "com/centreon/broker/neb/node_cache.hh"
 #include <memory>
+#include "com/centreon/broker/io/data_pool.hh"
 #include "com/centreon/broker/logging/logging.hh"
 
 using namespace com::centreon::broker;
@@ -102,22 +103,22 @@ void node_cache::serialize(std::shared_ptr<persistent_cache> cache) {
            it = _hosts.begin(),
            end = _hosts.end();
        it != end; ++it)
-    cache->add(std::make_shared<neb::host>(it->second));
+    cache->add(io::make_event<neb::host>(it->second));
   for (std::unordered_map<node_id, neb::service>::const_iterator
            it = _services.begin(),
            end = _services.end();
        it != end; ++it)
-    cache->add(std::make_shared<neb::service>(it->second));
+    cache->add(io::make_event<neb::service>(it->second));
   for (std::unordered_map<node_id, neb::host_status>::const_iterator
            it = _host_statuses.begin(),
            end = _host_statuses.end();
        it != end; ++it)
-    cache->add(std::make_shared<neb::host_status>(it->second));
+    cache->add(io::make_event<neb::host_status>(it->second));
   for (std::unordered_map<node_id, neb::service_status>::const_iterator
            it = _service_statuses.begin(),
            end = _service_statuses.end();
        it != end; ++it)
-    cache->add(std::make_shared<neb::service_status>(it->second));
+    cache->add(io::make_event<neb::service_status>(it->second));
 }
 
 /**
@@ -0,0 +1,189 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/bam/aggregation_tree.hh"
+#include <cmath>
+#include <limits>
+
+using namespace com::centreon::broker::bam;
+
+// Value of slots that are not used.
+static double const no_min(std::numeric_limits<double>::infinity());
+static double const no_max(-std::numeric_limits<double>::infinity());
+
+/**
+ *  Default constructor.
+ */
+aggregation_tree::aggregation_tree() : _capacity(0) {}
+
+/**
+ *  Destructor.
+ */
+aggregation_tree::~aggregation_tree() {}
+
+/**
+ *  Remove all the values.
+ */
+void aggregation_tree::clear() {
+  _capacity = 0;
+  _free.clear();
+  _nodes.clear();
+  _slots.clear();
+}
+
+/**
+ *  Get the value of a metric.
+ *
+ *  @param[in]  metric_id  Metric ID.
+ *  @param[out] value      Value of the metric.
+ *
+ *  @return True if the metric is in the tree.
+ */
+bool aggregation_tree::get(uint32_t metric_id, double& value) const {
+  std::unordered_map<uint32_t, uint32_t>::const_iterator it(
+      _slots.find(metric_id));
+  if (it == _slots.end())
+    return (false);
+  value = _nodes[_capacity + it->second].sum;
+  return (true);
+}
+
+/**
+ *  Get the maximum value.
+ *
+ *  @return The maximum value, NAN if there is no value.
+ */
+double aggregation_tree::max() const {
+  return (_slots.empty() ? NAN : _nodes[1].max);
+}
+
+/**
+ *  Get the minimum value.
+ *
+ *  @return The minimum value, NAN if there is no value.
+ */
+double aggregation_tree::min() const {
+  return (_slots.empty() ? NAN : _nodes[1].min);
+}
+
+/**
+ *  Remove the value of a metric.
+ *
+ *  @param[in] metric_id  Metric ID.
+ *
+ *  @return True if the metric was in the tree.
+ */
+bool aggregation_tree::remove(uint32_t metric_id) {
+  std::unordered_map<uint32_t, uint32_t>::iterator it(_slots.find(metric_id));
+  if (it == _slots.end())
+    return (false);
+  uint32_t slot(it->second);
+  _slots.erase(it);
+  node& leaf(_nodes[_capacity + slot]);
+  leaf.min = no_min;
+  leaf.max = no_max;
+  leaf.sum = 0.0;
+  _update(slot);
+  _free.push_back(slot);
+  return (true);
+}
+
+/**
+ *  Set the value of a metric, adding the metric if necessary.
+ *
+ *  @param[in] metric_id  Metric ID.
+ *  @param[in] value      Value of the metric.
+ */
+void aggregation_tree::set(uint32_t metric_id, double value) {
+  uint32_t slot;
+  std::unordered_map<uint32_t, uint32_t>::iterator it(_slots.find(metric_id));
+  if (it != _slots.end())
+    slot = it->second;
+  else {
+    if (_free.empty())
+      _grow();
+    slot = _free.back();
+    _free.pop_back();
+    _slots[metric_id] = slot;
+  }
+  node& leaf(_nodes[_capacity + slot]);
+  leaf.min = value;
+  leaf.max = value;
+  leaf.sum = value;
+  _update(slot);
+}
+
+/**
+ *  Get the number of values.
+ *
+ *  @return The number of metrics in the tree.
+ */
+size_t aggregation_tree::size() const {
+  return (_slots.size());
+}
+
+/**
+ *  Get the sum of the values.
+ *
+ *  @return The sum of the values, 0 if there is no value.
+ */
+double aggregation_tree::sum() const {
+  return (_slots.empty() ? 0.0 : _nodes[1].sum);
+}
+
+/**
+ *  Compute a node from its children.
+ *
+ *  @param[in,out] nodes  The nodes of the tree.
+ *  @param[in]     i      Index of the node.
+ */
+void aggregation_tree::_combine(std::vector<node>& nodes, size_t i) {
+  node const& left(nodes[i * 2]);
+  node const& right(nodes[i * 2 + 1]);
+  node& n(nodes[i]);
+  n.min = (right.min < left.min) ? right.min : left.min;
+  n.max = (right.max > left.max) ? right.max : left.max;
+  n.sum = left.sum + right.sum;
+}
+
+/**
+ *  Double the number of slots.
+ */
+void aggregation_tree::_grow() {
+  size_t capacity(_capacity ? _capacity * 2 : 1);
+  node empty = {no_min, no_max, 0.0};
+  std::vector<node> nodes(capacity * 2, empty);
+  for (size_t i(0); i < _capacity; ++i)
+    nodes[capacity + i] = _nodes[_capacity + i];
+  for (size_t i(capacity - 1); i > 0; --i)
+    _combine(nodes, i);
+  for (size_t i(capacity); i > _capacity; --i)
+    _free.push_back(i - 1);
+  _nodes.swap(nodes);
+  _capacity = capacity;
+}
+
+/**
+ *  Update the nodes from a slot to the root.
+ *
+ *  @param[in] slot  Modified slot.
+ */
+void aggregation_tree::_update(uint32_t slot) {
+  for (size_t i((_capacity + slot) / 2); i > 0; i /= 2)
+    _combine(_nodes, i);
+}
@@ -0,0 +1,174 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/bam/availability_batch.hh"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::bam;
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] days  Midnights of the days to compute, followed by the
+ *                   midnight ending the last day.
+ */
+availability_batch::availability_batch(std::vector<time_t> const& days)
+    : _days(days) {}
+
+/**
+ *  Destructor.
+ */
+availability_batch::~availability_batch() {}
+
+/**
+ *  Add an event of a BA.
+ *
+ *  @param[in] ba_id  The id of the BA.
+ *  @param[in] e      The event, tied to one timeperiod of the BA.
+ */
+void availability_batch::add_event(uint32_t ba_id, event const& e) {
+  _bas[ba_id].events.push_back(e);
+}
+
+/**
+ *  Compute the availabilities of all the BAs.
+ *
+ *  @param[in] threads_count  Number of threads to use, 0 to use one
+ *                            thread per core.
+ */
+void availability_batch::compute(unsigned int threads_count) {
+  std::vector<std::pair<uint32_t const, ba_events>*> bas;
+  for (std::pair<uint32_t const, ba_events>& ba : _bas)
+    bas.push_back(&ba);
+
+  std::atomic<size_t> next(0);
+  auto compute_bas = [this, &bas, &next]() {
+    for (size_t i; (i = next++) < bas.size();) {
+      try {
+        _compute_ba(bas[i]->first, bas[i]->second);
+      }
+      catch (...) {
+        bas[i]->second.error = std::current_exception();
+      }
+    }
+  };
+  if (!threads_count)
+    threads_count = std::max(std::thread::hardware_concurrency(), 1u);
+  threads_count = std::min<size_t>(threads_count, bas.size());
+  std::vector<std::thread> threads;
+  for (unsigned int i(1); i < threads_count; ++i)
+    threads.emplace_back(compute_bas);
+  compute_bas();
+  for (std::thread& t : threads)
+    t.join();
+
+  // Results are ordered by BA, then by day.
+  _availabilities.clear();
+  for (std::pair<uint32_t const, ba_events>* ba : bas) {
+    if (ba->second.error)
+      std::rethrow_exception(ba->second.error);
+    _availabilities.insert(_availabilities.end(),
+                           ba->second.availabilities.begin(),
+                           ba->second.availabilities.end());
+    ba->second.availabilities.clear();
+  }
+}
+
+/**
+ *  Get the computed availabilities.
+ *
+ *  @return The availabilities, ordered by BA, day and timeperiod.
+ */
+std::vector<availability_batch::availability> const&
+availability_batch::get_availabilities() const {
+  return (_availabilities);
+}
+
+/**
+ *  Set the first day to compute for a BA. By default, all the days are
+ *  computed.
+ *
+ *  @param[in] ba_id      The id of the BA.
+ *  @param[in] first_day  Midnight of the first day to compute.
+ */
+void availability_batch::set_first_day(uint32_t ba_id, time_t first_day) {
+  _bas[ba_id].first_day = first_day;
+}
+
+/**
+ *  Default BA events constructor.
+ */
+availability_batch::ba_events::ba_events() : first_day(0) {}
+
+/**
+ *  Compute the daily availabilities of one BA. This method is called by
+ *  the computing threads.
+ *
+ *  @param[in]     ba_id  The id of the BA.
+ *  @param[in,out] ba     The events of the BA, its availabilities are
+ *                        filled.
+ */
+void availability_batch::_compute_ba(uint32_t ba_id, ba_events& ba) const {
+  std::vector<event>& events(ba.events);
+  std::stable_sort(events.begin(), events.end(),
+                   [](event const& left, event const& right) {
+                     return (left.start_time < right.start_time);
+                   });
+
+  size_t first(0);
+  for (size_t day(std::lower_bound(_days.begin(), _days.end(), ba.first_day) -
+                  _days.begin());
+       day + 1 < _days.size();
+       ++day) {
+    time_t day_start(_days[day]);
+    time_t day_end(_days[day + 1]);
+
+    // Events finished before this day are not needed anymore.
+    while (first < events.size() && events[first].end_time &&
+           events[first].end_time < day_start)
+      ++first;
+
+    std::map<uint32_t, availability_builder> builders;
+    for (size_t i(first);
+         i < events.size() && events[i].start_time < day_end;
+         ++i) {
+      event const& e(events[i]);
+      if (e.end_time && e.end_time < day_start)
+        continue;
+      std::map<uint32_t, availability_builder>::iterator found(
+          builders.find(e.timeperiod_id));
+      if (found == builders.end())
+        found = builders
+                    .insert(std::make_pair(
+                        e.timeperiod_id,
+                        availability_builder(day_end, day_start)))
+                    .first;
+      found->second.add_event(
+          e.status, e.start_time, e.end_time, e.in_downtime, e.tp);
+      found->second.set_timeperiod_is_default(e.timeperiod_is_default);
+    }
+
+    for (std::pair<uint32_t const, availability_builder> const& b : builders)
+      ba.availabilities.push_back(
+          availability{ba_id, day_start, b.first, b.second});
+  }
+  ba.events.clear();
+}
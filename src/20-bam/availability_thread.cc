@@ -17,7 +17,9 @@
 */
 
 #include "com/centreon/broker/bam/availability_thread.hh"
+#include <algorithm>
 #include <ctime>
+#include <set>
 #include <sstream>
 #include "com/centreon/exceptions/msg_fmt.hh"
 #include "com/centreon/broker/logging/logging.hh"
@@ -171,9 +173,15 @@ void availability_thread::_build_availabilities(time_t midnight) {
   std::stringstream query;
   int thread_id;
 
+  // Days following the last availability of each BA.
+  std::map<uint32_t, time_t> first_days;
+
   // Get the first day of rebuilding. If a complete rebuilding was asked,
   // it's the day of the chronogically first event to rebuild.
-  // If not, it's the day following the chronogically last availability.
+  // If not, each BA restarts from the day following its chronogically last
+  // availability. BAs without availability start from the day following
+  // the chronogically last availability. Without any availability, all of
+  // them start from the day of the chronogically first event.
   if (_should_rebuild_all) {
     query << "SELECT MIN(start_time), MAX(end_time), MIN(IFNULL(end_time, '0'))"
              "  FROM mod_bam_reporting_ba_events"
@@ -203,19 +211,25 @@ void availability_thread::_build_availabilities(time_t midnight) {
     }
 
   } else {
-    query << "SELECT MAX(time_id)"
-             "  FROM mod_bam_reporting_ba_availabilities";
+    query << "SELECT ba_id, MAX(time_id)"
+             "  FROM mod_bam_reporting_ba_availabilities"
+             "  GROUP BY ba_id";
     try {
       std::promise<database::mysql_result> promise;
       thread_id = _mysql->run_query_and_get_result(query.str(), &promise);
-      // FIXME DBR: to finish...
       database::mysql_result res(promise.get_future().get());
-      if (!_mysql->fetch_row(res))
-        throw msg_fmt("no availability in table");
-      first_day = res.value_as_i32(0);
-      first_day =
-          time::timeperiod::add_round_days_to_midnight(first_day, 3600 * 24);
-      _mysql->fetch_row(res);
+      time_t last_availability = 0;
+      while (_mysql->fetch_row(res)) {
+        time_t day = time::timeperiod::add_round_days_to_midnight(
+            res.value_as_i32(1), 3600 * 24);
+        first_days[res.value_as_u32(0)] = day;
+        if (!first_day || day < first_day)
+          first_day = day;
+        if (day > last_availability)
+          last_availability = day;
+      }
+      if (!first_days.empty())
+        first_days[0] = last_availability;
     }
     catch (std::exception const& e) {
       throw msg_fmt(
@@ -223,41 +237,85 @@ void availability_thread::_build_availabilities(time_t midnight) {
           "from the reporting database: {}",
           e.what());
     }
+
+    // No availability yet: all the days are computed from the first event.
+    if (first_days.empty()) {
+      std::string const events_query(
+          "SELECT MIN(start_time) FROM mod_bam_reporting_ba_events");
+      try {
+        std::promise<database::mysql_result> promise;
+        thread_id = _mysql->run_query_and_get_result(events_query, &promise);
+        database::mysql_result res(promise.get_future().get());
+        if (_mysql->fetch_row(res) && !res.value_is_null(0))
+          first_day = _compute_start_of_day(res.value_as_i32(0));
+        else
+          first_day = last_day;
+      }
+      catch (std::exception const& e) {
+        throw msg_fmt(
+            "BAM-BI: availability thread could not select the first BA event "
+            "from the reporting database: {}",
+            e.what());
+      }
+    }
+  }
+
+  if (first_day >= last_day) {
+    logging::debug(logging::medium)
+        << "BAM-BI: availability thread has no availability to write";
+    return;
   }
 
   logging::debug(logging::medium)
       << "BAM-BI: availability thread writing availabilities from: "
       << first_day << " to " << last_day;
 
-  // Write the availabilities day after day.
-  while (first_day < last_day) {
-    time_t next_day =
-        time::timeperiod::add_round_days_to_midnight(first_day, 3600 * 24);
-    _build_daily_availabilities(thread_id, first_day, next_day);
-    first_day = next_day;
-  }
+  std::vector<time_t> days;
+  for (time_t day = first_day; day < last_day;
+       day = time::timeperiod::add_round_days_to_midnight(day, 3600 * 24))
+    days.push_back(day);
+  days.push_back(last_day);
+
+  // Events are read once for the whole period, then the days of each BA
+  // are computed in parallel.
+  availability_batch batch(days);
+  _load_events(thread_id, batch, first_days, first_day, last_day);
+  batch.compute();
+  _write_availabilities(batch);
 }
 
 /**
- *  @brief  Build all the availabilities of a day.
+ *  @brief  Load the events of the period to compute.
  *
  *  This is called from the context of the availability thread.
  *
- *  @param[in] q         A SQL query object.
- *  @param[in] day_start The start of the day.
- *  @param[in] day_end   The first second of the next day.
+ *  @param[in]  thread_id   The connection to use.
+ *  @param[out] batch       The batch receiving the events.
+ *  @param[in]  first_days  The first day of each BA, the default one is
+ *                          tied to BA 0. Empty to compute all the days.
+ *  @param[in]  first_day   The start of the period.
+ *  @param[in]  last_day    The end of the period.
  */
-void availability_thread::_build_daily_availabilities(int thread_id,
-                                                      time_t day_start,
-                                                      time_t day_end) {
-  logging::info(logging::medium)
-      << "BAM-BI: availability thread writing daily availability for "
-         "day : " << day_start << "-" << day_end;
+void availability_thread::_load_events(
+    int thread_id,
+    availability_batch& batch,
+    std::map<uint32_t, time_t> const& first_days,
+    time_t first_day,
+    time_t last_day) {
+  std::set<uint32_t> known_bas;
+  auto add_event = [&](uint32_t ba_id, availability_batch::event const& e) {
+    if (!first_days.empty() && known_bas.insert(ba_id).second) {
+      std::map<uint32_t, time_t>::const_iterator found(first_days.find(ba_id));
+      if (found == first_days.end())
+        found = first_days.find(0);
+      batch.set_first_day(ba_id, found->second);
+    }
+    batch.add_event(ba_id, e);
+  };
 
-  // Build the availabilities tied to event durations (event finished)
+  // Load the event durations (event finished).
   std::stringstream query;
-  query << "SELECT a.ba_event_id, b.ba_id, a.start_time, a.end_time,"
-           "       a.duration, a.sla_duration, a.timeperiod_id,"
+  query << "SELECT b.ba_id, a.start_time, a.end_time, a.timeperiod_id,"
            "       a.timeperiod_is_default, b.status, b.in_downtime"
            "  FROM mod_bam_reporting_ba_events_durations AS a"
            "    INNER JOIN mod_bam_reporting_ba_events AS b"
@@ -265,42 +323,29 @@ void availability_thread::_build_daily_availabilities(int thread_id,
            "  WHERE ";
   if (_should_rebuild_all)
     query << "(b.ba_id IN (" << _bas_to_rebuild << ")) AND ";
-  query << "((a.start_time BETWEEN " << day_start << " AND " << day_end - 1
-        << ") OR (a.end_time BETWEEN " << day_start << " AND " << day_end - 1
-        << ") OR (" << day_start << " BETWEEN a.start_time AND a.end_time))";
+  query << "a.start_time < " << last_day << " AND a.end_time >= " << first_day;
 
   std::promise<database::mysql_result> promise;
   _mysql->run_query_and_get_result(query.str(), &promise, thread_id);
 
-  // Create a builder for each ba_id and associated timeperiod_id.
-  std::map<std::pair<uint32_t, uint32_t>, availability_builder> builders;
+  uint32_t count = 0;
   try {
     database::mysql_result res(promise.get_future().get());
     while (_mysql->fetch_row(res)) {
-      uint32_t ba_id = res.value_as_i32(1);
-      uint32_t timeperiod_id = res.value_as_i32(6);
+      availability_batch::event e;
+      e.timeperiod_id = res.value_as_u32(3);
       // Find the timeperiod.
-      time::timeperiod::ptr tp = _shared_tps.get_timeperiod(timeperiod_id);
+      e.tp = _shared_tps.get_timeperiod(e.timeperiod_id);
       // No timeperiod found, skip.
-      if (!tp)
+      if (!e.tp)
         continue;
-      // Find the builder.
-      std::map<std::pair<uint32_t, uint32_t>, availability_builder>::iterator
-          found = builders.find(std::make_pair(ba_id, timeperiod_id));
-      // No builders found, create one.
-      if (found == builders.end())
-        found = builders.insert(std::make_pair(
-                                    std::make_pair(ba_id, timeperiod_id),
-                                    availability_builder(day_end, day_start)))
-                    .first;
-      // Add the event to the builder.
-      found->second.add_event(res.value_as_i32(8),   // Status
-                              res.value_as_i32(2),   // Start time
-                              res.value_as_i32(3),   // End time
-                              res.value_as_bool(9),  // Was in downtime
-                              tp);
-      // Add the timeperiod is default flag.
-      found->second.set_timeperiod_is_default(res.value_as_bool(7));
+      e.timeperiod_is_default = res.value_as_bool(4);
+      e.status = res.value_as_i32(5);
+      e.start_time = res.value_as_i32(1);
+      e.end_time = res.value_as_i32(2);
+      e.in_downtime = res.value_as_bool(6);
+      add_event(res.value_as_u32(0), e);
+      ++count;
     }
   }
   catch (std::exception const& e) {
@@ -308,15 +353,14 @@ void availability_thread::_build_daily_availabilities(int thread_id,
                   e.what());
   }
 
-  // Build the availabilities tied to event not finished.
+  // Load the events not finished.
   query.str("");
-  query << "SELECT ba_event_id, ba_id, start_time, end_time,"
-           "       status, in_downtime"
+  query << "SELECT ba_id, start_time, status, in_downtime"
            "  FROM mod_bam_reporting_ba_events"
            "  WHERE ";
   if (_should_rebuild_all)
     query << "(ba_id IN (" << _bas_to_rebuild << ")) AND ";
-  query << "(start_time < " << day_end << " AND end_time IS NULL)";
+  query << "(start_time < " << last_day << " AND end_time IS NULL)";
 
   promise = std::promise<database::mysql_result>();
   _mysql->run_query_and_get_result(query.str(), &promise, thread_id);
@@ -324,33 +368,21 @@ void availability_thread::_build_daily_availabilities(int thread_id,
   try {
     database::mysql_result res(promise.get_future().get());
     while (_mysql->fetch_row(res)) {
-      uint32_t ba_id = res.value_as_i32(1);
+      uint32_t ba_id = res.value_as_u32(0);
       // Get all the timeperiods associated with the ba of this event.
       std::vector<std::pair<time::timeperiod::ptr, bool> > tps =
           _shared_tps.get_timeperiods_by_ba_id(ba_id);
-      for (std::vector<std::pair<time::timeperiod::ptr, bool> >::const_iterator
-               it(tps.begin()),
-           end(tps.end());
-           it != end;
-           ++it) {
-        uint32_t tp_id = it->first->get_id();
-        // Find the builder.
-        std::map<std::pair<uint32_t, uint32_t>, availability_builder>::iterator
-            found = builders.find(std::make_pair(ba_id, tp_id));
-        // No builders found, create one.
-        if (found == builders.end())
-          found = builders.insert(std::make_pair(
-                                      std::make_pair(ba_id, tp_id),
-                                      availability_builder(day_end, day_start)))
-                      .first;
-        // Add the event to the builder.
-        found->second.add_event(res.value_as_i32(4),   // Status
-                                res.value_as_i32(2),   // Start time
-                                res.value_as_i32(3),   // End time
-                                res.value_as_bool(5),  // Was in downtime
-                                it->first);
-        // Add the timeperiod is default flag.
-        found->second.set_timeperiod_is_default(it->second);
+      for (std::pair<time::timeperiod::ptr, bool> const& tp : tps) {
+        availability_batch::event e;
+        e.timeperiod_id = tp.first->get_id();
+        e.tp = tp.first;
+        e.timeperiod_is_default = tp.second;
+        e.status = res.value_as_i32(2);
+        e.start_time = res.value_as_i32(1);
+        e.end_time = 0;
+        e.in_downtime = res.value_as_bool(3);
+        add_event(ba_id, e);
+        ++count;
       }
     }
   }
@@ -359,55 +391,61 @@ void availability_thread::_build_daily_availabilities(int thread_id,
                   e.what());
   }
 
-  // For each builder, write the availabilities.
-  for (std::map<std::pair<uint32_t, uint32_t>,
-                availability_builder>::const_iterator it = builders.begin(),
-                                                      end = builders.end();
-       it != end;
-       ++it)
-    _write_availability(
-        thread_id, it->second, it->first.first, day_start, it->first.second);
+  logging::debug(logging::medium)
+      << "BAM-BI: availability thread loaded " << count << " events of "
+      << known_bas.size() << " BAs";
 }
 
 /**
- *  Write an availability to the database.
+ *  Write the availabilities to the database, many rows per query. Queries
+ *  are spread over the database connections.
  *
- *  @param[in] q                      A QSqlQuery connected to this database.
- *  @param[in] builder                The builder of an availability.
- *  @param[in] ba_id                  The id of the ba.
- *  @param[in] day_start              The start of the day.
- *  @param[in] timeperiod_id          The id of the timeperiod.
+ *  @param[in] batch  The computed availabilities.
  */
-void availability_thread::_write_availability(
-    int thread_id,
-    availability_builder const& builder,
-    uint32_t ba_id,
-    time_t day_start,
-    uint32_t timeperiod_id) {
-  logging::debug(logging::low)
-      << "BAM-BI: availability thread writing availability for "
-         "BA " << ba_id << " at day " << day_start << " (timeperiod "
-      << timeperiod_id << ")";
-  std::stringstream query;
-  query << "INSERT INTO mod_bam_reporting_ba_availabilities "
-        << "  (ba_id, time_id, timeperiod_id, timeperiod_is_default,"
-           "   available, unavailable, degraded,"
-           "   unknown, downtime, alert_unavailable_opened,"
-           "   alert_degraded_opened, alert_unknown_opened,"
-           "   nb_downtime)"
-           "  VALUES (" << ba_id << ", " << day_start << ", " << timeperiod_id
-        << ", " << builder.get_timeperiod_is_default() << ", "
-        << builder.get_available() << ", " << builder.get_unavailable() << ", "
-        << builder.get_degraded() << ", " << builder.get_unknown() << ", "
-        << builder.get_downtime() << ", " << builder.get_unavailable_opened()
-        << ", " << builder.get_degraded_opened() << ", "
-        << builder.get_unknown_opened() << ", " << builder.get_downtime_opened()
-        << ")";
-  _mysql->run_query(
-      query.str(),
-      "BAM-BI: availability thread could not insert an availability: ",
-      true,
-      thread_id);
+void availability_thread::_write_availabilities(
+    availability_batch const& batch) {
+  std::vector<availability_batch::availability> const& availabilities(
+      batch.get_availabilities());
+  logging::info(logging::medium)
+      << "BAM-BI: availability thread writing " << availabilities.size()
+      << " availabilities";
+
+  size_t const rows_per_query = 1000;
+  int connections = std::max(_mysql->connections_count(), 1);
+  int thread_id = 0;
+  for (size_t i = 0; i < availabilities.size(); i += rows_per_query) {
+    std::stringstream query;
+    query << "INSERT INTO mod_bam_reporting_ba_availabilities "
+          << "  (ba_id, time_id, timeperiod_id, timeperiod_is_default,"
+             "   available, unavailable, degraded,"
+             "   unknown, downtime, alert_unavailable_opened,"
+             "   alert_degraded_opened, alert_unknown_opened,"
+             "   nb_downtime)"
+             "  VALUES ";
+    for (size_t j = i;
+         j < availabilities.size() && j < i + rows_per_query;
+         ++j) {
+      availability_batch::availability const& a(availabilities[j]);
+      availability_builder const& builder(a.builder);
+      if (j != i)
+        query << ", ";
+      query << "(" << a.ba_id << ", " << a.day_start << ", "
+            << a.timeperiod_id << ", " << builder.get_timeperiod_is_default()
+            << ", " << builder.get_available() << ", "
+            << builder.get_unavailable() << ", " << builder.get_degraded()
+            << ", " << builder.get_unknown() << ", " << builder.get_downtime()
+            << ", " << builder.get_unavailable_opened() << ", "
+            << builder.get_degraded_opened() << ", "
+            << builder.get_unknown_opened() << ", "
+            << builder.get_downtime_opened() << ")";
+    }
+    _mysql->run_query(
+        query.str(),
+        "BAM-BI: availability thread could not insert availabilities: ",
+        true,
+        thread_id);
+    thread_id = (thread_id + 1) % connections;
+  }
 }
 
 /**
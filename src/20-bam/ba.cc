@@ -81,6 +81,7 @@ ba::ba(bool generate_virtual_status)
       _computed_hard_state(ba::state::state_ok),
       _num_soft_critical_childs{0.f},
       _num_hard_critical_childs{0.f},
+      _deferred_publication(false),
       _acknowledgement_hard(0.0),
       _acknowledgement_soft(0.0),
       _downtime_hard(0.0),
@@ -96,6 +97,8 @@ ba::ba(bool generate_virtual_status)
       _level_warning(0.0),
       _recompute_count(0),
       _service_id(0),
+      _state_changed(false),
+      _status_pending(false),
       _valid(true) {}
 
 /**
@@ -168,8 +171,14 @@ bool ba::child_has_update(computable* child, io::stream* visitor) {
     // Check for inherited downtimes.
     _compute_inherited_downtime(visitor);
 
-    // Generate status event.
-    visit(visitor);
+    // Generate status event, or only events and wait for the next
+    // publication to generate status.
+    if (_deferred_publication) {
+      if (visitor && _update_event(visitor))
+        _state_changed = true;
+      _status_pending = true;
+    } else
+      visit(visitor);
   }
   return (true);
 }
@@ -397,6 +406,23 @@ configuration::ba::state_source ba::get_state_source(void) const {
   return _state_source;
 }
 
+/**
+ *  @brief Generate the status of the BA if it changed since the last
+ *  publication.
+ *
+ *  Used with deferred publication, to generate at most one status per
+ *  BA for a batch of updates.
+ *
+ *  @param[out] visitor  Visitor that will receive BA status.
+ */
+void ba::publish(io::stream* visitor) {
+  if (_status_pending && visitor) {
+    _write_status(visitor, _state_changed);
+    _state_changed = false;
+    _status_pending = false;
+  }
+}
+
 /**
  *  Remove child impact.
  *
@@ -411,6 +437,19 @@ void ba::remove_impact(std::shared_ptr<kpi> const& impact) {
   }
 }
 
+/**
+ *  @brief Set whether the status of this BA is generated on each child
+ *  update or only when published.
+ *
+ *  Events are always generated on child updates so that the history of
+ *  BA events is not altered.
+ *
+ *  @param[in] deferred  True to generate status only on publish().
+ */
+void ba::set_deferred_publication(bool deferred) {
+  _deferred_publication = deferred;
+}
+
 /**
  *  Set BA ID.
  *
@@ -517,101 +556,10 @@ void ba::set_state_source(configuration::ba::state_source state_source) {
  */
 void ba::visit(io::stream* visitor) {
   if (visitor) {
-    // Commit initial events.
-    _commit_initial_events(visitor);
-
-    // If no event was cached, create one if necessary.
-    short hard_state(get_state_hard());
-    bool state_changed(false);
-    if (!_event) {
-      if ((_last_kpi_update.get_time_t() == (time_t)-1) ||
-          (_last_kpi_update.get_time_t() == (time_t)0))
-        _last_kpi_update = time(nullptr);
-      _open_new_event(visitor, hard_state);
-    }
-    // If state changed, close event and open a new one.
-    else if ((_in_downtime != _event->in_downtime) ||
-             (hard_state != _event->status)) {
-      state_changed = true;
-      _event->end_time = _last_kpi_update;
-      visitor->write(std::static_pointer_cast<io::data>(_event));
-      _event.reset();
-      _open_new_event(visitor, hard_state);
-    }
-
-    // Generate BA status event.
-    {
-      std::shared_ptr<ba_status> status(new ba_status);
-      status->ba_id = _id;
-      status->in_downtime = _in_downtime;
-      if (_event)
-        status->last_state_change = _event->start_time;
-      else
-        status->last_state_change = _last_kpi_update;
-      status->level_acknowledgement = normalize(_acknowledgement_hard);
-      status->level_downtime = normalize(_downtime_hard);
-      status->level_nominal = normalize(_level_hard);
-      status->state = hard_state;
-      status->state_changed = state_changed;
-      logging::debug(logging::low)
-          << "BAM: generating status of BA " << status->ba_id << " (state "
-          << status->state << ", in downtime " << status->in_downtime
-          << ", level " << status->level_nominal << ")";
-      visitor->write(status);
-    }
-
-    // Generate virtual service status event.
-    if (_generate_virtual_status) {
-      std::shared_ptr<neb::service_status> status(new neb::service_status);
-      status->active_checks_enabled = false;
-      status->check_interval = 0.0;
-      status->check_type = 1;  // Passive.
-      status->current_check_attempt = 1;
-      status->current_state = hard_state;
-      status->enabled = true;
-      status->event_handler_enabled = false;
-      status->execution_time = 0.0;
-      status->flap_detection_enabled = false;
-      status->has_been_checked = true;
-      status->host_id = _host_id;
-      // status->host_name = XXX;
-      status->is_flapping = false;
-      if (_event)
-        status->last_check = _event->start_time;
-      else
-        status->last_check = _last_kpi_update;
-      status->last_hard_state = hard_state;
-      status->last_hard_state_change = status->last_check;
-      status->last_state_change = status->last_check;
-      // status->last_time_critical = XXX;
-      // status->last_time_unknown = XXX;
-      // status->last_time_warning = XXX;
-      status->last_update = time(nullptr);
-      status->latency = 0.0;
-      status->max_check_attempts = 1;
-      status->obsess_over = false;
-      {
-        std::ostringstream oss;
-        oss << "BA : Business Activity " << _id
-            << " - current_level = " << static_cast<int>(normalize(_level_hard))
-            << "%";
-        status->output = oss.str();
-      }
-      // status->percent_state_chagne = XXX;
-      {
-        std::ostringstream oss;
-        oss << "BA_Level=" << static_cast<int>(normalize(_level_hard)) << "%;"
-            << static_cast<int>(_level_warning) << ";"
-            << static_cast<int>(_level_critical) << ";0;100";
-        status->perf_data = oss.str();
-      }
-      status->retry_interval = 0;
-      // status->service_description = XXX;
-      status->service_id = _service_id;
-      status->should_be_scheduled = false;
-      status->state_type = 1;  // Hard.
-      visitor->write(status);
-    }
+    bool state_changed(_update_event(visitor));
+    _write_status(visitor, state_changed || _state_changed);
+    _state_changed = false;
+    _status_pending = false;
   }
 }
 
@@ -764,6 +712,123 @@ void ba::_open_new_event(io::stream* visitor, short service_hard_state) {
   }
 }
 
+/**
+ *  Open or close the BA event according to the current state.
+ *
+ *  @param[out] visitor  Visitor that will receive BA events.
+ *
+ *  @return True if the state of the BA changed.
+ */
+bool ba::_update_event(io::stream* visitor) {
+  // Commit initial events.
+  _commit_initial_events(visitor);
+
+  // If no event was cached, create one if necessary.
+  short hard_state(get_state_hard());
+  bool state_changed(false);
+  if (!_event) {
+    if ((_last_kpi_update.get_time_t() == (time_t)-1) ||
+        (_last_kpi_update.get_time_t() == (time_t)0))
+      _last_kpi_update = time(nullptr);
+    _open_new_event(visitor, hard_state);
+  }
+  // If state changed, close event and open a new one.
+  else if ((_in_downtime != _event->in_downtime) ||
+           (hard_state != _event->status)) {
+    state_changed = true;
+    _event->end_time = _last_kpi_update;
+    visitor->write(std::static_pointer_cast<io::data>(_event));
+    _event.reset();
+    _open_new_event(visitor, hard_state);
+  }
+
+  return state_changed;
+}
+
+/**
+ *  Generate the BA status and the virtual service status.
+ *
+ *  @param[out] visitor        Visitor that will receive statuses.
+ *  @param[in]  state_changed  Whether the state of the BA changed.
+ */
+void ba::_write_status(io::stream* visitor, bool state_changed) {
+  short hard_state(get_state_hard());
+
+  // Generate BA status event.
+  {
+    std::shared_ptr<ba_status> status(new ba_status);
+    status->ba_id = _id;
+    status->in_downtime = _in_downtime;
+    if (_event)
+      status->last_state_change = _event->start_time;
+    else
+      status->last_state_change = _last_kpi_update;
+    status->level_acknowledgement = normalize(_acknowledgement_hard);
+    status->level_downtime = normalize(_downtime_hard);
+    status->level_nominal = normalize(_level_hard);
+    status->state = hard_state;
+    status->state_changed = state_changed;
+    logging::debug(logging::low)
+        << "BAM: generating status of BA " << status->ba_id << " (state "
+        << status->state << ", in downtime " << status->in_downtime
+        << ", level " << status->level_nominal << ")";
+    visitor->write(status);
+  }
+
+  // Generate virtual service status event.
+  if (_generate_virtual_status) {
+    std::shared_ptr<neb::service_status> status(new neb::service_status);
+    status->active_checks_enabled = false;
+    status->check_interval = 0.0;
+    status->check_type = 1;  // Passive.
+    status->current_check_attempt = 1;
+    status->current_state = hard_state;
+    status->enabled = true;
+    status->event_handler_enabled = false;
+    status->execution_time = 0.0;
+    status->flap_detection_enabled = false;
+    status->has_been_checked = true;
+    status->host_id = _host_id;
+    // status->host_name = XXX;
+    status->is_flapping = false;
+    if (_event)
+      status->last_check = _event->start_time;
+    else
+      status->last_check = _last_kpi_update;
+    status->last_hard_state = hard_state;
+    status->last_hard_state_change = status->last_check;
+    status->last_state_change = status->last_check;
+    // status->last_time_critical = XXX;
+    // status->last_time_unknown = XXX;
+    // status->last_time_warning = XXX;
+    status->last_update = time(nullptr);
+    status->latency = 0.0;
+    status->max_check_attempts = 1;
+    status->obsess_over = false;
+    {
+      std::ostringstream oss;
+      oss << "BA : Business Activity " << _id
+          << " - current_level = " << static_cast<int>(normalize(_level_hard))
+          << "%";
+      status->output = oss.str();
+    }
+    // status->percent_state_chagne = XXX;
+    {
+      std::ostringstream oss;
+      oss << "BA_Level=" << static_cast<int>(normalize(_level_hard)) << "%;"
+          << static_cast<int>(_level_warning) << ";"
+          << static_cast<int>(_level_critical) << ";0;100";
+      status->perf_data = oss.str();
+    }
+    status->retry_interval = 0;
+    // status->service_description = XXX;
+    status->service_id = _service_id;
+    status->should_be_scheduled = false;
+    status->state_type = 1;  // Hard.
+    visitor->write(status);
+  }
+}
+
 /**
  *  @brief Recompute all impacts.
  *
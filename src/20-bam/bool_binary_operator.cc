@@ -88,7 +88,7 @@ bool bool_binary_operator::child_has_update(computable* child,
     } else if (child == _right.get()) {
       double value_hard(_right->value_hard());
       double value_soft(_right->value_soft());
-      if ((_right_hard != value_hard) || (_right_soft == value_soft)) {
+      if ((_right_hard != value_hard) || (_right_soft != value_soft)) {
         _right_hard = value_hard;
         _right_soft = value_soft;
         retval = true;
@@ -113,6 +113,24 @@ bool bool_binary_operator::child_has_update(computable* child,
   return (retval);
 }
 
+/**
+ *  Get left member.
+ *
+ *  @return Left member of the boolean operator.
+ */
+std::shared_ptr<bool_value> const& bool_binary_operator::get_left() const {
+  return (_left);
+}
+
+/**
+ *  Get right member.
+ *
+ *  @return Right member of the boolean operator.
+ */
+std::shared_ptr<bool_value> const& bool_binary_operator::get_right() const {
+  return (_right);
+}
+
 /**
  *  Set left member.
  *
@@ -57,6 +57,15 @@ bool_less_than& bool_less_than::operator=(bool_less_than const& right) {
   return (*this);
 }
 
+/**
+ *  Is the comparison strict?
+ *
+ *  @return True if equal values do not match.
+ */
+bool bool_less_than::is_strict() const {
+  return (_strict);
+}
+
 /**
  *  Get the hard value.
  *
@@ -57,6 +57,15 @@ bool_more_than& bool_more_than::operator=(bool_more_than const& right) {
   return (*this);
 }
 
+/**
+ *  Is the comparison strict?
+ *
+ *  @return True if equal values do not match.
+ */
+bool bool_more_than::is_strict() const {
+  return (_strict);
+}
+
 /**
  *  Get the hard value.
  *
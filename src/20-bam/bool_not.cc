@@ -73,6 +73,15 @@ bool bool_not::child_has_update(computable* child, io::stream* visitor) {
   return (true);
 }
 
+/**
+ *  Get the value to negate.
+ *
+ *  @return The negated value.
+ */
+bool_value::ptr const& bool_not::get_value() const {
+  return (_value);
+}
+
 /**
  *  Set value object.
  *
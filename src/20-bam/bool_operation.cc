@@ -71,6 +71,36 @@ bool_operation& bool_operation::operator=(bool_operation const& right) {
   return (*this);
 }
 
+/**
+ *  Get the operation type.
+ *
+ *  @return The operation type.
+ */
+bool_operation::operation_type bool_operation::get_type() const {
+  return (_type);
+}
+
+/**
+ *  Compute the remainder of the integer division of two values.
+ *
+ *  @param[in] left   Dividend.
+ *  @param[in] right  Divisor.
+ *
+ *  @return The remainder, NAN if it cannot be computed.
+ */
+double bool_operation::modulo_value(double left, double right) {
+  if (!std::isfinite(left) || !std::isfinite(right))
+    return (NAN);
+  long long left_val(static_cast<long long>(left));
+  long long right_val(static_cast<long long>(right));
+  if (right_val == 0)
+    return (NAN);
+  // LLONG_MIN % -1 overflows.
+  if (right_val == -1)
+    return (0);
+  return (left_val % right_val);
+}
+
 /**
  *  Get the hard value.
  *
@@ -88,13 +118,8 @@ double bool_operation::value_hard() {
       if (std::fabs(_right_hard) < COMPARE_EPSILON)
         return (NAN);
       return (_left_hard / _right_hard);
-    case modulo: {
-      long long left_val(static_cast<long long>(_left_hard));
-      long long right_val(static_cast<long long>(_right_hard));
-      if (right_val == 0)
-        return (NAN);
-      return (left_val % right_val);
-    }
+    case modulo:
+      return (modulo_value(_left_hard, _right_hard));
   }
   return (NAN);
 }
@@ -116,13 +141,8 @@ double bool_operation::value_soft() {
       if (std::fabs(_right_soft) < COMPARE_EPSILON)
         return (NAN);
       return (_left_soft / _right_soft);
-    case modulo: {
-      long long left_val(static_cast<long long>(_left_soft));
-      long long right_val(static_cast<long long>(_right_soft));
-      if (right_val == 0)
-        return (NAN);
-      return (left_val % right_val);
-    }
+    case modulo:
+      return (modulo_value(_left_soft, _right_soft));
   }
   return (NAN);
 }
@@ -0,0 +1,339 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/bam/bool_program.hh"
+#include <cmath>
+#include "com/centreon/broker/bam/bool_and.hh"
+#include "com/centreon/broker/bam/bool_constant.hh"
+#include "com/centreon/broker/bam/bool_equal.hh"
+#include "com/centreon/broker/bam/bool_less_than.hh"
+#include "com/centreon/broker/bam/bool_more_than.hh"
+#include "com/centreon/broker/bam/bool_not.hh"
+#include "com/centreon/broker/bam/bool_not_equal.hh"
+#include "com/centreon/broker/bam/bool_operation.hh"
+#include "com/centreon/broker/bam/bool_or.hh"
+#include "com/centreon/broker/bam/bool_xor.hh"
+
+using namespace com::centreon::broker::bam;
+
+/**
+ *  Default constructor.
+ */
+bool_program::bool_program() {}
+
+/**
+ *  Destructor.
+ */
+bool_program::~bool_program() {}
+
+/**
+ *  Notification of child update: the instructions from the updated leaf
+ *  to the root are evaluated again.
+ *
+ *  @param[in] child     Child that got updated.
+ *  @param[out] visitor  Visitor.
+ *
+ *  @return              True if the values of the expression were
+ *                       modified.
+ */
+bool bool_program::child_has_update(computable* child, io::stream* visitor) {
+  (void)visitor;
+  bool retval(false);
+  auto range(_leaf_index.equal_range(child));
+  for (auto it(range.first); it != range.second; ++it) {
+    uint32_t index(it->second);
+    while (_execute(index)) {
+      index = _code[index].parent;
+      if (index == no_parent) {
+        retval = true;
+        break;
+      }
+    }
+  }
+  return (retval);
+}
+
+/**
+ *  Compile an expression tree. The leaves of the tree notify the
+ *  program instead of the operators which are not used anymore.
+ *
+ *  @param[in] tree  Expression tree, likely built by exp_builder.
+ *
+ *  @return The compiled expression.
+ */
+bool_program::ptr bool_program::compile(bool_value::ptr const& tree) {
+  ptr retval(new bool_program);
+  retval->_compile(tree, std::shared_ptr<computable>(), retval);
+  return (retval);
+}
+
+/**
+ *  Get the number of instructions.
+ *
+ *  @return The number of instructions of the program.
+ */
+uint32_t bool_program::get_size() const {
+  return (_code.size());
+}
+
+/**
+ *  Get the hard value.
+ *
+ *  @return Evaluation of the expression with hard values.
+ */
+double bool_program::value_hard() {
+  return (_code.back().hard);
+}
+
+/**
+ *  Get the soft value.
+ *
+ *  @return Evaluation of the expression with soft values.
+ */
+double bool_program::value_soft() {
+  return (_code.back().soft);
+}
+
+/**
+ *  Get if the state is known, i.e has been computed at least once.
+ *
+ *  @return  True if the state is known.
+ */
+bool bool_program::state_known() const {
+  return (_code.back().known);
+}
+
+/**
+ *  Is this expression in downtime?
+ *
+ *  @return  True if this expression is in downtime.
+ */
+bool bool_program::in_downtime() const {
+  return (_code.back().downtime);
+}
+
+/**
+ *  Append the instructions of a node after the ones of its operands.
+ *
+ *  @param[in] node    Node to compile.
+ *  @param[in] parent  Parent of the node in the tree, if any.
+ *  @param[in] self    This program.
+ *
+ *  @return Index of the instruction of the node.
+ */
+uint32_t bool_program::_compile(bool_value::ptr const& node,
+                                std::shared_ptr<computable> const& parent,
+                                ptr const& self) {
+  instruction inst;
+  inst.left = 0;
+  inst.right = 0;
+  inst.parent = no_parent;
+  inst.hard = 0.0;
+  inst.soft = 0.0;
+  inst.known = false;
+  inst.downtime = false;
+
+  bool is_operator(true);
+  bool_binary_operator* binary(nullptr);
+  if (bool_not* n = dynamic_cast<bool_not*>(node.get())) {
+    inst.op = op_not;
+    inst.left = _compile(n->get_value(), node, self);
+  } else if ((binary = dynamic_cast<bool_binary_operator*>(node.get()))) {
+    if (dynamic_cast<bool_and*>(binary))
+      inst.op = op_and;
+    else if (dynamic_cast<bool_or*>(binary))
+      inst.op = op_or;
+    else if (dynamic_cast<bool_xor*>(binary))
+      inst.op = op_xor;
+    else if (dynamic_cast<bool_equal*>(binary))
+      inst.op = op_equal;
+    else if (dynamic_cast<bool_not_equal*>(binary))
+      inst.op = op_not_equal;
+    else if (bool_more_than* m = dynamic_cast<bool_more_than*>(binary))
+      inst.op = m->is_strict() ? op_more_than : op_more_equal;
+    else if (bool_less_than* l = dynamic_cast<bool_less_than*>(binary))
+      inst.op = l->is_strict() ? op_less_than : op_less_equal;
+    else if (bool_operation* o = dynamic_cast<bool_operation*>(binary)) {
+      switch (o->get_type()) {
+        case bool_operation::addition:
+          inst.op = op_add;
+          break;
+        case bool_operation::substraction:
+          inst.op = op_sub;
+          break;
+        case bool_operation::multiplication:
+          inst.op = op_mul;
+          break;
+        case bool_operation::division:
+          inst.op = op_div;
+          break;
+        default:
+          inst.op = op_mod;
+      }
+    } else
+      is_operator = false;
+    if (is_operator) {
+      inst.left = _compile(binary->get_left(), node, self);
+      inst.right = _compile(binary->get_right(), node, self);
+    }
+  } else
+    is_operator = false;
+
+  if (!is_operator) {
+    // Constants are evaluated once and for all, other values are leaves
+    // read when they notify the program.
+    if (dynamic_cast<bool_constant*>(node.get()))
+      inst.op = op_constant;
+    else {
+      inst.op = op_leaf;
+      inst.left = _leaves.size();
+      _leaves.push_back(node);
+      _leaf_index.insert({node.get(), _code.size()});
+      if (parent)
+        node->remove_parent(parent);
+      node->add_parent(self);
+    }
+    inst.hard = node->value_hard();
+    inst.soft = node->value_soft();
+    inst.known = node->state_known();
+    inst.downtime = node->in_downtime();
+  }
+
+  uint32_t index(_code.size());
+  _code.push_back(inst);
+  if (is_operator) {
+    _code[inst.left].parent = index;
+    if (inst.op != op_not)
+      _code[inst.right].parent = index;
+    _execute(index);
+  }
+  return (index);
+}
+
+/**
+ *  Evaluate an instruction.
+ *
+ *  @param[in] index  Index of the instruction.
+ *
+ *  @return True if the values of the instruction were modified.
+ */
+bool bool_program::_execute(uint32_t index) {
+  instruction& inst(_code[index]);
+  double hard;
+  double soft;
+  bool known;
+  bool downtime;
+  if (inst.op == op_leaf) {
+    bool_value& leaf(*_leaves[inst.left]);
+    hard = leaf.value_hard();
+    soft = leaf.value_soft();
+    known = leaf.state_known();
+    downtime = leaf.in_downtime();
+  } else if (inst.op == op_constant)
+    return (false);
+  else if (inst.op == op_not) {
+    instruction const& value(_code[inst.left]);
+    hard = !value.hard;
+    soft = !value.soft;
+    known = value.known;
+    downtime = value.downtime;
+  } else {
+    // Same computations as the bool_binary_operator subclasses.
+    instruction const& left(_code[inst.left]);
+    instruction const& right(_code[inst.right]);
+    known = left.known && right.known;
+    downtime = left.downtime || right.downtime;
+    switch (inst.op) {
+      case op_and:
+        hard = left.hard && right.hard;
+        soft = left.soft && right.soft;
+        break;
+      case op_or:
+        hard = left.hard || right.hard;
+        soft = left.soft || right.soft;
+        break;
+      case op_xor:
+        hard = (!left.hard && right.hard) || (left.hard && !right.hard);
+        soft = (!left.soft && right.soft) || (left.soft && !right.soft);
+        break;
+      case op_equal:
+        hard =
+            (std::fabs(left.hard - right.hard) < COMPARE_EPSILON) ? 1.0 : 0.0;
+        soft =
+            (std::fabs(left.soft - right.soft) < COMPARE_EPSILON) ? 1.0 : 0.0;
+        break;
+      case op_not_equal:
+        hard =
+            (std::fabs(left.hard - right.hard) >= COMPARE_EPSILON) ? 1.0 : 0.0;
+        soft =
+            (std::fabs(left.soft - right.soft) >= COMPARE_EPSILON) ? 1.0 : 0.0;
+        break;
+      case op_more_than:
+        hard = left.hard > right.hard;
+        soft = left.soft > right.soft;
+        break;
+      case op_more_equal:
+        hard = left.hard >= right.hard;
+        soft = left.soft >= right.soft;
+        break;
+      case op_less_than:
+        hard = left.hard < right.hard;
+        soft = left.soft < right.soft;
+        break;
+      case op_less_equal:
+        hard = left.hard <= right.hard;
+        soft = left.soft <= right.soft;
+        break;
+      case op_add:
+        hard = left.hard + right.hard;
+        soft = left.soft + right.soft;
+        break;
+      case op_sub:
+        hard = left.hard - right.hard;
+        soft = left.soft - right.soft;
+        break;
+      case op_mul:
+        hard = left.hard * right.hard;
+        soft = left.soft * right.soft;
+        break;
+      case op_div:
+        hard = (std::fabs(right.hard) < COMPARE_EPSILON)
+                   ? NAN
+                   : left.hard / right.hard;
+        soft = (std::fabs(right.soft) < COMPARE_EPSILON)
+                   ? NAN
+                   : left.soft / right.soft;
+        break;
+      default:
+        hard = bool_operation::modulo_value(left.hard, right.hard);
+        soft = bool_operation::modulo_value(left.soft, right.soft);
+    }
+    if ((inst.op == op_div || inst.op == op_mod) &&
+        ((std::fabs(right.hard) < COMPARE_EPSILON) ||
+         (std::fabs(right.soft) < COMPARE_EPSILON)))
+      known = false;
+  }
+
+  bool retval(inst.hard != hard || inst.soft != soft || inst.known != known ||
+              inst.downtime != downtime);
+  inst.hard = hard;
+  inst.soft = soft;
+  inst.known = known;
+  inst.downtime = downtime;
+  return (retval);
+}
@@ -0,0 +1,178 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/bam/command_channel.hh"
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include "com/centreon/broker/logging/logging.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::bam;
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] path      The command file to write into.
+ *  @param[in] max_size  Maximum size of the pending commands.
+ */
+command_channel::command_channel(std::string const& path, size_t max_size)
+    : _fd(-1), _max_size(max_size), _partial(false), _path(path) {}
+
+/**
+ *  Destructor, pending commands are sent if the engine can get them.
+ */
+command_channel::~command_channel() {
+  flush();
+  _close();
+}
+
+/**
+ *  Write the pending commands to the command file.
+ *
+ *  @return True if no commands are pending anymore.
+ */
+bool command_channel::flush() {
+  if (_buffer.empty())
+    return (true);
+  if (_fd < 0 && !_open())
+    return (false);
+
+  // The engine may close the FIFO at any time, EPIPE is handled below.
+  sigset_t sigpipe;
+  sigset_t old_mask;
+  sigset_t pending;
+  sigemptyset(&sigpipe);
+  sigaddset(&sigpipe, SIGPIPE);
+  sigpending(&pending);
+  bool was_pending(sigismember(&pending, SIGPIPE) == 1);
+  pthread_sigmask(SIG_BLOCK, &sigpipe, &old_mask);
+
+  bool broken(false);
+  size_t written(0);
+  while (written < _buffer.size()) {
+    ssize_t wb(
+        ::write(_fd, _buffer.data() + written, _buffer.size() - written));
+    if (wb > 0) {
+      written += wb;
+      _partial = (_buffer[written - 1] != '\n');
+    } else if (wb < 0 && errno == EINTR)
+      continue;
+    else {
+      // EAGAIN: the engine does not read fast enough, retry on next
+      // flush. Otherwise the engine is likely restarting and the file
+      // is opened again on next flush.
+      if (wb < 0 && errno != EAGAIN) {
+        char const* msg(strerror(errno));
+        logging::error(logging::medium)
+            << "BAM: could not write to command file '" << _path
+            << "': " << msg;
+        broken = true;
+      }
+      break;
+    }
+  }
+  _buffer.erase(0, written);
+  if (broken)
+    _close();
+
+  if (broken && !was_pending) {
+    timespec no_wait = {0, 0};
+    sigtimedwait(&sigpipe, nullptr, &no_wait);
+  }
+  pthread_sigmask(SIG_SETMASK, &old_mask, nullptr);
+
+  if (_buffer.empty())
+    logging::debug(logging::medium)
+        << "BAM: sent external commands to '" << _path << "'";
+  return (_buffer.empty());
+}
+
+/**
+ *  Get the size of the pending commands.
+ *
+ *  @return The number of bytes not written yet.
+ */
+size_t command_channel::get_pending() const {
+  return (_buffer.size());
+}
+
+/**
+ *  Add a command to the pending commands.
+ *
+ *  @param[in] cmd  External command, without the trailing newline.
+ */
+void command_channel::write(std::string const& cmd) {
+  _buffer.append(cmd);
+  _buffer.push_back('\n');
+  if (_buffer.size() > _max_size) {
+    // Drop the oldest complete commands, the end of a partially written
+    // command must still be sent.
+    size_t start(0);
+    if (_partial)
+      start = _buffer.find('\n') + 1;
+    size_t end(_buffer.find('\n', start + _buffer.size() - _max_size - 1));
+    if (end != std::string::npos && end + 1 < _buffer.size()) {
+      logging::error(logging::medium)
+          << "BAM: command file '" << _path << "' is not read, dropping "
+          << end + 1 - start << " bytes of external commands";
+      _buffer.erase(start, end + 1 - start);
+    }
+  }
+}
+
+/**
+ *  Close the command file.
+ */
+void command_channel::_close() {
+  if (_fd >= 0) {
+    ::close(_fd);
+    _fd = -1;
+  }
+  // A new reader cannot use the end of a partially written command.
+  if (_partial) {
+    size_t end(_buffer.find('\n'));
+    _buffer.erase(0, end == std::string::npos ? end : end + 1);
+    _partial = false;
+  }
+}
+
+/**
+ *  Open the command file.
+ *
+ *  @return True on success.
+ */
+bool command_channel::_open() {
+  _fd = ::open(_path.c_str(), O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+  if (_fd < 0) {
+    // ENXIO: the FIFO exists but the engine does not read it.
+    char const* msg(strerror(errno));
+    if (errno == ENXIO || errno == ENOENT)
+      logging::debug(logging::medium)
+          << "BAM: command file '" << _path << "' is not available yet: "
+          << msg;
+    else
+      logging::error(logging::medium) << "BAM: could not open command file '"
+                                      << _path << "': " << msg;
+    return (false);
+  }
+  return (true);
+}
@@ -17,7 +17,10 @@
 */
 
 #include "com/centreon/broker/bam/configuration/applier/ba.hh"
+#include <algorithm>
+#include <functional>
 #include <sstream>
+#include <unordered_map>
 #include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/logging/logging.hh"
 #include "com/centreon/broker/multiplexing/publisher.hh"
@@ -119,6 +122,7 @@ void applier::ba::apply(bam::configuration::state::bas const& my_bas,
     book.unlisten(it->second.cfg.get_host_id(), it->second.cfg.get_service_id(),
                   static_cast<bam::ba*>(it->second.obj.get()));
     _applied.erase(it->first);
+    _order.clear();
     multiplexing::publisher().write(s);
   }
   to_delete.clear();
@@ -182,6 +186,67 @@ std::shared_ptr<bam::ba> applier::ba::find_ba(uint32_t id) {
   return ((it != _applied.end()) ? it->second.obj : std::shared_ptr<bam::ba>());
 }
 
+/**
+ *  Generate the status of BAs updated since the last publication,
+ *  children BAs before their parents.
+ *
+ *  @param[out] visitor  Visitor that will receive status.
+ */
+void applier::ba::publish(io::stream* visitor) {
+  for (std::vector<std::shared_ptr<bam::ba> >::iterator it(_order.begin()),
+       end(_order.end());
+       it != end; ++it)
+    (*it)->publish(visitor);
+}
+
+/**
+ *  @brief Sort BAs so that BAs used as KPIs come before the BAs using
+ *  them.
+ *
+ *  The graph was checked for circular paths before.
+ *
+ *  @param[in] my_kpis  Applied KPIs.
+ */
+void applier::ba::sort(configuration::state::kpis const& my_kpis) {
+  // Children BAs of each BA.
+  std::unordered_map<uint32_t, std::vector<uint32_t> > children;
+  for (configuration::state::kpis::const_iterator it(my_kpis.begin()),
+       end(my_kpis.end());
+       it != end; ++it)
+    if (it->second.is_ba())
+      children[it->second.get_ba_id()].push_back(
+          it->second.get_indicator_ba_id());
+
+  // Depth of each BA, 0 for BAs without children BAs.
+  std::unordered_map<uint32_t, int> depths;
+  std::function<int(uint32_t)> depth = [&](uint32_t id) -> int {
+    std::unordered_map<uint32_t, int>::iterator d(depths.find(id));
+    if (d != depths.end())
+      return d->second;
+    int retval(0);
+    std::unordered_map<uint32_t, std::vector<uint32_t> >::const_iterator c(
+        children.find(id));
+    if (c != children.end())
+      for (uint32_t child : c->second)
+        retval = std::max(retval, depth(child) + 1);
+    depths[id] = retval;
+    return retval;
+  };
+
+  std::vector<std::pair<int, uint32_t> > sorted;
+  sorted.reserve(_applied.size());
+  for (std::map<uint32_t, applied>::const_iterator it(_applied.begin()),
+       end(_applied.end());
+       it != end; ++it)
+    sorted.push_back(std::make_pair(depth(it->first), it->first));
+  std::sort(sorted.begin(), sorted.end());
+
+  _order.clear();
+  _order.reserve(sorted.size());
+  for (std::pair<int, uint32_t> const& p : sorted)
+    _order.push_back(_applied[p.second].obj);
+}
+
 /**
  *  Visit each applied BA.
  *
@@ -248,6 +313,7 @@ std::shared_ptr<neb::service> applier::ba::_ba_service(
  */
 void applier::ba::_internal_copy(applier::ba const& other) {
   _applied = other._applied;
+  _order = other._order;
   return;
 }
 
@@ -269,6 +335,7 @@ std::shared_ptr<bam::ba> applier::ba::_new_ba(configuration::ba const& cfg,
   obj->set_level_warning(cfg.get_warning_level());
   obj->set_level_critical(cfg.get_critical_level());
   obj->set_downtime_behaviour(cfg.get_downtime_behaviour());
+  obj->set_deferred_publication(true);
   if (cfg.get_opened_event().ba_id)
     obj->set_initial_event(cfg.get_opened_event());
   book.listen(cfg.get_host_id(), cfg.get_service_id(), obj.get());
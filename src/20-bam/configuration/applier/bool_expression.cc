@@ -18,6 +18,7 @@
 
 #include "com/centreon/broker/bam/bool_expression.hh"
 #include "com/centreon/broker/bam/ba.hh"
+#include "com/centreon/broker/bam/bool_program.hh"
 #include "com/centreon/broker/bam/configuration/applier/ba.hh"
 #include "com/centreon/broker/bam/configuration/applier/bool_expression.hh"
 #include "com/centreon/broker/bam/configuration/bool_expression.hh"
@@ -145,6 +146,8 @@ void applier::bool_expression::apply(
       bam::exp_parser p(it->second.get_expression());
       bam::exp_builder b(p.get_postfix(), mapping);
       bam::bool_value::ptr tree(b.get_tree());
+      if (tree)
+        tree = bam::bool_program::compile(tree);
       new_bool_exp->set_expression(tree);
       if (tree)
         tree->add_parent(
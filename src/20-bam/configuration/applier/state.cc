@@ -144,6 +144,7 @@ void applier::state::apply(bam::configuration::state const& my_state) {
   _kpi_applier.apply(my_state.get_kpis(), my_state.get_hst_svc_mapping(),
                      _ba_applier, _meta_service_applier, _bool_exp_applier,
                      _book_service);
+  _ba_applier.sort(my_state.get_kpis());
 }
 
 /**
@@ -164,6 +165,18 @@ bam::service_book& applier::state::book_service() {
   return _book_service;
 }
 
+/**
+ *  @brief Publish the status of updated BAs.
+ *
+ *  BAs generate their events as soon as they are updated but their
+ *  status only once per publication.
+ *
+ *  @param[out] visitor  Visitor.
+ */
+void applier::state::publish(io::stream* visitor) {
+  _ba_applier.publish(visitor);
+}
+
 /**
  *  @brief Visit applied state.
  *
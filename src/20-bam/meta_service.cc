@@ -40,7 +40,6 @@ meta_service::meta_service()
       _last_state(meta_service::state::state_unknown),
       _level_critical(0.0),
       _level_warning(0.0),
-      _recompute_count(0),
       _value(NAN) {}
 
 /**
@@ -54,8 +53,8 @@ meta_service::~meta_service() {}
  *  @param[in] metric_id  Metric ID.
  */
 void meta_service::add_metric(uint32_t metric_id) {
-  _metrics[metric_id] = 0.0;
-  _recompute_count = _recompute_limit;
+  _metrics.set(metric_id, 0.0);
+  recompute();
 }
 
 /**
@@ -142,6 +141,15 @@ kpi_meta::state meta_service::get_state() const {
   return (state);
 }
 
+/**
+ *  Get meta-service value.
+ *
+ *  @return Current meta-service value.
+ */
+double meta_service::get_value() const {
+  return (_value);
+}
+
 /**
  *  Some child of the meta-service has a status update.
  *
@@ -152,19 +160,12 @@ void meta_service::metric_update(std::shared_ptr<storage::metric> const& m,
                                  io::stream* visitor) {
   if (m) {
     bool state_has_changed = false;
-    std::unordered_map<uint32_t, double>::iterator it(
-        _metrics.find(m->metric_id));
-    if (it != _metrics.end()) {
-      if (it->second != m->value) {
-        // Backup old value.
-        double old_value(it->second);
-        it->second = m->value;
-
+    double old_value;
+    if (_metrics.get(m->metric_id, old_value)) {
+      if (old_value != m->value) {
         // Recompute.
-        if (++_recompute_count >= _recompute_limit)
-          recompute();
-        else
-          _recompute_partial(it->second, old_value);
+        _metrics.set(m->metric_id, m->value);
+        recompute();
 
         // Generate status event.
         visit(visitor, state_has_changed);
@@ -176,49 +177,17 @@ void meta_service::metric_update(std::shared_ptr<storage::metric> const& m,
 }
 
 /**
- *  Perform a full recomputation of the value.
+ *  Compute the value from the aggregated metric values.
  */
 void meta_service::recompute() {
-  // MIN.
-  if (min == _computation) {
-    if (_metrics.empty())
-      _value = NAN;
-    else {
-      std::unordered_map<uint32_t, double>::const_iterator it(
-          _metrics.begin()),
-          end(_metrics.end());
-      _value = it->second;
-      while (++it != end)
-        if (it->second < _value)
-          _value = it->second;
-    }
-  }
-  // MAX.
-  else if (max == _computation) {
-    if (_metrics.empty())
-      _value = NAN;
-    else {
-      std::unordered_map<uint32_t, double>::const_iterator it(
-          _metrics.begin()),
-          end(_metrics.end());
-      _value = it->second;
-      while (++it != end)
-        if (it->second > _value)
-          _value = it->second;
-    }
-  }
-  // SUM/AVERAGE.
-  else {
-    _value = 0.0;
-    for (std::unordered_map<uint32_t, double>::const_iterator
-             it(_metrics.begin()),
-         end(_metrics.end());
-         it != end; ++it)
-      _value += it->second;
-    if (_computation != sum)
-      _value /= _metrics.size();
-  }
-  _recompute_count = 0;
+  if (min == _computation)
+    _value = _metrics.min();
+  else if (max == _computation)
+    _value = _metrics.max();
+  else if (sum == _computation)
+    _value = _metrics.sum();
+  else
+    _value = _metrics.sum() / _metrics.size();
 }
 
 /**
@@ -227,8 +196,8 @@ void meta_service::recompute() {
  *  @param[in] metric_id  Metric ID.
  */
 void meta_service::remove_metric(uint32_t metric_id) {
-  _metrics.erase(metric_id);
-  _recompute_count = _recompute_limit;
+  _metrics.remove(metric_id);
+  recompute();
 }
 
 /**
@@ -238,7 +207,7 @@ void meta_service::remove_metric(uint32_t metric_id) {
  */
 void meta_service::set_computation(meta_service::computation_type type) {
   _computation = type;
-  _recompute_count = _recompute_limit;
+  recompute();
 }
 
 /**
@@ -294,10 +263,6 @@ void meta_service::set_level_warning(double level) {
  */
 void meta_service::visit(io::stream* visitor, bool& changed_state) {
   if (visitor) {
-    // Recompute out-of-date value.
-    if (_recompute_count >= _recompute_limit)
-      recompute();
-
     // New state.
     kpi_meta::state new_state(get_state());
     changed_state = (_last_state != new_state);
@@ -317,37 +282,6 @@ void meta_service::visit(io::stream* visitor, bool& changed_state) {
   }
 }
 
-/**
- *  Perform a partial recomputation of the vlaue.
- *
- *  @param[in] new_value  New value.
- *  @param[in] old_value  Old value.
- */
-void meta_service::_recompute_partial(double new_value, double old_value) {
-  // MIN.
-  if (min == _computation) {
-    if (new_value <= _value)
-      _value = new_value;
-    else if (_value == old_value)
-      recompute();
-  }
-  // MAX.
-  else if (max == _computation) {
-    if (new_value >= _value)
-      _value = new_value;
-    else if (_value == old_value)
-      recompute();
-  }
-  // SUM.
-  else if (sum == _computation) {
-    _value = _value - old_value + new_value;
-  }
-  // AVERAGE.
-  else {
-    _value = _value + (new_value - old_value) / _metrics.size();
-  }
-}
-
 /**
  *  Send service status occasionally.
  *
@@ -20,7 +20,6 @@
 
 #include <cstdlib>
 #include <ctime>
-#include <fstream>
 #include <limits>
 #include <sstream>
 
@@ -73,8 +72,9 @@ monitoring_stream::monitoring_stream(std::string const& ext_cmd_file,
                                      database_config const& db_cfg,
                                      database_config const& storage_db_cfg,
                                      std::shared_ptr<persistent_cache> cache)
-    : _ext_cmd_file(ext_cmd_file),
+    : _commands(ext_cmd_file),
       _mysql(db_cfg),
+      _next_publication(0),
       _pending_events(0),
       _storage_db_cfg(storage_db_cfg),
       _cache(cache) {
@@ -107,6 +107,8 @@ monitoring_stream::~monitoring_stream() {
  *  @return Number of acknowledged events.
  */
 int monitoring_stream::flush() {
+  _publish();
+  _commands.flush();
   _mysql.commit();
   int retval = _pending_events;
   _pending_events = 0;
@@ -331,6 +333,13 @@ int monitoring_stream::write(std::shared_ptr<io::data> const& data) {
       break;
   }
 
+  // Publish BA status and send external commands once per second
+  // during event storms.
+  if (time(nullptr) >= _next_publication) {
+    _publish();
+    _commands.flush();
+  }
+
   // Event acknowledgement.
   return 0;
 }
@@ -363,6 +372,17 @@ void monitoring_stream::_prepare() {
   }
 }
 
+/**
+ *  Publish the status of the BAs updated since the last publication.
+ */
+void monitoring_stream::_publish() {
+  multiplexing::publisher pblshr;
+  event_cache_visitor ev_cache;
+  _applier.publish(&ev_cache);
+  ev_cache.commit_to(pblshr);
+  _next_publication = time(nullptr) + 1;
+}
+
 /**
  *  Rebuilds BA durations/availibities from BA events.
  */
@@ -425,29 +445,15 @@ void monitoring_stream::_update_status(std::string const& status) {
 }
 
 /**
- *  Write an external command to Engine.
+ *  Queue an external command for Engine. Queued commands are written to
+ *  the external command pipe on flush and once per second.
  *
  *  @param[in] cmd  Command to write to the external command pipe.
  */
-void monitoring_stream::_write_external_command(std::string cmd) {
-  cmd.append("\n");
-  std::ofstream ofs;
-  ofs.open(_ext_cmd_file.c_str());
-  if (!ofs.good()) {
-    logging::error(logging::medium)
-        << "BAM: could not write BA check result to command file '"
-        << _ext_cmd_file << "'";
-  } else {
-    ofs.write(cmd.c_str(), cmd.size());
-    if (!ofs.good())
-      logging::error(logging::medium)
-          << "BAM: could not write BA check result to command file '"
-          << _ext_cmd_file << "'";
-    else
-      logging::debug(logging::medium) << "BAM: sent external command '" << cmd
-                                      << "'";
-    ofs.close();
-  }
+void monitoring_stream::_write_external_command(std::string const& cmd) {
+  logging::debug(logging::medium) << "BAM: queuing external command '" << cmd
+                                  << "'";
+  _commands.write(cmd);
 }
 
 /**
@@ -26,6 +26,7 @@
 #include "com/centreon/broker/storage/metric.hh"
 #include "com/centreon/broker/storage/metric_mapping.hh"
 #include "com/centreon/broker/storage/rebuild.hh"
+#include "com/centreon/broker/storage/rebuild_data.hh"
 #include "com/centreon/broker/storage/remove_graph.hh"
 #include "com/centreon/broker/storage/status.hh"
 #include "com/centreon/broker/storage/stream.hh"
@@ -115,6 +116,11 @@ void broker_module_init(void const* arg) {
                        io::event_info("metric_mapping",
                                       &storage::metric_mapping::operations,
                                       storage::metric_mapping::entries));
+      e.register_event(io::events::storage,
+                       storage::de_rebuild_data,
+                       io::event_info("rebuild_data",
+                                      &storage::rebuild_data::operations,
+                                      storage::rebuild_data::entries));
     }
 
     // Register storage layer.
@@ -0,0 +1,167 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/storage/rebuild_data.hh"
+#include <fmt/format.h>
+#include <cstdlib>
+#include <iterator>
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::storage;
+
+/**************************************
+ *                                     *
+ *           Public Methods            *
+ *                                     *
+ **************************************/
+
+/**
+ *  Default constructor.
+ */
+rebuild_data::rebuild_data()
+    : io::data(rebuild_data::static_type()),
+      id(0),
+      interval(0),
+      is_index(false),
+      rrd_len(0),
+      value_type(0) {}
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] id          Index or metric ID.
+ *  @param[in] is_index    true for an index ID, false for a metric ID.
+ *  @param[in] interval    Host/service check interval.
+ *  @param[in] rrd_len     Graph length in seconds.
+ *  @param[in] value_type  Metric type.
+ */
+rebuild_data::rebuild_data(uint32_t id,
+                           bool is_index,
+                           uint32_t interval,
+                           uint32_t rrd_len,
+                           short value_type)
+    : io::data(rebuild_data::static_type()),
+      id(id),
+      interval(interval),
+      is_index(is_index),
+      rrd_len(rrd_len),
+      value_type(value_type) {}
+
+/**
+ *  Copy constructor.
+ *
+ *  @param[in] right Object to copy.
+ */
+rebuild_data::rebuild_data(rebuild_data const& right) : io::data(right) {
+  _internal_copy(right);
+}
+
+/**
+ *  Assignment operator.
+ *
+ *  @param[in] right Object to copy.
+ *
+ *  @return This object.
+ */
+rebuild_data& rebuild_data::operator=(rebuild_data const& right) {
+  if (this != &right) {
+    io::data::operator=(right);
+    _internal_copy(right);
+  }
+  return *this;
+}
+
+/**
+ *  Append a value. Values must be added in time order.
+ *
+ *  @param[in] ctime  Time of the value.
+ *  @param[in] value  The value, a state for a status.
+ */
+void rebuild_data::add_value(time_t ctime, double value) {
+  fmt::format_to(std::back_inserter(values), "{}:{} ", ctime, value);
+}
+
+/**
+ *  Read the value following a position.
+ *
+ *  @param[in,out] pos    Position in values, 0 to read the first value.
+ *  @param[out]    ctime  Time of the value.
+ *  @param[out]    value  The value.
+ *
+ *  @return false when there is no more value.
+ */
+bool rebuild_data::next_value(size_t& pos, time_t& ctime, double& value) const {
+  if (pos >= values.size())
+    return false;
+  char const* start(values.c_str() + pos);
+  char* end;
+  ctime = strtoll(start, &end, 10);
+  if (*end != ':')
+    return false;
+  start = end + 1;
+  value = strtod(start, &end);
+  if (end == start)
+    return false;
+  while (*end == ' ')
+    ++end;
+  pos = end - values.c_str();
+  return true;
+}
+
+/**************************************
+ *                                     *
+ *           Private Methods           *
+ *                                     *
+ **************************************/
+
+/**
+ *  Copy internal data members.
+ *
+ *  @param[in] right Object to copy.
+ */
+void rebuild_data::_internal_copy(rebuild_data const& right) {
+  id = right.id;
+  interval = right.interval;
+  is_index = right.is_index;
+  rrd_len = right.rrd_len;
+  value_type = right.value_type;
+  values = right.values;
+}
+
+/**************************************
+ *                                     *
+ *           Static Objects            *
+ *                                     *
+ **************************************/
+
+// Mapping.
+mapping::entry const rebuild_data::entries[] = {
+    mapping::entry(&rebuild_data::id, "id", mapping::entry::invalid_on_zero),
+    mapping::entry(&rebuild_data::interval, "interval"),
+    mapping::entry(&rebuild_data::is_index, "is_index"),
+    mapping::entry(&rebuild_data::rrd_len, "rrd_len"),
+    mapping::entry(&rebuild_data::value_type, "value_type"),
+    mapping::entry(&rebuild_data::values, "values"),
+    mapping::entry()};
+
+// Operations.
+static io::data* new_rebuild_data() {
+  return new rebuild_data;
+}
+io::event_info::event_operations const rebuild_data::operations = {
+    &new_rebuild_data};
@@ -18,21 +18,23 @@
 
 #include "com/centreon/broker/storage/rebuilder.hh"
 
+#include <algorithm>
+#include <atomic>
 #include <cfloat>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <sstream>
+#include <vector>
 
 #include "com/centreon/exceptions/msg_fmt.hh"
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/logging/logging.hh"
 #include "com/centreon/broker/multiplexing/publisher.hh"
 #include "com/centreon/broker/storage/conflict_manager.hh"
-#include "com/centreon/broker/storage/metric.hh"
 #include "com/centreon/broker/storage/rebuild.hh"
-#include "com/centreon/broker/storage/status.hh"
+#include "com/centreon/broker/storage/rebuild_data.hh"
 
 using namespace com::centreon::exceptions;
 using namespace com::centreon::broker;
@@ -61,8 +63,11 @@ rebuilder::rebuilder(database_config const& db_cfg,
       _interval_length(interval_length),
       _rebuild_check_interval(rebuild_check_interval),
       _rrd_len(rrd_length),
-      _should_exit(false) {
-  _db_cfg.set_connections_count(1);
+      _should_exit(false),
+      _threads_count(std::min(std::max(std::thread::hardware_concurrency(), 1u),
+                              max_threads)) {
+  // One connection per rebuilding thread.
+  _db_cfg.set_connections_count(_threads_count);
   _db_cfg.set_queries_per_transaction(1);
   _thread.reset(new std::thread(&rebuilder::_run, this));
 }
@@ -119,14 +124,10 @@ void rebuilder::_run() {
       while (!_should_exit && info.index_id) {
         // Get check interval of host/service.
         uint32_t index_id;
-        uint32_t host_id;
-        uint32_t service_id;
         uint32_t check_interval(0);
         uint32_t rrd_len;
         {
           index_id = info.index_id;
-          host_id = info.host_id;
-          service_id = info.service_id;
           rrd_len = info.rrd_retention;
 
           std::ostringstream oss;
@@ -154,7 +155,7 @@ void rebuilder::_run() {
 
         try {
           // Fetch metrics to rebuild.
-          std::list<metric_info> metrics_to_rebuild;
+          std::vector<metric_info> metrics_to_rebuild;
           {
             std::ostringstream oss;
             oss << "SELECT metric_id, metric_name, data_source_type"
@@ -181,22 +182,45 @@ void rebuilder::_run() {
             }
           }
 
-          // Browse metrics to rebuild.
-          while (!_should_exit && !metrics_to_rebuild.empty()) {
-            metric_info& info(metrics_to_rebuild.front());
-            _rebuild_metric(*ms,
-                            info.metric_id,
-                            host_id,
-                            service_id,
-                            info.metric_name,
-                            info.metric_type,
-                            check_interval,
-                            rrd_len);
+          // Rebuild metrics in parallel, each thread using its own
+          // database connection.
+          std::vector<std::exception_ptr> errors(metrics_to_rebuild.size());
+          std::atomic<size_t> next(0);
+          auto rebuild_metrics = [&](int thread_id) {
+            for (size_t i;
+                 !_should_exit && (i = next++) < metrics_to_rebuild.size();) {
+              metric_info const& info(metrics_to_rebuild[i]);
+              try {
+                _rebuild_metric(*ms,
+                                thread_id,
+                                info.metric_id,
+                                info.metric_name,
+                                info.metric_type,
+                                check_interval,
+                                rrd_len);
+              }
+              catch (...) {
+                errors[i] = std::current_exception();
+              }
+            }
+          };
+          uint32_t threads_count(std::min<size_t>(
+              _threads_count, std::max<size_t>(metrics_to_rebuild.size(), 1)));
+          std::vector<std::thread> threads;
+          for (uint32_t i(1); i < threads_count; ++i)
+            threads.emplace_back(rebuild_metrics, i);
+          rebuild_metrics(0);
+          for (std::thread& t : threads)
+            t.join();
+
+          for (size_t i(0); i < metrics_to_rebuild.size(); ++i) {
+            if (errors[i])
+              std::rethrow_exception(errors[i]);
+            metric_info const& info(metrics_to_rebuild[i]);
             // We need to update the conflict_manager for metrics that could
             // change of type.
             conflict_manager::instance().update_metric_info_cache(
                 index_id, info.metric_id, info.metric_name, info.metric_type);
-            metrics_to_rebuild.pop_front();
           }
 
           // Rebuild status.
@@ -270,21 +294,20 @@ void rebuilder::_next_index_to_rebuild(index_info& info, mysql& ms) {
 }
 
 /**
- *  Rebuild a metric.
+ *  Rebuild a metric. Its values are sent in time order, many values per
+ *  event.
  *
  *  @param[in] db           Database object.
+ *  @param[in] thread_id    Database connection to use.
  *  @param[in] metric_id    Metric ID.
- *  @param[in] host_id      Id of the host this metric belong to.
- *  @param[in] service_id   Id of the service this metric belong to.
  *  @param[in] metric_name  Metric name.
  *  @param[in] type         Metric type.
  *  @param[in] interval     Host/service check interval.
  *  @param[in] length       Metric RRD length in seconds.
  */
 void rebuilder::_rebuild_metric(mysql& ms,
+                                int thread_id,
                                 uint32_t metric_id,
-                                uint32_t host_id,
-                                uint32_t service_id,
                                 std::string const& metric_name,
                                 short metric_type,
                                 uint32_t interval,
@@ -309,7 +332,7 @@ void rebuilder::_rebuild_metric(mysql& ms,
     oss << "SELECT ctime, value FROM data_bin WHERE id_metric=" << metric_id
         << " AND ctime>=" << start << " ORDER BY ctime ASC";
     std::promise<database::mysql_result> promise;
-    ms.run_query_and_get_result(oss.str(), &promise);
+    ms.run_query_and_get_result(oss.str(), &promise, thread_id);
     log_v2::sql()->debug(
         "storage(rebuilder): rebuild of metric {}: SQL query: \"{}\"",
         metric_id,
@@ -317,39 +340,27 @@ void rebuilder::_rebuild_metric(mysql& ms,
 
     try {
       database::mysql_result res(promise.get_future().get());
+      std::shared_ptr<storage::rebuild_data> data;
+      uint32_t count(0);
       while (!_should_exit && ms.fetch_row(res)) {
-        std::shared_ptr<storage::metric> entry =
-            std::make_shared<storage::metric>(host_id,
-                                              service_id,
-                                              metric_name,
-                                              res.value_as_u32(0),
-                                              interval,
-                                              true,
-                                              metric_id,
-                                              length,
-                                              res.value_as_f64(1),
-                                              metric_type);
-        if (entry->value > FLT_MAX * 0.999)
-          entry->value = INFINITY;
-        else if (entry->value < -FLT_MAX * 0.999)
-          entry->value = -INFINITY;
-        log_v2::perfdata()->trace(
-            "storage(rebuilder): Sending metric with host_id {}, service_id "
-            "{}, metric_name {}, ctime {}, interval {}, is_for_rebuild {}, "
-            "metric_id {}, rrd_len {}, value {}, value_type{}",
-            host_id,
-            service_id,
-            metric_name,
-            res.value_as_u32(0),
-            interval,
-            true,
-            metric_id,
-            length,
-            res.value_as_f64(1),
-            metric_type);
-
-        multiplexing::publisher().write(entry);
+        if (!data)
+          data = std::make_shared<storage::rebuild_data>(
+              metric_id, false, interval, length, metric_type);
+        double value(res.value_as_f64(1));
+        if (value > FLT_MAX * 0.999)
+          value = INFINITY;
+        else if (value < -FLT_MAX * 0.999)
+          value = -INFINITY;
+        data->add_value(res.value_as_u32(0), value);
+        if (++count % values_per_event == 0) {
+          multiplexing::publisher().write(data);
+          data.reset();
+        }
       }
+      if (data)
+        multiplexing::publisher().write(data);
+      log_v2::perfdata()->debug(
+          "storage(rebuilder): sent {} values of metric {}", count, metric_id);
     }
     catch (std::exception const& e) {
       throw msg_fmt("storage: rebuilder: cannot fetch data of metric {}: {}",
@@ -401,16 +412,20 @@ void rebuilder::_rebuild_status(mysql& ms,
     ms.run_query_and_get_result(oss.str(), &promise);
     try {
       database::mysql_result res(promise.get_future().get());
+      std::shared_ptr<storage::rebuild_data> data;
+      uint32_t count(0);
       while (!_should_exit && ms.fetch_row(res)) {
-        std::shared_ptr<storage::status> entry(
-            std::make_shared<storage::status>(res.value_as_u32(0),
-                                              index_id,
-                                              interval,
-                                              true,
-                                              _rrd_len,
-                                              res.value_as_i32(1)));
-        multiplexing::publisher().write(entry);
+        if (!data)
+          data = std::make_shared<storage::rebuild_data>(
+              index_id, true, interval, _rrd_len, 0);
+        data->add_value(res.value_as_u32(0), res.value_as_i32(1));
+        if (++count % values_per_event == 0) {
+          multiplexing::publisher().write(data);
+          data.reset();
+        }
       }
+      if (data)
+        multiplexing::publisher().write(data);
     }
     catch (std::exception const& e) {
       throw msg_fmt("storage: rebuilder: cannot fetch data of index {}: {}",
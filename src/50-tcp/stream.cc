@@ -141,6 +141,18 @@ bool stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
  */
 void stream::set_parent(acceptor* parent) { _parent = parent; }
 
+/**
+ *  Set the function to call when a packet or a disconnection arrives.
+ *
+ *  @param[in] notifier  The function, empty to remove it.
+ *
+ *  @return True.
+ */
+bool stream::set_read_notifier(std::function<void()> const& notifier) {
+  tcp_async::instance().set_read_notifier(*_socket, notifier);
+  return true;
+}
+
 /**
  *  Set read timeout.
  *
@@ -182,6 +182,8 @@ void tcp_async::_async_read_cb(asio::ip::tcp::socket& socket,
       it->second._work_buffer.resize(bytes);
       it->second._buffer_queue.push(std::move(it->second._work_buffer));
       it->second._wait_socket_event.notify_all();
+      if (it->second._notifier)
+        it->second._notifier();
 
       // refit buffer for next read
       it->second._work_buffer.resize(async_buf_size);
@@ -204,6 +206,8 @@ void tcp_async::_async_read_cb(asio::ip::tcp::socket& socket,
 
     it->second._closing = true;
     it->second._wait_socket_event.notify_all();
+    if (it->second._notifier)
+      it->second._notifier();
   }
 }
 
@@ -250,6 +254,14 @@ void tcp_async::unregister_socket(asio::ip::tcp::socket& socket, bool sync) {
   }
 }
 
+void tcp_async::set_read_notifier(asio::ip::tcp::socket& socket,
+                                  std::function<void()> const& notifier) {
+  std::unique_lock<std::mutex> lock(_m_read_data);
+  auto it = _read_data.find(socket.native_handle());
+  if (it != _read_data.end())
+    it->second._notifier = notifier;
+}
+
 asio::io_context& tcp_async::get_io_ctx() {
   return _io_context;
 }
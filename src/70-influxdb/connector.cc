@@ -32,7 +32,8 @@ using namespace com::centreon::broker::influxdb;
 /**
  *  Default constructor.
  */
-connector::connector() : io::endpoint(false) {}
+connector::connector()
+    : io::endpoint(false), _max_in_flight{1}, _max_connections{1}, _gzip{false} {}
 
 /**
  *  Destructor.
@@ -53,7 +54,10 @@ void connector::connect_to(std::string const& user,
                            std::vector<column> const& status_cols,
                            std::string const& metric_ts,
                            std::vector<column> const& metric_cols,
-                           std::shared_ptr<persistent_cache> const& cache) {
+                           std::shared_ptr<persistent_cache> const& cache,
+                           uint32_t max_in_flight,
+                           uint32_t max_connections,
+                           bool gzip) {
   _user = user;
   _password = passwd;
   _addr = addr;
@@ -64,6 +68,9 @@ void connector::connect_to(std::string const& user,
   _metric_ts = metric_ts;
   _metric_cols = metric_cols;
   _cache = cache;
+  _max_in_flight = max_in_flight;
+  _max_connections = max_connections;
+  _gzip = gzip;
 }
 
 /**
@@ -74,5 +81,6 @@ void connector::connect_to(std::string const& user,
 std::shared_ptr<io::stream> connector::open() {
   return (std::shared_ptr<io::stream>(
       new stream(_user, _password, _addr, _port, _db, _queries_per_transaction,
-                 _status_ts, _status_cols, _metric_ts, _metric_cols, _cache)));
+                 _status_ts, _status_cols, _metric_ts, _metric_cols, _cache,
+                 _max_in_flight, _max_connections, _gzip)));
 }
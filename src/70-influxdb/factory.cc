@@ -130,6 +130,38 @@ io::endpoint* factory::new_endpoint(config::endpoint& cfg,
     else queries_per_transaction = 1000;
   }
 
+  // Number of queries waiting for their answer and number of HTTP
+  // connections used to send them.
+  uint32_t max_in_flight(1);
+  uint32_t max_connections(1);
+  {
+    std::map<std::string, std::string>::const_iterator it{
+        cfg.params.find("max_in_flight_queries")};
+    if (it != cfg.params.end())
+      try {
+        max_in_flight = std::stoul(it->second);
+      }
+    catch (std::exception const& ex) {
+      throw msg_fmt(
+          "influxdb: couldn't parse max_in_flight_queries '{}' defined for "
+          "endpoint '{}'",
+          it->second,
+          cfg.name);
+    }
+    it = cfg.params.find("db_connections");
+    if (it != cfg.params.end())
+      try {
+        max_connections = std::stoul(it->second);
+      }
+    catch (std::exception const& ex) {
+      throw msg_fmt(
+          "influxdb: couldn't parse db_connections '{}' defined for "
+          "endpoint '{}'",
+          it->second,
+          cfg.name);
+    }
+  }
+
   auto chk_str = [](Json const & js)->std::string {
     if (!js.is_string() || js.string_value().empty()) {
       throw msg_fmt(
@@ -179,6 +211,15 @@ io::endpoint* factory::new_endpoint(config::endpoint& cfg,
                  chk_bool(chk_str(object["is_tag"])),
                  column::parse_type(chk_str(object["type"]))));
 
+  // Body compression.
+  bool gzip(false);
+  {
+    std::map<std::string, std::string>::const_iterator it{
+        cfg.params.find("gzip")};
+    if (it != cfg.params.end())
+      gzip = chk_bool(it->second);
+  }
+
   // Connector.
   std::unique_ptr<influxdb::connector> c(new influxdb::connector);
   c->connect_to(user,
@@ -191,7 +232,10 @@ io::endpoint* factory::new_endpoint(config::endpoint& cfg,
                 status_column_list,
                 metric_timeseries,
                 metric_column_list,
-                cache);
+                cache,
+                max_in_flight,
+                max_connections,
+                gzip);
   is_acceptor = false;
   return c.release();
 }
@@ -17,18 +17,30 @@
 */
 
 #include "com/centreon/broker/influxdb/influxdb12.hh"
-#include <iterator>
-#include <vector>
 #include "com/centreon/exceptions/msg_fmt.hh"
 #include "com/centreon/broker/logging/logging.hh"
 #include "com/centreon/broker/misc/string.hh"
 
-using namespace asio;
 using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
 using namespace com::centreon::broker::influxdb;
 
 static const char* query_footer = "\n";
 
+/**
+ *  Build the HTTP client configuration.
+ */
+static http::client::config client_config(uint32_t max_in_flight,
+                                          uint32_t max_connections,
+                                          bool gzip) {
+  http::client::config retval;
+  retval.max_connections = max_connections ? max_connections : 1;
+  retval.max_pipeline =
+      (max_in_flight + retval.max_connections - 1) / retval.max_connections;
+  retval.gzip = gzip;
+  return retval;
+}
+
 /**
  *  Constructor.
  */
@@ -41,12 +53,28 @@ influxdb12::influxdb12(std::string const& user,
                        std::vector<column> const& status_cols,
                        std::string const& metric_ts,
                        std::vector<column> const& metric_cols,
-                       macro_cache const& cache)
-    : _socket{_io_context}, _host(addr), _port(port), _cache(cache) {
+                       macro_cache const& cache,
+                       uint32_t max_in_flight,
+                       uint32_t max_connections,
+                       bool gzip)
+    : _client{addr, port,
+              client_config(max_in_flight, max_connections, gzip)},
+      _max_in_flight{max_in_flight ? max_in_flight : 1},
+      _answered{0},
+      _cache(cache) {
   // Try to connect to the server.
   logging::debug(logging::medium)
       << "influxdb: connecting using 1.2 Line Protocol";
-  _connect_socket();
+  try {
+    _client.connect();
+  } catch (std::exception const& e) {
+    throw msg_fmt(
+        "influxdb: couldn't connect to InfluxDB with address '{}' and port "
+        "'{}': {}",
+        addr,
+        port,
+        e.what());
+  }
   _create_queries(
       user, passwd, db, status_ts, status_cols, metric_ts, metric_cols);
 }
@@ -80,110 +108,66 @@ void influxdb12::write(storage::status const& s) {
 }
 
 /**
- *  Commit a query.
+ *  Commit a query. The query is posted and this method only waits for
+ *  answers if the in-flight window is full.
+ *
+ *  @return True if a query was sent.
  */
-void influxdb12::commit() {
+bool influxdb12::commit() {
   if (_query.empty())
-    return;
-
-  std::stringstream content_length;
-  size_t length = _query.size() + ::strlen(query_footer);
-  content_length << "Content-Length: " << length << "\n";
-
-  std::string final_query;
-  final_query.reserve(length + _post_header.size() +
-                      content_length.str().size() + 1);
-  final_query.append(_post_header)
-      .append(content_length.str())
-      .append("\n")
-      .append(_query)
-      .append(query_footer);
-
-  _connect_socket();
-
-  std::error_code err;
-
-  asio::write(_socket, buffer(final_query), asio::transfer_all(), err);
-  if (err)
-    throw msg_fmt(
-        "influxdb: couldn't commit data to InfluxDB with address '{}' and port "
-        "'{}': {}",
-        _socket.remote_endpoint().address().to_string(),
-        _socket.remote_endpoint().port(),
-        err.message());
-  // Receive the server answer.
-
-  std::string answer;
-  std::size_t total_read{0}, read_size{2048};
-
-  do {
-    answer.resize(read_size);
-
-    total_read += _socket.read_some(
-        asio::buffer(&answer[total_read], read_size - total_read), err);
-    if (total_read == read_size)
-      total_read += 2048;
-
-    answer.resize(total_read);
-
-    if (err)
-      throw msg_fmt(
-          "influxdb: couldn't receive InfluxDB answer with address '{}' and "
-          "port '{}': {}",
-          _socket.remote_endpoint().address().to_string(),
-          _socket.remote_endpoint().port(),
-          err.message());
+    return false;
 
-  } while (!_check_answer_string(answer));
-  _socket.shutdown(ip::tcp::socket::shutdown_both);
-  _socket.close();
+  _query.append(query_footer);
+  _pending.push_back(
+      _client.send(http::request("POST", _post_target, std::move(_query))));
   _query.clear();
+
+  _collect(_max_in_flight - 1);
+  return true;
 }
 
 /**
- *  Connect the socket to the endpoint.
+ *  Check the answers already received, without waiting.
  */
-void influxdb12::_connect_socket() {
-  if (_socket.is_open()) {
-    _socket.shutdown(ip::tcp::socket::shutdown_both);
-    _socket.close();
-  }
-  ip::tcp::resolver resolver{_io_context};
-  ip::tcp::resolver::query query{_host, std::to_string(_port)};
-
-  try {
-    ip::tcp::resolver::iterator it{resolver.resolve(query)};
-    ip::tcp::resolver::iterator end;
-
-    std::error_code err{std::make_error_code(std::errc::host_unreachable)};
+void influxdb12::collect() { _collect(_max_in_flight); }
 
-    // it can resolve to multiple addresses like ipv4 and ipv6
-    // we need to try all to find the first available socket
-    while (err && it != end) {
-      _socket.connect(*it, err);
-
-      if (err)
-        _socket.close();
-
-      ++it;
-    }
+/**
+ *  Get the number of queries accepted since the last call.
+ *
+ *  @return The number of queries accepted.
+ */
+uint32_t influxdb12::answered() {
+  uint32_t retval(_answered);
+  _answered = 0;
+  return retval;
+}
 
-    if (err) {
+/**
+ *  Check the answers received, in the order queries were committed,
+ *  waiting for them while more than max_pending are in flight.
+ *
+ *  @param[in] max_pending  Number of queries allowed to stay in flight.
+ */
+void influxdb12::_collect(size_t max_pending) {
+  while (!_pending.empty() &&
+         (_pending.size() > max_pending ||
+          _pending.front().wait_for(std::chrono::seconds(0)) ==
+              std::future_status::ready)) {
+    std::future<http::response> f{std::move(_pending.front())};
+    _pending.pop_front();
+    http::response ans;
+    try {
+      ans = f.get();
+    } catch (std::exception const& e) {
       throw msg_fmt(
-          "influxdb: couldn't connect to InfluxDB with address '{}' and port "
-          "'{}': {}",
-          _host,
-          _port,
-          err.message());
+          "influxdb: couldn't commit data to InfluxDB with address '{}' and "
+          "port '{}': {}",
+          _client.host(),
+          _client.port(),
+          e.what());
     }
-  }
-  catch (std::system_error const& se) {
-    throw msg_fmt(
-        "influxdb: couldn't connect to InfluxDB with address '{}' and port "
-        "'{}': {}",
-        _host,
-        _port,
-        se.what());
+    _check_answer(ans);
+    ++_answered;
   }
 }
 
@@ -191,48 +175,29 @@ void influxdb12::_connect_socket() {
  *  Check the server's answer.
  *
  *  @param[in] ans  The server's answer.
- *
- *  @return         True of the answer was complete, false otherwise.
  */
-bool influxdb12::_check_answer_string(std::string const& ans) {
-  size_t first_line = ans.find_first_of('\n');
-  if (first_line == std::string::npos)
-    return false;
-  std::string first_line_str = ans.substr(0, first_line);
-
+void influxdb12::_check_answer(http::response const& ans) {
   logging::debug(logging::medium)
-      << "influxdb: received an answer from "
-      << _socket.remote_endpoint().address().to_string() << "' and port '"
-      << _socket.remote_endpoint().port() << "': '" << ans << "'";
-
-  // Split the first line using the power of std.
-  std::istringstream iss(first_line_str);
-  std::vector<std::string> split;
-  std::copy(std::istream_iterator<std::string>(iss),
-            std::istream_iterator<std::string>(),
-            std::back_inserter(split));
-
-  if (split.size() < 3)
-    throw msg_fmt(
-        "influxdb: unrecognizable HTTP header for '{}' and port '{}': got '{}'",
-        _socket.remote_endpoint().address().to_string(),
-        _socket.remote_endpoint().port(),
-        first_line_str);
+      << "influxdb: received an answer from '" << _client.host()
+      << "' and port '" << _client.port() << "': '" << ans.code << " "
+      << ans.reason << "'";
 
-  if ((split[0] == "HTTP/1.0") && (split[1] == "204") && (split[2] == "No") &&
-      (split[3] == "Content"))
-    return true;
-  else if (ans.find("partial write: points beyond retention policy dropped") !=
+  if (ans.code == 204)
+    return;
+  else if (ans.body.find(
+               "partial write: points beyond retention policy dropped") !=
            std::string::npos) {
     logging::info(logging::medium) << "influxdb: sending points beyond "
                                       "Influxdb database configured "
                                       "retention policy";
-    return true;
+    return;
   } else
-    throw msg_fmt("influxdb: got an error from '{}' and port '{}': '{}'",
-                  _socket.remote_endpoint().address().to_string(),
-                  _socket.remote_endpoint().port(),
-                  ans);
+    throw msg_fmt("influxdb: got an error from '{}' and port '{}': '{} {}' {}",
+                  _client.host(),
+                  _client.port(),
+                  ans.code,
+                  ans.reason,
+                  ans.body);
 }
 
 /**
@@ -250,16 +215,14 @@ void influxdb12::_create_queries(std::string const& user,
                                  std::vector<column> const& status_cols,
                                  std::string const& metric_ts,
                                  std::vector<column> const& metric_cols) {
-  // Create POST HTTP header.
-  std::string base_url;
-  base_url.append("/write?u=")
+  // Create POST target.
+  _post_target.append("/write?u=")
       .append(user)
       .append("&p=")
       .append(passwd)
       .append("&db=")
       .append(db)
       .append("&precision=s");
-  _post_header.append("POST ").append(base_url).append(" HTTP/1.0\n");
 
   // Create protocol objects.
   _status_query = line_protocol_query(
@@ -52,7 +52,10 @@ stream::stream(std::string const& user,
                std::vector<column> const& status_cols,
                std::string const& metric_ts,
                std::vector<column> const& metric_cols,
-               std::shared_ptr<persistent_cache> const& cache)
+               std::shared_ptr<persistent_cache> const& cache,
+               uint32_t max_in_flight,
+               uint32_t max_connections,
+               bool gzip)
     : _user(user),
       _password(passwd),
       _address(addr),
@@ -72,7 +75,10 @@ stream::stream(std::string const& user,
                                   status_cols,
                                   metric_ts,
                                   metric_cols,
-                                  _cache));
+                                  _cache,
+                                  max_in_flight,
+                                  max_connections,
+                                  gzip));
 }
 
 /**
@@ -83,16 +89,43 @@ stream::~stream() {}
 /**
  *  Flush the stream.
  *
+ *  Events are acknowledged once InfluxDB answered the query containing
+ *  them, which may happen during a later flush. If InfluxDB rejects a
+ *  query, the events of the queries accepted before it are still
+ *  acknowledged and the error is thrown by the next call.
+ *
  *  @return Number of events acknowledged.
  */
 int stream::flush() {
+  if (_error)
+    std::rethrow_exception(_error);
+
   logging::debug(logging::medium) << "influxdb: commiting " << _actual_query
                                   << " queries";
-  int ret(_pending_queries);
+  int ret(0);
+  int events(_pending_queries);
   _actual_query = 0;
   _pending_queries = 0;
-  _influx_db->commit();
   _commit = false;
+  try {
+    if (_influx_db->commit())
+      _committed.push_back(events);
+    else
+      ret += events;
+    _influx_db->collect();
+  }
+  catch (std::exception const& e) {
+    logging::error(logging::medium) << e.what();
+    _error = std::current_exception();
+  }
+
+  // Queries are answered in order.
+  for (uint32_t answered(_influx_db->answered());
+       answered && !_committed.empty();
+       --answered) {
+    ret += _committed.front();
+    _committed.pop_front();
+  }
   return ret;
 }
 
@@ -131,6 +164,9 @@ void stream::statistics(json11::Json::object& tree) const {
  *  @return Number of events acknowledged.
  */
 int stream::write(std::shared_ptr<io::data> const& data) {
+  if (_error)
+    std::rethrow_exception(_error);
+
   // Take this event into account.
   ++_pending_queries;
   if (!validate(data, "influxdb"))
@@ -18,7 +18,10 @@
 
 #include "com/centreon/broker/lua/broker_socket.hh"
 #include <asio.hpp>
+#include <deque>
+#include <future>
 #include <sstream>
+#include "com/centreon/broker/http/client.hh"
 
 #if ASIO_VERSION < 101200
 namespace asio {
@@ -114,7 +117,7 @@ static int l_broker_socket_connect(lua_State* L) {
       std::ostringstream ss;
       ss << "broker_socket::connect: Couldn't connect to " << addr << ":"
          << port << ": " << err.message();
-      luaL_error(L, ss.str().c_str());
+      luaL_error(L, "%s", ss.str().c_str());
     } else {
       socket_state = connected;
     }
@@ -123,7 +126,7 @@ static int l_broker_socket_connect(lua_State* L) {
     std::ostringstream ss;
     ss << "broker_socket::connect: Couldn't connect to " << addr << ":" << port
        << ": " << se.what();
-    luaL_error(L, ss.str().c_str());
+    luaL_error(L, "%s", ss.str().c_str());
   }
   return 0;
 }
@@ -164,7 +167,7 @@ static int l_broker_socket_write(lua_State* L) {
     ss << "broker_socket::write: Couldn't write to "
        << socket->remote_endpoint().address().to_string() << ":"
        << socket->remote_endpoint().port() << ": " << err.message();
-    luaL_error(L, ss.str().c_str());
+    luaL_error(L, "%s", ss.str().c_str());
   }
 
   return 0;
@@ -191,7 +194,7 @@ static int l_broker_socket_read(lua_State* L) {
     ss << "broker_socket::read: Couldn't read data from "
        << socket->remote_endpoint().address().to_string() << ":"
        << socket->remote_endpoint().port() << ": " << err.message();
-    luaL_error(L, ss.str().c_str());
+    luaL_error(L, "%s", ss.str().c_str());
   } else if (!err) {
     lua_pushlstring(L, buff, len);
   }
@@ -217,6 +220,176 @@ static int l_broker_socket_close(lua_State* L) {
   return 0;
 }
 
+/**
+ *  HTTP client given to Lua, with the answers not yet returned by wait().
+ */
+struct lua_http_client {
+  http::client client;
+  std::deque<std::future<http::response> > pending;
+
+  lua_http_client(std::string const& host,
+                  uint16_t port,
+                  http::client::config const& conf)
+      : client{host, port, conf} {}
+};
+
+/**
+ *  The Lua broker_http_client constructor
+ *
+ *  Lua arguments: host, port, and an optional table with the fields
+ *  max_connections, max_pipeline, gzip and timeout.
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return 1
+ */
+static int l_broker_http_client_constructor(lua_State* L) {
+  char const* host{luaL_checkstring(L, 1)};
+  int port{static_cast<int>(luaL_checknumber(L, 2))};
+  http::client::config conf;
+  if (lua_istable(L, 3)) {
+    lua_getfield(L, 3, "max_connections");
+    if (lua_isnumber(L, -1))
+      conf.max_connections = lua_tointeger(L, -1);
+    lua_getfield(L, 3, "max_pipeline");
+    if (lua_isnumber(L, -1))
+      conf.max_pipeline = lua_tointeger(L, -1);
+    lua_getfield(L, 3, "gzip");
+    if (lua_isboolean(L, -1))
+      conf.gzip = lua_toboolean(L, -1);
+    lua_getfield(L, 3, "timeout");
+    if (lua_isnumber(L, -1))
+      conf.timeout = std::chrono::seconds(lua_tointeger(L, -1));
+    lua_pop(L, 4);
+  }
+
+  lua_http_client** udata{static_cast<lua_http_client**>(
+      lua_newuserdata(L, sizeof(lua_http_client*)))};
+  *udata = new lua_http_client{host, static_cast<uint16_t>(port), conf};
+
+  luaL_getmetatable(L, "lua_broker_http_client");
+  lua_setmetatable(L, -2);
+
+  return 1;
+}
+
+/**
+ *  The Lua broker_http_client destructor
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return 0
+ */
+static int l_broker_http_client_destructor(lua_State* L) {
+  delete *static_cast<lua_http_client**>(
+      luaL_checkudata(L, 1, "lua_broker_http_client"));
+  return 0;
+}
+
+/**
+ *  The Lua broker_http_client post method. The request is pipelined and
+ *  the method returns immediately, answers are got with wait().
+ *
+ *  Lua arguments: target, body and an optional content type.
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return 0
+ */
+static int l_broker_http_client_post(lua_State* L) {
+  lua_http_client* c{*static_cast<lua_http_client**>(
+      luaL_checkudata(L, 1, "lua_broker_http_client"))};
+  char const* target{luaL_checkstring(L, 2)};
+  size_t len;
+  char const* body{luaL_checklstring(L, 3, &len)};
+
+  http::request req{"POST", target, std::string(body, len)};
+  if (lua_isstring(L, 4))
+    req.add_header("Content-Type", lua_tostring(L, 4));
+  c->pending.push_back(c->client.send(std::move(req)));
+  return 0;
+}
+
+/**
+ *  The Lua broker_http_client in_flight method
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return 1, the number of requests not answered yet.
+ */
+static int l_broker_http_client_in_flight(lua_State* L) {
+  lua_http_client* c{*static_cast<lua_http_client**>(
+      luaL_checkudata(L, 1, "lua_broker_http_client"))};
+  lua_pushinteger(L, c->client.in_flight());
+  return 1;
+}
+
+/**
+ *  The Lua broker_http_client wait method. It waits for all the posted
+ *  requests.
+ *
+ *  @param L The Lua interpreter
+ *
+ *  @return 1, an array of tables { code = ..., body = ... } in the order
+ *          the requests were posted.
+ */
+static int l_broker_http_client_wait(lua_State* L) {
+  lua_http_client* c{*static_cast<lua_http_client**>(
+      luaL_checkudata(L, 1, "lua_broker_http_client"))};
+
+  lua_createtable(L, c->pending.size(), 0);
+  int idx{1};
+  std::string error;
+  while (!c->pending.empty()) {
+    std::future<http::response> f{std::move(c->pending.front())};
+    c->pending.pop_front();
+    try {
+      http::response ans{f.get()};
+      lua_createtable(L, 0, 2);
+      lua_pushinteger(L, ans.code);
+      lua_setfield(L, -2, "code");
+      lua_pushlstring(L, ans.body.c_str(), ans.body.size());
+      lua_setfield(L, -2, "body");
+      lua_rawseti(L, -2, idx++);
+    } catch (std::exception const& e) {
+      if (error.empty())
+        error = e.what();
+    }
+  }
+
+  if (!error.empty()) {
+    std::ostringstream ss;
+    ss << "broker_http_client::wait: " << error;
+    luaL_error(L, "%s", ss.str().c_str());
+  }
+  return 1;
+}
+
+/**
+ *  Register the broker_http_client class.
+ *
+ *  @param L The Lua interpreter
+ */
+static void broker_http_client_reg(lua_State* L) {
+  luaL_Reg s_broker_http_client_regs[] = {
+      {"new", l_broker_http_client_constructor},
+      {"__gc", l_broker_http_client_destructor},
+      {"post", l_broker_http_client_post},
+      {"in_flight", l_broker_http_client_in_flight},
+      {"wait", l_broker_http_client_wait},
+      {nullptr, nullptr}};
+
+  luaL_newmetatable(L, "lua_broker_http_client");
+#ifdef LUA51
+  luaL_register(L, NULL, s_broker_http_client_regs);
+#else
+  luaL_setfuncs(L, s_broker_http_client_regs, 0);
+#endif
+  lua_pushvalue(L, -1);
+  lua_setfield(L, -1, "__index");
+  lua_setglobal(L, "broker_http_client");
+}
+
 /**
  *  Load the Lua interpreter with the standard libraries
  *  and the broker lua sdk.
@@ -264,4 +437,6 @@ void broker_socket::broker_socket_reg(lua_State* L) {
 
   // And now, we use setglobal to store userdata as the variable "broker".
   lua_setglobal(L, "broker_tcp_socket");
+
+  broker_http_client_reg(L);
 }
@@ -269,6 +269,50 @@ void cached::update(time_t t, std::string const& value) {
   }
 }
 
+/**
+ *  Update the RRD file with many values at once. Values are sent in as
+ *  few UPDATE commands as rrdcached accepts.
+ *
+ *  @param[in] pts  Values formatted as "time:value", in time order.
+ */
+void cached::update(std::vector<std::string> const& pts) {
+  // rrdcached reads commands in a 4 kB buffer.
+  size_t const max_command_size(4000);
+
+  std::vector<std::string>::const_iterator it(pts.begin());
+  while (it != pts.end()) {
+    // Build rrdcached command.
+    std::string command("UPDATE ");
+    command.append(_filename);
+    do {
+      command.push_back(' ');
+      command.append(*it);
+      ++it;
+    } while (it != pts.end() &&
+             command.size() + it->size() + 2 < max_command_size);
+    command.push_back('\n');
+
+    // Send command.
+    logging::debug(logging::high) << "RRD: updating file '" << _filename
+                                  << "' (" << command << ")";
+    try {
+      if (_type == cached::tcp)
+        _send_to_cached<std::unique_ptr<ip::tcp::socket>&>(command,
+                                                           _tcp_socket);
+      else
+        _send_to_cached<std::unique_ptr<local::stream_protocol::socket>&>(
+            command, _local_socket);
+    }
+    catch (msg_fmt const& e) {
+      if (!strstr(e.what(), "illegal attempt to update using time"))
+        throw exceptions::update(e.what());
+      else
+        logging::error(logging::low) << "RRD: ignored update error in file '"
+                                     << _filename << "': " << e.what() + 5;
+    }
+  }
+}
+
 /**************************************
  *                                     *
  *           Private Methods           *
@@ -168,3 +168,39 @@ void lib::update(time_t t, std::string const& value) {
                                    << _filename << "': " << msg;
   }
 }
+
+/**
+ *  Update the RRD file with many values at once.
+ *
+ *  @param[in] pts  Values formatted as "time:value", in time order.
+ */
+void lib::update(std::vector<std::string> const& pts) {
+  if (pts.empty())
+    return;
+
+  // Set argument table.
+  std::vector<char const*> argv;
+  argv.reserve(pts.size() + 1);
+  for (std::string const& pt : pts)
+    argv.push_back(pt.c_str());
+  argv.push_back(nullptr);
+
+  // Debug message.
+  log_v2::perfdata()->debug("RRD: updating file '{}' with {} values ({} to {})",
+                            _filename,
+                            pts.size(),
+                            pts.front(),
+                            pts.back());
+
+  // Update RRD file.
+  rrd_clear_error();
+  if (rrd_update_r(_filename.c_str(), nullptr, pts.size(), argv.data())) {
+    char const* msg(rrd_get_error());
+    if (!strstr(msg, "illegal attempt to update using time"))
+      logging::error(logging::high) << "RRD: failed to update values in file '"
+                                    << _filename << "': " << msg;
+    else
+      logging::error(logging::low) << "RRD: ignored update error in file '"
+                                   << _filename << "': " << msg;
+  }
+}
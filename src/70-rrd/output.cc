@@ -18,6 +18,7 @@
 
 #include <cassert>
 #include "com/centreon/broker/rrd/output.hh"
+#include <fmt/format.h>
 #include <cstdlib>
 #include <iomanip>
 #include <sstream>
@@ -205,46 +206,12 @@ int output::write(std::shared_ptr<io::data> const& d) {
             _backend->open(
                 metric_path, e->rrd_len, e->ctime - 1, interval, e->value_type);
           }
-          std::ostringstream oss;
-          switch (e->value_type) {
-            case storage::perfdata::gauge:
-              oss << std::fixed << e->value;
-              log_v2::perfdata()->trace(
-                  "RRD: update metric {} of type GAUGE with {}",
-                  e->metric_id,
-                  oss.str());
-              break;
-            case storage::perfdata::counter:
-              oss << static_cast<uint64_t>(e->value);
-              log_v2::perfdata()->trace(
-                  "RRD: update metric {} of type COUNTER with {}",
-                  e->metric_id,
-                  oss.str());
-              break;
-            case storage::perfdata::derive:
-              oss << static_cast<int64_t>(e->value);
-              log_v2::perfdata()->trace(
-                  "RRD: update metric {} of type DERIVE with {}",
-                  e->metric_id,
-                  oss.str());
-              break;
-            case storage::perfdata::absolute:
-              oss << static_cast<uint64_t>(e->value);
-              log_v2::perfdata()->trace(
-                  "RRD: update metric {} of type ABSOLUTE with {}",
-                  e->metric_id,
-                  oss.str());
-              break;
-            default:
-              oss << std::fixed << e->value;
-              log_v2::perfdata()->trace(
-                  "RRD: update metric {} of type {} with {}",
-                  e->metric_id,
-                  e->value_type,
-                  oss.str());
-              break;
-          }
-          _backend->update(e->ctime, oss.str());
+          std::string value(_metric_value(e->value_type, e->value));
+          log_v2::perfdata()->trace("RRD: update metric {} of type {} with {}",
+                                    e->metric_id,
+                                    e->value_type,
+                                    value);
+          _backend->update(e->ctime, value);
         } else
           // Cache value.
           it->second.push_back(d);
@@ -281,16 +248,7 @@ int output::write(std::shared_ptr<io::data> const& d) {
             assert(e->rrd_len);
             _backend->open(status_path, e->rrd_len, e->ctime - 1, interval);
           }
-          std::string value;
-          if (e->state == 0)
-            value = "100";
-          else if (e->state == 1)
-            value = "75";
-          else if (e->state == 2)
-            value = "0";
-          else
-            value = "";
-          _backend->update(e->ctime, value);
+          _backend->update(e->ctime, _status_value(e->state));
         } else
           // Cache value.
           it->second.push_back(d);
@@ -349,6 +307,63 @@ int output::write(std::shared_ptr<io::data> const& d) {
         }
       }
     } break;
+    case storage::rebuild_data::static_type() : {
+      std::shared_ptr<storage::rebuild_data> e(
+          std::static_pointer_cast<storage::rebuild_data>(d));
+      if (e->is_index ? !_write_status : !_write_metrics)
+        break;
+
+      // Generate path.
+      std::string path;
+      {
+        std::ostringstream oss;
+        oss << (e->is_index ? _status_path : _metrics_path) << e->id << ".rrd";
+        path = oss.str();
+      }
+
+      // Format all the values.
+      std::vector<std::string> pts;
+      size_t pos(0);
+      time_t ctime;
+      double value;
+      time_t first(0);
+      time_t last(0);
+      while (e->next_value(pos, ctime, value)) {
+        std::string v(e->is_index ? _status_value(value)
+                                  : _metric_value(e->value_type, value));
+        if (v.empty())
+          continue;
+        // RRD stops the whole update at the first time that does not
+        // increase, so duplicates would drop the rest of the values.
+        if (!pts.empty() && ctime <= last) {
+          log_v2::perfdata()->debug(
+              "RRD: ignoring rebuild value of {} {} at {}: not after {}",
+              e->is_index ? "index" : "metric", e->id, ctime, last);
+          continue;
+        }
+        if (pts.empty())
+          first = ctime;
+        last = ctime;
+        pts.push_back(fmt::format("{}:{}", ctime, v));
+      }
+      log_v2::perfdata()->debug("RRD: rebuild data for {} {} ({} values)",
+                                e->is_index ? "index" : "metric",
+                                e->id,
+                                pts.size());
+      if (pts.empty())
+        break;
+
+      // The file was removed when the rebuild started.
+      try {
+        _backend->open(path);
+      }
+      catch (exceptions::open const& b) {
+        time_t interval(e->interval ? e->interval : 60);
+        assert(e->rrd_len);
+        _backend->open(path, e->rrd_len, first - 1, interval, e->value_type);
+      }
+      _backend->update(pts);
+    } break;
     case storage::remove_graph::static_type() : {
       // Debug message.
       std::shared_ptr<storage::remove_graph> e(
@@ -378,3 +393,51 @@ int output::write(std::shared_ptr<io::data> const& d) {
 
   return 1;
 }
+
+/**************************************
+ *                                     *
+ *           Private Methods           *
+ *                                     *
+ **************************************/
+
+/**
+ *  Format a metric value for RRD.
+ *
+ *  @param[in] value_type  Metric type.
+ *  @param[in] value       The value.
+ *
+ *  @return The value as expected by RRD for this type.
+ */
+std::string output::_metric_value(short value_type, double value) {
+  std::ostringstream oss;
+  switch (value_type) {
+    case storage::perfdata::counter:
+    case storage::perfdata::absolute:
+      oss << static_cast<uint64_t>(value);
+      break;
+    case storage::perfdata::derive:
+      oss << static_cast<int64_t>(value);
+      break;
+    default:
+      oss << std::fixed << value;
+      break;
+  }
+  return oss.str();
+}
+
+/**
+ *  Format a status for RRD.
+ *
+ *  @param[in] state  The service state.
+ *
+ *  @return The value drawn in the status graph, empty if unknown.
+ */
+std::string output::_status_value(short state) {
+  if (state == 0)
+    return "100";
+  else if (state == 1)
+    return "75";
+  else if (state == 2)
+    return "0";
+  return "";
+}
@@ -32,6 +32,7 @@
 #include "com/centreon/broker/io/protocols.hh"
 #include "com/centreon/broker/logging/manager.hh"
 #include "com/centreon/broker/multiplexing/engine.hh"
+#include "com/centreon/broker/processing/executor.hh"
 #include "com/centreon/broker/time/timezone_manager.hh"
 
 using namespace com::centreon::broker;
@@ -47,6 +48,7 @@ using namespace com::centreon::broker;
  */
 void config::applier::deinit() {
   config::applier::endpoint::unload();
+  processing::executor::unload();
   config::applier::logger::unload();
   config::applier::state::unload();
   bbdo::unload();
@@ -65,6 +67,7 @@ void config::applier::deinit() {
  */
 void config::applier::init() {
   // Load singletons.
+  processing::executor::load();
   multiplexing::engine::load();
   io::events::load();
   io::protocols::load();
@@ -30,6 +30,7 @@
 #include "com/centreon/broker/config/parser.hh"
 #include "com/centreon/broker/config/state.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
+#include "com/centreon/broker/io/data_pool.hh"
 #include "com/centreon/broker/logging/logging.hh"
 #include "com/centreon/broker/misc/string.hh"
 #include "com/centreon/broker/neb/callback.hh"
@@ -131,6 +132,51 @@ extern "C" void event_statistics(void* args) {
   }
 }
 
+/**
+ *  Start the asynchronous publisher of the calling thread (the engine
+ *  main loop) with the "cbmod_queue_size" and "cbmod_queue_overflow"
+ *  configuration parameters. A running publisher is stopped first, its
+ *  pending events being published, so that new parameters are applied
+ *  each time the configuration is.
+ *
+ *  @param[in] conf  Broker configuration.
+ */
+static void start_publisher(config::state const& conf) {
+  size_t queue_size{65536};
+  multiplexing::async_publisher::overflow_policy policy{
+      multiplexing::async_publisher::overflow_block};
+  std::string err;
+
+  auto it{conf.params().find("cbmod_queue_size")};
+  if (it != conf.params().end()) {
+    json11::Json value{json11::Json::parse(it->second, err)};
+    if (err.empty() && value.is_number() && value.int_value() >= 0)
+      queue_size = value.int_value();
+    else
+      logging::config(logging::high)
+          << "callbacks: cbmod_queue_size must be a positive integer, "
+          << "using " << queue_size;
+  }
+
+  it = conf.params().find("cbmod_queue_overflow");
+  if (it != conf.params().end()) {
+    json11::Json value{json11::Json::parse(it->second, err)};
+    if (err.empty() && value.string_value() == "spill")
+      policy = multiplexing::async_publisher::overflow_spill;
+    else if (!err.empty() || value.string_value() != "block")
+      logging::config(logging::high)
+          << "callbacks: cbmod_queue_overflow must be 'block' or 'spill', "
+          << "using 'block'";
+  }
+
+  // With a null queue size, events are published by the engine thread.
+  neb::gl_publisher.stop();
+  if (queue_size)
+    neb::gl_publisher.start(
+        queue_size, policy,
+        config::applier::state::instance().cache_dir() + ".spill.cbmod");
+}
+
 /**
  *  @brief Function that process acknowledgement data.
  *
@@ -1230,7 +1276,8 @@ int neb::callback_host_check(int callback_type, void* data) {
   try {
     // In/Out variables.
     nebstruct_host_check_data const* hcdata;
-    std::shared_ptr<neb::host_check> host_check(new neb::host_check);
+    std::shared_ptr<neb::host_check> host_check(
+        io::make_event<neb::host_check>());
 
     // Fill output var.
     hcdata = static_cast<nebstruct_host_check_data*>(data);
@@ -1281,7 +1328,8 @@ int neb::callback_host_status(int callback_type, void* data) {
   try {
     // In/Out variables.
     engine::host const* h;
-    std::shared_ptr<neb::host_status> host_status(new neb::host_status);
+    std::shared_ptr<neb::host_status> host_status(
+        io::make_event<neb::host_status>());
 
     // Fill output var.
     h = static_cast<engine::host*>(
@@ -1512,6 +1560,7 @@ int neb::callback_process(int callback_type, void* data) {
         // Apply resulting configuration.
         config::applier::state::instance().apply(conf);
         gl_generator.set(conf);
+        start_publisher(conf);
 
         // Set variables.
         statistics_interval = gl_generator.interval();
@@ -1908,7 +1957,8 @@ int neb::callback_service_check(int callback_type, void* data) {
   try {
     // In/Out variables.
     nebstruct_service_check_data const* scdata;
-    std::shared_ptr<neb::service_check> service_check(new neb::service_check);
+    std::shared_ptr<neb::service_check> service_check(
+        io::make_event<neb::service_check>());
 
     // Fill output var.
     scdata = static_cast<nebstruct_service_check_data*>(data);
@@ -1962,7 +2012,7 @@ int neb::callback_service_status(int callback_type, void* data) {
   try {
     // In/Out variables.
     std::shared_ptr<neb::service_status> service_status(
-        new neb::service_status);
+        io::make_event<neb::service_status>());
 
     // Fill output var.
     engine::service const* s{static_cast<engine::service*>(
@@ -29,7 +29,6 @@
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/logging/logging.hh"
 #include "com/centreon/broker/logging/manager.hh"
-#include "com/centreon/broker/multiplexing/publisher.hh"
 #include "com/centreon/broker/neb/callbacks.hh"
 #include "com/centreon/broker/neb/instance_configuration.hh"
 #include "com/centreon/broker/neb/internal.hh"
@@ -69,6 +68,9 @@ int nebmodule_deinit(int flags, int reason) {
     // Unregister callbacks.
     neb::unregister_callbacks();
 
+    // Publish pending events.
+    neb::gl_publisher.stop();
+
     // Unload singletons.
     com::centreon::broker::config::applier::deinit();
   }
@@ -233,8 +235,7 @@ int nebmodule_reload() {
       new neb::instance_configuration);
   ic->loaded = true;
   ic->poller_id = config::applier::state::instance().poller_id();
-  multiplexing::publisher p;
-  p.write(ic);
+  neb::gl_publisher.write(ic);
   return 0;
 }
 }
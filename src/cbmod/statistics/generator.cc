@@ -42,6 +42,7 @@
 #include "com/centreon/broker/neb/statistics/passive_service_latency.hh"
 #include "com/centreon/broker/neb/statistics/passive_service_state_change.hh"
 #include "com/centreon/broker/neb/statistics/passive_services_last.hh"
+#include "com/centreon/broker/neb/statistics/publisher_queue.hh"
 #include "com/centreon/broker/neb/statistics/services.hh"
 #include "com/centreon/broker/neb/statistics/services_actively_checked.hh"
 #include "com/centreon/broker/neb/statistics/services_checked.hh"
@@ -94,6 +95,7 @@ generator::generator() : _interval(0) {
       std::shared_ptr<plugin>(new passive_services_last);
   _plugins["passive_service_state_change"] =
       std::shared_ptr<plugin>(new passive_service_state_change);
+  _plugins["publisher_queue"] = std::shared_ptr<plugin>(new publisher_queue);
   _plugins["services_actively_checked"] =
       std::shared_ptr<plugin>(new services_actively_checked);
   _plugins["services_checked"] = std::shared_ptr<plugin>(new services_checked);
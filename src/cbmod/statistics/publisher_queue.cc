@@ -0,0 +1,83 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/neb/statistics/publisher_queue.hh"
+#include <sstream>
+#include "com/centreon/broker/config/applier/state.hh"
+#include "com/centreon/broker/neb/internal.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::neb;
+using namespace com::centreon::broker::neb::statistics;
+
+/**
+ *  Default constructor.
+ */
+publisher_queue::publisher_queue() : plugin("publisher_queue") {}
+
+/**
+ *  Copy constructor.
+ *
+ *  @param[in] right Object to copy.
+ */
+publisher_queue::publisher_queue(publisher_queue const& right)
+    : plugin(right) {}
+
+/**
+ *  Destructor.
+ */
+publisher_queue::~publisher_queue() {}
+
+/**
+ *  Assignment operator.
+ *
+ *  @param[in] right Object to copy.
+ *
+ *  @return This object.
+ */
+publisher_queue& publisher_queue::operator=(publisher_queue const& right) {
+  plugin::operator=(right);
+  return (*this);
+}
+
+/**
+ *  Get statistics.
+ *
+ *  @param[out] output   The output return by the plugin.
+ *  @param[out] perfdata The perf data return by the plugin.
+ */
+void publisher_queue::run(std::string& output, std::string& perfdata) {
+  multiplexing::async_publisher::stats s{gl_publisher.get_stats()};
+
+  // Output.
+  std::ostringstream oss;
+  oss << "Engine " << config::applier::state::instance().poller_name()
+      << " has " << s.queued << "/" << s.capacity
+      << " events waiting to be published";
+  output = oss.str();
+
+  // Perfdata.
+  oss.str("");
+  oss << "queued=" << s.queued << " published=" << s.published << "c"
+      << " failed=" << s.failed << "c"
+      << " spilled=" << s.spilled << "c"
+      << " blocked=" << s.blocked << "c"
+      << " avg_latency=" << s.average_latency << "ms"
+      << " max_latency=" << s.max_latency << "ms";
+  perfdata = oss.str();
+}
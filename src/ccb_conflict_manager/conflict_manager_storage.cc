@@ -22,6 +22,7 @@
 #include <sstream>
 
 #include "com/centreon/exceptions/msg_fmt.hh"
+#include "com/centreon/broker/io/data_pool.hh"
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/logging/logging.hh"
 #include "com/centreon/broker/neb/events.hh"
@@ -119,7 +120,7 @@ void conflict_manager::_storage_process_service_status(
 
     /* Create the metric mapping. */
     std::shared_ptr<storage::index_mapping> im{
-        std::make_shared<storage::index_mapping>(
+        io::make_event<storage::index_mapping>(
             index_id, host_id, service_id)};
     multiplexing::publisher pblshr;
     pblshr.write(im);
@@ -247,7 +248,7 @@ void conflict_manager::_storage_process_service_status(
         service_id,
         index_id,
         rrd_len);
-    std::shared_ptr<storage::status> status(std::make_shared<storage::status>(
+    std::shared_ptr<storage::status> status(io::make_event<storage::status>(
         ss.last_check,
         index_id,
         static_cast<uint32_t>(ss.check_interval * _interval_length),
@@ -430,7 +431,7 @@ void conflict_manager::_storage_process_service_status(
             }
           }
           to_publish.emplace_back(
-              std::make_shared<storage::metric_mapping>(index_id, metric_id));
+              io::make_event<storage::metric_mapping>(index_id, metric_id));
 
           if (_store_in_db) {
             // Append perfdata to queue.
@@ -445,7 +446,7 @@ void conflict_manager::_storage_process_service_status(
           // Send perfdata event to processing.
           if (!index_locked) {
             std::shared_ptr<storage::metric> perf{
-                std::make_shared<storage::metric>(
+                io::make_event<storage::metric>(
                     ss.host_id,
                     ss.service_id,
                     pd.name(),
@@ -589,7 +590,7 @@ void conflict_manager::_check_deleted_index() {
 
       // Remove associated graph.
       std::shared_ptr<storage::remove_graph> rg{
-          std::make_shared<storage::remove_graph>(index_id, true)};
+          io::make_event<storage::remove_graph>(index_id, true)};
       multiplexing::publisher().write(rg);
     }
   }
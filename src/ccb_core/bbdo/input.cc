@@ -30,6 +30,7 @@
 #include "com/centreon/broker/bbdo/version_response.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 #include "com/centreon/broker/exceptions/timeout.hh"
+#include "com/centreon/broker/io/data_pool.hh"
 #include "com/centreon/broker/io/events.hh"
 #include "com/centreon/broker/io/raw.hh"
 #include "com/centreon/broker/log_v2.hh"
@@ -495,8 +496,15 @@ bool input::read_any(std::shared_ptr<io::data>& d, time_t deadline) {
     }
 
     // Unserialize event.
-    d.reset(unserialize(
+    // The control block of the event also comes from the events pool.
+    io::data* event(unserialize(
         event_id, source_id, destination_id, packet.data(), packet.size()));
+    if (event)
+      d = std::shared_ptr<io::data>(event,
+                                    std::default_delete<io::data>(),
+                                    io::pool_allocator<io::data>());
+    else
+      d.reset();
     if (d) {
       log_v2::bbdo()->debug(
           "BBDO: unserialized {0} bytes for event of type {1}",
@@ -0,0 +1,486 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/http/client.hh"
+#include <zlib.h>
+#include <array>
+#include "com/centreon/broker/log_v2.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::http;
+
+constexpr std::size_t http_read_size = 16384;
+
+/**
+ *  A keep-alive connection of the pool. Requests are answered in the
+ *  order they were written, so in_flight is a FIFO.
+ */
+struct client::connection {
+  asio::ip::tcp::socket socket;
+  asio::steady_timer timer;
+  std::deque<pending_ptr> in_flight;
+  std::string out;
+  std::string writing;
+  std::array<char, http_read_size> in;
+  response_parser parser;
+  bool closed;
+
+  connection(asio::io_context& ctx)
+      : socket{ctx}, timer{ctx}, closed{false} {}
+};
+
+/**
+ *  Compress a buffer in the gzip format.
+ *
+ *  @param[in] data  Buffer to compress.
+ *
+ *  @return The compressed buffer.
+ */
+static std::string gzip(std::string const& data) {
+  z_stream zs{};
+  if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK)
+    throw msg_fmt("http: cannot initialize gzip compression");
+
+  std::string retval;
+  retval.resize(deflateBound(&zs, data.size()));
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  zs.avail_in = data.size();
+  zs.next_out = reinterpret_cast<Bytef*>(&retval[0]);
+  zs.avail_out = retval.size();
+  int ret{deflate(&zs, Z_FINISH)};
+  deflateEnd(&zs);
+  if (ret != Z_STREAM_END)
+    throw msg_fmt("http: gzip compression failed: error {}", ret);
+  retval.resize(zs.total_out);
+  return retval;
+}
+
+/**
+ *  Constructor. No connection is established here, see connect().
+ *
+ *  @param[in] host  Server host name or address.
+ *  @param[in] port  Server port.
+ *  @param[in] conf  Pool configuration.
+ */
+client::client(std::string const& host, uint16_t port, config const& conf)
+    : _host{host},
+      _port{port},
+      _host_header{host + ":" + std::to_string(port)},
+      _conf{conf},
+      _work{asio::make_work_guard(_io_context)},
+      _resolver{_io_context},
+      _connecting{0},
+      _closing{false},
+      _in_flight{0} {
+  if (!_conf.max_connections)
+    _conf.max_connections = 1;
+  if (!_conf.max_pipeline)
+    _conf.max_pipeline = 1;
+  _thread = std::thread([this] {
+    for (;;) {
+      try {
+        _io_context.run();
+        break;
+      } catch (std::exception const& e) {
+        log_v2::tcp()->error("http: error in client of {}: {}", _host_header,
+                             e.what());
+      }
+    }
+  });
+}
+
+/**
+ *  Destructor. Requests not answered yet fail.
+ */
+client::~client() {
+  asio::post(_io_context, [this] {
+    _closing = true;
+    _resolver.cancel();
+    std::list<connection_ptr> connections{_connections};
+    for (connection_ptr const& c : connections)
+      _close(c, "client stopped");
+    for (pending_ptr const& p : _waiting)
+      _fail(p, "client stopped");
+    _waiting.clear();
+  });
+  _work.reset();
+  _thread.join();
+}
+
+/**
+ *  Synchronously open a first connection to the server, so that a bad
+ *  address or an unreachable server is reported immediately.
+ */
+void client::connect() {
+  connection_ptr c{std::make_shared<connection>(_io_context)};
+  asio::ip::tcp::resolver resolver{_io_context};
+  std::error_code err;
+
+  // It can resolve to multiple addresses like ipv4 and ipv6, asio::connect()
+  // tries all of them to find the first available one.
+  auto endpoints(resolver.resolve(_host, std::to_string(_port), err));
+  if (!err)
+    asio::connect(c->socket, endpoints, err);
+  if (err)
+    throw msg_fmt("http: couldn't connect to '{}' on port '{}': {}", _host,
+                  _port, err.message());
+  c->socket.set_option(asio::ip::tcp::no_delay(true), err);
+
+  asio::post(_io_context, [this, c] {
+    if (_closing || _connections.size() + _connecting >= _conf.max_connections)
+      _close(c, "pool full");
+    else {
+      _connections.push_back(c);
+      _start_read(c);
+      _dispatch();
+    }
+  });
+}
+
+/**
+ *  Send a request. The body is compressed here, on the caller thread, if
+ *  gzip is enabled.
+ *
+ *  @param[in] req  The request to send.
+ *
+ *  @return A future holding the server answer, or an exception if the
+ *          request could not be sent or answered.
+ */
+std::future<response> client::send(request req) {
+  pending_ptr p{std::make_shared<pending>()};
+  p->no_body = req.method == "HEAD";
+  bool gzipped{_conf.gzip && !req.body.empty()};
+  if (gzipped)
+    req.body = gzip(req.body);
+  req.serialize(p->data, _host_header, gzipped);
+
+  std::future<response> retval{p->promise.get_future()};
+  ++_in_flight;
+  asio::post(_io_context, [this, p] {
+    if (_closing)
+      _fail(p, "client stopped");
+    else {
+      _waiting.push_back(p);
+      _dispatch();
+    }
+  });
+  return retval;
+}
+
+/**
+ *  Get the number of requests sent or queued and not answered yet.
+ *
+ *  @return The number of requests in flight.
+ */
+uint32_t client::in_flight() const { return _in_flight; }
+
+/**
+ *  Get the server host.
+ *
+ *  @return The host as given to the constructor.
+ */
+std::string const& client::host() const { return _host; }
+
+/**
+ *  Get the server port.
+ *
+ *  @return The port.
+ */
+uint16_t client::port() const { return _port; }
+
+/**
+ *  Give waiting requests to connections having a free pipeline slot. The
+ *  least busy connection is chosen, and a new connection is preferred to
+ *  pipelining as long as the pool is not full.
+ */
+void client::_dispatch() {
+  if (_closing)
+    return;
+
+  while (!_waiting.empty()) {
+    connection_ptr best;
+    for (connection_ptr const& c : _connections)
+      if (c->in_flight.size() < _conf.max_pipeline &&
+          (!best || c->in_flight.size() < best->in_flight.size()))
+        best = c;
+
+    if ((!best || !best->in_flight.empty()) &&
+        _connections.size() + _connecting < _conf.max_connections) {
+      _open_connection();
+      if (!best)
+        break;
+    }
+    if (!best)
+      break;
+
+    pending_ptr p{std::move(_waiting.front())};
+    _waiting.pop_front();
+    _assign(best, std::move(p));
+  }
+}
+
+/**
+ *  Start an asynchronous connection to the server.
+ *
+ *  @return The connection, added to the pool once connected.
+ */
+client::connection_ptr client::_open_connection() {
+  connection_ptr c{std::make_shared<connection>(_io_context)};
+  ++_connecting;
+  log_v2::tcp()->debug("http: opening a new connection to {}", _host_header);
+  _resolver.async_resolve(
+      _host, std::to_string(_port),
+      [this, c](std::error_code const& err,
+                asio::ip::tcp::resolver::results_type endpoints) {
+        if (err)
+          _on_connect(c, err);
+        else
+          asio::async_connect(c->socket, endpoints,
+                              [this, c](std::error_code const& err,
+                                        asio::ip::tcp::endpoint const&) {
+                                _on_connect(c, err);
+                              });
+      });
+  return c;
+}
+
+/**
+ *  Called when an asynchronous connection is done.
+ *
+ *  @param[in] c    The connection.
+ *  @param[in] err  Connection error, if any.
+ */
+void client::_on_connect(connection_ptr c, std::error_code const& err) {
+  --_connecting;
+  if (_closing) {
+    std::error_code ec;
+    c->socket.close(ec);
+    return;
+  }
+
+  if (err) {
+    log_v2::tcp()->error("http: couldn't connect to {}: {}", _host_header,
+                         err.message());
+    // Nobody can send the waiting requests.
+    if (_connections.empty() && !_connecting) {
+      for (pending_ptr const& p : _waiting)
+        _fail(p, err.message());
+      _waiting.clear();
+    }
+    return;
+  }
+
+  std::error_code ec;
+  c->socket.set_option(asio::ip::tcp::no_delay(true), ec);
+  _connections.push_back(c);
+  _start_read(c);
+  _dispatch();
+}
+
+/**
+ *  Pipeline a request on a connection.
+ *
+ *  @param[in] c  The connection.
+ *  @param[in] p  The request.
+ */
+void client::_assign(connection_ptr const& c, pending_ptr p) {
+  if (c->in_flight.empty())
+    _arm_timer(c);
+  c->out.append(p->data);
+  c->in_flight.push_back(std::move(p));
+  if (c->writing.empty())
+    _start_write(c);
+}
+
+/**
+ *  Write everything buffered on a connection.
+ *
+ *  @param[in] c  The connection.
+ */
+void client::_start_write(connection_ptr c) {
+  c->writing.swap(c->out);
+  c->out.clear();
+  asio::async_write(
+      c->socket, asio::buffer(c->writing),
+      [this, c](std::error_code const& err, size_t) { _on_write(c, err); });
+}
+
+/**
+ *  Called when a write is done.
+ *
+ *  @param[in] c    The connection.
+ *  @param[in] err  Write error, if any.
+ */
+void client::_on_write(connection_ptr c, std::error_code const& err) {
+  if (c->closed)
+    return;
+  if (err) {
+    _close(c, err.message());
+    return;
+  }
+  c->writing.clear();
+  if (!c->out.empty())
+    _start_write(c);
+}
+
+/**
+ *  Wait for data on a connection. Connections are always read, even when
+ *  idle, to notice servers closing them.
+ *
+ *  @param[in] c  The connection.
+ */
+void client::_start_read(connection_ptr c) {
+  c->socket.async_read_some(asio::buffer(c->in),
+                            [this, c](std::error_code const& err,
+                                      size_t bytes) { _on_read(c, err, bytes); });
+}
+
+/**
+ *  Called when data is received. Every complete response is given to
+ *  the oldest request of the connection.
+ *
+ *  @param[in] c      The connection.
+ *  @param[in] err    Read error, if any.
+ *  @param[in] bytes  Number of bytes read.
+ */
+void client::_on_read(connection_ptr c, std::error_code const& err,
+                      size_t bytes) {
+  if (c->closed)
+    return;
+
+  bool keep_alive{true};
+  try {
+    size_t pos{0};
+    while (pos < bytes && keep_alive) {
+      if (c->in_flight.empty())
+        throw msg_fmt("unexpected data received");
+      c->parser.expect_no_body(c->in_flight.front()->no_body);
+      pos += c->parser.parse(c->in.data() + pos, bytes - pos);
+      if (c->parser.done()) {
+        pending_ptr p{std::move(c->in_flight.front())};
+        c->in_flight.pop_front();
+        keep_alive = c->parser.get().keep_alive();
+        p->promise.set_value(std::move(c->parser.get()));
+        --_in_flight;
+        c->parser.reset();
+      }
+    }
+    // A response without Content-Length ends with the connection.
+    if (err == asio::error::eof && !c->in_flight.empty()) {
+      c->parser.eof();
+      if (c->parser.done()) {
+        pending_ptr p{std::move(c->in_flight.front())};
+        c->in_flight.pop_front();
+        p->promise.set_value(std::move(c->parser.get()));
+        --_in_flight;
+        c->parser.reset();
+      }
+    }
+  } catch (std::exception const& e) {
+    _close(c, e.what());
+    return;
+  }
+
+  if (!keep_alive) {
+    // The server won't answer the requests pipelined after this one, they
+    // were not processed and can be sent again.
+    for (auto it = c->in_flight.rbegin(), end = c->in_flight.rend(); it != end;
+         ++it)
+      _waiting.push_front(std::move(*it));
+    c->in_flight.clear();
+    _close(c, "connection closed by server");
+    return;
+  }
+  if (err) {
+    _close(c, err == asio::error::eof ? "connection closed by server"
+                                      : err.message());
+    return;
+  }
+
+  if (c->in_flight.empty())
+    c->timer.cancel();
+  else
+    _arm_timer(c);
+  _start_read(c);
+  _dispatch();
+}
+
+/**
+ *  (Re)start the answer timeout of a connection.
+ *
+ *  @param[in] c  The connection.
+ */
+void client::_arm_timer(connection_ptr const& c) {
+  c->timer.expires_after(_conf.timeout);
+  c->timer.async_wait(
+      [this, c](std::error_code const& err) { _on_timeout(c, err); });
+}
+
+/**
+ *  Called when a connection did not receive an answer in time.
+ *
+ *  @param[in] c    The connection.
+ *  @param[in] err  Cancelled if the timer was re-armed or stopped.
+ */
+void client::_on_timeout(connection_ptr c, std::error_code const& err) {
+  if (err || c->closed)
+    return;
+  _close(c, "timeout while waiting for the answer");
+}
+
+/**
+ *  Close a connection and fail its pending requests.
+ *
+ *  @param[in] c       The connection.
+ *  @param[in] reason  Error message given to the pending requests.
+ */
+void client::_close(connection_ptr const& c, std::string const& reason) {
+  if (c->closed)
+    return;
+  c->closed = true;
+
+  std::error_code ec;
+  c->timer.cancel(ec);
+  c->socket.shutdown(asio::ip::tcp::socket::shutdown_both, ec);
+  c->socket.close(ec);
+  if (!c->in_flight.empty())
+    log_v2::tcp()->error("http: connection to {} closed with {} pending "
+                         "requests: {}",
+                         _host_header, c->in_flight.size(), reason);
+  for (pending_ptr const& p : c->in_flight)
+    _fail(p, reason);
+  c->in_flight.clear();
+  _connections.remove(c);
+
+  _dispatch();
+}
+
+/**
+ *  Fail a request.
+ *
+ *  @param[in] p       The request.
+ *  @param[in] reason  Error message.
+ */
+void client::_fail(pending_ptr const& p, std::string const& reason) {
+  p->promise.set_exception(std::make_exception_ptr(msg_fmt(
+      "http: request to '{}' on port '{}' failed: {}", _host, _port, reason)));
+  --_in_flight;
+}
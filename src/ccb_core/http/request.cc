@@ -0,0 +1,71 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/http/request.hh"
+
+using namespace com::centreon::broker::http;
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] method  HTTP method (GET, POST, ...).
+ *  @param[in] target  Request target, path and query string.
+ *  @param[in] body    Request body.
+ */
+request::request(std::string const& method,
+                 std::string const& target,
+                 std::string body)
+    : method(method), target(target), body(std::move(body)) {}
+
+/**
+ *  Add a header to the request.
+ *
+ *  @param[in] name   Header name.
+ *  @param[in] value  Header value.
+ */
+void request::add_header(std::string const& name, std::string const& value) {
+  headers.emplace_back(name, value);
+}
+
+/**
+ *  Append the request, as sent on the wire, to a buffer.
+ *
+ *  @param[out] buffer   Output buffer.
+ *  @param[in]  host     Value of the Host header.
+ *  @param[in]  gzipped  True if body is gzip-compressed.
+ */
+void request::serialize(std::string& buffer,
+                        std::string const& host,
+                        bool gzipped) const {
+  buffer.reserve(buffer.size() + body.size() + 256);
+  buffer.append(method)
+      .append(" ")
+      .append(target)
+      .append(" HTTP/1.1\r\nHost: ")
+      .append(host)
+      .append("\r\n");
+  for (auto const& h : headers)
+    buffer.append(h.first).append(": ").append(h.second).append("\r\n");
+  if (gzipped)
+    buffer.append("Content-Encoding: gzip\r\n");
+  if (!body.empty() || method == "POST" || method == "PUT")
+    buffer.append("Content-Length: ")
+        .append(std::to_string(body.size()))
+        .append("\r\n");
+  buffer.append("\r\n").append(body);
+}
@@ -0,0 +1,288 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/http/response.hh"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include "com/centreon/broker/misc/string.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::http;
+
+/**************************************
+ *                                     *
+ *              response               *
+ *                                     *
+ **************************************/
+
+/**
+ *  Default constructor.
+ */
+response::response() : code{0} {}
+
+/**
+ *  Get a header value.
+ *
+ *  @param[in] name  Lower-cased header name.
+ *
+ *  @return The header value, an empty string if not found.
+ */
+std::string const& response::header(std::string const& name) const {
+  static std::string const empty;
+  auto it = headers.find(name);
+  return it == headers.end() ? empty : it->second;
+}
+
+/**
+ *  Tell if the server keeps the connection open after this response.
+ *
+ *  @return True if the connection can be reused.
+ */
+bool response::keep_alive() const {
+  std::string connection{header("connection")};
+  std::transform(connection.begin(), connection.end(), connection.begin(),
+                 ::tolower);
+  if (version == "HTTP/1.0")
+    return connection == "keep-alive";
+  return connection != "close";
+}
+
+/**************************************
+ *                                     *
+ *          response_parser            *
+ *                                     *
+ **************************************/
+
+/**
+ *  Default constructor.
+ */
+response_parser::response_parser()
+    : _state{status_line}, _no_body{false}, _remaining{0} {}
+
+/**
+ *  Parse incoming bytes.
+ *
+ *  @param[in] data  Received bytes.
+ *  @param[in] size  Number of bytes.
+ *
+ *  @return Number of bytes consumed. It is lower than size only if the
+ *          response is complete.
+ */
+size_t response_parser::parse(char const* data, size_t size) {
+  size_t consumed{0};
+  std::string line;
+  while (consumed < size && _state != complete) {
+    switch (_state) {
+      case status_line:
+        if (_next_line(data, size, consumed, line) && !line.empty())
+          _parse_status(line);
+        break;
+      case header_lines:
+        if (_next_line(data, size, consumed, line)) {
+          if (line.empty())
+            _headers_done();
+          else
+            _parse_header(line);
+        }
+        break;
+      case body_length:
+      case chunk_data: {
+        size_t len{std::min(_remaining, size - consumed)};
+        _response.body.append(data + consumed, len);
+        consumed += len;
+        _remaining -= len;
+        if (!_remaining)
+          _state = (_state == body_length) ? complete : chunk_trailer;
+      } break;
+      case chunk_size:
+        if (_next_line(data, size, consumed, line)) {
+          try {
+            _remaining = std::stoul(line, nullptr, 16);
+          } catch (std::exception const& e) {
+            throw msg_fmt("http: invalid chunk size '{}'", line);
+          }
+          // Last chunk, optional trailers end with an empty line.
+          _state = _remaining ? chunk_data : trailer_lines;
+        }
+        break;
+      case chunk_trailer:
+        if (_next_line(data, size, consumed, line))
+          _state = chunk_size;
+        break;
+      case trailer_lines:
+        if (_next_line(data, size, consumed, line) && line.empty())
+          _state = complete;
+        break;
+      case body_eof:
+        _response.body.append(data + consumed, size - consumed);
+        consumed = size;
+        break;
+      case complete:
+        break;
+    }
+  }
+  return consumed;
+}
+
+/**
+ *  Tell if the response is complete.
+ *
+ *  @return True if the response is complete.
+ */
+bool response_parser::done() const { return _state == complete; }
+
+/**
+ *  Notify the parser that the connection was closed by the peer. Only
+ *  a response whose body is delimited by the connection end is then
+ *  complete.
+ */
+void response_parser::eof() {
+  if (_state == body_eof)
+    _state = complete;
+}
+
+/**
+ *  Tell the parser the response has no body whatever its headers say
+ *  (answer to a HEAD request).
+ *
+ *  @param[in] no_body  True if no body is expected.
+ */
+void response_parser::expect_no_body(bool no_body) { _no_body = no_body; }
+
+/**
+ *  Get the parsed response.
+ *
+ *  @return The response.
+ */
+response& response_parser::get() { return _response; }
+
+/**
+ *  Prepare the parser for the next response.
+ */
+void response_parser::reset() {
+  _state = status_line;
+  _no_body = false;
+  _remaining = 0;
+  _line.clear();
+  _response = response();
+}
+
+/**
+ *  Extract a CRLF (or LF) terminated line. Partial lines are kept
+ *  between calls.
+ *
+ *  @return True if a full line was extracted in line.
+ */
+bool response_parser::_next_line(char const* data,
+                                 size_t size,
+                                 size_t& consumed,
+                                 std::string& line) {
+  char const* start{data + consumed};
+  char const* eol{
+      static_cast<char const*>(memchr(start, '\n', size - consumed))};
+  if (!eol) {
+    _line.append(start, size - consumed);
+    consumed = size;
+    if (_line.size() > 65536)
+      throw msg_fmt("http: header line too long");
+    return false;
+  }
+  _line.append(start, eol - start);
+  consumed += eol - start + 1;
+  if (!_line.empty() && _line.back() == '\r')
+    _line.resize(_line.size() - 1);
+  line = std::move(_line);
+  _line.clear();
+  return true;
+}
+
+/**
+ *  Parse the status line.
+ *
+ *  @param[in] line  Status line without its end of line.
+ */
+void response_parser::_parse_status(std::string const& line) {
+  size_t sp1{line.find(' ')};
+  if (sp1 == std::string::npos || line.compare(0, 5, "HTTP/"))
+    throw msg_fmt("http: unrecognizable status line '{}'", line);
+  _response.version = line.substr(0, sp1);
+  size_t sp2{line.find(' ', sp1 + 1)};
+  try {
+    _response.code = std::stoi(line.substr(sp1 + 1, sp2 - sp1 - 1));
+  } catch (std::exception const& e) {
+    throw msg_fmt("http: unrecognizable status line '{}'", line);
+  }
+  if (sp2 != std::string::npos)
+    _response.reason = line.substr(sp2 + 1);
+  _state = header_lines;
+}
+
+/**
+ *  Parse a header line.
+ *
+ *  @param[in] line  Header line without its end of line.
+ */
+void response_parser::_parse_header(std::string const& line) {
+  size_t colon{line.find(':')};
+  if (colon == std::string::npos)
+    throw msg_fmt("http: invalid header line '{}'", line);
+  std::string name{line.substr(0, colon)};
+  std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+  std::string value{line.substr(colon + 1)};
+  misc::string::trim(value);
+  _response.headers[name] = std::move(value);
+}
+
+/**
+ *  Called on the empty line ending the headers.
+ */
+void response_parser::_headers_done() {
+  // Interim responses are skipped, the final one follows.
+  if (_response.code >= 100 && _response.code < 200) {
+    bool no_body{_no_body};
+    reset();
+    _no_body = no_body;
+    return;
+  }
+  if (_no_body || _response.code == 204 || _response.code == 304) {
+    _state = complete;
+    return;
+  }
+
+  std::string encoding{_response.header("transfer-encoding")};
+  std::transform(encoding.begin(), encoding.end(), encoding.begin(),
+                 ::tolower);
+  if (encoding.find("chunked") != std::string::npos) {
+    _state = chunk_size;
+    return;
+  }
+
+  std::string const& length{_response.header("content-length")};
+  if (!length.empty()) {
+    try {
+      _remaining = std::stoul(length);
+    } catch (std::exception const& e) {
+      throw msg_fmt("http: invalid Content-Length '{}'", length);
+    }
+    _state = _remaining ? body_length : complete;
+  } else
+    _state = body_eof;
+}
@@ -18,6 +18,7 @@
 
 #include <cassert>
 #include "com/centreon/broker/io/data.hh"
+#include "com/centreon/broker/io/data_pool.hh"
 
 using namespace com::centreon::broker::io;
 
@@ -75,3 +76,24 @@ data& data::operator=(data const& other) {
 uint32_t data::type() const noexcept {
   return _type;
 }
+
+/**
+ *  Allocate an event from the events memory pool.
+ *
+ *  @param[in] size  Size of the event.
+ *
+ *  @return Memory of the event.
+ */
+void* data::operator new(size_t size) {
+  return data_pool::allocate(size);
+}
+
+/**
+ *  Release the memory of an event.
+ *
+ *  @param[in] p     Memory of the event.
+ *  @param[in] size  Size of the event.
+ */
+void data::operator delete(void* p, size_t size) noexcept {
+  data_pool::deallocate(p, size);
+}
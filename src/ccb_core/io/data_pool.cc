@@ -0,0 +1,228 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/io/data_pool.hh"
+#include <atomic>
+#include <mutex>
+#include <new>
+
+using namespace com::centreon::broker::io;
+
+namespace {
+size_t const block_align = 16;
+size_t const classes_count = data_pool::max_block_size / block_align;
+size_t const slab_size = 64 * 1024;
+// Blocks kept by a thread per size class, and blocks moved at once
+// between a thread and the shared pool.
+size_t const cache_size = 512;
+size_t const batch_size = 128;
+
+struct block {
+  block* next;
+};
+
+struct free_list {
+  block* head;
+  size_t count;
+};
+
+/**
+ *  Blocks shared by all the threads.
+ */
+class shared_pool {
+ public:
+  shared_pool() : _slabs(0), _lists() {}
+
+  /**
+   *  Fill an empty list with a batch of blocks.
+   *
+   *  @param[in]  cls   Size class.
+   *  @param[out] list  Empty list.
+   */
+  void get(size_t cls, free_list& list) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      free_list& shared(_lists[cls]);
+      if (shared.count) {
+        block* last(shared.head);
+        size_t count(1);
+        while (count < batch_size && last->next) {
+          last = last->next;
+          ++count;
+        }
+        list.head = shared.head;
+        list.count = count;
+        shared.head = last->next;
+        shared.count -= count;
+        last->next = nullptr;
+        return;
+      }
+    }
+
+    // No free block, carve a new slab.
+    size_t size((cls + 1) * block_align);
+    char* slab(static_cast<char*>(::operator new(slab_size)));
+    ++_slabs;
+    block* head(nullptr);
+    size_t count(slab_size / size);
+    for (size_t i(count); i > 0; --i) {
+      block* b(reinterpret_cast<block*>(slab + (i - 1) * size));
+      b->next = head;
+      head = b;
+    }
+    list.head = head;
+    list.count = count;
+  }
+
+  /**
+   *  Give blocks of a list back.
+   *
+   *  @param[in]     cls    Size class.
+   *  @param[in,out] list   List of free blocks.
+   *  @param[in]     count  Number of blocks to give from the list.
+   */
+  void put(size_t cls, free_list& list, size_t count) {
+    if (!count)
+      return;
+    block* first(list.head);
+    block* last(first);
+    for (size_t i(1); i < count; ++i)
+      last = last->next;
+    list.head = last->next;
+    list.count -= count;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    free_list& shared(_lists[cls]);
+    last->next = shared.head;
+    shared.head = first;
+    shared.count += count;
+  }
+
+  size_t get_slabs_count() const noexcept { return _slabs; }
+
+ private:
+  std::atomic<size_t> _slabs;
+  free_list _lists[classes_count];
+  std::mutex _mutex;
+};
+
+/**
+ *  Get the shared pool. It is never destroyed, events may be released
+ *  by static objects.
+ */
+shared_pool& pool() {
+  static shared_pool* retval(new shared_pool);
+  return *retval;
+}
+
+/**
+ *  Free blocks of a thread.
+ */
+struct thread_cache {
+  thread_cache() : lists() {}
+  ~thread_cache() {
+    for (size_t i(0); i < classes_count; ++i)
+      pool().put(i, lists[i], lists[i].count);
+    destroyed = true;
+  }
+
+  free_list lists[classes_count];
+  static thread_local bool destroyed;
+};
+
+thread_local bool thread_cache::destroyed(false);
+thread_local thread_cache cache;
+
+/**
+ *  Get the size class of a block.
+ */
+inline size_t size_class(size_t size) {
+  return size ? (size - 1) / block_align : 0;
+}
+}  // namespace
+
+/**
+ *  Allocate a block.
+ *
+ *  @param[in] size  Size of the block.
+ *
+ *  @return The block, aligned for any type.
+ */
+void* data_pool::allocate(size_t size) {
+  if (size > max_block_size)
+    return ::operator new(size);
+  size_t cls(size_class(size));
+
+  // Events created while the thread exits do not use its cache.
+  if (thread_cache::destroyed) {
+    free_list list = {nullptr, 0};
+    pool().get(cls, list);
+    block* b(list.head);
+    list.head = b->next;
+    --list.count;
+    pool().put(cls, list, list.count);
+    return b;
+  }
+
+  free_list& list(cache.lists[cls]);
+  if (!list.head)
+    pool().get(cls, list);
+  block* b(list.head);
+  list.head = b->next;
+  --list.count;
+  return b;
+}
+
+/**
+ *  Release a block.
+ *
+ *  @param[in] p     Block returned by allocate().
+ *  @param[in] size  Size given to allocate().
+ */
+void data_pool::deallocate(void* p, size_t size) noexcept {
+  if (!p)
+    return;
+  if (size > max_block_size) {
+    ::operator delete(p);
+    return;
+  }
+  size_t cls(size_class(size));
+  block* b(static_cast<block*>(p));
+
+  if (thread_cache::destroyed) {
+    free_list list = {b, 1};
+    b->next = nullptr;
+    pool().put(cls, list, 1);
+    return;
+  }
+
+  free_list& list(cache.lists[cls]);
+  b->next = list.head;
+  list.head = b;
+  if (++list.count > cache_size)
+    pool().put(cls, list, batch_size);
+}
+
+/**
+ *  Get the number of slabs allocated from the system.
+ *
+ *  @return The number of slabs.
+ */
+size_t data_pool::get_slabs_count() noexcept {
+  return pool().get_slabs_count();
+}
@@ -75,6 +75,7 @@ unsigned short events::register_category(std::string const& name,
       ++hint;
   }
   _elements[hint].name = name;
+  _compile();
   return hint;
 }
 
@@ -85,8 +86,10 @@ unsigned short events::register_category(std::string const& name,
  */
 void events::unregister_category(unsigned short category_id) {
   categories_container::iterator it(_elements.find(category_id));
-  if (it != _elements.end())
+  if (it != _elements.end()) {
     _elements.erase(it);
+    _compile();
+  }
 }
 
 /**
@@ -110,6 +113,7 @@ uint32_t events::register_event(unsigned short category_id,
         category_id);
   int type(make_type(category_id, event_id));
   it->second.events[type] = info;
+  _compile();
   return type;
 }
 
@@ -123,8 +127,10 @@ void events::unregister_event(uint32_t type_id) {
   categories_container::iterator itc(_elements.find(category_id));
   if (itc != _elements.end()) {
     events_container::iterator ite(itc->second.events.find(type_id));
-    if (ite != itc->second.events.end())
+    if (ite != itc->second.events.end()) {
       itc->second.events.erase(ite);
+      _compile();
+    }
   }
 }
 
@@ -182,25 +188,6 @@ events::events_container events::get_events_by_category_name(
   throw msg_fmt("core: cannot find event category '{}'", name);
 }
 
-/**
- *  Get an event information structure.
- *
- *  @param[in] type  Event type ID.
- *
- *  @return Event information structure if found, NULL otherwise.
- */
-event_info const* events::get_event_info(uint32_t type) {
-  std::unordered_map<unsigned short, category_info>::const_iterator itc(
-      _elements.find(category_of_type(type)));
-  if (itc != _elements.end()) {
-    std::unordered_map<uint32_t, event_info>::const_iterator ite(
-        itc->second.events.find(type));
-    if (ite != itc->second.events.end())
-      return &ite->second;
-  }
-  return nullptr;
-}
-
 /**
  *  Get all the events matching this name.
  *
@@ -247,7 +234,7 @@ events::events_container events::get_matching_events(std::string const& name)
 /**
  *  Default constructor.
  */
-events::events() {
+events::events() : _dense(nullptr) {
   // Register internal category.
   register_category("internal", io::events::internal);
 }
@@ -256,3 +243,53 @@ events::events() {
  *  Destructor.
  */
 events::~events() { unregister_category(io::events::internal); }
+
+/**
+ *  Compile registered events into a new dense table and publish it.
+ */
+void events::_compile() {
+  std::unique_ptr<dense_table> table(new dense_table);
+
+  // Rows sizes.
+  std::vector<uint32_t> sizes;
+  for (categories_container::const_iterator it(_elements.begin()),
+       end(_elements.end());
+       it != end;
+       ++it) {
+    uint32_t slot(category_slot(it->first));
+    if (slot >= sizes.size())
+      sizes.resize(slot + 1, 0);
+    for (events_container::const_iterator ite(it->second.events.begin()),
+         ende(it->second.events.end());
+         ite != ende;
+         ++ite)
+      sizes[slot] = std::max<uint32_t>(sizes[slot],
+                                       element_of_type(ite->first) + 1);
+  }
+
+  // Rows offsets.
+  table->offsets.reserve(sizes.size() + 1);
+  uint32_t offset(0);
+  for (uint32_t size : sizes) {
+    table->offsets.push_back(offset);
+    offset += size;
+  }
+  table->offsets.push_back(offset);
+
+  // Event informations.
+  table->infos.resize(offset, nullptr);
+  for (categories_container::const_iterator it(_elements.begin()),
+       end(_elements.end());
+       it != end;
+       ++it) {
+    uint32_t first(table->offsets[category_slot(it->first)]);
+    for (events_container::const_iterator ite(it->second.events.begin()),
+         ende(it->second.events.end());
+         ite != ende;
+         ++ite)
+      table->infos[first + element_of_type(ite->first)] = &ite->second;
+  }
+
+  _dense.store(table.get(), std::memory_order_release);
+  _tables.push_back(std::move(table));
+}
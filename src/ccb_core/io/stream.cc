@@ -78,6 +78,21 @@ std::string stream::peer() const {
   return !_substream ? "(unknown)" : _substream->peer();
 }
 
+/**
+ *  Set the function to call when data arrives. By default, the
+ *  notifier is given to the sub-stream.
+ *
+ *  @param[in] notifier  Function called when read() can return new
+ *                       data, empty to remove it. It must be quick and
+ *                       must not use the stream.
+ *
+ *  @return True if the notifier will be called, false if the stream
+ *          must be polled.
+ */
+bool stream::set_read_notifier(std::function<void()> const& notifier) {
+  return _substream ? _substream->set_read_notifier(notifier) : false;
+}
+
 /**
  *  Set sub-stream.
  *
@@ -0,0 +1,428 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/multiplexing/async_publisher.hh"
+
+#include <chrono>
+
+#include "com/centreon/broker/logging/logging.hh"
+#include "com/centreon/broker/multiplexing/engine.hh"
+#include "com/centreon/exceptions/shutdown.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::multiplexing;
+
+/**
+ *  Default constructor. The publisher is synchronous until start() is
+ *  called.
+ */
+async_publisher::async_publisher()
+    : _mask(0),
+      _capacity(0),
+      _policy(overflow_block),
+      _running(false),
+      _head(0),
+      _spilling(false),
+      _tail(0),
+      _sleeping(false),
+      _published(0),
+      _failed(0),
+      _spilled(0),
+      _blocked(0),
+      _latency_sum(0),
+      _latency_max(0),
+      _latency_count(0) {}
+
+/**
+ *  Destructor.
+ */
+async_publisher::~async_publisher() {
+  try {
+    stop();
+  }
+  catch (...) {
+  }
+}
+
+/**
+ *  Get the publisher statistics.
+ *
+ *  @return Queue usage, counters and latencies in milliseconds.
+ */
+async_publisher::stats async_publisher::get_stats() const {
+  stats retval;
+  retval.queued = _head.load() - _tail.load();
+  retval.capacity = _capacity;
+  retval.published = _published;
+  retval.failed = _failed;
+  retval.spilled = _spilled;
+  retval.blocked = _blocked;
+  uint64_t count{_latency_count};
+  retval.average_latency = count ? _latency_sum / 1000000.0 / count : 0.0;
+  retval.max_latency = _latency_max / 1000000.0;
+  return retval;
+}
+
+/**
+ *  Read is not available on a publisher.
+ *
+ *  @param[out] d         Cleared.
+ *  @param[in]  deadline  Unused.
+ *
+ *  @return This method throws.
+ */
+bool async_publisher::read(std::shared_ptr<io::data>& d, time_t deadline) {
+  (void)deadline;
+  d.reset();
+  throw shutdown("cannot read from publisher");
+  return true;
+}
+
+/**
+ *  Check if the publishing thread is running.
+ *
+ *  @return true if events are published asynchronously.
+ */
+bool async_publisher::running() const noexcept { return _running; }
+
+/**
+ *  Start the publishing thread. The calling thread becomes the producer
+ *  of the lock-free queue, other threads will use a locked queue.
+ *
+ *  @param[in] queue_size  Number of events the queue can contain.
+ *  @param[in] policy      What to do when the queue is full.
+ *  @param[in] spill_file  File used to store events when the queue is
+ *                         full with the overflow_spill policy.
+ */
+void async_publisher::start(size_t queue_size,
+                            overflow_policy policy,
+                            std::string const& spill_file) {
+  if (_running)
+    return;
+  if (!queue_size)
+    queue_size = 1;
+
+  size_t size{1};
+  while (size < queue_size)
+    size <<= 1;
+  _ring.clear();
+  _ring.resize(size);
+  _mask = size - 1;
+  _capacity = queue_size;
+  _head = 0;
+  _tail = 0;
+  _policy = policy;
+  _spill_file = spill_file;
+  _producer = std::this_thread::get_id();
+
+  // Events spilled by a previous instance that could not be published
+  // are sent first.
+  if (_policy == overflow_spill) {
+    std::lock_guard<std::mutex> lock(_spill_m);
+    _file.reset(new persistent_file(_spill_file));
+    _spilling = true;
+  }
+
+  logging::info(logging::medium)
+      << "multiplexing: starting asynchronous publisher with a queue of "
+      << queue_size << " events ("
+      << (_policy == overflow_spill ? "spill" : "block") << " on overflow)";
+  _running = true;
+  _thread = std::thread(&async_publisher::_callback, this);
+}
+
+/**
+ *  Get statistics.
+ *
+ *  @param[out] tree  Output tree.
+ */
+void async_publisher::statistics(json11::Json::object& tree) const {
+  stats s{get_stats()};
+  tree["queued_events"] = static_cast<int>(s.queued);
+  tree["queue_size"] = static_cast<int>(s.capacity);
+  tree["published_events"] = static_cast<double>(s.published);
+  tree["failed_events"] = static_cast<double>(s.failed);
+  tree["spilled_events"] = static_cast<double>(s.spilled);
+  tree["blocked_writes"] = static_cast<double>(s.blocked);
+  tree["average_latency"] = s.average_latency;
+  tree["max_latency"] = s.max_latency;
+}
+
+/**
+ *  Publish all the pending events and stop the publishing thread. This
+ *  method must be called by the producer thread.
+ */
+void async_publisher::stop() {
+  if (!_running)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(_m);
+    _running = false;
+    _cv.notify_one();
+  }
+  _thread.join();
+
+  // Events written by other threads while stopping.
+  std::deque<entry> foreign;
+  {
+    std::lock_guard<std::mutex> lock(_m);
+    foreign.swap(_foreign);
+  }
+  for (entry& e : foreign)
+    engine::instance().publish(e.event);
+  _ring.clear();
+  logging::info(logging::medium)
+      << "multiplexing: asynchronous publisher stopped";
+}
+
+/**
+ *  Send an event to the multiplexing engine.
+ *
+ *  @param[in] d  Event to publish.
+ *
+ *  @return 1.
+ */
+int async_publisher::write(std::shared_ptr<io::data> const& d) {
+  if (!_running) {
+    engine::instance().publish(d);
+    return 1;
+  }
+
+  int64_t now{_now()};
+  if (std::this_thread::get_id() != _producer) {
+    std::lock_guard<std::mutex> lock(_m);
+    _foreign.push_back({d, now});
+    _cv.notify_one();
+    return 1;
+  }
+
+  // While events are spilled, the queue is not used so that events
+  // are published in order.
+  if (_spilling.load(std::memory_order_acquire) || !_push(d, now)) {
+    if (_policy == overflow_spill)
+      _spill(d);
+    else {
+      ++_blocked;
+      do {
+        _wake();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      } while (!_push(d, now));
+    }
+  }
+  _wake();
+  return 1;
+}
+
+/**************************************
+ *                                     *
+ *           Private Methods           *
+ *                                     *
+ **************************************/
+
+/**
+ *  Get a monotonic date in nanoseconds.
+ *
+ *  @return Current date.
+ */
+int64_t async_publisher::_now() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ *  Publishing thread.
+ */
+void async_publisher::_callback() {
+  std::list<std::shared_ptr<io::data>> batch;
+  for (;;) {
+    if (!_consume(batch) && _spilling.load(std::memory_order_acquire))
+      _read_spill(batch);
+
+    if (!batch.empty()) {
+      _publish(batch);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(_m);
+    if (!_running)
+      break;
+    _sleeping = true;
+    if (_head.load() == _tail.load() && _foreign.empty() && !_spilling)
+      _cv.wait_for(lock, std::chrono::milliseconds(200));
+    _sleeping = false;
+  }
+}
+
+/**
+ *  Move available events from the queues to a batch.
+ *
+ *  @param[out] batch  Batch to fill.
+ *
+ *  @return Number of events taken from the lock-free queue.
+ */
+size_t async_publisher::_consume(std::list<std::shared_ptr<io::data>>& batch) {
+  int64_t now{_now()};
+  int64_t sum{0};
+  int64_t max{_latency_max.load(std::memory_order_relaxed)};
+
+  size_t tail{_tail.load(std::memory_order_relaxed)};
+  size_t available{_head.load(std::memory_order_acquire) - tail};
+  if (available > batch_size)
+    available = batch_size;
+  for (size_t i{0}; i < available; ++i) {
+    entry& e{_ring[(tail + i) & _mask]};
+    int64_t latency{now - e.enqueued};
+    sum += latency;
+    if (latency > max)
+      max = latency;
+    batch.emplace_back(std::move(e.event));
+  }
+  _tail.store(tail + available, std::memory_order_release);
+
+  size_t count{available};
+  {
+    std::lock_guard<std::mutex> lock(_m);
+    while (!_foreign.empty() && count < batch_size) {
+      entry& e{_foreign.front()};
+      int64_t latency{now - e.enqueued};
+      sum += latency;
+      if (latency > max)
+        max = latency;
+      batch.emplace_back(std::move(e.event));
+      _foreign.pop_front();
+      ++count;
+    }
+  }
+
+  if (count) {
+    _latency_sum.fetch_add(sum, std::memory_order_relaxed);
+    _latency_count.fetch_add(count, std::memory_order_relaxed);
+    _latency_max.store(max, std::memory_order_relaxed);
+  }
+  return available;
+}
+
+/**
+ *  Publish a batch of events and clear it. Events of a batch that could
+ *  not be published are counted as failed.
+ *
+ *  @param[in,out] batch  Events to publish.
+ */
+void async_publisher::_publish(std::list<std::shared_ptr<io::data>>& batch) {
+  try {
+    engine::instance().publish(batch);
+    _published.fetch_add(batch.size(), std::memory_order_relaxed);
+  }
+  catch (std::exception const& e) {
+    _failed.fetch_add(batch.size(), std::memory_order_relaxed);
+    logging::error(logging::high)
+        << "multiplexing: asynchronous publisher could not publish "
+        << batch.size() << " events: " << e.what();
+  }
+  catch (...) {
+    _failed.fetch_add(batch.size(), std::memory_order_relaxed);
+    logging::error(logging::high)
+        << "multiplexing: asynchronous publisher could not publish "
+        << batch.size() << " events: unknown error";
+  }
+  batch.clear();
+}
+
+/**
+ *  Push an event in the lock-free queue. Only called by the producer.
+ *
+ *  @param[in] d    Event.
+ *  @param[in] now  Date of the write.
+ *
+ *  @return false if the queue is full.
+ */
+bool async_publisher::_push(std::shared_ptr<io::data> const& d, int64_t now) {
+  size_t head{_head.load(std::memory_order_relaxed)};
+  if (head - _tail.load(std::memory_order_acquire) >= _capacity)
+    return false;
+  entry& e{_ring[head & _mask]};
+  e.event = d;
+  e.enqueued = now;
+  _head.store(head + 1);
+  return true;
+}
+
+/**
+ *  Read spilled events back. Once the spill file is entirely read, the
+ *  producer uses the lock-free queue again.
+ *
+ *  @param[out] batch  Batch to fill.
+ *
+ *  @return Number of events read.
+ */
+size_t async_publisher::_read_spill(
+    std::list<std::shared_ptr<io::data>>& batch) {
+  std::lock_guard<std::mutex> lock(_spill_m);
+  size_t count{0};
+  try {
+    while (_file && count < batch_size) {
+      std::shared_ptr<io::data> d;
+      _file->read(d, 0);
+      if (d) {
+        batch.emplace_back(std::move(d));
+        ++count;
+      }
+    }
+  }
+  catch (shutdown const& e) {
+    // The spill file was entirely read.
+    (void)e;
+    _file.reset();
+  }
+  catch (std::exception const& e) {
+    logging::error(logging::high)
+        << "multiplexing: asynchronous publisher could not read spill file '"
+        << _spill_file << "': " << e.what();
+    _file.reset();
+  }
+  if (!_file)
+    _spilling.store(false, std::memory_order_release);
+  return count;
+}
+
+/**
+ *  Write an event to the spill file.
+ *
+ *  @param[in] d  Event to spill.
+ */
+void async_publisher::_spill(std::shared_ptr<io::data> const& d) {
+  std::lock_guard<std::mutex> lock(_spill_m);
+  if (!_file)
+    _file.reset(new persistent_file(_spill_file));
+  _file->write(d);
+  _spilling.store(true, std::memory_order_release);
+  ++_spilled;
+}
+
+/**
+ *  Wake up the publishing thread if it is waiting for events.
+ */
+void async_publisher::_wake() {
+  if (_sleeping) {
+    std::lock_guard<std::mutex> lock(_m);
+    _cv.notify_one();
+  }
+}
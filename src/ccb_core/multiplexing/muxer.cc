@@ -231,6 +231,17 @@ bool muxer::read(std::shared_ptr<io::data>& event, time_t deadline) {
   return !timed_out;
 }
 
+/**
+ *  Set the function to call when events become available to read().
+ *
+ *  @param[in] notifier  The function, empty to remove it. It is called
+ *                       with the muxer locked.
+ */
+void muxer::set_notifier(std::function<void()> const& notifier) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _notifier = notifier;
+}
+
 /**
  *  Set the read filters.
  *
@@ -307,6 +318,8 @@ void muxer::nack_events() {
       _name);
   std::lock_guard<std::mutex> lock(_mutex);
   _pos = _events.begin();
+  if (_pos != _events.end() && _notifier)
+    _notifier();
 }
 
 /**
@@ -453,6 +466,8 @@ void muxer::_push_to_queue(std::shared_ptr<io::data> const& event) {
   if (pos_has_no_more_to_read) {
     _pos = --_events.end();
     _cv.notify_one();
+    if (_notifier)
+      _notifier();
   }
 }
 
@@ -0,0 +1,355 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/processing/executor.hh"
+#include <algorithm>
+#include <cassert>
+#include "com/centreon/broker/logging/logging.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::processing;
+
+executor* executor::_instance(nullptr);
+
+namespace {
+// Executor and queue of the current thread, if it is a worker.
+thread_local executor const* current_executor(nullptr);
+thread_local uint32_t current_index(0);
+// Task running on the current thread.
+thread_local executor::task const* current_task(nullptr);
+
+// Order timers by deadline, the first one on top of the heap.
+template <typename T>
+bool later(T const& left, T const& right) {
+  return left.first > right.first;
+}
+}  // namespace
+
+/**************************************
+ *                                     *
+ *           Public Methods            *
+ *                                     *
+ **************************************/
+
+/**
+ *  Task constructor.
+ *
+ *  @param[in] owner  The executor running the task.
+ *  @param[in] run    Function running a slice of work.
+ */
+executor::task::task(executor& owner, std::function<int()> const& run)
+    : _owner(owner), _run(run), _state(idle), _removed(false) {}
+
+/**
+ *  Run the task as soon as possible. It is run again if it is already
+ *  running.
+ */
+void executor::task::notify() {
+  int s(_state.load());
+  for (;;) {
+    if (s == idle) {
+      if (_state.compare_exchange_weak(s, queued)) {
+        _owner._push(shared_from_this());
+        return;
+      }
+    } else if (s == running) {
+      if (_state.compare_exchange_weak(s, running_notified))
+        return;
+    } else
+      return;
+  }
+}
+
+/**
+ *  Get the executor.
+ *
+ *  @return The executor.
+ */
+executor& executor::instance() {
+  assert(_instance);
+  return *_instance;
+}
+
+/**
+ *  Start the executor threads.
+ *
+ *  @param[in] threads_count  Number of threads, 0 for twice the number
+ *                            of cores with at least 4 threads, as
+ *                            slices may wait on their streams.
+ */
+void executor::load(uint32_t threads_count) {
+  if (!_instance) {
+    if (!threads_count)
+      threads_count = std::max(2 * std::thread::hardware_concurrency(), 4u);
+    _instance = new executor(threads_count);
+  }
+}
+
+/**
+ *  Stop the executor threads. Tasks should have been removed.
+ */
+void executor::unload() {
+  delete _instance;
+  _instance = nullptr;
+}
+
+/**
+ *  Add a task. It is not run until it is notified.
+ *
+ *  @param[in] run  Function running a slice of work of the task.
+ *
+ *  @return The task.
+ */
+std::shared_ptr<executor::task> executor::add(
+    std::function<int()> const& run) {
+  return std::make_shared<task>(*this, run);
+}
+
+/**
+ *  Get the number of threads of the executor.
+ *
+ *  @return The number of threads.
+ */
+uint32_t executor::get_threads_count() const noexcept {
+  return _threads.size();
+}
+
+/**
+ *  Remove a task. When this method returns, the task is not running
+ *  and will not run anymore, except if it is removed by itself: it then
+ *  stops at the end of its current slice.
+ *
+ *  @param[in] t  The task.
+ */
+void executor::remove(std::shared_ptr<task> const& t) {
+  t->_removed = true;
+  if (current_task == t.get())
+    return;
+
+  std::unique_lock<std::mutex> lock(_m);
+  _removed_cv.wait(lock, [&t] {
+    int s(t->_state.load());
+    while (s == task::idle || s == task::queued)
+      t->_state.compare_exchange_weak(s, task::finished);
+    return s == task::finished;
+  });
+}
+
+/**************************************
+ *                                     *
+ *           Private Methods           *
+ *                                     *
+ **************************************/
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] threads_count  Number of threads.
+ */
+executor::executor(uint32_t threads_count)
+    : _next_queue(0), _queued(0), _sleepers(0), _exit(false) {
+  for (uint32_t i(0); i < threads_count; ++i)
+    _queues.emplace_back(new worker_queue);
+  for (uint32_t i(0); i < threads_count; ++i)
+    _threads.emplace_back(&executor::_work, this, i);
+  logging::info(logging::medium) << "executor: " << threads_count
+                                 << " threads started";
+}
+
+/**
+ *  Destructor.
+ */
+executor::~executor() {
+  {
+    std::lock_guard<std::mutex> lock(_m);
+    _exit = true;
+    _cv.notify_all();
+  }
+  for (std::thread& t : _threads)
+    t.join();
+}
+
+/**
+ *  Run a task again after a delay. Only the earliest timer of a task is
+ *  kept, an extra run is harmless.
+ *
+ *  @param[in] t      The task.
+ *  @param[in] delay  Delay in milliseconds.
+ */
+void executor::_add_timer(std::shared_ptr<task> const& t, int delay) {
+  time_point deadline(std::chrono::steady_clock::now() +
+                      std::chrono::milliseconds(delay));
+  std::lock_guard<std::mutex> lock(_m);
+  if (t->_timer != time_point() && t->_timer <= deadline)
+    return;
+  t->_timer = deadline;
+  _timers.emplace_back(deadline, t);
+  std::push_heap(_timers.begin(), _timers.end(),
+                 later<std::pair<time_point, std::shared_ptr<task>>>);
+
+  // Sleeping threads must wait for this new first timer.
+  if (_timers.front().second == t && _sleepers)
+    _cv.notify_one();
+}
+
+/**
+ *  Get a ready task, from the queue of the thread or else from another
+ *  queue.
+ *
+ *  @param[in] index  Index of the thread.
+ *
+ *  @return A task, null if none is ready.
+ */
+std::shared_ptr<executor::task> executor::_pop(uint32_t index) {
+  std::shared_ptr<task> retval;
+  for (uint32_t i(0); i < _queues.size() && !retval; ++i) {
+    worker_queue& q(*_queues[(index + i) % _queues.size()]);
+    std::lock_guard<std::mutex> lock(q.m);
+    if (!q.tasks.empty()) {
+      // Own tasks are run in order, stolen ones from the end.
+      if (!i) {
+        retval = std::move(q.tasks.front());
+        q.tasks.pop_front();
+      } else {
+        retval = std::move(q.tasks.back());
+        q.tasks.pop_back();
+      }
+      --_queued;
+    }
+  }
+  return retval;
+}
+
+/**
+ *  Queue a ready task. Workers queue tasks on their own queue.
+ *
+ *  @param[in] t  The task.
+ */
+void executor::_push(std::shared_ptr<task> const& t) {
+  uint32_t index(current_executor == this
+                     ? current_index
+                     : _next_queue++ % _queues.size());
+  {
+    worker_queue& q(*_queues[index]);
+    std::lock_guard<std::mutex> lock(q.m);
+    q.tasks.push_back(t);
+  }
+  ++_queued;
+  if (_sleepers) {
+    std::lock_guard<std::mutex> lock(_m);
+    _cv.notify_one();
+  }
+}
+
+/**
+ *  Run a slice of a task and schedule its next run.
+ *
+ *  @param[in] t  The task.
+ */
+void executor::_run(std::shared_ptr<task> const& t) {
+  // Removed tasks are finished, they are not run.
+  int s(task::queued);
+  if (!t->_state.compare_exchange_strong(s, task::running))
+    return;
+
+  int delay;
+  current_task = t.get();
+  try {
+    delay = t->_run();
+  }
+  catch (std::exception const& e) {
+    logging::error(logging::high) << "executor: task stopped on error: "
+                                  << e.what();
+    delay = -1;
+  }
+  catch (...) {
+    logging::error(logging::high) << "executor: task stopped on unknown error";
+    delay = -1;
+  }
+  current_task = nullptr;
+
+  if (delay < 0 || t->_removed)
+    t->_state = task::finished;
+  else if (delay == 0) {
+    t->_state = task::queued;
+    _push(t);
+  } else {
+    s = task::running;
+    if (t->_state.compare_exchange_strong(s, task::idle))
+      _add_timer(t, delay);
+    else {
+      // Notified while running.
+      t->_state = task::queued;
+      _push(t);
+    }
+  }
+
+  // A removal may wait for the end of this slice.
+  if (t->_removed) {
+    std::lock_guard<std::mutex> lock(_m);
+    _removed_cv.notify_all();
+  }
+}
+
+/**
+ *  Thread routine: run ready tasks, fire timers and sleep.
+ *
+ *  @param[in] index  Index of the thread.
+ */
+void executor::_work(uint32_t index) {
+  current_executor = this;
+  current_index = index;
+  std::vector<std::shared_ptr<task>> expired;
+  while (!_exit) {
+    std::shared_ptr<task> t(_pop(index));
+    if (t) {
+      _run(t);
+      continue;
+    }
+
+    // Fire expired timers.
+    std::unique_lock<std::mutex> lock(_m);
+    time_point now(std::chrono::steady_clock::now());
+    while (!_timers.empty() && _timers.front().first <= now) {
+      std::pop_heap(_timers.begin(), _timers.end(),
+                    later<std::pair<time_point, std::shared_ptr<task>>>);
+      std::pair<time_point, std::shared_ptr<task>>& timer(_timers.back());
+      if (timer.second->_timer == timer.first)
+        timer.second->_timer = time_point();
+      expired.push_back(std::move(timer.second));
+      _timers.pop_back();
+    }
+    if (!expired.empty()) {
+      lock.unlock();
+      for (std::shared_ptr<task> const& e : expired)
+        e->notify();
+      expired.clear();
+      continue;
+    }
+
+    // Sleep until a task is queued or the first timer.
+    ++_sleepers;
+    if (!_queued && !_exit) {
+      if (_timers.empty())
+        _cv.wait(lock);
+      else
+        _cv.wait_until(lock, _timers.front().first);
+    }
+    --_sleepers;
+  }
+}
@@ -17,7 +17,6 @@
 */
 
 #include "com/centreon/broker/processing/failover.hh"
-#include <unistd.h>
 #include "com/centreon/exceptions/shutdown.hh"
 #include "com/centreon/broker/logging/logging.hh"
 #include "com/centreon/broker/multiplexing/muxer.hh"
@@ -27,6 +26,14 @@ using namespace com::centreon::exceptions;
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::processing;
 
+// Events processed by a slice before other tasks can run.
+static uint32_t const events_per_run = 1000;
+// Milliseconds before checking a stream that tells when it has data,
+// and before polling a stream that does not. Streams are flushed at
+// most every second when idle.
+static int const idle_delay = 1000;
+static int const poll_delay = 100;
+
 /**************************************
  *                                     *
  *           Public Methods            *
@@ -51,7 +58,14 @@ failover::failover(std::shared_ptr<io::endpoint> endp,
       _next_timeout(0),
       _retry_interval(30),
       _subscriber(sbscrbr),
-      _update(false) {}
+      _update(false),
+      _step(opening),
+      _step_end(0),
+      _stream_can_read(true),
+      _muxer_can_read(true),
+      _should_commit(false),
+      _stream_notifies(false),
+      _fill_stats_time(0) {}
 
 /**
  *  Destructor.
@@ -68,11 +82,22 @@ void failover::add_secondary_endpoint(std::shared_ptr<io::endpoint> endp) {
 }
 
 /**
- *  Exit failover thread.
+ *  Exit failover thread. When this method returns, the failover task is
+ *  not running anymore.
  */
 void failover::exit() {
-  bthread::exit();
-  _subscriber->get_muxer().wake();
+  std::shared_ptr<executor::task> t;
+  {
+    std::lock_guard<std::mutex> lock(_task_m);
+    t.swap(_task);
+  }
+  if (t) {
+    executor::instance().remove(t);
+    if (_job_thread.joinable())
+      _job_thread.join();
+    _job = std::future<void>();
+    _stop();
+  }
 }
 
 /**
@@ -99,290 +124,13 @@ bool failover::get_initialized() const throw() { return _initialized; }
 time_t failover::get_retry_interval() const throw() { return _retry_interval; }
 
 /**
- *  Thread core function.
+ *  Check whether the failover is started.
+ *
+ *  @return True if the failover task exists.
  */
-void failover::run() {
-  // Initial log.
-  logging::debug(logging::high) << "failover: thread of endpoint '" << _name
-                                << "' is starting";
-
-  // Check endpoint.
-  if (!_endpoint) {
-    logging::error(logging::high)
-        << "failover: thread of endpoint '" << _name << "' has no endpoint"
-        << " object, this is likely a software bug that should be reported"
-        << " to Centreon Broker developers";
-    return;
-  }
-
-  // Thread should be aware of external exit requests.
-  do {
-    // This try/catch block handles any error of the current thread
-    // objects. In case of an exception, it is responsible to launch
-    // failovers of this failover.
-    try {
-      // Attempt to open endpoint.
-      _update_status("opening endpoint");
-      set_last_connection_attempt(timestamp::now());
-      {
-        std::shared_ptr<io::stream> s(_endpoint->open());
-        {
-          std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
-          _stream = s;
-          set_state(s ? "connected" : "connecting");
-        }
-        _initialized = true;
-        set_last_connection_success(timestamp::now());
-      }
-      _update_status("");
-      _update = true;
-
-      // Buffering.
-      if (_buffering_timeout > 0) {
-        // Status.
-        logging::debug(logging::medium)
-            << "failover: buffering data for endpoint '" << _name << "' ("
-            << _buffering_timeout << "s)";
-        _update_status("buffering data");
-
-        // Wait loop.
-        // FIXME SGA: condvar should be more elegant...
-        for (ssize_t i = 0; !should_exit() && i < (_buffering_timeout * 10);
-             i++) {
-          std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
-
-        _update_status("");
-      }
-
-      // Open secondaries.
-      _update_status("initializing secondaries");
-      std::vector<std::shared_ptr<io::stream> > secondaries;
-      for (std::vector<std::shared_ptr<io::endpoint> >::iterator
-               it(_secondary_endpoints.begin()),
-           end(_secondary_endpoints.end());
-           it != end;
-           ++it)
-        try {
-          std::shared_ptr<io::stream> s((*it)->open());
-          if (s)
-            secondaries.push_back(s);
-          else
-            logging::error(logging::medium)
-                << "failover: could not open a secondary of endpoint '" << _name
-                << ": secondary returned a null stream";
-        }
-      catch (std::exception const& e) {
-        logging::error(logging::medium)
-            << "failover: error occured while opening a secondary "
-            << "of endpoint '" << _name << "': " << e.what();
-      }
-      _update_status("");
-
-      // Shutdown failover.
-      if (_failover_launched) {
-        logging::debug(logging::medium)
-            << "failover: shutting down failover of endpoint '" << _name << "'";
-        _update_status("shutting down failover");
-        _failover->exit();
-        _failover_launched = false;
-        _update_status("");
-      }
-
-      // Event processing loop.
-      logging::debug(logging::medium)
-          << "failover: launching event loop of endpoint '" << _name << "'";
-      _subscriber->get_muxer().nack_events();
-      bool stream_can_read(true);
-      bool muxer_can_read(true);
-      bool should_commit(false);
-      std::shared_ptr<io::data> d;
-
-      time_t fill_stats_time = time(nullptr);
-
-      while (!should_exit()) {
-        // Check for update.
-        if (_update) {
-          std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
-          _stream->update();
-          _update = false;
-        }
-
-        // Filling stats
-        if (time(nullptr) >= fill_stats_time) {
-          fill_stats_time += 5;
-          set_queued_events(_subscriber->get_muxer().get_event_queue_size());
-        }
-
-        // Read from endpoint stream.
-        d.reset();
-        bool timed_out_stream(true);
-        if (stream_can_read) {
-          logging::debug(logging::low)
-              << "failover: reading event from endpoint '" << _name << "'";
-          _update_status("reading event from stream");
-          try {
-            std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
-            timed_out_stream = !_stream->read(d, 0);
-          }
-          catch (shutdown const& e) {
-            logging::debug(logging::medium)
-                << "failover: stream of endpoint '" << _name
-                << "' shutdown while reading: " << e.what();
-            stream_can_read = false;
-          }
-          if (d) {
-            logging::debug(logging::low)
-                << "failover: writing event of endpoint '" << _name
-                << "' to multiplexing engine";
-            _update_status("writing event to multiplexing engine");
-            _subscriber->get_muxer().write(d);
-            tick();
-            _update_status("");
-            continue;  // Stream read bias.
-          }
-          _update_status("");
-        }
-
-        // Read from muxer stream.
-        d.reset();
-        bool timed_out_muxer(true);
-        if (muxer_can_read) {
-          logging::debug(logging::low) << "failover: reading event from "
-                                          "multiplexing engine for endpoint '"
-                                       << _name << "'";
-          _update_status("reading event from multiplexing engine");
-          try {
-            timed_out_muxer = !_subscriber->get_muxer().read(d, 0);
-            should_commit = should_commit || d;
-          }
-          catch (shutdown const& e) {
-            logging::debug(logging::medium)
-                << "failover: muxer of endpoint '" << _name
-                << "' shutdown while reading: " << e.what();
-            muxer_can_read = false;
-          }
-          if (d) {
-            logging::debug(logging::low) << "failover: writing event of "
-                                            "multiplexing engine to endpoint '"
-                                         << _name << "'";
-            _update_status("writing event to stream");
-            int we(0);
-
-            try {
-              std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
-              we = _stream->write(d);
-            }
-            catch (shutdown const& e) {
-              logging::debug(logging::medium)
-                  << "failover: stream of endpoint '" << _name
-                  << "' shutdown while writing: " << e.what();
-              muxer_can_read = false;
-            }
-            _subscriber->get_muxer().ack_events(we);
-            tick();
-            for (std::vector<std::shared_ptr<io::stream> >::iterator
-                     it(secondaries.begin()),
-                 end(secondaries.end());
-                 it != end;) {
-              try {
-                (*it)->write(d);
-                ++it;
-              }
-              catch (std::exception const& e) {
-                logging::error(logging::medium)
-                    << "failover: error "
-                    << "occurred while writing to a secondary of endpoint '"
-                    << _name << "' (secondary will be removed): " << e.what();
-                it = secondaries.erase(it);
-              }
-            }
-            _update_status("");
-          }
-        }
-
-        // If both timed out, sleep a while.
-        d.reset();
-        if (timed_out_stream && timed_out_muxer) {
-          time_t now(time(nullptr));
-          int we(0);
-          if (should_commit) {
-            should_commit = false;
-            _next_timeout = now + 1;
-            std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
-            we = _stream->flush();
-          } else if (now >= _next_timeout) {
-            _next_timeout = now + 1;
-            std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
-            we = _stream->flush();
-          }
-          _subscriber->get_muxer().ack_events(we);
-          ::usleep(100000);
-        }
-      }
-    }
-    // Some real error occured.
-    catch (std::exception const& e) {
-      logging::error(logging::high) << e.what();
-      {
-        std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
-        _stream.reset();
-        set_state("connecting");
-      }
-      _launch_failover();
-      _initialized = true;
-    }
-    catch (...) {
-      logging::error(logging::high)
-          << "failover: endpoint '" << _name
-          << "' encountered an unknown exception, this is likely a "
-          << "software bug that should be reported to Centreon Broker "
-             "developers";
-      {
-        std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
-        _stream.reset();
-        set_state("connecting");
-      }
-      _launch_failover();
-      _initialized = true;
-    }
-
-    // Clear stream.
-    {
-      std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
-      _stream.reset();
-      set_state("connecting");
-    }
-
-    // Sleep a while before attempting a reconnection.
-    _update_status("sleeping before reconnection");
-
-    for (ssize_t i = 0; !should_exit() && i < (_retry_interval * 10); i++) {
-      std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
-
-    _update_status("");
-
-  } while (!should_exit());
-
-  // Clear stream.
-  {
-    std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
-    _stream.reset();
-    set_state("connecting");
-  }
-
-  // Exit failover thread if necessary.
-  if (_failover) {
-    logging::info(logging::medium)
-        << "failover: requesting termination of failover of endpoint '" << _name
-        << "'";
-    _failover->exit();
-  }
-
-  // Exit log.
-  logging::debug(logging::high) << "failover: thread of endpoint '" << _name
-                                << "' is exiting";
+bool failover::is_running() const {
+  std::lock_guard<std::mutex> lock(_task_m);
+  return static_cast<bool>(_task);
 }
 
 /**
@@ -409,10 +157,43 @@ void failover::set_retry_interval(time_t retry_interval) {
   _retry_interval = retry_interval;
 }
 
+/**
+ *  Start the failover. It runs on the executor.
+ */
+void failover::start() {
+  std::lock_guard<std::mutex> lock(_task_m);
+  if (_task)
+    return;
+
+  // Initial log.
+  logging::debug(logging::high) << "failover: thread of endpoint '" << _name
+                                << "' is starting";
+
+  // Check endpoint.
+  if (!_endpoint) {
+    logging::error(logging::high)
+        << "failover: thread of endpoint '" << _name << "' has no endpoint"
+        << " object, this is likely a software bug that should be reported"
+        << " to Centreon Broker developers";
+    return;
+  }
+
+  _step = opening;
+  _task = executor::instance().add(std::bind(&failover::_run, this));
+  std::shared_ptr<executor::task> t(_task);
+  _subscriber->get_muxer().set_notifier([t]() { t->notify(); });
+  _task->notify();
+}
+
 /**
  *  Configuration update request.
  */
-void failover::update() { _update = true; }
+void failover::update() {
+  _update = true;
+  std::lock_guard<std::mutex> lock(_task_m);
+  if (_task)
+    _task->notify();
+}
 
 /**
  *  Wait for this thread to terminate along with other failovers.
@@ -502,6 +283,334 @@ void failover::_launch_failover() {
   }
 }
 
+/**
+ *  Open the endpoint.
+ */
+void failover::_open() {
+  // Attempt to open endpoint.
+  _update_status("opening endpoint");
+  set_last_connection_attempt(timestamp::now());
+  {
+    std::shared_ptr<io::stream> s(_endpoint->open());
+    {
+      std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
+      _stream = s;
+      set_state(s ? "connected" : "connecting");
+    }
+    _initialized = true;
+    set_last_connection_success(timestamp::now());
+  }
+  _update_status("");
+  _update = true;
+}
+
+/**
+ *  Open the secondaries and shut down the failover of this endpoint.
+ */
+void failover::_open_secondaries() {
+  // Open secondaries.
+  _update_status("initializing secondaries");
+  _secondaries.clear();
+  for (std::vector<std::shared_ptr<io::endpoint> >::iterator
+           it(_secondary_endpoints.begin()),
+       end(_secondary_endpoints.end());
+       it != end;
+       ++it)
+    try {
+      std::shared_ptr<io::stream> s((*it)->open());
+      if (s)
+        _secondaries.push_back(s);
+      else
+        logging::error(logging::medium)
+            << "failover: could not open a secondary of endpoint '" << _name
+            << ": secondary returned a null stream";
+    }
+  catch (std::exception const& e) {
+    logging::error(logging::medium)
+        << "failover: error occured while opening a secondary "
+        << "of endpoint '" << _name << "': " << e.what();
+  }
+  _update_status("");
+
+  // Shutdown failover.
+  if (_failover_launched) {
+    logging::debug(logging::medium)
+        << "failover: shutting down failover of endpoint '" << _name << "'";
+    _update_status("shutting down failover");
+    _failover->exit();
+    _failover_launched = false;
+    _update_status("");
+  }
+}
+
+/**
+ *  Process events between the stream and the muxer until both have no
+ *  more data.
+ *
+ *  @return Delay before the next run.
+ */
+int failover::_process() {
+  std::shared_ptr<io::data> d;
+  for (uint32_t i(0); i < events_per_run; ++i) {
+    // Check for update.
+    if (_update) {
+      std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
+      _stream->update();
+      _update = false;
+    }
+
+    // Filling stats
+    if (time(nullptr) >= _fill_stats_time) {
+      _fill_stats_time += 5;
+      set_queued_events(_subscriber->get_muxer().get_event_queue_size());
+    }
+
+    // Read from endpoint stream.
+    d.reset();
+    bool timed_out_stream(true);
+    if (_stream_can_read) {
+      logging::debug(logging::low)
+          << "failover: reading event from endpoint '" << _name << "'";
+      _update_status("reading event from stream");
+      try {
+        std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
+        timed_out_stream = !_stream->read(d, 0);
+      }
+      catch (shutdown const& e) {
+        logging::debug(logging::medium)
+            << "failover: stream of endpoint '" << _name
+            << "' shutdown while reading: " << e.what();
+        _stream_can_read = false;
+      }
+      if (d) {
+        logging::debug(logging::low)
+            << "failover: writing event of endpoint '" << _name
+            << "' to multiplexing engine";
+        _update_status("writing event to multiplexing engine");
+        _subscriber->get_muxer().write(d);
+        tick();
+        _update_status("");
+        continue;  // Stream read bias.
+      }
+      _update_status("");
+    }
+
+    // Read from muxer stream.
+    d.reset();
+    bool timed_out_muxer(true);
+    if (_muxer_can_read) {
+      logging::debug(logging::low) << "failover: reading event from "
+                                      "multiplexing engine for endpoint '"
+                                   << _name << "'";
+      _update_status("reading event from multiplexing engine");
+      try {
+        timed_out_muxer = !_subscriber->get_muxer().read(d, 0);
+        _should_commit = _should_commit || d;
+      }
+      catch (shutdown const& e) {
+        logging::debug(logging::medium)
+            << "failover: muxer of endpoint '" << _name
+            << "' shutdown while reading: " << e.what();
+        _muxer_can_read = false;
+      }
+      if (d) {
+        logging::debug(logging::low) << "failover: writing event of "
+                                        "multiplexing engine to endpoint '"
+                                     << _name << "'";
+        _update_status("writing event to stream");
+        int we(0);
+
+        try {
+          std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
+          we = _stream->write(d);
+        }
+        catch (shutdown const& e) {
+          logging::debug(logging::medium)
+              << "failover: stream of endpoint '" << _name
+              << "' shutdown while writing: " << e.what();
+          _muxer_can_read = false;
+        }
+        _subscriber->get_muxer().ack_events(we);
+        tick();
+        for (std::vector<std::shared_ptr<io::stream> >::iterator
+                 it(_secondaries.begin()),
+             end(_secondaries.end());
+             it != end;) {
+          try {
+            (*it)->write(d);
+            ++it;
+          }
+          catch (std::exception const& e) {
+            logging::error(logging::medium)
+                << "failover: error "
+                << "occurred while writing to a secondary of endpoint '"
+                << _name << "' (secondary will be removed): " << e.what();
+            it = _secondaries.erase(it);
+            end = _secondaries.end();
+          }
+        }
+        _update_status("");
+      }
+    }
+
+    // If both timed out, flush and wait for new data.
+    d.reset();
+    if (timed_out_stream && timed_out_muxer) {
+      time_t now(time(nullptr));
+      int we(0);
+      if (_should_commit) {
+        _should_commit = false;
+        _next_timeout = now + 1;
+        std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
+        we = _stream->flush();
+      } else if (now >= _next_timeout) {
+        _next_timeout = now + 1;
+        std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
+        we = _stream->flush();
+      }
+      _subscriber->get_muxer().ack_events(we);
+      return _stream_notifies ? idle_delay : poll_delay;
+    }
+  }
+  return 0;
+}
+
+/**
+ *  Run a slice of the failover, depending on its current step. Errors
+ *  launch the failover of this endpoint and a reconnection is attempted
+ *  after the retry interval.
+ *
+ *  @return Delay before the next run.
+ */
+int failover::_run() noexcept {
+  // This try/catch block handles any error of the current task
+  // objects. In case of an exception, it is responsible to launch
+  // failovers of this failover.
+  try {
+    time_t now(time(nullptr));
+    switch (_step) {
+      case opening:
+        if (!_wait_job(std::bind(&failover::_open, this)))
+          return idle_delay;
+        if (_buffering_timeout > 0) {
+          logging::debug(logging::medium)
+              << "failover: buffering data for endpoint '" << _name << "' ("
+              << _buffering_timeout << "s)";
+          _update_status("buffering data");
+          _step = buffering;
+          _step_end = time(nullptr) + _buffering_timeout;
+          return _buffering_timeout * 1000;
+        }
+        _step = starting;
+        return 0;
+      case buffering:
+        if (now < _step_end)
+          return (_step_end - now) * 1000;
+        _update_status("");
+        _step = starting;
+        return 0;
+      case starting:
+        if (!_wait_job(std::bind(&failover::_open_secondaries, this)))
+          return idle_delay;
+        _start_processing();
+        return 0;
+      case running:
+        return _process();
+      case waiting:
+        if (now < _step_end)
+          return (_step_end - now) * 1000;
+        _update_status("");
+        _step = opening;
+        return 0;
+    }
+  }
+  // Some real error occured.
+  catch (std::exception const& e) {
+    logging::error(logging::high) << e.what();
+  }
+  catch (...) {
+    logging::error(logging::high)
+        << "failover: endpoint '" << _name
+        << "' encountered an unknown exception, this is likely a "
+        << "software bug that should be reported to Centreon Broker "
+           "developers";
+  }
+
+  // Clear stream.
+  {
+    std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
+    if (_stream)
+      _stream->set_read_notifier(nullptr);
+    _stream.reset();
+    set_state("connecting");
+  }
+  _secondaries.clear();
+  _launch_failover();
+  _initialized = true;
+
+  // Wait a while before attempting a reconnection.
+  _update_status("sleeping before reconnection");
+  _step = waiting;
+  _step_end = time(nullptr) + _retry_interval;
+  return _retry_interval * 1000;
+}
+
+/**
+ *  Start processing events, once the secondaries are opened.
+ */
+void failover::_start_processing() {
+  // Event processing.
+  logging::debug(logging::medium)
+      << "failover: launching event loop of endpoint '" << _name << "'";
+  _subscriber->get_muxer().nack_events();
+  _stream_can_read = true;
+  _muxer_can_read = true;
+  _should_commit = false;
+  _fill_stats_time = time(nullptr);
+  _step = running;
+
+  // The stream tells when it has data.
+  std::shared_ptr<executor::task> t;
+  {
+    std::lock_guard<std::mutex> lock(_task_m);
+    t = _task;
+  }
+  std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
+  _stream_notifies = t && _stream &&
+                     _stream->set_read_notifier([t]() { t->notify(); });
+}
+
+/**
+ *  Release the streams and exit the failover of this endpoint once the
+ *  task is removed.
+ */
+void failover::_stop() {
+  _subscriber->get_muxer().set_notifier(nullptr);
+
+  // Clear stream.
+  {
+    std::lock_guard<std::timed_mutex> stream_lock(_stream_m);
+    if (_stream)
+      _stream->set_read_notifier(nullptr);
+    _stream.reset();
+    set_state("connecting");
+  }
+  _secondaries.clear();
+
+  // Exit failover thread if necessary.
+  if (_failover) {
+    logging::info(logging::medium)
+        << "failover: requesting termination of failover of endpoint '" << _name
+        << "'";
+    _failover->exit();
+    _failover_launched = false;
+  }
+
+  // Exit log.
+  logging::debug(logging::high) << "failover: thread of endpoint '" << _name
+                                << "' is exiting";
+}
+
 /**
  *  Update status message.
  *
@@ -511,3 +620,43 @@ void failover::_update_status(std::string const& status) {
   std::lock_guard<std::mutex> lock(_status_m);
   _status = status;
 }
+
+/**
+ *  Run a job that may block on I/O on its own thread, the executor
+ *  threads must not wait for it. The task is notified when the job is
+ *  done. A slice calls this method until it returns true.
+ *
+ *  @param[in] job  The job, only used to start it.
+ *
+ *  @return True once the job is done, its error is then rethrown.
+ */
+bool failover::_wait_job(std::function<void()> const& job) {
+  if (!_job_thread.joinable()) {
+    std::shared_ptr<executor::task> t;
+    {
+      std::lock_guard<std::mutex> lock(_task_m);
+      t = _task;
+    }
+    std::promise<void> done;
+    _job = done.get_future();
+    _job_thread = std::thread(
+        [job, t](std::promise<void> done) {
+          try {
+            job();
+            done.set_value();
+          }
+          catch (...) {
+            done.set_exception(std::current_exception());
+          }
+          if (t)
+            t->notify();
+        },
+        std::move(done));
+    return false;
+  }
+  if (_job.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    return false;
+  _job_thread.join();
+  _job.get();
+  return true;
+}
@@ -17,7 +17,6 @@
 */
 
 #include "com/centreon/broker/processing/feeder.hh"
-#include <unistd.h>
 #include <cassert>
 #include "com/centreon/exceptions/msg_fmt.hh"
 #include "com/centreon/exceptions/shutdown.hh"
@@ -30,6 +29,13 @@ using namespace com::centreon::exceptions;
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::processing;
 
+// Events processed by a slice before other tasks can run.
+static uint32_t const events_per_run = 1000;
+// Milliseconds before checking a stream that tells when it has data,
+// and before polling a stream that does not.
+static int const idle_delay = 1000;
+static int const poll_delay = 100;
+
 /**************************************
  *                                     *
  *           Public Methods            *
@@ -49,9 +55,11 @@ feeder::feeder(std::string const& name,
                std::unordered_set<uint32_t> const& read_filters,
                std::unordered_set<uint32_t> const& write_filters)
     : stat_visitable(name),
-      _started{false},
-      _stopped{false},
-      _should_exit{false},
+      _finished{false},
+      _stream_can_read{true},
+      _muxer_can_read{true},
+      _stream_notifies{false},
+      _fill_stats_time{0},
       _client(client),
       _subscriber(name, false) {
   _subscriber.get_muxer().set_read_filters(read_filters);
@@ -67,21 +75,31 @@ feeder::feeder(std::string const& name,
  */
 feeder::~feeder() { exit(); }
 
+/**
+ *  Stop the feeder. When this method returns, the feeder task is not
+ *  running anymore.
+ */
 void feeder::exit() {
-  std::unique_lock<std::mutex> lock(_stopped_m);
-  if (_started) {
-    if (!_should_exit) {
-      _should_exit = true;
-      _stopped_cv.wait(lock, [this] { return _stopped; });
-      _thread.join();
-      _started = false;
-    }
+  std::shared_ptr<executor::task> t;
+  {
+    std::lock_guard<std::mutex> lock(_task_m);
+    t = _task;
+  }
+  if (t) {
+    executor::instance().remove(t);
+    _stop();
   }
 }
 
+/**
+ *  Check whether the feeder is finished, that is stopped or
+ *  disconnected.
+ *
+ *  @return True if the feeder is finished.
+ */
 bool feeder::is_finished() const noexcept {
-  std::lock_guard<std::mutex> lock(_started_m);
-  return !_started && _should_exit;
+  std::lock_guard<std::mutex> lock(_task_m);
+  return _finished;
 }
 
 /**
@@ -116,50 +134,52 @@ void feeder::_forward_statistic(json11::Json::object& tree) {
   _subscriber.get_muxer().statistics(tree);
 }
 
+/**
+ *  Start feeding events. The feeder runs on the executor.
+ */
 void feeder::start() {
-  std::unique_lock<std::mutex> lock(_started_m);
-  _stopped = false;
+  std::lock_guard<std::mutex> lock(_task_m);
   if (!_client)
     throw msg_fmt("could not process '{}' with no client stream", _name);
-  if (!_started) {
-    _should_exit = false;
-    _thread = std::thread(&feeder::_callback, this);
-    _started_cv.wait(lock, [this] { return _started; });
+  if (!_task) {
+    logging::info(logging::medium) << "feeder: task of client '" << _name
+                                   << "' is starting";
+    _fill_stats_time = time(nullptr);
+    set_state("connected");
+    _task = executor::instance().add(std::bind(&feeder::_run, this));
+    std::shared_ptr<executor::task> t(_task);
+    _subscriber.get_muxer().set_notifier([t]() { t->notify(); });
+    _stream_notifies = _client->set_read_notifier([t]() { t->notify(); });
+    _task->notify();
   }
 }
 
-void feeder::_callback() noexcept {
+/**
+ *  Run a slice of the feeder: move events between the client and the
+ *  muxer until both have no more data.
+ *
+ *  @return Delay before the next run, negative once finished.
+ */
+int feeder::_run() noexcept {
   assert(_client);
-  logging::info(logging::medium) << "feeder: thread of client '" << _name
-                                 << "' is starting";
-  time_t fill_stats_time = time(nullptr);
-  std::unique_lock<std::mutex> lock(_started_m);
-
   try {
-    set_state("connected");
-    bool stream_can_read(true);
-    bool muxer_can_read(true);
+    // Filling stats
+    if (time(nullptr) >= _fill_stats_time) {
+      _fill_stats_time += 5;
+      set_queued_events(_subscriber.get_muxer().get_event_queue_size());
+    }
+
     std::shared_ptr<io::data> d;
-    _started = true;
-    _started_cv.notify_all();
-    lock.unlock();
-    while (!_should_exit) {
+    for (uint32_t i(0); i < events_per_run; ++i) {
       // Read from stream.
       bool timed_out_stream(true);
-
-      // Filling stats
-      if (time(nullptr) >= fill_stats_time) {
-        fill_stats_time += 5;
-        set_queued_events(_subscriber.get_muxer().get_event_queue_size());
-      }
-
-      if (stream_can_read) {
+      if (_stream_can_read) {
         try {
           misc::read_lock lock(_client_m);
           timed_out_stream = !_client->read(d, 0);
         }
         catch (shutdown const& e) {
-          stream_can_read = false;
+          _stream_can_read = false;
         }
         if (d) {
           {
@@ -167,19 +187,19 @@ void feeder::_callback() noexcept {
             _subscriber.get_muxer().write(d);
           }
           tick();
+          d.reset();
           continue;  // Stream read bias.
         }
       }
 
       // Read from muxer.
-      d.reset();
       bool timed_out_muxer(true);
-      if (muxer_can_read)
+      if (_muxer_can_read)
         try {
           timed_out_muxer = !_subscriber.get_muxer().read(d, 0);
         }
       catch (shutdown const& e) {
-        muxer_can_read = false;
+        _muxer_can_read = false;
       }
       if (d) {
         {
@@ -188,13 +208,14 @@ void feeder::_callback() noexcept {
         }
         _subscriber.get_muxer().ack_events(1);
         tick();
+        d.reset();
       }
 
-      // If both timed out, sleep a while.
-      d.reset();
+      // If both timed out, wait for new data.
       if (timed_out_stream && timed_out_muxer)
-        ::usleep(100000);
+        return _stream_notifies ? idle_delay : poll_delay;
     }
+    return 0;
   }
   catch (shutdown const& e) {
     // Normal termination.
@@ -211,18 +232,30 @@ void feeder::_callback() noexcept {
         << "feeder: unknown error occured while processing client '" << _name
         << "'";
   }
+  _stop();
+  return -1;
+}
 
-  std::unique_lock<std::mutex> lock_stop(_stopped_m);
-  _stopped = true;
-  _stopped_cv.notify_all();
-  lock_stop.unlock();
-
+/**
+ *  Release the client once the task is finished.
+ */
+void feeder::_stop() {
   {
-    misc::read_lock lock(_client_m);
-    _client.reset();
+    std::lock_guard<std::mutex> lock(_task_m);
+    if (_finished)
+      return;
+    _finished = true;
+  }
+  _subscriber.get_muxer().set_notifier(nullptr);
+  {
+    std::lock_guard<misc::shared_mutex> lock(_client_m);
+    if (_client) {
+      _client->set_read_notifier(nullptr);
+      _client.reset();
+    }
     set_state("disconnected");
     _subscriber.get_muxer().remove_queue_files();
   }
-  logging::info(logging::medium) << "feeder: thread of client '" << _name
+  logging::info(logging::medium) << "feeder: task of client '" << _name
                                  << "' will exit";
 }
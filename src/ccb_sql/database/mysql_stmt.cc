@@ -116,7 +116,8 @@ mysql_stmt::mysql_stmt(mysql_stmt&& other)
       _param_count(other._param_count),
       _query(other._query),
       _bind(std::move(other._bind)),
-      _bind_mapping(other._bind_mapping) {}
+      _bind_mapping(other._bind_mapping),
+      _bind_plan(other._bind_plan) {}
 
 mysql_stmt& mysql_stmt::operator=(mysql_stmt const& other) {
   if (this != &other) {
@@ -124,6 +125,7 @@ mysql_stmt& mysql_stmt::operator=(mysql_stmt const& other) {
     _param_count = other._param_count;
     _query = other._query;
     _bind_mapping = other._bind_mapping;
+    _bind_plan = other._bind_plan;
   }
   return *this;
 }
@@ -159,109 +161,148 @@ std::unique_ptr<database::mysql_bind> mysql_stmt::get_bind() {
   return std::move(_bind);
 }
 
+/**
+ *  Bind the fields of an event to the statement.
+ *
+ *  @param[in] d  The event.
+ */
 void mysql_stmt::operator<<(io::data const& d) {
-  // Get event info.
-  io::event_info const* info(io::events::instance().get_event_info(d.type()));
-  if (info) {
-    for (mapping::entry const* current_entry(info->get_mapping());
-         !current_entry->is_null();
-         ++current_entry) {
-      char const* entry_name = current_entry->get_name_v2();
-      if (entry_name && entry_name[0]) {
-        std::string field(":");
-        field.append(entry_name);
-        switch (current_entry->get_type()) {
-          case mapping::source::BOOL:
-            bind_value_as_bool(field, current_entry->get_bool(d));
-            break;
-          case mapping::source::DOUBLE:
-            bind_value_as_f64(field, current_entry->get_double(d));
-            break;
-          case mapping::source::INT: {
-            int v(current_entry->get_int(d));
-            switch (current_entry->get_attribute()) {
-              case mapping::entry::invalid_on_zero:
-                if (v == 0)
-                  bind_value_as_null(field);
-                else
-                  bind_value_as_i32(field, v);
-                break;
-              case mapping::entry::invalid_on_minus_one:
-                if (v == -1)
-                  bind_value_as_null(field);
-                else
-                  bind_value_as_i32(field, v);
-                break;
-              default:
-                bind_value_as_i32(field, v);
-            }
-          } break;
-          case mapping::source::SHORT:
-            bind_value_as_i32(field, current_entry->get_short(d));
-            break;
-          case mapping::source::STRING: {
-            std::string v(current_entry->get_string(d));
-            if (current_entry->get_attribute() ==
-                mapping::entry::invalid_on_zero) {
-              if (v == "")
-                bind_value_as_null(field);
-              else
-                bind_value_as_str(field, v);
-            } else
-              bind_value_as_str(field, v);
-          } break;
-          case mapping::source::TIME: {
-            time_t v(current_entry->get_time(d));
-            switch (current_entry->get_attribute()) {
-              case mapping::entry::invalid_on_zero:
-                if (v == 0)
-                  bind_value_as_null(field);
-                else
-                  bind_value_as_u32(field, v);
-                break;
-              case mapping::entry::invalid_on_minus_one:
-                if (v == -1)
-                  bind_value_as_null(field);
-                else
-                  bind_value_as_u32(field, v);
-                break;
-              default:
-                bind_value_as_u32(field, v);
-            }
-          } break;
-          case mapping::source::UINT: {
-            uint32_t v(current_entry->get_uint(d));
-            switch (current_entry->get_attribute()) {
-              case mapping::entry::invalid_on_zero:
-                //              if (v == 0)
-                //                bind_value_as_null(field);
-                //              else
-                bind_value_as_u32(field, v);
-                break;
-              case mapping::entry::invalid_on_minus_one:
-                if (v == (uint32_t) - 1)
-                  bind_value_as_null(field);
-                else
-                  bind_value_as_u32(field, v);
-                break;
-              default:
-                bind_value_as_u32(field, v);
-            }
-          } break;
-          default:  // Error in one of the mappings.
-            throw msg_fmt(
-                "invalid mapping for object of type '{}': {} is not a known "
-                "type ID",
-                info->get_name(),
-                current_entry->get_type());
-        };
-      }
+  if (!_bind_plan || _bind_plan->event_type != d.type())
+    compile_bind_plan(d.type());
+
+  if (!_bind)
+    _bind.reset(new database::mysql_bind(_param_count));
+
+  for (mysql_bind_plan::field const& f : _bind_plan->fields) {
+    switch (f.type) {
+      case mapping::source::BOOL:
+        _bind_field<bool>(f, false, f.entry->get_bool(d),
+                          &mysql_bind::set_value_as_bool);
+        break;
+      case mapping::source::DOUBLE:
+        _bind_field<double>(f, false, f.entry->get_double(d),
+                            &mysql_bind::set_value_as_f64);
+        break;
+      case mapping::source::INT: {
+        int v(f.entry->get_int(d));
+        _bind_field<int>(
+            f,
+            (f.policy == mysql_bind_plan::null_on_zero && v == 0) ||
+                (f.policy == mysql_bind_plan::null_on_minus_one && v == -1),
+            v, &mysql_bind::set_value_as_i32);
+      } break;
+      case mapping::source::SHORT:
+        _bind_field<int>(f, false, f.entry->get_short(d),
+                         &mysql_bind::set_value_as_i32);
+        break;
+      case mapping::source::STRING: {
+        std::string const& v(f.entry->get_string(d));
+        _bind_field<std::string const&>(
+            f, f.policy == mysql_bind_plan::null_on_empty && v.empty(), v,
+            &mysql_bind::set_value_as_str);
+      } break;
+      case mapping::source::TIME: {
+        time_t v(f.entry->get_time(d));
+        _bind_field<uint32_t>(
+            f,
+            (f.policy == mysql_bind_plan::null_on_zero && v == 0) ||
+                (f.policy == mysql_bind_plan::null_on_minus_one && v == -1),
+            v, &mysql_bind::set_value_as_u32);
+      } break;
+      case mapping::source::UINT: {
+        uint32_t v(f.entry->get_uint(d));
+        _bind_field<uint32_t>(
+            f,
+            f.policy == mysql_bind_plan::null_on_minus_one &&
+                v == static_cast<uint32_t>(-1),
+            v, &mysql_bind::set_value_as_u32);
+      } break;
     }
-  } else
+  }
+}
+
+/**
+ *  Compute the bindings of an event type from the bind mapping of the
+ *  statement. They are then used by operator<<() for all the events of
+ *  this type, without any lookup by name.
+ *
+ *  @param[in] event_type  The event type.
+ */
+void mysql_stmt::compile_bind_plan(uint32_t event_type) {
+  io::event_info const* info(io::events::instance().get_event_info(event_type));
+  if (!info)
     throw msg_fmt(
         "cannot bind object of type {} to database query: mapping does not "
         "exist",
-        d.type());
+        event_type);
+
+  std::shared_ptr<mysql_bind_plan> plan(std::make_shared<mysql_bind_plan>());
+  plan->event_type = event_type;
+  std::string key;
+  for (mapping::entry const* current_entry(info->get_mapping());
+       !current_entry->is_null(); ++current_entry) {
+    char const* entry_name = current_entry->get_name_v2();
+    if (!entry_name || !entry_name[0])
+      continue;
+
+    mysql_bind_plan::field f{current_entry, current_entry->get_type(),
+                             mysql_bind_plan::never_null, {-1, -1}};
+    uint32_t attribute(current_entry->get_attribute());
+    switch (f.type) {
+      case mapping::source::BOOL:
+      case mapping::source::DOUBLE:
+      case mapping::source::SHORT:
+        break;
+      case mapping::source::INT:
+      case mapping::source::TIME:
+        if (attribute == mapping::entry::invalid_on_zero)
+          f.policy = mysql_bind_plan::null_on_zero;
+        else if (attribute == mapping::entry::invalid_on_minus_one)
+          f.policy = mysql_bind_plan::null_on_minus_one;
+        break;
+      case mapping::source::STRING:
+        if (attribute == mapping::entry::invalid_on_zero)
+          f.policy = mysql_bind_plan::null_on_empty;
+        break;
+      case mapping::source::UINT:
+        // Zero is a valid value for unsigned integers.
+        if (attribute == mapping::entry::invalid_on_minus_one)
+          f.policy = mysql_bind_plan::null_on_minus_one;
+        break;
+      default:  // Error in one of the mappings.
+        throw msg_fmt(
+            "invalid mapping for object of type '{}': {} is not a known "
+            "type ID",
+            info->get_name(), f.type);
+    }
+
+    // A field is either bound once, or twice as name1 and name2 in
+    // insert or update queries.
+    key = ":";
+    key.append(entry_name);
+    mysql_bind_mapping::const_iterator it(_bind_mapping.find(key));
+    if (it != _bind_mapping.end())
+      f.index[0] = it->second;
+    else {
+      key.push_back('1');
+      it = _bind_mapping.find(key);
+      if (it != _bind_mapping.end()) {
+        f.index[0] = it->second;
+        key[key.size() - 1] = '2';
+        it = _bind_mapping.find(key);
+        if (it != _bind_mapping.end())
+          f.index[1] = it->second;
+      }
+    }
+
+    if (f.index[0] >= 0)
+      plan->fields.push_back(f);
+    else
+      logging::debug(logging::low)
+          << "mysql: cannot bind object with name ':" << entry_name
+          << "' in statement " << get_id();
+  }
+  _bind_plan = plan;
 }
 
 void mysql_stmt::bind_value_as_i32(int range, int value) {
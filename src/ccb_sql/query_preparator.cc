@@ -140,6 +140,7 @@ mysql_stmt query_preparator::prepare_insert(mysql& ms, bool ignore) {
         info->get_table(),
         e.what());
   }
+  retval.compile_bind_plan(_event_id);
   return retval;
 }
 
@@ -234,6 +235,7 @@ mysql_stmt query_preparator::prepare_insert_or_update(mysql& ms) {
         info->get_table(),
         e.what());
   }
+  retval.compile_bind_plan(_event_id);
   return retval;
 }
 
@@ -318,6 +320,7 @@ mysql_stmt query_preparator::prepare_update(mysql& ms) {
         info->get_table(),
         e.what());
   }
+  retval.compile_bind_plan(_event_id);
   return retval;
 }
 
@@ -368,5 +371,6 @@ mysql_stmt query_preparator::prepare_delete(mysql& ms) {
         info->get_table(),
         e.what());
   }
+  retval.compile_bind_plan(_event_id);
   return retval;
 }
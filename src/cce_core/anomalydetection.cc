@@ -19,12 +19,24 @@
 
 #include "com/centreon/engine/anomalydetection.hh"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
 #include <cmath>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <fstream>
 #include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/command_manager.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/host.hh"
 #include "com/centreon/engine/logging.hh"
@@ -186,8 +198,7 @@ anomalydetection::anomalydetection(uint64_t host_id,
       _dependent_service{dependent_service},
       _metric_name{metric_name},
       _thresholds_file{thresholds_file},
-      _status_change{status_change},
-      _thresholds_file_viable{false} {
+      _status_change{status_change} {
   set_host_id(host_id);
   set_service_id(service_id);
   init_thresholds();
@@ -664,7 +675,7 @@ commands::command* anomalydetection::get_check_command_ptr() const {
 std::tuple<service::service_state, double, std::string, double, double>
 anomalydetection::parse_perfdata(std::string const& perfdata,
                                  time_t check_time) {
-  std::lock_guard<std::mutex> lock(_thresholds_m);
+  std::shared_ptr<threshold_set const> thresholds{get_thresholds()};
   size_t pos = perfdata.find_last_of("=");
   /* If the perfdata is wrong. */
   if (pos == std::string::npos) {
@@ -687,7 +698,7 @@ anomalydetection::parse_perfdata(std::string const& perfdata,
 
   service::service_state status;
 
-  if (!_thresholds_file_viable) {
+  if (!thresholds) {
     status = service::state_ok;
     if (_status_change) {
       logger(log_info_message, basic) << "The thresholds file is not viable "
@@ -713,15 +724,17 @@ anomalydetection::parse_perfdata(std::string const& perfdata,
    * The linear approximation gives the formula:
    *                       dc = (d2-d1) * (tc-t1) / (t2-t1) + d1
    */
-  auto it2 = _thresholds.upper_bound(check_time);
-  auto it1 = it2;
-  if (it2 == _thresholds.end()) {
+  threshold_point const* it2 = std::upper_bound(
+      thresholds->begin(), thresholds->end(), check_time,
+      [](time_t t, threshold_point const& p) { return t < p.timestamp; });
+  threshold_point const* it1 = it2;
+  if (it2 == thresholds->end()) {
     logger(log_runtime_error, basic) << "Error: the thresholds file is too old "
                                         "compared to the check timestamp "
                                      << check_time;
     return std::make_tuple(service::state_unknown, value, uom, NAN, NAN);
   }
-  if (it1 != _thresholds.begin())
+  if (it1 != thresholds->begin())
     --it1;
   else {
     logger(log_runtime_error, basic)
@@ -730,13 +743,13 @@ anomalydetection::parse_perfdata(std::string const& perfdata,
     return std::make_tuple(service::state_unknown, value, uom, NAN, NAN);
   }
 
-  /* Now it1.first <= check_time < it2.first */
-  double upper = (it2->second.second - it1->second.second) *
-                     (check_time - it1->first) / (it2->first - it1->first) +
-                 it1->second.second;
-  double lower = (it2->second.first - it1->second.first) *
-                     (check_time - it1->first) / (it2->first - it1->first) +
-                 it1->second.first;
+  /* Now it1->timestamp <= check_time < it2->timestamp */
+  double upper = (it2->upper - it1->upper) * (check_time - it1->timestamp) /
+                     (it2->timestamp - it1->timestamp) +
+                 it1->upper;
+  double lower = (it2->lower - it1->lower) * (check_time - it1->timestamp) /
+                     (it2->timestamp - it1->timestamp) +
+                 it1->lower;
 
   if (!_status_change)
     status = service::state_ok;
@@ -752,79 +765,162 @@ anomalydetection::parse_perfdata(std::string const& perfdata,
   return std::make_tuple(status, value, uom, lower, upper);
 }
 
-void anomalydetection::init_thresholds() {
-  std::lock_guard<std::mutex> lock(_thresholds_m);
+/**
+ * @brief Predictions owned by the set.
+ *
+ * @param points Predictions sorted by timestamp.
+ */
+anomalydetection::threshold_set::threshold_set(
+    std::vector<threshold_point>&& points) {
+  auto storage = std::make_shared<std::vector<threshold_point> >(
+      std::move(points));
+  _begin = storage->data();
+  _size = storage->size();
+  _storage = std::move(storage);
+}
+
+/**
+ * @brief Predictions stored elsewhere (a file buffer for example).
+ *
+ * @param storage Object keeping the predictions alive.
+ * @param begin First prediction.
+ * @param size Number of predictions.
+ */
+anomalydetection::threshold_set::threshold_set(
+    std::shared_ptr<void const> storage,
+    threshold_point const* begin,
+    size_t size)
+    : _storage{std::move(storage)}, _begin{begin}, _size{size} {}
+
+namespace {
+/* Content of a file, aligned on 8 bytes so that predictions can be used
+ * in place. */
+class file_buffer {
+  std::vector<uint64_t> _words;
+  size_t _size;
+
+ public:
+  file_buffer() : _size{0} {}
+  file_buffer(file_buffer const&) = delete;
+  file_buffer& operator=(file_buffer const&) = delete;
+
+  /* Read the file until its end, whatever its size when it was opened.
+   * Return false on error. */
+  bool read_from(int fd) {
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+      _words.resize(st.st_size / sizeof(uint64_t) + 1);
+    for (;;) {
+      if (_size == _words.size() * sizeof(uint64_t))
+        _words.resize(_words.size() * 2 + 512);
+      ssize_t r = ::read(fd, reinterpret_cast<char*>(_words.data()) + _size,
+                         _words.size() * sizeof(uint64_t) - _size);
+      if (r == 0)
+        return true;
+      if (r < 0) {
+        if (errno == EINTR)
+          continue;
+        return false;
+      }
+      _size += r;
+    }
+  }
+  char const* data() const noexcept {
+    return reinterpret_cast<char const*>(_words.data());
+  }
+  size_t size() const noexcept { return _size; }
+};
+
+/* Binary thresholds file header. */
+struct binary_header {
+  char magic[4];
+  uint32_t version;
+  uint64_t series_count;
+};
+
+/* Binary thresholds file series descriptor. */
+struct binary_series {
+  uint64_t host_id;
+  uint64_t service_id;
+  uint64_t points_offset;
+  uint64_t points_count;
+  uint32_t metric_offset;
+  uint32_t metric_length;
+};
+
+char const binary_magic[4]{'C', 'A', 'D', 'T'};
+uint32_t const binary_version{1};
+}  // namespace
 
+void anomalydetection::init_thresholds() {
   logger(log_info_message, basic)
       << "Trying to read thresholds file '" << _thresholds_file << "'";
-  std::ifstream t(_thresholds_file);
-  if (!t)
+  if (access(_thresholds_file.c_str(), R_OK))
     return;
 
-  std::stringstream buffer;
-  buffer << t.rdbuf();
-  std::string err;
-  auto json = json11::Json::parse(buffer.str(), err);
-  if (!err.empty()) {
-    logger(log_config_error, basic) << "Error: the file '" << _thresholds_file
-                                    << "' contains errors: " << err;
-    return;
-  }
-  if (!json.is_array()) {
-    logger(log_config_error, basic)
-        << "Error: the file '" << _thresholds_file
-        << "' is not a thresholds file. Its global structure is not an array.";
+  std::vector<thresholds_entry> entries;
+  if (parse_thresholds_file(_thresholds_file, entries) < 0)
     return;
-  }
 
-  int count = 0;
-  for (auto& item : json.array_items()) {
-    uint64_t host_id, service_id;
-    try {
-      host_id = stoull(item["host_id"].string_value());
-      service_id = stoull(item["service_id"].string_value());
-    } catch (std::exception const& e) {
-      logger(log_config_error, basic) << "Error: host_id and service_id must "
-                                         "be strings containing integers: "
-                                      << e.what();
-      return;
-    }
-    if (host_id == get_host_id() && service_id == get_service_id() &&
-        item["metric_name"].string_value() == _metric_name) {
+  for (thresholds_entry const& e : entries) {
+    if (e.host_id == get_host_id() && e.service_id == get_service_id() &&
+        e.metric_name == _metric_name) {
       logger(log_info_message, basic)
           << "Filling thresholds in anomaly detection (host_id: "
           << get_host_id() << ", service_id: " << get_service_id()
           << ", metric: " << _metric_name << ")";
-      auto predict = item["predict"];
-      _thresholds.clear();
-      for (auto& i : predict.array_items()) {
-        time_t timestamp = static_cast<time_t>(i["timestamp"].number_value());
-        double upper = i["upper"].number_value();
-        double lower = i["lower"].number_value();
-        _thresholds.emplace_hint(
-            _thresholds.end(),
-            std::make_pair(timestamp, std::make_pair(lower, upper)));
-        count++;
-      }
-      break;
+      if (e.thresholds->size() > 1) {
+        logger(log_info_message, most)
+            << "Number of rows in memory: " << e.thresholds->size();
+        std::atomic_store(&_thresholds, e.thresholds);
+      } else
+        logger(log_info_message, most) << "Nothing in memory";
+      return;
     }
   }
-  if (count > 1) {
-    logger(log_info_message, most) << "Number of rows in memory: " << count;
-    _thresholds_file_viable = true;
-  } else
-    logger(log_info_message, most) << "Nothing in memory";
+  logger(log_info_message, most) << "Nothing in memory";
 }
 
 /**
- * @brief Update all the anomaly detection services concerned by one thresholds
- *        file. The file has already been parsed and is translated into json.
+ * @brief Read a thresholds file. The file is either a JSON array or a
+ * binary file (see _parse_binary_thresholds()). This function does not
+ * access any engine object so it can be called outside of the main loop.
  *
  * @param filename The fullname of the file to parse.
+ * @param entries Predictions found in the file, one entry per service.
+ *
+ * @return 0 on success, a negative value otherwise.
  */
-int anomalydetection::update_thresholds(const std::string& filename) {
-  logger(log_info_message, most)
-      << "Reading thresholds file '" << filename << "'.";
+int anomalydetection::parse_thresholds_file(
+    std::string const& filename,
+    std::vector<thresholds_entry>& entries) {
+  char magic[sizeof(binary_magic)];
+  {
+    std::ifstream t(filename, std::ios::binary);
+    if (!t) {
+      logger(log_config_error, basic)
+          << "Error: Unable to read the thresholds file '" << filename << "'.";
+      return -1;
+    }
+    if (!t.read(magic, sizeof(magic)))
+      memset(magic, 0, sizeof(magic));
+  }
+  if (memcmp(magic, binary_magic, sizeof(magic)) == 0)
+    return _parse_binary_thresholds(filename, entries);
+  return _parse_json_thresholds(filename, entries);
+}
+
+/**
+ * @brief Read a JSON thresholds file.
+ *
+ * @param filename The fullname of the file to parse.
+ * @param entries Predictions found in the file.
+ *
+ * @return 0 on success, a negative value otherwise.
+ */
+int anomalydetection::_parse_json_thresholds(
+    std::string const& filename,
+    std::vector<thresholds_entry>& entries) {
   std::ifstream t(filename);
   if (!t) {
     logger(log_config_error, basic)
@@ -849,6 +945,7 @@ int anomalydetection::update_thresholds(const std::string& filename) {
     return -3;
   }
 
+  entries.reserve(entries.size() + json.array_items().size());
   for (auto& item : json.array_items()) {
     uint64_t host_id, svc_id;
     try {
@@ -860,23 +957,167 @@ int anomalydetection::update_thresholds(const std::string& filename) {
                                       << e.what();
       continue;
     }
-    auto found = service::services_by_id.find({host_id, svc_id});
+
+    auto const& predict = item["predict"].array_items();
+    std::vector<threshold_point> points;
+    points.reserve(predict.size());
+    for (auto& i : predict)
+      points.push_back({static_cast<int64_t>(i["timestamp"].number_value()),
+                        i["lower"].number_value(),
+                        i["upper"].number_value()});
+    /* Predictions are expected sorted, keep the first one of duplicates. */
+    std::stable_sort(points.begin(), points.end(),
+                     [](threshold_point const& a, threshold_point const& b) {
+                       return a.timestamp < b.timestamp;
+                     });
+    points.erase(std::unique(points.begin(), points.end(),
+                             [](threshold_point const& a,
+                                threshold_point const& b) {
+                               return a.timestamp == b.timestamp;
+                             }),
+                 points.end());
+
+    entries.push_back({host_id, svc_id, item["metric_name"].string_value(),
+                       std::make_shared<threshold_set const>(
+                           std::move(points))});
+  }
+  return 0;
+}
+
+/**
+ * @brief Read a binary thresholds file. The file is read at once and
+ * predictions are used in place. Integers are in host byte order:
+ *
+ *   header   "CADT", uint32 version (1), uint64 number of series
+ *   series   uint64 host_id, uint64 service_id, uint64 offset of the
+ *            predictions, uint64 number of predictions, uint32 offset and
+ *            uint32 length of the metric name
+ *   ...
+ *
+ * Predictions are arrays of threshold_point (int64 timestamp, double
+ * lower, double upper) sorted by timestamp and aligned on 8 bytes.
+ *
+ * @param filename The fullname of the file to parse.
+ * @param entries Predictions found in the file.
+ *
+ * @return 0 on success, a negative value otherwise.
+ */
+int anomalydetection::_parse_binary_thresholds(
+    std::string const& filename,
+    std::vector<thresholds_entry>& entries) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    logger(log_config_error, basic)
+        << "Error: Unable to read the thresholds file '" << filename
+        << "': " << strerror(errno);
+    return -1;
+  }
+  /* The file is read instead of being mapped: a mapping would fault if
+   * the file was truncated while it is used. */
+  auto buffer = std::make_shared<file_buffer>();
+  bool read_ok{buffer->read_from(fd)};
+  int read_errno{errno};
+  close(fd);
+  if (!read_ok) {
+    logger(log_config_error, basic)
+        << "Error: Unable to read the thresholds file '" << filename
+        << "': " << strerror(read_errno);
+    return -1;
+  }
+  if (buffer->size() < sizeof(binary_header)) {
+    logger(log_config_error, basic)
+        << "Error: the file '" << filename
+        << "' is not a valid binary thresholds file.";
+    return -3;
+  }
+  std::shared_ptr<file_buffer const> file{std::move(buffer)};
+
+  binary_header header;
+  memcpy(&header, file->data(), sizeof(header));
+  if (header.version != binary_version ||
+      header.series_count > (file->size() - sizeof(header)) /
+                                sizeof(binary_series)) {
+    logger(log_config_error, basic)
+        << "Error: the file '" << filename
+        << "' is not a valid binary thresholds file.";
+    return -3;
+  }
+
+  entries.reserve(entries.size() + header.series_count);
+  for (uint64_t i = 0; i < header.series_count; ++i) {
+    binary_series series;
+    memcpy(&series, file->data() + sizeof(header) + i * sizeof(series),
+           sizeof(series));
+    if (series.points_offset % alignof(threshold_point) ||
+        series.points_offset > file->size() ||
+        series.points_count >
+            (file->size() - series.points_offset) / sizeof(threshold_point) ||
+        series.metric_offset > file->size() ||
+        series.metric_length > file->size() - series.metric_offset) {
+      logger(log_config_error, basic)
+          << "Error: the file '" << filename
+          << "' contains invalid thresholds for the anomaly detection "
+             "service (host_id: "
+          << series.host_id << ", service_id: " << series.service_id << ")";
+      continue;
+    }
+
+    threshold_point const* points{reinterpret_cast<threshold_point const*>(
+        file->data() + series.points_offset)};
+    std::shared_ptr<threshold_set const> set;
+    if (std::is_sorted(points, points + series.points_count,
+                       [](threshold_point const& a, threshold_point const& b) {
+                         return a.timestamp <= b.timestamp;
+                       }))
+      set = std::make_shared<threshold_set const>(file, points,
+                                                  series.points_count);
+    else {
+      std::vector<threshold_point> copy(points, points + series.points_count);
+      std::stable_sort(copy.begin(), copy.end(),
+                       [](threshold_point const& a, threshold_point const& b) {
+                         return a.timestamp < b.timestamp;
+                       });
+      set = std::make_shared<threshold_set const>(std::move(copy));
+    }
+    entries.push_back(
+        {series.host_id, series.service_id,
+         std::string(file->data() + series.metric_offset,
+                     series.metric_length),
+         std::move(set)});
+  }
+  return 0;
+}
+
+/**
+ * @brief Give predictions read from a thresholds file to the anomaly
+ * detection services they belong to. Must be called from the main loop.
+ *
+ * @param filename The fullname of the file.
+ * @param entries Predictions read by parse_thresholds_file().
+ *
+ * @return 0.
+ */
+int anomalydetection::apply_thresholds(
+    std::string const& filename,
+    std::vector<thresholds_entry> const& entries) {
+  for (thresholds_entry const& e : entries) {
+    auto found = service::services_by_id.find({e.host_id, e.service_id});
     if (found == service::services_by_id.end()) {
       logger(log_config_error, basic)
           << "Error: The thresholds file contains thresholds for the anomaly "
              "detection service (host_id: "
-          << host_id << ", service_id: " << svc_id << ") that does not exist";
+          << e.host_id << ", service_id: " << e.service_id
+          << ") that does not exist";
       continue;
     }
     std::shared_ptr<anomalydetection> ad =
         std::static_pointer_cast<anomalydetection>(found->second);
-    const std::string& metric_name(item["metric_name"].string_value());
-    if (ad->get_metric_name() != metric_name) {
+    if (ad->get_metric_name() != e.metric_name) {
       logger(log_config_error, basic)
           << "Error: The thresholds file contains thresholds for the anomaly "
              "detection service (host_id: "
           << ad->get_host_id() << ", service_id: " << ad->get_service_id()
-          << ") with metric_name='" << metric_name
+          << ") with metric_name='" << e.metric_name
           << "' whereas the configured metric name is '"
           << ad->get_metric_name() << "'";
       continue;
@@ -885,28 +1126,113 @@ int anomalydetection::update_thresholds(const std::string& filename) {
         << "Filling thresholds in anomaly detection (host_id: "
         << ad->get_host_id() << ", service_id: " << ad->get_service_id()
         << ", metric: " << ad->get_metric_name() << ")";
-
-    auto predict = item["predict"];
-    std::map<time_t, std::pair<double, double> > thresholds;
-    for (auto& i : predict.array_items()) {
-      time_t timestamp = static_cast<time_t>(i["timestamp"].number_value());
-      double upper = i["upper"].number_value();
-      double lower = i["lower"].number_value();
-      thresholds.emplace_hint(
-          thresholds.end(),
-          std::make_pair(timestamp, std::make_pair(lower, upper)));
-    }
-    ad->set_thresholds(filename, std::move(thresholds));
+    ad->set_thresholds(filename, e.thresholds);
   }
   return 0;
 }
 
+/**
+ * @brief Update all the anomaly detection services concerned by one thresholds
+ *        file.
+ *
+ * @param filename The fullname of the file to parse.
+ */
+int anomalydetection::update_thresholds(const std::string& filename) {
+  logger(log_info_message, most)
+      << "Reading thresholds file '" << filename << "'.";
+  std::vector<thresholds_entry> entries;
+  int retval = parse_thresholds_file(filename, entries);
+  if (retval < 0)
+    return retval;
+  return apply_thresholds(filename, entries);
+}
+
+namespace {
+/* Thread reading the files given to update_thresholds_async(), one after
+ * the other so that their updates are applied in the same order. */
+std::mutex update_m;
+std::condition_variable update_cv;
+std::deque<std::string> update_queue;
+std::thread update_thread;
+bool update_exit{false};
+}  // namespace
+
+/**
+ * @brief Same as update_thresholds() but the file is read by another
+ * thread, only the update of the services is done by the main loop.
+ * Files are read in the order they are given.
+ *
+ * @param filename The fullname of the file to parse.
+ */
+void anomalydetection::update_thresholds_async(std::string const& filename) {
+  std::lock_guard<std::mutex> lock(update_m);
+  if (!update_thread.joinable()) {
+    update_exit = false;
+    update_thread = std::thread([] {
+      std::unique_lock<std::mutex> lock(update_m);
+      for (;;) {
+        update_cv.wait(lock,
+                       [] { return update_exit || !update_queue.empty(); });
+        if (update_exit)
+          return;
+        std::string filename{std::move(update_queue.front())};
+        update_queue.pop_front();
+        lock.unlock();
+
+        logger(log_info_message, most)
+            << "Reading thresholds file '" << filename << "'.";
+        auto entries = std::make_shared<std::vector<thresholds_entry> >();
+        if (parse_thresholds_file(filename, *entries) >= 0)
+          command_manager::instance().enqueue(
+              std::packaged_task<int(void)>([filename, entries]() -> int {
+                return apply_thresholds(filename, *entries);
+              }));
+        lock.lock();
+      }
+    });
+  }
+  update_queue.push_back(filename);
+  update_cv.notify_one();
+}
+
+/**
+ * @brief Stop the thread reading thresholds files. Files not read yet
+ * are forgotten. The thread is started again by the next
+ * update_thresholds_async().
+ */
+void anomalydetection::stop_thresholds_updates() {
+  {
+    std::lock_guard<std::mutex> lock(update_m);
+    if (!update_thread.joinable())
+      return;
+    update_exit = true;
+    update_queue.clear();
+    update_cv.notify_one();
+  }
+  update_thread.join();
+}
+
 void anomalydetection::set_thresholds(
     const std::string& filename,
-    std::map<time_t, std::pair<double, double> >&& thresholds) noexcept {
-  std::lock_guard<std::mutex> _lock(_thresholds_m);
-  _thresholds_file = filename, _thresholds = thresholds;
-  _thresholds_file_viable = _thresholds.size() > 0;
+    std::shared_ptr<threshold_set const> thresholds) noexcept {
+  {
+    std::lock_guard<std::mutex> _lock(_thresholds_m);
+    _thresholds_file = filename;
+  }
+  if (thresholds && thresholds->size() == 0)
+    thresholds.reset();
+  std::atomic_store(&_thresholds, std::move(thresholds));
+}
+
+/**
+ * @brief Get the current predictions. They can be replaced at any time by
+ * set_thresholds(), the returned set stays valid as long as it is held.
+ *
+ * @return The predictions, nullptr if no viable thresholds file was read.
+ */
+std::shared_ptr<anomalydetection::threshold_set const>
+anomalydetection::get_thresholds() const noexcept {
+  return std::atomic_load(&_thresholds);
 }
 
 void anomalydetection::set_status_change(bool status_change) {
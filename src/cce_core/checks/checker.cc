@@ -89,6 +89,7 @@ void checker::clear() noexcept {
       it = _waiting_check_result.erase(it);
     }
     _to_forget.clear();
+    _reachability.clear();
   }
   catch (...) {
   }
@@ -101,6 +102,9 @@ void checker::reap() {
   logger(dbg_functions, logging::basic) << "checker::reap";
   logger(dbg_checks, logging::basic) << "Starting to reap check results.";
 
+  // Finish the resolutions of hosts whose parents were removed.
+  _reachability.flush();
+
   // Time to start reaping.
   time_t reaper_start_time;
   time(&reaper_start_time);
@@ -720,5 +724,16 @@ void checker::forget(notifier* n) noexcept {
   if (_instance) {
     std::lock_guard<std::mutex> lock(_instance->_mut_reap);
     _instance->_to_forget.push_back(n);
+    if (n->get_notifier_type() == notifier::host_notification)
+      _instance->_reachability.forget(static_cast<host*>(n));
   }
 }
+
+/**
+ *  Get the resolver of hosts reachability.
+ *
+ *  @return The reachability resolver.
+ */
+reachability& checker::get_reachability() noexcept {
+  return _reachability;
+}
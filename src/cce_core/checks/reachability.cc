@@ -0,0 +1,273 @@
+/*
+** Copyright 2020 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/checks/reachability.hh"
+
+#include <ctime>
+
+#include "com/centreon/engine/checks/stats.hh"
+#include "com/centreon/engine/common.hh"
+#include "com/centreon/engine/logging/logger.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::checks;
+using namespace com::centreon::engine::logging;
+
+/**
+ *  Cancel the pending resolution of a host, when a newer check result
+ *  supersedes the one being resolved.
+ *
+ *  @param[in] hst  The host.
+ */
+void reachability::cancel(host* hst) {
+  auto it(_pending.find(hst));
+  if (it != _pending.end()) {
+    logger(dbg_checks, more) << "Reachability resolution of host '"
+                             << hst->get_name() << "' cancelled.";
+    _remove(it);
+  }
+}
+
+/**
+ *  Drop all the pending resolutions.
+ */
+void reachability::clear() noexcept {
+  _pending.clear();
+  _ready.clear();
+  _waiters.clear();
+}
+
+/**
+ *  Finish the resolutions of hosts whose parents were all removed.
+ */
+void reachability::flush() {
+  std::vector<host*> ready;
+  std::swap(ready, _ready);
+  for (host* hst : ready) {
+    auto it(_pending.find(hst));
+    if (it != _pending.end() && it->second.parents.empty())
+      _finish(hst, host::state_unreachable);
+  }
+}
+
+/**
+ *  Forget a host that is being removed.
+ *
+ *  @param[in] hst  The host.
+ */
+void reachability::forget(host* hst) {
+  auto it(_pending.find(hst));
+  if (it != _pending.end())
+    _remove(it);
+  auto w(_waiters.find(hst));
+  if (w != _waiters.end()) {
+    for (host* child : w->second) {
+      auto it(_pending.find(child));
+      if (it != _pending.end()) {
+        it->second.parents.erase(hst);
+        if (it->second.parents.empty())
+          _ready.push_back(child);
+      }
+    }
+    _waiters.erase(w);
+  }
+}
+
+/**
+ *  Check if the state of a host is waiting for its parents.
+ *
+ *  @param[in] hst  The host.
+ *
+ *  @return True if the host state transition is not finished yet.
+ */
+bool reachability::is_pending(host const* hst) const noexcept {
+  return _pending.find(hst) != _pending.end();
+}
+
+/**
+ *  Give the final state of a host to its waiting children.
+ *
+ *  @param[in] hst  The host whose check result was just processed.
+ */
+void reachability::notify(host* hst) {
+  auto w(_waiters.find(hst));
+  if (w == _waiters.end())
+    return;
+  std::unordered_set<host*> children(std::move(w->second));
+  _waiters.erase(w);
+
+  bool up(hst->get_current_state() == host::state_up);
+  for (host* child : children) {
+    auto it(_pending.find(child));
+    if (it == _pending.end())
+      continue;
+    if (up) {
+      logger(dbg_checks, more) << "Parent host '" << hst->get_name()
+                               << "' is UP, so host '" << child->get_name()
+                               << "' is DOWN.";
+      _finish(child, host::state_down);
+    } else {
+      it->second.parents.erase(hst);
+      if (it->second.parents.empty()) {
+        logger(dbg_checks, more) << "No parents were UP, so host '"
+                                 << child->get_name() << "' is UNREACHABLE.";
+        _finish(child, host::state_unreachable);
+      }
+    }
+  }
+}
+
+/**
+ *  Determine whether a host that just went down is DOWN or UNREACHABLE.
+ *
+ *  Parents with a recent enough state are used as is. The others are
+ *  checked asynchronously, unless a check is already running, and the
+ *  resolution then completes later through the finish callback.
+ *
+ *  @param[in]  hst                      The host.
+ *  @param[in]  check_options            Options of the parents checks.
+ *  @param[in]  use_cached_result        Use recent parent states.
+ *  @param[in]  check_timestamp_horizon  How recent a state must be.
+ *  @param[out] state                    The host state if resolved now.
+ *  @param[in]  finish                   Called with the host state once
+ *                                       the parents results arrived.
+ *
+ *  @return True if the state was resolved now, false if the host waits
+ *          for its parents.
+ */
+bool reachability::resolve(host* hst,
+                           int check_options,
+                           int use_cached_result,
+                           unsigned long check_timestamp_horizon,
+                           host::host_state& state,
+                           callback&& finish) {
+  cancel(hst);
+
+  time_t now(time(nullptr));
+  std::vector<host*> to_check;
+  bool has_parent(false);
+  for (host_map_unsafe::const_iterator it(hst->parent_hosts.begin()),
+       end(hst->parent_hosts.end());
+       it != end; ++it) {
+    host* parent(it->second);
+    if (!parent)
+      continue;
+    has_parent = true;
+
+    // A check of this parent is already running or being resolved.
+    if (parent->get_is_executing() || is_pending(parent)) {
+      to_check.push_back(parent);
+      continue;
+    }
+
+    // Use the parent state if it is recent enough.
+    if (use_cached_result && parent->has_been_checked() &&
+        static_cast<unsigned long>(now - parent->get_last_check()) <=
+            check_timestamp_horizon) {
+      update_check_stats(ACTIVE_ONDEMAND_HOST_CHECK_STATS, now);
+      update_check_stats(ACTIVE_CACHED_HOST_CHECK_STATS, now);
+      logger(dbg_checks, more) << "Using cached state of parent host '"
+                               << it->first
+                               << "': " << parent->get_current_state();
+      if (parent->get_current_state() == host::state_up) {
+        logger(dbg_checks, more) << "Parent host is UP, so this one is DOWN.";
+        state = host::state_down;
+        return true;
+      }
+      continue;
+    }
+    to_check.push_back(parent);
+  }
+
+  if (!has_parent) {
+    logger(dbg_checks, more) << "Host has no parents, so it's DOWN.";
+    state = host::state_down;
+    return true;
+  }
+
+  // Run the parents checks in parallel.
+  pending p;
+  for (host* parent : to_check) {
+    if (!parent->get_is_executing() && !is_pending(parent)) {
+      logger(dbg_checks, more) << "Running async check of parent host '"
+                               << parent->get_name() << "'...";
+      update_check_stats(ACTIVE_ONDEMAND_HOST_CHECK_STATS, now);
+      update_check_stats(PARALLEL_HOST_CHECK_STATS, now);
+      parent->run_async_check(check_options, 0.0, false, false, nullptr,
+                              nullptr);
+      // The check could not run, the parent state is the current one.
+      if (!parent->get_is_executing()) {
+        if (parent->get_current_state() == host::state_up) {
+          logger(dbg_checks, more)
+              << "Parent host is UP, so this one is DOWN.";
+          state = host::state_down;
+          return true;
+        }
+        continue;
+      }
+    }
+    p.parents.insert(parent);
+  }
+
+  if (p.parents.empty()) {
+    logger(dbg_checks, more)
+        << "No parents were UP, so this host is UNREACHABLE.";
+    state = host::state_unreachable;
+    return true;
+  }
+
+  logger(dbg_checks, more) << "Host '" << hst->get_name() << "' waits for "
+                           << p.parents.size() << " parent host check(s).";
+  for (host* parent : p.parents)
+    _waiters[parent].insert(hst);
+  p.finish = std::move(finish);
+  _pending.emplace(hst, std::move(p));
+  return false;
+}
+
+/**
+ *  Finish the resolution of a host.
+ *
+ *  @param[in] hst    The host.
+ *  @param[in] state  Its final state.
+ */
+void reachability::_finish(host* hst, host::host_state state) {
+  auto it(_pending.find(hst));
+  callback finish(std::move(it->second.finish));
+  _remove(it);
+  finish(state);
+}
+
+/**
+ *  Remove a pending resolution.
+ *
+ *  @param[in] it  The resolution.
+ */
+void reachability::_remove(pending_map::iterator it) {
+  host* hst(const_cast<host*>(it->first));
+  for (host* parent : it->second.parents) {
+    auto w(_waiters.find(parent));
+    if (w != _waiters.end()) {
+      w->second.erase(hst);
+      if (w->second.empty())
+        _waiters.erase(w);
+    }
+  }
+  _pending.erase(it);
+}
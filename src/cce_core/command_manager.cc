@@ -36,7 +36,7 @@ using namespace com::centreon::engine::downtimes;
 /**
  *  The default constructor
  */
-command_manager::command_manager() {}
+command_manager::command_manager() : _results_size(0) {}
 
 /**
  * @brief Just an accessor to the command_manager instance.
@@ -53,7 +53,77 @@ void command_manager::enqueue(std::packaged_task<int(void)>&& f) {
   _queue.emplace_back(std::move(f));
 }
 
+/**
+ * @brief Queue a chunk of passive check results. A result without service
+ * description is a host check result. They are handled by execute() in the
+ * main loop. While check_results_max results are already waiting, the
+ * caller is blocked, so that a client cannot fill the memory faster than
+ * the main loop works.
+ *
+ * @param results The check results, at most check_results_chunk of them.
+ *                They are left untouched if not queued.
+ * @param timeout How long to wait for room in the queue.
+ *
+ * @return true if the results are queued, false if the queue stayed full.
+ */
+bool command_manager::enqueue_check_results(
+    std::vector<Check>&& results,
+    std::chrono::milliseconds timeout) {
+  if (results.empty())
+    return true;
+  std::unique_lock<std::mutex> lock(_results_m);
+  if (!_results_cv.wait_for(lock, timeout, [this] {
+        return _results_size < check_results_max;
+      }))
+    return false;
+  _results_size += results.size();
+  _results.emplace_back(std::move(results));
+  return true;
+}
+
+/**
+ * @brief Submit queued passive check results. Whole chunks are taken until
+ * max results are reached, so that the main loop is not stalled by a
+ * client flooding the engine.
+ *
+ * @param max The number of results from which no more chunk is taken.
+ *
+ * @return The number of submitted results.
+ */
+size_t command_manager::process_check_results(size_t max) {
+  std::deque<std::vector<Check>> chunks;
+  {
+    std::lock_guard<std::mutex> lock(_results_m);
+    size_t count = 0;
+    while (!_results.empty() && count < max) {
+      count += _results.front().size();
+      chunks.emplace_back(std::move(_results.front()));
+      _results.pop_front();
+    }
+    _results_size -= count;
+  }
+  _results_cv.notify_all();
+
+  size_t retval = 0;
+  for (std::vector<Check> const& chunk : chunks) {
+    for (Check const& c : chunk) {
+      time_t check_time =
+          google::protobuf::util::TimeUtil::TimestampToSeconds(c.check_time());
+      if (c.svc_desc().empty())
+        process_passive_host_check(check_time, c.host_name(), c.code(),
+                                   c.output());
+      else
+        process_passive_service_check(check_time, c.host_name(), c.svc_desc(),
+                                      c.code(), c.output());
+    }
+    retval += chunk.size();
+  }
+  return retval;
+}
+
 void command_manager::execute() {
+  process_check_results();
+
   std::unique_lock<std::mutex> lock(_queue_m);
   if (_queue.empty())
     return;
@@ -75,8 +145,6 @@ int command_manager::process_passive_service_check(
     const std::string& svc_description,
     uint32_t return_code,
     const std::string& output) {
-  const std::string* real_host_name = nullptr;
-
   /* skip this service check result if we aren't accepting passive service
    * checks */
   if (!config->accept_passive_service_checks())
@@ -87,22 +155,10 @@ int command_manager::process_passive_service_check(
     return ERROR;
 
   /* find the host by its name or address */
-  host_map::const_iterator it(host::hosts.find(host_name));
-  if (it != host::hosts.end() && it->second)
-    real_host_name = &host_name;
-  else {
-    for (host_map::iterator itt(host::hosts.begin()), end(host::hosts.end());
-         itt != end; ++itt) {
-      if (itt->second && itt->second->get_address() == host_name) {
-        real_host_name = &itt->first;
-        it = itt;
-        break;
-      }
-    }
-  }
+  host* hst(find_host_by_name_or_address(host_name));
 
   /* we couldn't find the host */
-  if (real_host_name == nullptr) {
+  if (!hst) {
     logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for service '"
         << svc_description << "' on host '" << host_name
@@ -112,7 +168,7 @@ int command_manager::process_passive_service_check(
 
   /* make sure the service exists */
   service_map::const_iterator found(
-      service::services.find({*real_host_name, svc_description}));
+      service::services.find({hst->get_name(), svc_description}));
   if (found == service::services.end() || !found->second) {
     logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for service '"
@@ -121,8 +177,49 @@ int command_manager::process_passive_service_check(
     return ERROR;
   }
 
+  return _submit_passive_service_check(found->second.get(), check_time,
+                                       return_code, output);
+}
+
+/* submits a passive service check result identified by host and service
+ * ids for later processing */
+int command_manager::process_passive_service_check_by_id(
+    time_t check_time,
+    uint64_t host_id,
+    uint64_t service_id,
+    uint32_t return_code,
+    const std::string& output) {
+  /* skip this service check result if we aren't accepting passive service
+   * checks */
+  if (!config->accept_passive_service_checks())
+    return ERROR;
+
+  /* make sure we have a reasonable return code */
+  if (return_code > 3)
+    return ERROR;
+
+  /* make sure the service exists */
+  service_id_map::const_iterator found(
+      service::services_by_id.find({host_id, service_id}));
+  if (found == service::services_by_id.end() || !found->second) {
+    logger(log_runtime_warning, basic)
+        << "Warning:  Passive check result was received for service ("
+        << host_id << ", " << service_id
+        << "), but the service could not be found!";
+    return ERROR;
+  }
+
+  return _submit_passive_service_check(found->second.get(), check_time,
+                                       return_code, output);
+}
+
+/* submits a passive service check result of a known service */
+int command_manager::_submit_passive_service_check(service* svc,
+                                                   time_t check_time,
+                                                   uint32_t return_code,
+                                                   const std::string& output) {
   /* skip this is we aren't accepting passive checks for this service */
-  if (!found->second->get_accept_passive_checks())
+  if (!svc->get_accept_passive_checks())
     return ERROR;
 
   timeval tv;
@@ -131,8 +228,8 @@ int command_manager::process_passive_service_check(
   timeval set_tv = {.tv_sec = check_time, .tv_usec = 0};
 
   check_result* result =
-      new check_result(service_check, found->second.get(),
-                       checkable::check_passive, CHECK_OPTION_NONE, false,
+      new check_result(service_check, svc, checkable::check_passive,
+                       CHECK_OPTION_NONE, false,
                        static_cast<double>(tv.tv_sec - check_time) +
                            static_cast<double>(tv.tv_usec) / 1000000.0,
                        set_tv, set_tv, false, true, return_code, output);
@@ -153,8 +250,6 @@ int command_manager::process_passive_host_check(time_t check_time,
                                                 const std::string& host_name,
                                                 uint32_t return_code,
                                                 const std::string& output) {
-  const std::string* real_host_name = nullptr;
-
   /* skip this host check result if we aren't accepting passive host checks */
   if (!config->accept_passive_service_checks())
     return ERROR;
@@ -164,22 +259,10 @@ int command_manager::process_passive_host_check(time_t check_time,
     return ERROR;
 
   /* find the host by its name or address */
-  host_map::const_iterator it(host::hosts.find(host_name));
-  if (it != host::hosts.end() && it->second)
-    real_host_name = &host_name;
-  else {
-    for (host_map::iterator itt(host::hosts.begin()), end(host::hosts.end());
-         itt != end; ++itt) {
-      if (itt->second && itt->second->get_address() == host_name) {
-        real_host_name = &itt->first;
-        it = itt;
-        break;
-      }
-    }
-  }
+  host* hst(find_host_by_name_or_address(host_name));
 
   /* we couldn't find the host */
-  if (real_host_name == nullptr) {
+  if (!hst) {
     logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for host '" << host_name
         << "', but the host could not be found!";
@@ -187,7 +270,7 @@ int command_manager::process_passive_host_check(time_t check_time,
   }
 
   /* skip this is we aren't accepting passive checks for this host */
-  if (!it->second->get_accept_passive_checks())
+  if (!hst->get_accept_passive_checks())
     return ERROR;
 
   timeval tv;
@@ -197,7 +280,7 @@ int command_manager::process_passive_host_check(time_t check_time,
   tv_start.tv_usec = 0;
 
   check_result* result =
-      new check_result(host_check, it->second.get(), checkable::check_passive,
+      new check_result(host_check, hst, checkable::check_passive,
                        CHECK_OPTION_NONE, false,
                        static_cast<double>(tv.tv_sec - check_time) +
                            static_cast<double>(tv.tv_usec) / 1000000.0,
@@ -267,10 +350,8 @@ int command_manager::get_stats(std::string const& request, Stats* response) {
     uint32_t high_external_command_buffer_slots = 0;
     // get number f items in the command buffer
     if (config->check_external_commands()) {
-      pthread_mutex_lock(&external_command_buffer.buffer_lock);
-      used_external_command_buffer_slots = external_command_buffer.items;
-      high_external_command_buffer_slots = external_command_buffer.high;
-      pthread_mutex_unlock(&external_command_buffer.buffer_lock);
+      used_external_command_buffer_slots = external_command_buffer.size();
+      high_external_command_buffer_slots = external_command_buffer.high();
     }
     response->mutable_program_status()->set_total_external_command_buffer_slots(
         config->external_command_buffer_slots());
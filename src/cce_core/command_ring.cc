@@ -0,0 +1,112 @@
+/*
+** Copyright 2020 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/command_ring.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  Default constructor. The ring has no slot until resize() is called.
+ */
+command_ring::command_ring()
+    : _capacity{0}, _mask{0}, _head{0}, _high{0}, _tail{0} {}
+
+/**
+ *  Get the maximum number of lines the ring can hold.
+ *
+ *  @return The capacity.
+ */
+size_t command_ring::capacity() const noexcept {
+  return _capacity;
+}
+
+/**
+ *  Drop all the lines. Must not be called while a producer or a consumer
+ *  is running.
+ */
+void command_ring::clear() noexcept {
+  _head.store(0, std::memory_order_relaxed);
+  _tail.store(0, std::memory_order_relaxed);
+  _high.store(0, std::memory_order_relaxed);
+}
+
+/**
+ *  Get the highest number of lines that have been waiting in the ring.
+ *
+ *  @return The high water mark.
+ */
+size_t command_ring::high() const noexcept {
+  return _high.load(std::memory_order_relaxed);
+}
+
+/**
+ *  Append a line to the ring. Only the producer thread can call this
+ *  method.
+ *
+ *  @param[in] line   The line, not necessarily null-terminated.
+ *  @param[in] length Its length.
+ *
+ *  @return false if the ring is full.
+ */
+bool command_ring::push(char const* line, size_t length) {
+  size_t head{_head.load(std::memory_order_relaxed)};
+  size_t used{head - _tail.load(std::memory_order_acquire)};
+  if (used >= _capacity)
+    return false;
+
+  /* The slot keeps its buffer, so assign() only allocates for lines
+   * longer than all the previous ones stored in it. */
+  _slots[head & _mask].assign(line, length);
+  _head.store(head + 1, std::memory_order_release);
+
+  if (used + 1 > _high.load(std::memory_order_relaxed))
+    _high.store(used + 1, std::memory_order_relaxed);
+  return true;
+}
+
+/**
+ *  Allocate the slots of the ring and drop its content. Must not be
+ *  called while a producer or a consumer is running.
+ *
+ *  @param[in] slots Maximum number of lines in the ring.
+ */
+void command_ring::resize(size_t slots) {
+  size_t size{1};
+  while (size < slots)
+    size <<= 1;
+
+  std::vector<std::string> new_slots(size);
+  for (std::string& s : new_slots)
+    s.reserve(slot_size);
+  _slots.swap(new_slots);
+  _capacity = slots;
+  _mask = size - 1;
+  clear();
+}
+
+/**
+ *  Get the number of lines waiting in the ring.
+ *
+ *  @return A number of lines.
+ */
+size_t command_ring::size() const noexcept {
+  /* The tail is read first so that it is never ahead of the head. */
+  size_t tail{_tail.load(std::memory_order_acquire)};
+  return _head.load(std::memory_order_acquire) - tail;
+}
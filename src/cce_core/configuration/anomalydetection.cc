@@ -25,7 +25,6 @@
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/string.hh"
 
-extern int config_warnings;
 extern int config_errors;
 
 using namespace com::centreon;
@@ -1505,7 +1504,7 @@ bool anomalydetection::_set_failure_prediction_enabled(bool value) {
   logger(log_verification_error, basic)
       << "Warning: anomalydetection failure_prediction_enabled is deprecated."
       << " This option will not be supported in 20.04.";
-  ++config_warnings;
+  ++*parse_warnings;
   return true;
 }
 
@@ -1522,7 +1521,7 @@ bool anomalydetection::_set_failure_prediction_options(
   logger(log_verification_error, basic)
       << "Warning: anomalydetection failure_prediction_options is deprecated."
       << " This option will not be supported in 20.04.";
-  ++config_warnings;
+  ++*parse_warnings;
   return true;
 }
 
@@ -1827,7 +1826,7 @@ bool anomalydetection::_set_parallelize_check(bool value) {
   logger(log_verification_error, basic)
       << "Warning: anomalydetection parallelize_check is deprecated"
       << " This option will not be supported in 20.04.";
-  ++config_warnings;
+  ++*parse_warnings;
   return true;
 }
 
@@ -35,6 +35,20 @@ using namespace com::centreon::exceptions;
 using namespace com::centreon::engine;
 using namespace com::centreon::engine::configuration;
 
+/**
+ *  Remove a host from the address index.
+ *
+ *  @param[in] h  Host to remove.
+ */
+static void remove_address(engine::host const& h) {
+  auto range(engine::host::hosts_by_address.equal_range(h.get_address()));
+  for (auto it(range.first); it != range.second; ++it)
+    if (it->second.get() == &h) {
+      engine::host::hosts_by_address.erase(it);
+      break;
+    }
+}
+
 /**
  *  Default constructor.
  */
@@ -125,6 +139,7 @@ void applier::host::add_object(configuration::host const& obj) {
 
   engine::host::hosts.insert({h->get_name(), h});
   engine::host::hosts_by_id.insert({obj.host_id(), h});
+  engine::host::hosts_by_address.insert({h->get_address(), h});
 
   h->set_initial_notif_time(0);
   h->set_should_reschedule_current_check(false);
@@ -275,7 +290,11 @@ void applier::host::modify_object(configuration::host const& obj) {
     it_obj->second->set_alias(obj.alias());
   else
     it_obj->second->set_alias(obj.host_name());
-  it_obj->second->set_address(obj.address());
+  if (it_obj->second->get_address() != obj.address()) {
+    remove_address(*it_obj->second);
+    it_obj->second->set_address(obj.address());
+    engine::host::hosts_by_address.insert({obj.address(), it_obj->second});
+  }
   if (obj.check_period().empty())
     it_obj->second->set_check_period(obj.check_period());
   it_obj->second->set_initial_state(
@@ -520,6 +539,7 @@ void applier::host::remove_object(configuration::host const& obj) {
                               &tv);
 
     // Erase host object (will effectively delete the object).
+    remove_address(*it->second);
     engine::host::hosts.erase(it->second->get_name());
     engine::host::hosts_by_id.erase(it);
   }
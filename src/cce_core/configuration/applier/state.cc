@@ -152,6 +152,7 @@ void applier::state::clear() {
   engine::serviceescalation::serviceescalations.clear();
   engine::host::hosts.clear();
   engine::host::hosts_by_id.clear();
+  engine::host::hosts_by_address.clear();
   engine::hostdependency::hostdependencies.clear();
   engine::hostescalation::hostescalations.clear();
   engine::timeperiod::timeperiods.clear();
@@ -190,6 +191,7 @@ applier::state::~state() throw() {
   engine::serviceescalation::serviceescalations.clear();
   engine::host::hosts.clear();
   engine::host::hosts_by_id.clear();
+  engine::host::hosts_by_address.clear();
   engine::hostdependency::hostdependencies.clear();
   engine::hostescalation::hostescalations.clear();
   engine::timeperiod::timeperiods.clear();
@@ -399,6 +401,7 @@ void applier::state::_apply(configuration::state const& new_cfg) {
   config->retained_host_attribute_mask(new_cfg.retained_host_attribute_mask());
   config->retained_process_host_attribute_mask(
       new_cfg.retained_process_host_attribute_mask());
+  config->retention_binary_format(new_cfg.retention_binary_format());
   config->retention_scheduling_horizon(new_cfg.retention_scheduling_horizon());
   config->retention_update_interval(new_cfg.retention_update_interval());
   config->service_check_timeout(new_cfg.service_check_timeout());
@@ -421,6 +424,7 @@ void applier::state::_apply(configuration::state const& new_cfg) {
   config->soft_state_dependencies(new_cfg.soft_state_dependencies());
   config->state_retention_file(new_cfg.state_retention_file());
   config->status_file(new_cfg.status_file());
+  config->status_snapshot_file(new_cfg.status_snapshot_file());
   config->status_update_interval(new_cfg.status_update_interval());
   config->time_change_threshold(new_cfg.time_change_threshold());
   config->translate_passive_host_checks(
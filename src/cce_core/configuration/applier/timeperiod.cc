@@ -76,6 +76,8 @@ void applier::timeperiod::add_object(configuration::timeperiod const& obj) {
       new engine::timeperiod(obj.timeperiod_name(), obj.alias())};
 
   engine::timeperiod::timeperiods.insert({obj.timeperiod_name(), tp});
+  engine::timeperiod::invalidate_indexes();
+  tp->set_indexed(true);
 
   // Notify event broker.
   timeval tv(get_broker_timestamp(nullptr));
@@ -162,6 +164,10 @@ void applier::timeperiod::modify_object(configuration::timeperiod const& obj) {
     _add_exclusions(obj.exclude(), tp);
   }
 
+  // Cached intervals of this period and of those excluding it are
+  // outdated.
+  engine::timeperiod::invalidate_indexes();
+
   // Notify event broker.
   timeval tv(get_broker_timestamp(nullptr));
   broker_adaptive_timeperiod_data(
@@ -192,6 +198,7 @@ void applier::timeperiod::remove_object(configuration::timeperiod const& obj) {
 
     // Erase time period (will effectively delete the object).
     engine::timeperiod::timeperiods.erase(it);
+    engine::timeperiod::invalidate_indexes();
   }
 
   // Remove time period from the global configuration set.
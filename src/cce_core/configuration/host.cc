@@ -18,13 +18,13 @@
 */
 
 #include "com/centreon/engine/configuration/host.hh"
+#include "com/centreon/engine/configuration/hasher.hh"
 #include "com/centreon/engine/configuration/hostextinfo.hh"
 #include "com/centreon/exceptions/error.hh"
 #include "com/centreon/engine/host.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/string.hh"
 
-extern int config_warnings;
 extern int config_errors;
 
 using namespace com::centreon;
@@ -301,6 +301,33 @@ bool host::operator!=(host const& other) const throw() {
   return !operator==(other);
 }
 
+/**
+ *  Compute the content hash from the properties used by the equality
+ *  operator.
+ *
+ *  @return The hash.
+ */
+uint64_t host::_hash() const {
+  hasher h;
+  _hash_object(h);
+  h << _acknowledgement_timeout << _action_url << _address << _alias
+    << _checks_active << _checks_passive << _check_command << _check_freshness
+    << _check_interval << _check_period << _contactgroups << _contacts
+    << _coords_2d << _coords_3d << _customvariables << _display_name
+    << _event_handler << _event_handler_enabled << _first_notification_delay
+    << _flap_detection_enabled << _flap_detection_options
+    << _freshness_threshold << _high_flap_threshold << _hostgroups << _host_id
+    << _host_name << _icon_image << _icon_image_alt << _initial_state
+    << _low_flap_threshold << _max_check_attempts << _notes << _notes_url
+    << _notifications_enabled << _notification_interval
+    << _notification_options << _notification_period << _obsess_over_host
+    << _parents << _process_perf_data << _retain_nonstatus_information
+    << _retain_status_information << _retry_interval
+    << _recovery_notification_delay << _stalking_options << _statusmap_image
+    << _timezone << _vrml_image;
+  return h.value();
+}
+
 /**
  *  Less-than operator.
  *
@@ -514,6 +541,7 @@ void host::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool host::parse(char const* key, char const* value) {
+  _content_hash = 0;
   std::unordered_map<std::string, host::setter_func>::const_iterator it{
       _setters.find(key)};
   if (it != _setters.end())
@@ -1200,7 +1228,7 @@ bool host::_set_failure_prediction_enabled(bool value) {
   logger(log_verification_error, basic)
       << "Warning: host failure_prediction_enabled is deprecated"
       << " This option will not be supported in 20.04.";
-  ++config_warnings;
+  ++*parse_warnings;
   return true;
 }
 
@@ -1216,7 +1244,7 @@ bool host::_set_failure_prediction_options(std::string const& value) {
   logger(log_verification_error, basic)
       << "Warning: service failure_prediction_options is deprecated"
       << " This option will not be supported in 20.04.";
-  ++config_warnings;
+  ++*parse_warnings;
   return (true);
 }
 
@@ -22,6 +22,7 @@
 #include "com/centreon/engine/configuration/connector.hh"
 #include "com/centreon/engine/configuration/contact.hh"
 #include "com/centreon/engine/configuration/contactgroup.hh"
+#include "com/centreon/engine/configuration/hasher.hh"
 #include "com/centreon/engine/configuration/host.hh"
 #include "com/centreon/engine/configuration/hostdependency.hh"
 #include "com/centreon/engine/configuration/hostescalation.hh"
@@ -41,9 +42,13 @@ using namespace com::centreon;
 using namespace com::centreon::exceptions;
 using namespace com::centreon::engine::configuration;
 
+extern int config_warnings;
+
 #define SETTER(type, method) \
   &object::setter<object, type, &object::method>::generic
 
+thread_local int* object::parse_warnings(&config_warnings);
+
 object::setters const object::_setters[] = {
     {"use", SETTER(std::string const&, _set_templates)},
     {"name", SETTER(std::string const&, _set_name)},
@@ -55,7 +60,10 @@ object::setters const object::_setters[] = {
  *  @param[in] type      The object type.
  */
 object::object(object::object_type type)
-    : _is_resolve(false), _should_register(true), _type(type) {}
+    : _content_hash(0),
+      _is_resolve(false),
+      _should_register(true),
+      _type(type) {}
 
 /**
  *  Copy constructor.
@@ -78,6 +86,7 @@ object::~object() noexcept {}
  */
 object& object::operator=(object const& right) {
   if (this != &right) {
+    _content_hash = right._content_hash;
     _is_resolve = right._is_resolve;
     _name = right._name;
     _should_register = right._should_register;
@@ -186,6 +195,7 @@ bool object::parse(char const* key, char const* value) {
  *  @return True on success, otherwise false.
  */
 bool object::parse(std::string const& line) {
+  _content_hash = 0;
   std::size_t pos(line.find_first_of(" \t\r", 0));
   std::string key;
   std::string value;
@@ -211,6 +221,7 @@ void object::resolve_template(map_object& templates) {
     return;
 
   _is_resolve = true;
+  _content_hash = 0;
   for (std::list<std::string>::const_iterator it(_templates.begin()),
        end(_templates.end());
        it != end;
@@ -223,6 +234,37 @@ void object::resolve_template(map_object& templates) {
   }
 }
 
+/**
+ *  Get the content hash of the object, equal objects having the same
+ *  hash. It is computed once, so it must only be used on objects that
+ *  will not be modified anymore.
+ *
+ *  @return The hash, 0 if the object type does not support it.
+ */
+uint64_t object::content_hash() const {
+  if (!_content_hash)
+    _content_hash = _hash();
+  return _content_hash;
+}
+
+/**
+ *  Compute the content hash. Object types supporting content hashes
+ *  override this method.
+ *
+ *  @return 0.
+ */
+uint64_t object::_hash() const { return 0; }
+
+/**
+ *  Add the properties common to all objects to a content hash.
+ *
+ *  @param[in,out] h The hash to update.
+ */
+void object::_hash_object(hasher& h) const {
+  h << _name << static_cast<int>(_type) << _is_resolve << _should_register
+    << _templates;
+}
+
 /**
  *  Check if object should be registered.
  *
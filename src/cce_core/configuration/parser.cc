@@ -18,7 +18,11 @@
 */
 
 #include "com/centreon/engine/configuration/parser.hh"
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <unordered_map>
 #include "com/centreon/exceptions/error.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/io/directory_entry.hh"
@@ -28,6 +32,8 @@ using namespace com::centreon::exceptions;
 using namespace com::centreon::engine::configuration;
 using namespace com::centreon::io;
 
+extern int config_warnings;
+
 parser::store parser::_store[] = {
     &parser::_store_into_map<command, &command::command_name>,
     &parser::_store_into_map<connector, &connector::connector_name>,
@@ -72,12 +78,14 @@ void parser::parse(std::string const& path, state& config) {
   // parse the global configuration file.
   _parse_global_configuration(path);
 
-  // parse configuration files.
-  _apply(config.cfg_file(), &parser::_parse_object_definitions);
+  // list configuration files.
+  _apply(config.cfg_file(), &parser::_list_object_definitions);
   // parse resource files.
   _apply(config.resource_file(), &parser::_parse_resource_file);
-  // parse configuration directories.
-  _apply(config.cfg_dir(), &parser::_parse_directory_configuration);
+  // list configuration directories.
+  _apply(config.cfg_dir(), &parser::_list_directory_configuration);
+  // parse configuration files.
+  _parse_object_files();
 
   // Apply template.
   _resolve_template();
@@ -241,6 +249,38 @@ void parser::_apply_serviceextinfo() {
   }
 }
 
+/**
+ *  Build the objects of an object file. This method is called by the
+ *  parsing threads and does not modify the parser.
+ *
+ *  @param[in]  file The definitions read from the file.
+ *  @param[out] out  The objects built.
+ */
+void parser::_build_objects(file_definitions const& file,
+                            file_objects& out) const {
+  for (definition const& def : file.definitions) {
+    object_ptr obj(object::create(def.type));
+    if (obj == nullptr)
+      throw engine_error(
+          "Parsing of object definition failed in file '{}' on line {}: "
+          "Unknown object type name '{}'",
+          file.path,
+          def.line,
+          def.type);
+    if (!(_read_options & (1 << obj->type())))
+      continue;
+    for (std::pair<unsigned int, std::string> const& line : def.lines)
+      if (!obj->parse(line.second))
+        throw engine_error(
+            "Parsing of object definition failed in file '{}' on line {}: "
+            "Invalid line '{}'",
+            file.path,
+            line.first,
+            line.second);
+    out.objects.emplace_back(obj, file_info(file.path, def.line));
+  }
+}
+
 /**
  *  Get the file information.
  *
@@ -355,17 +395,29 @@ std::string const& parser::_map_object_type(map_object const& objects) const
 }
 
 /**
- *  Parse the directory configuration.
+ *  Add the object files of a configuration directory to the files to
+ *  parse.
  *
  *  @param[in] path The directory path.
  */
-void parser::_parse_directory_configuration(std::string const& path) {
+void parser::_list_directory_configuration(std::string const& path) {
   directory_entry dir(path);
   std::list<file_entry> const& lst(dir.entry_list("*.cfg"));
   for (std::list<file_entry>::const_iterator it(lst.begin()), end(lst.end());
        it != end;
        ++it)
-    _parse_object_definitions(it->path());
+    _list_object_definitions(it->path());
+}
+
+/**
+ *  Add an object file to the files to parse.
+ *
+ *  @param[in] path The object definitions path.
+ */
+void parser::_list_object_definitions(std::string const& path) {
+  file_definitions file;
+  file.path = path;
+  _files.push_back(std::move(file));
 }
 
 /**
@@ -402,86 +454,114 @@ void parser::_parse_global_configuration(std::string const& path) {
 }
 
 /**
- *  Parse the object definition file.
- *
- *  @param[in] path The object definitions path.
+ *  Parse the object files. Files are read and their objects built by
+ *  several threads, objects are then added in the order of the files.
  */
-void parser::_parse_object_definitions(std::string const& path) {
-  logger(logging::log_info_message, logging::basic)
-      << "Processing object config file '" << path << "'";
+void parser::_parse_object_files() {
+  for (file_definitions const& file : _files)
+    logger(logging::log_info_message, logging::basic)
+        << "Processing object config file '" << file.path << "'";
+
+  std::vector<file_objects> objects(_files.size());
+  std::atomic<size_t> next(0);
+  auto parse_files = [this, &objects, &next]() {
+    int* warnings(object::parse_warnings);
+    for (size_t i; (i = next++) < _files.size();) {
+      object::parse_warnings = &objects[i].warnings;
+      try {
+        _read_definitions(_files[i]);
+        _build_objects(_files[i], objects[i]);
+      }
+      catch (...) {
+        objects[i].error = std::current_exception();
+      }
+    }
+    object::parse_warnings = warnings;
+  };
+  size_t threads_count(std::min<size_t>(
+      std::max(std::thread::hardware_concurrency(), 1u), _files.size()));
+  std::vector<std::thread> threads;
+  for (size_t i(1); i < threads_count; ++i)
+    threads.emplace_back(parse_files);
+  parse_files();
+  for (std::thread& t : threads)
+    t.join();
+
+  for (file_objects& file : objects) {
+    config_warnings += file.warnings;
+    if (file.error) {
+      _files.clear();
+      std::rethrow_exception(file.error);
+    }
+    for (std::pair<object_ptr, file_info>& obj : file.objects) {
+      _objects_info[obj.first.get()] = obj.second;
+      if (!obj.first->name().empty())
+        _add_template(obj.first);
+      if (obj.first->should_register())
+        _add_object(obj.first);
+    }
+  }
 
-  std::ifstream stream(path.c_str(), std::ios::binary);
+  _files.clear();
+}
+
+/**
+ *  Read the object definitions of a file. This method is called by the
+ *  parsing threads.
+ *
+ *  @param[in,out] file The file to read, its definitions are filled.
+ */
+void parser::_read_definitions(file_definitions& file) {
+  std::ifstream stream(file.path.c_str(), std::ios::binary);
   if (!stream.is_open())
     throw engine_error("Parsing of object definition failed: Can't open file '{}'",
-                path);
+                file.path);
 
-  _current_line = 0;
-  _current_path = path;
-
-  bool parse_object(false);
-  object_ptr obj;
+  unsigned int current_line(0);
+  definition* def(nullptr);
   std::string input;
-  while (string::get_next_line(stream, input, _current_line)) {
+  while (string::get_next_line(stream, input, current_line)) {
     // Multi-line.
     while ('\\' == input[input.size() - 1]) {
       input.resize(input.size() - 1);
       std::string addendum;
-      if (!string::get_next_line(stream, addendum, _current_line))
+      if (!string::get_next_line(stream, addendum, current_line))
         break;
       input.append(addendum);
     }
 
     // Check if is a valid object.
-    if (obj == nullptr) {
+    if (def == nullptr) {
       if (input.find("define") || !std::isspace(input[6]))
         throw engine_error(
             "Parsing of object definition failed in file '{}' on line {}: "
             "Unexpected start definition",
-            _current_path,
-            _current_line);
+            file.path,
+            current_line);
       string::trim_left(input.erase(0, 6));
       std::size_t last(input.size() - 1);
       if (input.empty() || input[last] != '{')
         throw engine_error(
             "Parsing of object definition failed in file '{}' on line {}: "
             "Unexpected start definition",
-            _current_path,
-            _current_line);
-      std::string const& type(string::trim_right(input.erase(last)));
-      obj = object::create(type);
-      if (obj == nullptr)
-        throw engine_error(
-            "Parsing of object definition failed in file '{}' on line {}: "
-            "Unknown object type name '{}'",
-            _current_path,
-            _current_line,
-            type);
-      parse_object = (_read_options & (1 << obj->type()));
-      _objects_info[obj.get()] = file_info(path, _current_line);
+            file.path,
+            current_line);
+      file.definitions.emplace_back();
+      def = &file.definitions.back();
+      def->line = current_line;
+      def->type = string::trim_right(input.erase(last));
     }
     // Check if is the not the end of the current object.
-    else if (input != "}") {
-      if (parse_object) {
-        if (!obj->parse(input))
-          throw engine_error(
-              "Parsing of object definition failed in file '{}' on line {}: "
-              "Invalid line '{}'",
-              _current_path,
-              _current_line,
-              input);
-      }
-    }
+    else if (input != "}")
+      def->lines.emplace_back(current_line, input);
     // End of the current object.
-    else {
-      if (parse_object) {
-        if (!obj->name().empty())
-          _add_template(obj);
-        if (obj->should_register())
-          _add_object(obj);
-      }
-      obj.reset();
-    }
+    else
+      def = nullptr;
   }
+
+  // An unterminated object is ignored.
+  if (def)
+    file.definitions.pop_back();
 }
 
 /**
@@ -526,21 +606,17 @@ void parser::_parse_resource_file(std::string const& path) {
 }
 
 /**
- *  Resolve template for register objects.
+ *  Resolve template for register objects. Each object type is handled
+ *  once: its templates then its objects are resolved and checked.
  */
 void parser::_resolve_template() {
-  for (unsigned int i(0); i < sizeof(_templates) / sizeof(_templates[0]); ++i) {
+  for (unsigned int i(0); i < _templates.size(); ++i) {
     map_object& templates(_templates[i]);
-    for (map_object::iterator it(_templates[i].begin()),
-         end(_templates[i].end());
+    for (map_object::iterator it(templates.begin()), end(templates.end());
          it != end;
          ++it)
       it->second->resolve_template(templates);
-  }
 
-  for (unsigned int i(0); i < sizeof(_lst_objects) / sizeof(_lst_objects[0]);
-       ++i) {
-    map_object& templates(_templates[i]);
     for (list_object::iterator it(_lst_objects[i].begin()),
          end(_lst_objects[i].end());
          it != end;
@@ -551,19 +627,13 @@ void parser::_resolve_template() {
       }
       catch (std::exception const& e) {
         auto& file_info = _get_file_info(it->get());
-        // throw engine_error("Configuration parsing failed {}: {}",
-        // _get_file_info(it->get()), e.what());
         throw engine_error("Configuration parsing failed in file {} on line {}: {}",
                     file_info.path(),
                     file_info.line(),
                     e.what());
       }
     }
-  }
 
-  for (unsigned int i(0); i < sizeof(_map_objects) / sizeof(_map_objects[0]);
-       ++i) {
-    map_object& templates(_templates[i]);
     for (map_object::iterator it(_map_objects[i].begin()),
          end(_map_objects[i].end());
          it != end;
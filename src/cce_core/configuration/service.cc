@@ -18,6 +18,7 @@
 */
 
 #include "com/centreon/engine/configuration/service.hh"
+#include "com/centreon/engine/configuration/hasher.hh"
 #include "com/centreon/engine/configuration/serviceextinfo.hh"
 #include "com/centreon/engine/customvariable.hh"
 #include "com/centreon/exceptions/error.hh"
@@ -25,7 +26,6 @@
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/string.hh"
 
-extern int config_warnings;
 extern int config_errors;
 
 using namespace com::centreon;
@@ -548,6 +548,34 @@ bool service::operator!=(service const& other) const throw() {
   return !operator==(other);
 }
 
+/**
+ *  Compute the content hash from the properties used by the equality
+ *  operator.
+ *
+ *  @return The hash.
+ */
+uint64_t service::_hash() const {
+  hasher h;
+  _hash_object(h);
+  h << _acknowledgement_timeout << _action_url << _checks_active
+    << _checks_passive << _check_command << _check_command_is_important
+    << _check_freshness << _check_interval << _check_period << _contactgroups
+    << _contacts << _customvariables << _display_name << _event_handler
+    << _event_handler_enabled
+    << _first_notification_delay << _flap_detection_enabled
+    << _flap_detection_options << _freshness_threshold << _high_flap_threshold
+    << _hostgroups << _hosts << _icon_image << _icon_image_alt
+    << _initial_state << _is_volatile << _low_flap_threshold
+    << _max_check_attempts << _notes << _notes_url << _notifications_enabled
+    << _notification_interval << _notification_options << _notification_period
+    << _obsess_over_service << _process_perf_data
+    << _retain_nonstatus_information << _retain_status_information
+    << _retry_interval << _recovery_notification_delay << _servicegroups
+    << _service_description << _host_id << _service_id << _stalking_options
+    << _timezone;
+  return h.value();
+}
+
 /**
  *  Less-than operator.
  *
@@ -756,6 +784,7 @@ void service::merge(object const& obj) {
  *  @return True on success, otherwise false.
  */
 bool service::parse(char const* key, char const* value) {
+  _content_hash = 0;
   std::unordered_map<std::string, service::setter_func>::const_iterator it{
       _setters.find(key)};
   if (it != _setters.end())
@@ -1452,7 +1481,7 @@ bool service::_set_failure_prediction_enabled(bool value) {
   logger(log_verification_error, basic)
       << "Warning: service failure_prediction_enabled is deprecated."
       << " This option will not be supported in 20.04.";
-  ++config_warnings;
+  ++*parse_warnings;
   return true;
 }
 
@@ -1468,7 +1497,7 @@ bool service::_set_failure_prediction_options(std::string const& value) {
   logger(log_verification_error, basic)
       << "Warning: service failure_prediction_options is deprecated."
       << " This option will not be supported in 20.04.";
-  ++config_warnings;
+  ++*parse_warnings;
   return true;
 }
 
@@ -1785,7 +1814,7 @@ bool service::_set_parallelize_check(bool value) {
   logger(log_verification_error, basic)
       << "Warning: service parallelize_check is deprecated"
       << " This option will not be supported in 20.04.";
-  ++config_warnings;
+  ++*parse_warnings;
   return true;
 }
 
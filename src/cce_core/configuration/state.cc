@@ -189,6 +189,7 @@ std::unordered_map<std::string, state::setter_func> const state::_setters{
     {"retained_service_attribute_mask",
      SETTER(std::string const&, _set_retained_service_attribute_mask)},
     {"retain_state_information", SETTER(bool, retain_state_information)},
+    {"retention_binary_format", SETTER(bool, retention_binary_format)},
     {"retention_scheduling_horizon",
      SETTER(unsigned int, retention_scheduling_horizon)},
     {"retention_update_interval",
@@ -217,6 +218,7 @@ std::unordered_map<std::string, state::setter_func> const state::_setters{
     {"soft_state_dependencies", SETTER(bool, soft_state_dependencies)},
     {"state_retention_file", SETTER(std::string const&, state_retention_file)},
     {"status_file", SETTER(std::string const&, status_file)},
+    {"status_snapshot_file", SETTER(std::string const&, status_snapshot_file)},
     {"status_update_interval", SETTER(unsigned int, status_update_interval)},
     {"temp_file", SETTER(std::string const&, _set_temp_file)},
     {"temp_path", SETTER(std::string const&, _set_temp_path)},
@@ -328,6 +330,7 @@ static unsigned long const default_retained_contact_service_attribute_mask(0L);
 static unsigned long const default_retained_host_attribute_mask(0L);
 static unsigned long const default_retained_process_host_attribute_mask(0L);
 static bool const default_retain_state_information(true);
+static bool const default_retention_binary_format(false);
 static unsigned int const default_retention_scheduling_horizon(900);
 static unsigned int const default_retention_update_interval(60);
 static unsigned int const default_service_check_timeout(60);
@@ -347,6 +350,7 @@ static float const default_sleep_time(0.5);
 static bool const default_soft_state_dependencies(false);
 static std::string const default_state_retention_file(DEFAULT_RETENTION_FILE);
 static std::string const default_status_file(DEFAULT_STATUS_FILE);
+static std::string const default_status_snapshot_file("");
 static unsigned int const default_status_update_interval(60);
 static unsigned int const default_time_change_threshold(900);
 static bool const default_translate_passive_host_checks(false);
@@ -454,6 +458,7 @@ state::state()
       _retained_process_host_attribute_mask(
           default_retained_process_host_attribute_mask),
       _retain_state_information(default_retain_state_information),
+      _retention_binary_format(default_retention_binary_format),
       _retention_scheduling_horizon(default_retention_scheduling_horizon),
       _retention_update_interval(default_retention_update_interval),
       _service_check_timeout(default_service_check_timeout),
@@ -471,6 +476,7 @@ state::state()
       _soft_state_dependencies(default_soft_state_dependencies),
       _state_retention_file(default_state_retention_file),
       _status_file(default_status_file),
+      _status_snapshot_file(default_status_snapshot_file),
       _status_update_interval(default_status_update_interval),
       _time_change_threshold(default_time_change_threshold),
       _translate_passive_host_checks(default_translate_passive_host_checks),
@@ -609,6 +615,7 @@ state& state::operator=(state const& right) {
     _retained_process_host_attribute_mask =
         right._retained_process_host_attribute_mask;
     _retain_state_information = right._retain_state_information;
+    _retention_binary_format = right._retention_binary_format;
     _retention_scheduling_horizon = right._retention_scheduling_horizon;
     _retention_update_interval = right._retention_update_interval;
     _servicedependencies = right._servicedependencies;
@@ -631,6 +638,7 @@ state& state::operator=(state const& right) {
     _soft_state_dependencies = right._soft_state_dependencies;
     _state_retention_file = right._state_retention_file;
     _status_file = right._status_file;
+    _status_snapshot_file = right._status_snapshot_file;
     _status_update_interval = right._status_update_interval;
     _timeperiods = right._timeperiods;
     _time_change_threshold = right._time_change_threshold;
@@ -759,6 +767,7 @@ bool state::operator==(state const& right) const noexcept {
       _retained_process_host_attribute_mask ==
           right._retained_process_host_attribute_mask &&
       _retain_state_information == right._retain_state_information &&
+      _retention_binary_format == right._retention_binary_format &&
       _retention_scheduling_horizon == right._retention_scheduling_horizon &&
       _retention_update_interval == right._retention_update_interval &&
       _servicedependencies == right._servicedependencies &&
@@ -784,6 +793,7 @@ bool state::operator==(state const& right) const noexcept {
       _soft_state_dependencies == right._soft_state_dependencies &&
       _state_retention_file == right._state_retention_file &&
       _status_file == right._status_file &&
+      _status_snapshot_file == right._status_snapshot_file &&
       _status_update_interval == right._status_update_interval &&
       _timeperiods == right._timeperiods &&
       _time_change_threshold == right._time_change_threshold &&
@@ -2764,6 +2774,24 @@ void state::retain_state_information(bool value) {
   _retain_state_information = value;
 }
 
+/**
+ *  Get retention_binary_format value.
+ *
+ *  @return The retention_binary_format value.
+ */
+bool state::retention_binary_format() const noexcept {
+  return _retention_binary_format;
+}
+
+/**
+ *  Set retention_binary_format value.
+ *
+ *  @param[in] value The new retention_binary_format value.
+ */
+void state::retention_binary_format(bool value) {
+  _retention_binary_format = value;
+}
+
 /**
  *  Get retention_scheduling_horizon value.
  *
@@ -3244,6 +3272,30 @@ std::string const& state::status_file() const noexcept { return _status_file; }
  */
 void state::status_file(std::string const& value) { _status_file = value; }
 
+/**
+ *  Get status_snapshot_file value.
+ *
+ *  @return The status_snapshot_file value.
+ */
+std::string const& state::status_snapshot_file() const noexcept {
+  return _status_snapshot_file;
+}
+
+/**
+ *  Set status_snapshot_file value.
+ *
+ *  @param[in] value The new status_snapshot_file value.
+ */
+void state::status_snapshot_file(std::string const& value) {
+  if (value.empty() || value[0] == '/')
+    _status_snapshot_file = value;
+  else {
+    io::file_entry fe(_cfg_main);
+    std::string base_name(fe.directory_name());
+    _status_snapshot_file = base_name + "/" + value;
+  }
+}
+
 /**
  *  Get status_update_interval value.
  *
@@ -20,12 +20,15 @@
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
+#include <algorithm>
 #include "com/centreon/engine/downtimes/host_downtime.hh"
 #include "com/centreon/engine/downtimes/service_downtime.hh"
 #include "com/centreon/exceptions/error.hh"
 #include "com/centreon/engine/events/loop.hh"
 #include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/host.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/service.hh"
 
 using namespace com::centreon::engine;
 using namespace com::centreon::exceptions;
@@ -42,51 +45,42 @@ using namespace com::centreon::engine::logging;
  */
 void downtime_manager::delete_downtime(uint64_t downtime_id) {
   /* find the downtime we should remove */
-  for (auto it = _scheduled_downtimes.begin(), end = _scheduled_downtimes.end();
-       it != end;
-       ++it) {
-    if (it->second->get_downtime_id() == downtime_id) {
-      logger(dbg_downtime, basic)
-        << "delete downtime(id: " << downtime_id << ")";
-      _scheduled_downtimes.erase(it);
-      break;
-    }
+  auto found = _downtimes_by_id.find(downtime_id);
+  if (found != _downtimes_by_id.end()) {
+    logger(dbg_downtime, basic)
+      << "delete downtime(id: " << downtime_id << ")";
+    _erase(found->second.it);
   }
 }
 
 /* unschedules a host or service downtime */
 int downtime_manager::unschedule_downtime(uint64_t downtime_id) {
-  auto found = std::find_if(_scheduled_downtimes.begin(),
-      _scheduled_downtimes.end(),
-      [&downtime_id](std::pair<time_t, std::shared_ptr<downtime>> d) {
-        return downtime_id == d.second->get_downtime_id();
-      });
+  auto found = _downtimes_by_id.find(downtime_id);
 
   logger(dbg_functions, basic) << "unschedule_downtime()";
   logger(dbg_downtime, basic)
     << "unschedule downtime(id: " << downtime_id << ")";
 
   /* find the downtime entry in the list in memory */
-  if (found == _scheduled_downtimes.end())
+  if (found == _downtimes_by_id.end())
     return ERROR;
 
-  if (found->second->unschedule() == ERROR)
+  if (found->second.it->second->unschedule() == ERROR)
     return ERROR;
 
   /* remove scheduled entry from event queue */
   events::loop::instance().remove_downtime(downtime_id);
 
-  /* delete downtime entry */
-  _scheduled_downtimes.erase(found);
+  /* delete downtime entry, unschedule() may have removed it already */
+  found = _downtimes_by_id.find(downtime_id);
+  if (found != _downtimes_by_id.end())
+    _erase(found->second.it);
 
   /* unschedule all downtime entries that were triggered by this one */
   std::list<uint64_t> lst;
-  for (auto it = _scheduled_downtimes.begin(), end = _scheduled_downtimes.end();
-       it != end;
-       ++it) {
-    if (it->second->get_triggered_by() == downtime_id)
-      lst.push_back(it->second->get_downtime_id());
-  }
+  auto range = _downtimes_by_trigger.equal_range(downtime_id);
+  for (auto it = range.first; it != range.second; ++it)
+    lst.push_back(it->second);
 
   for (uint64_t id : lst) {
     logger(dbg_downtime, basic)
@@ -100,17 +94,74 @@ int downtime_manager::unschedule_downtime(uint64_t downtime_id) {
 std::shared_ptr<downtime> downtime_manager::find_downtime(
     downtime::type type,
     uint64_t downtime_id) {
-  for (std::multimap<time_t, std::shared_ptr<downtime> >::iterator
-           it{_scheduled_downtimes.begin()},
-       end{_scheduled_downtimes.end()};
-       it != end;
-       ++it) {
-    if (type != downtime::any_downtime && it->second->get_type() != type)
-      continue;
-    if (it->second->get_downtime_id() == downtime_id)
-      return it->second;
+  auto found = _downtimes_by_id.find(downtime_id);
+  if (found == _downtimes_by_id.end())
+    return nullptr;
+  std::shared_ptr<downtime> const& dt{found->second.it->second};
+  if (type != downtime::any_downtime && dt->get_type() != type)
+    return nullptr;
+  return dt;
+}
+
+/**
+ *  Find downtimes of a host and/or of its services.
+ *
+ *  @param[in] type                 downtime::host_downtime for downtimes of
+ *                                  the host, downtime::service_downtime for
+ *                                  downtimes of its services and
+ *                                  downtime::any_downtime for both.
+ *  @param[in] hostname             Host name.
+ *  @param[in] service_description  If not empty, only service downtimes of
+ *                                  this service are returned.
+ *
+ *  @return Downtimes ordered by start time.
+ */
+std::vector<std::shared_ptr<downtime>> downtime_manager::find_downtimes(
+    downtime::type type,
+    std::string const& hostname,
+    std::string const& service_description) const {
+  std::vector<std::shared_ptr<downtime>> retval;
+
+  host_map::const_iterator hst{host::hosts.find(hostname)};
+  if (hst == host::hosts.end() || !hst->second) {
+    /* Unknown host, its downtimes (if any) are only found by name. */
+    for (auto const& p : _scheduled_downtimes)
+      if (p.second->get_hostname() == hostname &&
+          (type == downtime::any_downtime || p.second->get_type() == type) &&
+          (service_description.empty() ||
+           (p.second->get_type() == downtime::service_downtime &&
+            std::static_pointer_cast<service_downtime>(p.second)
+                    ->get_service_description() == service_description)))
+        retval.push_back(p.second);
+    return retval;
   }
-  return nullptr;
+
+  uint64_t host_id{hst->second->get_host_id()};
+  if (type != downtime::service_downtime && service_description.empty())
+    _append_object_downtimes({host_id, 0}, downtime::host_downtime, hostname,
+                             service_description, retval);
+  if (type != downtime::host_downtime) {
+    if (!service_description.empty()) {
+      uint64_t service_id{get_service_id(hostname, service_description)};
+      if (service_id)
+        _append_object_downtimes({host_id, service_id},
+                                 downtime::service_downtime, hostname,
+                                 service_description, retval);
+    } else {
+      for (auto const& svc : hst->second->services)
+        if (svc.second)
+          _append_object_downtimes(
+              {host_id, svc.second->get_service_id()},
+              downtime::service_downtime, hostname, "", retval);
+    }
+  }
+
+  std::stable_sort(retval.begin(), retval.end(),
+                   [](std::shared_ptr<downtime> const& a,
+                      std::shared_ptr<downtime> const& b) {
+                     return a->get_start_time() < b->get_start_time();
+                   });
+  return retval;
 }
 
 /* checks for flexible (non-fixed) host downtime that should start now */
@@ -221,11 +272,21 @@ downtime_manager::get_scheduled_downtimes() const {
 
 void downtime_manager::clear_scheduled_downtimes() {
   _scheduled_downtimes.clear();
+  _downtimes_by_id.clear();
+  _downtimes_by_object.clear();
+  _downtimes_by_trigger.clear();
 }
 
-void downtime_manager::add_downtime(downtime* dt) noexcept {
-  _scheduled_downtimes.insert(
-      {dt->get_start_time(), std::shared_ptr<downtime>(dt)});
+/**
+ *  Add a downtime. The manager takes ownership of it.
+ *
+ *  @param[in] dt  The downtime.
+ *
+ *  @return False if a downtime with the same ID already exists, dt is
+ *          then deleted.
+ */
+bool downtime_manager::add_downtime(downtime* dt) noexcept {
+  return _insert(std::shared_ptr<downtime>(dt));
 }
 
 int downtime_manager::check_for_expired_downtime() {
@@ -283,37 +344,50 @@ int downtime_manager::
       comment.empty())
     return deleted;
 
-  std::pair<std::multimap<time_t, std::shared_ptr<downtime> >::iterator,
-            std::multimap<time_t, std::shared_ptr<downtime> >::iterator> range;
-
-  if (start_time.first)
-    range = _scheduled_downtimes.equal_range(start_time.second);
-  else
-    range = {_scheduled_downtimes.begin(), _scheduled_downtimes.end()};
-
   std::list<uint64_t> lst;
-  for (auto it = range.first,  end = range.second; it != end; ++it) {
-    if (!comment.empty() && it->second->get_comment() != comment)
-      continue;
-    if (downtime::host_downtime == it->second->get_type()) {
-      /* If service is specified, then do not delete the host downtime. */
-      if (!service_description.empty())
-        continue;
-      if (!hostname.empty() && it->second->get_hostname() != hostname)
+  if (!hostname.empty()) {
+    /* Downtimes of the host and/or of its services, from the object
+     * index. If service is specified, then do not delete the host
+     * downtime. */
+    for (std::shared_ptr<downtime> const& dt :
+         find_downtimes(service_description.empty()
+                            ? downtime::any_downtime
+                            : downtime::service_downtime,
+                        hostname, service_description)) {
+      if (start_time.first && dt->get_start_time() != start_time.second)
         continue;
-    } else if (downtime::service_downtime == it->second->get_type()) {
-      if (!hostname.empty() && it->second->get_hostname() != hostname)
+      if (!comment.empty() && dt->get_comment() != comment)
         continue;
-      if (!service_description.empty()) {
-        service_downtime* svc{
-            dynamic_cast<service_downtime*>(it->second.get())};
+      lst.push_back(dt->get_downtime_id());
+      ++deleted;
+    }
+  } else {
+    std::pair<time_index::iterator, time_index::iterator> range;
+
+    if (start_time.first)
+      range = _scheduled_downtimes.equal_range(start_time.second);
+    else
+      range = {_scheduled_downtimes.begin(), _scheduled_downtimes.end()};
 
-        if (!svc || svc->get_service_description() != service_description)
+    for (auto it = range.first, end = range.second; it != end; ++it) {
+      if (!comment.empty() && it->second->get_comment() != comment)
+        continue;
+      if (downtime::host_downtime == it->second->get_type()) {
+        /* If service is specified, then do not delete the host downtime. */
+        if (!service_description.empty())
           continue;
+      } else if (downtime::service_downtime == it->second->get_type()) {
+        if (!service_description.empty()) {
+          service_downtime* svc{
+              dynamic_cast<service_downtime*>(it->second.get())};
+
+          if (!svc || svc->get_service_description() != service_description)
+            continue;
+        }
       }
+      lst.push_back(it->second->get_downtime_id());
+      ++deleted;
     }
-    lst.push_back(it->second->get_downtime_id());
-    ++deleted;
   }
 
   for (auto id : lst)
@@ -322,10 +396,9 @@ int downtime_manager::
   return deleted;
 }
 
-void downtime_manager::insert_downtime(std::shared_ptr<downtime> dt) {
+bool downtime_manager::insert_downtime(std::shared_ptr<downtime> dt) {
   logger(dbg_functions, basic) << "downtime_manager::insert_downtime()";
-  time_t start{dt->get_start_time()};
-  _scheduled_downtimes.insert({start, dt});
+  return _insert(dt);
 }
 
 /**
@@ -355,7 +428,7 @@ int downtime_manager::xdddefault_validate_downtime_data() {
     /* delete downtimes with invalid host names, invalid service descriptions
      * or that have expired. */
     if (temp_downtime->is_stale())
-      it = _scheduled_downtimes.erase(it);
+      it = _erase(it);
     else
       ++it;
   }
@@ -377,7 +450,7 @@ int downtime_manager::xdddefault_validate_downtime_data() {
 
     /* delete the downtime */
     if (!save)
-      it = _scheduled_downtimes.erase(it);
+      it = _erase(it);
     else
       ++it;
   }
@@ -586,3 +659,106 @@ int downtime_manager::register_downtime(downtime::type type,
 
   return OK;
 }
+
+/**
+ *  Insert a downtime in the time ordered container and in all indexes.
+ *  Downtime IDs are unique, a downtime whose ID already exists is
+ *  rejected.
+ *
+ *  @param[in] dt  The downtime.
+ *
+ *  @return True if the downtime was inserted.
+ */
+bool downtime_manager::_insert(std::shared_ptr<downtime> const& dt) {
+  if (_downtimes_by_id.find(dt->get_downtime_id()) != _downtimes_by_id.end()) {
+    logger(log_runtime_error, basic)
+        << "Error: Could not add downtime (id: " << dt->get_downtime_id()
+        << "): a downtime with the same id already exists";
+    return false;
+  }
+
+  object_key object;
+  if (dt->get_type() == downtime::service_downtime)
+    object = get_host_and_service_id(
+        dt->get_hostname(),
+        std::static_pointer_cast<service_downtime>(dt)
+            ->get_service_description());
+  else
+    object = {get_host_id(dt->get_hostname()), 0};
+
+  time_index::iterator it{
+      _scheduled_downtimes.insert({dt->get_start_time(), dt})};
+  _downtimes_by_id[dt->get_downtime_id()] = {it, object};
+  _downtimes_by_object.insert({object, dt->get_downtime_id()});
+  if (dt->get_triggered_by())
+    _downtimes_by_trigger.insert({dt->get_triggered_by(),
+                                  dt->get_downtime_id()});
+  return true;
+}
+
+/**
+ *  Remove a downtime from the time ordered container and from all
+ *  indexes.
+ *
+ *  @param[in] it  Downtime position in the time ordered container.
+ *
+ *  @return Iterator following the removed downtime.
+ */
+downtime_manager::time_index::iterator downtime_manager::_erase(
+    time_index::iterator it) {
+  uint64_t downtime_id{it->second->get_downtime_id()};
+  auto found = _downtimes_by_id.find(downtime_id);
+  if (found != _downtimes_by_id.end() && found->second.it == it) {
+    auto range = _downtimes_by_object.equal_range(found->second.object);
+    for (auto it_obj = range.first; it_obj != range.second; ++it_obj)
+      if (it_obj->second == downtime_id) {
+        _downtimes_by_object.erase(it_obj);
+        break;
+      }
+    _downtimes_by_id.erase(found);
+  }
+  if (uint64_t triggered_by = it->second->get_triggered_by()) {
+    auto range = _downtimes_by_trigger.equal_range(triggered_by);
+    for (auto it_trg = range.first; it_trg != range.second; ++it_trg)
+      if (it_trg->second == downtime_id) {
+        _downtimes_by_trigger.erase(it_trg);
+        break;
+      }
+  }
+  return _scheduled_downtimes.erase(it);
+}
+
+/**
+ *  Append downtimes of an object found in the object index.
+ *
+ *  @param[in]  object               (host id, service id), service id
+ *                                   being 0 for host downtimes.
+ *  @param[in]  type                 Expected downtime type.
+ *  @param[in]  hostname             Expected host name.
+ *  @param[in]  service_description  Expected service description if not
+ *                                   empty.
+ *  @param[out] downtimes            Found downtimes.
+ */
+void downtime_manager::_append_object_downtimes(
+    object_key const& object,
+    downtime::type type,
+    std::string const& hostname,
+    std::string const& service_description,
+    std::vector<std::shared_ptr<downtime>>& downtimes) const {
+  auto range = _downtimes_by_object.equal_range(object);
+  for (auto it = range.first; it != range.second; ++it) {
+    auto found = _downtimes_by_id.find(it->second);
+    if (found == _downtimes_by_id.end())
+      continue;
+    std::shared_ptr<downtime> const& dt{found->second.it->second};
+
+    /* Objects may have been renamed since the downtime was scheduled. */
+    if (dt->get_type() != type || dt->get_hostname() != hostname)
+      continue;
+    if (!service_description.empty() &&
+        std::static_pointer_cast<service_downtime>(dt)
+                ->get_service_description() != service_description)
+      continue;
+    downtimes.push_back(dt);
+  }
+}
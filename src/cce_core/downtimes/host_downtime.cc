@@ -470,7 +470,9 @@ int host_downtime::handle() {
 }
 
 void host_downtime::schedule() {
-  downtime_manager::instance().add_downtime(this);
+  // A downtime whose id already exists is deleted by the manager.
+  if (!downtime_manager::instance().add_downtime(this))
+    return;
 
   /* send data to event broker */
   broker_downtime_data(NEBTYPE_DOWNTIME_LOAD, NEBFLAG_NONE, NEBATTR_NONE,
@@ -519,7 +519,9 @@ std::string const& service_downtime::get_service_description() const {
 
 void service_downtime::schedule() {
   logger(dbg_functions, basic) << "service_downtime::schedule()";
-  downtime_manager::instance().add_downtime(this);
+  // A downtime whose id already exists is deleted by the manager.
+  if (!downtime_manager::instance().add_downtime(this))
+    return;
 
   /* send data to event broker */
   broker_downtime_data(
@@ -216,8 +216,8 @@ void timed_event::_exec_event_orphan_check() {
 void timed_event::_exec_event_retention_save() {
   logger(dbg_events, basic) << "** Retention Data Save Event";
 
-  // save state retention data.
-  retention::dump::save(config->state_retention_file());
+  // save state retention data, the file is written in the background.
+  retention::dump::save_async(config->state_retention_file());
 }
 
 /**
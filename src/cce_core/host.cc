@@ -39,6 +39,7 @@
 #include "com/centreon/engine/objects.hh"
 #include "com/centreon/engine/sehandlers.hh"
 #include "com/centreon/engine/shared.hh"
+#include "com/centreon/engine/status_snapshot.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/engine/timezone_locker.hh"
@@ -59,6 +60,7 @@ std::array<std::pair<uint32_t, std::string>, 3> const host::tab_host_states{
 
 host_map host::hosts;
 host_id_map host::hosts_by_id;
+host_address_map host::hosts_by_address;
 
 /*
  *  @param[in] name                          Host name.
@@ -1010,6 +1012,24 @@ uint64_t engine::get_host_id(std::string const& name) {
   return found != host::hosts.end() ? found->second->get_host_id() : 0u;
 }
 
+/**
+ *  Find a host by its name, or by its address if no host has this name.
+ *
+ *  @param[in] name  The name or the address of the host.
+ *
+ *  @return  The host or nullptr if not found.
+ */
+host* engine::find_host_by_name_or_address(std::string const& name) {
+  host_map::const_iterator it{host::hosts.find(name)};
+  if (it != host::hosts.end() && it->second)
+    return it->second.get();
+
+  host_address_map::const_iterator found{host::hosts_by_address.find(name)};
+  if (found != host::hosts_by_address.end())
+    return found->second.get();
+  return nullptr;
+}
+
 /**
  *  Schedule acknowledgement expiration.
  *
@@ -2045,6 +2065,8 @@ void host::clear_flap(double percent_change,
 
 /* updates host status info */
 void host::update_status(bool aggregated_dump) {
+  status_snapshot::writer::instance().mark(*this);
+
   /* send data to event broker (non-aggregated dumps only) */
   if (!aggregated_dump)
     broker_host_status(
@@ -2844,18 +2866,15 @@ int host::process_check_result_3x(enum host::host_state new_state,
                                   int use_cached_result,
                                   unsigned long check_timestamp_horizon) {
   com::centreon::engine::host* master_host = nullptr;
-  host* temp_host;
   std::list<host*> check_hostlist;
-  host::host_state parent_state = host::state_up;
   time_t current_time = 0L;
   time_t next_check = 0L;
-  time_t preferred_time = 0L;
-  time_t next_valid_time = 0L;
-  int run_async_check = true;
-  bool has_parent;
 
   logger(dbg_functions, logging::basic) << "process_host_check_result_3x()";
 
+  /* this result supersedes any previous one waiting for parent checks */
+  checks::checker::instance().get_reachability().cancel(this);
+
   logger(dbg_checks, more)
       << "HOST: " << _name << ", ATTEMPT=" << get_current_attempt() << "/"
       << get_max_attempts() << ", CHECK TYPE="
@@ -3047,60 +3066,43 @@ int host::process_check_result_3x(enum host::host_state new_state,
             (unsigned long)(current_time +
                             (get_check_interval() * config->interval_length()));
 
-        /* we need to run SYNCHRONOUS checks of all parent hosts to accurately
-         * determine the state of this host */
-        /* this is extremely inefficient (reminiscent of Nagios 2.x logic), but
-         * there's no other good way around it */
-        /* check all parent hosts to see if we're DOWN or UNREACHABLE */
+        /* we need to check all parent hosts to accurately determine the state
+         * of this host */
+        /* parents are checked asynchronously and in parallel, the state
+         * transition is finished once their results are processed */
         /* only do this for ACTIVE checks, as PASSIVE checks contain a
          * pre-determined state */
         if (get_check_type() == check_active) {
-          has_parent = false;
-
           logger(dbg_checks, more)
-              << "** WARNING: Max attempts = 1, so we have to run serial "
-                 "checks of all parent hosts!";
-
-          for (host_map_unsafe::iterator it{parent_hosts.begin()},
-               end{parent_hosts.end()};
-               it != end;
-               it++) {
-            if (!it->second)
-              continue;
-
-            has_parent = true;
-
-            logger(dbg_checks, more) << "Running serial check parent host '"
-                                     << it->first << "'...";
-
-            /* run an immediate check of the parent host */
-            it->second->run_sync_check_3x(&parent_state,
-                                          check_options,
-                                          use_cached_result,
-                                          check_timestamp_horizon);
-
-            /* bail out as soon as we find one parent host that is UP */
-            if (parent_state == host::state_up) {
-              logger(dbg_checks, more)
-                  << "Parent host is UP, so this one is DOWN.";
-
-              /* set the current state */
-              _current_state = host::state_down;
-              break;
-            }
-          }
-
-          if (!has_parent) {
-            /* host has no parents, so its up */
-            if (parent_hosts.empty()) {
-              logger(dbg_checks, more) << "Host has no parents, so it's DOWN.";
-              _current_state = host::state_down;
-            } else {
-              /* no parents were up, so this host is UNREACHABLE */
-              logger(dbg_checks, more)
-                  << "No parents were UP, so this host is UNREACHABLE.";
-              _current_state = host::state_unreachable;
-            }
+              << "Max attempts = 1, so we have to check all parent hosts!";
+
+          std::string output(old_plugin_output);
+          if (!checks::checker::instance().get_reachability().resolve(
+                  this,
+                  check_options,
+                  use_cached_result,
+                  check_timestamp_horizon,
+                  _current_state,
+                  [this, output, next_check, use_cached_result,
+                   check_timestamp_horizon](host::host_state state) {
+                    _current_state = state;
+                    std::list<host*> children;
+                    for (host_map_unsafe::iterator it{child_hosts.begin()},
+                         end{child_hosts.end()};
+                         it != end; it++)
+                      if (it->second && it->second->get_current_state() !=
+                                            host::state_unreachable)
+                        children.push_back(it->second);
+                    _finish_check_result_3x(output, true, next_check,
+                                            children, use_cached_result,
+                                            check_timestamp_horizon);
+                  })) {
+            /* until parents results arrive, the state is based on their
+             * current states */
+            _current_state = determine_host_reachability();
+            logger(dbg_checks, more)
+                << "Host state pending on parent hosts checks.";
+            return OK;
           }
         }
         /* set the host state for passive checks */
@@ -3249,6 +3251,38 @@ int host::process_check_result_3x(enum host::host_state new_state,
     }
   }
 
+  return _finish_check_result_3x(old_plugin_output,
+                                 reschedule_check,
+                                 next_check,
+                                 check_hostlist,
+                                 use_cached_result,
+                                 check_timestamp_horizon);
+}
+
+/**
+ *  Finish the processing of a host check result once its state is known.
+ *
+ *  @param[in] old_plugin_output        Plugin output of the previous check.
+ *  @param[in] reschedule_check         Reschedule the next check.
+ *  @param[in] next_check               Default next check time.
+ *  @param[in] check_hostlist           Hosts to check asynchronously.
+ *  @param[in] use_cached_result        Use recent states of these hosts.
+ *  @param[in] check_timestamp_horizon  How recent a state must be.
+ *
+ *  @return OK.
+ */
+int host::_finish_check_result_3x(std::string const& old_plugin_output,
+                                  int reschedule_check,
+                                  time_t next_check,
+                                  std::list<host*> const& check_hostlist,
+                                  int use_cached_result,
+                                  unsigned long check_timestamp_horizon) {
+  time_t current_time = std::time(nullptr);
+  time_t preferred_time = 0L;
+  time_t next_valid_time = 0L;
+  int run_async_check = true;
+  host* temp_host;
+
   logger(dbg_checks, more) << "Pre-handle_host_state() Host: " << _name
                            << ", Attempt=" << get_current_attempt() << "/"
                            << get_max_attempts() << ", Type="
@@ -3330,10 +3364,13 @@ int host::process_check_result_3x(enum host::host_state new_state,
    * (non-scheduled) hosts */
   update_status(false);
 
+  /* children waiting for this host to know their own state */
+  checks::checker::instance().get_reachability().notify(this);
+
   /* run async checks of all hosts we added above */
   /* don't run a check if one is already executing or we can get by with a
    * cached state */
-  for (std::list<host*>::iterator it{check_hostlist.begin()},
+  for (std::list<host*>::const_iterator it{check_hostlist.begin()},
        end{check_hostlist.end()};
        it != end;
        ++it) {
@@ -22,8 +22,10 @@
 #include "com/centreon/engine/downtimes/host_downtime.hh"
 #include "com/centreon/engine/downtimes/service_downtime.hh"
 #include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/logging/logger.hh"
 
 using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
 using namespace com::centreon::engine::retention;
 
 /**
@@ -50,6 +52,14 @@ void applier::downtime::apply(list_downtime const& lst) {
  */
 void applier::downtime::_add_host_downtime(
     retention::downtime const& obj) throw() {
+  // Duplicate ids are rejected, the existing downtime is kept as is.
+  if (downtimes::downtime_manager::instance().find_downtime(
+          downtimes::downtime::any_downtime, obj.downtime_id())) {
+    logger(log_runtime_error, basic)
+        << "Error: Could not add downtime (id: " << obj.downtime_id()
+        << "): a downtime with the same id already exists";
+    return;
+  }
   downtimes::host_downtime* dt{new downtimes::host_downtime(
       obj.host_name(), obj.entry_time(), obj.author(), obj.comment_data(),
       obj.start_time(), obj.end_time(), obj.fixed(), obj.triggered_by(),
@@ -66,6 +76,14 @@ void applier::downtime::_add_host_downtime(
  */
 void applier::downtime::_add_service_downtime(
     retention::downtime const& obj) throw() {
+  // Duplicate ids are rejected, the existing downtime is kept as is.
+  if (downtimes::downtime_manager::instance().find_downtime(
+          downtimes::downtime::any_downtime, obj.downtime_id())) {
+    logger(log_runtime_error, basic)
+        << "Error: Could not add downtime (id: " << obj.downtime_id()
+        << "): a downtime with the same id already exists";
+    return;
+  }
   downtimes::service_downtime* dt{new downtimes::service_downtime(
       obj.host_name(), obj.service_description(), obj.entry_time(),
       obj.author(), obj.comment_data(), obj.start_time(), obj.end_time(),
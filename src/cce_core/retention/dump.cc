@@ -19,10 +19,19 @@
 
 #include "com/centreon/engine/retention/dump.hh"
 
-#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <future>
 #include <iomanip>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/command_manager.hh"
 #include "com/centreon/engine/comment.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/downtimes/downtime.hh"
@@ -32,6 +41,7 @@
 #include "com/centreon/exceptions/error.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/string.hh"
 
 using namespace com::centreon::exceptions;
 using namespace com::centreon::engine;
@@ -40,6 +50,759 @@ using namespace com::centreon::engine::downtimes;
 using namespace com::centreon::engine::logging;
 using namespace com::centreon::engine::retention;
 
+namespace {
+/**
+ *  Retained attributes of a custom variable.
+ */
+struct customvariable_state {
+  std::string name;
+  bool modified;
+  std::string value;
+};
+
+/**
+ *  Retained attributes shared by hosts and services. They are copied
+ *  from the event loop so that the retention file can be written by
+ *  another thread.
+ */
+struct notifier_state {
+  notifier_state(notifier const& obj);
+
+  int acknowledgement_type;
+  bool checks_enabled;
+  std::string check_command;
+  double execution_time;
+  double latency;
+  int check_options;
+  std::string check_period;
+  int check_type;
+  int current_attempt;
+  unsigned long current_event_id;
+  uint64_t current_notification_id;
+  int notification_number;
+  unsigned long current_problem_id;
+  std::string event_handler;
+  bool event_handler_enabled;
+  bool flap_detection_enabled;
+  bool has_been_checked;
+  bool is_flapping;
+  time_t last_acknowledgement;
+  unsigned long last_check;
+  unsigned long last_event_id;
+  unsigned long last_hard_state_change;
+  unsigned long last_notification;
+  unsigned long last_problem_id;
+  unsigned long last_state_change;
+  std::string long_plugin_output;
+  int max_attempts;
+  unsigned long modified_attributes;
+  unsigned long next_check;
+  uint32_t check_interval;
+  std::string notification_period;
+  bool notifications_enabled;
+  bool obsess_over;
+  bool accept_passive_checks;
+  double percent_state_change;
+  std::string perf_data;
+  std::string plugin_output;
+  bool problem_has_been_acknowledged;
+  int state_type;
+  std::array<int, MAX_STATE_HISTORY_ENTRIES> state_history;
+  std::string notifications;
+  std::vector<customvariable_state> custom_variables;
+};
+
+/**
+ *  Retained attributes of a host.
+ */
+struct host_state : notifier_state {
+  host_state(com::centreon::engine::host const& obj);
+
+  std::string name;
+  uint64_t host_id;
+  int current_state;
+  int last_hard_state;
+  int last_state;
+  unsigned long last_time_down;
+  unsigned long last_time_unreachable;
+  unsigned long last_time_up;
+  bool notified_on_down;
+  bool notified_on_unreachable;
+  bool process_performance_data;
+};
+
+/**
+ *  Retained attributes of a service.
+ */
+struct service_state : notifier_state {
+  service_state(com::centreon::engine::service const& obj);
+
+  std::string hostname;
+  std::string description;
+  uint64_t host_id;
+  uint64_t service_id;
+  bool check_flapping_recovery_notification;
+  int current_state;
+  int last_hard_state;
+  int last_state;
+  unsigned long last_time_critical;
+  unsigned long last_time_ok;
+  unsigned long last_time_unknown;
+  unsigned long last_time_warning;
+  bool notified_on_critical;
+  bool notified_on_unknown;
+  bool notified_on_warning;
+  int process_performance_data;
+  double retry_interval;
+};
+
+/**
+ *  Retention data taken from the event loop. Objects that are not
+ *  numerous are directly dumped in text.
+ */
+struct snapshot {
+  std::string head;
+  std::vector<host_state> hosts;
+  std::vector<service_state> services;
+  std::string tail;
+};
+
+/**
+ *  Convert text retention objects to the binary format. Type names and
+ *  keys are stored once in a dictionary and then referenced by index.
+ */
+class binary_writer {
+ public:
+  binary_writer() : _in_object(false) {}
+  void write(std::string const& text, std::string& out);
+
+ private:
+  void _id(std::string const& name, std::string& out);
+  static void _uint32(uint32_t value, std::string& out);
+
+  std::unordered_map<std::string, uint32_t> _dictionary;
+  bool _in_object;
+};
+
+// Retention save running in the background.
+std::future<bool> pending_save;
+// Identifier of the last background save.
+uint64_t pending_save_id(0);
+// True once the end of the last background save is sent to the broker.
+bool pending_save_ended(true);
+
+/**
+ *  Send the end of a background save to the event broker, once and only
+ *  if it is still the last save. Called from the main loop.
+ *
+ *  @param[in] id  The save identifier.
+ */
+void end_pending_save(uint64_t id) {
+  if (id == pending_save_id && !pending_save_ended) {
+    pending_save_ended = true;
+    broker_retention_data(
+        NEBTYPE_RETENTIONDATA_ENDSAVE, NEBFLAG_NONE, NEBATTR_NONE, NULL);
+  }
+}
+
+/**
+ *  Copy the retained attributes shared by hosts and services.
+ *
+ *  @param[in] obj  The host or the service.
+ */
+notifier_state::notifier_state(notifier const& obj)
+    : acknowledgement_type(obj.get_acknowledgement_type()),
+      checks_enabled(obj.get_checks_enabled()),
+      check_command(obj.get_check_command()),
+      execution_time(obj.get_execution_time()),
+      latency(obj.get_latency()),
+      check_options(obj.get_check_options()),
+      check_period(obj.get_check_period()),
+      check_type(obj.get_check_type()),
+      current_attempt(obj.get_current_attempt()),
+      current_event_id(obj.get_current_event_id()),
+      current_notification_id(obj.get_current_notification_id()),
+      notification_number(obj.get_notification_number()),
+      current_problem_id(obj.get_current_problem_id()),
+      event_handler(obj.get_event_handler()),
+      event_handler_enabled(obj.get_event_handler_enabled()),
+      flap_detection_enabled(obj.get_flap_detection_enabled()),
+      has_been_checked(obj.has_been_checked()),
+      is_flapping(obj.get_is_flapping()),
+      last_acknowledgement(obj.get_last_acknowledgement()),
+      last_check(static_cast<unsigned long>(obj.get_last_check())),
+      last_event_id(obj.get_last_event_id()),
+      last_hard_state_change(
+          static_cast<unsigned long>(obj.get_last_hard_state_change())),
+      last_notification(
+          static_cast<unsigned long>(obj.get_last_notification())),
+      last_problem_id(obj.get_last_problem_id()),
+      last_state_change(
+          static_cast<unsigned long>(obj.get_last_state_change())),
+      long_plugin_output(obj.get_long_plugin_output()),
+      max_attempts(obj.get_max_attempts()),
+      modified_attributes(obj.get_modified_attributes() &
+                          ~config->retained_host_attribute_mask()),
+      next_check(static_cast<unsigned long>(obj.get_next_check())),
+      check_interval(obj.get_check_interval()),
+      notification_period(obj.get_notification_period()),
+      notifications_enabled(obj.get_notifications_enabled()),
+      obsess_over(obj.get_obsess_over()),
+      accept_passive_checks(obj.get_accept_passive_checks()),
+      percent_state_change(obj.get_percent_state_change()),
+      perf_data(obj.get_perf_data()),
+      plugin_output(obj.get_plugin_output()),
+      problem_has_been_acknowledged(obj.get_problem_has_been_acknowledged()),
+      state_type(obj.get_state_type()) {
+  // State history is stored from the oldest entry.
+  for (unsigned int x(0); x < MAX_STATE_HISTORY_ENTRIES; ++x)
+    state_history[x] =
+        obj.get_state_history()
+            [(x + obj.get_state_history_index()) % MAX_STATE_HISTORY_ENTRIES];
+
+  // Notifications are rare, they are directly dumped.
+  for (std::shared_ptr<notification> const& n : obj.get_current_notifications())
+    if (n) {
+      std::ostringstream oss;
+      dump::notifications(oss, obj.get_current_notifications());
+      notifications = oss.str();
+      break;
+    }
+
+  custom_variables.reserve(obj.custom_variables.size());
+  for (auto const& cv : obj.custom_variables)
+    custom_variables.push_back(
+        {cv.first, cv.second.has_been_modified(), cv.second.get_value()});
+}
+
+/**
+ *  Copy the retained attributes of a host.
+ *
+ *  @param[in] obj  The host.
+ */
+host_state::host_state(com::centreon::engine::host const& obj)
+    : notifier_state(obj),
+      name(obj.get_name()),
+      host_id(obj.get_host_id()),
+      current_state(obj.get_current_state()),
+      last_hard_state(obj.get_last_hard_state()),
+      last_state(obj.get_last_state()),
+      last_time_down(static_cast<unsigned long>(obj.get_last_time_down())),
+      last_time_unreachable(
+          static_cast<unsigned long>(obj.get_last_time_unreachable())),
+      last_time_up(static_cast<unsigned long>(obj.get_last_time_up())),
+      notified_on_down(obj.get_notified_on(notifier::down)),
+      notified_on_unreachable(obj.get_notified_on(notifier::unreachable)),
+      process_performance_data(obj.get_process_performance_data()) {}
+
+/**
+ *  Copy the retained attributes of a service.
+ *
+ *  @param[in] obj  The service.
+ */
+service_state::service_state(com::centreon::engine::service const& obj)
+    : notifier_state(obj),
+      hostname(obj.get_hostname()),
+      description(obj.get_description()),
+      check_flapping_recovery_notification(
+          obj.get_check_flapping_recovery_notification()),
+      current_state(obj.get_current_state()),
+      last_hard_state(obj.get_last_hard_state()),
+      last_state(obj.get_last_state()),
+      last_time_critical(
+          static_cast<unsigned long>(obj.get_last_time_critical())),
+      last_time_ok(static_cast<unsigned long>(obj.get_last_time_ok())),
+      last_time_unknown(
+          static_cast<unsigned long>(obj.get_last_time_unknown())),
+      last_time_warning(
+          static_cast<unsigned long>(obj.get_last_time_warning())),
+      notified_on_critical(obj.get_notified_on(notifier::critical)),
+      notified_on_unknown(obj.get_notified_on(notifier::unknown)),
+      notified_on_warning(obj.get_notified_on(notifier::warning)),
+      process_performance_data(obj.get_process_performance_data()),
+      retry_interval(obj.get_retry_interval()) {
+  std::string host_name;
+  if (obj.get_host_ptr())
+    host_name = obj.get_host_ptr()->get_name();
+  com::centreon::engine::service const* svc(
+      com::centreon::engine::service::services[{host_name,
+                                                 obj.get_description()}]
+          .get());
+  host_id = svc->get_host_id();
+  service_id = svc->get_service_id();
+}
+
+/**
+ *  Dump custom variables.
+ *
+ *  @param[out] os  The output stream.
+ *  @param[in]  obj The custom variables to dump.
+ */
+void dump_customvariables(std::ostream& os,
+                          std::vector<customvariable_state> const& obj) {
+  for (customvariable_state const& cv : obj)
+    os << "_" << cv.name << "=" << cv.modified << "," << cv.value << "\n";
+}
+
+/**
+ *  Dump the retained attributes of a host.
+ *
+ *  @param[out] os  The output stream.
+ *  @param[in]  obj The host retained attributes.
+ */
+void dump_host(std::ostream& os, host_state const& obj) {
+  os << "host {\n"
+        "host_name=" << obj.name << "\n"
+                                    "host_id=" << obj.host_id
+     << "\n"
+        "acknowledgement_type=" << obj.acknowledgement_type
+     << "\n"
+        "active_checks_enabled=" << obj.checks_enabled
+     << "\n"
+        "check_command=" << obj.check_command
+     << "\n"
+        "check_execution_time=" << std::setprecision(3) << std::fixed
+     << obj.execution_time << "\n"
+                              "check_latency=" << std::setprecision(3)
+     << std::fixed << obj.latency
+     << "\n"
+        "check_options=" << obj.check_options
+     << "\n"
+        "check_period=" << obj.check_period
+     << "\n"
+        "check_type=" << obj.check_type
+     << "\n"
+        "current_attempt=" << obj.current_attempt
+     << "\n"
+        "current_event_id=" << obj.current_event_id
+     << "\n"
+        "current_notification_id=" << obj.current_notification_id
+     << "\n"
+        "current_notification_number=" << obj.notification_number
+     << "\n"
+        "current_problem_id=" << obj.current_problem_id
+     << "\n"
+        "current_state=" << obj.current_state
+     << "\n"
+        "event_handler=" << obj.event_handler
+     << "\n"
+        "event_handler_enabled=" << obj.event_handler_enabled
+     << "\n"
+        "flap_detection_enabled=" << obj.flap_detection_enabled
+     << "\n"
+        "has_been_checked=" << obj.has_been_checked
+     << "\n"
+        "is_flapping=" << obj.is_flapping
+     << "\n"
+        "last_acknowledgement=" << obj.last_acknowledgement
+     << "\n"
+        "last_check=" << obj.last_check
+     << "\n"
+        "last_event_id=" << obj.last_event_id
+     << "\n"
+        "last_hard_state=" << obj.last_hard_state
+     << "\n"
+        "last_hard_state_change=" << obj.last_hard_state_change
+     << "\n"
+        "last_notification=" << obj.last_notification
+     << "\n"
+        "last_problem_id=" << obj.last_problem_id
+     << "\n"
+        "last_state=" << obj.last_state
+     << "\n"
+        "last_state_change=" << obj.last_state_change
+     << "\n"
+        "last_time_down=" << obj.last_time_down
+     << "\n"
+        "last_time_unreachable=" << obj.last_time_unreachable
+     << "\n"
+        "last_time_up=" << obj.last_time_up
+     << "\n"
+        "long_plugin_output=" << obj.long_plugin_output
+     << "\n"
+        "max_attempts=" << obj.max_attempts
+     << "\n"
+        "modified_attributes=" << obj.modified_attributes
+     << "\n"
+        "next_check=" << obj.next_check
+     << "\n"
+        "normal_check_interval=" << obj.check_interval
+     << "\n"
+        "notification_period=" << obj.notification_period
+     << "\n"
+        "notifications_enabled=" << obj.notifications_enabled
+     << "\n"
+        "notified_on_down=" << obj.notified_on_down
+     << "\n"
+        "notified_on_unreachable=" << obj.notified_on_unreachable
+     << "\n"
+        "obsess_over_host=" << obj.obsess_over
+     << "\n"
+        "passive_checks_enabled=" << obj.accept_passive_checks
+     << "\n"
+        "percent_state_change=" << std::setprecision(2) << std::fixed
+     << obj.percent_state_change
+     << "\n"
+        "performance_data=" << obj.perf_data
+     << "\n"
+        "plugin_output=" << obj.plugin_output
+     << "\n"
+        "problem_has_been_acknowledged=" << obj.problem_has_been_acknowledged
+     << "\n"
+        "process_performance_data=" << obj.process_performance_data
+     << "\n"
+        "retry_check_interval=" << obj.check_interval
+     << "\n"
+        "state_type=" << obj.state_type << "\n";
+
+  os << "state_history=";
+  for (unsigned int x(0); x < MAX_STATE_HISTORY_ENTRIES; ++x)
+    os << (x > 0 ? "," : "") << obj.state_history[x];
+  os << "\n";
+
+  os << obj.notifications;
+  dump_customvariables(os, obj.custom_variables);
+  os << "}\n";
+}
+
+/**
+ *  Dump the retained attributes of a service.
+ *
+ *  @param[out] os  The output stream.
+ *  @param[in]  obj The service retained attributes.
+ */
+void dump_service(std::ostream& os, service_state const& obj) {
+  os << "service {\n"
+        "host_name=" << obj.hostname
+     << "\n"
+        "service_description=" << obj.description
+     << "\n"
+        "host_id=" << obj.host_id
+     << "\n"
+        "service_id=" << obj.service_id
+     << "\n"
+        "acknowledgement_type=" << obj.acknowledgement_type
+     << "\n"
+        "active_checks_enabled=" << obj.checks_enabled
+     << "\n"
+        "check_command=" << obj.check_command
+     << "\n"
+        "check_execution_time=" << std::setprecision(3) << std::fixed
+     << obj.execution_time << "\n"
+                              "check_flapping_recovery_notification="
+     << obj.check_flapping_recovery_notification
+     << "\n"
+        "check_latency=" << std::setprecision(3) << std::fixed << obj.latency
+     << "\n"
+        "check_options=" << obj.check_options
+     << "\n"
+        "check_period=" << obj.check_period
+     << "\n"
+        "check_type=" << obj.check_type
+     << "\n"
+        "current_attempt=" << obj.current_attempt
+     << "\n"
+        "current_event_id=" << obj.current_event_id
+     << "\n"
+        "current_notification_id=" << obj.current_notification_id
+     << "\n"
+        "current_notification_number=" << obj.notification_number
+     << "\n"
+        "current_problem_id=" << obj.current_problem_id
+     << "\n"
+        "current_state=" << obj.current_state
+     << "\n"
+        "event_handler=" << obj.event_handler
+     << "\n"
+        "event_handler_enabled=" << obj.event_handler_enabled
+     << "\n"
+        "flap_detection_enabled=" << obj.flap_detection_enabled
+     << "\n"
+        "has_been_checked=" << obj.has_been_checked
+     << "\n"
+        "is_flapping=" << obj.is_flapping
+     << "\n"
+        "last_acknowledgement=" << obj.last_acknowledgement
+     << "\n"
+        "last_check=" << obj.last_check
+     << "\n"
+        "last_event_id=" << obj.last_event_id
+     << "\n"
+        "last_hard_state=" << obj.last_hard_state
+     << "\n"
+        "last_hard_state_change=" << obj.last_hard_state_change
+     << "\n"
+        "last_notification=" << obj.last_notification
+     << "\n"
+        "last_problem_id=" << obj.last_problem_id
+     << "\n"
+        "last_state=" << obj.last_state
+     << "\n"
+        "last_state_change=" << obj.last_state_change
+     << "\n"
+        "last_time_critical=" << obj.last_time_critical
+     << "\n"
+        "last_time_ok=" << obj.last_time_ok
+     << "\n"
+        "last_time_unknown=" << obj.last_time_unknown
+     << "\n"
+        "last_time_warning=" << obj.last_time_warning
+     << "\n"
+        "long_plugin_output=" << obj.long_plugin_output
+     << "\n"
+        "max_attempts=" << obj.max_attempts
+     << "\n"
+        "modified_attributes=" << obj.modified_attributes
+     << "\n"
+        "next_check=" << obj.next_check
+     << "\n"
+        "normal_check_interval=" << obj.check_interval
+     << "\n"
+        "notification_period=" << obj.notification_period
+     << "\n"
+        "notifications_enabled=" << obj.notifications_enabled
+     << "\n"
+        "notified_on_critical=" << obj.notified_on_critical
+     << "\n"
+        "notified_on_unknown=" << obj.notified_on_unknown
+     << "\n"
+        "notified_on_warning=" << obj.notified_on_warning
+     << "\n"
+        "obsess_over_service=" << obj.obsess_over
+     << "\n"
+        "passive_checks_enabled=" << obj.accept_passive_checks
+     << "\n"
+        "percent_state_change=" << std::setprecision(2) << std::fixed
+     << obj.percent_state_change
+     << "\n"
+        "performance_data=" << obj.perf_data
+     << "\n"
+        "plugin_output=" << obj.plugin_output
+     << "\n"
+        "problem_has_been_acknowledged=" << obj.problem_has_been_acknowledged
+     << "\n"
+        "process_performance_data=" << obj.process_performance_data
+     << "\n"
+        "retry_check_interval=" << obj.retry_interval
+     << "\n"
+        "state_type=" << obj.state_type << "\n";
+
+  os << "state_history=";
+  for (unsigned int x(0); x < MAX_STATE_HISTORY_ENTRIES; ++x)
+    os << (x > 0 ? "," : "") << obj.state_history[x];
+  os << "\n";
+
+  os << obj.notifications;
+  dump_customvariables(os, obj.custom_variables);
+  os << "}\n";
+}
+
+/**
+ *  Convert text retention objects and append them to a buffer. Lines
+ *  are interpreted like the text parser does.
+ *
+ *  @param[in]  text  Text retention objects.
+ *  @param[out] out   The buffer to fill.
+ */
+void binary_writer::write(std::string const& text, std::string& out) {
+  std::string line;
+  std::string key;
+  std::string value;
+  size_t pos(0);
+  while (pos < text.size()) {
+    size_t end(text.find('\n', pos));
+    if (end == std::string::npos)
+      end = text.size();
+    line.assign(text, pos, end - pos);
+    pos = end + 1;
+
+    size_t first(line.find_first_not_of(" \t"));
+    if (first == std::string::npos || line[first] == '#')
+      continue;
+    line.erase(line.find_last_not_of(" \t") + 1);
+    line.erase(0, first);
+
+    if (!_in_object) {
+      size_t space(line.find_first_of(" \t"));
+      if (space == std::string::npos)
+        continue;
+      _id(line.substr(0, space), out);
+      _in_object = true;
+    } else if (line != "}") {
+      if (string::split(line, key, value, '=') && !key.empty()) {
+        _id(key, out);
+        _uint32(value.size(), out);
+        out.append(value);
+      }
+    } else {
+      _uint32(dump::binary_end, out);
+      _in_object = false;
+    }
+  }
+}
+
+/**
+ *  Append the identifier of a type name or a key. Unknown names are
+ *  added to the dictionary and stored after their identifier.
+ *
+ *  @param[in]  name  The type name or the key.
+ *  @param[out] out   The buffer to fill.
+ */
+void binary_writer::_id(std::string const& name, std::string& out) {
+  auto it(_dictionary.find(name));
+  if (it != _dictionary.end())
+    _uint32(it->second, out);
+  else {
+    uint32_t id(_dictionary.size());
+    _dictionary.emplace(name, id);
+    _uint32(id, out);
+    _uint32(name.size(), out);
+    out.append(name);
+  }
+}
+
+/**
+ *  Append an integer in host byte order.
+ *
+ *  @param[in]  value  The integer.
+ *  @param[out] out    The buffer to fill.
+ */
+void binary_writer::_uint32(uint32_t value, std::string& out) {
+  out.append(reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+/**
+ *  Write a whole buffer to a file descriptor.
+ *
+ *  @param[in]     fd    The file descriptor.
+ *  @param[in,out] data  The data to write, cleared on success.
+ */
+void write_all(int fd, std::string& data) {
+  char const* p(data.data());
+  size_t size(data.size());
+  while (size) {
+    ssize_t wb(::write(fd, p, size));
+    if (wb < 0) {
+      if (errno == EINTR)
+        continue;
+      char const* msg(strerror(errno));
+      throw engine_error("Cannot write retention data: {}", msg);
+    }
+    p += wb;
+    size -= wb;
+  }
+  data.clear();
+}
+
+/**
+ *  Take a snapshot of the retention data. Must be called from the event
+ *  loop.
+ *
+ *  @param[out] snap  The snapshot to fill.
+ */
+void take_snapshot(snapshot& snap) {
+  std::ostringstream head;
+  dump::info(head);
+  dump::program(head);
+  snap.head = head.str();
+
+  snap.hosts.reserve(com::centreon::engine::host::hosts.size());
+  for (auto const& h : com::centreon::engine::host::hosts)
+    snap.hosts.emplace_back(*h.second);
+  snap.services.reserve(com::centreon::engine::service::services.size());
+  for (auto const& s : com::centreon::engine::service::services)
+    snap.services.emplace_back(*s.second);
+
+  std::ostringstream tail;
+  dump::contacts(tail);
+  dump::comments(tail);
+  dump::downtimes(tail);
+  snap.tail = tail.str();
+}
+
+/**
+ *  Write a snapshot in a temporary file, flush it to disk and rename it
+ *  to the retention file so that the retention file is always complete.
+ *
+ *  @param[in] snap    The snapshot.
+ *  @param[in] path    The retention file path.
+ *  @param[in] binary  Use the binary format.
+ *
+ *  @return True on success, otherwise false.
+ */
+bool write_snapshot(snapshot const& snap,
+                    std::string const& path,
+                    bool binary) {
+  std::string tmp(path + ".tmp");
+  int fd(-1);
+  try {
+    fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      char const* msg(strerror(errno));
+      throw engine_error("Cannot open retention file '{}': {}", tmp, msg);
+    }
+
+    binary_writer writer;
+    std::string buffer;
+    std::ostringstream oss;
+    auto append = [&](std::string const& text) {
+      if (binary)
+        writer.write(text, buffer);
+      else
+        buffer.append(text);
+      if (buffer.size() >= 1024 * 1024)
+        write_all(fd, buffer);
+    };
+    auto flush_object = [&]() {
+      append(oss.str());
+      oss.str("");
+    };
+
+    if (binary)
+      buffer.append(dump::binary_magic, sizeof(dump::binary_magic) - 1);
+    else {
+      dump::header(oss);
+      flush_object();
+    }
+    append(snap.head);
+    for (host_state const& h : snap.hosts) {
+      dump_host(oss, h);
+      flush_object();
+    }
+    for (service_state const& s : snap.services) {
+      dump_service(oss, s);
+      flush_object();
+    }
+    append(snap.tail);
+    write_all(fd, buffer);
+
+    if (::fsync(fd)) {
+      char const* msg(strerror(errno));
+      throw engine_error("Cannot flush retention file '{}': {}", tmp, msg);
+    }
+    int ret(::close(fd));
+    fd = -1;
+    if (ret) {
+      char const* msg(strerror(errno));
+      throw engine_error("Cannot close retention file '{}': {}", tmp, msg);
+    }
+    if (::rename(tmp.c_str(), path.c_str())) {
+      char const* msg(strerror(errno));
+      throw engine_error("Cannot rename retention file '{}' to '{}': {}", tmp,
+                         path, msg);
+    }
+  }
+  catch (std::exception const& e) {
+    if (fd >= 0)
+      ::close(fd);
+    ::unlink(tmp.c_str());
+    logger(log_runtime_error, basic) << e.what();
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
 /**
  *  Dump retention of comment.
  *
@@ -249,126 +1012,7 @@ std::ostream& dump::header(std::ostream& os) {
  */
 std::ostream& dump::host(std::ostream& os,
                          com::centreon::engine::host const& obj) {
-  os << "host {\n"
-        "host_name=" << obj.get_name() << "\n"
-                                          "host_id=" << obj.get_host_id()
-     << "\n"
-        "acknowledgement_type=" << obj.get_acknowledgement_type()
-     << "\n"
-        "active_checks_enabled=" << obj.get_checks_enabled()
-     << "\n"
-        "check_command=" << obj.get_check_command()
-     << "\n"
-        "check_execution_time=" << std::setprecision(3) << std::fixed
-     << obj.get_execution_time() << "\n"
-                                    "check_latency=" << std::setprecision(3)
-     << std::fixed << obj.get_latency()
-     << "\n"
-        "check_options=" << obj.get_check_options()
-     << "\n"
-        "check_period=" << obj.get_check_period()
-     << "\n"
-        "check_type=" << obj.get_check_type()
-     << "\n"
-        "current_attempt=" << obj.get_current_attempt()
-     << "\n"
-        "current_event_id=" << obj.get_current_event_id()
-     << "\n"
-        "current_notification_id=" << obj.get_current_notification_id()
-     << "\n"
-        "current_notification_number=" << obj.get_notification_number()
-     << "\n"
-        "current_problem_id=" << obj.get_current_problem_id()
-     << "\n"
-        "current_state=" << obj.get_current_state()
-     << "\n"
-        "event_handler=" << obj.get_event_handler()
-     << "\n"
-        "event_handler_enabled=" << obj.get_event_handler_enabled()
-     << "\n"
-        "flap_detection_enabled=" << obj.get_flap_detection_enabled()
-     << "\n"
-        "has_been_checked=" << obj.has_been_checked()
-     << "\n"
-        "is_flapping=" << obj.get_is_flapping()
-     << "\n"
-        "last_acknowledgement=" << obj.get_last_acknowledgement()
-     << "\n"
-        "last_check=" << static_cast<unsigned long>(obj.get_last_check())
-     << "\n"
-        "last_event_id=" << obj.get_last_event_id()
-     << "\n"
-        "last_hard_state=" << obj.get_last_hard_state()
-     << "\n"
-        "last_hard_state_change="
-     << static_cast<unsigned long>(obj.get_last_hard_state_change())
-     << "\n"
-        "last_notification="
-     << static_cast<unsigned long>(obj.get_last_notification())
-     << "\n"
-        "last_problem_id=" << obj.get_last_problem_id()
-     << "\n"
-        "last_state=" << obj.get_last_state() << "\n"
-                                                 "last_state_change="
-     << static_cast<unsigned long>(obj.get_last_state_change())
-     << "\n"
-        "last_time_down="
-     << static_cast<unsigned long>(obj.get_last_time_down())
-     << "\n"
-        "last_time_unreachable="
-     << static_cast<unsigned long>(obj.get_last_time_unreachable())
-     << "\n"
-        "last_time_up=" << static_cast<unsigned long>(obj.get_last_time_up())
-     << "\n"
-        "long_plugin_output=" << obj.get_long_plugin_output()
-     << "\n"
-        "max_attempts=" << obj.get_max_attempts()
-     << "\n"
-        "modified_attributes=" << (obj.get_modified_attributes() &
-                                   ~config->retained_host_attribute_mask())
-     << "\n"
-        "next_check=" << static_cast<unsigned long>(obj.get_next_check())
-     << "\n"
-        "normal_check_interval=" << obj.get_check_interval()
-     << "\n"
-        "notification_period=" << obj.get_notification_period()
-     << "\n"
-        "notifications_enabled=" << obj.get_notifications_enabled()
-     << "\n"
-        "notified_on_down=" << obj.get_notified_on(notifier::down)
-     << "\n"
-        "notified_on_unreachable=" << obj.get_notified_on(notifier::unreachable)
-     << "\n"
-        "obsess_over_host=" << obj.get_obsess_over()
-     << "\n"
-        "passive_checks_enabled=" << obj.get_accept_passive_checks()
-     << "\n"
-        "percent_state_change=" << std::setprecision(2) << std::fixed
-     << obj.get_percent_state_change()
-     << "\n"
-        "performance_data=" << obj.get_perf_data()
-     << "\n"
-        "plugin_output=" << obj.get_plugin_output()
-     << "\n"
-        "problem_has_been_acknowledged="
-     << obj.get_problem_has_been_acknowledged()
-     << "\n"
-        "process_performance_data=" << obj.get_process_performance_data()
-     << "\n"
-        "retry_check_interval=" << obj.get_check_interval()
-     << "\n"
-        "state_type=" << obj.get_state_type() << "\n";
-
-  os << "state_history=";
-  for (unsigned int x(0); x < obj.get_state_history().size(); ++x)
-    os << (x > 0 ? "," : "")
-       << obj.get_state_history()
-              [(x + obj.get_state_history_index()) % MAX_STATE_HISTORY_ENTRIES];
-  os << "\n";
-
-  dump::notifications(os, obj.get_current_notifications());
-  dump::customvariables(os, obj.custom_variables);
-  os << "}\n";
+  dump_host(os, host_state(obj));
   return os;
 }
 
@@ -463,13 +1107,14 @@ std::ostream& dump::program(std::ostream& os) {
 }
 
 /**
- *  Save all data.
+ *  Save all data. A save running in the background is waited for first.
  *
  *  @param[in] path The file path to use to save.
  *
  *  @return True on success, otherwise false.
  */
 bool dump::save(std::string const& path) {
+  dump::wait();
   if (!config->retain_state_information())
     return true;
 
@@ -477,31 +1122,65 @@ bool dump::save(std::string const& path) {
   broker_retention_data(
       NEBTYPE_RETENTIONDATA_STARTSAVE, NEBFLAG_NONE, NEBATTR_NONE, NULL);
 
-  bool ret(false);
-  try {
-    std::ofstream stream(path.c_str(), std::ios::binary | std::ios::trunc);
-    if (!stream.is_open())
-      throw engine_error("Cannot open retention file '{}'",
-                  config->state_retention_file());
-    dump::header(stream);
-    dump::info(stream);
-    dump::program(stream);
-    dump::hosts(stream);
-    dump::services(stream);
-    dump::contacts(stream);
-    dump::comments(stream);
-    dump::downtimes(stream);
-
-    ret = true;
-  }
-  catch (std::exception const& e) {
-    logger(log_runtime_error, basic) << e.what();
-  }
+  snapshot snap;
+  take_snapshot(snap);
+  if (!write_snapshot(snap, path, config->retention_binary_format()))
+    return false;
 
   // send data to event broker.
   broker_retention_data(
       NEBTYPE_RETENTIONDATA_ENDSAVE, NEBFLAG_NONE, NEBATTR_NONE, NULL);
-  return ret;
+  return true;
+}
+
+/**
+ *  Save all data in the background. Retained attributes are copied in
+ *  the calling thread, they are then written by another thread. If the
+ *  previous save is not finished, nothing is done.
+ *
+ *  @param[in] path The file path to use to save.
+ *
+ *  @return True if the save was started, otherwise false.
+ */
+bool dump::save_async(std::string const& path) {
+  if (!config->retain_state_information())
+    return true;
+
+  if (pending_save.valid()) {
+    if (pending_save.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      logger(log_runtime_warning, basic)
+          << "Warning: Previous retention save still running, retention "
+             "data not saved";
+      return false;
+    }
+    if (pending_save.get())
+      end_pending_save(pending_save_id);
+  }
+
+  // send data to event broker
+  broker_retention_data(
+      NEBTYPE_RETENTIONDATA_STARTSAVE, NEBFLAG_NONE, NEBATTR_NONE, NULL);
+
+  std::shared_ptr<snapshot> snap(std::make_shared<snapshot>());
+  take_snapshot(*snap);
+
+  // The end is sent to the event broker by the main loop, once the file
+  // is written.
+  uint64_t id(++pending_save_id);
+  pending_save_ended = false;
+  bool binary(config->retention_binary_format());
+  pending_save = std::async(std::launch::async, [snap, path, binary, id] {
+    if (!write_snapshot(*snap, path, binary))
+      return false;
+    command_manager::instance().enqueue(
+        std::packaged_task<int(void)>([id]() -> int {
+          end_pending_save(id);
+          return 0;
+        }));
+    return true;
+  });
+  return true;
 }
 
 /**
@@ -513,143 +1192,7 @@ bool dump::save(std::string const& path) {
  *  @return The output stream.
  */
 std::ostream& dump::service(std::ostream& os, class service const& obj) {
-  std::string hostname;
-  if (obj.get_host_ptr())
-    hostname = obj.get_host_ptr()->get_name();
-
-  os << "service {\n"
-        "host_name=" << obj.get_hostname()
-     << "\n"
-        "service_description=" << obj.get_description() << "\n"
-                                                           "host_id="
-     << service::services[{hostname, obj.get_description()}]->get_host_id()
-     << "\n"
-        "service_id="
-     << service::services[{hostname, obj.get_description()}]->get_service_id()
-     << "\n"
-        "acknowledgement_type=" << obj.get_acknowledgement_type()
-     << "\n"
-        "active_checks_enabled=" << obj.get_checks_enabled()
-     << "\n"
-        "check_command=" << obj.get_check_command()
-     << "\n"
-        "check_execution_time=" << std::setprecision(3) << std::fixed
-     << obj.get_execution_time() << "\n"
-                                    "check_flapping_recovery_notification="
-     << obj.get_check_flapping_recovery_notification()
-     << "\n"
-        "check_latency=" << std::setprecision(3) << std::fixed
-     << obj.get_latency() << "\n"
-                             "check_options=" << obj.get_check_options()
-     << "\n"
-        "check_period=" << obj.get_check_period()
-     << "\n"
-        "check_type=" << obj.get_check_type()
-     << "\n"
-        "current_attempt=" << obj.get_current_attempt()
-     << "\n"
-        "current_event_id=" << obj.get_current_event_id()
-     << "\n"
-        "current_notification_id=" << obj.get_current_notification_id()
-     << "\n"
-        "current_notification_number=" << obj.get_notification_number()
-     << "\n"
-        "current_problem_id=" << obj.get_current_problem_id()
-     << "\n"
-        "current_state=" << obj.get_current_state()
-     << "\n"
-        "event_handler=" << obj.get_event_handler()
-     << "\n"
-        "event_handler_enabled=" << obj.get_event_handler_enabled()
-     << "\n"
-        "flap_detection_enabled=" << obj.get_flap_detection_enabled()
-     << "\n"
-        "has_been_checked=" << obj.has_been_checked()
-     << "\n"
-        "is_flapping=" << obj.get_is_flapping()
-     << "\n"
-        "last_acknowledgement=" << obj.get_last_acknowledgement()
-     << "\n"
-        "last_check=" << static_cast<unsigned long>(obj.get_last_check())
-     << "\n"
-        "last_event_id=" << obj.get_last_event_id()
-     << "\n"
-        "last_hard_state=" << obj.get_last_hard_state()
-     << "\n"
-        "last_hard_state_change="
-     << static_cast<unsigned long>(obj.get_last_hard_state_change())
-     << "\n"
-        "last_notification="
-     << static_cast<unsigned long>(obj.get_last_notification())
-     << "\n"
-        "last_problem_id=" << obj.get_last_problem_id()
-     << "\n"
-        "last_state=" << obj.get_last_state() << "\n"
-                                                 "last_state_change="
-     << static_cast<unsigned long>(obj.get_last_state_change())
-     << "\n"
-        "last_time_critical="
-     << static_cast<unsigned long>(obj.get_last_time_critical())
-     << "\n"
-        "last_time_ok=" << static_cast<unsigned long>(obj.get_last_time_ok())
-     << "\n"
-        "last_time_unknown="
-     << static_cast<unsigned long>(obj.get_last_time_unknown())
-     << "\n"
-        "last_time_warning="
-     << static_cast<unsigned long>(obj.get_last_time_warning())
-     << "\n"
-        "long_plugin_output=" << obj.get_long_plugin_output()
-     << "\n"
-        "max_attempts=" << obj.get_max_attempts()
-     << "\n"
-        "modified_attributes=" << (obj.get_modified_attributes() &
-                                   ~config->retained_host_attribute_mask())
-     << "\n"
-        "next_check=" << static_cast<unsigned long>(obj.get_next_check())
-     << "\n"
-        "normal_check_interval=" << obj.get_check_interval()
-     << "\n"
-        "notification_period=" << obj.get_notification_period()
-     << "\n"
-        "notifications_enabled=" << obj.get_notifications_enabled()
-     << "\n"
-        "notified_on_critical=" << obj.get_notified_on(notifier::critical)
-     << "\n"
-        "notified_on_unknown=" << obj.get_notified_on(notifier::unknown)
-     << "\n"
-        "notified_on_warning=" << obj.get_notified_on(notifier::warning)
-     << "\n"
-        "obsess_over_service=" << obj.get_obsess_over()
-     << "\n"
-        "passive_checks_enabled=" << obj.get_accept_passive_checks()
-     << "\n"
-        "percent_state_change=" << std::setprecision(2) << std::fixed
-     << obj.get_percent_state_change()
-     << "\n"
-        "performance_data=" << obj.get_perf_data()
-     << "\n"
-        "plugin_output=" << obj.get_plugin_output()
-     << "\n"
-        "problem_has_been_acknowledged="
-     << obj.get_problem_has_been_acknowledged()
-     << "\n"
-        "process_performance_data=" << obj.get_process_performance_data()
-     << "\n"
-        "retry_check_interval=" << obj.get_retry_interval()
-     << "\n"
-        "state_type=" << obj.get_state_type() << "\n";
-
-  os << "state_history=";
-  for (unsigned int x(0); x < MAX_STATE_HISTORY_ENTRIES; ++x)
-    os << (x > 0 ? "," : "")
-       << obj.get_state_history()
-              [(x + obj.get_state_history_index()) % MAX_STATE_HISTORY_ENTRIES];
-  os << "\n";
-
-  dump::notifications(os, obj.get_current_notifications());
-  dump::customvariables(os, obj.custom_variables);
-  os << "}\n";
+  dump_service(os, service_state(obj));
   return os;
 }
 
@@ -668,3 +1211,17 @@ std::ostream& dump::services(std::ostream& os) {
     dump::service(os, *it->second);
   return os;
 }
+
+/**
+ *  Wait for the end of the retention save running in the background.
+ *
+ *  @return False if the last save failed, otherwise true.
+ */
+bool dump::wait() {
+  if (!pending_save.valid())
+    return true;
+  if (!pending_save.get())
+    return false;
+  end_pending_save(pending_save_id);
+  return true;
+}
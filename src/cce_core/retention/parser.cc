@@ -19,9 +19,13 @@
 
 #include "com/centreon/engine/retention/parser.hh"
 #include <array>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <string>
+#include <vector>
 #include "com/centreon/exceptions/error.hh"
+#include "com/centreon/engine/retention/dump.hh"
 #include "com/centreon/engine/retention/state.hh"
 #include "com/centreon/engine/string.hh"
 
@@ -57,6 +61,18 @@ void parser::parse(std::string const& path, state& retention) {
   if (!stream.is_open())
     throw engine_error("Parsing of retention file failed: Can't open file '{}'", path);
 
+  // Binary retention file.
+  char magic[sizeof(dump::binary_magic) - 1];
+  if (stream.read(magic, sizeof(magic)) &&
+      !memcmp(magic, dump::binary_magic, sizeof(magic))) {
+    std::string data((std::istreambuf_iterator<char>(stream)),
+                     std::istreambuf_iterator<char>());
+    _parse_binary(path, data, retention);
+    return;
+  }
+  stream.clear();
+  stream.seekg(0);
+
   std::shared_ptr<object> obj;
   std::string input;
   unsigned int current_line(0);
@@ -97,6 +113,68 @@ void parser::parse(std::string const& path, state& retention) {
   }
 }
 
+/**
+ *  Parse the content of a binary retention file.
+ *
+ *  @param[in]  path       The retention file path.
+ *  @param[in]  data       The file content after the magic number.
+ *  @param[out] retention  The state to fill.
+ */
+void parser::_parse_binary(std::string const& path,
+                           std::string const& data,
+                           state& retention) {
+  char const* p(data.data());
+  char const* end(p + data.size());
+  auto next_uint32 = [&]() -> uint32_t {
+    uint32_t value;
+    if (end - p < static_cast<ptrdiff_t>(sizeof(value)))
+      throw engine_error(
+          "Parsing of retention file failed: file '{}' is truncated", path);
+    memcpy(&value, p, sizeof(value));
+    p += sizeof(value);
+    return value;
+  };
+  auto next_string = [&](std::string& value) {
+    uint32_t size(next_uint32());
+    if (static_cast<size_t>(end - p) < size)
+      throw engine_error(
+          "Parsing of retention file failed: file '{}' is truncated", path);
+    value.assign(p, size);
+    p += size;
+  };
+
+  // Type names and keys, indexed by their identifier.
+  std::vector<std::string> dictionary;
+  auto next_name = [&]() -> std::string const* {
+    uint32_t id(next_uint32());
+    if (id == dump::binary_end)
+      return nullptr;
+    if (id == dictionary.size()) {
+      dictionary.emplace_back();
+      next_string(dictionary.back());
+    } else if (id > dictionary.size())
+      throw engine_error(
+          "Parsing of retention file failed: file '{}' is corrupted", path);
+    return &dictionary[id];
+  };
+
+  std::string value;
+  while (p != end) {
+    std::string const* type_name(next_name());
+    if (!type_name)
+      throw engine_error(
+          "Parsing of retention file failed: file '{}' is corrupted", path);
+    std::shared_ptr<object> obj(object::create(*type_name));
+    while (std::string const* key = next_name()) {
+      next_string(value);
+      if (obj)
+        obj->set(key->c_str(), value.c_str());
+    }
+    if (obj)
+      (this->*_store[obj->type()])(retention, obj);
+  }
+}
+
 /**
  *  Store object into the state list.
  *
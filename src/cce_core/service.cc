@@ -39,6 +39,7 @@
 #include "com/centreon/engine/objects.hh"
 #include "com/centreon/engine/sehandlers.hh"
 #include "com/centreon/engine/shared.hh"
+#include "com/centreon/engine/status_snapshot.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/engine/timezone_locker.hh"
 #include "com/centreon/exceptions/error.hh"
@@ -2705,6 +2706,8 @@ void service::disable_flap_detection() {
 
 /* updates service status info */
 void service::update_status(bool aggregated_dump) {
+  status_snapshot::writer::instance().mark(*this);
+
   /* send data to event broker (non-aggregated dumps only) */
   if (!aggregated_dump)
     broker_service_status(NEBTYPE_SERVICESTATUS_UPDATE, NEBFLAG_NONE,
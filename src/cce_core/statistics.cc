@@ -57,10 +57,8 @@ pid_t statistics::get_pid() const noexcept {
 bool statistics::get_external_command_buffer_stats(buffer_stats& retval) const
     noexcept {
   if (config->check_external_commands()) {
-    pthread_mutex_lock(&external_command_buffer.buffer_lock);
-    retval.used = external_command_buffer.items;
-    retval.high = external_command_buffer.high;
-    pthread_mutex_unlock(&external_command_buffer.buffer_lock);
+    retval.used = external_command_buffer.size();
+    retval.high = external_command_buffer.high();
     retval.total = config->external_command_buffer_slots();
     return true;
   } else
@@ -0,0 +1,322 @@
+/*
+** Copyright 2020 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/status_snapshot.hh"
+
+#include <cerrno>
+#include <ctime>
+
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/host.hh"
+#include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/service.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::logging;
+using namespace com::centreon::engine::status_snapshot;
+
+/**
+ *  Fill a record from a host or a service.
+ *
+ *  @param[out] r    The record.
+ *  @param[in]  obj  The host or the service.
+ */
+static void fill_record(record& r, notifier const& obj) {
+  r.execution_time = obj.get_execution_time();
+  r.latency = obj.get_latency();
+  r.percent_state_change = obj.get_percent_state_change();
+  r.last_check = obj.get_last_check();
+  r.check_type = obj.get_check_type();
+  r.scheduled_downtime_depth = obj.get_scheduled_downtime_depth();
+  r.is_flapping = obj.get_is_flapping();
+  r.has_been_checked = obj.has_been_checked();
+  r.should_be_scheduled = obj.get_should_be_scheduled();
+  r.reserved = 0;
+}
+
+/**
+ *  Fill a record from a host.
+ *
+ *  @param[out] r    The record.
+ *  @param[in]  hst  The host.
+ */
+static void fill_record(record& r, host const& hst) {
+  fill_record(r, static_cast<notifier const&>(hst));
+  r.host_id = hst.get_host_id();
+  r.service_id = 0;
+  r.current_state = hst.get_current_state();
+}
+
+/**
+ *  Fill a record from a service.
+ *
+ *  @param[out] r    The record.
+ *  @param[in]  svc  The service.
+ */
+static void fill_record(record& r, service const& svc) {
+  fill_record(r, static_cast<notifier const&>(svc));
+  r.host_id = svc.get_host_id();
+  r.service_id = svc.get_service_id();
+  r.current_state = svc.get_current_state();
+}
+
+/**
+ *  Default constructor.
+ */
+writer::writer() : _map(nullptr), _rebuild_needed(false), _size(0) {}
+
+/**
+ *  Destructor.
+ */
+writer::~writer() { close(false); }
+
+/**
+ *  Get the writer instance.
+ *
+ *  @return The status snapshot writer.
+ */
+writer& writer::instance() {
+  static writer instance;
+  return instance;
+}
+
+/**
+ *  Stop maintaining the status snapshot.
+ *
+ *  @param[in] remove  Remove the snapshot file.
+ */
+void writer::close(bool remove) {
+  if (_map) {
+    munmap(_map, _size);
+    _map = nullptr;
+    _size = 0;
+    if (remove)
+      ::unlink(_path.c_str());
+  }
+  _path.clear();
+  _slots.clear();
+  _dirty.clear();
+  _is_dirty.clear();
+}
+
+/**
+ *  Mark a host as modified.
+ *
+ *  @param[in] hst  The host.
+ */
+void writer::mark(host const& hst) {
+  if (_map)
+    _mark({hst.get_host_id(), 0});
+}
+
+/**
+ *  Mark a service as modified.
+ *
+ *  @param[in] svc  The service.
+ */
+void writer::mark(service const& svc) {
+  if (_map)
+    _mark({svc.get_host_id(), svc.get_service_id()});
+}
+
+/**
+ *  Start maintaining a status snapshot.
+ *
+ *  @param[in] path  The snapshot file.
+ *
+ *  @return True on success.
+ */
+bool writer::open(std::string const& path) {
+  close(false);
+  _path = path;
+  if (!_rebuild()) {
+    _path.clear();
+    return false;
+  }
+  return true;
+}
+
+/**
+ *  Update the status snapshot: the header and the records of modified
+ *  objects are rewritten. The whole file is written again if objects
+ *  were added or removed.
+ *
+ *  @return True on success.
+ */
+bool writer::update() {
+  std::string const& path(config->status_snapshot_file());
+  if (path != _path) {
+    close(true);
+    if (path.empty())
+      return true;
+    return open(path);
+  }
+  if (!_map)
+    return true;
+
+  if (_rebuild_needed ||
+      _map->host_count != host::hosts.size() ||
+      _map->service_count != service::services.size())
+    return _rebuild();
+
+  uint64_t seq(_map->sequence);
+  __atomic_store_n(&_map->sequence, seq + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  _fill_header();
+  record* records(reinterpret_cast<record*>(_map + 1));
+  for (uint32_t slot : _dirty) {
+    _is_dirty[slot] = false;
+    record& r(records[slot]);
+    if (slot < _map->host_count) {
+      host_id_map::const_iterator it(host::hosts_by_id.find(r.host_id));
+      if (it == host::hosts_by_id.end())
+        _rebuild_needed = true;
+      else
+        fill_record(r, *it->second);
+    } else {
+      service_id_map::const_iterator it(
+          service::services_by_id.find({r.host_id, r.service_id}));
+      if (it == service::services_by_id.end())
+        _rebuild_needed = true;
+      else
+        fill_record(r, *it->second);
+    }
+  }
+  _dirty.clear();
+
+  __atomic_store_n(&_map->sequence, seq + 2, __ATOMIC_RELEASE);
+  return true;
+}
+
+/**
+ *  Fill the header fields that change over time.
+ */
+void writer::_fill_header() {
+  generate_check_stats();
+  _map->created = time(nullptr);
+  _map->program_start = program_start;
+  _map->pid = getpid();
+  _map->total_external_command_buffer_slots =
+      config->external_command_buffer_slots();
+  if (config->check_external_commands()) {
+    _map->used_external_command_buffer_slots = external_command_buffer.size();
+    _map->high_external_command_buffer_slots = external_command_buffer.high();
+  } else {
+    _map->used_external_command_buffer_slots = 0;
+    _map->high_external_command_buffer_slots = 0;
+  }
+  for (int i(0); i < MAX_CHECK_STATS_TYPES; ++i)
+    for (int j(0); j < 3; ++j)
+      _map->check_stats[i][j] = check_statistics[i].minute_stats[j];
+}
+
+/**
+ *  Mark the record of an object as modified.
+ *
+ *  @param[in] k  The host ID and the service ID (0 for hosts).
+ */
+void writer::_mark(key const& k) {
+  if (_rebuild_needed)
+    return;
+  auto it(_slots.find(k));
+  if (it == _slots.end())
+    _rebuild_needed = true;
+  else if (!_is_dirty[it->second]) {
+    _is_dirty[it->second] = true;
+    _dirty.push_back(it->second);
+  }
+}
+
+/**
+ *  Write the whole snapshot in a new file that replaces the current
+ *  one. Readers that opened the current file are not disturbed.
+ *
+ *  @return True on success.
+ */
+bool writer::_rebuild() {
+  size_t count(host::hosts.size() + service::services.size());
+  size_t size(sizeof(header) + count * sizeof(record));
+  std::string tmp(_path + ".tmp");
+
+  int fd(::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC,
+                S_IRUSR | S_IWUSR | S_IRGRP));
+  void* map(MAP_FAILED);
+  if (fd >= 0) {
+    if (!ftruncate(fd, size))
+      map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+  }
+  if (map == MAP_FAILED) {
+    char const* msg(strerror(errno));
+    logger(log_runtime_error, basic)
+        << "Error: Unable to write status snapshot file '" << tmp
+        << "': " << msg;
+    ::unlink(tmp.c_str());
+    return false;
+  }
+
+  header* h(static_cast<header*>(map));
+  memset(h, 0, sizeof(*h));
+  memcpy(h->magic, magic, sizeof(magic));
+  h->version = version;
+  h->header_size = sizeof(header);
+  h->record_size = sizeof(record);
+  h->host_count = host::hosts.size();
+  h->service_count = service::services.size();
+
+  _slots.clear();
+  _slots.reserve(count);
+  record* records(reinterpret_cast<record*>(h + 1));
+  uint32_t slot(0);
+  for (host_map::const_iterator it(host::hosts.begin()),
+       end(host::hosts.end());
+       it != end; ++it, ++slot) {
+    fill_record(records[slot], *it->second);
+    _slots[{records[slot].host_id, 0}] = slot;
+  }
+  for (service_map::const_iterator it(service::services.begin()),
+       end(service::services.end());
+       it != end; ++it, ++slot) {
+    fill_record(records[slot], *it->second);
+    _slots[{records[slot].host_id, records[slot].service_id}] = slot;
+  }
+
+  std::swap(_map, h);
+  _fill_header();
+  if (::rename(tmp.c_str(), _path.c_str())) {
+    char const* msg(strerror(errno));
+    logger(log_runtime_error, basic)
+        << "Error: Unable to rename status snapshot file '" << tmp << "' to '"
+        << _path << "': " << msg;
+    ::unlink(tmp.c_str());
+    munmap(_map, size);
+    _map = h;
+    _rebuild_needed = true;
+    return false;
+  }
+  if (h)
+    munmap(h, _size);
+  _size = size;
+
+  _dirty.clear();
+  _is_dirty.assign(count, false);
+  _rebuild_needed = false;
+  return true;
+}
@@ -21,6 +21,7 @@
 #include "com/centreon/engine/statusdata.hh"
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/status_snapshot.hh"
 #include "com/centreon/engine/xsddefault.hh"
 
 /******************************************************************/
@@ -29,7 +30,10 @@
 
 /* initializes status data at program start */
 int initialize_status_data() {
-  return xsddefault_initialize_status_data();
+  int result = xsddefault_initialize_status_data();
+  if (!com::centreon::engine::status_snapshot::writer::instance().update())
+    result = ERROR;
+  return result;
 }
 
 /* update all status data (aggregated dump) */
@@ -41,6 +45,8 @@ int update_all_status_data() {
                                 NEBFLAG_NONE, NEBATTR_NONE, NULL);
 
   result = xsddefault_save_status_data();
+  if (!com::centreon::engine::status_snapshot::writer::instance().update())
+    result = ERROR;
 
   /* send data to event broker */
   broker_aggregated_status_data(NEBTYPE_AGGREGATEDSTATUS_ENDDUMP, NEBFLAG_NONE,
@@ -53,6 +59,8 @@ int update_all_status_data() {
 
 /* cleans up status data before program termination */
 int cleanup_status_data(int delete_status_data) {
+  com::centreon::engine::status_snapshot::writer::instance().close(
+      delete_status_data);
   return xsddefault_cleanup_status_data(delete_status_data);
 }
 
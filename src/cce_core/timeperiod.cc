@@ -18,6 +18,9 @@
 */
 
 #include "com/centreon/engine/timeperiod.hh"
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_set>
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/daterange.hh"
@@ -36,6 +39,7 @@ using namespace com::centreon::engine::logging;
 using namespace com::centreon::engine::string;
 
 timeperiod_map timeperiod::timeperiods;
+unsigned int timeperiod::_indexes_generation(1);
 
 /**
  *  Create a new timeperiod in memory.
@@ -46,7 +50,7 @@ timeperiod_map timeperiod::timeperiods;
  */
 
 timeperiod::timeperiod(std::string const& name, std::string const& alias)
-    : _name{name}, _alias{alias} {
+    : _name{name}, _alias{alias}, _indexed{false} {
   if (name.empty() || alias.empty()) {
     logger(log_config_error, basic)
         << "Error: Name or alias for timeperiod is NULL";
@@ -70,6 +74,36 @@ std::string const timeperiod::get_alias() const { return _alias; }
 
 void timeperiod::set_alias(std::string const& alias) { _alias = alias; }
 
+/**
+ *  Check if valid times of this time period are looked up in a
+ *  precomputed interval index.
+ *
+ *  @return True if the index is used.
+ */
+bool timeperiod::get_indexed() const noexcept { return _indexed; }
+
+/**
+ *  Enable or disable the interval index. The index must only be enabled
+ *  on time periods whose definition is modified through the
+ *  configuration appliers, as they invalidate it.
+ *
+ *  @param[in] indexed  True to use the index.
+ */
+void timeperiod::set_indexed(bool indexed) {
+  _indexed = indexed;
+  _indexes.clear();
+}
+
+/**
+ *  Invalidate interval indexes of all time periods. Must be called each
+ *  time a time period is added, modified or removed as exclusions make
+ *  time periods depend on each other.
+ */
+void timeperiod::invalidate_indexes() {
+  if (!++_indexes_generation)
+    ++_indexes_generation;
+}
+
 /**
  *  Equal operator.
  *
@@ -762,9 +796,24 @@ bool check_time_against_period(time_t test_time, timeperiod* tperiod) {
   if (!tperiod)
     return true;
 
+  return tperiod->is_valid_time(test_time);
+}
+
+/**
+ *  Check if a time is valid in this time period.
+ *
+ *  @param[in] test_time  Time to test.
+ *
+ *  @return true if test_time is a valid time.
+ */
+bool timeperiod::is_valid_time(time_t test_time) {
+  // The index answers for every time it covers, no fallback is needed.
+  if (_indexed)
+    return _get_index(test_time).is_valid(test_time);
+
   // Faked next valid time must be tested time.
   time_t next_valid_time{(time_t) - 1};
-  tperiod->get_next_valid_time_per_timeperiod(test_time, &next_valid_time);
+  _get_next_valid_time_uncached(test_time, &next_valid_time);
   return next_valid_time == test_time;
 }
 
@@ -962,6 +1011,115 @@ static time_t _get_next_valid_time_in_timeranges(time_t preferred_time,
   return earliest_time;
 }
 
+/**
+ *  Collect time ranges of a time period and of the time periods it
+ *  excludes (recursively).
+ *
+ *  @param[in]     tp       Time period.
+ *  @param[in,out] visited  Time periods already browsed.
+ *  @param[out]    ranges   Time ranges.
+ */
+static void _collect_timeranges(timeperiod* tp,
+                                std::unordered_set<timeperiod*>& visited,
+                                std::vector<timerange*>& ranges) {
+  if (!visited.insert(tp).second)
+    return;
+  for (timerange_list const& day : tp->days)
+    for (std::shared_ptr<timerange> const& tr : day)
+      ranges.push_back(tr.get());
+  for (daterange_list const& type : tp->exceptions)
+    for (std::shared_ptr<daterange> const& dr : type)
+      for (std::shared_ptr<timerange> const& tr : dr->times)
+        ranges.push_back(tr.get());
+  for (timeperiodexclusion::value_type const& excl : tp->get_exclusions())
+    if (excl.second)
+      _collect_timeranges(excl.second, visited, ranges);
+}
+
+/**
+ *  Get the interval index of the current timezone covering a time,
+ *  building it if necessary.
+ *
+ *  Validity of a time period can only change on midnights and on time
+ *  range limits (of the time period or of its exclusions). All those
+ *  boundaries are computed day by day with mktime() within the horizon,
+ *  so DST transitions are handled as the original algorithm does. Each
+ *  segment between two boundaries is then checked once.
+ *
+ *  @param[in] preferred_time  Time that must be covered.
+ *
+ *  @return The interval index.
+ */
+timeperiod_index const& timeperiod::_get_index(time_t preferred_time) {
+  char const* tz{getenv("TZ")};
+  timeperiod_index& index{_indexes[tz ? tz : ""]};
+  if (index.covers(preferred_time, _indexes_generation))
+    return index;
+
+  logger(dbg_functions, most) << "building interval index of time period '"
+                              << _name << "'";
+
+  std::pair<time_t, time_t> const horizon{
+      index.next_horizon(preferred_time, _indexes_generation)};
+  time_t const horizon_start{horizon.first};
+  time_t const horizon_end{horizon.second};
+  std::vector<timerange*> ranges;
+  {
+    std::unordered_set<timeperiod*> visited;
+    _collect_timeranges(this, visited, ranges);
+  }
+
+  // Compute boundaries.
+  std::vector<time_t> boundaries;
+  boundaries.push_back(horizon_start);
+  struct tm midnight;
+  localtime_r(&horizon_start, &midnight);
+  midnight.tm_sec = 0;
+  midnight.tm_min = 0;
+  midnight.tm_hour = 0;
+  midnight.tm_isdst = -1;
+  for (time_t day{mktime(&midnight)}; day != (time_t)-1 && day < horizon_end;
+       day = _add_round_days_to_midnight(day, 24 * 60 * 60)) {
+    boundaries.push_back(day);
+    localtime_r(&day, &midnight);
+    for (timerange* tr : ranges) {
+      time_t range_start;
+      time_t range_end;
+      _timerange_to_time_t(tr, &midnight, range_start, range_end);
+      boundaries.push_back(range_start);
+      boundaries.push_back(range_end);
+    }
+  }
+  std::sort(boundaries.begin(), boundaries.end());
+  boundaries.erase(std::unique(boundaries.begin(), boundaries.end()),
+                   boundaries.end());
+
+  // Check each segment and merge valid ones.
+  timeperiod_index::interval_list intervals;
+  for (std::vector<time_t>::const_iterator
+           it{std::lower_bound(
+               boundaries.begin(), boundaries.end(), horizon_start)},
+       end{std::lower_bound(boundaries.begin(), boundaries.end(), horizon_end)};
+       it != end;
+       ++it) {
+    time_t valid{(time_t)-1};
+    _get_next_valid_time_uncached(*it, &valid);
+    if (valid == *it) {
+      time_t segment_end{std::next(it) == end ? horizon_end : *std::next(it)};
+      if (!intervals.empty() && intervals.back().second == *it)
+        intervals.back().second = segment_end;
+      else
+        intervals.emplace_back(*it, segment_end);
+    }
+  }
+
+  index.set(horizon_start,
+            horizon_end,
+            _indexes_generation,
+            std::move(intervals));
+  return index;
+}
+
 /**
  *  Get the next valid time within a time period.
  *
@@ -972,6 +1130,25 @@ void timeperiod::get_next_valid_time_per_timeperiod(time_t preferred_time,
                                                     time_t* valid_time) {
   logger(dbg_functions, basic) << "get_next_valid_time_per_timeperiod()";
 
+  // Look up the index. If no valid time is found within its horizon,
+  // fall back to the full computation that browses a whole year.
+  if (_indexed &&
+      _get_index(preferred_time).get_next_valid_time(preferred_time,
+                                                     *valid_time))
+    return;
+  _get_next_valid_time_uncached(preferred_time, valid_time);
+}
+
+/**
+ *  Get the next valid time within a time period, without using the
+ *  interval index.
+ *
+ *  @param[in]  preferred_time  The preferred time to check.
+ *  @param[out] valid_time      Variable to fill.
+ */
+void timeperiod::_get_next_valid_time_uncached(time_t preferred_time,
+                                               time_t* valid_time) {
+
   // If no time can be found, the original preferred time will be set
   // in valid_time at the end of the loop.
   time_t original_preferred_time(preferred_time);
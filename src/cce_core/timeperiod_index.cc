@@ -0,0 +1,140 @@
+/*
+** Copyright 2020 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include "com/centreon/engine/timeperiod_index.hh"
+#include <algorithm>
+
+using namespace com::centreon::engine;
+
+time_t const timeperiod_index::horizon;
+time_t const timeperiod_index::lookahead;
+
+/**
+ *  Default constructor. The index covers nothing.
+ */
+timeperiod_index::timeperiod_index() : _start(0), _end(0), _generation(0) {}
+
+/**
+ *  Check if the index can answer for a given time. At least lookahead
+ *  seconds must remain in the horizon so that the next valid time of
+ *  usual time periods is found in it.
+ *
+ *  @param[in] t           Time to check.
+ *  @param[in] generation  Current configuration generation.
+ *
+ *  @return True if the index can be used.
+ */
+bool timeperiod_index::covers(time_t t, unsigned int generation) const {
+  return generation == _generation && t >= _start && t + lookahead < _end;
+}
+
+/**
+ *  Get the next valid time from the index.
+ *
+ *  @param[in]  preferred_time  Preferred time, must be covered.
+ *  @param[out] valid_time      Next valid time.
+ *
+ *  @return True if a valid time was found in the horizon. Otherwise the
+ *          caller must fall back to the full computation.
+ */
+bool timeperiod_index::get_next_valid_time(time_t preferred_time,
+                                           time_t& valid_time) const {
+  // First interval ending after the preferred time.
+  interval_list::const_iterator it(std::upper_bound(
+      _intervals.begin(),
+      _intervals.end(),
+      preferred_time,
+      [](time_t t, std::pair<time_t, time_t> const& interval) {
+        return t < interval.second;
+      }));
+  if (it == _intervals.end())
+    return false;
+  valid_time = std::max(preferred_time, it->first);
+  return true;
+}
+
+/**
+ *  Get the valid intervals.
+ *
+ *  @return Sorted list of disjoint [start, end[ intervals.
+ */
+timeperiod_index::interval_list const& timeperiod_index::intervals() const {
+  return _intervals;
+}
+
+/**
+ *  Check if a time is in a valid interval.
+ *
+ *  @param[in] t  Time to check, must be covered.
+ *
+ *  @return True if t is a valid time.
+ */
+bool timeperiod_index::is_valid(time_t t) const {
+  // First interval ending after t.
+  interval_list::const_iterator it(std::upper_bound(
+      _intervals.begin(),
+      _intervals.end(),
+      t,
+      [](time_t t, std::pair<time_t, time_t> const& interval) {
+        return t < interval.second;
+      }));
+  return it != _intervals.end() && it->first <= t;
+}
+
+/**
+ *  Get the horizon of the index to build when a time is not covered.
+ *  It starts at the oldest time already covered, keeping at most one
+ *  horizon before the requested time, so that lookups alternating
+ *  between older and newer times do not rebuild the index each time.
+ *
+ *  @param[in] t           Time that must be covered.
+ *  @param[in] generation  Current configuration generation.
+ *
+ *  @return Start and end of the new horizon.
+ */
+std::pair<time_t, time_t> timeperiod_index::next_horizon(
+    time_t t,
+    unsigned int generation) const {
+  std::pair<time_t, time_t> retval(t, t + horizon);
+  if (generation == _generation && _start < _end) {
+    if (_start < t)
+      retval.first = std::max(_start, t - horizon);
+    else
+      retval.second = std::min(std::max(_end, retval.second), t + 2 * horizon);
+  }
+  return retval;
+}
+
+/**
+ *  Set the index content.
+ *
+ *  @param[in] start       Start of the horizon.
+ *  @param[in] end         End of the horizon.
+ *  @param[in] generation  Configuration generation of the intervals.
+ *  @param[in] intervals   Sorted disjoint valid intervals.
+ */
+void timeperiod_index::set(time_t start,
+                           time_t end,
+                           unsigned int generation,
+                           interval_list&& intervals) {
+  _start = start;
+  _end = end;
+  _generation = generation;
+  _intervals = std::move(intervals);
+}
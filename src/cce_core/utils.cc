@@ -37,6 +37,7 @@
 #include <ctime>
 #include <iomanip>
 
+#include "com/centreon/engine/anomalydetection.hh"
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/broker/compatibility.hh"
 #include "com/centreon/engine/broker/loader.hh"
@@ -413,6 +414,9 @@ bool set_cloexec(int fd) {
  *  Do some cleanup before we exit.
  */
 void cleanup() {
+  // Stop reading thresholds files.
+  anomalydetection::stop_thresholds_updates();
+
   // Unload modules.
   if (!test_scheduling && !verify_config) {
     checks::checker::deinit();
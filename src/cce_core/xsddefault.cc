@@ -29,9 +29,13 @@
 #include <cerrno>
 #include <cstdio>
 #include <cstdlib>
+#include <future>
 #include <iomanip>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "com/centreon/engine/comment.hh"
 #include "com/centreon/engine/common.hh"
@@ -50,6 +54,103 @@ using namespace com::centreon::engine::downtimes;
 using namespace com::centreon::engine::configuration::applier;
 
 static int xsddefault_status_log_fd(-1);
+static std::future<int> xsddefault_pending_write;
+
+namespace {
+// Status of a host or a service, copied on the main loop.
+struct notifier_status {
+  uint32_t modified_attributes;
+  std::string check_command;
+  std::string check_period;
+  std::string notification_period;
+  uint32_t check_interval;
+  double retry_interval;
+  std::string event_handler;
+  bool has_been_checked;
+  bool should_be_scheduled;
+  double execution_time;
+  double latency;
+  int check_type;
+  int current_state;
+  int last_hard_state;
+  unsigned long last_event_id;
+  unsigned long current_event_id;
+  unsigned long current_problem_id;
+  unsigned long last_problem_id;
+  std::string plugin_output;
+  std::string long_plugin_output;
+  std::string perf_data;
+  time_t last_check;
+  time_t next_check;
+  int check_options;
+  int current_attempt;
+  int max_attempts;
+  int state_type;
+  time_t last_state_change;
+  time_t last_hard_state_change;
+  time_t last_notification;
+  time_t next_notification;
+  bool no_more_notifications;
+  int notification_number;
+  uint64_t current_notification_id;
+  bool notifications_enabled;
+  bool problem_has_been_acknowledged;
+  int acknowledgement_type;
+  bool checks_enabled;
+  bool accept_passive_checks;
+  bool event_handler_enabled;
+  bool flap_detection_enabled;
+  bool process_performance_data;
+  bool obsess_over;
+  bool is_flapping;
+  double percent_state_change;
+  int scheduled_downtime_depth;
+  map_customvar custom_variables;
+};
+
+struct host_status : notifier_status {
+  std::string name;
+  time_t last_time_up;
+  time_t last_time_down;
+  time_t last_time_unreachable;
+};
+
+struct service_status : notifier_status {
+  std::string hostname;
+  std::string description;
+  time_t last_time_ok;
+  time_t last_time_warning;
+  time_t last_time_unknown;
+  time_t last_time_critical;
+};
+
+struct contact_status {
+  std::string name;
+  uint32_t modified_attributes;
+  unsigned long modified_host_attributes;
+  unsigned long modified_service_attributes;
+  std::string host_notification_period;
+  std::string service_notification_period;
+  time_t last_host_notification;
+  time_t last_service_notification;
+  bool host_notifications_enabled;
+  bool service_notifications_enabled;
+  map_customvar custom_variables;
+};
+
+// Status data copied on the main loop and formatted in the background.
+// The program status and the downtimes, whose sizes do not depend on
+// the number of objects, are formatted on the main loop.
+struct status_data {
+  time_t current_time;
+  std::string program_status;
+  std::vector<host_status> hosts;
+  std::vector<service_status> services;
+  std::vector<contact_status> contacts;
+  std::vector<std::pair<uint64_t, comment> > comments;
+  std::string downtimes;
+};
+}  // namespace
 
 /******************************************************************/
 /********************* INIT/CLEANUP FUNCTIONS *********************/
@@ -82,6 +183,10 @@ int xsddefault_cleanup_status_data(int delete_status_data) {
   if (verify_config)
     return OK;
 
+  // wait for the status data being written.
+  if (xsddefault_pending_write.valid())
+    xsddefault_pending_write.get();
+
   // delete the status log.
   if (delete_status_data && !config->status_file().empty()) {
     if (unlink(config->status_file().c_str()))
@@ -99,11 +204,543 @@ int xsddefault_cleanup_status_data(int delete_status_data) {
 /****************** STATUS DATA OUTPUT FUNCTIONS ******************/
 /******************************************************************/
 
+/* print the custom variables of an object */
+static void xsddefault_print_custom_variables(std::ostream& os,
+                                              map_customvar const& vars) {
+  for (auto const& cv : vars) {
+    if (!cv.first.empty())
+      os << "\t_" << cv.first << "=" << cv.second.has_been_modified() << ";"
+         << cv.second.get_value() << "\n";
+  }
+}
+
+/* copy the status fields shared by hosts and services */
+template <typename T>
+static void xsddefault_copy_status(notifier_status& s, T const& n) {
+  s.modified_attributes = n.get_modified_attributes();
+  s.check_command = n.get_check_command();
+  s.check_period = n.get_check_period();
+  s.notification_period = n.get_notification_period();
+  s.check_interval = n.get_check_interval();
+  s.retry_interval = n.get_retry_interval();
+  s.event_handler = n.get_event_handler();
+  s.has_been_checked = n.has_been_checked();
+  s.should_be_scheduled = n.get_should_be_scheduled();
+  s.execution_time = n.get_execution_time();
+  s.latency = n.get_latency();
+  s.check_type = n.get_check_type();
+  s.current_state = n.get_current_state();
+  s.last_hard_state = n.get_last_hard_state();
+  s.last_event_id = n.get_last_event_id();
+  s.current_event_id = n.get_current_event_id();
+  s.current_problem_id = n.get_current_problem_id();
+  s.last_problem_id = n.get_last_problem_id();
+  s.plugin_output = n.get_plugin_output();
+  s.long_plugin_output = n.get_long_plugin_output();
+  s.perf_data = n.get_perf_data();
+  s.last_check = n.get_last_check();
+  s.next_check = n.get_next_check();
+  s.check_options = n.get_check_options();
+  s.current_attempt = n.get_current_attempt();
+  s.max_attempts = n.get_max_attempts();
+  s.state_type = n.get_state_type();
+  s.last_state_change = n.get_last_state_change();
+  s.last_hard_state_change = n.get_last_hard_state_change();
+  s.last_notification = n.get_last_notification();
+  s.next_notification = n.get_next_notification();
+  s.no_more_notifications = n.get_no_more_notifications();
+  s.notification_number = n.get_notification_number();
+  s.current_notification_id = n.get_current_notification_id();
+  s.notifications_enabled = n.get_notifications_enabled();
+  s.problem_has_been_acknowledged = n.get_problem_has_been_acknowledged();
+  s.acknowledgement_type = n.get_acknowledgement_type();
+  s.checks_enabled = n.get_checks_enabled();
+  s.accept_passive_checks = n.get_accept_passive_checks();
+  s.event_handler_enabled = n.get_event_handler_enabled();
+  s.flap_detection_enabled = n.get_flap_detection_enabled();
+  s.process_performance_data = n.get_process_performance_data();
+  s.obsess_over = n.get_obsess_over();
+  s.is_flapping = n.get_is_flapping();
+  s.percent_state_change = n.get_percent_state_change();
+  s.scheduled_downtime_depth = n.get_scheduled_downtime_depth();
+  s.custom_variables = n.custom_variables;
+}
+
+/* print the status of a host */
+static void xsddefault_print_host(std::ostream& os,
+                                  host_status const& s,
+                                  time_t current_time) {
+  os
+      << "hoststatus {\n"
+         "\thost_name="
+      << s.name
+      << "\n"
+         "\tmodified_attributes="
+      << s.modified_attributes
+      << "\n"
+         "\tcheck_command="
+      << s.check_command
+      << "\n"
+         "\tcheck_period="
+      << s.check_period
+      << "\n"
+         "\tnotification_period="
+      << s.notification_period
+      << "\n"
+         "\tcheck_interval="
+      << s.check_interval
+      << "\n"
+         "\tretry_interval="
+      << s.retry_interval
+      << "\n"
+         "\tevent_handler="
+      << s.event_handler
+      << "\n"
+         "\thas_been_checked="
+      << s.has_been_checked
+      << "\n"
+         "\tshould_be_scheduled="
+      << s.should_be_scheduled
+      << "\n"
+         "\tcheck_execution_time="
+      << std::setprecision(3) << std::fixed
+      << s.execution_time
+      << "\n"
+         "\tcheck_latency="
+      << std::setprecision(3) << std::fixed << s.latency
+      << "\n"
+         "\tcheck_type="
+      << s.check_type
+      << "\n"
+         "\tcurrent_state="
+      << s.current_state
+      << "\n"
+         "\tlast_hard_state="
+      << s.last_hard_state
+      << "\n"
+         "\tlast_event_id="
+      << s.last_event_id
+      << "\n"
+         "\tcurrent_event_id="
+      << s.current_event_id
+      << "\n"
+         "\tcurrent_problem_id="
+      << s.current_problem_id
+      << "\n"
+         "\tlast_problem_id="
+      << s.last_problem_id
+      << "\n"
+         "\tplugin_output="
+      << s.plugin_output
+      << "\n"
+         "\tlong_plugin_output="
+      << s.long_plugin_output
+      << "\n"
+         "\tperformance_data="
+      << s.perf_data
+      << "\n"
+         "\tlast_check="
+      << static_cast<unsigned long>(s.last_check)
+      << "\n"
+         "\tnext_check="
+      << static_cast<unsigned long>(s.next_check)
+      << "\n"
+         "\tcheck_options="
+      << s.check_options
+      << "\n"
+         "\tcurrent_attempt="
+      << s.current_attempt
+      << "\n"
+         "\tmax_attempts="
+      << s.max_attempts
+      << "\n"
+         "\tstate_type="
+      << s.state_type
+      << "\n"
+         "\tlast_state_change="
+      << static_cast<unsigned long>(s.last_state_change)
+      << "\n"
+         "\tlast_hard_state_change="
+      << static_cast<unsigned long>(s.last_hard_state_change)
+      << "\n"
+         "\tlast_time_up="
+      << static_cast<unsigned long>(s.last_time_up)
+      << "\n"
+         "\tlast_time_down="
+      << static_cast<unsigned long>(s.last_time_down)
+      << "\n"
+         "\tlast_time_unreachable="
+      << static_cast<unsigned long>(s.last_time_unreachable)
+      << "\n"
+         "\tlast_notification="
+      << static_cast<unsigned long>(s.last_notification)
+      << "\n"
+         "\tnext_notification="
+      << static_cast<unsigned long>(s.next_notification)
+      << "\n"
+         "\tno_more_notifications="
+      << s.no_more_notifications
+      << "\n"
+         "\tcurrent_notification_number="
+      << s.notification_number
+      << "\n"
+         "\tcurrent_notification_id="
+      << s.current_notification_id
+      << "\n"
+         "\tnotifications_enabled="
+      << s.notifications_enabled
+      << "\n"
+         "\tproblem_has_been_acknowledged="
+      << s.problem_has_been_acknowledged
+      << "\n"
+         "\tacknowledgement_type="
+      << s.acknowledgement_type
+      << "\n"
+         "\tactive_checks_enabled="
+      << s.checks_enabled
+      << "\n"
+         "\tpassive_checks_enabled="
+      << s.accept_passive_checks
+      << "\n"
+         "\tevent_handler_enabled="
+      << s.event_handler_enabled
+      << "\n"
+         "\tflap_detection_enabled="
+      << s.flap_detection_enabled
+      << "\n"
+         "\tprocess_performance_data="
+      << s.process_performance_data
+      << "\n"
+         "\tobsess_over_host="
+      << s.obsess_over
+      << "\n"
+         "\tlast_update="
+      << static_cast<unsigned long>(current_time)
+      << "\n"
+         "\tis_flapping="
+      << s.is_flapping
+      << "\n"
+         "\tpercent_state_change="
+      << std::setprecision(2) << std::fixed
+      << s.percent_state_change
+      << "\n"
+         "\tscheduled_downtime_depth="
+      << s.scheduled_downtime_depth << "\n";
+  xsddefault_print_custom_variables(os, s.custom_variables);
+  os << "\t}\n\n";
+}
+
+/* print the status of a service */
+static void xsddefault_print_service(std::ostream& os,
+                                     service_status const& s,
+                                     time_t current_time) {
+  os << "servicestatus {\n"
+        "\thost_name="
+     << s.hostname
+     << "\n"
+        "\tservice_description="
+     << s.description
+     << "\n"
+        "\tmodified_attributes="
+     << s.modified_attributes
+     << "\n"
+        "\tcheck_command="
+     << s.check_command
+     << "\n"
+        "\tcheck_period="
+     << s.check_period
+     << "\n"
+        "\tnotification_period="
+     << s.notification_period
+     << "\n"
+        "\tcheck_interval="
+     << s.check_interval
+     << "\n"
+        "\tretry_interval="
+     << s.retry_interval
+     << "\n"
+        "\tevent_handler="
+     << s.event_handler
+     << "\n"
+        "\thas_been_checked="
+     << s.has_been_checked
+     << "\n"
+        "\tshould_be_scheduled="
+     << s.should_be_scheduled
+     << "\n"
+        "\tcheck_execution_time="
+     << std::setprecision(3) << std::fixed
+     << s.execution_time
+     << "\n"
+        "\tcheck_latency="
+     << std::setprecision(3) << std::fixed << s.latency
+     << "\n"
+        "\tcheck_type="
+     << s.check_type
+     << "\n"
+        "\tcurrent_state="
+     << s.current_state
+     << "\n"
+        "\tlast_hard_state="
+     << s.last_hard_state
+     << "\n"
+        "\tlast_event_id="
+     << s.last_event_id
+     << "\n"
+        "\tcurrent_event_id="
+     << s.current_event_id
+     << "\n"
+        "\tcurrent_problem_id="
+     << s.current_problem_id
+     << "\n"
+        "\tlast_problem_id="
+     << s.last_problem_id
+     << "\n"
+        "\tcurrent_attempt="
+     << s.current_attempt
+     << "\n"
+        "\tmax_attempts="
+     << s.max_attempts
+     << "\n"
+        "\tstate_type="
+     << s.state_type
+     << "\n"
+        "\tlast_state_change="
+     << static_cast<unsigned long>(s.last_state_change)
+     << "\n"
+        "\tlast_hard_state_change="
+     << static_cast<unsigned long>(
+            s.last_hard_state_change)
+     << "\n"
+        "\tlast_time_ok="
+     << static_cast<unsigned long>(s.last_time_ok)
+     << "\n"
+        "\tlast_time_warning="
+     << static_cast<unsigned long>(s.last_time_warning)
+     << "\n"
+        "\tlast_time_unknown="
+     << static_cast<unsigned long>(s.last_time_unknown)
+     << "\n"
+        "\tlast_time_critical="
+     << static_cast<unsigned long>(s.last_time_critical)
+     << "\n"
+        "\tplugin_output="
+     << s.plugin_output
+     << "\n"
+        "\tlong_plugin_output="
+     << s.long_plugin_output
+     << "\n"
+        "\tperformance_data="
+     << s.perf_data
+     << "\n"
+        "\tlast_check="
+     << static_cast<unsigned long>(s.last_check)
+     << "\n"
+        "\tnext_check="
+     << static_cast<unsigned long>(s.next_check)
+     << "\n"
+        "\tcheck_options="
+     << s.check_options
+     << "\n"
+        "\tcurrent_notification_number="
+     << s.notification_number
+     << "\n"
+        "\tcurrent_notification_id="
+     << s.current_notification_id
+     << "\n"
+        "\tlast_notification="
+     << static_cast<unsigned long>(s.last_notification)
+     << "\n"
+        "\tnext_notification="
+     << static_cast<unsigned long>(s.next_notification)
+     << "\n"
+        "\tno_more_notifications="
+     << s.no_more_notifications
+     << "\n"
+        "\tnotifications_enabled="
+     << s.notifications_enabled
+     << "\n"
+        "\tactive_checks_enabled="
+     << s.checks_enabled
+     << "\n"
+        "\tpassive_checks_enabled="
+     << s.accept_passive_checks
+     << "\n"
+        "\tevent_handler_enabled="
+     << s.event_handler_enabled
+     << "\n"
+        "\tproblem_has_been_acknowledged="
+     << s.problem_has_been_acknowledged
+     << "\n"
+        "\tacknowledgement_type="
+     << s.acknowledgement_type
+     << "\n"
+        "\tflap_detection_enabled="
+     << s.flap_detection_enabled
+     << "\n"
+        "\tprocess_performance_data="
+     << s.process_performance_data
+     << "\n"
+        "\tobsess_over_service="
+     << s.obsess_over
+     << "\n"
+        "\tlast_update="
+     << static_cast<unsigned long>(current_time)
+     << "\n"
+        "\tis_flapping="
+     << s.is_flapping
+     << "\n"
+        "\tpercent_state_change="
+     << std::setprecision(2) << std::fixed
+     << s.percent_state_change
+     << "\n"
+        "\tscheduled_downtime_depth="
+     << s.scheduled_downtime_depth << "\n";
+  xsddefault_print_custom_variables(os, s.custom_variables);
+  os << "\t}\n\n";
+}
+
+/* print the status of a contact */
+static void xsddefault_print_contact(std::ostream& os,
+                                     contact_status const& c) {
+  os << "contactstatus {\n"
+        "\tcontact_name="
+     << c.name
+     << "\n"
+        "\tmodified_attributes="
+     << c.modified_attributes
+     << "\n"
+        "\tmodified_host_attributes="
+     << c.modified_host_attributes
+     << "\n"
+        "\tmodified_service_attributes="
+     << c.modified_service_attributes
+     << "\n"
+        "\thost_notification_period="
+     << c.host_notification_period
+     << "\n"
+        "\tservice_notification_period="
+     << c.service_notification_period
+     << "\n"
+        "\tlast_host_notification="
+     << static_cast<unsigned long>(c.last_host_notification)
+     << "\n"
+        "\tlast_service_notification="
+     << static_cast<unsigned long>(c.last_service_notification)
+     << "\n"
+        "\thost_notifications_enabled="
+     << c.host_notifications_enabled
+     << "\n"
+        "\tservice_notifications_enabled="
+     << c.service_notifications_enabled << "\n";
+  xsddefault_print_custom_variables(os, c.custom_variables);
+  os << "\t}\n\n";
+}
+
+/* print a comment */
+static void xsddefault_print_comment(std::ostream& os,
+                                     uint64_t id,
+                                     comment const& cmt) {
+  if (cmt.get_comment_type() == com::centreon::engine::comment::host)
+    os << "hostcomment {\n";
+  else
+    os << "servicecomment {\n";
+  os << "\thost_id=" << cmt.get_host_id() << "\n";
+  if (cmt.get_comment_type() == com::centreon::engine::comment::service)
+    os << "\tservice_id=" << cmt.get_service_id() << "\n";
+  os << "\tentry_type=" << cmt.get_entry_type()
+     << "\n"
+        "\tcomment_id="
+     << id
+     << "\n"
+        "\tsource="
+     << cmt.get_source()
+     << "\n"
+        "\tpersistent="
+     << cmt.get_persistent()
+     << "\n"
+        "\tentry_time="
+     << static_cast<unsigned long>(cmt.get_entry_time())
+     << "\n"
+        "\texpires="
+     << cmt.get_expires()
+     << "\n"
+        "\texpire_time="
+     << static_cast<unsigned long>(cmt.get_expire_time())
+     << "\n"
+        "\tauthor="
+     << cmt.get_author()
+     << "\n"
+        "\tcomment_data="
+     << cmt.get_comment_data()
+     << "\n"
+        "\t}\n\n";
+}
+
+/* format the status data and replace the status file content, run in
+   the background */
+static int xsddefault_write_status_data(int fd,
+                                        std::string const& path,
+                                        std::shared_ptr<status_data> status) {
+  std::ostringstream stream;
+  stream << status->program_status;
+  for (host_status const& s : status->hosts)
+    xsddefault_print_host(stream, s, status->current_time);
+  for (service_status const& s : status->services)
+    xsddefault_print_service(stream, s, status->current_time);
+  for (contact_status const& c : status->contacts)
+    xsddefault_print_contact(stream, c);
+  for (std::pair<uint64_t, comment> const& cmt : status->comments)
+    xsddefault_print_comment(stream, cmt.first, cmt.second);
+  stream << status->downtimes;
+  std::string data(stream.str());
+  status.reset();
+
+  // Prepare status file for overwrite.
+  if ((ftruncate(fd, 0) == -1) || (fsync(fd) == -1) ||
+      (lseek(fd, 0, SEEK_SET) == (off_t)-1)) {
+    char const* msg(strerror(errno));
+    logger(engine::logging::log_runtime_error, engine::logging::basic)
+        << "Error: Unable to update status data file '" << path
+        << "': " << msg;
+    return ERROR;
+  }
+
+  // Write status file.
+  char const* data_ptr(data.c_str());
+  unsigned int size(data.size());
+  while (size > 0) {
+    ssize_t wb(write(fd, data_ptr, size));
+    if (wb <= 0) {
+      char const* msg(strerror(errno));
+      logger(engine::logging::log_runtime_error, engine::logging::basic)
+          << "Error: Unable to update status data file '" << path
+          << "': " << msg;
+      return ERROR;
+    }
+    data_ptr += wb;
+    size -= wb;
+  }
+
+  return OK;
+}
+
 /* write all status data to file */
 int xsddefault_save_status_data() {
   if (xsddefault_status_log_fd == -1)
     return OK;
 
+  // the previous status data are still being written.
+  if (xsddefault_pending_write.valid()) {
+    if (xsddefault_pending_write.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      logger(engine::logging::dbg_events, engine::logging::basic)
+          << "Status data file is still being written, update skipped";
+      return OK;
+    }
+    xsddefault_pending_write.get();
+  }
+
   int used_external_command_buffer_slots(0);
   int high_external_command_buffer_slots(0);
 
@@ -112,11 +749,8 @@ int xsddefault_save_status_data() {
 
   // get number of items in the command buffer
   if (config->check_external_commands()) {
-    // FIXME DBR
-    pthread_mutex_lock(&external_command_buffer.buffer_lock);
-    used_external_command_buffer_slots = external_command_buffer.items;
-    high_external_command_buffer_slots = external_command_buffer.high;
-    pthread_mutex_unlock(&external_command_buffer.buffer_lock);
+    used_external_command_buffer_slots = external_command_buffer.size();
+    high_external_command_buffer_slots = external_command_buffer.high();
   }
 
   // generate check statistics
@@ -292,472 +926,79 @@ int xsddefault_save_status_data() {
       << "\n"
          "\t}\n\n";
 
-  /* save host status data */
-  for (host_map::iterator it(com::centreon::engine::host::hosts.begin()),
-       end(com::centreon::engine::host::hosts.end());
+  std::shared_ptr<status_data> status(std::make_shared<status_data>());
+  status->current_time = current_time;
+  status->program_status = stream.str();
+
+  // copy host status data
+  status->hosts.reserve(host::hosts.size());
+  for (host_map::iterator it(host::hosts.begin()), end(host::hosts.end());
        it != end; ++it) {
-    stream
-        << "hoststatus {\n"
-           "\thost_name="
-        << it->second->get_name()
-        << "\n"
-           "\tmodified_attributes="
-        << it->second->get_modified_attributes()
-        << "\n"
-           "\tcheck_command="
-        << it->second->get_check_command()
-        << "\n"
-           "\tcheck_period="
-        << it->second->get_check_period()
-        << "\n"
-           "\tnotification_period="
-        << it->second->get_notification_period()
-        << "\n"
-           "\tcheck_interval="
-        << it->second->get_check_interval()
-        << "\n"
-           "\tretry_interval="
-        << it->second->get_retry_interval()
-        << "\n"
-           "\tevent_handler="
-        << it->second->get_event_handler()
-        << "\n"
-           "\thas_been_checked="
-        << it->second->has_been_checked()
-        << "\n"
-           "\tshould_be_scheduled="
-        << it->second->get_should_be_scheduled()
-        << "\n"
-           "\tcheck_execution_time="
-        << std::setprecision(3) << std::fixed
-        << it->second->get_execution_time()
-        << "\n"
-           "\tcheck_latency="
-        << std::setprecision(3) << std::fixed << it->second->get_latency()
-        << "\n"
-           "\tcheck_type="
-        << it->second->get_check_type()
-        << "\n"
-           "\tcurrent_state="
-        << it->second->get_current_state()
-        << "\n"
-           "\tlast_hard_state="
-        << it->second->get_last_hard_state()
-        << "\n"
-           "\tlast_event_id="
-        << it->second->get_last_event_id()
-        << "\n"
-           "\tcurrent_event_id="
-        << it->second->get_current_event_id()
-        << "\n"
-           "\tcurrent_problem_id="
-        << it->second->get_current_problem_id()
-        << "\n"
-           "\tlast_problem_id="
-        << it->second->get_last_problem_id()
-        << "\n"
-           "\tplugin_output="
-        << it->second->get_plugin_output()
-        << "\n"
-           "\tlong_plugin_output="
-        << it->second->get_long_plugin_output()
-        << "\n"
-           "\tperformance_data="
-        << it->second->get_perf_data()
-        << "\n"
-           "\tlast_check="
-        << static_cast<unsigned long>(it->second->get_last_check())
-        << "\n"
-           "\tnext_check="
-        << static_cast<unsigned long>(it->second->get_next_check())
-        << "\n"
-           "\tcheck_options="
-        << it->second->get_check_options()
-        << "\n"
-           "\tcurrent_attempt="
-        << it->second->get_current_attempt()
-        << "\n"
-           "\tmax_attempts="
-        << it->second->get_max_attempts()
-        << "\n"
-           "\tstate_type="
-        << it->second->get_state_type()
-        << "\n"
-           "\tlast_state_change="
-        << static_cast<unsigned long>(it->second->get_last_state_change())
-        << "\n"
-           "\tlast_hard_state_change="
-        << static_cast<unsigned long>(it->second->get_last_hard_state_change())
-        << "\n"
-           "\tlast_time_up="
-        << static_cast<unsigned long>(it->second->get_last_time_up())
-        << "\n"
-           "\tlast_time_down="
-        << static_cast<unsigned long>(it->second->get_last_time_down())
-        << "\n"
-           "\tlast_time_unreachable="
-        << static_cast<unsigned long>(it->second->get_last_time_unreachable())
-        << "\n"
-           "\tlast_notification="
-        << static_cast<unsigned long>(it->second->get_last_notification())
-        << "\n"
-           "\tnext_notification="
-        << static_cast<unsigned long>(it->second->get_next_notification())
-        << "\n"
-           "\tno_more_notifications="
-        << it->second->get_no_more_notifications()
-        << "\n"
-           "\tcurrent_notification_number="
-        << it->second->get_notification_number()
-        << "\n"
-           "\tcurrent_notification_id="
-        << it->second->get_current_notification_id()
-        << "\n"
-           "\tnotifications_enabled="
-        << it->second->get_notifications_enabled()
-        << "\n"
-           "\tproblem_has_been_acknowledged="
-        << it->second->get_problem_has_been_acknowledged()
-        << "\n"
-           "\tacknowledgement_type="
-        << it->second->get_acknowledgement_type()
-        << "\n"
-           "\tactive_checks_enabled="
-        << it->second->get_checks_enabled()
-        << "\n"
-           "\tpassive_checks_enabled="
-        << it->second->get_accept_passive_checks()
-        << "\n"
-           "\tevent_handler_enabled="
-        << it->second->get_event_handler_enabled()
-        << "\n"
-           "\tflap_detection_enabled="
-        << it->second->get_flap_detection_enabled()
-        << "\n"
-           "\tprocess_performance_data="
-        << it->second->get_process_performance_data()
-        << "\n"
-           "\tobsess_over_host="
-        << it->second->get_obsess_over()
-        << "\n"
-           "\tlast_update="
-        << static_cast<unsigned long>(current_time)
-        << "\n"
-           "\tis_flapping="
-        << it->second->get_is_flapping()
-        << "\n"
-           "\tpercent_state_change="
-        << std::setprecision(2) << std::fixed
-        << it->second->get_percent_state_change()
-        << "\n"
-           "\tscheduled_downtime_depth="
-        << it->second->get_scheduled_downtime_depth() << "\n";
-
-    // custom variables
-    for (auto const& cv : it->second->custom_variables) {
-      if (!cv.first.empty())
-        stream << "\t_" << cv.first << "=" << cv.second.has_been_modified()
-               << ";" << cv.second.get_value() << "\n";
-    }
-    stream << "\t}\n\n";
+    status->hosts.emplace_back();
+    host_status& s(status->hosts.back());
+    xsddefault_copy_status(s, *it->second);
+    s.name = it->second->get_name();
+    s.last_time_up = it->second->get_last_time_up();
+    s.last_time_down = it->second->get_last_time_down();
+    s.last_time_unreachable = it->second->get_last_time_unreachable();
   }
 
-  // save service status data
+  // copy service status data
+  status->services.reserve(service::services.size());
   for (service_map::iterator it(service::services.begin()),
        end(service::services.end());
        it != end; ++it) {
-    stream << "servicestatus {\n"
-              "\thost_name="
-           << it->second->get_hostname()
-           << "\n"
-              "\tservice_description="
-           << it->second->get_description()
-           << "\n"
-              "\tmodified_attributes="
-           << it->second->get_modified_attributes()
-           << "\n"
-              "\tcheck_command="
-           << it->second->get_check_command()
-           << "\n"
-              "\tcheck_period="
-           << it->second->get_check_period()
-           << "\n"
-              "\tnotification_period="
-           << it->second->get_notification_period()
-           << "\n"
-              "\tcheck_interval="
-           << it->second->get_check_interval()
-           << "\n"
-              "\tretry_interval="
-           << it->second->get_retry_interval()
-           << "\n"
-              "\tevent_handler="
-           << it->second->get_event_handler()
-           << "\n"
-              "\thas_been_checked="
-           << it->second->has_been_checked()
-           << "\n"
-              "\tshould_be_scheduled="
-           << it->second->get_should_be_scheduled()
-           << "\n"
-              "\tcheck_execution_time="
-           << std::setprecision(3) << std::fixed
-           << it->second->get_execution_time()
-           << "\n"
-              "\tcheck_latency="
-           << std::setprecision(3) << std::fixed << it->second->get_latency()
-           << "\n"
-              "\tcheck_type="
-           << it->second->get_check_type()
-           << "\n"
-              "\tcurrent_state="
-           << it->second->get_current_state()
-           << "\n"
-              "\tlast_hard_state="
-           << it->second->get_last_hard_state()
-           << "\n"
-              "\tlast_event_id="
-           << it->second->get_last_event_id()
-           << "\n"
-              "\tcurrent_event_id="
-           << it->second->get_current_event_id()
-           << "\n"
-              "\tcurrent_problem_id="
-           << it->second->get_current_problem_id()
-           << "\n"
-              "\tlast_problem_id="
-           << it->second->get_last_problem_id()
-           << "\n"
-              "\tcurrent_attempt="
-           << it->second->get_current_attempt()
-           << "\n"
-              "\tmax_attempts="
-           << it->second->get_max_attempts()
-           << "\n"
-              "\tstate_type="
-           << it->second->get_state_type()
-           << "\n"
-              "\tlast_state_change="
-           << static_cast<unsigned long>(it->second->get_last_state_change())
-           << "\n"
-              "\tlast_hard_state_change="
-           << static_cast<unsigned long>(
-                  it->second->get_last_hard_state_change())
-           << "\n"
-              "\tlast_time_ok="
-           << static_cast<unsigned long>(it->second->get_last_time_ok())
-           << "\n"
-              "\tlast_time_warning="
-           << static_cast<unsigned long>(it->second->get_last_time_warning())
-           << "\n"
-              "\tlast_time_unknown="
-           << static_cast<unsigned long>(it->second->get_last_time_unknown())
-           << "\n"
-              "\tlast_time_critical="
-           << static_cast<unsigned long>(it->second->get_last_time_critical())
-           << "\n"
-              "\tplugin_output="
-           << it->second->get_plugin_output()
-           << "\n"
-              "\tlong_plugin_output="
-           << it->second->get_long_plugin_output()
-           << "\n"
-              "\tperformance_data="
-           << it->second->get_perf_data()
-           << "\n"
-              "\tlast_check="
-           << static_cast<unsigned long>(it->second->get_last_check())
-           << "\n"
-              "\tnext_check="
-           << static_cast<unsigned long>(it->second->get_next_check())
-           << "\n"
-              "\tcheck_options="
-           << it->second->get_check_options()
-           << "\n"
-              "\tcurrent_notification_number="
-           << it->second->get_notification_number()
-           << "\n"
-              "\tcurrent_notification_id="
-           << it->second->get_current_notification_id()
-           << "\n"
-              "\tlast_notification="
-           << static_cast<unsigned long>(it->second->get_last_notification())
-           << "\n"
-              "\tnext_notification="
-           << static_cast<unsigned long>(it->second->get_next_notification())
-           << "\n"
-              "\tno_more_notifications="
-           << it->second->get_no_more_notifications()
-           << "\n"
-              "\tnotifications_enabled="
-           << it->second->get_notifications_enabled()
-           << "\n"
-              "\tactive_checks_enabled="
-           << it->second->get_checks_enabled()
-           << "\n"
-              "\tpassive_checks_enabled="
-           << it->second->get_accept_passive_checks()
-           << "\n"
-              "\tevent_handler_enabled="
-           << it->second->get_event_handler_enabled()
-           << "\n"
-              "\tproblem_has_been_acknowledged="
-           << it->second->get_problem_has_been_acknowledged()
-           << "\n"
-              "\tacknowledgement_type="
-           << it->second->get_acknowledgement_type()
-           << "\n"
-              "\tflap_detection_enabled="
-           << it->second->get_flap_detection_enabled()
-           << "\n"
-              "\tprocess_performance_data="
-           << it->second->get_process_performance_data()
-           << "\n"
-              "\tobsess_over_service="
-           << it->second->get_obsess_over()
-           << "\n"
-              "\tlast_update="
-           << static_cast<unsigned long>(current_time)
-           << "\n"
-              "\tis_flapping="
-           << it->second->get_is_flapping()
-           << "\n"
-              "\tpercent_state_change="
-           << std::setprecision(2) << std::fixed
-           << it->second->get_percent_state_change()
-           << "\n"
-              "\tscheduled_downtime_depth="
-           << it->second->get_scheduled_downtime_depth() << "\n";
-
-    // custom variables
-    for (auto const& cv : it->second->custom_variables) {
-      if (!cv.first.empty())
-        stream << "\t_" << cv.first << "=" << cv.second.has_been_modified()
-               << ";" << cv.second.get_value() << "\n";
-    }
-    stream << "\t}\n\n";
+    status->services.emplace_back();
+    service_status& s(status->services.back());
+    xsddefault_copy_status(s, *it->second);
+    s.hostname = it->second->get_hostname();
+    s.description = it->second->get_description();
+    s.last_time_ok = it->second->get_last_time_ok();
+    s.last_time_warning = it->second->get_last_time_warning();
+    s.last_time_unknown = it->second->get_last_time_unknown();
+    s.last_time_critical = it->second->get_last_time_critical();
   }
 
-  // save contact status data
+  // copy contact status data
+  status->contacts.reserve(contact::contacts.size());
   for (contact_map::const_iterator it{contact::contacts.begin()},
        end{contact::contacts.end()};
        it != end; ++it) {
-    contact* cntct(it->second.get());
-    stream << "contactstatus {\n"
-              "\tcontact_name="
-           << cntct->get_name()
-           << "\n"
-              "\tmodified_attributes="
-           << cntct->get_modified_attributes()
-           << "\n"
-              "\tmodified_host_attributes="
-           << cntct->get_modified_host_attributes()
-           << "\n"
-              "\tmodified_service_attributes="
-           << cntct->get_modified_service_attributes()
-           << "\n"
-              "\thost_notification_period="
-           << cntct->get_host_notification_period()
-           << "\n"
-              "\tservice_notification_period="
-           << cntct->get_service_notification_period()
-           << "\n"
-              "\tlast_host_notification="
-           << static_cast<unsigned long>(cntct->get_last_host_notification())
-           << "\n"
-              "\tlast_service_notification="
-           << static_cast<unsigned long>(cntct->get_last_service_notification())
-           << "\n"
-              "\thost_notifications_enabled="
-           << cntct->get_host_notifications_enabled()
-           << "\n"
-              "\tservice_notifications_enabled="
-           << cntct->get_service_notifications_enabled() << "\n";
-    // custom variables
-    for (auto const& cv : cntct->get_custom_variables()) {
-      if (!cv.first.empty())
-        stream << "\t_" << cv.first << "=" << cv.second.has_been_modified()
-               << ";" << cv.second.get_value() << "\n";
-    }
-    stream << "\t}\n\n";
+    contact const* cntct(it->second.get());
+    status->contacts.emplace_back();
+    contact_status& c(status->contacts.back());
+    c.name = cntct->get_name();
+    c.modified_attributes = cntct->get_modified_attributes();
+    c.modified_host_attributes = cntct->get_modified_host_attributes();
+    c.modified_service_attributes = cntct->get_modified_service_attributes();
+    c.host_notification_period = cntct->get_host_notification_period();
+    c.service_notification_period = cntct->get_service_notification_period();
+    c.last_host_notification = cntct->get_last_host_notification();
+    c.last_service_notification = cntct->get_last_service_notification();
+    c.host_notifications_enabled = cntct->get_host_notifications_enabled();
+    c.service_notifications_enabled =
+        cntct->get_service_notifications_enabled();
+    c.custom_variables = cntct->get_custom_variables();
   }
 
-  // save all comments
+  // copy all comments
+  status->comments.reserve(comment::comments.size());
   for (comment_map::iterator it(comment::comments.begin()),
        end(comment::comments.end());
-       it != end; ++it) {
-    if (it->second->get_comment_type() == com::centreon::engine::comment::host)
-      stream << "hostcomment {\n";
-    else
-      stream << "servicecomment {\n";
-    stream << "\thost_id=" << it->second->get_host_id() << "\n";
-    if (it->second->get_comment_type() ==
-        com::centreon::engine::comment::service)
-      stream << "\tservice_id=" << it->second->get_service_id() << "\n";
-    stream << "\tentry_type=" << it->second->get_entry_type()
-           << "\n"
-              "\tcomment_id="
-           << it->first
-           << "\n"
-              "\tsource="
-           << it->second->get_source()
-           << "\n"
-              "\tpersistent="
-           << it->second->get_persistent()
-           << "\n"
-              "\tentry_time="
-           << static_cast<unsigned long>(it->second->get_entry_time())
-           << "\n"
-              "\texpires="
-           << it->second->get_expires()
-           << "\n"
-              "\texpire_time="
-           << static_cast<unsigned long>(it->second->get_expire_time())
-           << "\n"
-              "\tauthor="
-           << it->second->get_author()
-           << "\n"
-              "\tcomment_data="
-           << it->second->get_comment_data()
-           << "\n"
-              "\t}\n\n";
-  }
+       it != end; ++it)
+    status->comments.emplace_back(it->first, *it->second);
 
   // save all downtime
+  std::ostringstream downtimes;
   for (std::pair<time_t, std::shared_ptr<downtime>> const& dt :
        downtime_manager::instance().get_scheduled_downtimes())
-    stream << *dt.second;
-
-  // Write data in buffer.
-  stream.flush();
-
-  // Prepare status file for overwrite.
-  if ((ftruncate(xsddefault_status_log_fd, 0) == -1) ||
-      (fsync(xsddefault_status_log_fd) == -1) ||
-      (lseek(xsddefault_status_log_fd, 0, SEEK_SET) == (off_t)-1)) {
-    char const* msg(strerror(errno));
-    logger(engine::logging::log_runtime_error, engine::logging::basic)
-        << "Error: Unable to update status data file '" << config->status_file()
-        << "': " << msg;
-    return ERROR;
-  }
+    downtimes << *dt.second;
+  status->downtimes = downtimes.str();
 
-  // Write status file.
-  std::string data(stream.str());
-  char const* data_ptr(data.c_str());
-  unsigned int size(data.size());
-  while (size > 0) {
-    ssize_t wb(write(xsddefault_status_log_fd, data_ptr, size));
-    if (wb <= 0) {
-      char const* msg(strerror(errno));
-      logger(engine::logging::log_runtime_error, engine::logging::basic)
-          << "Error: Unable to update status data file '"
-          << config->status_file() << "': " << msg;
-      return ERROR;
-    }
-    data_ptr += wb;
-    size -= wb;
-  }
+  // Format and write status file in the background.
+  xsddefault_pending_write =
+      std::async(std::launch::async, &xsddefault_write_status_data,
+                 xsddefault_status_log_fd, config->status_file(), status);
 
   return OK;
 }
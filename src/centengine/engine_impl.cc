@@ -1665,19 +1665,19 @@ grpc::Status engine_impl::DeleteHostDowntimeFull(
     const DowntimeCriterias* request,
     CommandSuccess* response) {
   auto fn = std::packaged_task<int32_t(void)>([request]() -> int32_t {
-    downtime::type downtime_type = downtime::host_downtime;
+    std::vector<std::shared_ptr<downtimes::downtime>> candidates;
+    /* with a host name, only downtimes of this host are browsed */
+    if (!request->host_name().empty())
+      candidates = downtime_manager::instance().find_downtimes(
+          downtime::host_downtime, request->host_name(), "");
+    else
+      for (auto const& p :
+           downtime_manager::instance().get_scheduled_downtimes())
+        if (p.second->get_type() == downtime::host_downtime)
+          candidates.push_back(p.second);
+
     std::list<std::shared_ptr<downtimes::downtime>> dtlist;
-    for (auto it = downtimes::downtime_manager::instance()
-                       .get_scheduled_downtimes()
-                       .begin(),
-              end = downtimes::downtime_manager::instance()
-                        .get_scheduled_downtimes()
-                        .end();
-         it != end; ++it) {
-      auto dt = it->second;
-      if (!(request->host_name().empty()) &&
-          dt->get_hostname() != request->host_name())
-        continue;
+    for (auto const& dt : candidates) {
       if (request->has_start() &&
           dt->get_start_time() != request->start().value())
         continue;
@@ -1730,21 +1730,22 @@ grpc::Status engine_impl::DeleteServiceDowntimeFull(
     const DowntimeCriterias* request,
     CommandSuccess* response) {
   auto fn = std::packaged_task<int32_t(void)>([request]() -> int32_t {
-    downtime::type downtime_type = downtime::service_downtime;
+    std::vector<std::shared_ptr<downtimes::downtime>> candidates;
+    /* with a host name, only downtimes of its services are browsed */
+    if (!request->host_name().empty())
+      candidates = downtime_manager::instance().find_downtimes(
+          downtime::service_downtime, request->host_name(),
+          request->service_desc());
+    else
+      for (auto const& p :
+           downtime_manager::instance().get_scheduled_downtimes())
+        if (p.second->get_type() == downtime::service_downtime)
+          candidates.push_back(p.second);
+
     std::list<service_downtime*> dtlist;
-    /* iterate through all current downtime(s) */
-    for (auto it = downtimes::downtime_manager::instance()
-                       .get_scheduled_downtimes()
-                       .begin(),
-              end = downtimes::downtime_manager::instance()
-                        .get_scheduled_downtimes()
-                        .end();
-         it != end; ++it) {
-      service_downtime* dt = static_cast<service_downtime*>(it->second.get());
+    for (auto const& d : candidates) {
+      service_downtime* dt = static_cast<service_downtime*>(d.get());
       /* we are checking if request criteria match with the downtime criteria */
-      if (!(request->host_name().empty()) &&
-          (dt->get_hostname() != request->host_name()))
-        continue;
       if (!(request->service_desc().empty()) &&
           (dt->get_service_description() != request->service_desc()))
         continue;
@@ -1861,7 +1862,7 @@ grpc::Status engine_impl::DeleteDowntimeByHostGroupName(
     std::string host_name;
     std::string service_desc;
     std::string comment_data;
-    uint32_t deleted;
+    uint32_t deleted{0};
 
     auto it = hostgroup::hostgroups.find(host_group_name);
     if (it == hostgroup::hostgroups.end() || !it->second)
@@ -1884,10 +1885,10 @@ grpc::Status engine_impl::DeleteDowntimeByHostGroupName(
         continue;
       if (!(host_name.empty()) && it_h->first != host_name)
         continue;
-      deleted =
+      deleted +=
           downtime_manager::instance()
               .delete_downtime_by_hostname_service_description_start_time_comment(
-                  host_name, service_desc, start_time, comment_data);
+                  it_h->first, service_desc, start_time, comment_data);
     }
 
     if (deleted == 0)
@@ -2730,6 +2731,30 @@ grpc::Status engine_impl::ProcessServiceCheckResult(grpc::ServerContext* context
   return grpc::Status::OK;
 }
 
+grpc::Status engine_impl::ProcessServiceCheckResultById(
+    grpc::ServerContext* context __attribute__((unused)),
+    const CheckById* request,
+    CommandSuccess* response __attribute__((unused))) {
+  if (!request->host_id())
+    return grpc::Status(::grpc::StatusCode::INVALID_ARGUMENT,
+                        "host_id must not be null");
+
+  if (!request->service_id())
+    return grpc::Status(::grpc::StatusCode::INVALID_ARGUMENT,
+                        "service_id must not be null");
+
+  auto fn = std::packaged_task<int(void)>(
+      std::bind(&command_manager::process_passive_service_check_by_id,
+                &command_manager::instance(),
+                google::protobuf::util::TimeUtil::TimestampToSeconds(
+                    request->check_time()),
+                request->host_id(), request->service_id(), request->code(),
+                request->output()));
+  command_manager::instance().enqueue(std::move(fn));
+
+  return grpc::Status::OK;
+}
+
 grpc::Status engine_impl::ProcessHostCheckResult(grpc::ServerContext* context
                                                  __attribute__((unused)),
                                                  const Check* request,
@@ -2770,8 +2795,123 @@ grpc::Status engine_impl::NewThresholdsFile(grpc::ServerContext* context
                                             CommandSuccess* response
                                             __attribute__((unused))) {
   const std::string& filename = request->filename();
-  auto fn = std::packaged_task<int(void)>(
-      std::bind(&anomalydetection::update_thresholds, filename));
+  /* The file is parsed here, only the update of the services is done by
+   * the main loop. */
+  auto entries =
+      std::make_shared<std::vector<anomalydetection::thresholds_entry>>();
+  if (anomalydetection::parse_thresholds_file(filename, *entries) < 0)
+    return grpc::Status::OK;
+  auto fn = std::packaged_task<int(void)>([filename, entries]() -> int {
+    return anomalydetection::apply_thresholds(filename, *entries);
+  });
   command_manager::instance().enqueue(std::move(fn));
   return grpc::Status::OK;
 }
+
+/**
+ * @brief Queue a chunk of passive check results. While the command_manager
+ * queue is full, we wait here, so the results of a stream are not read
+ * faster than the main loop handles them.
+ *
+ * @param context The context of the request
+ * @param chunk The check results to queue
+ *
+ * @return true if the chunk is queued, false if the request was cancelled.
+ */
+static bool enqueue_check_results(grpc::ServerContext* context,
+                                  std::vector<Check>&& chunk) {
+  while (!command_manager::instance().enqueue_check_results(
+      std::move(chunk), std::chrono::seconds(1)))
+    if (context->IsCancelled())
+      return false;
+  return true;
+}
+
+/**
+ * @brief Receive a stream of passive check results. A result without service
+ * description is a host check result. Results are given to the
+ * command_manager by chunks instead of one task per result.
+ *
+ * @param context The context of the request
+ * @param reader The stream of check results
+ * @param response How many results have been accepted and rejected
+ *
+ * @return Status::OK, or Status::CANCELLED if the client went away while
+ * results were waiting for the main loop.
+ */
+grpc::Status engine_impl::ProcessCheckResults(
+    grpc::ServerContext* context,
+    grpc::ServerReader<Check>* reader,
+    CheckResultsCount* response) {
+  uint64_t accepted = 0, rejected = 0;
+  std::vector<Check> chunk;
+  chunk.reserve(command_manager::check_results_chunk);
+  Check c;
+  while (reader->Read(&c)) {
+    if (c.host_name().empty()) {
+      ++rejected;
+      continue;
+    }
+    chunk.emplace_back(std::move(c));
+    if (chunk.size() >= command_manager::check_results_chunk) {
+      size_t size = chunk.size();
+      if (!enqueue_check_results(context, std::move(chunk)))
+        return grpc::Status::CANCELLED;
+      accepted += size;
+      chunk.clear();
+      chunk.reserve(command_manager::check_results_chunk);
+    }
+  }
+  size_t size = chunk.size();
+  if (!enqueue_check_results(context, std::move(chunk)))
+    return grpc::Status::CANCELLED;
+  accepted += size;
+
+  response->set_accepted(accepted);
+  response->set_rejected(rejected);
+  return grpc::Status::OK;
+}
+
+/**
+ * @brief Same as ProcessCheckResults() but with all the results in one
+ * message.
+ *
+ * @param context The context of the request
+ * @param request The list of check results
+ * @param response How many results have been accepted and rejected
+ *
+ * @return Status::OK, or Status::CANCELLED if the client went away while
+ * results were waiting for the main loop.
+ */
+grpc::Status engine_impl::ProcessCheckResultsBatch(
+    grpc::ServerContext* context,
+    const CheckList* request,
+    CheckResultsCount* response) {
+  uint64_t accepted = 0, rejected = 0;
+  std::vector<Check> chunk;
+  for (Check const& c : request->checks()) {
+    if (c.host_name().empty()) {
+      ++rejected;
+      continue;
+    }
+    if (chunk.empty())
+      chunk.reserve(std::min<size_t>(command_manager::check_results_chunk,
+                                     request->checks_size()));
+    chunk.push_back(c);
+    if (chunk.size() >= command_manager::check_results_chunk) {
+      size_t size = chunk.size();
+      if (!enqueue_check_results(context, std::move(chunk)))
+        return grpc::Status::CANCELLED;
+      accepted += size;
+      chunk.clear();
+    }
+  }
+  size_t size = chunk.size();
+  if (!enqueue_check_results(context, std::move(chunk)))
+    return grpc::Status::CANCELLED;
+  accepted += size;
+
+  response->set_accepted(accepted);
+  response->set_rejected(rejected);
+  return grpc::Status::OK;
+}
@@ -31,6 +31,7 @@
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/notifier.hh"
 #include "com/centreon/engine/objects.hh"
+#include "com/centreon/engine/status_snapshot.hh"
 #include "com/centreon/engine/string.hh"
 #include "com/centreon/exceptions/basic.hh"
 #include "engine-version.hh"
@@ -48,6 +49,8 @@ using namespace com::centreon::engine;
 static char* main_config_file(NULL);
 static char* stats_file(NULL);
 static char* status_file(NULL);
+static char* status_snapshot_file(NULL);
+static bool status_snapshot_read(false);
 
 time_t status_creation_date = 0L;
 char* status_version = NULL;
@@ -207,6 +210,7 @@ void get_time_breakdown(unsigned long, int*, int*, int*, int*);
 int read_config_file();
 int read_stats_file();
 int read_status_file();
+int read_status_snapshot();
 void strip(char*);
 
 /**
@@ -340,8 +344,10 @@ int main(int argc, char* argv[]) {
           throw basic_error("Error processing config file '{}'",
                             main_config_file);
 
-        // Read status file.
-        if (read_status_file() == ERROR) {
+        // Read status snapshot if available, status file otherwise.
+        if (status_snapshot_file && read_status_snapshot() == OK)
+          status_snapshot_read = true;
+        else if (read_status_file() == ERROR) {
           char const* msg(strerror(errno));
           throw basic_error(
               "Error reading status file '{}': {}", status_file, msg);
@@ -369,6 +375,8 @@ int main(int argc, char* argv[]) {
   stats_file = NULL;
   delete[] status_file;
   status_file = NULL;
+  delete[] status_snapshot_file;
+  status_snapshot_file = NULL;
 
   return (retval);
 }
@@ -386,7 +394,9 @@ int display_stats() {
   printf("CURRENT STATUS DATA\n");
   printf("------------------------------------------------------\n");
   printf("Status File:                            %s\n",
-         (stats_file != NULL) ? stats_file : status_file);
+         (stats_file != NULL)
+             ? stats_file
+             : (status_snapshot_read ? status_snapshot_file : status_file));
   time_difference = (current_time - status_creation_date);
   get_time_breakdown(time_difference, &days, &hours, &minutes, &seconds);
   printf("Status File Age:                        %dd %dh %dm %ds\n",
@@ -603,6 +613,14 @@ int read_config_file() {
       if (status_file)
         delete[] status_file;
       status_file = string::dup(val);
+    } else if (!strcmp(var, "status_snapshot_file")) {
+      delete[] status_snapshot_file;
+      // Relative paths are relative to the main configuration file.
+      std::string path(val);
+      char const* slash(strrchr(main_config_file, '/'));
+      if (!path.empty() && path[0] != '/' && slash)
+        path.insert(0, main_config_file, slash + 1 - main_config_file);
+      status_snapshot_file = string::dup(path);
     }
   }
 
@@ -610,6 +628,367 @@ int read_config_file() {
   return (OK);
 }
 
+/**
+ *  Compute the active check totals from the check statistics.
+ */
+static void compute_check_totals() {
+  /* 02-15-2008 exclude cached host checks from total (they were
+   * ondemand checks that never actually executed) */
+  active_host_checks_last_1min =
+      active_scheduled_host_checks_last_1min +
+      active_ondemand_host_checks_last_1min;
+  active_host_checks_last_5min =
+      active_scheduled_host_checks_last_5min +
+      active_ondemand_host_checks_last_5min;
+  active_host_checks_last_15min =
+      active_scheduled_host_checks_last_15min +
+      active_ondemand_host_checks_last_15min;
+
+  /* 02-15-2008 exclude cached service checks from total (they were
+   * ondemand checks that never actually executed) */
+  active_service_checks_last_1min =
+      active_scheduled_service_checks_last_1min +
+      active_ondemand_service_checks_last_1min;
+  active_service_checks_last_5min =
+      active_scheduled_service_checks_last_5min +
+      active_ondemand_service_checks_last_5min;
+  active_service_checks_last_15min =
+      active_scheduled_service_checks_last_15min +
+      active_ondemand_service_checks_last_15min;
+}
+
+/**
+ *  Account for the status of a host in the statistics.
+ *
+ *  @param[in] current_time         Current time.
+ *  @param[in] execution_time       Check execution time.
+ *  @param[in] latency              Check latency.
+ *  @param[in] check_type           Active or passive check.
+ *  @param[in] current_state        Host state.
+ *  @param[in] state_change         Percent state change.
+ *  @param[in] is_flapping          Whether the host is flapping.
+ *  @param[in] downtime_depth       Scheduled downtime depth.
+ *  @param[in] last_check           Last check time.
+ *  @param[in] should_be_scheduled  Whether the host is scheduled.
+ *  @param[in] has_been_checked     Whether the host has been checked.
+ */
+static void add_host_status(time_t current_time,
+                            double execution_time,
+                            double latency,
+                            int check_type,
+                            int current_state,
+                            double state_change,
+                            int is_flapping,
+                            int downtime_depth,
+                            time_t last_check,
+                            int should_be_scheduled,
+                            int has_been_checked) {
+  unsigned long time_difference;
+  average_host_state_change = (((average_host_state_change *
+                                 ((double)status_host_entries - 1.0)) +
+                                state_change) /
+                               (double)status_host_entries);
+  if (have_min_host_state_change == false ||
+      min_host_state_change > state_change) {
+    have_min_host_state_change = true;
+    min_host_state_change = state_change;
+  }
+  if (have_max_host_state_change == false ||
+      max_host_state_change < state_change) {
+    have_max_host_state_change = true;
+    max_host_state_change = state_change;
+  }
+  if (check_type == checkable::check_active) {
+    active_host_checks++;
+    average_active_host_latency =
+        (((average_active_host_latency *
+           ((double)active_host_checks - 1.0)) +
+          latency) /
+         (double)active_host_checks);
+    if (have_min_active_host_latency == false ||
+        min_active_host_latency > latency) {
+      have_min_active_host_latency = true;
+      min_active_host_latency = latency;
+    }
+    if (have_max_active_host_latency == false ||
+        max_active_host_latency < latency) {
+      have_max_active_host_latency = true;
+      max_active_host_latency = latency;
+    }
+    average_active_host_execution_time =
+        (((average_active_host_execution_time *
+           ((double)active_host_checks - 1.0)) +
+          execution_time) /
+         (double)active_host_checks);
+    if (have_min_active_host_execution_time == false ||
+        min_active_host_execution_time > execution_time) {
+      have_min_active_host_execution_time = true;
+      min_active_host_execution_time = execution_time;
+    }
+    if (have_max_active_host_execution_time == false ||
+        max_active_host_execution_time < execution_time) {
+      have_max_active_host_execution_time = true;
+      max_active_host_execution_time = execution_time;
+    }
+    average_active_host_state_change =
+        (((average_active_host_state_change *
+           ((double)active_host_checks - 1.0)) +
+          state_change) /
+         (double)active_host_checks);
+    if (have_min_active_host_state_change == false ||
+        min_active_host_state_change > state_change) {
+      have_min_active_host_state_change = true;
+      min_active_host_state_change = state_change;
+    }
+    if (have_max_active_host_state_change == false ||
+        max_active_host_state_change < state_change) {
+      have_max_active_host_state_change = true;
+      max_active_host_state_change = state_change;
+    }
+    time_difference = current_time - last_check;
+    if (time_difference <= 3600)
+      active_hosts_checked_last_1hour++;
+    if (time_difference <= 900)
+      active_hosts_checked_last_15min++;
+    if (time_difference <= 300)
+      active_hosts_checked_last_5min++;
+    if (time_difference <= 60)
+      active_hosts_checked_last_1min++;
+  } else {
+    passive_host_checks++;
+    average_passive_host_latency =
+        (((average_passive_host_latency *
+           ((double)passive_host_checks - 1.0)) +
+          latency) /
+         (double)passive_host_checks);
+    if (have_min_passive_host_latency == false ||
+        min_passive_host_latency > latency) {
+      have_min_passive_host_latency = true;
+      min_passive_host_latency = latency;
+    }
+    if (have_max_passive_host_latency == false ||
+        max_passive_host_latency < latency) {
+      have_max_passive_host_latency = true;
+      max_passive_host_latency = latency;
+    }
+    average_passive_host_state_change =
+        (((average_passive_host_state_change *
+           ((double)passive_host_checks - 1.0)) +
+          state_change) /
+         (double)passive_host_checks);
+    if (have_min_passive_host_state_change == false ||
+        min_passive_host_state_change > state_change) {
+      have_min_passive_host_state_change = true;
+      min_passive_host_state_change = state_change;
+    }
+    if (have_max_passive_host_state_change == false ||
+        max_passive_host_state_change < state_change) {
+      have_max_passive_host_state_change = true;
+      max_passive_host_state_change = state_change;
+    }
+    time_difference = current_time - last_check;
+    if (time_difference <= 3600)
+      passive_hosts_checked_last_1hour++;
+    if (time_difference <= 900)
+      passive_hosts_checked_last_15min++;
+    if (time_difference <= 300)
+      passive_hosts_checked_last_5min++;
+    if (time_difference <= 60)
+      passive_hosts_checked_last_1min++;
+  }
+  switch (current_state) {
+    case host::state_up:
+      hosts_up++;
+      break;
+    case host::state_down:
+      hosts_down++;
+      break;
+    case host::state_unreachable:
+      hosts_unreachable++;
+      break;
+    default:
+      break;
+  }
+  if (is_flapping == true)
+    hosts_flapping++;
+  if (downtime_depth > 0)
+    hosts_in_downtime++;
+  if (has_been_checked == true)
+    hosts_checked++;
+  if (should_be_scheduled == true)
+    hosts_scheduled++;
+}
+
+/**
+ *  Account for the status of a service in the statistics.
+ *
+ *  @param[in] current_time         Current time.
+ *  @param[in] execution_time       Check execution time.
+ *  @param[in] latency              Check latency.
+ *  @param[in] check_type           Active or passive check.
+ *  @param[in] current_state        Service state.
+ *  @param[in] state_change         Percent state change.
+ *  @param[in] is_flapping          Whether the service is flapping.
+ *  @param[in] downtime_depth       Scheduled downtime depth.
+ *  @param[in] last_check           Last check time.
+ *  @param[in] should_be_scheduled  Whether the service is scheduled.
+ *  @param[in] has_been_checked     Whether the service has been checked.
+ */
+static void add_service_status(time_t current_time,
+                               double execution_time,
+                               double latency,
+                               int check_type,
+                               int current_state,
+                               double state_change,
+                               int is_flapping,
+                               int downtime_depth,
+                               time_t last_check,
+                               int should_be_scheduled,
+                               int has_been_checked) {
+  unsigned long time_difference;
+  average_service_state_change =
+      (((average_service_state_change *
+         ((double)status_service_entries - 1.0)) +
+        state_change) /
+       (double)status_service_entries);
+  if (have_min_service_state_change == false ||
+      min_service_state_change > state_change) {
+    have_min_service_state_change = true;
+    min_service_state_change = state_change;
+  }
+  if (have_max_service_state_change == false ||
+      max_service_state_change < state_change) {
+    have_max_service_state_change = true;
+    max_service_state_change = state_change;
+  }
+  if (check_type == checkable::check_active) {
+    active_service_checks++;
+    average_active_service_latency =
+        (((average_active_service_latency *
+           ((double)active_service_checks - 1.0)) +
+          latency) /
+         (double)active_service_checks);
+    if (have_min_active_service_latency == false ||
+        min_active_service_latency > latency) {
+      have_min_active_service_latency = true;
+      min_active_service_latency = latency;
+    }
+    if (have_max_active_service_latency == false ||
+        max_active_service_latency < latency) {
+      have_max_active_service_latency = true;
+      max_active_service_latency = latency;
+    }
+    average_active_service_execution_time =
+        (((average_active_service_execution_time *
+           ((double)active_service_checks - 1.0)) +
+          execution_time) /
+         (double)active_service_checks);
+    if (have_min_active_service_execution_time == false ||
+        min_active_service_execution_time > execution_time) {
+      have_min_active_service_execution_time = true;
+      min_active_service_execution_time = execution_time;
+    }
+    if (have_max_active_service_execution_time == false ||
+        max_active_service_execution_time < execution_time) {
+      have_max_active_service_execution_time = true;
+      max_active_service_execution_time = execution_time;
+    }
+    average_active_service_state_change =
+        (((average_active_service_state_change *
+           ((double)active_service_checks - 1.0)) +
+          state_change) /
+         (double)active_service_checks);
+    if (have_min_active_service_state_change == false ||
+        min_active_service_state_change > state_change) {
+      have_min_active_service_state_change = true;
+      min_active_service_state_change = state_change;
+    }
+    if (have_max_active_service_state_change == false ||
+        max_active_service_state_change < state_change) {
+      have_max_active_service_state_change = true;
+      max_active_service_state_change = state_change;
+    }
+    time_difference = current_time - last_check;
+    if (time_difference <= 3600)
+      active_services_checked_last_1hour++;
+    if (time_difference <= 900)
+      active_services_checked_last_15min++;
+    if (time_difference <= 300)
+      active_services_checked_last_5min++;
+    if (time_difference <= 60)
+      active_services_checked_last_1min++;
+  } else {
+    passive_service_checks++;
+    average_passive_service_latency =
+        (((average_passive_service_latency *
+           ((double)passive_service_checks - 1.0)) +
+          latency) /
+         (double)passive_service_checks);
+    if (have_min_passive_service_latency == false ||
+        min_passive_service_latency > latency) {
+      have_min_passive_service_latency = true;
+      min_passive_service_latency = latency;
+    }
+    if (have_max_passive_service_latency == false ||
+        max_passive_service_latency < latency) {
+      have_max_passive_service_latency = true;
+      max_passive_service_latency = latency;
+    }
+    average_passive_service_state_change =
+        (((average_passive_service_state_change *
+           ((double)passive_service_checks - 1.0)) +
+          state_change) /
+         (double)passive_service_checks);
+    if (have_min_passive_service_state_change == false ||
+        min_passive_service_state_change > state_change) {
+      have_min_passive_service_state_change = true;
+      min_passive_service_state_change = state_change;
+    }
+    if (have_max_passive_service_state_change == false ||
+        max_passive_service_state_change < state_change) {
+      have_max_passive_service_state_change = true;
+      max_passive_service_state_change = state_change;
+    }
+    time_difference = current_time - last_check;
+    if (time_difference <= 3600)
+      passive_services_checked_last_1hour++;
+    if (time_difference <= 900)
+      passive_services_checked_last_15min++;
+    if (time_difference <= 300)
+      passive_services_checked_last_5min++;
+    if (time_difference <= 60)
+      passive_services_checked_last_1min++;
+  }
+  switch (current_state) {
+    case service::state_ok:
+      services_ok++;
+      break;
+
+    case service::state_warning:
+      services_warning++;
+      break;
+
+    case service::state_unknown:
+      services_unknown++;
+      break;
+
+    case service::state_critical:
+      services_critical++;
+      break;
+
+    default:
+      break;
+  }
+  if (is_flapping == true)
+    services_flapping++;
+  if (downtime_depth > 0)
+    services_in_downtime++;
+  if (has_been_checked == true)
+    services_checked++;
+  if (should_be_scheduled == true)
+    services_scheduled++;
+}
+
 int read_status_file() {
   char temp_buffer[MAX_INPUT_BUFFER];
   FILE* fp = NULL;
@@ -618,7 +997,6 @@ int read_status_file() {
   char* val = NULL;
   char* temp_ptr = NULL;
   time_t current_time;
-  unsigned long time_difference = 0L;
 
   double execution_time = 0.0;
   double latency = 0.0;
@@ -664,309 +1042,21 @@ int read_status_file() {
           break;
 
         case STATUS_PROGRAM_DATA:
-          /* 02-15-2008 exclude cached host checks from total (they were
-           * ondemand checks that never actually executed) */
-          active_host_checks_last_1min =
-              active_scheduled_host_checks_last_1min +
-              active_ondemand_host_checks_last_1min;
-          active_host_checks_last_5min =
-              active_scheduled_host_checks_last_5min +
-              active_ondemand_host_checks_last_5min;
-          active_host_checks_last_15min =
-              active_scheduled_host_checks_last_15min +
-              active_ondemand_host_checks_last_15min;
-
-          /* 02-15-2008 exclude cached service checks from total (they were
-           * ondemand checks that never actually executed) */
-          active_service_checks_last_1min =
-              active_scheduled_service_checks_last_1min +
-              active_ondemand_service_checks_last_1min;
-          active_service_checks_last_5min =
-              active_scheduled_service_checks_last_5min +
-              active_ondemand_service_checks_last_5min;
-          active_service_checks_last_15min =
-              active_scheduled_service_checks_last_15min +
-              active_ondemand_service_checks_last_15min;
+          compute_check_totals();
           break;
 
         case STATUS_HOST_DATA:
-          average_host_state_change = (((average_host_state_change *
-                                         ((double)status_host_entries - 1.0)) +
-                                        state_change) /
-                                       (double)status_host_entries);
-          if (have_min_host_state_change == false ||
-              min_host_state_change > state_change) {
-            have_min_host_state_change = true;
-            min_host_state_change = state_change;
-          }
-          if (have_max_host_state_change == false ||
-              max_host_state_change < state_change) {
-            have_max_host_state_change = true;
-            max_host_state_change = state_change;
-          }
-          if (check_type == checkable::check_active) {
-            active_host_checks++;
-            average_active_host_latency =
-                (((average_active_host_latency *
-                   ((double)active_host_checks - 1.0)) +
-                  latency) /
-                 (double)active_host_checks);
-            if (have_min_active_host_latency == false ||
-                min_active_host_latency > latency) {
-              have_min_active_host_latency = true;
-              min_active_host_latency = latency;
-            }
-            if (have_max_active_host_latency == false ||
-                max_active_host_latency < latency) {
-              have_max_active_host_latency = true;
-              max_active_host_latency = latency;
-            }
-            average_active_host_execution_time =
-                (((average_active_host_execution_time *
-                   ((double)active_host_checks - 1.0)) +
-                  execution_time) /
-                 (double)active_host_checks);
-            if (have_min_active_host_execution_time == false ||
-                min_active_host_execution_time > execution_time) {
-              have_min_active_host_execution_time = true;
-              min_active_host_execution_time = execution_time;
-            }
-            if (have_max_active_host_execution_time == false ||
-                max_active_host_execution_time < execution_time) {
-              have_max_active_host_execution_time = true;
-              max_active_host_execution_time = execution_time;
-            }
-            average_active_host_state_change =
-                (((average_active_host_state_change *
-                   ((double)active_host_checks - 1.0)) +
-                  state_change) /
-                 (double)active_host_checks);
-            if (have_min_active_host_state_change == false ||
-                min_active_host_state_change > state_change) {
-              have_min_active_host_state_change = true;
-              min_active_host_state_change = state_change;
-            }
-            if (have_max_active_host_state_change == false ||
-                max_active_host_state_change < state_change) {
-              have_max_active_host_state_change = true;
-              max_active_host_state_change = state_change;
-            }
-            time_difference = current_time - last_check;
-            if (time_difference <= 3600)
-              active_hosts_checked_last_1hour++;
-            if (time_difference <= 900)
-              active_hosts_checked_last_15min++;
-            if (time_difference <= 300)
-              active_hosts_checked_last_5min++;
-            if (time_difference <= 60)
-              active_hosts_checked_last_1min++;
-          } else {
-            passive_host_checks++;
-            average_passive_host_latency =
-                (((average_passive_host_latency *
-                   ((double)passive_host_checks - 1.0)) +
-                  latency) /
-                 (double)passive_host_checks);
-            if (have_min_passive_host_latency == false ||
-                min_passive_host_latency > latency) {
-              have_min_passive_host_latency = true;
-              min_passive_host_latency = latency;
-            }
-            if (have_max_passive_host_latency == false ||
-                max_passive_host_latency < latency) {
-              have_max_passive_host_latency = true;
-              max_passive_host_latency = latency;
-            }
-            average_passive_host_state_change =
-                (((average_passive_host_state_change *
-                   ((double)passive_host_checks - 1.0)) +
-                  state_change) /
-                 (double)passive_host_checks);
-            if (have_min_passive_host_state_change == false ||
-                min_passive_host_state_change > state_change) {
-              have_min_passive_host_state_change = true;
-              min_passive_host_state_change = state_change;
-            }
-            if (have_max_passive_host_state_change == false ||
-                max_passive_host_state_change < state_change) {
-              have_max_passive_host_state_change = true;
-              max_passive_host_state_change = state_change;
-            }
-            time_difference = current_time - last_check;
-            if (time_difference <= 3600)
-              passive_hosts_checked_last_1hour++;
-            if (time_difference <= 900)
-              passive_hosts_checked_last_15min++;
-            if (time_difference <= 300)
-              passive_hosts_checked_last_5min++;
-            if (time_difference <= 60)
-              passive_hosts_checked_last_1min++;
-          }
-          switch (current_state) {
-            case host::state_up:
-              hosts_up++;
-              break;
-            case host::state_down:
-              hosts_down++;
-              break;
-            case host::state_unreachable:
-              hosts_unreachable++;
-              break;
-            default:
-              break;
-          }
-          if (is_flapping == true)
-            hosts_flapping++;
-          if (downtime_depth > 0)
-            hosts_in_downtime++;
-          if (has_been_checked == true)
-            hosts_checked++;
-          if (should_be_scheduled == true)
-            hosts_scheduled++;
+          add_host_status(current_time, execution_time, latency, check_type,
+                          current_state, state_change, is_flapping,
+                          downtime_depth, last_check, should_be_scheduled,
+                          has_been_checked);
           break;
 
         case STATUS_SERVICE_DATA:
-          average_service_state_change =
-              (((average_service_state_change *
-                 ((double)status_service_entries - 1.0)) +
-                state_change) /
-               (double)status_service_entries);
-          if (have_min_service_state_change == false ||
-              min_service_state_change > state_change) {
-            have_min_service_state_change = true;
-            min_service_state_change = state_change;
-          }
-          if (have_max_service_state_change == false ||
-              max_service_state_change < state_change) {
-            have_max_service_state_change = true;
-            max_service_state_change = state_change;
-          }
-          if (check_type == checkable::check_active) {
-            active_service_checks++;
-            average_active_service_latency =
-                (((average_active_service_latency *
-                   ((double)active_service_checks - 1.0)) +
-                  latency) /
-                 (double)active_service_checks);
-            if (have_min_active_service_latency == false ||
-                min_active_service_latency > latency) {
-              have_min_active_service_latency = true;
-              min_active_service_latency = latency;
-            }
-            if (have_max_active_service_latency == false ||
-                max_active_service_latency < latency) {
-              have_max_active_service_latency = true;
-              max_active_service_latency = latency;
-            }
-            average_active_service_execution_time =
-                (((average_active_service_execution_time *
-                   ((double)active_service_checks - 1.0)) +
-                  execution_time) /
-                 (double)active_service_checks);
-            if (have_min_active_service_execution_time == false ||
-                min_active_service_execution_time > execution_time) {
-              have_min_active_service_execution_time = true;
-              min_active_service_execution_time = execution_time;
-            }
-            if (have_max_active_service_execution_time == false ||
-                max_active_service_execution_time < execution_time) {
-              have_max_active_service_execution_time = true;
-              max_active_service_execution_time = execution_time;
-            }
-            average_active_service_state_change =
-                (((average_active_service_state_change *
-                   ((double)active_service_checks - 1.0)) +
-                  state_change) /
-                 (double)active_service_checks);
-            if (have_min_active_service_state_change == false ||
-                min_active_service_state_change > state_change) {
-              have_min_active_service_state_change = true;
-              min_active_service_state_change = state_change;
-            }
-            if (have_max_active_service_state_change == false ||
-                max_active_service_state_change < state_change) {
-              have_max_active_service_state_change = true;
-              max_active_service_state_change = state_change;
-            }
-            time_difference = current_time - last_check;
-            if (time_difference <= 3600)
-              active_services_checked_last_1hour++;
-            if (time_difference <= 900)
-              active_services_checked_last_15min++;
-            if (time_difference <= 300)
-              active_services_checked_last_5min++;
-            if (time_difference <= 60)
-              active_services_checked_last_1min++;
-          } else {
-            passive_service_checks++;
-            average_passive_service_latency =
-                (((average_passive_service_latency *
-                   ((double)passive_service_checks - 1.0)) +
-                  latency) /
-                 (double)passive_service_checks);
-            if (have_min_passive_service_latency == false ||
-                min_passive_service_latency > latency) {
-              have_min_passive_service_latency = true;
-              min_passive_service_latency = latency;
-            }
-            if (have_max_passive_service_latency == false ||
-                max_passive_service_latency < latency) {
-              have_max_passive_service_latency = true;
-              max_passive_service_latency = latency;
-            }
-            average_passive_service_state_change =
-                (((average_passive_service_state_change *
-                   ((double)passive_service_checks - 1.0)) +
-                  state_change) /
-                 (double)passive_service_checks);
-            if (have_min_passive_service_state_change == false ||
-                min_passive_service_state_change > state_change) {
-              have_min_passive_service_state_change = true;
-              min_passive_service_state_change = state_change;
-            }
-            if (have_max_passive_service_state_change == false ||
-                max_passive_service_state_change < state_change) {
-              have_max_passive_service_state_change = true;
-              max_passive_service_state_change = state_change;
-            }
-            time_difference = current_time - last_check;
-            if (time_difference <= 3600)
-              passive_services_checked_last_1hour++;
-            if (time_difference <= 900)
-              passive_services_checked_last_15min++;
-            if (time_difference <= 300)
-              passive_services_checked_last_5min++;
-            if (time_difference <= 60)
-              passive_services_checked_last_1min++;
-          }
-          switch (current_state) {
-            case service::state_ok:
-              services_ok++;
-              break;
-
-            case service::state_warning:
-              services_warning++;
-              break;
-
-            case service::state_unknown:
-              services_unknown++;
-              break;
-
-            case service::state_critical:
-              services_critical++;
-              break;
-
-            default:
-              break;
-          }
-          if (is_flapping == true)
-            services_flapping++;
-          if (downtime_depth > 0)
-            services_in_downtime++;
-          if (has_been_checked == true)
-            services_checked++;
-          if (should_be_scheduled == true)
-            services_scheduled++;
+          add_service_status(current_time, execution_time, latency,
+                             check_type, current_state, state_change,
+                             is_flapping, downtime_depth, last_check,
+                             should_be_scheduled, has_been_checked);
           break;
 
         default:
@@ -1149,6 +1239,86 @@ int read_status_file() {
   return (OK);
 }
 
+/**
+ *  Read the binary status snapshot maintained by Centreon Engine.
+ *
+ *  @return OK if a consistent snapshot was read, ERROR otherwise.
+ */
+int read_status_snapshot() {
+  status_snapshot::reader reader;
+  if (!reader.read(status_snapshot_file))
+    return (ERROR);
+
+  status_snapshot::header const& h(reader.get_header());
+  status_creation_date = h.created;
+  status_version = string::dup(std::to_string(h.version));
+  program_start = h.program_start;
+  nagios_pid = h.pid;
+  total_external_command_buffer_slots = h.total_external_command_buffer_slots;
+  used_external_command_buffer_slots = h.used_external_command_buffer_slots;
+  high_external_command_buffer_slots = h.high_external_command_buffer_slots;
+
+  struct {
+    int* last_1min;
+    int* last_5min;
+    int* last_15min;
+  } const stats[MAX_CHECK_STATS_TYPES] = {
+      {&active_scheduled_service_checks_last_1min,
+       &active_scheduled_service_checks_last_5min,
+       &active_scheduled_service_checks_last_15min},
+      {&active_ondemand_service_checks_last_1min,
+       &active_ondemand_service_checks_last_5min,
+       &active_ondemand_service_checks_last_15min},
+      {&passive_service_checks_last_1min, &passive_service_checks_last_5min,
+       &passive_service_checks_last_15min},
+      {&active_scheduled_host_checks_last_1min,
+       &active_scheduled_host_checks_last_5min,
+       &active_scheduled_host_checks_last_15min},
+      {&active_ondemand_host_checks_last_1min,
+       &active_ondemand_host_checks_last_5min,
+       &active_ondemand_host_checks_last_15min},
+      {&passive_host_checks_last_1min, &passive_host_checks_last_5min,
+       &passive_host_checks_last_15min},
+      {&active_cached_host_checks_last_1min,
+       &active_cached_host_checks_last_5min,
+       &active_cached_host_checks_last_15min},
+      {&active_cached_service_checks_last_1min,
+       &active_cached_service_checks_last_5min,
+       &active_cached_service_checks_last_15min},
+      {&external_commands_last_1min, &external_commands_last_5min,
+       &external_commands_last_15min},
+      {&parallel_host_checks_last_1min, &parallel_host_checks_last_5min,
+       &parallel_host_checks_last_15min},
+      {&serial_host_checks_last_1min, &serial_host_checks_last_5min,
+       &serial_host_checks_last_15min}};
+  for (int i(0); i < MAX_CHECK_STATS_TYPES; ++i) {
+    *stats[i].last_1min = h.check_stats[i][0];
+    *stats[i].last_5min = h.check_stats[i][1];
+    *stats[i].last_15min = h.check_stats[i][2];
+  }
+  compute_check_totals();
+
+  time_t current_time;
+  time(&current_time);
+  for (uint32_t i(0); i < h.host_count; ++i) {
+    status_snapshot::record const& r(reader.hosts()[i]);
+    ++status_host_entries;
+    add_host_status(current_time, r.execution_time, r.latency, r.check_type,
+                    r.current_state, r.percent_state_change, r.is_flapping,
+                    r.scheduled_downtime_depth, r.last_check,
+                    r.should_be_scheduled, r.has_been_checked);
+  }
+  for (uint32_t i(0); i < h.service_count; ++i) {
+    status_snapshot::record const& r(reader.services()[i]);
+    ++status_service_entries;
+    add_service_status(current_time, r.execution_time, r.latency,
+                       r.check_type, r.current_state, r.percent_state_change,
+                       r.is_flapping, r.scheduled_downtime_depth, r.last_check,
+                       r.should_be_scheduled, r.has_been_checked);
+  }
+  return (OK);
+}
+
 int read_stats_file() {
   char temp_buffer[MAX_INPUT_BUFFER];
   FILE* fp = NULL;
@@ -28,6 +28,7 @@
 #include "com/centreon/connector/perl/checks/timeout.hh"
 #include "com/centreon/connector/perl/embedded_perl.hh"
 #include "com/centreon/connector/perl/multiplexer.hh"
+#include "com/centreon/connector/perl/worker_pool.hh"
 
 using namespace com::centreon;
 using namespace com::centreon::connector;
@@ -81,12 +82,18 @@ void check::error(handle& h) {
 pid_t check::execute(uint64_t cmd_id,
                      std::string const& cmd,
                      const timestamp& tmt) {
-  // Run process.
-  int fds[3];
-  _child = embedded_perl::instance().run(cmd, fds);
-  ::close(fds[0]);
-  _out.set_fd(fds[1]);
-  _err.set_fd(fds[2]);
+  // Run check on a pre-forked interpreter, outputs will be sent with
+  // its termination. Or run process.
+  bool forked(!worker_pool::enabled());
+  if (!forked)
+    _child = worker_pool::instance().run(cmd);
+  else {
+    int fds[3];
+    _child = embedded_perl::instance().run(cmd, fds);
+    ::close(fds[0]);
+    _out.set_fd(fds[1]);
+    _err.set_fd(fds[2]);
+  }
 
   // Store command ID.
   log::core()->debug("check {0} has ID {1}", static_cast<void*>(this),
@@ -94,8 +101,10 @@ pid_t check::execute(uint64_t cmd_id,
   _cmd_id = cmd_id;
 
   // Register with multiplexer.
-  multiplexer::instance().handle_manager::add(&_err, this);
-  multiplexer::instance().handle_manager::add(&_out, this);
+  if (forked) {
+    multiplexer::instance().handle_manager::add(&_err, this);
+    multiplexer::instance().handle_manager::add(&_out, this);
+  }
 
   // Register timeout.
   std::unique_ptr<timeout> t(new timeout(this, false));
@@ -129,16 +138,16 @@ void check::on_timeout(bool final) {
   // Reset timeout task ID.
   _timeout = 0;
 
-  if (_child <= 0)
+  if (_child == (pid_t)-1)
     return;
 
   if (final) {
     // Send SIGKILL (not catchable, not ignorable).
-    kill(_child, SIGKILL);
+    _kill(SIGKILL);
     _child = (pid_t)-1;
   } else {
     // Try graceful shutdown.
-    kill(_child, SIGTERM);
+    _kill(SIGTERM);
 
     // Schedule a final timeout.
     std::unique_ptr<timeout> t(new timeout(this, true));
@@ -205,6 +214,21 @@ void check::terminated(int exit_code) {
   _send_result_and_unregister(r);
 }
 
+/**
+ *  Check process termination, when outputs were not read from pipes.
+ *
+ *  @param[in] exit_code  Check exit code.
+ *  @param[in] output     Check standard output.
+ *  @param[in] error      Check standard error.
+ */
+void check::terminated(int exit_code,
+                       std::string const& output,
+                       std::string const& error) {
+  _stdout.append(output);
+  _stderr.append(error);
+  terminated(exit_code);
+}
+
 /**
  *  Unlisten the check.
  *
@@ -243,6 +267,19 @@ void check::write([[maybe_unused]] handle& h) {
  *                                     *
  **************************************/
 
+/**
+ *  Send a signal to the process running the check.
+ *
+ *  @param[in] signum Signal.
+ */
+void check::_kill(int signum) {
+  if (_child < (pid_t)-1) {
+    if (worker_pool::enabled())
+      worker_pool::instance().kill(_child, signum);
+  } else if (_child > 0)
+    kill(_child, signum);
+}
+
 /**
  *  Send check result and unregister.
  *
@@ -250,8 +287,8 @@ void check::write([[maybe_unused]] handle& h) {
  */
 void check::_send_result_and_unregister(result const& r) {
   // Kill subprocess.
-  if (_child > 0) {
-    kill(_child, SIGKILL);
+  if (_child != (pid_t)-1) {
+    _kill(SIGKILL);
     _child = (pid_t)-1;
   }
 
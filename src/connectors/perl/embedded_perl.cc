@@ -24,9 +24,13 @@
 #include <perl.h>
 #include <unistd.h>
 
+#include <cerrno>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <list>
+#include <memory>
 
 using namespace com::centreon;
 using namespace com::centreon::connector::perl;
@@ -42,6 +46,96 @@ PerlInterpreter* my_perl(nullptr);
 // Allow module loading.
 EXTERN_C void xs_init(pTHX);
 
+/**
+ *  Split a command line into the script path and its arguments.
+ *
+ *  @param[in]  cmd   Command line.
+ *  @param[out] file  Script path.
+ *  @param[out] args  Script arguments.
+ */
+static void split_command(std::string const& cmd,
+                          std::string& file,
+                          std::string& args) {
+  size_t pos(cmd.find(' '));
+  if (pos != std::string::npos) {
+    file = cmd.substr(0, pos);
+    args = cmd.substr(pos + 1);
+  } else
+    file = cmd;
+  connector::log::core()->debug("command {}", cmd);
+  connector::log::core()->debug("  - file {}", file);
+  connector::log::core()->debug("  - args {}", args);
+}
+
+namespace {
+/**
+ *  Redirect a descriptor of the process to an anonymous temporary file
+ *  as long as the object lives. Processes spawned meanwhile inherit the
+ *  redirection, so their output is captured as well.
+ */
+class fd_capture {
+  int _fd;
+  int _saved;
+  FILE* _file;
+
+ public:
+  /**
+   *  Start capture.
+   *
+   *  @param[in] fd  Descriptor to redirect.
+   */
+  fd_capture(int fd) : _fd(fd), _saved(dup(fd)), _file(tmpfile()) {
+    if (_saved < 0 || !_file || dup2(fileno(_file), _fd) < 0) {
+      char const* msg(strerror(errno));
+      if (_saved >= 0)
+        close(_saved);
+      if (_file)
+        fclose(_file);
+      throw basic_error("cannot capture descriptor {}: {}", _fd, msg);
+    }
+  }
+
+  /**
+   *  Restore the descriptor.
+   */
+  ~fd_capture() {
+    _restore();
+    fclose(_file);
+  }
+
+  fd_capture(fd_capture const&) = delete;
+  fd_capture& operator=(fd_capture const&) = delete;
+
+  /**
+   *  Restore the descriptor and fetch what was written to it.
+   *
+   *  @param[out] data  Captured data.
+   */
+  void release(std::string& data) {
+    _restore();
+    data.clear();
+    int fd(fileno(_file));
+    if (lseek(fd, 0, SEEK_SET) < 0)
+      return;
+    char buffer[4096];
+    ssize_t rb;
+    while ((rb = ::read(fd, buffer, sizeof(buffer))) > 0 ||
+           (rb < 0 && errno == EINTR))
+      if (rb > 0)
+        data.append(buffer, rb);
+  }
+
+ private:
+  void _restore() {
+    if (_saved >= 0) {
+      dup2(_saved, _fd);
+      close(_saved);
+      _saved = -1;
+    }
+  }
+};
+}  // namespace
+
 /**************************************
  *                                     *
  *           Public Methods            *
@@ -66,6 +160,83 @@ embedded_perl::~embedded_perl() {
   }
 }
 
+/**
+ *  Run a Perl script within the current process. Exit is trapped,
+ *  standard output and error of the script and of its children are
+ *  captured, signal handlers and alarm set by the script are reset.
+ *
+ *  @param[in]  cmd     Command to execute.
+ *  @param[out] output  Standard output of the script.
+ *  @param[out] error   Standard error of the script.
+ *
+ *  @return Exit code of the script.
+ */
+int embedded_perl::execute(std::string const& cmd,
+                           std::string& output,
+                           std::string& error) {
+  std::string args;
+  std::string file;
+  split_command(cmd, file, args);
+
+  SV* handle;
+  try {
+    handle = _compile(file);
+  }
+  catch (std::exception const& e) {
+    error = e.what();
+    return 3;
+  }
+
+  // Redirect outputs of the process, the script and its children write
+  // there.
+  fflush(stdout);
+  fflush(stderr);
+  std::unique_ptr<fd_capture> out_capture;
+  std::unique_ptr<fd_capture> err_capture;
+  try {
+    out_capture.reset(new fd_capture(STDOUT_FILENO));
+    err_capture.reset(new fd_capture(STDERR_FILENO));
+  }
+  catch (std::exception const& e) {
+    error = e.what();
+    return 3;
+  }
+
+  // Run check.
+  int retval(3);
+  std::string perl_error;
+  dSP;
+  ENTER;
+  SAVETMPS;
+  PUSHMARK(SP);
+  XPUSHs(sv_2mortal(newSVpv(file.c_str(), 0)));
+  XPUSHs(handle);
+  XPUSHs(sv_2mortal(newSVpv(args.c_str(), 0)));
+  PUTBACK;
+  int count(call_pv("Embed::Persistent::run_file_captured", G_ARRAY | G_EVAL));
+  SPAGAIN;
+  if (count == 2) {
+    STRLEN len;
+    SV* err(POPs);
+    char const* data(SvPV(err, len));
+    perl_error.assign(data, len);
+    retval = POPi;
+  } else {
+    SP -= count;
+    perl_error = fmt::format("error while executing Perl script '{}': {}",
+                             file, SvPV_nolen(ERRSV));
+  }
+  PUTBACK;
+  FREETMPS;
+  LEAVE;
+
+  // Fetch outputs.
+  out_capture->release(output);
+  err_capture->release(error);
+  error.append(perl_error);
+  return retval & 0xff;
+}
+
 /**
  *  Get instance.
  *
@@ -104,46 +275,13 @@ pid_t embedded_perl::run(std::string const& cmd, int fds[3]) {
         "cannot run Perl script without fetching process' descriptors");
 
   // Extract arguments.
-  size_t pos(cmd.find(' '));
   std::string args;
   std::string file;
-  if (pos != std::string::npos) {
-    file = cmd.substr(0, pos);
-    args = cmd.substr(pos + 1);
-  } else
-    file = cmd;
-  log::core()->debug("command {}", cmd);
-  log::core()->debug("  - file {}", file);
-  log::core()->debug("  - args {}", args);
+  split_command(cmd, file, args);
 
-  // Check if file has already been compiled.
-  SV* handle;
-  umap<std::string, SV*>::const_iterator it(_parsed.find(file));
+  // Compile Perl file if not already done.
+  SV* handle(_compile(file));
   dSP;
-  if (it == _parsed.end()) {
-    // Compile Perl file.
-    {
-      log::core()->debug("parsing file {}", file);
-      char const* argv[3];
-      argv[0] = file.c_str();
-      argv[1] = "0";
-      argv[2] = nullptr;
-      if (call_argv("Embed::Persistent::eval_file",
-                    G_EVAL | G_SCALAR,
-                    (char**)argv) != 1)
-        throw basic_error("could not compile Perl script {}", file);
-    }
-    SPAGAIN;
-    handle = POPs;
-    if (SvTRUE(ERRSV))
-      throw basic_error("Embedded Perl error: {}", SvPV_nolen(ERRSV));
-
-    // Insert in parsed file list.
-    _parsed.insert(std::make_pair(file, handle));
-  }
-  // Already parsed.
-  else
-    handle = it->second;
 
   // Open pipes.
   int in_pipe[2];
@@ -261,6 +399,42 @@ void embedded_perl::unload() {
  *                                     *
  **************************************/
 
+/**
+ *  Compile a Perl script, or get it from the cache of compiled scripts.
+ *
+ *  @param[in] file  Script path.
+ *
+ *  @return Handle of the compiled script.
+ */
+SV* embedded_perl::_compile(std::string const& file) {
+  // Check if file has already been compiled.
+  umap<std::string, SV*>::const_iterator it(_parsed.find(file));
+  if (it != _parsed.end())
+    return it->second;
+
+  // Compile Perl file.
+  dSP;
+  {
+    log::core()->debug("parsing file {}", file);
+    char const* argv[3];
+    argv[0] = file.c_str();
+    argv[1] = "0";
+    argv[2] = nullptr;
+    if (call_argv("Embed::Persistent::eval_file",
+                  G_EVAL | G_SCALAR,
+                  (char**)argv) != 1)
+      throw basic_error("could not compile Perl script {}", file);
+  }
+  SPAGAIN;
+  SV* handle(POPs);
+  if (SvTRUE(ERRSV))
+    throw basic_error("Embedded Perl error: {}", SvPV_nolen(ERRSV));
+
+  // Insert in parsed file list.
+  _parsed.insert(std::make_pair(file, handle));
+  return handle;
+}
+
 /**
  *  Constructor.
  *
@@ -25,6 +25,7 @@
 #include "com/centreon/connector/perl/multiplexer.hh"
 #include "com/centreon/connector/perl/options.hh"
 #include "com/centreon/connector/perl/policy.hh"
+#include "com/centreon/connector/perl/worker_pool.hh"
 #include "com/centreon/exceptions/basic.hh"
 
 using namespace com::centreon;
@@ -113,6 +114,27 @@ int main(int argc, char** argv, char** env) {
                                ? opts.get_argument("code").get_value().c_str()
                                : nullptr));
 
+      // Pre-fork Perl interpreters.
+      if (opts.get_argument("workers").get_is_set()) {
+        uint32_t workers(
+            strtoul(opts.get_argument("workers").get_value().c_str(),
+                    nullptr, 10));
+        uint32_t max_checks(1000);
+        if (opts.get_argument("worker-max-checks").get_is_set())
+          max_checks = strtoul(
+              opts.get_argument("worker-max-checks").get_value().c_str(),
+              nullptr, 10);
+        uint32_t max_memory(0);
+        if (opts.get_argument("worker-max-memory").get_is_set())
+          max_memory =
+              strtoul(
+                  opts.get_argument("worker-max-memory").get_value().c_str(),
+                  nullptr, 10) *
+              1024;
+        if (workers)
+          worker_pool::load(workers, max_checks, max_memory);
+      }
+
       // Program policy.
       policy p;
       retval = (p.run() ? EXIT_SUCCESS : EXIT_FAILURE);
@@ -122,6 +144,7 @@ int main(int argc, char** argv, char** env) {
   }
 
   // Deinitializations.
+  worker_pool::unload();
   embedded_perl::unload();
   multiplexer::unload();
 
@@ -32,6 +32,15 @@ static char const* const version_description =
     "Print software version and exit.";
 static char const* const log_file_description =
     "Specifies the log file (default: stderr).";
+static char const* const workers_description =
+    "Number of pre-forked Perl interpreters running checks (default: 0, "
+    "fork the connector for each check).";
+static char const* const worker_max_checks_description =
+    "Number of checks after which a pre-forked interpreter is replaced "
+    "(default: 1000).";
+static char const* const worker_max_memory_description =
+    "Resident memory in megabytes above which a pre-forked interpreter is "
+    "replaced (default: 0, no limit).";
 
 /**************************************
  *                                     *
@@ -60,7 +69,10 @@ std::string options::help() const {
       << "  --debug    " << debug_description << "\n"
       << "  --help     " << help_description << "\n"
       << "  --version  " << version_description << "\n"
-      << "  --code     " << code_description << "\n";
+      << "  --code     " << code_description << "\n"
+      << "  --workers  " << workers_description << "\n"
+      << "  --worker-max-checks  " << worker_max_checks_description << "\n"
+      << "  --worker-max-memory  " << worker_max_memory_description << "\n";
   return oss.str();
 }
 
@@ -132,4 +144,31 @@ void options::_init() {
     arg.set_description(log_file_description);
     arg.set_has_value(true);
   }
+
+  // Workers.
+  {
+    misc::argument& arg(_arguments['w']);
+    arg.set_name('w');
+    arg.set_long_name("workers");
+    arg.set_description(workers_description);
+    arg.set_has_value(true);
+  }
+
+  // Checks per worker.
+  {
+    misc::argument& arg(_arguments['k']);
+    arg.set_name('k');
+    arg.set_long_name("worker-max-checks");
+    arg.set_description(worker_max_checks_description);
+    arg.set_has_value(true);
+  }
+
+  // Memory per worker.
+  {
+    misc::argument& arg(_arguments['m']);
+    arg.set_name('m');
+    arg.set_long_name("worker-max-memory");
+    arg.set_description(worker_max_memory_description);
+    arg.set_has_value(true);
+  }
 }
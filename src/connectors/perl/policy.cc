@@ -29,6 +29,7 @@
 #include "com/centreon/connector/log.hh"
 #include "com/centreon/connector/perl/checks/check.hh"
 #include "com/centreon/connector/perl/multiplexer.hh"
+#include "com/centreon/connector/perl/worker_pool.hh"
 #include "com/centreon/exceptions/basic.hh"
 
 using namespace com::centreon;
@@ -177,6 +178,8 @@ bool policy::run() {
     while (child != 0 && child != (pid_t) - 1) {
       // Handle process termination.
       log::core()->info("process {0} exited with status {1}", status);
+      if (worker_pool::enabled())
+        worker_pool::instance().on_exit(child);
       std::map<pid_t, checks::check*>::iterator it;
       it = _checks.find(child);
       if (it != _checks.end()) {
@@ -201,6 +204,18 @@ bool policy::run() {
       char const* msg(strerror(errno));
       throw basic_error("waitpid failed: {}", msg);
     }
+
+    // Checks completed by pre-forked interpreters.
+    if (worker_pool::enabled())
+      for (worker_pool::completion const& c :
+           worker_pool::instance().completions()) {
+        std::map<pid_t, checks::check*>::iterator it(_checks.find(c.id));
+        if (it != _checks.end()) {
+          std::unique_ptr<checks::check> chk(it->second);
+          _checks.erase(it);
+          chk->terminated(c.exit_code, c.output, c.error);
+        }
+      }
   }
 
   // Run as long as some data remains.
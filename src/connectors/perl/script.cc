@@ -26,6 +26,17 @@ char const* const com::centreon::connector::perl::embedded_perl::_script =
     "use Text::ParseWords qw(parse_line);\n"
     "\n"
     "our %Cache;\n"
+    "our $Captured = 0;\n"
+    "\n"
+    "# Within run_file_captured, exit() unwinds back to the caller instead\n"
+    "# of terminating the interpreter.\n"
+    "BEGIN {\n"
+    "  *CORE::GLOBAL::exit = sub (;$) {\n"
+    "    my $code = @_ ? 0 + $_[0] : 0;\n"
+    "    die bless(\\$code, 'Embed::Persistent::Exit') if ($Captured);\n"
+    "    CORE::exit($code);\n"
+    "  };\n"
+    "}\n"
     "\n"
     "use constant MTIME_IDX  => 0;\n"
     "use constant HANDLE_IDX => 1;\n"
@@ -108,4 +119,49 @@ char const* const com::centreon::connector::perl::embedded_perl::_script =
     "    die \"could not run '$filename': $@\";\n"
     "  }\n"
     "  return ($res);\n"
+    "}\n"
+    "\n"
+    "sub run_file_captured {\n"
+    "  # Fetch arguments.\n"
+    "  my ($filename, $handle, $args) = @_;\n"
+    "\n"
+    "  # Parse arguments.\n"
+    "  my @parsed_args = (\"$filename\");\n"
+    "  push(@parsed_args, parse_line('\\s+', 0, $args));\n"
+    "\n"
+    "  # Save signal handlers and pending alarm, the script must not leave\n"
+    "  # them behind for the next one run by this interpreter.\n"
+    "  my %saved_sig = %SIG;\n"
+    "  my $saved_alarm = alarm(0);\n"
+    "\n"
+    "  # Run subroutine. Its outputs are the process' descriptors, redirected\n"
+    "  # by the caller, so that children spawned by the script write there\n"
+    "  # too.\n"
+    "  my $err = '';\n"
+    "  my $code = 3;\n"
+    "  {\n"
+    "    local $Captured = 1;\n"
+    "    my $previous = select(STDOUT);\n"
+    "    $| = 1;\n"
+    "    select($previous);\n"
+    "    eval { $handle->(@parsed_args) };\n"
+    "    if (ref($@) eq 'Embed::Persistent::Exit') {\n"
+    "      $code = ${$@};\n"
+    "    }\n"
+    "    else {\n"
+    "      chomp($@);\n"
+    "      $err = \"error while executing Perl script '$filename': $@\";\n"
+    "    }\n"
+    "  }\n"
+    "\n"
+    "  # Flush what the script left buffered, restore signal handlers and\n"
+    "  # alarm.\n"
+    "  select((select(STDOUT), $| = 1)[0]);\n"
+    "  select((select(STDERR), $| = 1)[0]);\n"
+    "  alarm(0);\n"
+    "  foreach my $name (keys(%SIG)) {\n"
+    "    $SIG{$name} = $saved_sig{$name};\n"
+    "  }\n"
+    "  alarm($saved_alarm);\n"
+    "  return ($code, $err);\n"
     "}\n\n";
@@ -0,0 +1,541 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/connector/perl/worker_pool.hh"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+#include "com/centreon/connector/log.hh"
+#include "com/centreon/connector/perl/embedded_perl.hh"
+#include "com/centreon/connector/perl/multiplexer.hh"
+#include "com/centreon/exceptions/basic.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::exceptions;
+using namespace com::centreon::connector;
+using namespace com::centreon::connector::perl;
+
+// Worker pool instance.
+static worker_pool* _instance = nullptr;
+
+/**
+ *  Read exactly size bytes from a file descriptor.
+ *
+ *  @return false on end of file or error.
+ */
+static bool read_all(int fd, void* data, size_t size) {
+  char* p(static_cast<char*>(data));
+  while (size) {
+    ssize_t rb(::read(fd, p, size));
+    if (rb < 0 && errno == EINTR)
+      continue;
+    if (rb <= 0)
+      return false;
+    p += rb;
+    size -= rb;
+  }
+  return true;
+}
+
+/**
+ *  Write exactly size bytes to a file descriptor.
+ *
+ *  @return false on error.
+ */
+static bool write_all(int fd, void const* data, size_t size) {
+  char const* p(static_cast<char const*>(data));
+  while (size) {
+    ssize_t wb(::write(fd, p, size));
+    if (wb < 0 && errno == EINTR)
+      continue;
+    if (wb <= 0)
+      return false;
+    p += wb;
+    size -= wb;
+  }
+  return true;
+}
+
+/**
+ *  Write a request to a worker. SIGPIPE is blocked meanwhile so that
+ *  a worker that exited does not terminate the connector.
+ *
+ *  @return false if the worker is not reachable.
+ */
+static bool write_request(int fd, std::string const& request) {
+  sigset_t pipe_set;
+  sigset_t old_set;
+  sigemptyset(&pipe_set);
+  sigaddset(&pipe_set, SIGPIPE);
+  pthread_sigmask(SIG_BLOCK, &pipe_set, &old_set);
+  bool retval(write_all(fd, request.data(), request.size()));
+  if (!retval && errno == EPIPE) {
+    timespec zero{0, 0};
+    sigtimedwait(&pipe_set, nullptr, &zero);
+  }
+  pthread_sigmask(SIG_SETMASK, &old_set, nullptr);
+  return retval;
+}
+
+/**
+ *  Get the resident memory of the current process.
+ *
+ *  @return Resident memory in kilobytes, 0 if it is not available.
+ */
+static uint32_t resident_memory() {
+  unsigned long size(0);
+  unsigned long resident(0);
+  FILE* f(fopen("/proc/self/statm", "r"));
+  if (f) {
+    if (fscanf(f, "%lu %lu", &size, &resident) != 2)
+      resident = 0;
+    fclose(f);
+  }
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+/**************************************
+ *                                     *
+ *           Public Methods            *
+ *                                     *
+ **************************************/
+
+/**
+ *  Destructor. Workers are asked to exit and waited for.
+ */
+worker_pool::~worker_pool() {
+  std::vector<pid_t> pids;
+  for (std::unique_ptr<worker>& w : _workers) {
+    if (w->running != -1 && !w->dead)
+      ::kill(w->pid, SIGKILL);
+    w->retire();
+    pids.push_back(w->pid);
+  }
+  for (std::unique_ptr<worker>& w : _retired)
+    pids.push_back(w->pid);
+  _workers.clear();
+  _retired.clear();
+  for (pid_t pid : pids)
+    waitpid(pid, nullptr, 0);
+}
+
+/**
+ *  Get the checks completed since the last call.
+ *
+ *  @return List of completed checks.
+ */
+std::list<worker_pool::completion> worker_pool::completions() {
+  std::list<completion> retval;
+  retval.swap(_completions);
+  return retval;
+}
+
+/**
+ *  Check if checks are run by a worker pool.
+ *
+ *  @return true if the pool is loaded.
+ */
+bool worker_pool::enabled() noexcept { return _instance; }
+
+/**
+ *  Get instance.
+ *
+ *  @return Worker pool instance.
+ */
+worker_pool& worker_pool::instance() { return *_instance; }
+
+/**
+ *  Send a signal to the worker running a check. A check that is still
+ *  waiting for a worker is removed from the queue and completed with
+ *  the same exit code as a killed process.
+ *
+ *  @param[in] id      Check ID.
+ *  @param[in] signum  Signal.
+ */
+void worker_pool::kill(pid_t id, int signum) {
+  for (std::unique_ptr<worker>& w : _workers)
+    if (w->running == id) {
+      ::kill(w->pid, signum);
+      return;
+    }
+
+  for (auto it(_queue.begin()), end(_queue.end()); it != end; ++it)
+    if (it->first == id) {
+      _queue.erase(it);
+      _completions.push_back({id, -1, std::string(), std::string()});
+      return;
+    }
+}
+
+/**
+ *  Load the worker pool. Embedded Perl must be loaded first.
+ *
+ *  @param[in] size        Number of workers.
+ *  @param[in] max_checks  Number of checks after which a worker is
+ *                         replaced.
+ *  @param[in] max_memory  Resident memory in kilobytes above which a
+ *                         worker is replaced, 0 for no limit.
+ */
+void worker_pool::load(uint32_t size,
+                       uint32_t max_checks,
+                       uint32_t max_memory) {
+  if (!_instance)
+    _instance = new worker_pool(size, max_checks, max_memory);
+}
+
+/**
+ *  Notify the pool that a child process terminated. Workers that
+ *  exited unexpectedly (crash, timeout) are replaced and the check
+ *  they were running is completed with the exit code of a killed
+ *  process.
+ *
+ *  @param[in] pid  Process ID.
+ */
+void worker_pool::on_exit(pid_t pid) {
+  for (auto it(_retired.begin()), end(_retired.end()); it != end; ++it)
+    if ((*it)->pid == pid) {
+      _retired.erase(it);
+      return;
+    }
+
+  for (std::unique_ptr<worker>& w : _workers)
+    if (w->pid == pid) {
+      log::core()->info("Perl worker {} exited, starting a new one", pid);
+      if (w->running != -1)
+        _completions.push_back(
+            {w->running, -1, std::string(), std::string()});
+      w->retire();
+      w.reset(new worker(*this));
+      _dispatch();
+      return;
+    }
+}
+
+/**
+ *  Run a check on an available worker, or queue it until a worker is
+ *  available.
+ *
+ *  @param[in] cmd  Command to execute.
+ *
+ *  @return Check ID.
+ */
+pid_t worker_pool::run(std::string const& cmd) {
+  pid_t id(_next_id);
+  _next_id = (_next_id == std::numeric_limits<pid_t>::min() ? -2
+                                                            : _next_id - 1);
+
+  std::string request;
+  uint32_t size(cmd.size());
+  request.append(reinterpret_cast<char const*>(&size), sizeof(size));
+  request.append(cmd);
+  _queue.emplace_back(id, std::move(request));
+  _dispatch();
+  return id;
+}
+
+/**
+ *  Unload the worker pool.
+ */
+void worker_pool::unload() {
+  delete _instance;
+  _instance = nullptr;
+}
+
+/**************************************
+ *                                     *
+ *           Private Methods           *
+ *                                     *
+ **************************************/
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] size        Number of workers.
+ *  @param[in] max_checks  Number of checks per worker.
+ *  @param[in] max_memory  Memory limit of a worker in kilobytes.
+ */
+worker_pool::worker_pool(uint32_t size,
+                         uint32_t max_checks,
+                         uint32_t max_memory)
+    : _max_checks(max_checks ? max_checks : 1),
+      _max_memory(max_memory),
+      _next_id(-2) {
+  log::core()->info("starting {} Perl workers", size);
+  for (uint32_t i(0); i < size; ++i)
+    _workers.emplace_back(new worker(*this));
+}
+
+/**
+ *  Send queued checks to idle workers.
+ */
+void worker_pool::_dispatch() {
+  for (std::unique_ptr<worker>& w : _workers) {
+    if (_queue.empty())
+      return;
+    if (w->running == -1 && !w->dead &&
+        w->send(_queue.front().first, _queue.front().second))
+      _queue.pop_front();
+  }
+}
+
+/**
+ *  A worker completed its check. It is replaced if it reached its
+ *  limits, then queued checks are dispatched.
+ *
+ *  @param[in] w  Worker.
+ */
+void worker_pool::_release(worker* w) {
+  if (w->checks >= _max_checks ||
+      (_max_memory && w->memory >= _max_memory)) {
+    for (std::unique_ptr<worker>& ptr : _workers)
+      if (ptr.get() == w) {
+        log::core()->info(
+            "recycling Perl worker {0} after {1} checks ({2} kB)", w->pid,
+            w->checks, w->memory);
+        w->retire();
+        _retired.push_back(std::move(ptr));
+        ptr.reset(new worker(*this));
+        break;
+      }
+  }
+  _dispatch();
+}
+
+/**
+ *  Worker process main loop: run checks received on the request pipe
+ *  until it is closed.
+ *
+ *  @param[in] request   Request pipe.
+ *  @param[in] response  Response pipe.
+ */
+void worker_pool::_serve(int request, int response) {
+  for (;;) {
+    uint32_t size;
+    if (!read_all(request, &size, sizeof(size)))
+      break;
+    std::string cmd(size, '\0');
+    if (!read_all(request, &cmd[0], size))
+      break;
+
+    std::string output;
+    std::string error;
+    int32_t exit_code(embedded_perl::instance().execute(cmd, output, error));
+    uint32_t memory(resident_memory());
+
+    std::string frame;
+    frame.append(reinterpret_cast<char const*>(&exit_code), sizeof(exit_code));
+    frame.append(reinterpret_cast<char const*>(&memory), sizeof(memory));
+    size = output.size();
+    frame.append(reinterpret_cast<char const*>(&size), sizeof(size));
+    frame.append(output);
+    size = error.size();
+    frame.append(reinterpret_cast<char const*>(&size), sizeof(size));
+    frame.append(error);
+    if (!write_all(response, frame.data(), frame.size()))
+      break;
+  }
+}
+
+/**
+ *  Fork a new worker.
+ *
+ *  @param[in] pool  Pool the worker belongs to.
+ */
+worker_pool::worker::worker(worker_pool& pool)
+    : pid((pid_t)-1),
+      running((pid_t)-1),
+      dead(false),
+      checks(0),
+      memory(0),
+      _pool(pool) {
+  int req[2];
+  int resp[2];
+  if (pipe(req)) {
+    char const* msg(strerror(errno));
+    throw basic_error("could not create Perl worker pipe: {}", msg);
+  }
+  if (pipe(resp)) {
+    char const* msg(strerror(errno));
+    ::close(req[0]);
+    ::close(req[1]);
+    throw basic_error("could not create Perl worker pipe: {}", msg);
+  }
+
+  pid = fork();
+  if (pid < 0) {
+    char const* msg(strerror(errno));
+    ::close(req[0]);
+    ::close(req[1]);
+    ::close(resp[0]);
+    ::close(resp[1]);
+    throw basic_error("could not fork Perl worker: {}", msg);
+  } else if (!pid) {  // Child
+    // Do not keep the descriptors of the connector and other workers.
+    try {
+      pipe_handle::close_all_handles();
+    }
+    catch (...) {
+      _exit(3);
+    }
+    ::close(req[1]);
+    ::close(resp[0]);
+    int null_fd(open("/dev/null", O_RDWR));
+    if (null_fd >= 0) {
+      dup2(null_fd, STDIN_FILENO);
+      dup2(null_fd, STDOUT_FILENO);
+      if (null_fd > STDERR_FILENO)
+        ::close(null_fd);
+    }
+    signal(SIGTERM, SIG_DFL);
+    _serve(req[0], resp[1]);
+    _exit(0);
+  }
+
+  // Parent.
+  ::close(req[0]);
+  ::close(resp[1]);
+  _request.set_fd(req[1]);
+  _response.set_fd(resp[0]);
+  multiplexer::instance().handle_manager::add(&_response, this);
+  log::core()->debug("Perl worker {} started", pid);
+}
+
+/**
+ *  Destructor.
+ */
+worker_pool::worker::~worker() noexcept {
+  retire();
+}
+
+/**
+ *  Error on the response pipe: the worker is no longer usable.
+ *
+ *  @param[in] h  Response pipe.
+ */
+void worker_pool::worker::error([[maybe_unused]] handle& h) {
+  dead = true;
+  multiplexer::instance().handle_manager::remove(&_response);
+}
+
+/**
+ *  Read a response from the worker.
+ *
+ *  @param[in] h  Response pipe.
+ */
+void worker_pool::worker::read([[maybe_unused]] handle& h) {
+  char buffer[4096];
+  unsigned long rb(_response.read(buffer, sizeof(buffer)));
+  if (!rb) {
+    // The worker exited, it will be replaced once waited for.
+    dead = true;
+    multiplexer::instance().handle_manager::remove(&_response);
+    return;
+  }
+  _buffer.append(buffer, rb);
+  _parse();
+}
+
+/**
+ *  Stop sending checks to the worker. It exits once its request pipe
+ *  is closed.
+ */
+void worker_pool::worker::retire() noexcept {
+  try {
+    multiplexer::instance().handle_manager::remove(&_response);
+  }
+  catch (...) {
+  }
+  _request.close();
+  _response.close();
+}
+
+/**
+ *  Send a check to the worker.
+ *
+ *  @param[in] id       Check ID.
+ *  @param[in] request  Serialized check.
+ *
+ *  @return false if the worker is not reachable.
+ */
+bool worker_pool::worker::send(pid_t id, std::string const& request) {
+  if (!write_request(_request.get_native_handle(), request)) {
+    // The worker exited, it will be replaced once waited for.
+    dead = true;
+    return false;
+  }
+  running = id;
+  log::core()->debug("check {0} sent to Perl worker {1}", id, pid);
+  return true;
+}
+
+/**
+ *  Always read from the response pipe.
+ *
+ *  @param[in] h  Unused.
+ *
+ *  @return true.
+ */
+bool worker_pool::worker::want_read([[maybe_unused]] handle& h) {
+  return true;
+}
+
+/**
+ *  Extract a complete response from the read buffer.
+ */
+void worker_pool::worker::_parse() {
+  size_t const header(2 * sizeof(int32_t) + sizeof(uint32_t));
+  if (_buffer.size() < header)
+    return;
+
+  int32_t exit_code;
+  uint32_t mem;
+  uint32_t out_size;
+  memcpy(&exit_code, _buffer.data(), sizeof(exit_code));
+  memcpy(&mem, _buffer.data() + sizeof(exit_code), sizeof(mem));
+  memcpy(&out_size, _buffer.data() + 2 * sizeof(int32_t), sizeof(out_size));
+  if (_buffer.size() < header + out_size + sizeof(uint32_t))
+    return;
+  uint32_t err_size;
+  memcpy(&err_size, _buffer.data() + header + out_size, sizeof(err_size));
+  size_t total(header + out_size + sizeof(uint32_t) + err_size);
+  if (_buffer.size() < total)
+    return;
+
+  completion c;
+  c.id = running;
+  c.exit_code = exit_code;
+  c.output = _buffer.substr(header, out_size);
+  c.error = _buffer.substr(header + out_size + sizeof(uint32_t), err_size);
+  _pool._completions.push_back(std::move(c));
+  _buffer.clear();
+  running = (pid_t)-1;
+  ++checks;
+  memory = mem;
+
+  // This object may be retired by the pool.
+  _pool._release(this);
+}
@@ -138,8 +138,22 @@ int main(int argc, char* argv[]) {
       log::core()->debug("installing termination handler");
       signal(SIGTERM, term_handler);
 
+      // Sessions settings.
+      uint32_t threads(1);
+      if (opts.get_argument("threads").get_is_set())
+        threads = strtoul(opts.get_argument("threads").get_value().c_str(),
+                          nullptr, 10);
+      uint32_t max_sessions(1);
+      if (opts.get_argument("sessions").get_is_set())
+        max_sessions = strtoul(
+            opts.get_argument("sessions").get_value().c_str(), nullptr, 10);
+      uint32_t max_channels(10);
+      if (opts.get_argument("channels").get_is_set())
+        max_channels = strtoul(
+            opts.get_argument("channels").get_value().c_str(), nullptr, 10);
+
       // Program policy.
-      policy p;
+      policy p(threads, max_sessions, max_channels);
       retval = (p.run() ? EXIT_SUCCESS : EXIT_FAILURE);
     }
   }
@@ -24,6 +24,9 @@ using namespace com::centreon::connector::ssh;
 // Class instance pointer.
 static multiplexer* _instance = nullptr;
 
+// Instance of the current thread, if any.
+static thread_local multiplexer* _local_instance = nullptr;
+
 /**************************************
  *                                     *
  *           Public Methods            *
@@ -36,6 +39,8 @@ static multiplexer* _instance = nullptr;
  *  @return multiplexer instance.
  */
 multiplexer& multiplexer::instance() noexcept {
+  if (_local_instance)
+    return *_local_instance;
   assert(_instance);
   return *_instance;
 }
@@ -48,6 +53,15 @@ void multiplexer::load() {
     _instance = new multiplexer;
 }
 
+/**
+ *  Load an instance used by the calling thread only. Its handlers and
+ *  tasks are run by this thread.
+ */
+void multiplexer::load_local() {
+  if (!_local_instance)
+    _local_instance = new multiplexer(1);
+}
+
 /**
  * Unload singleton.
  */
@@ -56,6 +70,14 @@ void multiplexer::unload() {
   _instance = nullptr;
 }
 
+/**
+ *  Unload the instance of the calling thread.
+ */
+void multiplexer::unload_local() {
+  delete _local_instance;
+  _local_instance = nullptr;
+}
+
 /**************************************
  *                                     *
  *           Private Methods           *
@@ -63,6 +85,11 @@ void multiplexer::unload() {
  **************************************/
 
 /**
- *  Default constructor.
+ *  Constructor.
+ *
+ *  @param[in] max_thread_count  Number of threads of the task manager,
+ *                               0 for one per CPU.
  */
-multiplexer::multiplexer() : com::centreon::handle_manager(this) {}
+multiplexer::multiplexer(uint32_t max_thread_count)
+    : com::centreon::task_manager(max_thread_count),
+      com::centreon::handle_manager(this) {}
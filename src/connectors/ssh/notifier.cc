@@ -0,0 +1,105 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/connector/ssh/notifier.hh"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "com/centreon/connector/log.hh"
+#include "com/centreon/exceptions/basic.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::connector::ssh;
+
+/**************************************
+ *                                     *
+ *           Public Methods            *
+ *                                     *
+ **************************************/
+
+/**
+ *  Default constructor.
+ */
+notifier::notifier() {
+  int fds[2];
+  if (pipe(fds)) {
+    char const* msg(strerror(errno));
+    throw basic_error("could not create notification pipe: {}", msg);
+  }
+  // Both ends are non blocking: a full pipe already wakes the reader.
+  for (int fd : fds)
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  _read.set_native_handle(fds[0]);
+  _write.set_native_handle(fds[1]);
+}
+
+/**
+ *  Destructor.
+ */
+notifier::~notifier() noexcept {}
+
+/**
+ *  Error on the pipe.
+ *
+ *  @param[in] h Unused.
+ */
+void notifier::error([[maybe_unused]] handle& h) {
+  log::core()->error("error detected on notification pipe");
+}
+
+/**
+ *  Get the handle to monitor.
+ *
+ *  @return Read end of the pipe.
+ */
+com::centreon::handle* notifier::get_handle() noexcept { return &_read; }
+
+/**
+ *  Wake up the multiplexer monitoring the pipe. This method is thread
+ *  safe.
+ */
+void notifier::notify() {
+  char c(0);
+  if (::write(_write.get_native_handle(), &c, 1) < 0 && errno != EAGAIN)
+    log::core()->error("could not write to notification pipe: {}",
+                       strerror(errno));
+}
+
+/**
+ *  Drain the pipe.
+ *
+ *  @param[in] h Unused.
+ */
+void notifier::read([[maybe_unused]] handle& h) {
+  char buffer[256];
+  while (::read(_read.get_native_handle(), buffer, sizeof(buffer)) > 0)
+    ;
+}
+
+/**
+ *  Always monitor the pipe.
+ *
+ *  @param[in] h Unused.
+ *
+ *  @return true.
+ */
+bool notifier::want_read([[maybe_unused]] handle& h) { return true; }
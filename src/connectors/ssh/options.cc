@@ -30,6 +30,16 @@ static char const* const version_description =
     "Print software version and exit.";
 static char const* const log_file_description =
     "Specifies the log file (default: stderr).";
+static char const* const threads_description =
+    "Number of threads running SSH sessions, the sessions of a host are "
+    "all handled by the same thread (default: 1).";
+static char const* const sessions_description =
+    "Maximum number of SSH sessions opened with a host by a same user "
+    "(default: 1).";
+static char const* const channels_description =
+    "Number of checks running on a session before another session is "
+    "opened with the host, should not exceed sshd MaxSessions "
+    "(default: 10).";
 
 /**************************************
  *                                     *
@@ -81,6 +91,9 @@ std::string options::help() const {
       << "  --help     " << help_description << "\n"
       << "  --version  " << version_description << "\n"
       << "  --log-file " << log_file_description << "\n"
+      << "  --threads  " << threads_description << "\n"
+      << "  --sessions " << sessions_description << "\n"
+      << "  --channels " << channels_description << "\n"
       << "\n"
       << "Commands must be sent on the connector's standard input.\n"
       << "They must be sent using Centreon Connector protocol version\n"
@@ -152,4 +165,31 @@ void options::_init() {
     arg.set_description(log_file_description);
     arg.set_has_value(true);
   }
+
+  // Threads.
+  {
+    misc::argument& arg(_arguments['t']);
+    arg.set_name('t');
+    arg.set_long_name("threads");
+    arg.set_description(threads_description);
+    arg.set_has_value(true);
+  }
+
+  // Sessions.
+  {
+    misc::argument& arg(_arguments['s']);
+    arg.set_name('s');
+    arg.set_long_name("sessions");
+    arg.set_description(sessions_description);
+    arg.set_has_value(true);
+  }
+
+  // Channels.
+  {
+    misc::argument& arg(_arguments['c']);
+    arg.set_name('c');
+    arg.set_long_name("channels");
+    arg.set_description(channels_description);
+    arg.set_has_value(true);
+  }
 }
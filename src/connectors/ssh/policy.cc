@@ -20,14 +20,12 @@
 
 #include <atomic>
 #include <cstdio>
+#include <functional>
 #include <memory>
 
 #include "com/centreon/connector/log.hh"
-#include "com/centreon/connector/ssh/checks/check.hh"
 #include "com/centreon/connector/ssh/checks/result.hh"
 #include "com/centreon/connector/ssh/multiplexer.hh"
-#include "com/centreon/connector/ssh/sessions/session.hh"
-#include "com/centreon/delayed_delete.hh"
 
 using namespace com::centreon::connector::ssh;
 
@@ -41,9 +39,30 @@ extern std::atomic<bool> should_exit;
  **************************************/
 
 /**
- *  Default constructor.
+ *  Constructor.
+ *
+ *  @param[in] threads       Number of workers running sessions.
+ *  @param[in] max_sessions  Maximum number of sessions per credentials.
+ *  @param[in] max_channels  Number of checks run on a session before
+ *                           another one is opened.
  */
-policy::policy() : _sin(stdin), _sout(stdout) {
+policy::policy(uint32_t threads, uint32_t max_sessions, uint32_t max_channels)
+    : _sin(stdin), _sout(stdout) {
+  // Start workers.
+  log::core()->info(
+      "starting {0} SSH workers ({1} sessions of {2} channels per host)",
+      threads, max_sessions, max_channels);
+  if (!threads)
+    threads = 1;
+  for (uint32_t i(0); i < threads; ++i) {
+    _workers.emplace_back(new worker(*this, max_sessions, max_channels));
+    _workers.back()->start();
+  }
+
+  // Results of workers.
+  multiplexer::instance().handle_manager::add(_notifier.get_handle(),
+                                              &_notifier);
+
   // Send information back.
   multiplexer::instance().handle_manager::add(&_sout, &_reporter);
 
@@ -62,27 +81,12 @@ policy::~policy() noexcept {
     // Remove from multiplexer.
     multiplexer::instance().handle_manager::remove(&_sin);
     multiplexer::instance().handle_manager::remove(&_sout);
+    multiplexer::instance().handle_manager::remove(_notifier.get_handle());
   } catch (...) {
   }
 
-  // Close checks.
-  for (auto& c : _checks) {
-    try {
-      c.second.first->unlisten(this);
-    } catch (...) {
-    }
-    delete c.second.first;
-  }
-  _checks.clear();
-
-  // Close sessions.
-  for (auto& _session : _sessions) {
-    try {
-      _session.second->close();
-    } catch (...) {
-    }
-    delete _session.second;
-  }
+  // Stop workers, they close their checks and sessions.
+  _workers.clear();
 }
 
 /**
@@ -154,31 +158,12 @@ void policy::on_execute(uint64_t cmd_id,
     creds.set_port(port);
     creds.set_key(key);
 
-    // Object lock.
-    std::unique_lock<std::mutex> lock(_mutex);
-
-    // Find session.
-    auto it = _sessions.find(creds);
-    if (it == _sessions.end()) {
-      log::core()->info("creating session for {0}@{1}:{2}", user, host, port);
-      std::unique_ptr<sessions::session> sess{new sessions::session(creds)};
-      sess->connect(use_ipv6);
-      _sessions[creds] = sess.release();
-      it = _sessions.find(creds);
-    }
-
-    sessions::session* sess = it->second;
-
-    // Create check object.
-    checks::check* chk_ptr = new checks::check(skip_stdout, skip_stderr);
-    chk_ptr->listen(this);
-    _checks[cmd_id] = std::make_pair(chk_ptr, sess);
-
-    // Release lock and run copied pointer (we might be called in
-    // on_result() and mutex must be available).
-    lock.unlock();
-
-    chk_ptr->execute(*sess, cmd_id, cmds, timeout);
+    // Sessions of some credentials are all handled by the same worker.
+    std::string id(user + "@" + host + ":" + std::to_string(port));
+    worker& w(*_workers[std::hash<std::string>()(id) % _workers.size()]);
+    _checks.insert(cmd_id);
+    w.execute(cmd_id, timeout, creds, cmds, skip_stdout, skip_stderr,
+              use_ipv6);
   } catch (std::exception const& e) {
     log::core()->error(
         "could not launch check ID {0} on host {1} because an error occurred: "
@@ -208,69 +193,17 @@ void policy::on_quit() {
 }
 
 /**
- *  Check result has arrived.
+ *  Check result has arrived. This method is called by workers, results
+ *  are reported by the main thread.
  *
  *  @param[in] r Check result.
  */
 void policy::on_result(checks::result const& r) {
-  // Object lock.
-  std::lock_guard<std::mutex> lock(_mutex);
-
-  // Remove check from list.
-  std::map<uint64_t, std::pair<checks::check*, sessions::session*> >::iterator
-      chk;
-  chk = _checks.find(r.get_command_id());
-  if (chk == _checks.end())
-    log::core()->error("got result of check {} which is not registered",
-                       r.get_command_id());
-  else {
-    try {
-      chk->second.first->unlisten(this);
-      chk->second.second->unlisten(chk->second.first);
-    } catch (...) {
-    }
-    delete chk->second.first;
-    sessions::session* sess(chk->second.second);
-    _checks.erase(chk);
-
-    // Check session.
-    if (!sess->is_connected()) {
-      log::core()->debug(
-          "session {} is not connected, checking if any check working with it "
-          "remains",
-          static_cast<void*>(sess));
-      bool found(false);
-      for (auto& _check : _checks)
-        if (_check.second.second == sess) {
-          found = true;
-          break;
-        }
-      if (!found) {
-        std::map<sessions::credentials, sessions::session*>::iterator it, end;
-        for (it = _sessions.begin(), end = _sessions.end(); it != end; ++it) {
-          if (it->second == sess)
-            break;
-        }
-        if (it == end)
-          log::core()->error(
-              "session {} was not found in policy list, deleting anyway",
-              static_cast<void*>(sess));
-        else {
-          log::core()->info(
-              "session {0}@{1}:{2} that is not connected and has no check "
-              "running will be deleted",
-              it->first.get_user(), it->first.get_host(), it->first.get_port());
-          _sessions.erase(it);
-        }
-        delayed_delete<sessions::session>* dd =
-            new delayed_delete<sessions::session>(sess);
-        multiplexer::instance().task_manager::add(dd, 0, true, true);
-      }
-    }
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _results.push_back(r);
   }
-
-  // Send check result back to monitoring engine.
-  _reporter.send_result(r);
+  _notifier.notify();
 }
 
 /**
@@ -296,13 +229,16 @@ bool policy::run() {
   while (!should_exit) {
     log::core()->debug("multiplexing");
     multiplexer::instance().multiplex();
+    _report();
   }
 
   // Run as long as a check remains.
   log::core()->info("waiting for checks to terminate");
+  _report();
   while (!_checks.empty()) {
     log::core()->debug("multiplexing remaining checks ({})", _checks.size());
     multiplexer::instance().multiplex();
+    _report();
   }
 
   // Run as long as some data remains.
@@ -314,3 +250,24 @@ bool policy::run() {
 
   return !_error;
 }
+
+/**************************************
+ *                                     *
+ *           Private Methods           *
+ *                                     *
+ **************************************/
+
+/**
+ *  Move results received from workers to the reporter.
+ */
+void policy::_report() {
+  std::deque<checks::result> results;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    results.swap(_results);
+  }
+  for (checks::result const& r : results) {
+    _checks.erase(r.get_command_id());
+    _reporter.send_result(r);
+  }
+}
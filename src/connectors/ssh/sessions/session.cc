@@ -210,8 +210,10 @@ void session::connect(bool use_ipv6) {
 
   _socket.set_native_handle(mysocket);
 
-  // Register with multiplexer.
-  multiplexer::instance().handle_manager::add(&_socket, this, true);
+  // Register with multiplexer. The session is handled by the thread
+  // owning the multiplexer, sessions run in parallel in distinct
+  // threads.
+  multiplexer::instance().handle_manager::add(&_socket, this);
 
   // Launch the connection process.
   log::core()->debug(
@@ -249,6 +251,13 @@ void session::error([[maybe_unused]] handle& h) {
   this->close();
 }
 
+/**
+ *  Get the number of checks using a channel of this session.
+ *
+ *  @return Number of checks.
+ */
+size_t session::get_channel_count() const noexcept { return _listnrs.size(); }
+
 /**
  *  Get the session credentials.
  *
@@ -0,0 +1,312 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/connector/ssh/worker.hh"
+
+#include <algorithm>
+#include <memory>
+
+#include "com/centreon/connector/log.hh"
+#include "com/centreon/connector/ssh/checks/check.hh"
+#include "com/centreon/connector/ssh/checks/result.hh"
+#include "com/centreon/connector/ssh/multiplexer.hh"
+#include "com/centreon/connector/ssh/sessions/session.hh"
+#include "com/centreon/delayed_delete.hh"
+
+using namespace com::centreon::connector::ssh;
+
+/**************************************
+ *                                     *
+ *           Public Methods            *
+ *                                     *
+ **************************************/
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] listnr        Listener of check results.
+ *  @param[in] max_sessions  Maximum number of sessions per credentials.
+ *  @param[in] max_channels  Number of checks run on a session before
+ *                           another one is opened.
+ */
+worker::worker(checks::listener& listnr,
+               uint32_t max_sessions,
+               uint32_t max_channels)
+    : _exit(false),
+      _listnr(listnr),
+      _max_channels(max_channels ? max_channels : 1),
+      _max_sessions(max_sessions ? max_sessions : 1) {}
+
+/**
+ *  Destructor.
+ */
+worker::~worker() noexcept {
+  try {
+    stop();
+  }
+  catch (...) {
+  }
+}
+
+/**
+ *  Run a check. This method is thread safe, the check is started by the
+ *  worker thread.
+ *
+ *  @param[in] cmd_id      Command ID.
+ *  @param[in] timeout     Time the command has to execute.
+ *  @param[in] creds       Session credentials.
+ *  @param[in] cmds        Commands to execute.
+ *  @param[in] skip_stdout Ignore all or first n output lines.
+ *  @param[in] skip_stderr Ignore all or first n error lines.
+ *  @param[in] use_ipv6    Version of ip protocol to use.
+ */
+void worker::execute(uint64_t cmd_id,
+                     timestamp const& timeout,
+                     sessions::credentials const& creds,
+                     std::list<std::string> const& cmds,
+                     int skip_stdout,
+                     int skip_stderr,
+                     bool use_ipv6) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _requests.push_back(
+        {cmd_id, timeout, creds, cmds, skip_stdout, skip_stderr, use_ipv6});
+  }
+  _notifier.notify();
+}
+
+/**
+ *  Check result has arrived. Called from the worker thread.
+ *
+ *  @param[in] r Check result.
+ */
+void worker::on_result(checks::result const& r) {
+  // Remove check from list.
+  auto chk(_checks.find(r.get_command_id()));
+  if (chk == _checks.end())
+    log::core()->error("got result of check {} which is not registered",
+                       r.get_command_id());
+  else {
+    try {
+      chk->second.first->unlisten(this);
+      chk->second.second->unlisten(chk->second.first);
+    }
+    catch (...) {
+    }
+    delete chk->second.first;
+    sessions::session* sess(chk->second.second);
+    _checks.erase(chk);
+
+    // Check session.
+    if (!sess->is_connected()) {
+      log::core()->debug(
+          "session {} is not connected, checking if any check working with it "
+          "remains",
+          static_cast<void*>(sess));
+      bool found(false);
+      for (auto& c : _checks)
+        if (c.second.second == sess) {
+          found = true;
+          break;
+        }
+      if (!found) {
+        auto it(_sessions.find(sess->get_credentials()));
+        std::vector<sessions::session*>::iterator s;
+        if (it != _sessions.end())
+          s = std::find(it->second.begin(), it->second.end(), sess);
+        if (it == _sessions.end() || s == it->second.end())
+          log::core()->error(
+              "session {} was not found in worker list, deleting anyway",
+              static_cast<void*>(sess));
+        else {
+          log::core()->info(
+              "session {0}@{1}:{2} that is not connected and has no check "
+              "running will be deleted",
+              it->first.get_user(), it->first.get_host(), it->first.get_port());
+          it->second.erase(s);
+          if (it->second.empty())
+            _sessions.erase(it);
+        }
+        // Deleted by this thread, which owns the session multiplexer.
+        delayed_delete<sessions::session>* dd =
+            new delayed_delete<sessions::session>(sess);
+        multiplexer::instance().task_manager::add(dd, 0, false, true);
+      }
+    }
+  }
+
+  // Forward check result.
+  _listnr.on_result(r);
+}
+
+/**
+ *  Start the worker thread.
+ */
+void worker::start() {
+  _thread = std::thread(&worker::_callback, this);
+}
+
+/**
+ *  Stop the worker thread once its checks are over.
+ */
+void worker::stop() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _exit = true;
+  }
+  _notifier.notify();
+  if (_thread.joinable())
+    _thread.join();
+}
+
+/**************************************
+ *                                     *
+ *           Private Methods           *
+ *                                     *
+ **************************************/
+
+/**
+ *  Worker thread.
+ */
+void worker::_callback() {
+  multiplexer::load_local();
+  multiplexer::instance().handle_manager::add(_notifier.get_handle(),
+                                              &_notifier);
+  for (;;) {
+    std::deque<request> requests;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (_exit && _requests.empty() && _checks.empty())
+        break;
+      requests.swap(_requests);
+    }
+    for (request const& r : requests)
+      _execute(r);
+
+    try {
+      multiplexer::instance().multiplex();
+    }
+    catch (std::exception const& e) {
+      log::core()->error("SSH worker multiplexing failed: {}", e.what());
+    }
+  }
+  _close();
+  multiplexer::unload_local();
+}
+
+/**
+ *  Delete remaining checks and sessions. Called from the worker thread.
+ */
+void worker::_close() {
+  // Close checks.
+  for (auto& c : _checks) {
+    try {
+      c.second.first->unlisten(this);
+    }
+    catch (...) {
+    }
+    delete c.second.first;
+  }
+  _checks.clear();
+
+  // Close sessions.
+  for (auto& creds : _sessions)
+    for (sessions::session* sess : creds.second) {
+      try {
+        sess->close();
+      }
+      catch (...) {
+      }
+      delete sess;
+    }
+  _sessions.clear();
+
+  // Run pending deletions.
+  multiplexer::instance().handle_manager::remove(_notifier.get_handle());
+  multiplexer::instance().task_manager::execute(timestamp::max_time());
+}
+
+/**
+ *  Start a check. Called from the worker thread.
+ *
+ *  @param[in] r Check request.
+ */
+void worker::_execute(request const& r) {
+  try {
+    sessions::session* sess(_session_for(r.creds, r.use_ipv6));
+
+    // Create check object.
+    checks::check* chk_ptr =
+        new checks::check(r.skip_stdout, r.skip_stderr);
+    chk_ptr->listen(this);
+    _checks[r.cmd_id] = std::make_pair(chk_ptr, sess);
+    chk_ptr->execute(*sess, r.cmd_id, r.cmds, r.timeout);
+  }
+  catch (std::exception const& e) {
+    log::core()->error(
+        "could not launch check ID {0} on host {1} because an error occurred: "
+        "{2}",
+        r.cmd_id, r.creds.get_host(), e.what());
+    checks::result res;
+    res.set_command_id(r.cmd_id);
+    on_result(res);
+  }
+}
+
+/**
+ *  Get the session on which a check is run.
+ *
+ *  @param[in] creds    Session credentials.
+ *  @param[in] use_ipv6 Version of ip protocol to use.
+ *
+ *  @return The session running the fewest checks, a new one if it has
+ *          max_channels checks and fewer than max_sessions are open.
+ */
+sessions::session* worker::_session_for(sessions::credentials const& creds,
+                                        bool use_ipv6) {
+  std::vector<sessions::session*>& pool(_sessions[creds]);
+  sessions::session* retval(nullptr);
+  for (sessions::session* sess : pool)
+    if (!retval || sess->get_channel_count() < retval->get_channel_count())
+      retval = sess;
+
+  if (!retval || (retval->get_channel_count() >= _max_channels &&
+                  pool.size() < _max_sessions)) {
+    log::core()->info("creating session {0}/{1} for {2}@{3}:{4}",
+                      pool.size() + 1, _max_sessions, creds.get_user(),
+                      creds.get_host(), creds.get_port());
+    try {
+      std::unique_ptr<sessions::session> sess{new sessions::session(creds)};
+      sess->connect(use_ipv6);
+      pool.push_back(sess.release());
+      retval = pool.back();
+    }
+    catch (std::exception const& e) {
+      if (retval)
+        log::core()->error(
+            "could not open another session for {0}@{1}:{2}, using an "
+            "existing one: {3}",
+            creds.get_user(), creds.get_host(), creds.get_port(), e.what());
+      else {
+        _sessions.erase(creds);
+        throw;
+      }
+    }
+  }
+  return retval;
+}
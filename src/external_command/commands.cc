@@ -22,6 +22,7 @@
 
 #include <sys/time.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
 #include <cstdlib>
@@ -54,6 +55,9 @@ using namespace com::centreon::engine::logging;
 /****************** EXTERNAL COMMAND PROCESSING *******************/
 /******************************************************************/
 
+/* number of commands taken at once from the external command buffer */
+static size_t const external_command_batch_size(256);
+
 /* checks for the existence of the external command file and processes all
  * commands found in it */
 int check_for_external_commands() {
@@ -74,36 +78,25 @@ int check_for_external_commands() {
     update_program_status(false);
   }
 
-  /* process all commands found in the buffer */
-  char* buffer(nullptr);
-  while (1) {
-    /* get a lock on the buffer */
-    pthread_mutex_lock(&external_command_buffer.buffer_lock);
-
-    /* if no items present, bail out */
-    if (external_command_buffer.items <= 0) {
-      pthread_mutex_unlock(&external_command_buffer.buffer_lock);
+  /* process the commands found in the buffer by batches, slots are given
+   * back to the worker thread after each batch. Only commands already
+   * there are processed so that a steady flow cannot hold the loop. */
+  size_t remaining(external_command_buffer.size());
+  while (remaining > 0) {
+    size_t processed(external_command_buffer.consume(
+        std::min(remaining, external_command_batch_size),
+        [](std::string const& cmd) {
+          try {
+            modules::external_commands::gl_processor.execute(cmd);
+          } catch (std::exception const& e) {
+            logger(log_runtime_error, basic)
+                << "Error: external command '" << cmd
+                << "' failed: " << e.what();
+          }
+        }));
+    if (!processed)
       break;
-    }
-
-    buffer =
-        ((char**)external_command_buffer.buffer)[external_command_buffer.tail];
-    ((char**)external_command_buffer.buffer)[external_command_buffer.tail] =
-        nullptr;
-
-    /* adjust tail counter and number of items */
-    external_command_buffer.tail = (external_command_buffer.tail + 1) %
-                                   config->external_command_buffer_slots();
-    external_command_buffer.items--;
-
-    /* release the lock on the buffer */
-    pthread_mutex_unlock(&external_command_buffer.buffer_lock);
-
-    /* process the command */
-    process_external_command(buffer);
-
-    /* free memory */
-    delete[] buffer;
+    remaining -= processed;
   }
 
   return OK;
@@ -531,8 +524,6 @@ int process_passive_service_check(time_t check_time,
                                   char const* svc_description,
                                   int return_code,
                                   char const* output) {
-  char const* real_host_name(nullptr);
-
   /* skip this service check result if we aren't accepting passive service
    * checks */
   if (config->accept_passive_service_checks() == false)
@@ -543,22 +534,10 @@ int process_passive_service_check(time_t check_time,
     return ERROR;
 
   /* find the host by its name or address */
-  host_map::const_iterator it(host::hosts.find(host_name));
-  if (it != host::hosts.end() && it->second)
-    real_host_name = host_name;
-  else {
-    for (host_map::iterator itt(host::hosts.begin()), end(host::hosts.end());
-         itt != end; ++itt) {
-      if (itt->second && itt->second->get_address() == host_name) {
-        real_host_name = itt->first.c_str();
-        it = itt;
-        break;
-      }
-    }
-  }
+  host* hst(find_host_by_name_or_address(host_name));
 
   /* we couldn't find the host */
-  if (real_host_name == nullptr) {
+  if (!hst) {
     logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for service '"
         << svc_description << "' on host '" << host_name
@@ -568,7 +547,7 @@ int process_passive_service_check(time_t check_time,
 
   /* make sure the service exists */
   service_map::const_iterator found(
-      service::services.find({real_host_name, svc_description}));
+      service::services.find({hst->get_name(), svc_description}));
   if (found == service::services.end() || !found->second) {
     logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for service '"
@@ -650,7 +629,6 @@ int process_passive_host_check(time_t check_time,
                                char const* host_name,
                                int return_code,
                                char const* output) {
-  char const* real_host_name(nullptr);
   /* skip this host check result if we aren't accepting passive host checks */
   if (!config->accept_passive_service_checks())
     return ERROR;
@@ -664,22 +642,10 @@ int process_passive_host_check(time_t check_time,
     return ERROR;
 
   /* find the host by its name or address */
-  host_map::const_iterator it(host::hosts.find(host_name));
-  if (it != host::hosts.end() && it->second)
-    real_host_name = host_name;
-  else {
-    for (host_map::iterator itt(host::hosts.begin()), end(host::hosts.end());
-         itt != end; ++itt) {
-      if (itt->second && itt->second->get_address() == host_name) {
-        real_host_name = itt->first.c_str();
-        it = itt;
-        break;
-      }
-    }
-  }
+  host* hst(find_host_by_name_or_address(host_name));
 
   /* we couldn't find the host */
-  if (real_host_name == nullptr) {
+  if (!hst) {
     logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for host '" << host_name
         << "', but the host could not be found!";
@@ -687,7 +653,7 @@ int process_passive_host_check(time_t check_time,
   }
 
   /* skip this is we aren't accepting passive checks for this host */
-  if (!it->second->get_accept_passive_checks())
+  if (!hst->get_accept_passive_checks())
     return ERROR;
 
   timeval tv;
@@ -695,7 +661,7 @@ int process_passive_host_check(time_t check_time,
   timeval tv_start = {.tv_sec = check_time, .tv_usec = 0};
 
   check_result* result =
-      new check_result(host_check, it->second.get(), checkable::check_passive,
+      new check_result(host_check, hst, checkable::check_passive,
                        CHECK_OPTION_NONE, false,
                        static_cast<double>(tv.tv_sec - check_time) +
                            static_cast<double>(tv.tv_usec / 1000000.0),
@@ -3447,5 +3413,5 @@ void set_service_notification_number(service* svc, int num) {
 }
 
 void new_thresholds_file(char* filename) {
-  anomalydetection::update_thresholds(filename);
+  anomalydetection::update_thresholds_async(filename);
 }
@@ -18,6 +18,7 @@
 */
 
 #include "com/centreon/engine/modules/external_commands/processing.hh"
+#include <algorithm>
 #include <cstdlib>
 #include "com/centreon/engine/broker.hh"
 #include "com/centreon/engine/flapping.hh"
@@ -574,6 +575,8 @@ processing::processing()
   // misc commands.
   _lst_command["PROCESS_FILE"] = command_info(
       CMD_PROCESS_FILE, &_redirector<&cmd_process_external_commands_from_file>);
+
+  _build_lookup_table();
 }
 
 processing::~processing() throw() {}
@@ -618,19 +621,17 @@ bool processing::execute(std::string const& cmdstr) const {
 
   int command_id(CMD_CUSTOM_COMMAND);
 
-  std::unordered_map<std::string, command_info>::const_iterator it;
-  {
-    std::unique_lock<std::mutex> lock(_mutex);
-    it = _lst_command.find(command_name);
-    if (it != _lst_command.end())
-      command_id = it->second.id;
-    else if (command_name[0] != '_') {
-      lock.unlock();
-      logger(log_external_command | log_runtime_warning, basic)
-          << "Warning: Unrecognized external command -> " << command_name;
-      return false;
-    }
+  command_info const* info(_find(command_name.c_str(), command_name.size()));
+  if (info)
+    command_id = info->id;
+  else if (command_name[0] != '_') {
+    logger(log_external_command | log_runtime_warning, basic)
+        << "Warning: Unrecognized external command -> " << command_name;
+    return false;
+  }
 
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
     // Update statistics for external commands.
     update_check_stats(EXTERNAL_COMMAND_STATS, std::time(nullptr));
   }
@@ -658,9 +659,8 @@ bool processing::execute(std::string const& cmdstr) const {
 
   {
     std::lock_guard<std::mutex> lock(_mutex);
-    if (it != _lst_command.end())
-      (*it->second.func)(command_id, entry_time,
-                         const_cast<char*>(args.c_str()));
+    if (info)
+      (*info->func)(command_id, entry_time, const_cast<char*>(args.c_str()));
   }
 
   // Send data to event broker.
@@ -680,11 +680,106 @@ bool processing::execute(std::string const& cmdstr) const {
  */
 bool processing::is_thread_safe(char const* cmd) const {
   char const* ptr = cmd + strspn(cmd, "[]0123456789 ");
-  std::string short_cmd(ptr, strcspn(ptr, ";"));
-  std::lock_guard<std::mutex> lock(_mutex);
-  std::unordered_map<std::string, command_info>::const_iterator it =
-      _lst_command.find(short_cmd);
-  return it != _lst_command.end() && it->second.thread_safe;
+  command_info const* info(_find(ptr, strcspn(ptr, ";")));
+  return info && info->thread_safe;
+}
+
+/**
+ *  Hash a command name (FNV-1a followed by a final mix).
+ *
+ *  @param[in] name    Command name, not necessarily null-terminated.
+ *  @param[in] length  Length of the name.
+ *  @param[in] seed    Seed of the hash.
+ *
+ *  @return The hash value.
+ */
+uint32_t processing::_hash(char const* name, size_t length, uint32_t seed) {
+  uint32_t h(2166136261u ^ seed);
+  for (size_t i(0); i < length; ++i) {
+    h ^= static_cast<unsigned char>(name[i]);
+    h *= 16777619u;
+  }
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+/**
+ *  Build the perfect hash table of the commands. Buckets are placed from
+ *  the biggest to the smallest, each one with the first seed that sends
+ *  all its names to free slots.
+ */
+void processing::_build_lookup_table() {
+  size_t size(1);
+  while (size < 2 * _lst_command.size())
+    size <<= 1;
+
+  std::vector<std::vector<std::unordered_map<std::string,
+                                             command_info>::const_iterator> >
+      buckets(size);
+  for (std::unordered_map<std::string, command_info>::const_iterator
+           it(_lst_command.begin()),
+       end(_lst_command.end());
+       it != end; ++it)
+    buckets[_hash(it->first.data(), it->first.size(), 0) & (size - 1)]
+        .push_back(it);
+
+  std::vector<size_t> order(size);
+  for (size_t i(0); i < size; ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&buckets](size_t a, size_t b) {
+    return buckets[a].size() > buckets[b].size();
+  });
+
+  _lookup_seeds.assign(size, 0);
+  _lookup_slots.assign(size, command_slot{nullptr, nullptr});
+  std::vector<size_t> slots;
+  for (size_t b : order) {
+    if (buckets[b].empty())
+      break;
+    for (uint32_t seed(1);; ++seed) {
+      slots.clear();
+      for (auto const& it : buckets[b]) {
+        size_t slot(_hash(it->first.data(), it->first.size(), seed) &
+                    (size - 1));
+        if (_lookup_slots[slot].name ||
+            std::find(slots.begin(), slots.end(), slot) != slots.end())
+          break;
+        slots.push_back(slot);
+      }
+      if (slots.size() == buckets[b].size()) {
+        _lookup_seeds[b] = seed;
+        for (size_t i(0); i < slots.size(); ++i)
+          _lookup_slots[slots[i]] = {&buckets[b][i]->first,
+                                     &buckets[b][i]->second};
+        break;
+      }
+    }
+  }
+}
+
+/**
+ *  Find a command by its name.
+ *
+ *  @param[in] name    Command name, not necessarily null-terminated.
+ *  @param[in] length  Length of the name.
+ *
+ *  @return The command or nullptr if it does not exist.
+ */
+processing::command_info const* processing::_find(char const* name,
+                                                  size_t length) const {
+  size_t mask(_lookup_slots.size() - 1);
+  uint32_t seed(_lookup_seeds[_hash(name, length, 0) & mask]);
+  if (!seed)
+    return nullptr;
+  command_slot const& slot(_lookup_slots[_hash(name, length, seed) & mask]);
+  if (slot.name && slot.name->size() == length &&
+      !slot.name->compare(0, length, name, length))
+    return slot.info;
+  return nullptr;
 }
 
 void processing::_wrapper_read_state_information() {
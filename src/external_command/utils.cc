@@ -159,25 +159,16 @@ int close_command_file(void) {
   return (OK);
 }
 
+/* size of the chunks read from the command file */
+static size_t const command_file_chunk_size = 64 * 1024;
+
 /* initializes command file worker thread */
 int init_command_file_worker_thread(void) {
   int result = 0;
   sigset_t newmask;
 
-  /* initialize circular buffer */
-  external_command_buffer.head = 0;
-  external_command_buffer.tail = 0;
-  external_command_buffer.items = 0;
-  external_command_buffer.high = 0;
-  external_command_buffer.overflow = 0L;
-  external_command_buffer.buffer =
-      new void*[config->external_command_buffer_slots()];
-  if (external_command_buffer.buffer == NULL)
-    return (ERROR);
-
-  /* initialize mutex (only on cold startup) */
-  if (sigrestart == false)
-    pthread_mutex_init(&external_command_buffer.buffer_lock, NULL);
+  /* initialize the ring of commands, its slots are allocated once */
+  external_command_buffer.resize(config->external_command_buffer_slots());
 
   /* new thread should block all signals */
   sigfillset(&newmask);
@@ -228,28 +219,42 @@ int shutdown_command_file_worker_thread(void) {
 
 /* clean up resources used by command file worker thread */
 void cleanup_command_file_worker_thread(void* arg) {
-  int x = 0;
-
   (void)arg;
 
-  /* release memory allocated to circular buffer */
-  for (x = external_command_buffer.tail; x != external_command_buffer.head;
-       x = (x + 1) % config->external_command_buffer_slots()) {
-    delete[]((char**)external_command_buffer.buffer)[x];
-    ((char**)external_command_buffer.buffer)[x] = NULL;
+  /* drop the commands not processed yet, slots are kept for a restart */
+  external_command_buffer.clear();
+}
+
+/* executes a command line read from the command file or queues it for the
+ * main loop (waiting for some room in the ring if needed) */
+static void dispatch_command_line(char* line, size_t length) {
+  /* Check if command is thread-safe (for immediate execution). */
+  if (modules::external_commands::gl_processor.is_thread_safe(line)) {
+    modules::external_commands::gl_processor.execute(
+        std::string(line, length));
+    return;
+  }
+
+  /* Submit the external command for processing (retry if ring is full). */
+  while (!external_command_buffer.push(line, length)) {
+    /* Wait a bit. */
+    struct timeval tv;
+    tv.tv_sec = 0;
+    tv.tv_usec = 10000;
+    select(0, NULL, NULL, NULL, &tv);
+
+    /* Should we shutdown? */
+    pthread_testcancel();
   }
-  delete[] external_command_buffer.buffer;
-  external_command_buffer.buffer = NULL;
 }
 
 /* worker thread - artificially increases buffer of named pipe */
 void* command_file_worker_thread(void* arg) {
-  char input_buffer[MAX_EXTERNAL_COMMAND_LENGTH];
+  /* static, the thread may be cancelled at any cancellation point */
+  static char input_buffer[command_file_chunk_size];
+  size_t pending = 0;
   struct pollfd pfd;
   int pollval;
-  struct timeval tv;
-  int buffer_items = 0;
-  int result = 0;
 
   (void)arg;
 
@@ -316,60 +321,36 @@ void* command_file_worker_thread(void* arg) {
     /* should we shutdown? */
     pthread_testcancel();
 
-    /* get number of items in the buffer */
-    pthread_mutex_lock(&external_command_buffer.buffer_lock);
-    buffer_items = external_command_buffer.items;
-    pthread_mutex_unlock(&external_command_buffer.buffer_lock);
-
-    /* 10-15-08 Fix for OS X by Jonathan Saggau - see
-     * http://www.jonathansaggau.com/blog/2008/09/using_shark_and_custom_dtrace.html
-     */
-    /* Not sure if this would have negative effects on other OSes... */
-    if (buffer_items == 0) {
-      /* pause a bit so OS X doesn't go nuts with CPU overload */
-      tv.tv_sec = 0;
-      tv.tv_usec = 500;
-      select(0, NULL, NULL, NULL, &tv);
+    /* read as much as possible from the named pipe at once */
+    ssize_t rb = read(command_file_fd, input_buffer + pending,
+                      sizeof(input_buffer) - pending);
+    if (rb <= 0) {
+      if (rb < 0 && errno != EAGAIN && errno != EINTR)
+        logger(logging_options, basic)
+            << "command_file_worker_thread(): read(): (" << errno << ") -> "
+            << strerror(errno);
+      continue;
     }
 
-    /* process all commands in the file (named pipe) if there's some space in
-     * the buffer */
-    if (buffer_items < config->external_command_buffer_slots()) {
-      /* clear EOF condition from prior run (FreeBSD fix) */
-      /* FIXME: use_poll_on_cmd_pipe: Still needed? */
-      clearerr(command_file_fp);
-
-      /* read and process the next command in the file */
-      while (fgets(input_buffer, (int)(sizeof(input_buffer) - 1),
-                   command_file_fp) != NULL) {
-        // Check if command is thread-safe (for immediate execution).
-        if (modules::external_commands::gl_processor.is_thread_safe(
-                input_buffer))
-          modules::external_commands::gl_processor.execute(input_buffer);
-        // Submit the external command for processing
-        // (retry if buffer is full).
-        else {
-          while ((result = submit_external_command(input_buffer,
-                                                   &buffer_items)) == ERROR &&
-                 buffer_items == config->external_command_buffer_slots()) {
-            // Wait a bit.
-            tv.tv_sec = 0;
-            tv.tv_usec = 250000;
-            select(0, NULL, NULL, NULL, &tv);
-
-            // Should we shutdown?
-            pthread_testcancel();
-          }
-
-          // Bail if the circular buffer is full.
-          if (buffer_items == config->external_command_buffer_slots())
-            break;
-
-          // Should we shutdown?
-          pthread_testcancel();
-        }
-      }
+    /* split lines in place, the last one may be incomplete */
+    char* line = input_buffer;
+    char* end = input_buffer + pending + rb;
+    char* eol;
+    while ((eol = static_cast<char*>(memchr(line, '\n', end - line)))) {
+      *eol = 0;
+      if (eol != line)
+        dispatch_command_line(line, eol - line);
+      line = eol + 1;
     }
+
+    /* keep the incomplete line for the next read */
+    pending = end - line;
+    if (pending == sizeof(input_buffer)) {
+      logger(log_runtime_warning, basic)
+          << "Warning: External command too long, it is ignored";
+      pending = 0;
+    } else if (pending)
+      memmove(input_buffer, line, pending);
   }
 
   /* removes cleanup handler - this should never be reached */
@@ -378,41 +359,24 @@ void* command_file_worker_thread(void* arg) {
   return (NULL);
 }
 
-/* submits an external command for processing */
+/* submits an external command for processing, only the command file worker
+ * thread can call it */
 int submit_external_command(char const* cmd, int* buffer_items) {
   int result = OK;
 
-  if (cmd == NULL || external_command_buffer.buffer == NULL) {
+  if (cmd == NULL || external_command_buffer.capacity() == 0) {
     if (buffer_items != NULL)
       *buffer_items = -1;
     return (ERROR);
   }
 
-  /* obtain a lock for writing to the buffer */
-  pthread_mutex_lock(&external_command_buffer.buffer_lock);
-
-  if (external_command_buffer.items < config->external_command_buffer_slots()) {
-    /* save the line in the buffer */
-    ((char**)external_command_buffer.buffer)[external_command_buffer.head] =
-        string::dup(cmd);
-
-    /* increment the head counter and items */
-    external_command_buffer.head = (external_command_buffer.head + 1) %
-                                   config->external_command_buffer_slots();
-    external_command_buffer.items++;
-    if (external_command_buffer.items > external_command_buffer.high)
-      external_command_buffer.high = external_command_buffer.items;
-  }
-  /* buffer was full */
-  else
+  /* save the line in the ring, the buffer was full if it fails */
+  if (!external_command_buffer.push(cmd, strlen(cmd)))
     result = ERROR;
 
   /* return number of items now in buffer */
   if (buffer_items != NULL)
-    *buffer_items = external_command_buffer.items;
-
-  /* release lock on buffer */
-  pthread_mutex_unlock(&external_command_buffer.buffer_lock);
+    *buffer_items = external_command_buffer.size();
 
   return result;
 }
@@ -0,0 +1,187 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/bam/availability_batch.hh"
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <utility>
+
+using namespace com::centreon::broker;
+
+class BamAvailabilityBatch : public ::testing::Test {
+ public:
+  void SetUp() override {
+    _tps.push_back(std::make_shared<time::timeperiod>(
+        1, "24x7", "24x7", "00:00-24:00", "00:00-24:00", "00:00-24:00",
+        "00:00-24:00", "00:00-24:00", "00:00-24:00", "00:00-24:00"));
+    _tps.push_back(std::make_shared<time::timeperiod>(
+        2, "workhours", "workhours", "", "09:00-18:00", "09:00-18:00",
+        "09:00-18:00", "09:00-18:00", "09:00-18:00", ""));
+    time_t day(_midnight(1577880000));  // 2020-01-01 12:00 UTC.
+    for (int i(0); i <= 30; ++i) {
+      _days.push_back(day);
+      day = time::timeperiod::add_round_days_to_midnight(day, 3600 * 24);
+    }
+  }
+
+ protected:
+  typedef std::map<std::pair<uint32_t, uint32_t>, bam::availability_builder>
+      day_builders;
+
+  static time_t _midnight(time_t when) {
+    struct tm tmv;
+    localtime_r(&when, &tmv);
+    tmv.tm_sec = tmv.tm_min = tmv.tm_hour = 0;
+    return mktime(&tmv);
+  }
+
+  // Former computation of a day: every event matching the day is added
+  // to the builder of its BA and timeperiod.
+  static day_builders _compute_day(
+      std::vector<std::pair<uint32_t, bam::availability_batch::event>> const&
+          events,
+      time_t day_start,
+      time_t day_end) {
+    day_builders retval;
+    for (std::pair<uint32_t, bam::availability_batch::event> const& p :
+         events) {
+      bam::availability_batch::event const& e(p.second);
+      if (e.start_time >= day_end || (e.end_time && e.end_time < day_start))
+        continue;
+      std::pair<uint32_t, uint32_t> key(p.first, e.timeperiod_id);
+      day_builders::iterator found(retval.find(key));
+      if (found == retval.end())
+        found = retval
+                    .insert(std::make_pair(
+                        key, bam::availability_builder(day_end, day_start)))
+                    .first;
+      found->second.add_event(
+          e.status, e.start_time, e.end_time, e.in_downtime, e.tp);
+      found->second.set_timeperiod_is_default(e.timeperiod_is_default);
+    }
+    return retval;
+  }
+
+  std::vector<time_t> _days;
+  std::vector<time::timeperiod::ptr> _tps;
+};
+
+// Given events of many BAs over a month, some not finished
+// When the batch computes their availabilities with several threads
+// Then each day gives the availabilities computed day after day.
+TEST_F(BamAvailabilityBatch, SameAsDaily) {
+  std::mt19937 gen;
+  std::uniform_int_distribution<int> duration(60, 3 * 24 * 3600);
+  std::uniform_int_distribution<int> status(0, 3);
+  std::vector<std::pair<uint32_t, bam::availability_batch::event>> events;
+  for (uint32_t ba_id(1); ba_id <= 50; ++ba_id) {
+    time_t start(_days.front() - 24 * 3600);
+    while (start < _days.back()) {
+      time_t end(start + duration(gen));
+      bool opened(end >= _days.back() && ba_id % 2);
+      for (time::timeperiod::ptr const& tp : _tps) {
+        bam::availability_batch::event e;
+        e.timeperiod_id = tp->get_id();
+        e.tp = tp;
+        e.timeperiod_is_default = (tp->get_id() == 1);
+        e.status = status(gen);
+        e.start_time = start;
+        e.end_time = opened ? 0 : end;
+        e.in_downtime = (status(gen) == 0);
+        events.push_back(std::make_pair(ba_id, e));
+      }
+      start = end;
+    }
+  }
+
+  bam::availability_batch batch(_days);
+  for (std::pair<uint32_t, bam::availability_batch::event> const& p : events)
+    batch.add_event(p.first, p.second);
+  batch.compute(4);
+
+  std::vector<bam::availability_batch::availability> const& result(
+      batch.get_availabilities());
+  std::map<std::pair<time_t, std::pair<uint32_t, uint32_t>>,
+           bam::availability_builder const*>
+      by_day;
+  for (bam::availability_batch::availability const& a : result)
+    by_day.insert(std::make_pair(
+        std::make_pair(a.day_start, std::make_pair(a.ba_id, a.timeperiod_id)),
+        &a.builder));
+
+  size_t expected_count(0);
+  for (size_t i(0); i + 1 < _days.size(); ++i) {
+    day_builders expected(_compute_day(events, _days[i], _days[i + 1]));
+    expected_count += expected.size();
+    for (day_builders::value_type const& b : expected) {
+      auto found(by_day.find(std::make_pair(_days[i], b.first)));
+      ASSERT_NE(found, by_day.end());
+      bam::availability_builder const& builder(*found->second);
+      ASSERT_EQ(builder.get_available(), b.second.get_available());
+      ASSERT_EQ(builder.get_unavailable(), b.second.get_unavailable());
+      ASSERT_EQ(builder.get_degraded(), b.second.get_degraded());
+      ASSERT_EQ(builder.get_unknown(), b.second.get_unknown());
+      ASSERT_EQ(builder.get_downtime(), b.second.get_downtime());
+      ASSERT_EQ(builder.get_unavailable_opened(),
+                b.second.get_unavailable_opened());
+      ASSERT_EQ(builder.get_degraded_opened(),
+                b.second.get_degraded_opened());
+      ASSERT_EQ(builder.get_unknown_opened(), b.second.get_unknown_opened());
+      ASSERT_EQ(builder.get_downtime_opened(),
+                b.second.get_downtime_opened());
+      ASSERT_EQ(builder.get_timeperiod_is_default(),
+                b.second.get_timeperiod_is_default());
+    }
+  }
+  ASSERT_EQ(result.size(), expected_count);
+}
+
+// Given BAs whose availabilities are already written up to different days
+// When the batch computes their availabilities
+// Then only the following days are computed, each one from the event
+// not finished.
+TEST_F(BamAvailabilityBatch, FirstDay) {
+  bam::availability_batch batch(_days);
+  for (uint32_t ba_id(1); ba_id <= 3; ++ba_id) {
+    bam::availability_batch::event e;
+    e.timeperiod_id = 1;
+    e.tp = _tps[0];
+    e.timeperiod_is_default = true;
+    e.status = 0;
+    e.start_time = _days.front() - 3600;
+    e.end_time = 0;
+    e.in_downtime = false;
+    batch.add_event(ba_id, e);
+  }
+  batch.set_first_day(2, _days[10]);
+  batch.set_first_day(3, _days.back());
+  batch.compute();
+
+  std::map<uint32_t, std::vector<time_t>> days;
+  for (bam::availability_batch::availability const& a :
+       batch.get_availabilities()) {
+    days[a.ba_id].push_back(a.day_start);
+    time_t day_end(
+        time::timeperiod::add_round_days_to_midnight(a.day_start, 3600 * 24));
+    ASSERT_EQ(a.builder.get_available(), day_end - a.day_start);
+  }
+  ASSERT_EQ(days[1], std::vector<time_t>(_days.begin(), _days.end() - 1));
+  ASSERT_EQ(days[2], std::vector<time_t>(_days.begin() + 10, _days.end() - 1));
+  ASSERT_TRUE(days[3].empty());
+}
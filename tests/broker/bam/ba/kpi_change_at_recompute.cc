@@ -22,6 +22,7 @@
 #include <stack>
 #include <vector>
 #include "com/centreon/broker/bam/ba.hh"
+#include "com/centreon/broker/bam/ba_status.hh"
 #include "com/centreon/broker/bam/configuration/applier/state.hh"
 #include "com/centreon/broker/bam/kpi_service.hh"
 #include "com/centreon/broker/config/applier/init.hh"
@@ -31,6 +32,33 @@
 
 using namespace com::centreon::broker;
 
+/**
+ *  Stream keeping the events written to it.
+ */
+class event_list : public io::stream {
+ public:
+  bool read(std::shared_ptr<io::data>& d, time_t deadline) override {
+    (void)deadline;
+    d.reset();
+    return true;
+  }
+
+  int write(std::shared_ptr<io::data> const& d) override {
+    events.push_back(d);
+    return 1;
+  }
+
+  size_t count(uint32_t type) const {
+    size_t retval(0);
+    for (std::shared_ptr<io::data> const& d : events)
+      if (d->type() == type)
+        ++retval;
+    return retval;
+  }
+
+  std::vector<std::shared_ptr<io::data> > events;
+};
+
 class BamBA : public ::testing::Test {
  public:
   void SetUp() override {
@@ -948,3 +976,87 @@ TEST_F(BamBA, DtIgnoreKpiRatio) {
     results.pop();
   }
 }
+
+/**
+ *  Check that a BA with deferred publication generates the same BA
+ *  events as an immediate one, but a single status per publication.
+ *
+ *                 ----------------
+ *         ________| BA(C40%:W70%)|___________
+ *        /        ----------------           \
+ *       |                  |                 |
+ *  KPI1(C20%:W10%)   KPI2(C20%:W10%)  KPI3(C20%:W10%)
+ *       |                  |                 |
+ *      H1S1               H2S1             H3S1
+ */
+TEST_F(BamBA, DeferredPublication) {
+  std::shared_ptr<bam::ba> bas[2] = {std::make_shared<bam::ba>(false),
+                                     std::make_shared<bam::ba>(false)};
+  event_list visitors[2];
+  std::vector<std::shared_ptr<bam::kpi_service> > kpis[2];
+  bas[1]->set_deferred_publication(true);
+
+  for (int b = 0; b < 2; b++) {
+    bas[b]->set_id(1);
+    bas[b]->set_level_warning(70.0);
+    bas[b]->set_level_critical(40.0);
+    for (int i = 0; i < 3; i++) {
+      std::shared_ptr<bam::kpi_service> k(new bam::kpi_service);
+      k->set_host_id(i + 1);
+      k->set_service_id(1);
+      k->set_impact_warning(10);
+      k->set_impact_critical(20);
+      k->set_state_hard(bam::kpi_service::state::state_ok);
+      k->set_state_soft(k->get_state_hard());
+      bas[b]->add_impact(k);
+      k->add_parent(bas[b]);
+      kpis[b].push_back(k);
+    }
+    bas[b]->visit(&visitors[b]);
+  }
+
+  time_t now(time(nullptr));
+  for (int i = 0; i < 2; i++) {
+    for (size_t j = 0; j < 3; j++) {
+      for (int b = 0; b < 2; b++) {
+        std::shared_ptr<neb::service_status> ss(new neb::service_status);
+        ss->host_id = j + 1;
+        ss->service_id = 1;
+        ss->last_check = now + i * 3 + j;
+        ss->last_hard_state = i + 1;
+        ss->current_state = ss->last_hard_state;
+        kpis[b][j]->service_update(ss, &visitors[b]);
+      }
+    }
+  }
+
+  // Same BA events, in the same order.
+  std::vector<bam::ba_event*> ba_events[2];
+  for (int b = 0; b < 2; b++)
+    for (std::shared_ptr<io::data> const& d : visitors[b].events)
+      if (d->type() == bam::ba_event::static_type())
+        ba_events[b].push_back(static_cast<bam::ba_event*>(d.get()));
+  ASSERT_EQ(ba_events[0].size(), ba_events[1].size());
+  ASSERT_GT(ba_events[0].size(), 1u);
+  for (size_t i = 0; i < ba_events[0].size(); i++) {
+    ASSERT_EQ(ba_events[0][i]->status, ba_events[1][i]->status);
+    ASSERT_EQ(ba_events[0][i]->start_time, ba_events[1][i]->start_time);
+    ASSERT_EQ(ba_events[0][i]->end_time, ba_events[1][i]->end_time);
+  }
+
+  // The immediate BA generated a status per update, the deferred one
+  // only the initial status so far.
+  ASSERT_EQ(visitors[0].count(bam::ba_status::static_type()), 7u);
+  ASSERT_EQ(visitors[1].count(bam::ba_status::static_type()), 1u);
+
+  bas[1]->publish(&visitors[1]);
+  ASSERT_EQ(visitors[1].count(bam::ba_status::static_type()), 2u);
+  bam::ba_status const& status(
+      *std::static_pointer_cast<bam::ba_status>(visitors[1].events.back()));
+  ASSERT_EQ(status.state, bas[0]->get_state_hard());
+  ASSERT_TRUE(status.state_changed);
+
+  // Nothing changed since the last publication.
+  bas[1]->publish(&visitors[1]);
+  ASSERT_EQ(visitors[1].count(bam::ba_status::static_type()), 2u);
+}
@@ -0,0 +1,121 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/bam/command_channel.hh"
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <string>
+
+using namespace com::centreon::broker;
+
+class BamCommandChannel : public ::testing::Test {
+ public:
+  void SetUp() override {
+    _path = "/tmp/bam_command_channel_test";
+    ::unlink(_path.c_str());
+    ASSERT_EQ(::mkfifo(_path.c_str(), S_IRUSR | S_IWUSR), 0);
+    _fd = -1;
+  }
+
+  void TearDown() override {
+    _close_reader();
+    ::unlink(_path.c_str());
+  }
+
+ protected:
+  void _open_reader() {
+    _fd = ::open(_path.c_str(), O_RDONLY | O_NONBLOCK);
+  }
+
+  void _close_reader() {
+    if (_fd >= 0) {
+      ::close(_fd);
+      _fd = -1;
+    }
+  }
+
+  std::string _read() {
+    std::string retval;
+    char buffer[4096];
+    ssize_t rb;
+    while ((rb = ::read(_fd, buffer, sizeof(buffer))) > 0)
+      retval.append(buffer, rb);
+    return retval;
+  }
+
+  int _fd;
+  std::string _path;
+};
+
+// Given a command channel on a FIFO not read by the engine
+// When commands are written and flushed
+// Then they are kept until the engine reads the FIFO.
+TEST_F(BamCommandChannel, NoReader) {
+  bam::command_channel channel(_path);
+  channel.write("[1] SCHEDULE_FORCED_SVC_CHECK;h;s;1");
+  channel.write("[2] SCHEDULE_FORCED_SVC_CHECK;h;s;2");
+  ASSERT_FALSE(channel.flush());
+
+  _open_reader();
+  ASSERT_TRUE(channel.flush());
+  ASSERT_EQ(channel.get_pending(), 0u);
+  ASSERT_EQ(_read(),
+            "[1] SCHEDULE_FORCED_SVC_CHECK;h;s;1\n"
+            "[2] SCHEDULE_FORCED_SVC_CHECK;h;s;2\n");
+}
+
+// Given a command channel whose FIFO is read by the engine
+// When the engine restarts
+// Then commands written meanwhile are sent to the new engine.
+TEST_F(BamCommandChannel, EngineRestart) {
+  bam::command_channel channel(_path);
+  _open_reader();
+  channel.write("[1] SCHEDULE_FORCED_SVC_CHECK;h;s;1");
+  ASSERT_TRUE(channel.flush());
+  ASSERT_EQ(_read(), "[1] SCHEDULE_FORCED_SVC_CHECK;h;s;1\n");
+
+  _close_reader();
+  channel.write("[2] SCHEDULE_FORCED_SVC_CHECK;h;s;2");
+  ASSERT_FALSE(channel.flush());
+  ASSERT_FALSE(channel.flush());
+
+  _open_reader();
+  channel.write("[3] SCHEDULE_FORCED_SVC_CHECK;h;s;3");
+  ASSERT_TRUE(channel.flush());
+  ASSERT_EQ(_read(),
+            "[2] SCHEDULE_FORCED_SVC_CHECK;h;s;2\n"
+            "[3] SCHEDULE_FORCED_SVC_CHECK;h;s;3\n");
+}
+
+// Given a command channel on a FIFO not read by the engine
+// When more commands than the channel can hold are written
+// Then the oldest commands are dropped.
+TEST_F(BamCommandChannel, Overflow) {
+  bam::command_channel channel(_path, 64);
+  for (int i(0); i < 10; ++i)
+    channel.write("COMMAND_" + std::to_string(i));
+  ASSERT_LE(channel.get_pending(), 64u);
+
+  _open_reader();
+  ASSERT_TRUE(channel.flush());
+  std::string content(_read());
+  ASSERT_EQ(content.find("COMMAND_0\n"), std::string::npos);
+  ASSERT_EQ(content.substr(content.size() - 10), "COMMAND_9\n");
+}
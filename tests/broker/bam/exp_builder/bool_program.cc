@@ -0,0 +1,160 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/bam/bool_program.hh"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <string>
+#include "com/centreon/broker/bam/bool_service.hh"
+#include "com/centreon/broker/bam/exp_builder.hh"
+#include "com/centreon/broker/bam/exp_parser.hh"
+#include "com/centreon/broker/neb/service_status.hh"
+
+using namespace com::centreon::broker;
+
+class BamBoolProgram : public ::testing::Test {
+ public:
+  void SetUp() override {
+    for (uint32_t i(1); i <= 6; ++i)
+      _mapping.set_service("h", "s" + std::to_string(i), 1, i, true);
+  }
+
+ protected:
+  /**
+   *  Generate a random expression.
+   */
+  std::string _generate(int depth) {
+    static char const* const constants[] = {"OK", "WARNING", "CRITICAL",
+                                            "UNKNOWN", "0", "1", "2", "3"};
+    static char const* const operators[] = {
+        "&&", "||", "^", "==", "!=", ">", ">=", "<",
+        "<=", "+",  "-", "*", "/",  "%",  "AND", "IS"};
+    std::uniform_int_distribution<int> percent(0, 99);
+    if (depth == 0 || percent(_gen) < 25) {
+      if (percent(_gen) < 70)
+        return "SERVICESTATUS('h', 's" +
+               std::to_string(std::uniform_int_distribution<int>(1, 6)(_gen)) +
+               "')";
+      return constants[std::uniform_int_distribution<int>(0, 7)(_gen)];
+    }
+    if (percent(_gen) < 15)
+      return "!(" + _generate(depth - 1) + ")";
+    std::string left(_generate(depth - 1));
+    std::string right(_generate(depth - 1));
+    return "(" + left + " " +
+           operators[std::uniform_int_distribution<int>(0, 15)(_gen)] + " " +
+           right + ")";
+  }
+
+  /**
+   *  Send a random service status to the services of both expressions.
+   */
+  void _update(bam::exp_builder::list_service const& tree_services,
+               bam::exp_builder::list_service const& program_services) {
+    std::shared_ptr<neb::service_status> ss(
+        std::make_shared<neb::service_status>());
+    ss->host_id = 1;
+    ss->service_id = std::uniform_int_distribution<int>(1, 6)(_gen);
+    ss->last_hard_state = std::uniform_int_distribution<int>(0, 3)(_gen);
+    ss->current_state = std::uniform_int_distribution<int>(0, 3)(_gen);
+    ss->downtime_depth = std::uniform_int_distribution<int>(0, 3)(_gen) == 0;
+    for (bam::bool_service::ptr const& s : tree_services)
+      s->service_update(ss);
+    for (bam::bool_service::ptr const& s : program_services)
+      s->service_update(ss);
+  }
+
+  static void _compare(bam::bool_value& tree,
+                       bam::bool_value& program,
+                       std::string const& expression) {
+    double tree_hard(tree.value_hard());
+    double tree_soft(tree.value_soft());
+    double program_hard(program.value_hard());
+    double program_soft(program.value_soft());
+    if (std::isnan(tree_hard))
+      ASSERT_TRUE(std::isnan(program_hard)) << expression;
+    else
+      ASSERT_EQ(tree_hard, program_hard) << expression;
+    if (std::isnan(tree_soft))
+      ASSERT_TRUE(std::isnan(program_soft)) << expression;
+    else
+      ASSERT_EQ(tree_soft, program_soft) << expression;
+    ASSERT_EQ(tree.state_known(), program.state_known()) << expression;
+    ASSERT_EQ(tree.in_downtime(), program.in_downtime()) << expression;
+  }
+
+  std::mt19937 _gen;
+  bam::hst_svc_mapping _mapping;
+};
+
+// Given a boolean expression
+// When it is compiled
+// Then the program has an instruction per node of the tree
+// And it follows the state of the services.
+TEST_F(BamBoolProgram, Simple) {
+  bam::exp_parser p("{h s1} {IS} {OK} {AND} {h s2} {NOT} {CRITICAL}");
+  bam::exp_builder builder(p.get_postfix(), _mapping);
+  bam::bool_program::ptr program(
+      bam::bool_program::compile(builder.get_tree()));
+  ASSERT_EQ(program->get_size(), 7u);
+  ASSERT_FALSE(program->state_known());
+  ASSERT_EQ(program->value_hard(), 1);
+
+  std::shared_ptr<neb::service_status> ss(
+      std::make_shared<neb::service_status>());
+  ss->host_id = 1;
+  ss->service_id = 1;
+  ss->last_hard_state = 0;
+  ss->current_state = 0;
+  for (bam::bool_service::ptr const& s : builder.get_services())
+    s->service_update(ss);
+  ASSERT_FALSE(program->state_known());
+  ASSERT_EQ(program->value_hard(), 1);
+  ASSERT_EQ(program->value_soft(), 1);
+
+  ss->service_id = 2;
+  ss->last_hard_state = 2;
+  ss->current_state = 1;
+  for (bam::bool_service::ptr const& s : builder.get_services())
+    s->service_update(ss);
+  ASSERT_TRUE(program->state_known());
+  ASSERT_EQ(program->value_hard(), 0);
+  ASSERT_EQ(program->value_soft(), 1);
+}
+
+// Given randomly generated boolean expressions
+// When the same service statuses are sent to their trees and programs
+// Then both always give the same values.
+TEST_F(BamBoolProgram, SameAsTree) {
+  for (int i(0); i < 500; ++i) {
+    std::string expression(_generate(5));
+    bam::exp_parser p(expression);
+    bam::exp_parser::notation const& postfix(p.get_postfix());
+    bam::exp_builder tree_builder(postfix, _mapping);
+    bam::exp_builder program_builder(postfix, _mapping);
+    bam::bool_value::ptr tree(tree_builder.get_tree());
+    bam::bool_program::ptr program(
+        bam::bool_program::compile(program_builder.get_tree()));
+    _compare(*tree, *program, expression);
+    for (int j(0); j < 50; ++j) {
+      _update(tree_builder.get_services(), program_builder.get_services());
+      _compare(*tree, *program, expression);
+    }
+  }
+}
@@ -0,0 +1,90 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/bam/meta_service.hh"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include "com/centreon/broker/storage/metric.hh"
+
+using namespace com::centreon::broker;
+
+class BamMetaService : public ::testing::Test {
+ protected:
+  static std::shared_ptr<storage::metric> _metric(uint32_t metric_id,
+                                                  double value) {
+    std::shared_ptr<storage::metric> m(std::make_shared<storage::metric>());
+    m->metric_id = metric_id;
+    m->value = value;
+    return m;
+  }
+
+  std::mt19937 _gen;
+};
+
+// Given meta-services with each computation method
+// When their metrics are updated, added or removed
+// Then their values are the ones of a full computation.
+TEST_F(BamMetaService, Computations) {
+  bam::meta_service::computation_type types[] = {
+      bam::meta_service::average, bam::meta_service::min,
+      bam::meta_service::max, bam::meta_service::sum};
+  std::uniform_int_distribution<uint32_t> metric(1, 200);
+  std::uniform_int_distribution<int> value(-1000, 1000);
+  for (bam::meta_service::computation_type type : types) {
+    bam::meta_service ms;
+    ms.set_computation(type);
+    ASSERT_TRUE(std::isnan(ms.get_value()) ||
+                type == bam::meta_service::sum);
+    std::unordered_map<uint32_t, double> values;
+    for (uint32_t i(1); i <= 100; ++i) {
+      ms.add_metric(i);
+      values[i] = 0.0;
+    }
+    for (int i(0); i < 10000; ++i) {
+      uint32_t id(metric(_gen));
+      if (i % 100 == 0) {
+        ms.remove_metric(id);
+        values.erase(id);
+      } else if (i % 100 == 50) {
+        ms.add_metric(id);
+        values[id] = 0.0;
+      } else {
+        double v(value(_gen) / 10.0);
+        ms.metric_update(_metric(id, v));
+        if (values.find(id) != values.end())
+          values[id] = v;
+      }
+
+      double expected(type == bam::meta_service::min
+                          ? INFINITY
+                          : type == bam::meta_service::max ? -INFINITY : 0.0);
+      for (std::pair<uint32_t const, double> const& p : values)
+        if (type == bam::meta_service::min)
+          expected = std::min(expected, p.second);
+        else if (type == bam::meta_service::max)
+          expected = std::max(expected, p.second);
+        else
+          expected += p.second;
+      if (type == bam::meta_service::average)
+        expected /= values.size();
+      ASSERT_NEAR(ms.get_value(), expected, 1e-6);
+    }
+  }
+}
@@ -0,0 +1,153 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "com/centreon/broker/bam/meta_service.hh"
+#include "com/centreon/broker/storage/metric.hh"
+
+using namespace com::centreon::broker;
+
+namespace {
+/**
+ *  Former meta-service computation: values in a hash table, partial
+ *  recomputation unless the extreme value changes, full scan every 100
+ *  updates.
+ */
+class scan_meta_service {
+ public:
+  scan_meta_service(bam::meta_service::computation_type computation)
+      : _computation(computation), _recompute_count(0), _value(NAN) {}
+
+  void add_metric(uint32_t metric_id) {
+    _metrics[metric_id] = 0.0;
+    _recompute();
+  }
+
+  double get_value() const { return _value; }
+
+  void metric_update(uint32_t metric_id, double value) {
+    std::unordered_map<uint32_t, double>::iterator it(_metrics.find(metric_id));
+    if (it == _metrics.end() || it->second == value)
+      return;
+    double old_value(it->second);
+    it->second = value;
+    if (++_recompute_count >= 100)
+      _recompute();
+    else if (_computation == bam::meta_service::min) {
+      if (value <= _value)
+        _value = value;
+      else if (_value == old_value)
+        _recompute();
+    } else if (_computation == bam::meta_service::max) {
+      if (value >= _value)
+        _value = value;
+      else if (_value == old_value)
+        _recompute();
+    } else if (_computation == bam::meta_service::sum)
+      _value = _value - old_value + value;
+    else
+      _value = _value + (value - old_value) / _metrics.size();
+  }
+
+ private:
+  void _recompute() {
+    if (_computation == bam::meta_service::min ||
+        _computation == bam::meta_service::max) {
+      bool is_min(_computation == bam::meta_service::min);
+      _value = NAN;
+      for (std::pair<uint32_t const, double> const& p : _metrics)
+        if (std::isnan(_value) || (is_min && p.second < _value) ||
+            (!is_min && p.second > _value))
+          _value = p.second;
+    } else {
+      _value = 0.0;
+      for (std::pair<uint32_t const, double> const& p : _metrics)
+        _value += p.second;
+      if (_computation != bam::meta_service::sum)
+        _value /= _metrics.size();
+    }
+    _recompute_count = 0;
+  }
+
+  bam::meta_service::computation_type _computation;
+  std::unordered_map<uint32_t, double> _metrics;
+  int _recompute_count;
+  double _value;
+};
+}  // namespace
+
+/**
+ *  Compare the meta-service computation of the minimum of many growing
+ *  counters, each update replacing the current minimum, to the former
+ *  computation and print both durations.
+ */
+int main() {
+  uint32_t const metrics(5000);
+  int const updates(20000);
+  std::vector<std::pair<uint32_t, double>> events;
+  for (int i(0); i < updates; ++i)
+    events.push_back({i % metrics + 1, metrics + i});
+
+  bam::meta_service ms;
+  ms.set_computation(bam::meta_service::min);
+  scan_meta_service former(bam::meta_service::min);
+  std::vector<std::shared_ptr<storage::metric>> metric_events;
+  for (uint32_t i(1); i <= metrics; ++i) {
+    ms.add_metric(i);
+    former.add_metric(i);
+  }
+  for (uint32_t i(1); i <= metrics; ++i) {
+    std::shared_ptr<storage::metric> m(std::make_shared<storage::metric>());
+    m->metric_id = i;
+    m->value = i;
+    ms.metric_update(m);
+    former.metric_update(i, i);
+  }
+  for (std::pair<uint32_t, double> const& e : events) {
+    std::shared_ptr<storage::metric> m(std::make_shared<storage::metric>());
+    m->metric_id = e.first;
+    m->value = e.second;
+    metric_events.push_back(m);
+  }
+
+  auto start(std::chrono::steady_clock::now());
+  for (std::pair<uint32_t, double> const& e : events)
+    former.metric_update(e.first, e.second);
+  auto middle(std::chrono::steady_clock::now());
+  for (std::shared_ptr<storage::metric> const& m : metric_events)
+    ms.metric_update(m);
+  auto end(std::chrono::steady_clock::now());
+
+  std::chrono::microseconds former_duration(
+      std::chrono::duration_cast<std::chrono::microseconds>(middle - start));
+  std::chrono::microseconds duration(
+      std::chrono::duration_cast<std::chrono::microseconds>(end - middle));
+  std::cout << "meta-service MIN of " << metrics << " metrics, " << updates
+            << " updates: former " << former_duration.count()
+            << " us, aggregation tree " << duration.count() << " us"
+            << std::endl;
+  return ms.get_value() == former.get_value() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/http/client.hh"
+#include <gtest/gtest.h>
+#include <zlib.h>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+
+static uint16_t const stand_in_port = 4244;
+
+/**
+ *  Minimal HTTP/1.1 server: it answers pipelined requests in order and
+ *  keeps connections open unless /close is requested.
+ *
+ *    /close    204 then the connection is closed.
+ *    /echo     200 with the (gunzipped) request body.
+ *    /chunked  200 with a chunked body "hello world".
+ *    others    204.
+ */
+class http_stand_in {
+  struct session {
+    asio::ip::tcp::socket socket;
+    std::string buf;
+    char tmp[4096];
+
+    session(asio::io_context& ctx) : socket{ctx} {}
+  };
+
+  asio::io_context _ctx;
+  asio::ip::tcp::acceptor _acceptor;
+  std::thread _thread;
+
+  static std::string _gunzip(std::string const& data) {
+    z_stream zs{};
+    inflateInit2(&zs, 15 + 16);
+    std::string retval;
+    char out[4096];
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    zs.avail_in = data.size();
+    int ret;
+    do {
+      zs.next_out = reinterpret_cast<Bytef*>(out);
+      zs.avail_out = sizeof(out);
+      ret = inflate(&zs, Z_NO_FLUSH);
+      retval.append(out, sizeof(out) - zs.avail_out);
+    } while (ret == Z_OK);
+    inflateEnd(&zs);
+    return retval;
+  }
+
+  void _accept() {
+    std::shared_ptr<session> s{std::make_shared<session>(_ctx)};
+    _acceptor.async_accept(s->socket, [this, s](std::error_code const& err) {
+      if (err)
+        return;
+      ++connections;
+      _read(s);
+      _accept();
+    });
+  }
+
+  void _read(std::shared_ptr<session> s) {
+    s->socket.async_read_some(
+        asio::buffer(s->tmp, sizeof(s->tmp)),
+        [this, s](std::error_code const& err, size_t bytes) {
+          if (err)
+            return;
+          s->buf.append(s->tmp, bytes);
+          if (_process(s))
+            _read(s);
+        });
+  }
+
+  bool _process(std::shared_ptr<session> const& s) {
+    for (;;) {
+      size_t end_headers{s->buf.find("\r\n\r\n")};
+      if (end_headers == std::string::npos)
+        return true;
+      std::string headers{s->buf.substr(0, end_headers)};
+      size_t length{0};
+      size_t pos{headers.find("Content-Length: ")};
+      if (pos != std::string::npos)
+        length = std::stoul(headers.substr(pos + 16));
+      if (s->buf.size() < end_headers + 4 + length)
+        return true;
+      std::string body{s->buf.substr(end_headers + 4, length)};
+      s->buf.erase(0, end_headers + 4 + length);
+      ++requests;
+
+      if (headers.find("Content-Encoding: gzip") != std::string::npos)
+        body = _gunzip(body);
+
+      std::string target{headers.substr(headers.find(' ') + 1)};
+      target.resize(target.find(' '));
+
+      std::string answer;
+      bool close{false};
+      if (target == "/close") {
+        answer = "HTTP/1.1 204 No Content\r\nConnection: close\r\n\r\n";
+        close = true;
+      } else if (target == "/echo")
+        answer = "HTTP/1.1 200 OK\r\nContent-Length: " +
+                 std::to_string(body.size()) + "\r\n\r\n" + body;
+      else if (target == "/chunked")
+        answer =
+            "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+            "5\r\nhello\r\n6\r\n world\r\n0\r\n\r\n";
+      else
+        answer = "HTTP/1.1 204 No Content\r\n\r\n";
+
+      std::error_code err;
+      asio::write(s->socket, asio::buffer(answer), err);
+      if (close || err) {
+        s->socket.shutdown(asio::ip::tcp::socket::shutdown_both, err);
+        s->socket.close(err);
+        return false;
+      }
+    }
+  }
+
+ public:
+  std::atomic_int connections;
+  std::atomic_int requests;
+
+  http_stand_in() : _acceptor{_ctx}, connections{0}, requests{0} {
+    asio::ip::tcp::endpoint ep{asio::ip::tcp::v4(), stand_in_port};
+    _acceptor.open(ep.protocol());
+    _acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+    _acceptor.bind(ep);
+    _acceptor.listen();
+    _accept();
+    _thread = std::thread([this] { _ctx.run(); });
+  }
+
+  ~http_stand_in() {
+    _ctx.stop();
+    _thread.join();
+  }
+};
+
+class HttpClient : public testing::Test {
+ public:
+  void SetUp() override { _server.reset(new http_stand_in); }
+  void TearDown() override { _server.reset(); }
+
+  std::unique_ptr<http_stand_in> _server;
+};
+
+TEST_F(HttpClient, BadConnection) {
+  http::client c{"localhost", 4245, http::client::config()};
+  ASSERT_THROW(c.connect(), msg_fmt);
+}
+
+TEST_F(HttpClient, Simple) {
+  http::client c{"127.0.0.1", stand_in_port, http::client::config()};
+  c.connect();
+  http::response r{c.send(http::request("POST", "/write", "a b=1\n")).get()};
+  ASSERT_EQ(r.code, 204);
+  ASSERT_EQ(c.in_flight(), 0u);
+}
+
+TEST_F(HttpClient, KeepAlive) {
+  http::client c{"127.0.0.1", stand_in_port, http::client::config()};
+  c.connect();
+  for (int i = 0; i < 10; ++i)
+    ASSERT_EQ(c.send(http::request("POST", "/write", "a b=1\n")).get().code,
+              204);
+  ASSERT_EQ(_server->connections, 1);
+  ASSERT_EQ(_server->requests, 10);
+}
+
+TEST_F(HttpClient, Pipeline) {
+  http::client::config conf;
+  conf.max_connections = 2;
+  conf.max_pipeline = 8;
+  http::client c{"127.0.0.1", stand_in_port, conf};
+  c.connect();
+
+  std::vector<std::future<http::response> > answers;
+  for (int i = 0; i < 100; ++i)
+    answers.push_back(c.send(
+        http::request("POST", "/echo", "a b=" + std::to_string(i) + "\n")));
+  for (int i = 0; i < 100; ++i) {
+    http::response r{answers[i].get()};
+    ASSERT_EQ(r.code, 200);
+    ASSERT_EQ(r.body, "a b=" + std::to_string(i) + "\n");
+  }
+  ASSERT_LE(_server->connections, 2);
+  ASSERT_EQ(_server->requests, 100);
+}
+
+TEST_F(HttpClient, Gzip) {
+  http::client::config conf;
+  conf.gzip = true;
+  http::client c{"127.0.0.1", stand_in_port, conf};
+  std::string body;
+  for (int i = 0; i < 1000; ++i)
+    body.append("cpu,host=host1 value=").append(std::to_string(i)).append("\n");
+  http::response r{c.send(http::request("POST", "/echo", body)).get()};
+  ASSERT_EQ(r.code, 200);
+  ASSERT_EQ(r.body, body);
+}
+
+TEST_F(HttpClient, Chunked) {
+  http::client c{"127.0.0.1", stand_in_port, http::client::config()};
+  http::response r{c.send(http::request("POST", "/chunked", "")).get()};
+  ASSERT_EQ(r.code, 200);
+  ASSERT_EQ(r.body, "hello world");
+}
+
+TEST_F(HttpClient, ServerCloses) {
+  http::client::config conf;
+  conf.max_pipeline = 4;
+  http::client c{"127.0.0.1", stand_in_port, conf};
+
+  // Requests pipelined behind /close are sent again on a new connection.
+  std::future<http::response> r1{c.send(http::request("POST", "/close", ""))};
+  std::future<http::response> r2{c.send(http::request("POST", "/echo", "x"))};
+  ASSERT_EQ(r1.get().code, 204);
+  ASSERT_EQ(r2.get().body, "x");
+  ASSERT_EQ(_server->connections, 2);
+}
+
+TEST(HttpResponseParser, Split) {
+  std::string const answer{
+      "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhelloHTTP/1.1 204 No "
+      "Content\r\n\r\n"};
+  http::response_parser parser;
+
+  // Bytes come one by one.
+  size_t pos{0};
+  while (!parser.done())
+    pos += parser.parse(answer.data() + pos, 1);
+  ASSERT_EQ(parser.get().code, 200);
+  ASSERT_EQ(parser.get().body, "hello");
+
+  // The second response was not consumed.
+  parser.reset();
+  pos += parser.parse(answer.data() + pos, answer.size() - pos);
+  ASSERT_TRUE(parser.done());
+  ASSERT_EQ(parser.get().code, 204);
+  ASSERT_EQ(pos, answer.size());
+}
+
+TEST(HttpResponseParser, BadStatus) {
+  std::string const answer{"HTTP/1.1 foo\r\n\r\n"};
+  http::response_parser parser;
+  ASSERT_THROW(parser.parse(answer.data(), answer.size()), msg_fmt);
+}
@@ -0,0 +1,124 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/io/data_pool.hh"
+#include <gtest/gtest.h>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "com/centreon/broker/io/data.hh"
+#include "com/centreon/broker/io/events.hh"
+
+using namespace com::centreon::broker;
+
+namespace {
+// An event the size of a service status.
+class bench_event : public io::data {
+ public:
+  bench_event(uint32_t id)
+      : io::data(io::events::data_type<io::events::internal, 42>::value),
+        id(id) {
+    for (uint32_t& v : values)
+      v = id;
+  }
+
+  uint32_t id;
+  uint32_t values[100];
+};
+
+}  // namespace
+
+// Given blocks of all the sizes handled by the pool
+// When they are released and allocated again
+// Then they are reused and aligned for any type.
+TEST(IODataPool, Reuse) {
+  std::vector<std::pair<void*, size_t>> blocks;
+  for (size_t size(1); size <= io::data_pool::max_block_size + 64; size += 7)
+    blocks.push_back({io::data_pool::allocate(size), size});
+  for (std::pair<void*, size_t> const& b : blocks)
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(b.first) % alignof(std::max_align_t),
+              0u);
+  for (std::pair<void*, size_t> const& b : blocks)
+    io::data_pool::deallocate(b.first, b.second);
+
+  size_t slabs(io::data_pool::get_slabs_count());
+  for (int i(0); i < 10; ++i) {
+    for (std::pair<void*, size_t>& b : blocks)
+      b.first = io::data_pool::allocate(b.second);
+    for (std::pair<void*, size_t> const& b : blocks)
+      io::data_pool::deallocate(b.first, b.second);
+  }
+  ASSERT_EQ(io::data_pool::get_slabs_count(), slabs);
+}
+
+// Given events created by a thread and released by another one
+// When this is done many times with a bounded number of events in flight
+// Then events keep their content and their blocks are reused.
+TEST(IODataPool, CrossThread) {
+  std::mutex m;
+  std::condition_variable cv;
+  std::condition_variable cv_room;
+  std::list<std::shared_ptr<io::data>> queue;
+  bool done(false);
+  uint32_t const count(200000);
+  size_t const in_flight(1000);
+
+  std::thread consumer([&]() {
+    uint32_t expected(0);
+    for (;;) {
+      std::unique_lock<std::mutex> lock(m);
+      cv.wait(lock, [&]() { return done || !queue.empty(); });
+      if (queue.empty())
+        break;
+      std::shared_ptr<io::data> d(queue.front());
+      queue.pop_front();
+      cv_room.notify_one();
+      lock.unlock();
+      bench_event const& e(static_cast<bench_event const&>(*d));
+      ASSERT_EQ(e.id, expected);
+      ASSERT_EQ(e.values[99], expected);
+      ++expected;
+    }
+    ASSERT_EQ(expected, count);
+  });
+
+  size_t slabs(0);
+  for (uint32_t i(0); i < count; ++i) {
+    std::shared_ptr<io::data> d(io::make_event<bench_event>(i));
+    std::unique_lock<std::mutex> lock(m);
+    cv_room.wait(lock, [&]() { return queue.size() < in_flight; });
+    queue.push_back(d);
+    cv.notify_one();
+    if (i == count / 2)
+      slabs = io::data_pool::get_slabs_count();
+  }
+  {
+    std::lock_guard<std::mutex> lock(m);
+    done = true;
+    cv.notify_one();
+  }
+  consumer.join();
+
+  // Blocks released by the consumer came back to the producer, no slab
+  // was needed for the last events.
+  ASSERT_EQ(io::data_pool::get_slabs_count(), slabs);
+}
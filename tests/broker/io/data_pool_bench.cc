@@ -0,0 +1,133 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/io/data_pool.hh"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <memory>
+#include "com/centreon/broker/io/data.hh"
+#include "com/centreon/broker/io/events.hh"
+
+using namespace com::centreon::broker;
+
+namespace {
+// An event the size of a service status.
+class bench_event : public io::data {
+ public:
+  bench_event(uint32_t id)
+      : io::data(io::events::data_type<io::events::internal, 42>::value),
+        id(id) {
+    for (uint32_t& v : values)
+      v = id;
+  }
+
+  uint32_t id;
+  uint32_t values[100];
+};
+
+// Standard allocator counting its allocations.
+template <typename T>
+class counting_allocator {
+ public:
+  typedef T value_type;
+
+  counting_allocator(size_t* count) noexcept : count(count) {}
+  template <typename U>
+  counting_allocator(counting_allocator<U> const& other) noexcept
+      : count(other.count) {}
+
+  T* allocate(size_t n) {
+    ++*count;
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, size_t n) noexcept {
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  size_t* count;
+};
+
+template <typename T, typename U>
+bool operator==(counting_allocator<T> const& left,
+                counting_allocator<U> const& right) noexcept {
+  return left.count == right.count;
+}
+
+template <typename T, typename U>
+bool operator!=(counting_allocator<T> const& left,
+                counting_allocator<U> const& right) noexcept {
+  return left.count != right.count;
+}
+}  // namespace
+
+/**
+ *  Events go through a queue as in a muxer. They are allocated with
+ *  make_shared, then from the events pool. Allocations per event and
+ *  throughput are printed.
+ *
+ *  @return EXIT_SUCCESS if the pool spares the allocations.
+ */
+int main() {
+  uint32_t const count(1000000);
+  uint32_t const in_flight(1000);
+
+  // make_shared: one allocation per event and one per list node.
+  size_t allocations(0);
+  counting_allocator<bench_event> events_alloc(&allocations);
+  std::list<std::shared_ptr<io::data>,
+            counting_allocator<std::shared_ptr<io::data>>>
+      list(events_alloc);
+  auto start(std::chrono::steady_clock::now());
+  for (uint32_t i(0); i < count; ++i) {
+    list.push_back(std::allocate_shared<bench_event>(events_alloc, i));
+    if (list.size() > in_flight)
+      list.pop_front();
+  }
+  list.clear();
+  auto middle(std::chrono::steady_clock::now());
+
+  // Pool: the event with its control block, and the list node.
+  size_t slabs(io::data_pool::get_slabs_count());
+  std::list<std::shared_ptr<io::data>,
+            io::pool_allocator<std::shared_ptr<io::data>>>
+      pool_list;
+  for (uint32_t i(0); i < count; ++i) {
+    pool_list.push_back(io::make_event<bench_event>(i));
+    if (pool_list.size() > in_flight)
+      pool_list.pop_front();
+  }
+  pool_list.clear();
+  auto end(std::chrono::steady_clock::now());
+
+  double std_duration(std::chrono::duration<double>(middle - start).count());
+  double pool_duration(std::chrono::duration<double>(end - middle).count());
+  size_t pool_allocations(io::data_pool::get_slabs_count() - slabs);
+  std::cout << "make_shared: " << static_cast<double>(allocations) / count
+            << " allocations per event, " << count / std_duration
+            << " events/s" << std::endl
+            << "data pool: " << static_cast<double>(pool_allocations) / count
+            << " allocations per event, " << count / pool_duration
+            << " events/s" << std::endl;
+  return allocations == 2 * count && pool_allocations < count / 100
+             ? EXIT_SUCCESS
+             : EXIT_FAILURE;
+}
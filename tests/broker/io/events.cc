@@ -0,0 +1,150 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/io/events.hh"
+#include <gtest/gtest.h>
+#include <memory>
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/mapping/entry.hh"
+#include "com/centreon/broker/timestamp.hh"
+
+using namespace com::centreon::broker;
+
+namespace {
+// An event looking like a service status.
+class bench_event : public io::data {
+ public:
+  bench_event() : io::data(type_id) {}
+
+  uint32_t host_id = 0;
+  uint32_t service_id = 0;
+  short state = 0;
+  short state_type = 0;
+  int current_check_attempt = 0;
+  bool active_checks_enabled = false;
+  double execution_time = 0;
+  double latency = 0;
+  timestamp last_check;
+  timestamp next_check;
+  std::string output;
+  std::string perf_data;
+
+  static uint32_t type_id;
+  static mapping::entry const entries[];
+  static io::event_info::event_operations const operations;
+};
+
+uint32_t bench_event::type_id(0);
+
+mapping::entry const bench_event::entries[] = {
+    mapping::entry(&bench_event::host_id, "host_id"),
+    mapping::entry(&bench_event::service_id, "service_id"),
+    mapping::entry(&bench_event::state, "state"),
+    mapping::entry(&bench_event::state_type, "state_type"),
+    mapping::entry(&bench_event::current_check_attempt,
+                   "current_check_attempt"),
+    mapping::entry(&bench_event::active_checks_enabled,
+                   "active_checks_enabled"),
+    mapping::entry(&bench_event::execution_time, "execution_time"),
+    mapping::entry(&bench_event::latency, "latency"),
+    mapping::entry(&bench_event::last_check, "last_check"),
+    mapping::entry(&bench_event::next_check, "next_check"),
+    mapping::entry(&bench_event::output, "output"),
+    mapping::entry(&bench_event::perf_data, "perf_data"),
+    mapping::entry()};
+
+io::data* new_bench_event() {
+  return new bench_event;
+}
+io::event_info::event_operations const bench_event::operations = {
+    &new_bench_event};
+
+}  // namespace
+
+class IOEvents : public ::testing::Test {
+ public:
+  void SetUp() override {
+    try {
+      config::applier::init();
+    }
+    catch (std::exception const& e) {
+      (void)e;
+    }
+    io::events& e(io::events::instance());
+    _category = e.register_category("bench", 1000);
+    bench_event::type_id = e.register_event(
+        _category, 3,
+        io::event_info("bench", &bench_event::operations,
+                       bench_event::entries));
+  }
+
+  void TearDown() override {
+    io::events::instance().unregister_category(_category);
+    config::applier::deinit();
+  }
+
+ protected:
+  unsigned short _category;
+};
+
+// Given events registered in a category
+// When their information is looked up
+// Then the registered information is found, and nothing is found for
+// other elements and unknown categories.
+TEST_F(IOEvents, GetEventInfo) {
+  io::events& e(io::events::instance());
+  e.register_event(_category, 40, io::event_info("far"));
+
+  io::event_info const* info(e.get_event_info(bench_event::type_id));
+  ASSERT_NE(info, nullptr);
+  ASSERT_EQ(info->get_name(), "bench");
+  ASSERT_EQ(info->get_mapping(), bench_event::entries);
+  info = e.get_event_info(io::events::make_type(_category, 40));
+  ASSERT_NE(info, nullptr);
+  ASSERT_EQ(info->get_name(), "far");
+  ASSERT_EQ(e.get_event_info(io::events::make_type(_category, 0)), nullptr);
+  ASSERT_EQ(e.get_event_info(io::events::make_type(_category, 4)), nullptr);
+  ASSERT_EQ(e.get_event_info(io::events::make_type(_category, 41)), nullptr);
+  ASSERT_EQ(e.get_event_info(io::events::make_type(_category + 1, 3)),
+            nullptr);
+  ASSERT_EQ(e.get_event_info(io::events::make_type(60000, 3)), nullptr);
+
+  // Category 0 is not the internal one.
+  e.register_event(io::events::internal, 40, io::event_info("internal"));
+  ASSERT_NE(e.get_event_info(io::events::make_type(io::events::internal, 40)),
+            nullptr);
+  ASSERT_EQ(e.get_event_info(io::events::make_type(0, 40)), nullptr);
+  e.unregister_event(io::events::make_type(io::events::internal, 40));
+
+  e.unregister_event(io::events::make_type(_category, 40));
+  ASSERT_EQ(e.get_event_info(io::events::make_type(_category, 40)), nullptr);
+  ASSERT_NE(e.get_event_info(bench_event::type_id), nullptr);
+}
+
+// Given a registered category
+// When it is unregistered
+// Then its events are not found anymore.
+TEST_F(IOEvents, UnregisterCategory) {
+  io::events& e(io::events::instance());
+  unsigned short category(e.register_category("other", 50000));
+  uint32_t type(e.register_event(category, 1, io::event_info("other")));
+  ASSERT_NE(e.get_event_info(type), nullptr);
+  e.unregister_category(category);
+  ASSERT_EQ(e.get_event_info(type), nullptr);
+  ASSERT_NE(e.get_event_info(bench_event::type_id), nullptr);
+}
@@ -0,0 +1,213 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/io/events.hh"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "com/centreon/broker/bbdo/internal.hh"
+#include "com/centreon/broker/bbdo/stream.hh"
+#include "com/centreon/broker/io/protocols.hh"
+#include "com/centreon/broker/io/raw.hh"
+#include "com/centreon/broker/mapping/entry.hh"
+#include "com/centreon/broker/timestamp.hh"
+
+using namespace com::centreon::broker;
+
+namespace {
+// An event looking like a service status.
+class bench_event : public io::data {
+ public:
+  bench_event() : io::data(type_id) {}
+
+  uint32_t host_id = 0;
+  uint32_t service_id = 0;
+  short state = 0;
+  short state_type = 0;
+  int current_check_attempt = 0;
+  bool active_checks_enabled = false;
+  double execution_time = 0;
+  double latency = 0;
+  timestamp last_check;
+  timestamp next_check;
+  std::string output;
+  std::string perf_data;
+
+  static uint32_t type_id;
+  static mapping::entry const entries[];
+  static io::event_info::event_operations const operations;
+};
+
+uint32_t bench_event::type_id(0);
+
+mapping::entry const bench_event::entries[] = {
+    mapping::entry(&bench_event::host_id, "host_id"),
+    mapping::entry(&bench_event::service_id, "service_id"),
+    mapping::entry(&bench_event::state, "state"),
+    mapping::entry(&bench_event::state_type, "state_type"),
+    mapping::entry(&bench_event::current_check_attempt,
+                   "current_check_attempt"),
+    mapping::entry(&bench_event::active_checks_enabled,
+                   "active_checks_enabled"),
+    mapping::entry(&bench_event::execution_time, "execution_time"),
+    mapping::entry(&bench_event::latency, "latency"),
+    mapping::entry(&bench_event::last_check, "last_check"),
+    mapping::entry(&bench_event::next_check, "next_check"),
+    mapping::entry(&bench_event::output, "output"),
+    mapping::entry(&bench_event::perf_data, "perf_data"),
+    mapping::entry()};
+
+io::data* new_bench_event() {
+  return new bench_event;
+}
+io::event_info::event_operations const bench_event::operations = {
+    &new_bench_event};
+
+// Stream keeping written data in memory, read back at once.
+class memory_stream : public io::stream {
+ public:
+  bool read(std::shared_ptr<io::data>& d,
+            time_t deadline = (time_t)-1) override {
+    (void)deadline;
+    d.reset();
+    if (_memory.empty())
+      return false;
+    std::shared_ptr<io::raw> raw(new io::raw);
+    raw->get_buffer().swap(_memory);
+    d = raw;
+    return true;
+  }
+
+  int write(std::shared_ptr<io::data> const& d) override {
+    std::vector<char> const& buffer(
+        std::static_pointer_cast<io::raw>(d)->get_buffer());
+    _memory.insert(_memory.end(), buffer.begin(), buffer.end());
+    return 1;
+  }
+
+ private:
+  std::vector<char> _memory;
+};
+}  // namespace
+
+/**
+ *  Events looking like service statuses are serialized then
+ *  unserialized with BBDO. Then the cost of get_event_info() is
+ *  compared to the former two maps lookup. Throughput and lookup times
+ *  are printed.
+ *
+ *  @return EXIT_SUCCESS if events are unchanged and all found.
+ */
+int main() {
+  io::events::load();
+  io::protocols::load();
+  bbdo::load();
+  io::events& e(io::events::instance());
+  unsigned short category(e.register_category("bench", 1000));
+  bench_event::type_id = e.register_event(
+      category, 3,
+      io::event_info("bench", &bench_event::operations,
+                     bench_event::entries));
+
+  uint32_t const count(200000);
+  std::shared_ptr<memory_stream> memory(std::make_shared<memory_stream>());
+  bbdo::stream stm;
+  stm.set_substream(memory);
+  stm.set_coarse(false);
+  stm.set_negotiate(false);
+  stm.set_ack_limit(2 * count);
+  stm.negotiate(bbdo::stream::negotiate_first);
+
+  auto start(std::chrono::steady_clock::now());
+  for (uint32_t i(0); i < count; ++i) {
+    std::shared_ptr<bench_event> svc(std::make_shared<bench_event>());
+    svc->host_id = i;
+    svc->service_id = i % 100;
+    svc->state = i % 4;
+    svc->execution_time = 0.25;
+    svc->last_check = timestamp(1577880000 + i);
+    svc->output = "OK - everything is fine";
+    svc->perf_data = "time=0.25s;1;2;0;";
+    stm.write(svc);
+  }
+  auto middle(std::chrono::steady_clock::now());
+  uint32_t unchanged(0);
+  for (uint32_t i(0); i < count; ++i) {
+    std::shared_ptr<io::data> d;
+    if (!stm.read(d, 0) || !d || d->type() != bench_event::type_id)
+      break;
+    bench_event const& svc(static_cast<bench_event const&>(*d));
+    if (svc.host_id == i && svc.state == static_cast<short>(i % 4) &&
+        svc.perf_data == "time=0.25s;1;2;0;")
+      ++unchanged;
+  }
+  auto end(std::chrono::steady_clock::now());
+
+  // Lookups alone, with the registry and with maps of maps.
+  std::unordered_map<unsigned short,
+                     std::unordered_map<uint32_t, io::event_info const*>>
+      maps;
+  std::vector<uint32_t> types;
+  for (io::events::categories_container::const_iterator it(e.begin());
+       it != e.end();
+       ++it)
+    for (io::events::events_container::const_iterator ite(
+             it->second.events.begin());
+         ite != it->second.events.end();
+         ++ite) {
+      maps[it->first][ite->first] = &ite->second;
+      types.push_back(ite->first);
+    }
+  uint32_t const lookups(10000000);
+  size_t found(0);
+  auto dense_start(std::chrono::steady_clock::now());
+  for (uint32_t i(0); i < lookups; ++i)
+    found += (e.get_event_info(types[i % types.size()]) != nullptr);
+  auto maps_start(std::chrono::steady_clock::now());
+  for (uint32_t i(0); i < lookups; ++i) {
+    uint32_t type(types[i % types.size()]);
+    auto itc(maps.find(io::events::category_of_type(type)));
+    if (itc != maps.end())
+      found += (itc->second.find(type) != itc->second.end());
+  }
+  auto maps_end(std::chrono::steady_clock::now());
+
+  typedef std::chrono::duration<double> seconds;
+  typedef std::chrono::duration<double, std::nano> nanoseconds;
+  std::cout << "BBDO serialize: "
+            << count / seconds(middle - start).count() << " events/s"
+            << std::endl
+            << "BBDO unserialize: " << count / seconds(end - middle).count()
+            << " events/s" << std::endl
+            << "get_event_info: "
+            << nanoseconds(maps_start - dense_start).count() / lookups
+            << " ns, maps: "
+            << nanoseconds(maps_end - maps_start).count() / lookups << " ns"
+            << std::endl;
+
+  e.unregister_category(category);
+  bbdo::unload();
+  io::protocols::unload();
+  io::events::unload();
+  return unchanged == count && found == 2u * lookups ? EXIT_SUCCESS
+                                                     : EXIT_FAILURE;
+}
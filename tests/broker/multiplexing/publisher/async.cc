@@ -0,0 +1,147 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/io/raw.hh"
+#include "com/centreon/broker/modules/loader.hh"
+#include "com/centreon/broker/multiplexing/async_publisher.hh"
+#include "com/centreon/broker/multiplexing/engine.hh"
+#include "com/centreon/broker/multiplexing/muxer.hh"
+#include "com/centreon/broker/multiplexing/subscriber.hh"
+#include "com/centreon/broker/neb/instance.hh"
+
+using namespace com::centreon::broker;
+
+class AsyncPublisher : public testing::Test {
+ public:
+  void SetUp() override {
+    try {
+      config::applier::init();
+    } catch (std::exception const& e) {
+      (void)e;
+    }
+    _loader.load_file("./lib/10-neb.so");
+  }
+
+  void TearDown() override {
+    _loader.unload();
+    config::applier::deinit();
+  }
+
+  /**
+   *  Read every event available in a subscriber.
+   */
+  static std::vector<std::shared_ptr<io::data>> read_all(
+      multiplexing::subscriber& s) {
+    std::vector<std::shared_ptr<io::data>> retval;
+    std::shared_ptr<io::data> d;
+    while (s.get_muxer().read(d, 0) && d)
+      retval.push_back(d);
+    return retval;
+  }
+
+ private:
+  modules::loader _loader;
+};
+
+// Given an asynchronous publisher with a small queue blocking on overflow
+// When many events are written
+// Then all of them are published in order
+TEST_F(AsyncPublisher, Block) {
+  multiplexing::subscriber s("core_multiplexing_async_publisher_block", "");
+  s.get_muxer().set_read_filters({io::raw::static_type()});
+  s.get_muxer().set_write_filters({io::raw::static_type()});
+  multiplexing::engine::instance().start();
+
+  int const count = 10000;
+  multiplexing::async_publisher p;
+  p.start(8, multiplexing::async_publisher::overflow_block, "");
+  ASSERT_TRUE(p.running());
+  for (int i = 0; i < count; ++i) {
+    std::shared_ptr<io::raw> raw(new io::raw);
+    raw->append(std::to_string(i));
+    p.write(raw);
+  }
+  p.stop();
+  ASSERT_FALSE(p.running());
+
+  auto events{read_all(s)};
+  ASSERT_EQ(events.size(), static_cast<size_t>(count));
+  for (int i = 0; i < count; ++i) {
+    io::raw const& raw(*std::static_pointer_cast<io::raw>(events[i]));
+    ASSERT_EQ(std::string(raw.const_data(), raw.size()), std::to_string(i));
+  }
+
+  multiplexing::async_publisher::stats st{p.get_stats()};
+  ASSERT_EQ(st.published, static_cast<uint64_t>(count));
+  ASSERT_EQ(st.queued, 0u);
+  ASSERT_EQ(st.spilled, 0u);
+  ASSERT_GE(st.max_latency, st.average_latency);
+}
+
+// Given an asynchronous publisher with a small queue spilling on overflow
+// When many events are written
+// Then all of them are published in order, spilled ones included
+TEST_F(AsyncPublisher, Spill) {
+  multiplexing::subscriber s("core_multiplexing_async_publisher_spill", "");
+  s.get_muxer().set_read_filters({neb::instance::static_type()});
+  s.get_muxer().set_write_filters({neb::instance::static_type()});
+  multiplexing::engine::instance().start();
+
+  int const count = 20000;
+  multiplexing::async_publisher p;
+  p.start(4, multiplexing::async_publisher::overflow_spill,
+          "/tmp/async_publisher_spill");
+  for (int i = 0; i < count; ++i) {
+    std::shared_ptr<neb::instance> inst(new neb::instance);
+    inst->poller_id = i;
+    p.write(inst);
+  }
+  p.stop();
+
+  auto events{read_all(s)};
+  ASSERT_EQ(events.size(), static_cast<size_t>(count));
+  for (int i = 0; i < count; ++i)
+    ASSERT_EQ(std::static_pointer_cast<neb::instance>(events[i])->poller_id,
+              static_cast<uint32_t>(i));
+  ASSERT_EQ(p.get_stats().published, static_cast<uint64_t>(count));
+}
+
+// Given a started asynchronous publisher
+// When events are written from another thread
+// Then they are published too
+TEST_F(AsyncPublisher, OtherThread) {
+  multiplexing::subscriber s("core_multiplexing_async_publisher_thread", "");
+  s.get_muxer().set_read_filters({io::raw::static_type()});
+  s.get_muxer().set_write_filters({io::raw::static_type()});
+  multiplexing::engine::instance().start();
+
+  multiplexing::async_publisher p;
+  p.start(8, multiplexing::async_publisher::overflow_block, "");
+  std::thread t([&p] {
+    for (int i = 0; i < 100; ++i)
+      p.write(std::make_shared<io::raw>());
+  });
+  t.join();
+  p.stop();
+
+  ASSERT_EQ(read_all(s).size(), 100u);
+}
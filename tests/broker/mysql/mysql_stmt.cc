@@ -0,0 +1,101 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/database/mysql_stmt.hh"
+#include <gtest/gtest.h>
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/modules/loader.hh"
+#include "com/centreon/broker/neb/instance.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::database;
+
+class MysqlStmt : public ::testing::Test {
+ public:
+  void SetUp() override {
+    try {
+      config::applier::init();
+    } catch (std::exception const& e) {
+      (void)e;
+    }
+    _loader.load_file("./lib/10-neb.so");
+  }
+
+  void TearDown() override {
+    _loader.unload();
+    config::applier::deinit();
+  }
+
+ private:
+  modules::loader _loader;
+};
+
+// Given a statement with named parameters, one of them used twice
+// When an event is bound to it
+// Then each field goes to its indexes, NULL values following the mapping
+TEST_F(MysqlStmt, BindEvent) {
+  mysql_stmt stmt(
+      "INSERT INTO instances (instance_id,name,running,end_time,version) "
+      "VALUES (:instance_id,:name,:running,:end_time,:version) ON DUPLICATE "
+      "KEY UPDATE name=:name",
+      true);
+  ASSERT_EQ(stmt.get_param_count(), 6);
+
+  neb::instance inst;
+  inst.poller_id = 0;
+  inst.name = "Central";
+  inst.is_running = true;
+  inst.program_end = -1;
+  inst.version = "";
+  stmt << inst;
+
+  std::unique_ptr<mysql_bind> bind(stmt.get_bind());
+  ASSERT_TRUE(bind);
+  // Zero is kept for unsigned integers.
+  ASSERT_FALSE(bind->value_is_null(0));
+  ASSERT_EQ(bind->value_as_u32(0), 0u);
+  ASSERT_EQ(std::string(bind->value_as_str(1)), "Central");
+  ASSERT_TRUE(bind->value_as_bool(2));
+  ASSERT_TRUE(bind->value_is_null(3));
+  ASSERT_FALSE(bind->value_is_null(4));
+  ASSERT_EQ(std::string(bind->value_as_str(5)), "Central");
+
+  // The same plan is used for the next event.
+  inst.poller_id = 3;
+  inst.name = "Poller";
+  inst.program_end = 1600000000;
+  stmt << inst;
+  bind = stmt.get_bind();
+  ASSERT_EQ(bind->value_as_u32(0), 3u);
+  ASSERT_EQ(std::string(bind->value_as_str(1)), "Poller");
+  ASSERT_FALSE(bind->value_is_null(3));
+  ASSERT_EQ(bind->value_as_u32(3), 1600000000u);
+  ASSERT_EQ(std::string(bind->value_as_str(5)), "Poller");
+}
+
+// Given a statement
+// When an event of an unknown type is bound
+// Then an exception is thrown
+TEST_F(MysqlStmt, UnknownEvent) {
+  mysql_stmt stmt("DELETE FROM instances WHERE instance_id=:instance_id",
+                  true);
+  ASSERT_THROW(stmt.compile_bind_plan(0xffffffff), msg_fmt);
+}
@@ -0,0 +1,165 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/processing/executor.hh"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::processing;
+
+class ProcessingExecutor : public ::testing::Test {
+ public:
+  void SetUp() override { executor::load(4); }
+
+  void TearDown() override { executor::unload(); }
+};
+
+// Given many tasks notified by several threads
+// When they run on the executor
+// Then a task never runs on two threads at once, it runs at least once
+// and not more than it is notified.
+TEST_F(ProcessingExecutor, NotifiedTasks) {
+  struct counter {
+    std::atomic_bool running{false};
+    std::atomic<uint32_t> runs{0};
+    std::atomic<uint32_t> notifications{0};
+    bool overlapped{false};
+  };
+  std::vector<counter> counters(100);
+  std::vector<std::shared_ptr<executor::task>> tasks;
+  for (counter& c : counters)
+    tasks.push_back(executor::instance().add([&c]() {
+      if (c.running.exchange(true))
+        c.overlapped = true;
+      ++c.runs;
+      c.running = false;
+      return 60000;
+    }));
+
+  std::vector<std::thread> notifiers;
+  for (int i(0); i < 4; ++i)
+    notifiers.emplace_back([&]() {
+      for (int j(0); j < 1000; ++j)
+        for (size_t k(0); k < tasks.size(); ++k) {
+          ++counters[k].notifications;
+          tasks[k]->notify();
+        }
+    });
+  for (std::thread& t : notifiers)
+    t.join();
+
+  // Wait for the last runs.
+  for (int i(0); i < 100; ++i) {
+    bool idle(true);
+    for (counter const& c : counters)
+      idle = idle && !c.running;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (idle)
+      break;
+  }
+  for (size_t k(0); k < tasks.size(); ++k) {
+    executor::instance().remove(tasks[k]);
+    ASSERT_FALSE(counters[k].overlapped);
+    ASSERT_GE(counters[k].runs, 1u);
+    ASSERT_LE(counters[k].runs, counters[k].notifications);
+  }
+}
+
+// Given a task running a slice
+// When it is notified during this slice
+// Then it runs once more after the slice.
+TEST_F(ProcessingExecutor, NotifiedWhileRunning) {
+  std::mutex m;
+  std::condition_variable cv;
+  bool started(false);
+  bool released(false);
+  std::atomic<uint32_t> runs(0);
+  std::shared_ptr<executor::task> t(executor::instance().add([&]() {
+    if (++runs == 1) {
+      std::unique_lock<std::mutex> lock(m);
+      started = true;
+      cv.notify_all();
+      cv.wait(lock, [&released]() { return released; });
+    }
+    return 60000;
+  }));
+  t->notify();
+  {
+    std::unique_lock<std::mutex> lock(m);
+    cv.wait(lock, [&started]() { return started; });
+  }
+  t->notify();
+  {
+    std::lock_guard<std::mutex> lock(m);
+    released = true;
+    cv.notify_all();
+  }
+
+  auto start(std::chrono::steady_clock::now());
+  while (runs < 2 &&
+         std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_EQ(runs, 2u);
+  executor::instance().remove(t);
+}
+
+// Given a task asking to run again after a delay
+// When it is not notified
+// Then it runs again after the delay.
+TEST_F(ProcessingExecutor, Timer) {
+  std::atomic<uint32_t> runs(0);
+  std::shared_ptr<executor::task> t(
+      executor::instance().add([&runs]() { return ++runs < 3 ? 50 : -1; }));
+  auto start(std::chrono::steady_clock::now());
+  t->notify();
+  while (runs < 3 &&
+         std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  ASSERT_EQ(runs, 3u);
+  ASSERT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(100));
+  executor::instance().remove(t);
+}
+
+// Given a task always ready
+// When it is removed
+// Then it does not run anymore once remove() returns.
+TEST_F(ProcessingExecutor, Remove) {
+  std::atomic<uint32_t> runs(0);
+  std::shared_ptr<executor::task> t(executor::instance().add([&runs]() {
+    ++runs;
+    return 0;
+  }));
+  t->notify();
+  while (runs < 100)
+    std::this_thread::yield();
+  executor::instance().remove(t);
+  uint32_t last(runs);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  t->notify();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_EQ(runs, last);
+}
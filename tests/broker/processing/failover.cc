@@ -0,0 +1,209 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/broker/processing/failover.hh"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "com/centreon/broker/config/applier/state.hh"
+#include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/multiplexing/engine.hh"
+#include "com/centreon/broker/multiplexing/subscriber.hh"
+#include "com/centreon/broker/processing/executor.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::exceptions;
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::processing;
+
+class FailoverStream : public io::stream {
+ public:
+  bool read(std::shared_ptr<io::data>& d, time_t deadline) override {
+    (void)deadline;
+    d.reset();
+    return false;
+  }
+
+  int write(std::shared_ptr<io::data> const& d) override {
+    (void)d;
+    return 1;
+  }
+};
+
+/**
+ *  Endpoint whose open() can fail a number of times or block until it
+ *  is released.
+ */
+class FailoverEndpoint : public io::endpoint {
+ public:
+  FailoverEndpoint()
+      : io::endpoint(false), _blocked(false), _failures(0), _opened(0) {}
+
+  std::shared_ptr<io::stream> open() override {
+    std::unique_lock<std::mutex> lock(_m);
+    ++_opened;
+    _cv.notify_all();
+    _cv.wait(lock, [this] { return !_blocked; });
+    if (_failures > 0) {
+      --_failures;
+      throw msg_fmt("failover test: could not open endpoint");
+    }
+    return std::make_shared<FailoverStream>();
+  }
+
+  void block(bool blocked) {
+    std::lock_guard<std::mutex> lock(_m);
+    _blocked = blocked;
+    _cv.notify_all();
+  }
+
+  void fail(int failures) {
+    std::lock_guard<std::mutex> lock(_m);
+    _failures = failures;
+  }
+
+  /**
+   *  Wait for open() to be called a number of times.
+   *
+   *  @param[in] count  Number of calls to wait for.
+   *
+   *  @return True if open() was called count times before the timeout.
+   */
+  bool wait_opened(int count) {
+    std::unique_lock<std::mutex> lock(_m);
+    return _cv.wait_for(lock, std::chrono::seconds(5),
+                        [this, count] { return _opened >= count; });
+  }
+
+ private:
+  bool _blocked;
+  int _failures;
+  int _opened;
+  std::condition_variable _cv;
+  std::mutex _m;
+};
+
+class TestFailover : public ::testing::Test {
+ public:
+  void SetUp() override {
+    config::applier::state::load();
+    multiplexing::engine::load();
+    io::events::load();
+    executor::load();
+
+    _endpoint = std::make_shared<FailoverEndpoint>();
+    _failover = _make_failover("test-failover", _endpoint);
+    _failover->set_retry_interval(1);
+  }
+
+  void TearDown() override {
+    _endpoint->block(false);
+    _failover.reset();
+    executor::unload();
+    io::events::unload();
+    multiplexing::engine::unload();
+    config::applier::state::unload();
+  }
+
+ protected:
+  static std::shared_ptr<failover> _make_failover(
+      std::string const& name,
+      std::shared_ptr<FailoverEndpoint> const& endp) {
+    return std::make_shared<failover>(
+        endp, std::make_shared<multiplexing::subscriber>(name), name);
+  }
+
+  /**
+   *  Poll the running state of a failover.
+   *
+   *  @param[in] fo       The failover.
+   *  @param[in] running  Expected state.
+   *
+   *  @return True if the state was reached before the timeout.
+   */
+  static bool _wait_running(failover const& fo, bool running) {
+    for (int i(0); i < 500; ++i) {
+      if (fo.is_running() == running)
+        return true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+  }
+
+  std::shared_ptr<FailoverEndpoint> _endpoint;
+  std::shared_ptr<failover> _failover;
+};
+
+// Given a failover whose endpoint cannot be opened once
+// When it is started
+// Then it opens the endpoint again after the retry interval
+TEST_F(TestFailover, ReconnectAfterOpenError) {
+  _endpoint->fail(1);
+  _failover->start();
+  ASSERT_TRUE(_endpoint->wait_opened(1));
+  ASSERT_TRUE(_endpoint->wait_opened(2));
+  ASSERT_TRUE(_failover->is_running());
+  _failover->exit();
+  ASSERT_FALSE(_failover->is_running());
+}
+
+// Given a failover with a secondary failover
+// When its endpoint cannot be opened once
+// Then the secondary failover is started and it is stopped once the
+// endpoint is opened
+TEST_F(TestFailover, LaunchAndStopSecondary) {
+  std::shared_ptr<FailoverEndpoint> endp(
+      std::make_shared<FailoverEndpoint>());
+  std::shared_ptr<failover> fo(_make_failover("test-failover-2", endp));
+  _failover->set_failover(fo);
+  _endpoint->block(true);
+  _endpoint->fail(1);
+  _failover->start();
+  ASSERT_TRUE(_endpoint->wait_opened(1));
+  ASSERT_FALSE(fo->is_running());
+
+  _endpoint->block(false);
+  ASSERT_TRUE(endp->wait_opened(1));
+  ASSERT_TRUE(_endpoint->wait_opened(2));
+  ASSERT_TRUE(_wait_running(*fo, false));
+  _failover->exit();
+}
+
+// Given a failover whose endpoint blocks in open()
+// When it exits
+// Then exit() returns once the open job is done
+TEST_F(TestFailover, ExitWhileOpening) {
+  _endpoint->block(true);
+  _failover->start();
+  ASSERT_TRUE(_endpoint->wait_opened(1));
+
+  std::future<void> exited(
+      std::async(std::launch::async, [this] { _failover->exit(); }));
+  ASSERT_EQ(exited.wait_for(std::chrono::milliseconds(200)),
+            std::future_status::timeout);
+  _endpoint->block(false);
+  ASSERT_EQ(exited.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  ASSERT_FALSE(_failover->is_running());
+}
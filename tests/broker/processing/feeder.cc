@@ -25,6 +25,7 @@
 #include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/multiplexing/engine.hh"
 #include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/processing/executor.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::processing;
@@ -46,6 +47,7 @@ class TestFeeder : public ::testing::Test {
     config::applier::state::load();
     multiplexing::engine::load();
     io::events::load();
+    executor::load();
 
     std::shared_ptr<io::stream> client = std::make_shared<TestStream>();
     std::unordered_set<uint32_t> read_filters;
@@ -56,6 +58,7 @@ class TestFeeder : public ::testing::Test {
 
   void TearDown() override {
     _feeder.reset(nullptr);
+    executor::unload();
     io::events::unload();
     multiplexing::engine::unload();
     config::applier::state::unload();
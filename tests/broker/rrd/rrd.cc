@@ -18,12 +18,17 @@
  */
 
 #include <gtest/gtest.h>
+#include <rrd.h>
 #include <unistd.h>
 #include <cstdlib>
 #include <ctime>
 #include <memory>
+#include <string>
+#include <vector>
 #include "com/centreon/broker/config/applier/init.hh"
 #include "com/centreon/broker/rrd/lib.hh"
+#include "com/centreon/broker/rrd/output.hh"
+#include "com/centreon/broker/storage/rebuild_data.hh"
 
 using namespace com::centreon::broker;
 
@@ -131,4 +136,105 @@ TEST_F(Rrd, UpdateNOK) {
   ::remove(file_path.c_str());
 
   ASSERT_TRUE(file_exists);
-}
\ No newline at end of file
+}
+
+TEST_F(Rrd, UpdateMany) {
+  // Temporary file path.
+  std::string file_path("/tmp/broker_rrd_lib_update_many");
+  ::remove(file_path.c_str());
+
+  // RRD library object. Records are aligned on the step so that each one
+  // holds exactly one value.
+  rrd::lib lib("/tmp", 16);
+  time_t now{std::time(nullptr)};
+  time_t from{(now - 7 * 24 * 60 * 60) / 60 * 60};
+  lib.open(file_path, 90 * 24 * 60 * 60, from, 60);
+
+  std::vector<std::string> pts;
+  for (time_t t(from + 60); t <= now; t += 60)
+    pts.push_back(std::to_string(t) + ":" + std::to_string(t % 100));
+  lib.update(pts);
+  lib.update(std::vector<std::string>());
+
+  // Fetch values back.
+  time_t start(from);
+  time_t end(from + 60 * pts.size());
+  unsigned long step(60);
+  unsigned long ds_count(0);
+  char** ds_names(nullptr);
+  rrd_value_t* data(nullptr);
+  rrd_clear_error();
+  int ret(rrd_fetch_r(file_path.c_str(), "AVERAGE", &start, &end, &step,
+                      &ds_count, &ds_names, &data));
+
+  // Remove temporary file.
+  ::remove(file_path.c_str());
+
+  ASSERT_EQ(ret, 0) << rrd_get_error();
+  ASSERT_EQ(step, 60u);
+  ASSERT_EQ(ds_count, 1u);
+  // The first row holds the record ending at start + step.
+  size_t checked(0);
+  for (time_t t(from + 60); t <= end && t <= from + 60 * pts.size();
+       t += 60) {
+    ASSERT_DOUBLE_EQ(data[(t - start) / step - 1], t % 100) << "at " << t;
+    ++checked;
+  }
+  ASSERT_EQ(checked, pts.size());
+
+  for (unsigned long i(0); i < ds_count; ++i)
+    free(ds_names[i]);
+  free(ds_names);
+  free(data);
+}
+
+TEST_F(Rrd, RebuildDuplicateTimes) {
+  // Given a rebuild of metric 1 whose values repeat some times
+  std::string file_path("/tmp/broker_rrd_rebuild_1.rrd");
+  ::remove(file_path.c_str());
+  time_t now{std::time(nullptr)};
+  time_t from{(now - 24 * 60 * 60) / 60 * 60};
+  std::shared_ptr<storage::rebuild_data> data{
+      std::make_shared<storage::rebuild_data>(1, false, 60,
+                                              90 * 24 * 60 * 60, 0)};
+  size_t count(0);
+  for (time_t t(from + 60); t <= now; t += 60, ++count) {
+    data->add_value(t, t % 100);
+    if (count % 10 == 0)
+      data->add_value(t, 1000);
+  }
+
+  // When the rrd output writes it
+  {
+    rrd::output out("/tmp/broker_rrd_rebuild_", "/tmp/broker_rrd_rebuild_s_",
+                    16, false, true, false);
+    out.write(data);
+  }
+
+  // Then every first value of a time is in the file
+  time_t start(from);
+  time_t end(from + 60 * count);
+  unsigned long step(60);
+  unsigned long ds_count(0);
+  char** ds_names(nullptr);
+  rrd_value_t* values(nullptr);
+  rrd_clear_error();
+  int ret(rrd_fetch_r(file_path.c_str(), "AVERAGE", &start, &end, &step,
+                      &ds_count, &ds_names, &values));
+  ::remove(file_path.c_str());
+
+  ASSERT_EQ(ret, 0) << rrd_get_error();
+  ASSERT_EQ(step, 60u);
+  ASSERT_EQ(ds_count, 1u);
+  size_t checked(0);
+  for (time_t t(from + 60); t <= end && t <= from + 60 * count; t += 60) {
+    ASSERT_DOUBLE_EQ(values[(t - start) / step - 1], t % 100) << "at " << t;
+    ++checked;
+  }
+  ASSERT_EQ(checked, count);
+
+  for (unsigned long i(0); i < ds_count; ++i)
+    free(ds_names[i]);
+  free(ds_names);
+  free(values);
+}
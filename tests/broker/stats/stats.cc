@@ -38,6 +38,7 @@
 #include "com/centreon/broker/misc/misc.hh"
 #include "com/centreon/broker/misc/string.hh"
 #include "com/centreon/broker/multiplexing/engine.hh"
+#include "com/centreon/broker/processing/executor.hh"
 #include "com/centreon/broker/stats/builder.hh"
 
 using namespace com::centreon::exceptions;
@@ -52,10 +53,12 @@ class StatsTest : public ::testing::Test {
     config::applier::endpoint::load();
     io::events::load();
     io::protocols::load();
+    processing::executor::load();
   }
 
   void TearDown() override {
     config::applier::endpoint::unload();
+    processing::executor::unload();
     config::applier::modules::unload();
     config::applier::state::load();
     io::protocols::unload();
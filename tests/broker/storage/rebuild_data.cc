@@ -0,0 +1,100 @@
+/*
+** Copyright 2020 Centreon
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+**
+** For more information : contact@centreon.com
+*/
+
+#include "com/centreon/broker/storage/rebuild_data.hh"
+#include <gtest/gtest.h>
+#include <cmath>
+#include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/storage/internal.hh"
+
+using namespace com::centreon::broker;
+
+/**
+ *  Check that rebuild_data copy constructor works properly.
+ */
+TEST(StorageRebuildData, CopyCtor) {
+  // Base object.
+  storage::rebuild_data r1(42, false, 300, 3600, 1);
+  r1.add_value(1000, 1.5);
+
+  // Copy object.
+  storage::rebuild_data r2(r1);
+
+  // Reset base object.
+  r1.id = 36;
+  r1.values.clear();
+
+  // Check.
+  ASSERT_EQ(r2.id, 42u);
+  ASSERT_FALSE(r2.is_index);
+  ASSERT_EQ(r2.interval, 300u);
+  ASSERT_EQ(r2.rrd_len, 3600u);
+  ASSERT_EQ(r2.value_type, 1);
+  ASSERT_EQ(r2.values, "1000:1.5 ");
+}
+
+/**
+ *  Check that the rebuild_data object properly default constructs.
+ */
+TEST(StorageRebuildData, DefaultCtor) {
+  storage::rebuild_data r;
+
+  size_t pos(0);
+  time_t ctime;
+  double value;
+  ASSERT_EQ(r.id, 0u);
+  ASSERT_FALSE(r.is_index);
+  ASSERT_TRUE(r.values.empty());
+  ASSERT_FALSE(r.next_value(pos, ctime, value));
+}
+
+/**
+ *  Check that the rebuild_data object properly return is type
+ */
+TEST(StorageRebuildData, ReturnType) {
+  storage::rebuild_data r;
+  auto val = io::events::data_type<io::events::storage,
+                                   storage::de_rebuild_data>::value;
+
+  ASSERT_TRUE(r.static_type() == val);
+  ASSERT_TRUE(r.type() == val);
+}
+
+/**
+ *  Check that values are read back in order and without precision loss.
+ */
+TEST(StorageRebuildData, Values) {
+  storage::rebuild_data r(42, false, 300, 3600, 0);
+  double const values[] = {0.1, -3.25e-12, 1e300, INFINITY, -INFINITY, 42};
+  for (int i(0); i < 6; ++i)
+    r.add_value(1000 + 300 * i, values[i]);
+  r.add_value(3000, NAN);
+
+  size_t pos(0);
+  time_t ctime;
+  double value;
+  for (int i(0); i < 6; ++i) {
+    ASSERT_TRUE(r.next_value(pos, ctime, value));
+    ASSERT_EQ(ctime, 1000 + 300 * i);
+    ASSERT_EQ(value, values[i]);
+  }
+  ASSERT_TRUE(r.next_value(pos, ctime, value));
+  ASSERT_EQ(ctime, 3000);
+  ASSERT_TRUE(std::isnan(value));
+  ASSERT_FALSE(r.next_value(pos, ctime, value));
+}
@@ -48,14 +48,14 @@ test_server::test_server()
        "application/json\\r\\n'",
        "HTTP/1.1 200 OK"});
   _answer_reply.insert(
-      {"POST /write?u=centreon&p=pass&db=centreon&precision=s HTTP/1.0",
-       "HTTP/1.0 204 No Content\n"});
+      {"POST /write?u=centreon&p=pass&db=centreon&precision=s HTTP/1.1",
+       "HTTP/1.1 204 No Content\r\n\r\n"});
   _answer_reply.insert(
-      {"POST /write?u=centreon&p=fail1&db=centreon&precision=s HTTP/1.0",
-       "HTTP/1.1 204 OK\n"});
+      {"POST /write?u=centreon&p=fail1&db=centreon&precision=s HTTP/1.1",
+       "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\n\r\n"});
   _answer_reply.insert(
-      {"POST /write?u=centreon&p=fail2&db=centreon&precision=s HTTP/1.0",
-       "HTTP/1.1 200\n"});
+      {"POST /write?u=centreon&p=fail2&db=centreon&precision=s HTTP/1.1",
+       "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n"});
 }
 
 void test_server::init() {
@@ -18,6 +18,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <unistd.h>
 #include "com/centreon/connector/perl/embedded_perl.hh"
 
 #include "com/centreon/io/file_stream.hh"
@@ -109,3 +110,91 @@ TEST(EmbeddedPerl, RunSimple2) {
     remove(script_path.c_str());
   });
 }
+
+TEST(EmbeddedPerl, ExecuteCaptured) {
+  // Write simple Perl script.
+  std::string script_path(com::centreon::io::file_stream::temp_path());
+  ASSERT_NO_THROW({
+    com::centreon::io::file_stream fs;
+    fs.open(script_path.c_str(), "w");
+    char const* data(
+        "print \"OK - $ARGV[-1]\\n\";\n"
+        "print STDERR \"warning\\n\";\n"
+        "exit 2;\n");
+    unsigned int size(strlen(data));
+    unsigned int rb(1);
+    do {
+      rb = fs.write(data, size);
+      size -= rb;
+      data += rb;
+    } while ((rb > 0) && (size > 0));
+  });
+
+  // Execute script twice within this process.
+  for (int i = 0; i < 2; ++i) {
+    std::string output;
+    std::string error;
+    ASSERT_EQ(embedded_perl::instance().execute(script_path + " arg", output,
+                                                error),
+              2);
+    ASSERT_EQ(output, "OK - arg\n");
+    ASSERT_EQ(error, "warning\n");
+  }
+
+  // Remove temporary file.
+  remove(script_path.c_str());
+}
+
+TEST(EmbeddedPerl, ExecuteIsolated) {
+  // Write Perl scripts, the first one leaves a signal handler and an
+  // alarm behind and runs a child process.
+  std::string first_path(com::centreon::io::file_stream::temp_path());
+  std::string second_path(com::centreon::io::file_stream::temp_path());
+  ASSERT_NO_THROW({
+    com::centreon::io::file_stream fs;
+    fs.open(first_path.c_str(), "w");
+    char const* data(
+        "$SIG{ALRM} = sub { exit 1; };\n"
+        "alarm(30);\n"
+        "print \"parent\\n\";\n"
+        "system(\"echo child; echo child error 1>&2\");\n"
+        "exit 0;\n");
+    unsigned int size(strlen(data));
+    unsigned int rb(1);
+    do {
+      rb = fs.write(data, size);
+      size -= rb;
+      data += rb;
+    } while ((rb > 0) && (size > 0));
+  });
+  ASSERT_NO_THROW({
+    com::centreon::io::file_stream fs;
+    fs.open(second_path.c_str(), "w");
+    char const* data(
+        "print defined($SIG{ALRM}) ? \"set\\n\" : \"unset\\n\";\n"
+        "exit 0;\n");
+    unsigned int size(strlen(data));
+    unsigned int rb(1);
+    do {
+      rb = fs.write(data, size);
+      size -= rb;
+      data += rb;
+    } while ((rb > 0) && (size > 0));
+  });
+
+  // Outputs of the child are captured.
+  std::string output;
+  std::string error;
+  ASSERT_EQ(embedded_perl::instance().execute(first_path, output, error), 0);
+  ASSERT_EQ(output, "parent\nchild\n");
+  ASSERT_EQ(error, "child error\n");
+
+  // Neither the alarm nor the handler survived the script.
+  ASSERT_EQ(alarm(0), 0u);
+  ASSERT_EQ(embedded_perl::instance().execute(second_path, output, error), 0);
+  ASSERT_EQ(output, "unset\n");
+
+  // Remove temporary files.
+  remove(first_path.c_str());
+  remove(second_path.c_str());
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "com/centreon/connector/ssh/worker.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::connector::ssh;
+
+/**
+ *  Collect check results sent by workers.
+ */
+class result_collector : public checks::listener {
+ public:
+  void on_result(checks::result const& r) override {
+    std::lock_guard<std::mutex> lock(_m);
+    _results[r.get_command_id()] = r;
+    _cv.notify_all();
+  }
+
+  bool wait(size_t count, int seconds) {
+    std::unique_lock<std::mutex> lock(_m);
+    return _cv.wait_for(lock, std::chrono::seconds(seconds),
+                        [this, count] { return _results.size() >= count; });
+  }
+
+  std::map<uint64_t, checks::result> results() {
+    std::lock_guard<std::mutex> lock(_m);
+    return _results;
+  }
+
+ private:
+  std::condition_variable _cv;
+  std::mutex _m;
+  std::map<uint64_t, checks::result> _results;
+};
+
+// Given a worker
+// When checks are run on a host that refuses connections
+// Then each check gets a result telling it was not executed
+TEST(SSHWorker, UnreachableHost) {
+  result_collector collector;
+  worker w(collector, 2, 2);
+  w.start();
+
+  sessions::credentials creds;
+  creds.set_host("127.0.0.1");
+  creds.set_port(1);
+  creds.set_user("centreon");
+  creds.set_password("centreon");
+  for (uint64_t i = 1; i <= 10; ++i)
+    w.execute(i, timestamp(time(nullptr) + 10), creds, {"true"}, -1, -1,
+              false);
+
+  ASSERT_TRUE(collector.wait(10, 20));
+  w.stop();
+  auto results(collector.results());
+  ASSERT_EQ(results.size(), 10u);
+  for (auto const& r : results)
+    ASSERT_FALSE(r.second.get_executed());
+}
+
+// Given workers with several sessions per host
+// When many checks are run concurrently on a local sshd
+// Then all of them are executed with their own output
+//
+// This test needs a sshd accepting the credentials given by the
+// SSH_TEST_USER and SSH_TEST_PASSWORD (or SSH_TEST_KEY) environment
+// variables, on SSH_TEST_HOST (default: 127.0.0.1).
+TEST(SSHWorker, Stress) {
+  char const* user(getenv("SSH_TEST_USER"));
+  if (!user)
+    GTEST_SKIP() << "SSH_TEST_USER is not set, no local sshd to stress";
+  char const* host(getenv("SSH_TEST_HOST"));
+  char const* password(getenv("SSH_TEST_PASSWORD"));
+  char const* key(getenv("SSH_TEST_KEY"));
+
+  sessions::credentials creds;
+  creds.set_host(host ? host : "127.0.0.1");
+  creds.set_port(22);
+  creds.set_user(user);
+  creds.set_password(password ? password : "");
+  creds.set_key(key ? key : "");
+
+  result_collector collector;
+  std::vector<std::unique_ptr<worker> > workers;
+  for (int i = 0; i < 4; ++i) {
+    workers.emplace_back(new worker(collector, 4, 5));
+    workers.back()->start();
+  }
+
+  uint64_t const count(400);
+  for (uint64_t i = 1; i <= count; ++i)
+    workers[i % workers.size()]->execute(
+        i, timestamp(time(nullptr) + 60), creds,
+        {"echo " + std::to_string(i)}, -1, -1, false);
+
+  ASSERT_TRUE(collector.wait(count, 120));
+  workers.clear();
+  auto results(collector.results());
+  ASSERT_EQ(results.size(), count);
+  for (auto const& r : results) {
+    ASSERT_TRUE(r.second.get_executed());
+    ASSERT_EQ(r.second.get_exit_code(), 0);
+    ASSERT_EQ(r.second.get_output(), std::to_string(r.first) + "\n");
+  }
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <csignal>
+#include <cstring>
+#include <list>
+#include <map>
+#include <string>
+
+#include "com/centreon/connector/perl/multiplexer.hh"
+#include "com/centreon/connector/perl/worker_pool.hh"
+#include "com/centreon/io/file_stream.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::connector::perl;
+
+class WorkerPool : public ::testing::Test {
+ public:
+  void SetUp() override {
+    multiplexer::load();
+    _pid_script = _write_script("print readlink('/proc/self');\nexit 0;\n");
+    _echo_script = _write_script("print \"OK - $ARGV[-1]\";\nexit 1;\n");
+    _sleep_script = _write_script("sleep(30);\nexit 0;\n");
+  }
+
+  void TearDown() override {
+    worker_pool::unload();
+    multiplexer::unload();
+    remove(_pid_script.c_str());
+    remove(_echo_script.c_str());
+    remove(_sleep_script.c_str());
+  }
+
+ protected:
+  /**
+   *  Multiplex until the given number of checks are completed.
+   *
+   *  @param[in] count  Number of completions to wait for.
+   *
+   *  @return Completions by check ID.
+   */
+  static std::map<pid_t, worker_pool::completion> _wait_completions(
+      size_t count) {
+    std::map<pid_t, worker_pool::completion> retval;
+    for (;;) {
+      for (worker_pool::completion& c : worker_pool::instance().completions())
+        retval[c.id] = std::move(c);
+      if (retval.size() >= count)
+        return retval;
+      multiplexer::instance().multiplex();
+    }
+  }
+
+  /**
+   *  Wait for workers to exit, as the connector does on SIGCHLD, until
+   *  a check is completed.
+   *
+   *  @return Completions.
+   */
+  static std::list<worker_pool::completion> _wait_exit() {
+    std::list<worker_pool::completion> retval;
+    while (retval.empty()) {
+      pid_t pid(waitpid(-1, nullptr, 0));
+      if (pid <= 0)
+        break;
+      worker_pool::instance().on_exit(pid);
+      retval = worker_pool::instance().completions();
+    }
+    return retval;
+  }
+
+  /**
+   *  Run the script printing the PID of the worker.
+   *
+   *  @return The worker PID.
+   */
+  pid_t _worker_pid() {
+    pid_t id(worker_pool::instance().run(_pid_script));
+    std::map<pid_t, worker_pool::completion> done(_wait_completions(1));
+    return std::stoi(done[id].output);
+  }
+
+  static std::string _write_script(char const* data) {
+    std::string path(io::file_stream::temp_path());
+    io::file_stream fs;
+    fs.open(path.c_str(), "w");
+    unsigned int size(strlen(data));
+    unsigned int rb(1);
+    do {
+      rb = fs.write(data, size);
+      size -= rb;
+      data += rb;
+    } while ((rb > 0) && (size > 0));
+    return path;
+  }
+
+  std::string _pid_script;
+  std::string _echo_script;
+  std::string _sleep_script;
+};
+
+// Given a pool of two workers
+// When three checks are run
+// Then the third one waits for a worker and all of them complete
+TEST_F(WorkerPool, Dispatch) {
+  worker_pool::load(2, 100, 0);
+  std::map<pid_t, std::string> expected;
+  for (int i(0); i < 3; ++i) {
+    std::string arg(std::to_string(i));
+    expected[worker_pool::instance().run(_echo_script + " " + arg)] =
+        "OK - " + arg;
+  }
+
+  std::map<pid_t, worker_pool::completion> done(_wait_completions(3));
+  ASSERT_EQ(done.size(), 3u);
+  for (std::pair<pid_t const, std::string> const& e : expected) {
+    ASSERT_LT(e.first, -1);
+    ASSERT_EQ(done[e.first].exit_code, 1);
+    ASSERT_EQ(done[e.first].output, e.second);
+  }
+}
+
+// Given a pool of one worker replaced after two checks
+// When three checks are run
+// Then the third one runs in a new worker
+TEST_F(WorkerPool, RecycleMaxChecks) {
+  worker_pool::load(1, 2, 0);
+  pid_t first(_worker_pid());
+  ASSERT_EQ(_worker_pid(), first);
+  pid_t third(_worker_pid());
+  ASSERT_NE(third, first);
+  ASSERT_EQ(_worker_pid(), third);
+}
+
+// Given a pool of one worker whose memory limit is always reached
+// When two checks are run
+// Then each one runs in a new worker
+TEST_F(WorkerPool, RecycleMaxMemory) {
+  worker_pool::load(1, 100, 1);
+  pid_t first(_worker_pid());
+  pid_t second(_worker_pid());
+  ASSERT_NE(second, first);
+  ASSERT_NE(_worker_pid(), second);
+}
+
+// Given a pool of one busy worker
+// When the check waiting in the queue is killed
+// Then it is completed at once as a killed process and never runs
+TEST_F(WorkerPool, KillQueued) {
+  worker_pool::load(1, 100, 0);
+  pid_t running(worker_pool::instance().run(_sleep_script));
+  pid_t queued(worker_pool::instance().run(_echo_script + " queued"));
+
+  worker_pool::instance().kill(queued, SIGKILL);
+  std::list<worker_pool::completion> done(
+      worker_pool::instance().completions());
+  ASSERT_EQ(done.size(), 1u);
+  ASSERT_EQ(done.front().id, queued);
+  ASSERT_EQ(done.front().exit_code, -1);
+
+  // The running check is not affected by the queued one.
+  worker_pool::instance().kill(running, SIGKILL);
+  done = _wait_exit();
+  ASSERT_EQ(done.size(), 1u);
+  ASSERT_EQ(done.front().id, running);
+}
+
+// Given a pool of one worker running a check that does not end
+// When the check times out and is killed
+// Then it is completed as a killed process and the next check runs in
+// a new worker
+TEST_F(WorkerPool, Timeout) {
+  worker_pool::load(1, 100, 0);
+  pid_t before(_worker_pid());
+  pid_t id(worker_pool::instance().run(_sleep_script));
+  worker_pool::instance().kill(id, SIGKILL);
+
+  std::list<worker_pool::completion> done(_wait_exit());
+  ASSERT_EQ(done.size(), 1u);
+  ASSERT_EQ(done.front().id, id);
+  ASSERT_EQ(done.front().exit_code, -1);
+
+  id = worker_pool::instance().run(_echo_script + " after");
+  std::map<pid_t, worker_pool::completion> after(_wait_completions(1));
+  ASSERT_EQ(after[id].output, "OK - after");
+  ASSERT_NE(_worker_pid(), before);
+}
+
+// Given a pool of one idle worker
+// When the worker dies
+// Then it is replaced and checks still run
+TEST_F(WorkerPool, ReplaceDeadWorker) {
+  worker_pool::load(1, 100, 0);
+  pid_t dead(_worker_pid());
+  ASSERT_EQ(::kill(dead, SIGKILL), 0);
+  ASSERT_EQ(waitpid(dead, nullptr, 0), dead);
+  worker_pool::instance().on_exit(dead);
+  ASSERT_TRUE(worker_pool::instance().completions().empty());
+
+  pid_t id(worker_pool::instance().run(_echo_script + " alive"));
+  std::map<pid_t, worker_pool::completion> done(_wait_completions(1));
+  ASSERT_EQ(done[id].exit_code, 1);
+  ASSERT_EQ(done[id].output, "OK - alive");
+  ASSERT_NE(_worker_pid(), dead);
+}
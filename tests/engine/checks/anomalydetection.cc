@@ -23,6 +23,7 @@
 #include <time.h>
 
 #include <cstring>
+#include <fstream>
 #include <memory>
 
 #include "../test_engine.hh"
@@ -510,3 +511,55 @@ TEST_F(AnomalydetectionCheck, MetricWithQuotes) {
             "'metric'=90MT;;;0;100 metric_lower_thresholds=73.31MT;;;0;100 "
             "metric_upper_thresholds=83.26MT;;;0;100");
 }
+
+TEST_F(AnomalydetectionCheck, BinaryThresholds) {
+  /* Same predictions as in the JSON tests, in the binary format. */
+  std::vector<engine::anomalydetection::threshold_point> points{
+      {50000, 74, 84},
+      {100000, 5, 10},
+      {150000, 93, 100},
+      {200000, 97, 100},
+      {250000, 21, 100}};
+  std::string metric{"metric"};
+  uint64_t header[2];
+  memcpy(&header[0], "CADT", 4);
+  reinterpret_cast<uint32_t*>(&header[0])[1] = 1;
+  header[1] = 1;
+  uint64_t points_offset = sizeof(header) + 40;
+  uint64_t series[5]{12, 9, points_offset, points.size(), 0};
+  uint32_t* metric_desc = reinterpret_cast<uint32_t*>(&series[4]);
+  metric_desc[0] = points_offset + points.size() * sizeof(points[0]);
+  metric_desc[1] = metric.size();
+  {
+    std::ofstream ofs("/tmp/thresholds_status_change.json",
+                      std::ios::binary | std::ios::trunc);
+    ofs.write(reinterpret_cast<char const*>(header), sizeof(header));
+    ofs.write(reinterpret_cast<char const*>(series), sizeof(series));
+    ofs.write(reinterpret_cast<char const*>(points.data()),
+              points.size() * sizeof(points[0]));
+    ofs.write(metric.data(), metric.size());
+  }
+
+  std::vector<engine::anomalydetection::thresholds_entry> entries;
+  ASSERT_EQ(engine::anomalydetection::parse_thresholds_file(
+                "/tmp/thresholds_status_change.json", entries),
+            0);
+  ASSERT_EQ(entries.size(), 1u);
+  ASSERT_EQ(entries[0].host_id, 12u);
+  ASSERT_EQ(entries[0].service_id, 9u);
+  ASSERT_EQ(entries[0].metric_name, "metric");
+  ASSERT_EQ(entries[0].thresholds->size(), 5u);
+
+  _ad->init_thresholds();
+  _ad->set_status_change(true);
+  auto pd = _ad->parse_perfdata("metric=90", 50500);
+  ASSERT_EQ(std::get<0>(pd), engine::service::state_critical);
+  ASSERT_NEAR(std::get<3>(pd), 73.31, 0.001);
+  ASSERT_NEAR(std::get<4>(pd), 83.26, 0.001);
+
+  /* Predictions held by a reader stay valid when they are replaced. */
+  auto old_thresholds = _ad->get_thresholds();
+  engine::anomalydetection::apply_thresholds("/tmp/other_file", entries);
+  ASSERT_EQ(_ad->get_thresholds_file(), "/tmp/other_file");
+  ASSERT_EQ(old_thresholds->begin()->timestamp, 50000);
+}
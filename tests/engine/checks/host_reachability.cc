@@ -0,0 +1,145 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+
+#include "com/centreon/engine/checks/reachability.hh"
+
+#include <gtest/gtest.h>
+
+#include "../test_engine.hh"
+#include "com/centreon/engine/checks/checker.hh"
+#include "com/centreon/engine/configuration/applier/contact.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/host.hh"
+#include "helper.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+
+class HostReachability : public TestEngine {
+ public:
+  void SetUp() override {
+    init_config_state();
+
+    configuration::applier::contact ct_aply;
+    configuration::contact ctct{new_configuration_contact("admin", true)};
+    ct_aply.add_object(ctct);
+    ct_aply.expand_objects(*config);
+    ct_aply.resolve_object(ctct);
+
+    configuration::applier::host hst_aply;
+    configuration::host parent{new_configuration_host("router", "admin", 1)};
+    hst_aply.add_object(parent);
+    configuration::host child{new_configuration_host("child", "admin", 2)};
+    child.parse("parents", "router");
+    hst_aply.add_object(child);
+    hst_aply.expand_objects(*config);
+    hst_aply.resolve_object(parent);
+    hst_aply.resolve_object(child);
+
+    _parent = engine::host::hosts["router"];
+    _child = engine::host::hosts["child"];
+    for (engine::host* h : {_parent.get(), _child.get()}) {
+      h->set_current_state(engine::host::state_up);
+      h->set_state_type(checkable::hard);
+      h->set_check_type(checkable::check_active);
+      h->set_max_attempts(1);
+      // Only the checks run by the reachability resolver are wanted.
+      h->set_checks_enabled(false);
+    }
+  }
+
+  void TearDown() override {
+    _parent.reset();
+    _child.reset();
+    deinit_config_state();
+  }
+
+ protected:
+  checks::reachability& reach() {
+    return checks::checker::instance().get_reachability();
+  }
+
+  std::shared_ptr<engine::host> _parent;
+  std::shared_ptr<engine::host> _child;
+};
+
+// Given a child host whose parent is being checked
+// When the child goes down
+// Then its state transition waits for the parent check result
+// When the parent is UP
+// Then the child is DOWN.
+TEST_F(HostReachability, ParentUp) {
+  _parent->set_is_executing(true);
+  _child->process_check_result_3x(engine::host::state_down, "",
+                                  CHECK_OPTION_NONE, false, true, 15);
+  ASSERT_TRUE(reach().is_pending(_child.get()));
+
+  _parent->set_is_executing(false);
+  _parent->process_check_result_3x(engine::host::state_up, "",
+                                   CHECK_OPTION_NONE, false, true, 15);
+  ASSERT_FALSE(reach().is_pending(_child.get()));
+  ASSERT_EQ(_child->get_current_state(), engine::host::state_down);
+  ASSERT_EQ(_child->get_state_type(), checkable::hard);
+}
+
+// Given a child host whose parent is being checked
+// When the child goes down
+// And the parent goes down too
+// Then the child is UNREACHABLE.
+TEST_F(HostReachability, ParentDown) {
+  _parent->set_is_executing(true);
+  _child->process_check_result_3x(engine::host::state_down, "",
+                                  CHECK_OPTION_NONE, false, true, 15);
+  ASSERT_TRUE(reach().is_pending(_child.get()));
+
+  _parent->set_is_executing(false);
+  _parent->process_check_result_3x(engine::host::state_down, "",
+                                   CHECK_OPTION_NONE, false, true, 15);
+  ASSERT_EQ(_parent->get_current_state(), engine::host::state_down);
+  ASSERT_FALSE(reach().is_pending(_child.get()));
+  ASSERT_EQ(_child->get_current_state(), engine::host::state_unreachable);
+}
+
+// Given a parent host checked within the cached check horizon
+// When its child goes down
+// Then the parent state is used without waiting.
+TEST_F(HostReachability, CachedParent) {
+  _parent->set_has_been_checked(true);
+  _parent->set_last_check(std::time(nullptr));
+  _child->process_check_result_3x(engine::host::state_down, "",
+                                  CHECK_OPTION_NONE, false, true, 15);
+  ASSERT_FALSE(reach().is_pending(_child.get()));
+  ASSERT_EQ(_child->get_current_state(), engine::host::state_down);
+}
+
+// Given a child host waiting for its parent
+// When a newer check result of the child is processed
+// Then the previous resolution is cancelled.
+TEST_F(HostReachability, NewerResultCancels) {
+  _parent->set_is_executing(true);
+  _child->process_check_result_3x(engine::host::state_down, "",
+                                  CHECK_OPTION_NONE, false, true, 15);
+  ASSERT_TRUE(reach().is_pending(_child.get()));
+
+  _child->process_check_result_3x(engine::host::state_up, "",
+                                  CHECK_OPTION_NONE, false, true, 15);
+  ASSERT_FALSE(reach().is_pending(_child.get()));
+  ASSERT_EQ(_child->get_current_state(), engine::host::state_up);
+}
@@ -26,6 +26,7 @@
 using namespace com::centreon;
 using namespace com::centreon::engine;
 
+extern int config_warnings;
 
 class ApplierGlobal : public ::testing::Test {
  public:
@@ -93,3 +94,82 @@ TEST_F(ApplierGlobal, RpcPort) {
 
   ASSERT_EQ(st.rpc_port(), 42);
 }
+
+// Given a configuration with several object files
+// When it is parsed, one object file being modified before a new parsing
+// Then the objects of every file are read
+TEST_F(ApplierGlobal, ObjectFiles) {
+  {
+    std::ofstream ofs("/tmp/test-config.cfg");
+    ofs << "cfg_file=/tmp/test-config-1.cfg" << std::endl
+        << "cfg_file=/tmp/test-config-2.cfg" << std::endl;
+  }
+  {
+    std::ofstream ofs("/tmp/test-config-1.cfg");
+    ofs << "define command {" << std::endl
+        << "  command_name cmd1" << std::endl
+        << "  command_line /bin/echo \\" << std::endl
+        << "1" << std::endl
+        << "}" << std::endl;
+  }
+  {
+    std::ofstream ofs("/tmp/test-config-2.cfg");
+    ofs << "define command {" << std::endl
+        << "  command_name cmd2" << std::endl
+        << "  command_line /bin/echo 2" << std::endl
+        << "}" << std::endl;
+  }
+
+  configuration::state st1;
+  configuration::parser().parse("/tmp/test-config.cfg", st1);
+  ASSERT_EQ(st1.commands().size(), 2u);
+  ASSERT_EQ(st1.commands_find("cmd1")->command_line(), "/bin/echo 1");
+  ASSERT_EQ(st1.commands_find("cmd2")->command_line(), "/bin/echo 2");
+
+  {
+    std::ofstream ofs("/tmp/test-config-2.cfg", std::ios::app);
+    ofs << "define command {" << std::endl
+        << "  command_name cmd3" << std::endl
+        << "  command_line /bin/echo 3" << std::endl
+        << "}" << std::endl;
+  }
+  configuration::state st2;
+  configuration::parser().parse("/tmp/test-config.cfg", st2);
+  ASSERT_EQ(st2.commands().size(), 3u);
+  ASSERT_EQ(st2.commands_find("cmd1")->command_line(), "/bin/echo 1");
+  ASSERT_EQ(st2.commands_find("cmd3")->command_line(), "/bin/echo 3");
+
+  std::remove("/tmp/test-config.cfg");
+  std::remove("/tmp/test-config-1.cfg");
+  std::remove("/tmp/test-config-2.cfg");
+}
+
+// Given several object files using deprecated options
+// When they are parsed by several threads
+// Then each warning is counted
+TEST_F(ApplierGlobal, ParseWarnings) {
+  {
+    std::ofstream ofs("/tmp/test-config.cfg");
+    for (int i = 0; i < 8; ++i)
+      ofs << "cfg_file=/tmp/test-config-" << i << ".cfg" << std::endl;
+  }
+  for (int i = 0; i < 8; ++i) {
+    std::ofstream ofs("/tmp/test-config-" + std::to_string(i) + ".cfg");
+    for (int j = 0; j < 100; ++j)
+      ofs << "define host {" << std::endl
+          << "  host_name host_" << i << "_" << j << std::endl
+          << "  _HOST_ID " << i * 100 + j + 1 << std::endl
+          << "  address 127.0.0.1" << std::endl
+          << "  failure_prediction_enabled 1" << std::endl
+          << "}" << std::endl;
+  }
+
+  config_warnings = 0;
+  configuration::state st;
+  configuration::parser().parse("/tmp/test-config.cfg", st);
+  ASSERT_EQ(config_warnings, 800);
+
+  std::remove("/tmp/test-config.cfg");
+  for (int i = 0; i < 8; ++i)
+    std::remove(("/tmp/test-config-" + std::to_string(i) + ".cfg").c_str());
+}
@@ -19,6 +19,7 @@
 
 #include "com/centreon/engine/configuration/service.hh"
 #include <gtest/gtest.h>
+#include "com/centreon/engine/configuration/applier/difference.hh"
 
 using namespace com::centreon::engine;
 
@@ -66,3 +67,45 @@ TEST(ConfigurationServiceParseProperties, SetCustomVariable) {
   configuration::service s;
   ASSERT_TRUE(s.parse("_VARNAME", "TEST1"));
 }
+
+// Given two equal service configuration objects
+// When their content hashes are computed
+// Then they are equal and not null
+// And a service parsed with another property value has another hash
+TEST(ConfigurationServiceContentHashTest, EqualServices) {
+  configuration::service s1;
+  ASSERT_TRUE(s1.parse("host_name", "test_host"));
+  ASSERT_TRUE(s1.parse("service_description", "test_svc"));
+  ASSERT_TRUE(s1.parse("check_interval", "5"));
+  configuration::service s2(s1);
+  ASSERT_NE(s1.content_hash(), 0u);
+  ASSERT_EQ(s1.content_hash(), s2.content_hash());
+
+  ASSERT_TRUE(s2.parse("check_interval", "6"));
+  ASSERT_TRUE(s1 != s2);
+  ASSERT_NE(s1.content_hash(), s2.content_hash());
+}
+
+// Given two services differing only by a custom variable
+// When the configurations containing them are compared
+// Then the service is detected as modified
+TEST(ConfigurationServiceContentHashTest, CustomVariable) {
+  configuration::service s1;
+  ASSERT_TRUE(s1.parse("host_name", "test_host"));
+  ASSERT_TRUE(s1.parse("service_description", "test_svc"));
+  ASSERT_TRUE(s1.parse("_HOST_ID", "12"));
+  ASSERT_TRUE(s1.parse("_SERVICE_ID", "13"));
+  ASSERT_TRUE(s1.parse("_VARNAME", "TEST1"));
+  configuration::service s2(s1);
+  ASSERT_TRUE(s2.parse("_VARNAME", "TEST2"));
+  ASSERT_TRUE(s1 != s2);
+  ASSERT_NE(s1.content_hash(), s2.content_hash());
+
+  configuration::set_service old_services{s1};
+  configuration::set_service new_services{s2};
+  configuration::applier::difference<configuration::set_service> diff(
+      old_services, new_services);
+  ASSERT_TRUE(diff.added().empty());
+  ASSERT_TRUE(diff.deleted().empty());
+  ASSERT_EQ(diff.modified().size(), 1u);
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/engine/downtimes/downtime_manager.hh"
+#include <gtest/gtest.h>
+#include "../timeperiod/utils.hh"
+#include "com/centreon/engine/configuration/applier/contact.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "com/centreon/engine/downtimes/service_downtime.hh"
+#include "helper.hh"
+#include "test_engine.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::downtimes;
+
+class DowntimeManager : public TestEngine {
+ public:
+  void SetUp() override {
+    init_config_state();
+
+    configuration::applier::contact ct_aply;
+    configuration::contact ctct{new_configuration_contact("admin", true)};
+    ct_aply.add_object(ctct);
+    ct_aply.expand_objects(*config);
+    ct_aply.resolve_object(ctct);
+
+    configuration::applier::host hst_aply;
+    configuration::applier::service svc_aply;
+    for (int h = 1; h <= 2; ++h) {
+      std::string host_name{"test_host" + std::to_string(h)};
+      configuration::host hst{new_configuration_host(host_name, "admin", h)};
+      hst_aply.add_object(hst);
+      for (int s = 1; s <= 3; ++s) {
+        configuration::service svc{new_configuration_service(
+            host_name, "test_svc" + std::to_string(s), "admin", h * 10 + s)};
+        svc_aply.add_object(svc);
+        _svc_cfg.push_back(svc);
+      }
+      _hst_cfg.push_back(hst);
+    }
+    for (auto& hst : _hst_cfg)
+      hst_aply.resolve_object(hst);
+    for (auto& svc : _svc_cfg)
+      svc_aply.resolve_object(svc);
+
+    set_time(20000);
+  }
+
+  void TearDown() override {
+    downtime_manager::instance().clear_scheduled_downtimes();
+    deinit_config_state();
+  }
+
+  uint64_t schedule(downtime::type type,
+                    std::string const& host_name,
+                    std::string const& service_description,
+                    time_t start,
+                    uint64_t triggered_by = 0) {
+    uint64_t id{0};
+    EXPECT_EQ(downtime_manager::instance().schedule_downtime(
+                  type, host_name, service_description, 20000, "admin",
+                  "comment", start, start + 3600, true, triggered_by, 3600,
+                  &id),
+              OK);
+    return id;
+  }
+
+ private:
+  std::list<configuration::host> _hst_cfg;
+  std::list<configuration::service> _svc_cfg;
+};
+
+// Given hosts with services and downtimes on each of them
+// When downtimes of a host are looked up
+// Then only its own downtimes are found, ordered by start time
+TEST_F(DowntimeManager, FindDowntimesByObject) {
+  schedule(downtime::host_downtime, "test_host1", "", 30000);
+  schedule(downtime::service_downtime, "test_host1", "test_svc2", 25000);
+  schedule(downtime::service_downtime, "test_host1", "test_svc3", 40000);
+  schedule(downtime::service_downtime, "test_host2", "test_svc2", 21000);
+  ASSERT_EQ(downtime_manager::instance().get_scheduled_downtimes().size(), 4u);
+
+  auto all{downtime_manager::instance().find_downtimes(
+      downtime::any_downtime, "test_host1", "")};
+  ASSERT_EQ(all.size(), 3u);
+  ASSERT_EQ(all[0]->get_start_time(), 25000);
+  ASSERT_EQ(all[1]->get_start_time(), 30000);
+  ASSERT_EQ(all[2]->get_start_time(), 40000);
+
+  auto hst{downtime_manager::instance().find_downtimes(downtime::host_downtime,
+                                                       "test_host1", "")};
+  ASSERT_EQ(hst.size(), 1u);
+  ASSERT_EQ(hst[0]->get_type(), downtime::host_downtime);
+
+  auto svc{downtime_manager::instance().find_downtimes(
+      downtime::service_downtime, "test_host2", "test_svc2")};
+  ASSERT_EQ(svc.size(), 1u);
+  ASSERT_EQ(std::static_pointer_cast<service_downtime>(svc[0])
+                ->get_service_description(),
+            "test_svc2");
+
+  ASSERT_TRUE(downtime_manager::instance()
+                  .find_downtimes(downtime::any_downtime, "unknown", "")
+                  .empty());
+}
+
+// Given downtimes on two hosts
+// When downtimes are deleted by host name
+// Then the other host keeps its downtimes and indexes stay consistent
+TEST_F(DowntimeManager, DeleteByHostName) {
+  uint64_t id1{schedule(downtime::host_downtime, "test_host1", "", 30000)};
+  schedule(downtime::service_downtime, "test_host1", "test_svc1", 30000);
+  uint64_t id2{
+      schedule(downtime::service_downtime, "test_host2", "test_svc1", 30000)};
+
+  ASSERT_EQ(downtime_manager::instance()
+                .delete_downtime_by_hostname_service_description_start_time_comment(
+                    "test_host1", "", {false, 0}, ""),
+            2);
+  ASSERT_EQ(downtime_manager::instance().get_scheduled_downtimes().size(), 1u);
+  ASSERT_FALSE(
+      downtime_manager::instance().find_downtime(downtime::any_downtime, id1));
+  ASSERT_TRUE(
+      downtime_manager::instance().find_downtime(downtime::any_downtime, id2));
+  ASSERT_FALSE(downtime_manager::instance().find_downtime(
+      downtime::host_downtime, id2));
+  ASSERT_TRUE(downtime_manager::instance()
+                  .find_downtimes(downtime::any_downtime, "test_host1", "")
+                  .empty());
+}
+
+// Given a downtime triggering other ones
+// When it is unscheduled
+// Then triggered downtimes are unscheduled too
+TEST_F(DowntimeManager, UnscheduleTriggered) {
+  uint64_t id{schedule(downtime::host_downtime, "test_host1", "", 30000)};
+  schedule(downtime::service_downtime, "test_host1", "test_svc1", 30000, id);
+  schedule(downtime::service_downtime, "test_host2", "test_svc1", 30000, id);
+  schedule(downtime::service_downtime, "test_host2", "test_svc2", 30000);
+  ASSERT_EQ(downtime_manager::instance().get_scheduled_downtimes().size(), 4u);
+
+  ASSERT_EQ(downtime_manager::instance().unschedule_downtime(id), OK);
+  ASSERT_EQ(downtime_manager::instance().get_scheduled_downtimes().size(), 1u);
+  ASSERT_EQ(downtime_manager::instance().unschedule_downtime(id), ERROR);
+}
+
+// Given many service downtimes
+// When they are deleted service by service
+// Then all of them are removed
+TEST_F(DowntimeManager, DeleteMany) {
+  for (int i = 0; i < 1000; ++i)
+    schedule(downtime::service_downtime, "test_host" + std::to_string(i % 2 + 1),
+             "test_svc" + std::to_string(i % 3 + 1), 21000 + i);
+  ASSERT_EQ(downtime_manager::instance().get_scheduled_downtimes().size(),
+            1000u);
+
+  int deleted{0};
+  for (int h = 1; h <= 2; ++h)
+    for (int s = 1; s <= 3; ++s)
+      deleted +=
+          downtime_manager::instance()
+              .delete_downtime_by_hostname_service_description_start_time_comment(
+                  "test_host" + std::to_string(h),
+                  "test_svc" + std::to_string(s), {false, 0}, "comment");
+  ASSERT_EQ(deleted, 1000);
+  ASSERT_TRUE(downtime_manager::instance().get_scheduled_downtimes().empty());
+}
+
+// Given a scheduled downtime
+// When another downtime with the same id is added
+// Then it is rejected and the existing downtime is kept
+TEST_F(DowntimeManager, DuplicateId) {
+  uint64_t id{schedule(downtime::host_downtime, "test_host1", "", 30000)};
+  std::shared_ptr<downtime> dup{std::make_shared<service_downtime>(
+      "test_host2", "test_svc1", 20000, "admin", "duplicate", 25000, 28600,
+      true, 0, 3600, id)};
+  ASSERT_FALSE(downtime_manager::instance().insert_downtime(dup));
+
+  ASSERT_EQ(downtime_manager::instance().get_scheduled_downtimes().size(), 1u);
+  std::shared_ptr<downtime> found{
+      downtime_manager::instance().find_downtime(downtime::any_downtime, id)};
+  ASSERT_TRUE(found);
+  ASSERT_EQ(found->get_type(), downtime::host_downtime);
+  ASSERT_EQ(found->get_start_time(), 30000);
+  ASSERT_TRUE(downtime_manager::instance()
+                  .find_downtimes(downtime::any_downtime, "test_host2", "")
+                  .empty());
+}
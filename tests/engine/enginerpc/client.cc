@@ -22,6 +22,7 @@
 #include <grpcpp/client_context.h>
 #include <grpcpp/create_channel.h>
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 
@@ -1279,6 +1280,18 @@ class EngineRPCClient {
     return true;
   }
 
+  bool ProcessServiceCheckResultById(CheckById const& sc) {
+    grpc::ClientContext context;
+    CommandSuccess response;
+    grpc::Status status =
+        _stub->ProcessServiceCheckResultById(&context, sc, &response);
+    if (!status.ok()) {
+      std::cout << "ProcessServiceCheckResultById failed." << std::endl;
+      return false;
+    }
+    return true;
+  }
+
   bool ProcessHostCheckResult(Check const& hc) {
     grpc::ClientContext context;
     CommandSuccess response;
@@ -1291,6 +1304,36 @@ class EngineRPCClient {
     return true;
   }
 
+  bool ProcessCheckResults(Check const& model,
+                           uint64_t count,
+                           CheckResultsCount* response) {
+    grpc::ClientContext context;
+    std::unique_ptr<grpc::ClientWriter<Check>> writer(
+        _stub->ProcessCheckResults(&context, response));
+    for (uint64_t i = 0; i < count; ++i)
+      if (!writer->Write(model))
+        break;
+    writer->WritesDone();
+    grpc::Status status = writer->Finish();
+    if (!status.ok()) {
+      std::cout << "ProcessCheckResults failed." << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  bool ProcessCheckResultsBatch(CheckList const& checks,
+                                CheckResultsCount* response) {
+    grpc::ClientContext context;
+    grpc::Status status =
+        _stub->ProcessCheckResultsBatch(&context, checks, response);
+    if (!status.ok()) {
+      std::cout << "ProcessCheckResultsBatch failed." << std::endl;
+      return false;
+    }
+    return true;
+  }
+
   bool NewThresholdsFile(const ThresholdsFile& tf) {
     grpc::ClientContext context;
     CommandSuccess response;
@@ -1330,6 +1373,14 @@ int main(int argc, char** argv) {
     sc.set_output("Test external command");
     status = client.ProcessServiceCheckResult(sc) ? 0 : 3;
     std::cout << "ProcessServiceCheckResult: " << status << std::endl;
+  } else if (strcmp(argv[1], "ProcessServiceCheckResultById") == 0) {
+    CheckById sc;
+    sc.set_host_id(std::stoul(argv[2]));
+    sc.set_service_id(std::stoul(argv[3]));
+    sc.set_code(std::stol(argv[4]));
+    sc.set_output("Test external command");
+    status = client.ProcessServiceCheckResultById(sc) ? 0 : 3;
+    std::cout << "ProcessServiceCheckResultById: " << status << std::endl;
   } else if (strcmp(argv[1], "ProcessHostCheckResult") == 0) {
     Check hc;
     hc.set_host_name(argv[2]);
@@ -1337,6 +1388,30 @@ int main(int argc, char** argv) {
     hc.set_output("Test external command");
     status = client.ProcessHostCheckResult(hc) ? 0 : 4;
     std::cout << "ProcessHostCheckResult: " << status << std::endl;
+  } else if (strcmp(argv[1], "ProcessCheckResults") == 0 ||
+             strcmp(argv[1], "ProcessCheckResultsBatch") == 0) {
+    /* Also usable as a load test: the rate is written on stderr. */
+    Check c;
+    c.set_host_name(argv[2]);
+    c.set_svc_desc(argv[3]);
+    c.set_code(0);
+    c.set_output("Test external command");
+    uint64_t count = std::stoull(argv[4]);
+    CheckResultsCount response;
+    auto start = std::chrono::steady_clock::now();
+    if (strcmp(argv[1], "ProcessCheckResults") == 0)
+      status = client.ProcessCheckResults(c, count, &response) ? 0 : 3;
+    else {
+      CheckList checks;
+      for (uint64_t i = 0; i < count; ++i)
+        *checks.add_checks() = c;
+      status = client.ProcessCheckResultsBatch(checks, &response) ? 0 : 3;
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cerr << count / elapsed.count() << " check results/s" << std::endl;
+    std::cout << argv[1] << ": " << response.accepted() << " "
+              << response.rejected() << std::endl;
   } else if (strcmp(argv[1], "NewThresholdsFile") == 0) {
     ThresholdsFile tf;
     tf.set_filename(argv[2]);
@@ -1782,6 +1782,81 @@ TEST_F(EngineRpc, ProcessServiceCheckResultBadService) {
   erpc.shutdown();
 }
 
+TEST_F(EngineRpc, ProcessServiceCheckResultById) {
+  enginerpc erpc("0.0.0.0", 40001);
+  auto output = execute("ProcessServiceCheckResultById 12 13 0");
+  ASSERT_EQ(output.size(), 1);
+  ASSERT_EQ(output.front(), "ProcessServiceCheckResultById: 0");
+  erpc.shutdown();
+}
+
+TEST_F(EngineRpc, ProcessServiceCheckResultByIdBadService) {
+  enginerpc erpc("0.0.0.0", 40001);
+  auto output = execute("ProcessServiceCheckResultById 12 0 0");
+  ASSERT_EQ(output.size(), 2);
+  ASSERT_EQ(output.front(), "ProcessServiceCheckResultById failed.");
+  erpc.shutdown();
+}
+
+TEST_F(EngineRpc, ProcessCheckResults) {
+  enginerpc erpc("0.0.0.0", 40001);
+  auto output = execute("ProcessCheckResults test_host test_svc 3000");
+  ASSERT_EQ(output.size(), 1);
+  ASSERT_EQ(output.front(), "ProcessCheckResults: 3000 0");
+  ASSERT_EQ(command_manager::instance().process_check_results(2000), 2048u);
+  ASSERT_EQ(command_manager::instance().process_check_results(), 952u);
+  ASSERT_EQ(command_manager::instance().process_check_results(), 0u);
+  erpc.shutdown();
+}
+
+TEST_F(EngineRpc, ProcessCheckResultsBadHost) {
+  enginerpc erpc("0.0.0.0", 40001);
+  auto output = execute("ProcessCheckResults \"\" test_svc 10");
+  ASSERT_EQ(output.size(), 1);
+  ASSERT_EQ(output.front(), "ProcessCheckResults: 0 10");
+  ASSERT_EQ(command_manager::instance().process_check_results(), 0u);
+  erpc.shutdown();
+}
+
+TEST_F(EngineRpc, ProcessCheckResultsBatch) {
+  enginerpc erpc("0.0.0.0", 40001);
+  auto output = execute("ProcessCheckResultsBatch test_host \"\" 100");
+  ASSERT_EQ(output.size(), 1);
+  ASSERT_EQ(output.front(), "ProcessCheckResultsBatch: 100 0");
+  ASSERT_EQ(command_manager::instance().process_check_results(), 100u);
+  erpc.shutdown();
+}
+
+TEST_F(EngineRpc, ProcessCheckResultsFull) {
+  // Given the queue of check results is full
+  Check c;
+  c.set_host_name("test_host");
+  for (size_t i = 0; i < command_manager::check_results_max;
+       i += command_manager::check_results_chunk) {
+    std::vector<Check> chunk(command_manager::check_results_chunk, c);
+    ASSERT_TRUE(command_manager::instance().enqueue_check_results(
+        std::move(chunk), std::chrono::milliseconds(10)));
+  }
+
+  // When a new chunk is queued
+  std::vector<Check> chunk(10, c);
+  // Then it waits and is refused
+  ASSERT_FALSE(command_manager::instance().enqueue_check_results(
+      std::move(chunk), std::chrono::milliseconds(10)));
+  ASSERT_EQ(chunk.size(), 10u);
+
+  // And it is accepted as soon as the main loop made room
+  ASSERT_EQ(command_manager::instance().process_check_results(
+                command_manager::check_results_chunk),
+            command_manager::check_results_chunk);
+  ASSERT_TRUE(command_manager::instance().enqueue_check_results(
+      std::move(chunk), std::chrono::milliseconds(10)));
+  ASSERT_EQ(command_manager::instance().process_check_results(
+                command_manager::check_results_max),
+            command_manager::check_results_max -
+                command_manager::check_results_chunk + 10);
+}
+
 TEST_F(EngineRpc, ProcessHostCheckResult) {
   enginerpc erpc("0.0.0.0", 40001);
   auto output = execute("ProcessHostCheckResult test_host 0");
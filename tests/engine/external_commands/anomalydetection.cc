@@ -21,7 +21,9 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <cstdio>
+#include <thread>
 
 #include "../test_engine.hh"
 #include "com/centreon/engine/checks/checker.hh"
@@ -91,6 +93,7 @@ class ADExtCmd : public TestEngine {
   }
 
   void TearDown() override {
+    anomalydetection::stop_thresholds_updates();
     _host.reset();
     _svc.reset();
     _ad.reset();
@@ -141,5 +144,16 @@ TEST_F(ADExtCmd, NewThresholdsFile) {
       << " NEW_THRESHOLDS_FILE;/tmp/thresholds_file.json";
   process_external_command(oss.str().c_str());
   checks::checker::instance().reap();
+
+  /* The file is read by another thread, then services are updated by the
+   * main loop. */
+  for (int i = 0; i < 100 && _ad->get_thresholds_file() !=
+                                 "/tmp/thresholds_file.json";
+       ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    command_manager::instance().execute();
+  }
   ASSERT_EQ(_ad->get_thresholds_file(), "/tmp/thresholds_file.json");
+  ASSERT_TRUE(_ad->get_thresholds());
+  ASSERT_EQ(_ad->get_thresholds()->size(), 5u);
 }
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2020 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include "com/centreon/engine/command_ring.hh"
+#include <gtest/gtest.h>
+#include <thread>
+#include "../timeperiod/utils.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/modules/external_commands/commands.hh"
+#include "com/centreon/engine/modules/external_commands/internal.hh"
+#include "helper.hh"
+
+using namespace com::centreon::engine;
+
+// Given a ring of three slots
+// When four lines are pushed
+// Then the last one is refused until a line is consumed
+TEST(CommandRing, Full) {
+  command_ring ring;
+  ring.resize(3);
+  ASSERT_EQ(ring.capacity(), 3u);
+  ASSERT_TRUE(ring.push("a", 1));
+  ASSERT_TRUE(ring.push("bb", 2));
+  ASSERT_TRUE(ring.push("ccc", 3));
+  ASSERT_FALSE(ring.push("dddd", 4));
+  ASSERT_EQ(ring.size(), 3u);
+  ASSERT_EQ(ring.high(), 3u);
+
+  std::vector<std::string> lines;
+  auto collect = [&lines](std::string const& l) { lines.push_back(l); };
+  ASSERT_EQ(ring.consume(2, collect), 2u);
+  ASSERT_TRUE(ring.push("dddd", 4));
+  ASSERT_EQ(ring.consume(10, collect), 2u);
+  ASSERT_EQ(ring.consume(10, collect), 0u);
+  ASSERT_EQ(lines, (std::vector<std::string>{"a", "bb", "ccc", "dddd"}));
+  ASSERT_EQ(ring.size(), 0u);
+  ASSERT_EQ(ring.high(), 3u);
+}
+
+// Given a ring
+// When lines longer than a slot are pushed
+// Then they are kept entirely
+TEST(CommandRing, LongLines) {
+  command_ring ring;
+  ring.resize(2);
+  std::string line(3 * command_ring::slot_size, 'x');
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(ring.push(line.data(), line.size()));
+    ASSERT_EQ(ring.consume(1,
+                           [&line](std::string const& l) {
+                             ASSERT_EQ(l, line);
+                           }),
+              1u);
+  }
+}
+
+// Given a producer thread filling a small ring
+// When the consumer takes lines by batches
+// Then all the lines are received in order
+TEST(CommandRing, ProducerConsumer) {
+  command_ring ring;
+  ring.resize(64);
+  int const count = 100000;
+
+  std::thread producer([&ring] {
+    for (int i = 0; i < count; ++i) {
+      std::string line{std::to_string(i)};
+      while (!ring.push(line.data(), line.size()))
+        std::this_thread::yield();
+    }
+  });
+
+  int expected = 0;
+  while (expected < count)
+    if (!ring.consume(16, [&expected](std::string const& l) {
+          ASSERT_EQ(l, std::to_string(expected));
+          ++expected;
+        }))
+      std::this_thread::yield();
+  producer.join();
+  ASSERT_EQ(ring.size(), 0u);
+  ASSERT_LE(ring.high(), 64u);
+}
+
+class CommandRingProcessing : public ::testing::Test {
+ public:
+  void SetUp() override {
+    init_config_state();
+    external_command_buffer.resize(16);
+  }
+
+  void TearDown() override {
+    external_command_buffer.clear();
+    deinit_config_state();
+  }
+};
+
+// Given command lines with various names
+// When their thread safety is checked
+// Then only known thread-safe commands are reported as such
+TEST_F(CommandRingProcessing, ThreadSafe) {
+  modules::external_commands::processing const& p{
+      modules::external_commands::gl_processor};
+  ASSERT_TRUE(p.is_thread_safe("[1234] PROCESS_SERVICE_CHECK_RESULT;a;b;0;o"));
+  ASSERT_TRUE(p.is_thread_safe("[1234] PROCESS_HOST_CHECK_RESULT;a;0;o"));
+  ASSERT_FALSE(p.is_thread_safe("[1234] PROCESS_SERVICE_CHECK_RESUL;a;b;0"));
+  ASSERT_FALSE(p.is_thread_safe("[1234] DISABLE_NOTIFICATIONS"));
+  ASSERT_FALSE(p.is_thread_safe("[1234] UNKNOWN_COMMAND;a"));
+  ASSERT_FALSE(p.is_thread_safe("[1234] "));
+}
+
+// Given commands queued in the external command buffer
+// When the main loop checks for external commands
+// Then they are executed and the buffer is empty
+TEST_F(CommandRingProcessing, CheckForExternalCommands) {
+  set_time(20000);
+  ASSERT_TRUE(config->enable_notifications());
+
+  std::string line{"[20000] DISABLE_NOTIFICATIONS"};
+  ASSERT_TRUE(external_command_buffer.push(line.data(), line.size()));
+  line = "[20000] UNKNOWN_COMMAND;a;b";
+  ASSERT_TRUE(external_command_buffer.push(line.data(), line.size()));
+  ASSERT_EQ(external_command_buffer.size(), 2u);
+
+  ASSERT_EQ(check_for_external_commands(), OK);
+  ASSERT_EQ(external_command_buffer.size(), 0u);
+  ASSERT_FALSE(config->enable_notifications());
+}
@@ -0,0 +1,140 @@
+/*
+** Copyright 2020 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <fstream>
+#include "com/centreon/engine/configuration/applier/command.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "com/centreon/engine/retention/dump.hh"
+#include "com/centreon/engine/retention/host.hh"
+#include "com/centreon/engine/retention/parser.hh"
+#include "com/centreon/engine/retention/service.hh"
+#include "com/centreon/engine/retention/state.hh"
+#include "helper.hh"
+
+using namespace com::centreon::engine;
+
+class RetentionSaveTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    init_config_state();
+
+    configuration::applier::command cmd_aply;
+    configuration::applier::host hst_aply;
+    configuration::applier::service svc_aply;
+    configuration::command cmd("cmd");
+    configuration::host hst;
+    configuration::service svc;
+
+    cmd.parse("command_line", "/usr/bin/echo 1");
+    cmd_aply.add_object(cmd);
+
+    ASSERT_TRUE(hst.parse("host_name", "test_host"));
+    ASSERT_TRUE(hst.parse("address", "127.0.0.1"));
+    ASSERT_TRUE(hst.parse("host_id", "1"));
+    ASSERT_TRUE(hst.parse("check_command", "cmd"));
+    ASSERT_TRUE(hst.parse("_VAR", "value"));
+    hst_aply.add_object(hst);
+
+    ASSERT_TRUE(svc.parse("host", "test_host"));
+    ASSERT_TRUE(svc.parse("service_description", "test_description"));
+    ASSERT_TRUE(svc.parse("service_id", "3"));
+    ASSERT_TRUE(svc.parse("check_command", "cmd"));
+    svc.set_host_id(1);
+    svc_aply.add_object(svc);
+
+    hst_aply.expand_objects(*config);
+    svc_aply.expand_objects(*config);
+    hst_aply.resolve_object(hst);
+    svc_aply.resolve_object(svc);
+
+    host::hosts["test_host"]->set_plugin_output("host output");
+    service::services[{"test_host", "test_description"}]->set_plugin_output(
+        "service output");
+  }
+
+  void TearDown() override {
+    deinit_config_state();
+    ::unlink(_path);
+  }
+
+  /**
+   *  Save the retention data and parse the file.
+   */
+  static void save_and_parse(bool binary, retention::state& st) {
+    config->retention_binary_format(binary);
+    ASSERT_TRUE(retention::dump::save(_path));
+    ASSERT_NE(::access(_path, F_OK), -1);
+    ASSERT_EQ(::access((std::string(_path) + ".tmp").c_str(), F_OK), -1);
+    retention::parser p;
+    p.parse(_path, st);
+  }
+
+ protected:
+  static char const* const _path;
+};
+
+char const* const RetentionSaveTest::_path = "/tmp/retention_save_test.dat";
+
+// Given hosts and services
+// When the retention data are saved in text and in binary
+// Then the parser reads the same retention data from both files
+TEST_F(RetentionSaveTest, TextAndBinaryFormats) {
+  retention::state text;
+  save_and_parse(false, text);
+  retention::state binary;
+  save_and_parse(true, binary);
+
+  std::ifstream ifs(_path, std::ios::binary);
+  char magic[sizeof(retention::dump::binary_magic) - 1];
+  ASSERT_TRUE(ifs.read(magic, sizeof(magic)));
+  ASSERT_EQ(std::string(magic, sizeof(magic)), retention::dump::binary_magic);
+
+  ASSERT_EQ(text.hosts().size(), 1u);
+  ASSERT_EQ(binary.hosts().size(), 1u);
+  ASSERT_EQ(text.hosts().front()->host_name(), "test_host");
+  ASSERT_EQ(*text.hosts().front()->plugin_output(), "host output");
+  ASSERT_TRUE(*text.hosts().front() == *binary.hosts().front());
+
+  ASSERT_EQ(text.services().size(), 1u);
+  ASSERT_EQ(binary.services().size(), 1u);
+  ASSERT_EQ(*text.services().front()->plugin_output(), "service output");
+  ASSERT_TRUE(*text.services().front() == *binary.services().front());
+
+  ASSERT_TRUE(text.globals() == binary.globals());
+}
+
+// Given hosts and services
+// When the retention data are saved in the background
+// Then the retention file is complete once the save is finished
+TEST_F(RetentionSaveTest, SaveAsync) {
+  config->retention_binary_format(false);
+  ASSERT_TRUE(retention::dump::save_async(_path));
+  ASSERT_TRUE(retention::dump::wait());
+  ASSERT_EQ(::access((std::string(_path) + ".tmp").c_str(), F_OK), -1);
+
+  retention::state st;
+  retention::parser p;
+  p.parse(_path, st);
+  ASSERT_EQ(st.hosts().size(), 1u);
+  ASSERT_EQ(st.services().size(), 1u);
+  ASSERT_EQ(st.services().front()->service_description(), "test_description");
+}
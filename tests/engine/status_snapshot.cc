@@ -0,0 +1,118 @@
+/*
+** Copyright 2020 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "com/centreon/engine/status_snapshot.hh"
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include "com/centreon/engine/configuration/applier/command.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "com/centreon/engine/configuration/state.hh"
+#include "helper.hh"
+
+using namespace com::centreon::engine;
+
+class StatusSnapshotTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    init_config_state();
+
+    configuration::applier::command cmd_aply;
+    configuration::applier::host hst_aply;
+    configuration::applier::service svc_aply;
+    configuration::command cmd("cmd");
+    configuration::host hst;
+    configuration::service svc;
+
+    cmd.parse("command_line", "/usr/bin/echo 1");
+    cmd_aply.add_object(cmd);
+
+    ASSERT_TRUE(hst.parse("host_name", "test_host"));
+    ASSERT_TRUE(hst.parse("address", "127.0.0.1"));
+    ASSERT_TRUE(hst.parse("host_id", "12"));
+    ASSERT_TRUE(hst.parse("check_command", "cmd"));
+    hst_aply.add_object(hst);
+
+    ASSERT_TRUE(svc.parse("host", "test_host"));
+    ASSERT_TRUE(svc.parse("service_description", "test_description"));
+    ASSERT_TRUE(svc.parse("service_id", "27"));
+    ASSERT_TRUE(svc.parse("check_command", "cmd"));
+    svc.set_host_id(12);
+    svc_aply.add_object(svc);
+
+    hst_aply.expand_objects(*config);
+    svc_aply.expand_objects(*config);
+    hst_aply.resolve_object(hst);
+    svc_aply.resolve_object(svc);
+  }
+
+  void TearDown() override {
+    status_snapshot::writer::instance().close(true);
+    deinit_config_state();
+  }
+
+ protected:
+  char const* _path = "/tmp/centengine_status_snapshot.bin";
+};
+
+// Given a configuration with a host and a service
+// When the status snapshot is enabled
+// Then it contains a record per host and per service
+// When the host status is updated
+// Then the snapshot record of the host is updated in place.
+TEST_F(StatusSnapshotTest, UpdateInPlace) {
+  config->status_snapshot_file(_path);
+  ASSERT_TRUE(status_snapshot::writer::instance().update());
+
+  status_snapshot::reader reader;
+  ASSERT_TRUE(reader.read(_path));
+  ASSERT_EQ(reader.get_header().host_count, 1u);
+  ASSERT_EQ(reader.get_header().service_count, 1u);
+  ASSERT_EQ(reader.hosts()[0].host_id, 12u);
+  ASSERT_EQ(reader.hosts()[0].service_id, 0u);
+  ASSERT_EQ(reader.services()[0].host_id, 12u);
+  ASSERT_EQ(reader.services()[0].service_id, 27u);
+  ASSERT_EQ(reader.hosts()[0].current_state, host::state_up);
+  uint64_t sequence(reader.get_header().sequence);
+
+  host& hst(*host::hosts["test_host"]);
+  hst.set_current_state(host::state_down);
+  hst.set_latency(2.5);
+  hst.update_status(false);
+  ASSERT_TRUE(status_snapshot::writer::instance().update());
+
+  ASSERT_TRUE(reader.read(_path));
+  ASSERT_EQ(reader.get_header().sequence, sequence + 2);
+  ASSERT_EQ(reader.hosts()[0].current_state, host::state_down);
+  ASSERT_EQ(reader.hosts()[0].latency, 2.5);
+}
+
+// Given an enabled status snapshot
+// When the status snapshot is disabled
+// Then the snapshot file is removed.
+TEST_F(StatusSnapshotTest, Disable) {
+  config->status_snapshot_file(_path);
+  ASSERT_TRUE(status_snapshot::writer::instance().update());
+  ASSERT_EQ(::access(_path, F_OK), 0);
+
+  config->status_snapshot_file("");
+  ASSERT_TRUE(status_snapshot::writer::instance().update());
+  ASSERT_NE(::access(_path, F_OK), 0);
+}
@@ -0,0 +1,199 @@
+/*
+** Copyright 2020 Centreon
+**
+** This file is part of Centreon Engine.
+**
+** Centreon Engine is free software: you can redistribute it and/or
+** modify it under the terms of the GNU General Public License version 2
+** as published by the Free Software Foundation.
+**
+** Centreon Engine is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Centreon Engine. If not, see
+** <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "com/centreon/engine/timeperiod.hh"
+#include "timeperiod/utils.hh"
+
+using namespace com::centreon::engine;
+
+/**
+ *  The same complex time periods are created twice, one of them being
+ *  indexed. Both must always give the same next valid time.
+ */
+class GetNextValidTimeIndexTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    _uncached = _build(_uncached_creator);
+    _indexed = _build(_indexed_creator);
+    _indexed->set_indexed(true);
+  }
+
+  void TearDown() override { timeperiod::invalidate_indexes(); }
+
+  /**
+   *  Office hours with exceptions around the DST transitions and
+   *  exclusions (one of them having its own exclusion).
+   */
+  static timeperiod* _build(timeperiod_creator& creator) {
+    timeperiod* holidays{creator.new_timeperiod()};
+    std::shared_ptr<timeperiod> holidays_shared{
+        creator.get_timeperiods_shared()};
+    daterange* dr{creator.new_calendar_date(2016, 11, 24, 2017, 0, 2)};
+    creator.new_timerange(0, 0, 24, 0, dr);
+    dr = creator.new_offset_weekday_of_generic_month(3, 2, 3, 2);
+    creator.new_timerange(12, 0, 15, 30, dr);
+
+    timeperiod* on_call{creator.new_timeperiod()};
+    dr = creator.new_calendar_date(2016, 11, 28, 2016, 11, 28);
+    creator.new_timerange(9, 0, 10, 0, dr);
+    creator.new_exclusion(holidays_shared, on_call);
+    std::shared_ptr<timeperiod> on_call_shared{
+        creator.get_timeperiods_shared()};
+
+    timeperiod* maintenance{creator.new_timeperiod()};
+    dr = creator.new_generic_month_date(15, 15);
+    creator.new_timerange(17, 0, 19, 0, dr);
+    std::shared_ptr<timeperiod> maintenance_shared{
+        creator.get_timeperiods_shared()};
+
+    timeperiod* tp{creator.new_timeperiod()};
+    for (int i(1); i < 6; ++i) {
+      creator.new_timerange(8, 0, 12, 0, i, tp);
+      creator.new_timerange(14, 0, 18, 30, i, tp);
+    }
+    creator.new_timerange(1, 0, 4, 0, 0, tp);
+    dr = creator.new_calendar_date(2016, 9, 30, 2016, 9, 30, tp);
+    creator.new_timerange(1, 30, 3, 30, dr);
+    dr = creator.new_specific_month_date(2, 26, 2, 26, tp);
+    creator.new_timerange(1, 30, 3, 30, dr);
+    dr = creator.new_offset_weekday_of_specific_month(0, 1, 1, 0, 1, 1, tp);
+    creator.new_timerange(0, 0, 24, 0, dr);
+    creator.new_exclusion(on_call_shared, tp);
+    creator.new_exclusion(maintenance_shared, tp);
+    (void)holidays;
+    (void)maintenance;
+    return tp;
+  }
+
+  void check_between(std::string const& from, std::string const& to) {
+    for (time_t now(strtotimet(from)), end(strtotimet(to)); now < end;
+         now += 7 * 60 + 13) {
+      set_time(now);
+      time_t expected((time_t)-1);
+      time_t computed((time_t)-1);
+      _uncached->get_next_valid_time_per_timeperiod(now, &expected);
+      _indexed->get_next_valid_time_per_timeperiod(now, &computed);
+      ASSERT_EQ(computed, expected) << "at " << now;
+      ASSERT_EQ(check_time_against_period(now, _indexed),
+                check_time_against_period(now, _uncached))
+          << "at " << now;
+    }
+  }
+
+ protected:
+  timeperiod_creator _uncached_creator;
+  timeperiod_creator _indexed_creator;
+  timeperiod* _uncached;
+  timeperiod* _indexed;
+};
+
+// Given a time period with exceptions and exclusions
+// When get_next_valid_time() is called on any time of a backward DST week
+// Then the indexed result is the same as the computed one
+TEST_F(GetNextValidTimeIndexTest, DSTBackward) {
+  check_between("2016-10-24 00:00:00", "2016-11-07 00:00:00");
+}
+
+// Given a time period with exceptions and exclusions
+// When get_next_valid_time() is called on any time of a forward DST week
+// Then the indexed result is the same as the computed one
+TEST_F(GetNextValidTimeIndexTest, DSTForward) {
+  check_between("2017-03-20 00:00:00", "2017-04-03 00:00:00");
+}
+
+// Given a time period with exceptions and exclusions
+// When get_next_valid_time() is called over several months
+// Then the indexed result is the same as the computed one
+TEST_F(GetNextValidTimeIndexTest, Horizon) {
+  check_between("2016-11-20 00:00:00", "2017-02-20 00:00:00");
+}
+
+// Given an indexed time period
+// When its definition changes and indexes are invalidated
+// Then the new definition is used
+TEST_F(GetNextValidTimeIndexTest, Invalidate) {
+  time_t now(strtotimet("2016-11-22 20:00:00"));
+  set_time(now);
+  time_t computed((time_t)-1);
+  _indexed->get_next_valid_time_per_timeperiod(now, &computed);
+  ASSERT_EQ(computed, strtotimet("2016-11-23 08:00:00"));
+
+  _indexed_creator.new_timerange(20, 0, 24, 0, 2, _indexed);
+  timeperiod::invalidate_indexes();
+  _indexed->get_next_valid_time_per_timeperiod(now, &computed);
+  ASSERT_EQ(computed, now);
+}
+
+// Given a time period with exceptions and exclusions
+// When older and newer times are looked up alternately
+// Then the indexed result is the same as the computed one
+TEST_F(GetNextValidTimeIndexTest, OlderTimes) {
+  time_t const now(strtotimet("2017-01-20 00:00:00"));
+  set_time(now);
+  for (time_t delta(0); delta < 40 * 24 * 60 * 60; delta += 5 * 60 * 60 + 7) {
+    for (time_t t : {now + delta, now - delta}) {
+      time_t expected((time_t)-1);
+      time_t computed((time_t)-1);
+      _uncached->get_next_valid_time_per_timeperiod(t, &expected);
+      _indexed->get_next_valid_time_per_timeperiod(t, &computed);
+      ASSERT_EQ(computed, expected) << "at " << t;
+    }
+  }
+}
+
+// Given a time period with exceptions and exclusions
+// When next valid times and valid times are looked up repeatedly
+// Then the indexed lookups give the computed results, faster
+TEST_F(GetNextValidTimeIndexTest, Benchmark) {
+  time_t const start(strtotimet("2016-11-20 00:00:00"));
+  int const lookups(20000);
+  set_time(start);
+
+  std::vector<time_t> uncached_times(lookups);
+  std::vector<time_t> indexed_times(lookups);
+  std::vector<bool> uncached_valid(lookups);
+  std::vector<bool> indexed_valid(lookups);
+  auto run = [&](timeperiod* tp, std::vector<time_t>& times,
+                 std::vector<bool>& valid) -> std::chrono::microseconds {
+    auto begin(std::chrono::steady_clock::now());
+    for (int i(0); i < lookups; ++i) {
+      times[i] = (time_t)-1;
+      tp->get_next_valid_time_per_timeperiod(start + i * 181, &times[i]);
+      valid[i] = check_time_against_period(start + i * 181, tp);
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin);
+  };
+  std::chrono::microseconds uncached(
+      run(_uncached, uncached_times, uncached_valid));
+  std::chrono::microseconds indexed(
+      run(_indexed, indexed_times, indexed_valid));
+  RecordProperty("computed_us", std::to_string(uncached.count()));
+  RecordProperty("indexed_us", std::to_string(indexed.count()));
+
+  for (int i(0); i < lookups; ++i) {
+    ASSERT_EQ(indexed_times[i], uncached_times[i]) << "at " << start + i * 181;
+    ASSERT_EQ(indexed_valid[i], uncached_valid[i]) << "at " << start + i * 181;
+  }
+  ASSERT_LT(indexed, uncached);
+}